@@ -8,6 +8,10 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// Interleaved rendering: shade only this frame's quad slot (count <= 1 = all)
+uniform int interleaveCount;
+uniform int interleavePhase;
+
 uniform vec2 resolution;
 uniform sampler2D fftTexture;
 uniform sampler2D gradientLUT;
@@ -82,6 +86,15 @@ float sampleFFTBand(float freqT0, float freqT1) {
 }
 
 void main() {
+    if (interleaveCount > 1) {
+        ivec2 q = ivec2(gl_FragCoord.xy) / 2;
+        int slot = interleaveCount == 2 ? (q.x + q.y) & 1
+                                        : (q.x & 1) + 2 * (q.y & 1);
+        if (slot != interleavePhase) {
+            discard;
+        }
+    }
+
     vec2 u = (fragTexCoord * resolution - resolution * 0.5) / resolution.y;
 
     float T = flyPhase + 5.0;
@@ -10,7 +10,7 @@ struct Agent {
     float y;
     float z;
     float age;
-    float _pad1;
+    float orbitPhase;
     float _pad2;
     float _pad3;
     float _pad4;
@@ -22,6 +22,12 @@ layout(std430, binding = 0) buffer AgentBuffer {
 
 layout(rgba32f, binding = 1) uniform image2D trailMap;
 
+// Orbit cache: orbitCount runs of orbitLength samples, xyz = position,
+// w = derivative magnitude
+layout(std430, binding = 2) buffer OrbitBuffer {
+    vec4 orbits[];
+};
+
 uniform vec2 resolution;
 uniform float time;
 uniform float timeScale;
@@ -46,9 +52,14 @@ uniform float depositAmount;
 uniform float maxSpeed;
 uniform int attractorType;
 uniform sampler2D gradientLUT;
+uniform int orbitMode;       // 0 = integrate, 1 = build orbits, 2 = follow orbits
+uniform int orbitCount;
+uniform int orbitLength;
+uniform float orbitAdvance;  // Orbit samples per step: timeScale / build timeScale
 
 const float PI = 3.14159265359;
 const float EXPLOSION_THRESHOLD = 500.0;  // Respawn when position exceeds this distance from origin
+const int ORBIT_WARMUP_STEPS = 500;       // Settle onto the attractor before recording an orbit
 
 // Hash function for pseudo-random respawn
 uint hash(uint x)
@@ -257,30 +268,78 @@ void respawnAgent(inout Agent agent, uint id)
         agent.z = (hashFloat(seed + 3u) - 0.5) * 0.2;
     }
     agent.age = 0.0;
-    agent._pad1 = 0.0;
+    agent.orbitPhase = 0.0;
+}
+
+bool isUnstable(vec3 pos)
+{
+    float magnitude = length(pos);
+    return isnan(magnitude) || isinf(magnitude) || magnitude > EXPLOSION_THRESHOLD;
+}
+
+// One invocation per orbit: spawn like an agent, settle onto the attractor,
+// then record orbitLength RK4 steps of timeScale
+void buildOrbit(uint id)
+{
+    Agent seed;
+    respawnAgent(seed, id);
+    vec3 pos = vec3(seed.x, seed.y, seed.z);
+    uint base = id * uint(orbitLength);
+
+    for (int i = -ORBIT_WARMUP_STEPS; i < orbitLength; i++) {
+        pos = rk4Step(pos, timeScale);
+        if (isUnstable(pos)) {
+            respawnAgent(seed, id + uint(orbitCount * (i + ORBIT_WARMUP_STEPS + 1)));
+            pos = vec3(seed.x, seed.y, seed.z);
+        }
+        if (i >= 0) {
+            orbits[base + uint(i)] = vec4(pos, length(attractorDerivative(pos)));
+        }
+    }
+}
+
+// Agents share orbits round-robin, each from its own hashed start, and
+// interpolate between samples so slow time scales stay smooth
+vec4 followOrbit(inout Agent agent, uint id)
+{
+    float span = float(orbitLength - 1);
+    agent.orbitPhase = mod(agent.orbitPhase + orbitAdvance, span);
+    float t = mod(hashFloat(id * 2654435761u) * span + agent.orbitPhase, span);
+    uint k = (id % uint(orbitCount)) * uint(orbitLength) + uint(t);
+    return mix(orbits[k], orbits[k + 1u], fract(t));
 }
 
 void main()
 {
     uint id = gl_GlobalInvocationID.x;
+    if (orbitMode == 1) {
+        if (id < uint(orbitCount)) {
+            buildOrbit(id);
+        }
+        return;
+    }
     if (id >= agents.length()) {
         return;
     }
 
     Agent agent = agents[id];
     vec3 pos = vec3(agent.x, agent.y, agent.z);
+    float cachedSpeed = -1.0;
 
-    // RK4 integration step
-    pos = rk4Step(pos, timeScale);
-
-    // Check for numerical instability (NaN or explosion)
-    float magnitude = length(pos);
-    bool unstable = isnan(magnitude) || isinf(magnitude) || magnitude > EXPLOSION_THRESHOLD;
-
-    if (unstable) {
-        respawnAgent(agent, id);
-        agents[id] = agent;
-        return;
+    if (orbitMode == 2) {
+        vec4 orbitSample = followOrbit(agent, id);
+        pos = orbitSample.xyz;
+        cachedSpeed = orbitSample.w;
+    } else {
+        // RK4 integration step
+        pos = rk4Step(pos, timeScale);
+
+        // Check for numerical instability (NaN or explosion)
+        if (isUnstable(pos)) {
+            respawnAgent(agent, id);
+            agents[id] = agent;
+            return;
+        }
     }
 
     // Project to screen coordinates
@@ -299,8 +358,8 @@ void main()
     // Deposit trail: velocity selects gradient LUT color
     if (onScreen) {
         ivec2 coord = ivec2(screenPos);
-        vec3 deriv = attractorDerivative(pos);
-        float speed = clamp(length(deriv) / maxSpeed, 0.0, 1.0);
+        float rawSpeed = (cachedSpeed >= 0.0) ? cachedSpeed : length(attractorDerivative(pos));
+        float speed = clamp(rawSpeed / maxSpeed, 0.0, 1.0);
         vec3 depositColor = texture(gradientLUT, vec2(speed, 0.5)).rgb;
 
         vec4 current = imageLoad(trailMap, coord);
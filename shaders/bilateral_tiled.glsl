@@ -0,0 +1,75 @@
+#version 430
+
+// Bilateral (tiled compute): same spatial x range Gaussian as bilateral.fs,
+// with the tile plus apron staged in shared memory once per workgroup.
+
+#define GROUP_SIZE 16
+#define MAX_RADIUS 12
+#define TILE_SIZE (GROUP_SIZE + 2 * MAX_RADIUS)
+#define EPS 1e-5
+
+layout(local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+layout(binding = 0) uniform sampler2D source;
+layout(rgba32f, binding = 1) writeonly uniform image2D outputImage;
+
+uniform float spatialSigma;
+uniform float rangeSigma;
+
+shared vec4 tile[TILE_SIZE * TILE_SIZE];
+
+void loadTile(ivec2 origin, ivec2 size)
+{
+    int local = int(gl_LocalInvocationIndex);
+    for (int i = local; i < TILE_SIZE * TILE_SIZE; i += GROUP_SIZE * GROUP_SIZE) {
+        ivec2 p = clamp(origin + ivec2(i % TILE_SIZE, i / TILE_SIZE), ivec2(0), size - 1);
+        tile[i] = texelFetch(source, p, 0);
+    }
+    barrier();
+}
+
+vec4 tileAt(ivec2 p)
+{
+    return tile[p.y * TILE_SIZE + p.x];
+}
+
+float lum(vec4 color)
+{
+    return length(color.xyz);
+}
+
+void main()
+{
+    ivec2 size = textureSize(source, 0);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * GROUP_SIZE - MAX_RADIUS;
+    loadTile(origin, size);
+
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= size.x || coord.y >= size.y) {
+        return;
+    }
+
+    float sigS = max(spatialSigma, EPS);
+    float sigL = max(rangeSigma, EPS);
+    float facS = -1.0 / (2.0 * sigS * sigS);
+    float facL = -1.0 / (2.0 * sigL * sigL);
+    int halfSize = min(int(sigS * 2.0), MAX_RADIUS);
+
+    ivec2 center = ivec2(gl_LocalInvocationID.xy) + MAX_RADIUS;
+    float l = lum(tileAt(center));
+
+    float sumW = 0.0;
+    vec4 sumC = vec4(0.0);
+    for (int i = -halfSize; i <= halfSize; i++) {
+        for (int j = -halfSize; j <= halfSize; j++) {
+            vec4 offsetColor = tileAt(center + ivec2(i, j));
+            float distS2 = float(i * i + j * j);
+            float distL = lum(offsetColor) - l;
+            float w = exp(facS * distS2) * exp(facL * distL * distL);
+            sumW += w;
+            sumC += offsetColor * w;
+        }
+    }
+
+    imageStore(outputImage, coord, sumC / sumW);
+}
@@ -21,6 +21,13 @@ layout(std430, binding = 0) buffer AgentBuffer {
 
 layout(rgba32f, binding = 1) uniform image2D trailMap;
 
+// Downsampled grids only: fixed-point RGB sums per trailMap texel, folded into
+// it by trail_deposit_resolve.glsl after the dispatch
+layout(std430, binding = 6) buffer DepositBuffer {
+    uint deposits[];
+};
+const float DEPOSIT_SCALE = 65536.0;  // Matches trail_deposit_resolve.glsl
+
 layout(std430, binding = 2) buffer CellOffsets {
     uint cellOffsets[];
 };
@@ -98,6 +105,55 @@ int positionToCell(vec2 pos)
     return cellCoord.y * gridSize.x + cellCoord.x;
 }
 
+void depositCell(ivec2 coord, vec3 color)
+{
+    vec4 current = imageLoad(trailMap, coord);
+    vec3 newColor = current.rgb + color;
+
+    // Scale proportionally to prevent overflow while preserving color ratios
+    float maxChan = max(newColor.r, max(newColor.g, newColor.b));
+    if (maxChan > 1.0) {
+        newColor /= maxChan;
+    }
+
+    imageStore(trailMap, coord, vec4(newColor, 0.0));
+}
+
+// Add to a texel's deposit sums. Splats from nearby agents overlap, so a
+// read-modify-write of trailMap here would drop all but one of them.
+void accumulateCell(ivec2 coord, ivec2 size, vec3 color)
+{
+    uvec3 amount = uvec3(max(color, 0.0) * DEPOSIT_SCALE + 0.5);
+    uint i = uint(coord.y * size.x + coord.x) * 3u;
+    if (amount.r != 0u) atomicAdd(deposits[i], amount.r);
+    if (amount.g != 0u) atomicAdd(deposits[i + 1u], amount.g);
+    if (amount.b != 0u) atomicAdd(deposits[i + 2u], amount.b);
+}
+
+// Deposit at a screen position. A downsampled grid splits the deposit
+// bilinearly over the 4 nearest cells, scaled by the cell area, into the
+// atomic sums; overflow scaling then applies once to each cell's total for
+// the step rather than per deposit. Full resolution writes trailMap directly
+// and can still lose deposits when agents land on the same pixel.
+void depositTrail(vec2 pos, vec3 color)
+{
+    ivec2 size = imageSize(trailMap);
+    if (size == ivec2(resolution)) {
+        depositCell(ivec2(pos), color);
+        return;
+    }
+
+    vec2 scale = vec2(size) / resolution;
+    vec2 g = mod(pos, resolution) * scale - 0.5;
+    ivec2 base = ivec2(floor(g));
+    vec2 f = g - vec2(base);
+    color *= scale.x * scale.y;
+    accumulateCell((base + size) % size, size, color * (1.0 - f.x) * (1.0 - f.y));
+    accumulateCell((base + ivec2(1, 0) + size) % size, size, color * f.x * (1.0 - f.y));
+    accumulateCell((base + ivec2(0, 1) + size) % size, size, color * (1.0 - f.x) * f.y);
+    accumulateCell((base + ivec2(1, 1) + size) % size, size, color * f.x * f.y);
+}
+
 void main()
 {
     uint id = gl_GlobalInvocationID.x;
@@ -121,7 +177,8 @@ void main()
     ivec2 myCell = ivec2(floor(mod(selfPos, resolution) / cellSize));
 
     // Dynamic scan radius: minimum 2 (5x5) to avoid edge artifacts, expand further for large perception
-    int scanRadius = max(2, int(ceil(perceptionRadius / cellSize)));
+    // A zero gridSize means the host has no spatial hash: skip neighbor steering
+    int scanRadius = (gridSize.x > 0) ? max(2, int(ceil(perceptionRadius / cellSize))) : -1;
 
     for (int dy = -scanRadius; dy <= scanRadius; dy++) {
         for (int dx = -scanRadius; dx <= scanRadius; dx++) {
@@ -233,18 +290,8 @@ void main()
     self.vy = selfVel.y;
 
     // Deposit color based on agent hue
-    ivec2 coord = ivec2(selfPos);
     vec3 depositColor = hsv2rgb(vec3(self.hue, saturation, value));
-    vec4 current = imageLoad(trailMap, coord);
-    vec3 newColor = current.rgb + depositColor * depositAmount;
-
-    // Scale proportionally to prevent overflow while preserving color ratios
-    float maxChan = max(newColor.r, max(newColor.g, newColor.b));
-    if (maxChan > 1.0) {
-        newColor /= maxChan;
-    }
-
-    imageStore(trailMap, coord, vec4(newColor, 0.0));
+    depositTrail(selfPos, depositColor * depositAmount);
 
     boids[id] = self;
 }
@@ -0,0 +1,69 @@
+#version 430
+
+// DoG Filter (tiled compute): same isotropic XDoG as dog_filter.fs. Only
+// luminance enters the kernel, so the shared tile stores one float per texel.
+
+#define GROUP_SIZE 16
+#define MAX_RADIUS 12
+#define TILE_SIZE (GROUP_SIZE + 2 * MAX_RADIUS)
+
+layout(local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+layout(binding = 0) uniform sampler2D source;
+layout(rgba32f, binding = 1) writeonly uniform image2D outputImage;
+
+uniform float sigma;
+uniform float tau;
+uniform float phi;
+
+shared float tile[TILE_SIZE * TILE_SIZE];
+
+void loadTile(ivec2 origin, ivec2 size)
+{
+    int local = int(gl_LocalInvocationIndex);
+    for (int i = local; i < TILE_SIZE * TILE_SIZE; i += GROUP_SIZE * GROUP_SIZE) {
+        ivec2 p = clamp(origin + ivec2(i % TILE_SIZE, i / TILE_SIZE), ivec2(0), size - 1);
+        tile[i] = dot(texelFetch(source, p, 0).rgb, vec3(0.299, 0.587, 0.114));
+    }
+    barrier();
+}
+
+void main()
+{
+    ivec2 size = textureSize(source, 0);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * GROUP_SIZE - MAX_RADIUS;
+    loadTile(origin, size);
+
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= size.x || coord.y >= size.y) {
+        return;
+    }
+
+    float sigmaR = sigma * 1.6;
+    float twoSigmaESquared = 2.0 * sigma * sigma;
+    float twoSigmaRSquared = 2.0 * sigmaR * sigmaR;
+    int halfWidth = min(int(ceil(2.0 * sigmaR)), MAX_RADIUS);
+
+    ivec2 center = ivec2(gl_LocalInvocationID.xy) + MAX_RADIUS;
+
+    vec2 sum = vec2(0.0);
+    vec2 norm = vec2(0.0);
+    for (int i = -halfWidth; i <= halfWidth; i++) {
+        for (int j = -halfWidth; j <= halfWidth; j++) {
+            float d2 = float(i * i + j * j);
+            vec2 kernel = vec2(exp(-d2 / twoSigmaESquared),
+                               exp(-d2 / twoSigmaRSquared));
+            ivec2 p = center + ivec2(i, j);
+            float L = tile[p.y * TILE_SIZE + p.x];
+            norm += 2.0 * kernel;
+            sum += kernel * L;
+        }
+    }
+    sum /= norm;
+
+    float H = 100.0 * (sum.x - tau * sum.y);
+    float edge = (H > 0.0) ? 1.0 : 2.0 * smoothstep(-2.0, 2.0, phi * H);
+
+    vec4 inputColor = texelFetch(source, coord, 0);
+    imageStore(outputImage, coord, vec4(inputColor.rgb * edge, inputColor.a));
+}
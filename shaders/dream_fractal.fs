@@ -10,6 +10,10 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// Interleaved rendering: shade only this frame's quad slot (count <= 1 = all)
+uniform int interleaveCount;
+uniform int interleavePhase;
+
 uniform vec2 resolution;
 uniform sampler2D fftTexture;
 uniform sampler2D gradientLUT;
@@ -64,6 +68,15 @@ void applyFold(inout vec3 p, int mode) {
 }
 
 void main() {
+    if (interleaveCount > 1) {
+        ivec2 q = ivec2(gl_FragCoord.xy) / 2;
+        int slot = interleaveCount == 2 ? (q.x + q.y) & 1
+                                        : (q.x & 1) + 2 * (q.y & 1);
+        if (slot != interleavePhase) {
+            discard;
+        }
+    }
+
     vec2 I = gl_FragCoord.xy;
     vec3 r = normalize(vec3(I + I, 0.0) - vec3(resolution.xy, resolution.y));
 
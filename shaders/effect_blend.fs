@@ -9,6 +9,8 @@ in vec4 fragColor;
 
 uniform sampler2D texture0;   // Main accumulation texture
 uniform sampler2D effectMap;  // Effect RGBA32F texture (trails, etc.)
+uniform sampler2D previousMap; // Effect state before the last fixed step
+uniform float stepAlpha;      // previousMap -> effectMap crossfade, 1 = current
 uniform float intensity;      // User-controlled 0.0-5.0
 uniform int blendMode;        // See EffectBlendMode enum
 
@@ -38,6 +40,9 @@ void main()
 {
     vec3 original = texture(texture0, fragTexCoord).rgb;
     vec3 effectColor = texture(effectMap, fragTexCoord).rgb;
+    if (stepAlpha < 1.0) {
+        effectColor = mix(texture(previousMap, fragTexCoord).rgb, effectColor, stepAlpha);
+    }
     float luminance = dot(effectColor, LUMA_WEIGHTS);
 
     // Headroom for boost modes - reduce effect on already-bright pixels
@@ -0,0 +1,52 @@
+#version 330
+
+// Interleaved rendering resolve. texture0 is a generator's history target in
+// which only this frame's slot was re-shaded; every other pixel still holds
+// its last shaded value. Stale pixels are clamped to the min/max of the
+// freshly shaded pixels around them, which bounds ghosting without needing
+// motion vectors.
+
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform int interleaveCount; // 2 = quad checkerboard, 4 = 4-way quad cycle
+uniform int interleavePhase;
+
+// Slots are assigned per 2x2 quad so discarded work saves whole GPU quads
+int interleaveSlot(ivec2 p)
+{
+    ivec2 q = p / 2;
+    if (interleaveCount == 2) {
+        return (q.x + q.y) & 1;
+    }
+    return (q.x & 1) + 2 * (q.y & 1);
+}
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(texture0, 0);
+    vec4 color = texelFetch(texture0, p, 0);
+
+    if (interleaveSlot(p) == interleavePhase) {
+        finalColor = color;
+        return;
+    }
+
+    vec4 lo = vec4(1e20);
+    vec4 hi = vec4(-1e20);
+    bool found = false;
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 s = clamp(p + ivec2(x, y) * 2, ivec2(0), size - 1);
+            if (interleaveSlot(s) == interleavePhase) {
+                vec4 v = texelFetch(texture0, s, 0);
+                lo = min(lo, v);
+                hi = max(hi, v);
+                found = true;
+            }
+        }
+    }
+
+    finalColor = found ? clamp(color, lo, hi) : color;
+}
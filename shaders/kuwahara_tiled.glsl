@@ -0,0 +1,78 @@
+#version 430
+
+// Kuwahara (tiled compute): same 4-sector minimum-variance filter as
+// kuwahara.fs, but each 16x16 workgroup loads its tile plus a radius-wide
+// apron into shared memory once instead of refetching overlapping sectors.
+
+#define GROUP_SIZE 16
+#define MAX_RADIUS 12
+#define TILE_SIZE (GROUP_SIZE + 2 * MAX_RADIUS)
+
+layout(local_size_x = GROUP_SIZE, local_size_y = GROUP_SIZE) in;
+
+layout(binding = 0) uniform sampler2D source;
+layout(rgba32f, binding = 1) writeonly uniform image2D outputImage;
+
+uniform int radius;
+
+shared vec3 tile[TILE_SIZE * TILE_SIZE];
+
+void loadTile(ivec2 origin, ivec2 size)
+{
+    int local = int(gl_LocalInvocationIndex);
+    for (int i = local; i < TILE_SIZE * TILE_SIZE; i += GROUP_SIZE * GROUP_SIZE) {
+        // Clamp matches the fragment version's CLAMP_TO_EDGE sampling
+        ivec2 p = clamp(origin + ivec2(i % TILE_SIZE, i / TILE_SIZE), ivec2(0), size - 1);
+        tile[i] = texelFetch(source, p, 0).rgb;
+    }
+    barrier();
+}
+
+vec3 tileAt(ivec2 p)
+{
+    return tile[p.y * TILE_SIZE + p.x];
+}
+
+void main()
+{
+    ivec2 size = textureSize(source, 0);
+    ivec2 origin = ivec2(gl_WorkGroupID.xy) * GROUP_SIZE - MAX_RADIUS;
+    loadTile(origin, size);
+
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= size.x || coord.y >= size.y) {
+        return;
+    }
+
+    int r = clamp(radius, 1, MAX_RADIUS);
+    ivec2 center = ivec2(gl_LocalInvocationID.xy) + MAX_RADIUS;
+
+    vec3 bestMean = vec3(0.0);
+    float bestVar = 1e30;
+
+    for (int sector = 0; sector < 4; sector++) {
+        int xStart = (sector == 0 || sector == 2) ? -r : 0;
+        int yStart = (sector == 0 || sector == 1) ? -r : 0;
+
+        vec3 colorSum = vec3(0.0);
+        vec3 colorSqSum = vec3(0.0);
+        for (int x = xStart; x <= xStart + r; x++) {
+            for (int y = yStart; y <= yStart + r; y++) {
+                vec3 c = tileAt(center + ivec2(x, y));
+                colorSum += c;
+                colorSqSum += c * c;
+            }
+        }
+
+        float count = float((r + 1) * (r + 1));
+        vec3 mean = colorSum / count;
+        vec3 var3 = colorSqSum / count - mean * mean;
+        float variance = dot(var3, vec3(0.299, 0.587, 0.114));
+        if (variance < bestVar) {
+            bestVar = variance;
+            bestMean = mean;
+        }
+    }
+
+    imageStore(outputImage, coord, vec4(bestMean, 1.0));
+}
@@ -2,6 +2,7 @@
 // https://www.shadertoy.com/view/XdjcRD
 // License: CC BY-NC-SA 3.0 Unported
 // Modified: Ported from Shadertoy fragment feedback to compute shader with SSBO agents and imageStore trail writes
+// Walks the live list only; dead worms count down in maze_worm_respawn.glsl
 #version 430
 
 layout(local_size_x = 1024) in;
@@ -22,6 +23,26 @@ layout(std430, binding = 0) buffer AgentBuffer {
 
 layout(rgba32f, binding = 1) uniform image2D trailMap;
 
+// Live list this step walks, and the lists the next step reads
+// (layout and append rule: SimLiveList in shader_utils.h)
+layout(std430, binding = 2) readonly buffer SourceList {
+    uint sourceGroups[3];
+    uint sourceCount;
+    uint sourceIndices[];
+};
+
+layout(std430, binding = 3) buffer LiveList {
+    uint liveGroups[3];
+    uint liveCount;
+    uint liveIndices[];
+};
+
+layout(std430, binding = 4) buffer DeadList {
+    uint deadGroups[3];
+    uint deadCount;
+    uint deadIndices[];
+};
+
 uniform sampler2D gradientLUT;
 uniform vec2 resolution;
 uniform int turningMode;
@@ -29,13 +50,29 @@ uniform float curvature;
 uniform float turnAngle;
 uniform float trailWidth;
 uniform float collisionGap;
-uniform float time;
 uniform float respawnCooldown;
-uniform float stepDeltaTime;
 uniform float moveSpeed;
 
-float hash(float n) {
-    return fract(sin(n) * 43758.5453123);
+void appendLive(uint idx) {
+    uint slot = atomicAdd(liveCount, 1u);
+    liveIndices[slot] = idx;
+    if (slot % gl_WorkGroupSize.x == 0u) {
+        atomicAdd(liveGroups[0], 1u);
+    }
+}
+
+void appendDead(uint idx) {
+    uint slot = atomicAdd(deadCount, 1u);
+    deadIndices[slot] = idx;
+    if (slot % gl_WorkGroupSize.x == 0u) {
+        atomicAdd(deadGroups[0], 1u);
+    }
+}
+
+void kill(uint idx) {
+    agents[idx].alive = 0.0;
+    agents[idx].respawnTimer = respawnCooldown;
+    appendDead(idx);
 }
 
 // Single-point collision probe (same model as original Shadertoy)
@@ -55,39 +92,11 @@ vec2 probe(vec2 pos, float a) {
 }
 
 void main() {
-    uint idx = gl_GlobalInvocationID.x;
-    if (idx >= agents.length()) return;
+    if (gl_GlobalInvocationID.x >= sourceCount) return;
+    uint idx = sourceIndices[gl_GlobalInvocationID.x];
 
     MazeWormAgent agent = agents[idx];
 
-    // GPU-side respawn for dead agents
-    if (agent.alive < 0.5) {
-        agent.respawnTimer -= stepDeltaTime;
-        if (agent.respawnTimer > 0.0) {
-            agents[idx].respawnTimer = agent.respawnTimer;
-            return;
-        }
-
-        float seed = float(idx) * 1000.0 + time * 137.0;
-        float margin = trailWidth + 1.0 + collisionGap;
-        float rx = hash(seed);
-        float ry = hash(seed + 1.0);
-        float newX = margin + rx * (resolution.x - 2.0 * margin);
-        float newY = margin + ry * (resolution.y - 2.0 * margin);
-
-        if (imageLoad(trailMap, ivec2(newX, newY)).w < 0.1) {
-            agents[idx].x = newX;
-            agents[idx].y = newY;
-            agents[idx].angle = hash(seed + 2.0) * 6.2832;
-            agents[idx].age = 1.0;
-            agents[idx].alive = 1.0;
-            agents[idx].respawnTimer = 0.0;
-        } else {
-            agents[idx].respawnTimer = 0.0;
-        }
-        return;
-    }
-
     vec2 pos = vec2(agent.x, agent.y);
     float a = agent.angle;
 
@@ -97,8 +106,7 @@ void main() {
         float chirality = sign(sin(float(idx) + 0.5));
         a += chirality * curvature / agent.age;
         if (isWall(probe(pos, a))) {
-            agents[idx].alive = 0.0;
-            agents[idx].respawnTimer = respawnCooldown;
+            kill(idx);
             return;
         }
     } else if (turningMode == 1) {
@@ -112,8 +120,7 @@ void main() {
             attempts++;
         }
         if (attempts >= maxAttempts) {
-            agents[idx].alive = 0.0;
-            agents[idx].respawnTimer = respawnCooldown;
+            kill(idx);
             return;
         }
     } else if (turningMode == 2) {
@@ -127,8 +134,7 @@ void main() {
             attempts++;
         }
         if (attempts >= maxAttempts) {
-            agents[idx].alive = 0.0;
-            agents[idx].respawnTimer = respawnCooldown;
+            kill(idx);
             return;
         }
     } else if (turningMode == 3) {
@@ -136,8 +142,7 @@ void main() {
         float chirality = sign(sin(float(idx) + 0.5));
         a += curvature * 0.001 * agent.age * chirality;
         if (isWall(probe(pos, a))) {
-            agents[idx].alive = 0.0;
-            agents[idx].respawnTimer = respawnCooldown;
+            kill(idx);
             return;
         }
     }
@@ -150,8 +155,7 @@ void main() {
     float margin = trailWidth + 1.0;
     if (newX < margin || newX > resolution.x - margin ||
         newY < margin || newY > resolution.y - margin) {
-        agents[idx].alive = 0.0;
-        agents[idx].respawnTimer = respawnCooldown;
+        kill(idx);
         return;
     }
 
@@ -177,4 +181,5 @@ void main() {
     agents[idx].y = newY;
     agents[idx].angle = mod(a, 6.2832);
     agents[idx].age = agent.age + 1.0;
+    appendLive(idx);
 }
@@ -0,0 +1,114 @@
+// Respawn kernel for maze_worm_agents.glsl. Walks the dead list, counting
+// each worm's cooldown down and dropping it on an empty spot once it runs out.
+// With rebuild set it instead walks every agent and sorts them into the live
+// and dead lists (after init, reset or a worm count change).
+#version 430
+
+layout(local_size_x = 1024) in;
+
+struct MazeWormAgent {
+    float x, y;
+    float angle;
+    float age;
+    float alive;
+    float hue;
+    float respawnTimer;
+    float _pad;
+};
+
+layout(std430, binding = 0) buffer AgentBuffer {
+    MazeWormAgent agents[];
+};
+
+layout(rgba32f, binding = 1) readonly uniform image2D trailMap;
+
+// Dead list this step walks, and the lists the next step reads
+// (layout and append rule: SimLiveList in shader_utils.h)
+layout(std430, binding = 2) readonly buffer SourceList {
+    uint sourceGroups[3];
+    uint sourceCount;
+    uint sourceIndices[];
+};
+
+layout(std430, binding = 3) buffer LiveList {
+    uint liveGroups[3];
+    uint liveCount;
+    uint liveIndices[];
+};
+
+layout(std430, binding = 4) buffer DeadList {
+    uint deadGroups[3];
+    uint deadCount;
+    uint deadIndices[];
+};
+
+uniform vec2 resolution;
+uniform float trailWidth;
+uniform float collisionGap;
+uniform float time;
+uniform float stepDeltaTime;
+uniform bool rebuild;
+
+float hash(float n) {
+    return fract(sin(n) * 43758.5453123);
+}
+
+void appendLive(uint idx) {
+    uint slot = atomicAdd(liveCount, 1u);
+    liveIndices[slot] = idx;
+    if (slot % gl_WorkGroupSize.x == 0u) {
+        atomicAdd(liveGroups[0], 1u);
+    }
+}
+
+void appendDead(uint idx) {
+    uint slot = atomicAdd(deadCount, 1u);
+    deadIndices[slot] = idx;
+    if (slot % gl_WorkGroupSize.x == 0u) {
+        atomicAdd(deadGroups[0], 1u);
+    }
+}
+
+void main() {
+    uint gid = gl_GlobalInvocationID.x;
+
+    if (rebuild) {
+        if (gid >= agents.length()) return;
+        if (agents[gid].alive < 0.5) {
+            appendDead(gid);
+        } else {
+            appendLive(gid);
+        }
+        return;
+    }
+
+    if (gid >= sourceCount) return;
+    uint idx = sourceIndices[gid];
+
+    float timer = agents[idx].respawnTimer - stepDeltaTime;
+    if (timer > 0.0) {
+        agents[idx].respawnTimer = timer;
+        appendDead(idx);
+        return;
+    }
+
+    float seed = float(idx) * 1000.0 + time * 137.0;
+    float margin = trailWidth + 1.0 + collisionGap;
+    float rx = hash(seed);
+    float ry = hash(seed + 1.0);
+    float newX = margin + rx * (resolution.x - 2.0 * margin);
+    float newY = margin + ry * (resolution.y - 2.0 * margin);
+
+    if (imageLoad(trailMap, ivec2(newX, newY)).w < 0.1) {
+        agents[idx].x = newX;
+        agents[idx].y = newY;
+        agents[idx].angle = hash(seed + 2.0) * 6.2832;
+        agents[idx].age = 1.0;
+        agents[idx].alive = 1.0;
+        agents[idx].respawnTimer = 0.0;
+        appendLive(idx);
+    } else {
+        agents[idx].respawnTimer = 0.0;
+        appendDead(idx);
+    }
+}
@@ -2,6 +2,9 @@
 
 // Particle Life: emergent behavior from species-based attraction/repulsion rules
 // Particles interact via piecewise force function with inner repulsion zone and outer interaction zone
+// Neighbors come from a 3D spatial hash with cells at least rMax wide, so only the 27 cells around a
+// particle can hold particles within range. Thread i updates sortedParticles[i] (the cell-ordered copy
+// of last frame's state) and writes particles[i], leaving the main buffer in cell order.
 
 layout(local_size_x = 1024) in;
 
@@ -16,10 +19,18 @@ struct Particle {
     int species;
 };
 
-layout(std430, binding = 0) buffer ParticleBuffer {
+layout(std430, binding = 0) writeonly buffer ParticleBuffer {
     Particle particles[];
 };
 
+layout(std430, binding = 2) readonly buffer SortedParticleBuffer {
+    Particle sortedParticles[];
+};
+
+layout(std430, binding = 3) readonly buffer CellOffsets {
+    uint cellOffsets[]; // Inclusive prefix sum: cell i spans [cellOffsets[i-1], cellOffsets[i])
+};
+
 layout(rgba32f, binding = 1) uniform image2D trailMap;
 
 uniform vec2 resolution;
@@ -40,6 +51,9 @@ uniform float depositAmount;
 uniform float saturation;
 uniform float value;
 uniform float attractionMatrix[256];  // Up to 16x16 species
+uniform ivec3 gridSize;
+uniform vec3 gridOrigin;  // Minimum corner of the spatial hash grid
+uniform float cellSize;
 
 // HSV to RGB conversion
 vec3 hsv2rgb(vec3 c)
@@ -103,33 +117,47 @@ void main()
         return;
     }
 
-    Particle p = particles[id];
+    Particle p = sortedParticles[id];
     vec3 pos = vec3(p.x, p.y, p.z);
     vec3 vel = vec3(p.vx, p.vy, p.vz);
 
     vec3 totalForce = vec3(0.0);
 
-    // Brute-force neighbor iteration for force accumulation
-    for (uint j = 0; j < uint(numParticles); j++) {
-        if (id == j) {
-            continue;
-        }
-
-        Particle other = particles[j];
-        vec3 otherPos = vec3(other.x, other.y, other.z);
-        vec3 delta = otherPos - pos;
-        float r = length(delta);
-
-        if (r > 0.0 && r < rMax) {
-            // Look up attraction value from species pair matrix (stride matches CPU's MAX_SPECIES)
-            int matrixIndex = p.species * 16 + other.species;
-            float a = attractionMatrix[matrixIndex];
-
-            // Compute force magnitude using normalized distance
-            float f = force(r / rMax, a, beta);
-
-            // Accumulate force in direction of neighbor
-            totalForce += (delta / r) * f;
+    // Same clamped mapping as the spatial hash build
+    ivec3 cell = clamp(ivec3(floor((pos - gridOrigin) / cellSize)), ivec3(0), gridSize - 1);
+    ivec3 cellMin = max(cell - 1, ivec3(0));
+    ivec3 cellMax = min(cell + 1, gridSize - 1);
+
+    for (int cz = cellMin.z; cz <= cellMax.z; cz++) {
+        for (int cy = cellMin.y; cy <= cellMax.y; cy++) {
+            // Cells along x are adjacent in the sorted order: one contiguous run per row
+            int rowStart = (cz * gridSize.y + cy) * gridSize.x;
+            int firstCell = rowStart + cellMin.x;
+            uint start = (firstCell == 0) ? 0u : cellOffsets[firstCell - 1];
+            uint end = cellOffsets[rowStart + cellMax.x];
+
+            for (uint j = start; j < end; j++) {
+                if (id == j) {
+                    continue;
+                }
+
+                Particle other = sortedParticles[j];
+                vec3 otherPos = vec3(other.x, other.y, other.z);
+                vec3 delta = otherPos - pos;
+                float r = length(delta);
+
+                if (r > 0.0 && r < rMax) {
+                    // Look up attraction value from species pair matrix (stride matches CPU's MAX_SPECIES)
+                    int matrixIndex = p.species * 16 + other.species;
+                    float a = attractionMatrix[matrixIndex];
+
+                    // Compute force magnitude using normalized distance
+                    float f = force(r / rMax, a, beta);
+
+                    // Accumulate force in direction of neighbor
+                    totalForce += (delta / r) * f;
+                }
+            }
         }
     }
 
@@ -182,12 +210,6 @@ void main()
         imageStore(trailMap, coord, vec4(newColor, 0.0));
     }
 
-    // Store updated state
-    particles[id].x = pos.x;
-    particles[id].y = pos.y;
-    particles[id].z = pos.z;
-    particles[id].vx = vel.x;
-    particles[id].vy = vel.y;
-    particles[id].vz = vel.z;
-    // hue and species remain unchanged
+    // Store updated state in sorted order; hue and species travel with the particle
+    particles[id] = Particle(pos.x, pos.y, pos.z, vel.x, vel.y, vel.z, p.hue, p.species);
 }
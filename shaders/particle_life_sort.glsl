@@ -0,0 +1,41 @@
+#version 430
+
+// Particle Life cell sort: gather particles into spatial hash order so the
+// force pass reads each cell's particles from contiguous memory
+
+layout(local_size_x = 1024) in;
+
+struct Particle {
+    float x;
+    float y;
+    float z;
+    float vx;
+    float vy;
+    float vz;
+    float hue;
+    int species;
+};
+
+layout(std430, binding = 0) readonly buffer ParticleBuffer {
+    Particle particles[];
+};
+
+layout(std430, binding = 1) writeonly buffer SortedParticleBuffer {
+    Particle sortedParticles[];
+};
+
+layout(std430, binding = 2) readonly buffer SortedIndices {
+    uint sortedIndices[];
+};
+
+uniform int numParticles;
+
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uint(numParticles)) {
+        return;
+    }
+
+    sortedParticles[id] = particles[sortedIndices[id]];
+}
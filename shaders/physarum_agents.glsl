@@ -9,7 +9,7 @@ struct Agent {
     float y;
     float heading;
     float hue;         // Agent's hue identity (0-1) for deposit color and affinity
-    float _pad1;
+    uint seed;         // Stable per-agent hash seed; buffer order changes on cell sort
     float _pad2;
     float _pad3;
     float _pad4;
@@ -20,6 +20,13 @@ layout(std430, binding = 0) buffer AgentBuffer {
 };
 
 layout(rgba32f, binding = 1) uniform image2D trailMap;
+
+// Downsampled grids only: fixed-point RGB sums per trailMap texel, folded into
+// it by trail_deposit_resolve.glsl after the dispatch
+layout(std430, binding = 6) buffer DepositBuffer {
+    uint deposits[];
+};
+const float DEPOSIT_SCALE = 65536.0;  // Matches trail_deposit_resolve.glsl
 layout(binding = 2) uniform sampler2D accumMap;
 
 uniform vec2 resolution;
@@ -145,13 +152,70 @@ bool isOutOfBounds(vec2 pos)
     return pos.x < 0.0 || pos.x >= resolution.x || pos.y < 0.0 || pos.y >= resolution.y;
 }
 
+// Trail map cell under a screen position. The trail map may be downsampled
+// (gridDivisor), so sensing distances stay in screen pixels at any scale.
+ivec2 trailCell(vec2 pos)
+{
+    return ivec2(mod(pos, resolution) * vec2(imageSize(trailMap)) / resolution);
+}
+
+void depositCell(ivec2 coord, vec3 color)
+{
+    vec4 current = imageLoad(trailMap, coord);
+    vec3 newColor = current.rgb + color;
+
+    // Scale proportionally to prevent overflow while preserving color ratios (saturation)
+    // Independent clamping causes desaturation: (1.2, 0.3, 0.1) -> (1.0, 0.3, 0.1)
+    // Proportional scaling preserves hue: (1.2, 0.3, 0.1) -> (1.0, 0.25, 0.083)
+    float maxChan = max(newColor.r, max(newColor.g, newColor.b));
+    if (maxChan > 1.0) {
+        newColor /= maxChan;
+    }
+
+    imageStore(trailMap, coord, vec4(newColor, 0.0));
+}
+
+// Add to a texel's deposit sums. Splats from nearby agents overlap, so a
+// read-modify-write of trailMap here would drop all but one of them.
+void accumulateCell(ivec2 coord, ivec2 size, vec3 color)
+{
+    uvec3 amount = uvec3(max(color, 0.0) * DEPOSIT_SCALE + 0.5);
+    uint i = uint(coord.y * size.x + coord.x) * 3u;
+    if (amount.r != 0u) atomicAdd(deposits[i], amount.r);
+    if (amount.g != 0u) atomicAdd(deposits[i + 1u], amount.g);
+    if (amount.b != 0u) atomicAdd(deposits[i + 2u], amount.b);
+}
+
+// Deposit at a screen position. A downsampled grid splits the deposit
+// bilinearly over the 4 nearest cells, scaled by the cell area, into the
+// atomic sums; overflow scaling then applies once to each cell's total for
+// the step rather than per deposit. Full resolution writes trailMap directly
+// and can still lose deposits when agents land on the same pixel.
+void depositTrail(vec2 pos, vec3 color)
+{
+    ivec2 size = imageSize(trailMap);
+    if (size == ivec2(resolution)) {
+        depositCell(ivec2(pos), color);
+        return;
+    }
+
+    vec2 scale = vec2(size) / resolution;
+    vec2 g = mod(pos, resolution) * scale - 0.5;
+    ivec2 base = ivec2(floor(g));
+    vec2 f = g - vec2(base);
+    color *= scale.x * scale.y;
+    accumulateCell((base + size) % size, size, color * (1.0 - f.x) * (1.0 - f.y));
+    accumulateCell((base + ivec2(1, 0) + size) % size, size, color * f.x * (1.0 - f.y));
+    accumulateCell((base + ivec2(0, 1) + size) % size, size, color * (1.0 - f.x) * f.y);
+    accumulateCell((base + ivec2(1, 1) + size) % size, size, color * f.x * f.y);
+}
+
 float sampleTrailAffinity(vec2 pos, float agentHue)
 {
     if (boundsMode != 0 && isOutOfBounds(pos)) {
         return 1.0;
     }
-    ivec2 coord = ivec2(mod(pos, resolution));
-    vec3 trailColor = imageLoad(trailMap, coord).rgb;
+    vec3 trailColor = imageLoad(trailMap, trailCell(pos)).rgb;
     return computeAffinity(trailColor, agentHue);
 }
 
@@ -186,7 +250,7 @@ void main()
     uint hashState = hash(id + uint(time * 1000.0));
 
     // Stable per-agent sensing distance from Gaussian distribution
-    uint distHash = hash(id);
+    uint distHash = hash(agent.seed);
     float agentSensorDist = sensorDistance;
     if (sensorDistanceVariance > 0.001) {
         float offset = gaussian(distHash) * sensorDistanceVariance;
@@ -293,7 +357,7 @@ void main()
     }
     else if (walkMode == 2) {
         // Adaptive: step scales with local density
-        ivec2 coord = ivec2(pos);
+        ivec2 coord = trailCell(pos);
         float localDensity = dot(imageLoad(trailMap, coord).rgb, LUMA_WEIGHTS);
         float scale = mix(1.0, densityResponse, localDensity);
         agentStep = stepSize * scale;
@@ -331,9 +395,8 @@ void main()
     }
     else if (walkMode == 7) {
         // Gradient: step scales with local gradient magnitude (edge-tracing)
-        ivec2 coord = ivec2(pos);
-        float here = dot(imageLoad(trailMap, coord).rgb, LUMA_WEIGHTS);
-        float ahead = dot(imageLoad(trailMap, coord + ivec2(moveDir * 2.0)).rgb, LUMA_WEIGHTS);
+        float here = dot(imageLoad(trailMap, trailCell(pos)).rgb, LUMA_WEIGHTS);
+        float ahead = dot(imageLoad(trailMap, trailCell(pos + moveDir * 2.0)).rgb, LUMA_WEIGHTS);
         float gradMag = abs(ahead - here);
         agentStep = stepSize * (1.0 + gradientBoost * gradMag);
     }
@@ -399,7 +462,7 @@ void main()
     } else if (boundsMode == 5) {
         // Fixed Home: redirect toward deterministic home position
         if (clampToEdge(pos, resolution)) {
-            uint homeHash = hash(id * 3u + 12345u);
+            uint homeHash = hash(agent.seed * 3u + 12345u);
             float homeX = float(homeHash) / 4294967295.0 * resolution.x;
             homeHash = hash(homeHash);
             float homeY = float(homeHash) / 4294967295.0 * resolution.y;
@@ -422,7 +485,7 @@ void main()
     } else if (boundsMode == 8) {
         // Multi-Home: redirect toward one of K attractors
         if (clampToEdge(pos, resolution)) {
-            uint attractorIdx = hash(id) % uint(attractorCount);
+            uint attractorIdx = hash(agent.seed) % uint(attractorCount);
             vec2 target = attractors[attractorIdx] * resolution;
             if (respawnMode > 0.5) {
                 pos = target;
@@ -444,20 +507,8 @@ void main()
     agent.y = pos.y;
 
     // Deposit color based on agent hue
-    ivec2 coord = ivec2(pos);
     vec3 depositColor = hsv2rgb(vec3(agent.hue, saturation, value));
-    vec4 current = imageLoad(trailMap, coord);
-    vec3 newColor = current.rgb + depositColor * depositAmount;
-
-    // Scale proportionally to prevent overflow while preserving color ratios (saturation)
-    // Independent clamping causes desaturation: (1.2, 0.3, 0.1) -> (1.0, 0.3, 0.1)
-    // Proportional scaling preserves hue: (1.2, 0.3, 0.1) -> (1.0, 0.25, 0.083)
-    float maxChan = max(newColor.r, max(newColor.g, newColor.b));
-    if (maxChan > 1.0) {
-        newColor /= maxChan;
-    }
-
-    imageStore(trailMap, coord, vec4(newColor, 0.0));
+    depositTrail(pos, depositColor * depositAmount);
 
     agents[id] = agent;
 }
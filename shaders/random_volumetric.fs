@@ -7,6 +7,10 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// Interleaved rendering: shade only this frame's quad slot (count <= 1 = all)
+uniform int interleaveCount;
+uniform int interleavePhase;
+
 uniform sampler2D fftTexture;
 uniform sampler2D gradientLUT;
 uniform vec2 resolution;
@@ -143,6 +147,15 @@ vec3 sanitize(vec3 dc) {
 }
 
 void main() {
+    if (interleaveCount > 1) {
+        ivec2 q = ivec2(gl_FragCoord.xy) / 2;
+        int slot = interleaveCount == 2 ? (q.x + q.y) & 1
+                                        : (q.x & 1) + 2 * (q.y & 1);
+        if (slot != interleavePhase) {
+            discard;
+        }
+    }
+
     vec3 r = vec3(resolution, 0.);
     vec2 fragCoord = fragTexCoord * resolution;
     vec2 u = (fragCoord - r.xy/2.) / r.y;
@@ -0,0 +1,49 @@
+#version 330
+
+// Shared-memory output conversion. Rows are written top row first so the
+// readback lands in image order. In NV12 mode the target is a single-channel
+// texture of width x height*3/2: the first height rows are luma, the rest
+// hold interleaved Cb/Cr for each 2x2 block.
+
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;
+uniform vec2 frameSize; // Output image size in pixels
+uniform int nv12;
+
+// BT.709 limited range, normalized to 0-1 byte values
+vec3 toYCbCr(vec3 c)
+{
+    c = clamp(c, 0.0, 1.0);
+    float y = dot(c, vec3(0.2126, 0.7152, 0.0722));
+    float cb = (c.b - y) / 1.8556;
+    float cr = (c.r - y) / 1.5748;
+    return vec3(16.0 + 219.0 * y, 128.0 + 224.0 * cb, 128.0 + 224.0 * cr) / 255.0;
+}
+
+vec2 imageUV(vec2 pixel)
+{
+    return vec2(pixel.x / frameSize.x, 1.0 - pixel.y / frameSize.y);
+}
+
+void main()
+{
+    vec2 p = gl_FragCoord.xy;
+    if (nv12 == 0) {
+        finalColor = vec4(texture(texture0, imageUV(p)).rgb, 1.0);
+        return;
+    }
+
+    ivec2 ip = ivec2(p);
+    if (ip.y < int(frameSize.y)) {
+        finalColor = vec4(toYCbCr(texture(texture0, imageUV(p)).rgb).x, 0.0, 0.0, 1.0);
+        return;
+    }
+
+    // Sample at the shared corner of the 2x2 block so bilinear filtering
+    // averages all four pixels
+    ivec2 block = ivec2(ip.x / 2, ip.y - int(frameSize.y));
+    vec3 ycc = toYCbCr(texture(texture0, imageUV(vec2(block * 2 + 1))).rgb);
+    finalColor = vec4((ip.x & 1) == 0 ? ycc.y : ycc.z, 0.0, 0.0, 1.0);
+}
@@ -1,15 +1,52 @@
 #version 430
 
-// Spatial hash build shader with four kernels:
+// Spatial hash build shader with kernels:
 // - KERNEL_CLEAR: Zero out cell counts
 // - KERNEL_COUNT: Count agents per cell
-// - KERNEL_PREFIX_SUM: Serial prefix sum (single thread)
+// - KERNEL_SCAN_BLOCKS: Inclusive prefix sum within blocks of SCAN_BLOCK cells
+// - KERNEL_SCAN_BLOCK_SUMS: Inclusive prefix sum of block totals (one workgroup)
+// - KERNEL_ADD_BLOCK_OFFSETS: Add preceding block totals to each block
 // - KERNEL_SCATTER: Scatter agents to sorted indices
+// - KERNEL_RESTORE: Re-add counts to offsets the scatter decremented
+// - KERNEL_REORDER: Gather agent structs into sorted order
+// - KERNEL_THIN: Gather an evenly strided subset of agents in sorted order
+// GRID_3D switches from a wrapping 2D screen grid over vec2 positions to a
+// clamped 3D grid over vec3 positions.
+
+// Workgroup scans use subgroup arithmetic where the driver exposes it
+#if defined(GL_KHR_shader_subgroup_arithmetic)
+#extension GL_KHR_shader_subgroup_basic : enable
+#extension GL_KHR_shader_subgroup_arithmetic : enable
+#define USE_SUBGROUPS
+#endif
+
+#define SCAN_THREADS 256
+#define SCAN_ITEMS 4 // Consecutive cells per invocation
+#define SCAN_BLOCK (SCAN_THREADS * SCAN_ITEMS)
 
-// Common uniforms for kernels using position-to-cell mapping
+// Common inputs for kernels using position-to-cell mapping
 #if defined(KERNEL_COUNT) || defined(KERNEL_SCATTER)
-uniform vec2 resolution;
+layout(std430, binding = 0) buffer Positions {
+    float positionData[];
+};
+
+uniform int agentCount;
+uniform int agentStride;    // Bytes between agents
+uniform int positionOffset; // Byte offset to position within agent struct
 uniform float cellSize;
+
+#ifdef GRID_3D
+uniform ivec3 gridSize;
+uniform vec3 gridOrigin; // Minimum corner
+
+// Position to cell index (clamped, so agents past the bounds land in border cells)
+int positionToCell(vec3 pos)
+{
+    ivec3 cellCoord = clamp(ivec3(floor((pos - gridOrigin) / cellSize)), ivec3(0), gridSize - 1);
+    return (cellCoord.z * gridSize.y + cellCoord.y) * gridSize.x + cellCoord.x;
+}
+#else
+uniform vec2 resolution;
 uniform ivec2 gridSize;
 
 // Position to cell index (mod wraps pos to [0, resolution), so cellCoord is always valid)
@@ -21,6 +58,22 @@ int positionToCell(vec2 pos)
 }
 #endif
 
+int agentCell(uint id)
+{
+    // Calculate float offset (agentStride and positionOffset are in bytes, floats are 4 bytes)
+    int floatStride = agentStride / 4;
+    int floatOffset = positionOffset / 4;
+    int baseIndex = int(id) * floatStride + floatOffset;
+
+#ifdef GRID_3D
+    return positionToCell(vec3(positionData[baseIndex], positionData[baseIndex + 1],
+                               positionData[baseIndex + 2]));
+#else
+    return positionToCell(vec2(positionData[baseIndex], positionData[baseIndex + 1]));
+#endif
+}
+#endif
+
 #ifdef KERNEL_CLEAR
 
 layout(local_size_x = 1024) in;
@@ -46,18 +99,10 @@ void main()
 
 layout(local_size_x = 1024) in;
 
-layout(std430, binding = 0) buffer Positions {
-    float positionData[];
-};
-
 layout(std430, binding = 1) buffer CellCounts {
     uint cellCounts[];
 };
 
-uniform int agentCount;
-uniform int agentStride;    // Bytes between agents
-uniform int positionOffset; // Byte offset to position within agent struct
-
 void main()
 {
     uint id = gl_GlobalInvocationID.x;
@@ -65,22 +110,64 @@ void main()
         return;
     }
 
-    // Calculate float offset (agentStride and positionOffset are in bytes, floats are 4 bytes)
-    int floatStride = agentStride / 4;
-    int floatOffset = positionOffset / 4;
-    int baseIndex = int(id) * floatStride + floatOffset;
-
-    vec2 pos = vec2(positionData[baseIndex], positionData[baseIndex + 1]);
-    int cell = positionToCell(pos);
-    atomicAdd(cellCounts[cell], 1u);
+    atomicAdd(cellCounts[agentCell(id)], 1u);
 }
 
 #endif // KERNEL_COUNT
 
-#ifdef KERNEL_PREFIX_SUM
+#if defined(KERNEL_SCAN_BLOCKS) || defined(KERNEL_SCAN_BLOCK_SUMS)
 
-// Serial prefix sum for small grids (<10k cells)
-layout(local_size_x = 1) in;
+layout(local_size_x = SCAN_THREADS) in;
+
+#ifdef USE_SUBGROUPS
+shared uint subgroupTotals[SCAN_THREADS];
+#else
+shared uint scanScratch[SCAN_THREADS];
+#endif
+
+// Inclusive sum of value over invocations 0..gl_LocalInvocationIndex
+uint workgroupInclusiveScan(uint value)
+{
+    uint lid = gl_LocalInvocationIndex;
+#ifdef USE_SUBGROUPS
+    uint scan = subgroupInclusiveAdd(value);
+    uint total = subgroupAdd(value);
+    if (subgroupElect()) {
+        subgroupTotals[gl_SubgroupID] = total;
+    }
+    barrier();
+    // A handful of subgroup totals: one invocation scans them
+    if (lid == 0u) {
+        uint sum = 0u;
+        for (uint i = 0u; i < gl_NumSubgroups; i++) {
+            uint t = subgroupTotals[i];
+            subgroupTotals[i] = sum;
+            sum += t;
+        }
+    }
+    barrier();
+    uint result = scan + subgroupTotals[gl_SubgroupID];
+    barrier();
+    return result;
+#else
+    // Hillis-Steele over shared memory
+    scanScratch[lid] = value;
+    barrier();
+    for (uint offset = 1u; offset < SCAN_THREADS; offset <<= 1) {
+        uint add = (lid >= offset) ? scanScratch[lid - offset] : 0u;
+        barrier();
+        scanScratch[lid] += add;
+        barrier();
+    }
+    uint result = scanScratch[lid];
+    barrier();
+    return result;
+#endif
+}
+
+#endif
+
+#ifdef KERNEL_SCAN_BLOCKS
 
 layout(std430, binding = 0) buffer CellCounts {
     uint cellCounts[];
@@ -90,39 +177,150 @@ layout(std430, binding = 1) buffer CellOffsets {
     uint cellOffsets[];
 };
 
+layout(std430, binding = 2) buffer BlockSums {
+    uint blockSums[];
+};
+
 uniform int totalCells;
 
 void main()
 {
+    uint base = gl_WorkGroupID.x * SCAN_BLOCK + gl_LocalInvocationIndex * SCAN_ITEMS;
+
+    // Serial scan of this invocation's cells, then one workgroup scan of the totals
+    uint items[SCAN_ITEMS];
     uint sum = 0u;
-    for (int i = 0; i < totalCells; i++) {
-        sum += cellCounts[i];
-        cellOffsets[i] = sum;
+    for (int i = 0; i < SCAN_ITEMS; i++) {
+        uint idx = base + uint(i);
+        sum += (idx < uint(totalCells)) ? cellCounts[idx] : 0u;
+        items[i] = sum;
+    }
+    uint prefix = workgroupInclusiveScan(sum) - sum;
+
+    for (int i = 0; i < SCAN_ITEMS; i++) {
+        uint idx = base + uint(i);
+        if (idx < uint(totalCells)) {
+            cellOffsets[idx] = prefix + items[i];
+        }
+    }
+    if (gl_LocalInvocationIndex == SCAN_THREADS - 1) {
+        blockSums[gl_WorkGroupID.x] = prefix + sum;
     }
 }
 
-#endif // KERNEL_PREFIX_SUM
+#endif // KERNEL_SCAN_BLOCKS
 
-#ifdef KERNEL_SCATTER
+#ifdef KERNEL_SCAN_BLOCK_SUMS
+
+layout(std430, binding = 0) buffer BlockSums {
+    uint blockSums[];
+};
+
+uniform int blockCount;
+
+shared uint chunkTotal;
+
+void main()
+{
+    // SCAN_BLOCK block totals per step, so even very large grids take few steps
+    uint carry = 0u;
+    for (uint chunk = 0u; chunk < uint(blockCount); chunk += SCAN_BLOCK) {
+        uint base = chunk + gl_LocalInvocationIndex * SCAN_ITEMS;
+
+        uint items[SCAN_ITEMS];
+        uint sum = 0u;
+        for (int i = 0; i < SCAN_ITEMS; i++) {
+            uint idx = base + uint(i);
+            sum += (idx < uint(blockCount)) ? blockSums[idx] : 0u;
+            items[i] = sum;
+        }
+        uint prefix = workgroupInclusiveScan(sum) - sum;
+
+        for (int i = 0; i < SCAN_ITEMS; i++) {
+            uint idx = base + uint(i);
+            if (idx < uint(blockCount)) {
+                blockSums[idx] = carry + prefix + items[i];
+            }
+        }
+        if (gl_LocalInvocationIndex == SCAN_THREADS - 1) {
+            chunkTotal = prefix + sum;
+        }
+        barrier();
+        carry += chunkTotal;
+        barrier();
+    }
+}
+
+#endif // KERNEL_SCAN_BLOCK_SUMS
+
+#ifdef KERNEL_ADD_BLOCK_OFFSETS
+
+layout(local_size_x = SCAN_THREADS) in;
+
+layout(std430, binding = 1) buffer CellOffsets {
+    uint cellOffsets[];
+};
+
+layout(std430, binding = 2) buffer BlockSums {
+    uint blockSums[]; // Inclusive scan of block totals
+};
+
+uniform int totalCells;
+
+void main()
+{
+    // Block 0 has nothing before it; dispatched from block 1
+    uint block = gl_WorkGroupID.x + 1u;
+    uint add = blockSums[block - 1u];
+    uint base = block * SCAN_BLOCK + gl_LocalInvocationIndex * SCAN_ITEMS;
+    for (int i = 0; i < SCAN_ITEMS; i++) {
+        uint idx = base + uint(i);
+        if (idx < uint(totalCells)) {
+            cellOffsets[idx] += add;
+        }
+    }
+}
+
+#endif // KERNEL_ADD_BLOCK_OFFSETS
+
+#ifdef KERNEL_RESTORE
 
 layout(local_size_x = 1024) in;
 
-layout(std430, binding = 0) buffer Positions {
-    float positionData[];
+layout(std430, binding = 0) buffer CellCounts {
+    uint cellCounts[];
 };
 
 layout(std430, binding = 1) buffer CellOffsets {
     uint cellOffsets[];
 };
 
+uniform int totalCells;
+
+void main()
+{
+    // Scatter leaves each offset at its cell's start; add the count back to reach the end
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uint(totalCells)) {
+        return;
+    }
+    cellOffsets[id] += cellCounts[id];
+}
+
+#endif // KERNEL_RESTORE
+
+#ifdef KERNEL_SCATTER
+
+layout(local_size_x = 1024) in;
+
+layout(std430, binding = 1) buffer CellOffsets {
+    uint cellOffsets[];
+};
+
 layout(std430, binding = 2) buffer SortedIndices {
     uint sortedIndices[];
 };
 
-uniform int agentCount;
-uniform int agentStride;
-uniform int positionOffset;
-
 void main()
 {
     uint id = gl_GlobalInvocationID.x;
@@ -130,12 +328,7 @@ void main()
         return;
     }
 
-    int floatStride = agentStride / 4;
-    int floatOffset = positionOffset / 4;
-    int baseIndex = int(id) * floatStride + floatOffset;
-
-    vec2 pos = vec2(positionData[baseIndex], positionData[baseIndex + 1]);
-    int cell = positionToCell(pos);
+    int cell = agentCell(id);
 
     // Get slot via atomic decrement on offset (offsets point to end of each cell's range)
     // We decrement to get slots from back to front
@@ -144,3 +337,80 @@ void main()
 }
 
 #endif // KERNEL_SCATTER
+
+#ifdef KERNEL_REORDER
+
+layout(local_size_x = 1024) in;
+
+layout(std430, binding = 0) readonly buffer SourceAgents {
+    uint sourceWords[];
+};
+
+layout(std430, binding = 1) writeonly buffer SortedAgents {
+    uint sortedWords[];
+};
+
+layout(std430, binding = 2) buffer SortedIndices {
+    uint sortedIndices[];
+};
+
+uniform int agentCount;
+uniform int agentWords; // 4-byte words per agent struct
+
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uint(agentCount)) {
+        return;
+    }
+
+    uint src = sortedIndices[id] * uint(agentWords);
+    uint dst = id * uint(agentWords);
+    for (int w = 0; w < agentWords; w++) {
+        sortedWords[dst + uint(w)] = sourceWords[src + uint(w)];
+    }
+
+    // Agent id now sits at slot id; each invocation owns its slot, so no race
+    sortedIndices[id] = id;
+}
+
+#endif // KERNEL_REORDER
+
+#ifdef KERNEL_THIN
+
+layout(local_size_x = 1024) in;
+
+layout(std430, binding = 0) readonly buffer SourceAgents {
+    uint sourceWords[];
+};
+
+layout(std430, binding = 1) writeonly buffer ThinnedAgents {
+    uint thinnedWords[];
+};
+
+layout(std430, binding = 2) readonly buffer SortedIndices {
+    uint sortedIndices[];
+};
+
+uniform int agentCount;   // Agents to keep
+uniform int agentWords;   // 4-byte words per agent struct
+uniform int sourceCount;  // Agents in the last build
+uniform float sourceStep; // Sorted slots per kept agent (sourceCount / agentCount)
+
+void main()
+{
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uint(agentCount)) {
+        return;
+    }
+
+    // Every sourceStep-th agent in cell order, so each cell keeps its share
+    uint slot = min(uint(float(id) * sourceStep), uint(sourceCount - 1));
+    uint src = sortedIndices[slot] * uint(agentWords);
+    uint dst = id * uint(agentWords);
+    for (int w = 0; w < agentWords; w++) {
+        thinnedWords[dst + uint(w)] = sourceWords[src + uint(w)];
+    }
+}
+
+#endif // KERNEL_THIN
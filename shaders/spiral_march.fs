@@ -8,6 +8,10 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// Interleaved rendering: shade only this frame's quad slot (count <= 1 = all)
+uniform int interleaveCount;
+uniform int interleavePhase;
+
 uniform vec2 resolution;
 uniform sampler2D fftTexture;
 uniform sampler2D gradientLUT;
@@ -90,6 +94,15 @@ float sampleFFTBand(float freqT0, float freqT1) {
 }
 
 void main() {
+    if (interleaveCount > 1) {
+        ivec2 q = ivec2(gl_FragCoord.xy) / 2;
+        int slot = interleaveCount == 2 ? (q.x + q.y) & 1
+                                        : (q.x & 1) + 2 * (q.y & 1);
+        if (slot != interleavePhase) {
+            discard;
+        }
+    }
+
     // Centered coords: (0,0) at screen center, y in [-1, 1].
     // Equivalent to the reference's `(fragCoord*2 - iResolution.xy)/iResolution.y`,
     // adapted to raylib's normalized fragTexCoord (Shadertoy fragCoord doesn't exist here).
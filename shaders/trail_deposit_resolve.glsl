@@ -0,0 +1,42 @@
+#version 430
+
+// Folds the deposit sums agent shaders accumulate on a downsampled trail map
+// into it, with their proportional overflow scaling, and zeros the sums for
+// the next step.
+layout(local_size_x = 16, local_size_y = 16) in;
+
+layout(rgba32f, binding = 1) uniform image2D trailMap;
+
+layout(std430, binding = 6) buffer DepositBuffer {
+    uint deposits[];  // RGB per texel, fixed point
+};
+
+const float DEPOSIT_SCALE = 65536.0;  // Matches the agent shaders
+
+void main()
+{
+    ivec2 size = imageSize(trailMap);
+    ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
+    if (coord.x >= size.x || coord.y >= size.y) {
+        return;
+    }
+
+    uint i = uint(coord.y * size.x + coord.x) * 3u;
+    uvec3 sum = uvec3(deposits[i], deposits[i + 1u], deposits[i + 2u]);
+    if (sum == uvec3(0u)) {
+        return;
+    }
+    deposits[i] = 0u;
+    deposits[i + 1u] = 0u;
+    deposits[i + 2u] = 0u;
+
+    vec3 newColor = imageLoad(trailMap, coord).rgb + vec3(sum) / DEPOSIT_SCALE;
+
+    // Scale proportionally to prevent overflow while preserving color ratios
+    float maxChan = max(newColor.r, max(newColor.g, newColor.b));
+    if (maxChan > 1.0) {
+        newColor /= maxChan;
+    }
+
+    imageStore(trailMap, coord, vec4(newColor, 0.0));
+}
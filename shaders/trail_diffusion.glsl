@@ -1,32 +1,71 @@
 #version 430
 
+// Diffuses and decays up to 6 trail maps per dispatch; gl_GlobalInvocationID.z
+// picks the map. Horizontal pass: map -> its scratch layer. Vertical pass
+// with decay: scratch layer -> map.
 layout(local_size_x = 16, local_size_y = 16) in;
 
-layout(rgba32f, binding = 1) readonly uniform image2D inputMap;
-layout(rgba32f, binding = 2) writeonly uniform image2D outputMap;
+layout(rgba32f, binding = 0) uniform image2DArray scratch;
+layout(rgba32f, binding = 1) uniform image2D map0;
+layout(rgba32f, binding = 2) uniform image2D map1;
+layout(rgba32f, binding = 3) uniform image2D map2;
+layout(rgba32f, binding = 4) uniform image2D map3;
+layout(rgba32f, binding = 5) uniform image2D map4;
+layout(rgba32f, binding = 6) uniform image2D map5;
 
-uniform vec2 resolution;
-uniform int diffusionScale;
-uniform float decayFactor;  // Pre-computed: exp(-0.693147 * dt / halfLife)
-uniform int applyDecay;     // 1 for V-pass, 0 for H-pass
-uniform int direction;      // 0 = horizontal, 1 = vertical
+uniform ivec2 resolution[6];
+uniform int diffusionScale[6];
+uniform float decayFactor[6];  // Pre-computed: exp(-0.693147 * dt / halfLife)
+uniform int direction;         // 0 = horizontal, 1 = vertical with decay
+
+// Image uniforms can't be indexed dynamically, so select them by case
+vec4 LoadMap(int m, ivec2 coord)
+{
+    switch (m) {
+    case 0: return imageLoad(map0, coord);
+    case 1: return imageLoad(map1, coord);
+    case 2: return imageLoad(map2, coord);
+    case 3: return imageLoad(map3, coord);
+    case 4: return imageLoad(map4, coord);
+    default: return imageLoad(map5, coord);
+    }
+}
+
+void StoreMap(int m, ivec2 coord, vec4 value)
+{
+    switch (m) {
+    case 0: imageStore(map0, coord, value); break;
+    case 1: imageStore(map1, coord, value); break;
+    case 2: imageStore(map2, coord, value); break;
+    case 3: imageStore(map3, coord, value); break;
+    case 4: imageStore(map4, coord, value); break;
+    default: imageStore(map5, coord, value); break;
+    }
+}
+
+vec4 LoadInput(int m, ivec2 coord)
+{
+    return (direction == 0) ? LoadMap(m, coord)
+                            : imageLoad(scratch, ivec3(coord, m));
+}
 
 void main()
 {
+    int m = int(gl_GlobalInvocationID.z);
     ivec2 coord = ivec2(gl_GlobalInvocationID.xy);
-    if (coord.x >= int(resolution.x) || coord.y >= int(resolution.y)) {
+    ivec2 res = resolution[m];
+    if (coord.x >= res.x || coord.y >= res.y) {
         return;
     }
 
     vec4 result;
-    if (diffusionScale == 0) {
-        result = imageLoad(inputMap, coord);
+    if (diffusionScale[m] == 0) {
+        result = LoadInput(m, coord);
     } else {
         // Dense unit-stride Gaussian: sigma = diffusionScale, radius = ceil(3 sigma)
         ivec2 offset = (direction == 0) ? ivec2(1, 0) : ivec2(0, 1);
-        ivec2 res = ivec2(resolution);
 
-        float sigma = float(diffusionScale);
+        float sigma = float(diffusionScale[m]);
         float twoSigma2 = 2.0 * sigma * sigma;
         int radius = int(ceil(3.0 * sigma));
 
@@ -35,15 +74,15 @@ void main()
         for (int i = -radius; i <= radius; i++) {
             float w = exp(-float(i * i) / twoSigma2);
             ivec2 s = ivec2(mod(vec2(coord + i * offset), vec2(res)));
-            sum += imageLoad(inputMap, s) * w;
+            sum += LoadInput(m, s) * w;
             wsum += w;
         }
         result = sum / wsum;
     }
 
-    if (applyDecay == 1) {
-        result *= decayFactor;
+    if (direction == 0) {
+        imageStore(scratch, ivec3(coord, m), result);
+    } else {
+        StoreMap(m, coord, result * decayFactor[m]);
     }
-
-    imageStore(outputMap, coord, result);
 }
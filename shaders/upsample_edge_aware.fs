@@ -0,0 +1,48 @@
+#version 330
+
+// Joint bilateral upsample for reduced-resolution effect passes. Each of the
+// four nearest low-res texels is weighted by its bilinear footprint and by
+// how closely the low-res scene luma at that texel matches the full-res
+// scene luma here, so results do not bleed across scene edges.
+
+in vec2 fragTexCoord;
+out vec4 finalColor;
+
+uniform sampler2D texture0;     // Low-res effect output
+uniform sampler2D guideLow;     // Low-res copy of the effect input
+uniform sampler2D guideHigh;    // Full-res effect input
+uniform vec2 lowResolution;
+uniform float rangeSigma;
+
+float luma(vec3 c)
+{
+    return dot(c, vec3(0.2126, 0.7152, 0.0722));
+}
+
+void main()
+{
+    float centerLuma = luma(texture(guideHigh, fragTexCoord).rgb);
+
+    vec2 pos = fragTexCoord * lowResolution - 0.5;
+    vec2 base = floor(pos);
+    vec2 f = pos - base;
+
+    vec4 sum = vec4(0.0);
+    float weightSum = 0.0;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            vec2 offset = vec2(float(x), float(y));
+            vec2 uv = (base + offset + 0.5) / lowResolution;
+
+            vec2 bw = mix(1.0 - f, f, offset);
+            float d = luma(texture(guideLow, uv).rgb) - centerLuma;
+            float w = bw.x * bw.y * exp(-(d * d) / (2.0 * rangeSigma * rangeSigma));
+
+            sum += texture(texture0, uv) * w;
+            weightSum += w;
+        }
+    }
+
+    // All four taps rejected: fall back to plain bilinear
+    finalColor = weightSum > 1e-4 ? sum / weightSum : texture(texture0, fragTexCoord);
+}
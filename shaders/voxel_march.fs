@@ -7,6 +7,10 @@
 in vec2 fragTexCoord;
 out vec4 finalColor;
 
+// Interleaved rendering: shade only this frame's quad slot (count <= 1 = all)
+uniform int interleaveCount;
+uniform int interleavePhase;
+
 uniform vec2 resolution;
 uniform sampler2D fftTexture;
 uniform float sampleRate;
@@ -61,6 +65,15 @@ float sampleFFTBand(float freqT0, float freqT1) {
 }
 
 void main() {
+    if (interleaveCount > 1) {
+        ivec2 q = ivec2(gl_FragCoord.xy) / 2;
+        int slot = interleaveCount == 2 ? (q.x + q.y) & 1
+                                        : (q.x & 1) + 2 * (q.y & 1);
+        if (slot != interleavePhase) {
+            discard;
+        }
+    }
+
     vec2 uv = fragTexCoord * 2.0 - 1.0;
     uv.x *= resolution.x / resolution.y;
     vec3 rd = normalize(vec3(uv, 1.0));
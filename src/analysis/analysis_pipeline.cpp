@@ -1,4 +1,5 @@
 #include "analysis_pipeline.h"
+#include "render/cpu_profiler.h"
 #include <math.h>
 #include <string.h>
 
@@ -56,25 +57,9 @@ void AnalysisPipelineUninit(AnalysisPipeline *pipeline) {
   FFTProcessorUninit(&pipeline->fft);
 }
 
-void AnalysisPipelineProcess(AnalysisPipeline *pipeline, AudioCapture *capture,
-                             float deltaTime) {
-  if (pipeline == NULL || capture == NULL) {
-    return;
-  }
-
-  const uint32_t available = AudioCaptureAvailable(capture);
-  if (available == 0) {
-    BeatDetectorProcess(&pipeline->beat, NULL, 0, deltaTime);
-    return;
-  }
-
-  uint32_t framesToRead = available;
-  if (framesToRead > AUDIO_MAX_FRAMES_PER_UPDATE) {
-    framesToRead = AUDIO_MAX_FRAMES_PER_UPDATE;
-  }
-
-  pipeline->lastFramesRead =
-      AudioCaptureRead(capture, pipeline->audioBuffer, framesToRead);
+// Runs FFT and feature extraction over the lastFramesRead frames already in
+// audioBuffer
+static void AnalyzeAudioBuffer(AnalysisPipeline *pipeline, float deltaTime) {
   if (pipeline->lastFramesRead == 0) {
     BeatDetectorProcess(&pipeline->beat, NULL, 0, deltaTime);
     return;
@@ -114,6 +99,51 @@ void AnalysisPipelineProcess(AnalysisPipeline *pipeline, AudioCapture *capture,
   }
 }
 
+void AnalysisPipelineProcess(AnalysisPipeline *pipeline, AudioCapture *capture,
+                             float deltaTime) {
+  CPU_ZONE("AnalysisPipelineProcess");
+  if (pipeline == NULL || capture == NULL) {
+    return;
+  }
+
+  const uint32_t available = AudioCaptureAvailable(capture);
+  if (available == 0) {
+    BeatDetectorProcess(&pipeline->beat, NULL, 0, deltaTime);
+    return;
+  }
+
+  uint32_t framesToRead = available;
+  if (framesToRead > AUDIO_MAX_FRAMES_PER_UPDATE) {
+    framesToRead = AUDIO_MAX_FRAMES_PER_UPDATE;
+  }
+
+  pipeline->lastFramesRead =
+      AudioCaptureRead(capture, pipeline->audioBuffer, framesToRead);
+  AnalyzeAudioBuffer(pipeline, deltaTime);
+}
+
+void AnalysisPipelineProcessBuffer(AnalysisPipeline *pipeline,
+                                   const float *samples, uint32_t frameCount,
+                                   float deltaTime) {
+  CPU_ZONE("AnalysisPipelineProcess");
+  if (pipeline == NULL) {
+    return;
+  }
+
+  if (samples == NULL) {
+    frameCount = 0;
+  }
+  if (frameCount > AUDIO_MAX_FRAMES_PER_UPDATE) {
+    frameCount = AUDIO_MAX_FRAMES_PER_UPDATE;
+  }
+  if (frameCount > 0) {
+    memcpy(pipeline->audioBuffer, samples,
+           (size_t)frameCount * AUDIO_CHANNELS * sizeof(float));
+  }
+  pipeline->lastFramesRead = frameCount;
+  AnalyzeAudioBuffer(pipeline, deltaTime);
+}
+
 void AnalysisPipelineUpdateWaveformHistory(AnalysisPipeline *pipeline) {
   if (pipeline == NULL) {
     return;
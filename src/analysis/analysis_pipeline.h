@@ -27,6 +27,12 @@ void AnalysisPipelineUninit(AnalysisPipeline *pipeline);
 void AnalysisPipelineProcess(AnalysisPipeline *pipeline, AudioCapture *capture,
                              float deltaTime);
 
+// Analyze caller-supplied interleaved frames instead of live capture (offline
+// rendering). frameCount is clamped to AUDIO_MAX_FRAMES_PER_UPDATE.
+void AnalysisPipelineProcessBuffer(AnalysisPipeline *pipeline,
+                                   const float *samples, uint32_t frameCount,
+                                   float deltaTime);
+
 // Update waveform history for ripple tank (call every frame for smooth
 // gradients)
 void AnalysisPipelineUpdateWaveformHistory(AnalysisPipeline *pipeline);
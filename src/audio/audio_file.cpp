@@ -0,0 +1,65 @@
+#include "audio_file.h"
+#include "audio.h"
+#include "miniaudio.h"
+#include "raylib.h"
+#include <stdlib.h>
+
+struct AudioFile {
+  ma_decoder decoder;
+};
+
+AudioFile *AudioFileOpen(const char *path) {
+  if (path == NULL) {
+    return NULL;
+  }
+
+  AudioFile *file = static_cast<AudioFile *>(calloc(1, sizeof(AudioFile)));
+  if (file == NULL) {
+    return NULL;
+  }
+
+  const ma_decoder_config config =
+      ma_decoder_config_init(ma_format_f32, AUDIO_CHANNELS, AUDIO_SAMPLE_RATE);
+  if (ma_decoder_init_file(path, &config, &file->decoder) != MA_SUCCESS) {
+    TraceLog(LOG_WARNING, "AUDIO_FILE: Failed to decode %s", path);
+    free(file);
+    return NULL;
+  }
+
+  return file;
+}
+
+void AudioFileClose(AudioFile *file) {
+  if (file == NULL) {
+    return;
+  }
+  ma_decoder_uninit(&file->decoder);
+  free(file);
+}
+
+uint32_t AudioFileRead(AudioFile *file, float *buffer, uint32_t frameCount) {
+  if (file == NULL || buffer == NULL || frameCount == 0) {
+    return 0;
+  }
+
+  ma_uint64 framesRead = 0;
+  const ma_result result = ma_decoder_read_pcm_frames(&file->decoder, buffer,
+                                                      frameCount, &framesRead);
+  if (result != MA_SUCCESS && result != MA_AT_END) {
+    return 0;
+  }
+  return (uint32_t)framesRead;
+}
+
+uint64_t AudioFileLengthFrames(AudioFile *file) {
+  if (file == NULL) {
+    return 0;
+  }
+
+  ma_uint64 length = 0;
+  if (ma_decoder_get_length_in_pcm_frames(&file->decoder, &length) !=
+      MA_SUCCESS) {
+    return 0;
+  }
+  return (uint64_t)length;
+}
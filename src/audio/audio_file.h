@@ -0,0 +1,24 @@
+#ifndef AUDIO_FILE_H
+#define AUDIO_FILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Decoded audio file (wav/flac/mp3) resampled to the capture format, so it
+// can stand in for loopback capture during offline rendering
+typedef struct AudioFile AudioFile;
+
+// Open and decode to f32, AUDIO_CHANNELS, AUDIO_SAMPLE_RATE
+// Returns NULL on failure
+AudioFile *AudioFileOpen(const char *path);
+
+void AudioFileClose(AudioFile *file);
+
+// Read the next frames. Returns frames read; fewer than requested at EOF.
+// buffer must hold at least frameCount * AUDIO_CHANNELS floats
+uint32_t AudioFileRead(AudioFile *file, float *buffer, uint32_t frameCount);
+
+// Total length in output frames, or 0 if the decoder cannot tell
+uint64_t AudioFileLengthFrames(AudioFile *file);
+
+#endif // AUDIO_FILE_H
@@ -1,11 +1,12 @@
 #include "modulation_engine.h"
 #include "easing.h"
+#include "render/cpu_profiler.h"
 #include <algorithm>
 #include <cstring>
 #include <math.h>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-#include <vector>
 
 struct ParamMeta {
   float *ptr;
@@ -14,9 +15,38 @@ struct ParamMeta {
   float base;
 };
 
-static std::unordered_map<std::string, ParamMeta> sParams;
-static std::unordered_map<std::string, ModRoute> sRoutes;
-static std::unordered_map<std::string, float> sOffsets;
+// Transparent hash so lookups by const char * from UI sliders and the frame
+// loop do not build a std::string per call
+struct ParamIdHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view id) const {
+    return std::hash<std::string_view>{}(id);
+  }
+};
+
+template <typename T>
+using ParamMap =
+    std::unordered_map<std::string, T, ParamIdHash, std::equal_to<>>;
+
+static ParamMap<ParamMeta> sParams;
+static ParamMap<ModRoute> sRoutes;
+static ParamMap<float> sOffsets;
+
+static bool HasPrefix(std::string_view id, std::string_view prefix) {
+  return id.substr(0, prefix.size()) == prefix;
+}
+
+// Reset a param's modulation offset and value to its base
+static void ResetToBase(std::string_view id) {
+  const auto offsetIt = sOffsets.find(id);
+  if (offsetIt != sOffsets.end()) {
+    offsetIt->second = 0.0f;
+  }
+  const auto it = sParams.find(id);
+  if (it != sParams.end() && it->second.ptr != NULL) {
+    *it->second.ptr = it->second.base;
+  }
+}
 
 static float BipolarEase(float x, float (*ease)(float)) {
   const float sign = (x >= 0.0f) ? 1.0f : -1.0f;
@@ -58,10 +88,8 @@ void ModEngineUninit(void) {
 
 void ModEngineRegisterParam(const char *paramId, float *ptr, float min,
                             float max) {
-  const std::string id(paramId);
-
   // Check if already registered
-  auto it = sParams.find(id);
+  auto it = sParams.find(std::string_view(paramId));
   if (it != sParams.end()) {
     // Update pointer in case it changed, keep existing base
     it->second.ptr = ptr;
@@ -75,71 +103,57 @@ void ModEngineRegisterParam(const char *paramId, float *ptr, float min,
   meta.min = min;
   meta.max = max;
   meta.base = *ptr;
+  const std::string id(paramId);
   sParams[id] = meta;
   sOffsets[id] = 0.0f;
 }
 
 void ModEngineSetRoute(const char *paramId, const ModRoute *route) {
-  const std::string id(paramId);
-  sRoutes[id] = *route;
+  const auto it = sRoutes.find(std::string_view(paramId));
+  if (it != sRoutes.end()) {
+    it->second = *route;
+    return;
+  }
+  sRoutes.emplace(paramId, *route);
 }
 
 void ModEngineRemoveRoute(const char *paramId) {
-  const std::string id(paramId);
-  sRoutes.erase(id);
-  sOffsets[id] = 0.0f;
-
-  // Reset param to base value
-  auto it = sParams.find(id);
-  if (it != sParams.end() && it->second.ptr != NULL) {
-    *it->second.ptr = it->second.base;
+  const auto it = sRoutes.find(std::string_view(paramId));
+  if (it == sRoutes.end()) {
+    ResetToBase(paramId);
+    return;
   }
+  ResetToBase(it->first);
+  sRoutes.erase(it);
 }
 
+// Erase in place; erase() returns the next iterator, so no ID list is built
 void ModEngineRemoveRoutesMatching(const char *prefix) {
-  const std::string pfx(prefix);
-  const size_t pfxLen = pfx.size();
-
-  // Collect matching route IDs (avoid iterator invalidation during erase)
-  std::vector<std::string> toRemove;
-  for (const auto &[id, route] : sRoutes) {
-    if (id.size() >= pfxLen && id.compare(0, pfxLen, pfx) == 0) {
-      toRemove.push_back(id);
-    }
-  }
-
-  // Remove each matching route
-  for (const auto &id : toRemove) {
-    sRoutes.erase(id);
-    sOffsets[id] = 0.0f;
-
-    auto it = sParams.find(id);
-    if (it != sParams.end() && it->second.ptr != NULL) {
-      *it->second.ptr = it->second.base;
+  const std::string_view pfx(prefix);
+  for (auto it = sRoutes.begin(); it != sRoutes.end();) {
+    if (HasPrefix(it->first, pfx)) {
+      ResetToBase(it->first);
+      it = sRoutes.erase(it);
+    } else {
+      ++it;
     }
   }
 }
 
 void ModEngineRemoveParamsMatching(const char *prefix) {
-  const std::string pfx(prefix);
-  const size_t pfxLen = pfx.size();
-
-  std::vector<std::string> toRemove;
-  for (const auto &[id, meta] : sParams) {
-    if (id.size() >= pfxLen && id.compare(0, pfxLen, pfx) == 0) {
-      toRemove.push_back(id);
+  const std::string_view pfx(prefix);
+  for (auto it = sParams.begin(); it != sParams.end();) {
+    if (HasPrefix(it->first, pfx)) {
+      sOffsets.erase(it->first);
+      it = sParams.erase(it);
+    } else {
+      ++it;
     }
   }
-
-  for (const auto &id : toRemove) {
-    sParams.erase(id);
-    sOffsets.erase(id);
-  }
 }
 
 bool ModEngineGetRoute(const char *paramId, ModRoute *outRoute) {
-  const std::string id(paramId);
-  auto it = sRoutes.find(id);
+  auto it = sRoutes.find(std::string_view(paramId));
   if (it == sRoutes.end()) {
     return false;
   }
@@ -148,6 +162,7 @@ bool ModEngineGetRoute(const char *paramId, ModRoute *outRoute) {
 }
 
 void ModEngineUpdate(float dt, const ModSources *sources) {
+  CPU_ZONE("ModEngineUpdate");
   (void)dt; // Currently unused, may be needed for smoothing later
 
   for (auto &[id, route] : sRoutes) {
@@ -173,7 +188,10 @@ void ModEngineUpdate(float dt, const ModSources *sources) {
     // Calculate offset: curved * amount * range
     const float range = meta.max - meta.min;
     const float offset = curved * route.amount * range;
-    sOffsets[id] = offset;
+    const auto offsetIt = sOffsets.find(id);
+    if (offsetIt != sOffsets.end()) {
+      offsetIt->second = offset;
+    }
 
     // Write modulated value (base + offset, clamped)
     float modulated = meta.base + offset;
@@ -183,8 +201,7 @@ void ModEngineUpdate(float dt, const ModSources *sources) {
 }
 
 float ModEngineGetBase(const char *paramId) {
-  const std::string id(paramId);
-  auto it = sParams.find(id);
+  auto it = sParams.find(std::string_view(paramId));
   if (it == sParams.end()) {
     return 0.0f;
   }
@@ -193,8 +210,7 @@ float ModEngineGetBase(const char *paramId) {
 
 bool ModEngineGetParamBounds(const char *paramId, float *outMin,
                              float *outMax) {
-  const std::string id(paramId);
-  auto it = sParams.find(id);
+  auto it = sParams.find(std::string_view(paramId));
   if (it == sParams.end()) {
     return false;
   }
@@ -204,8 +220,7 @@ bool ModEngineGetParamBounds(const char *paramId, float *outMin,
 }
 
 void ModEngineSetBase(const char *paramId, float base) {
-  const std::string id(paramId);
-  auto it = sParams.find(id);
+  auto it = sParams.find(std::string_view(paramId));
   if (it != sParams.end()) {
     it->second.base = base;
   }
@@ -231,7 +246,10 @@ void ModEngineClearRoutes(void) {
     if (paramIt != sParams.end() && paramIt->second.ptr != NULL) {
       *paramIt->second.ptr = paramIt->second.base;
     }
-    sOffsets[id] = 0.0f;
+    const auto offsetIt = sOffsets.find(id);
+    if (offsetIt != sOffsets.end()) {
+      offsetIt->second = 0.0f;
+    }
   }
   sRoutes.clear();
 }
@@ -322,6 +322,26 @@ enum TransformEffectType {
   TRANSFORM_EFFECT_COUNT
 };
 
+// Per-effect render resolution. DEFAULT defers to the descriptor:
+// EFFECT_FLAG_HALF_RES effects run at half, everything else at full.
+enum EffectResolutionTier {
+  RES_TIER_DEFAULT = 0,
+  RES_TIER_FULL,
+  RES_TIER_THREE_QUARTER,
+  RES_TIER_HALF,
+  RES_TIER_QUARTER,
+  RES_TIER_COUNT
+};
+
+// Temporal interleave for EFFECT_FLAG_INTERLEAVED generators: shade 1/2 or
+// 1/4 of the pixels each frame and reconstruct the rest from history
+enum EffectInterleaveMode {
+  INTERLEAVE_OFF = 0,
+  INTERLEAVE_CHECKER,
+  INTERLEAVE_QUAD,
+  INTERLEAVE_MODE_COUNT
+};
+
 struct TransformOrderConfig {
   TransformEffectType order[TRANSFORM_EFFECT_COUNT];
 
@@ -898,6 +918,12 @@ struct EffectConfig {
 
   // Transform effect execution order
   TransformOrderConfig transformOrder;
+
+  // Render resolution per effect, indexed by TransformEffectType
+  EffectResolutionTier resolutionTier[TRANSFORM_EFFECT_COUNT] = {};
+
+  // Interleave mode per effect, indexed by TransformEffectType
+  EffectInterleaveMode interleave[TRANSFORM_EFFECT_COUNT] = {};
 };
 
 #endif // EFFECT_CONFIG_H
@@ -1,4 +1,5 @@
 #include "effect_descriptor.h"
+#include <math.h>
 #include <stddef.h>
 
 // Zero-initialized table - slots populated by REGISTER_EFFECT* macros at
@@ -34,3 +35,109 @@ bool IsDescriptorEnabled(const EffectConfig *e, TransformEffectType type) {
   return *reinterpret_cast<const bool *>(
       base + EFFECT_DESCRIPTORS[type].enabledOffset);
 }
+
+bool EffectDescriptorSupportsTiers(TransformEffectType type) {
+  if (type < 0 || type >= TRANSFORM_EFFECT_COUNT) {
+    return false;
+  }
+  // These manage their own intermediate targets in dedicated pipeline branches
+  if (type == TRANSFORM_BLOOM || type == TRANSFORM_ANAMORPHIC_STREAK ||
+      type == TRANSFORM_OIL_PAINT || type == TRANSFORM_ACCUM_COMPOSITE) {
+    return false;
+  }
+  const EffectDescriptor &d = EFFECT_DESCRIPTORS[type];
+  return d.render == nullptr && (d.flags & EFFECT_FLAG_SIM_BOOST) == 0;
+}
+
+EffectResolutionTier EffectDescriptorResolutionTier(const EffectConfig *e,
+                                                    TransformEffectType type) {
+  if (e == NULL || !EffectDescriptorSupportsTiers(type)) {
+    return RES_TIER_FULL;
+  }
+  const EffectResolutionTier tier = e->resolutionTier[type];
+  if (tier > RES_TIER_DEFAULT && tier < RES_TIER_COUNT) {
+    return tier;
+  }
+  if ((EFFECT_DESCRIPTORS[type].flags & EFFECT_FLAG_HALF_RES) != 0) {
+    return RES_TIER_HALF;
+  }
+  return RES_TIER_FULL;
+}
+
+int EffectDescriptorInterleaveCount(const EffectConfig *e,
+                                    TransformEffectType type) {
+  if (e == NULL || type < 0 || type >= TRANSFORM_EFFECT_COUNT ||
+      (EFFECT_DESCRIPTORS[type].flags & EFFECT_FLAG_INTERLEAVED) == 0) {
+    return 1;
+  }
+  switch (e->interleave[type]) {
+  case INTERLEAVE_CHECKER:
+    return 2;
+  case INTERLEAVE_QUAD:
+    return 4;
+  default:
+    return 1;
+  }
+}
+
+bool EffectDescriptorRegisterQuality(TransformEffectType type, size_t offset,
+                                     int minValue, int maxValue) {
+  EffectDescriptor &d = EFFECT_DESCRIPTORS[type];
+  if (d.qualityCount < EFFECT_QUALITY_PARAM_MAX) {
+    d.quality[d.qualityCount++] = {offset, minValue, maxValue};
+  }
+  return true;
+}
+
+static int *QualityField(EffectConfig *e, const EffectQualityParam &q) {
+  return reinterpret_cast<int *>(reinterpret_cast<char *>(e) + q.offset);
+}
+
+// Linear from minValue at LOD 0 to the configured value at LOD 1. Values
+// already at or below the floor are left alone.
+static int ScaleQualityValue(int configured, const EffectQualityParam &q,
+                             float level) {
+  const int top = configured > q.maxValue ? q.maxValue : configured;
+  if (top <= q.minValue) {
+    return configured;
+  }
+  return q.minValue + (int)roundf((float)(top - q.minValue) * level);
+}
+
+int EffectDescriptorApplyQuality(EffectConfig *e, TransformEffectType type,
+                                 float level,
+                                 int saved[EFFECT_QUALITY_PARAM_MAX]) {
+  if (e == NULL || type < 0 || type >= TRANSFORM_EFFECT_COUNT ||
+      level >= 1.0f) {
+    return 0;
+  }
+  const EffectDescriptor &d = EFFECT_DESCRIPTORS[type];
+  const float clamped = level < 0.0f ? 0.0f : level;
+  for (int i = 0; i < d.qualityCount; i++) {
+    int *field = QualityField(e, d.quality[i]);
+    saved[i] = *field;
+    *field = ScaleQualityValue(*field, d.quality[i], clamped);
+  }
+  return d.qualityCount;
+}
+
+void EffectDescriptorRestoreQuality(EffectConfig *e, TransformEffectType type,
+                                    const int saved[EFFECT_QUALITY_PARAM_MAX],
+                                    int count) {
+  for (int i = 0; i < count; i++) {
+    *QualityField(e, EFFECT_DESCRIPTORS[type].quality[i]) = saved[i];
+  }
+}
+
+float EffectResolutionTierScale(EffectResolutionTier tier) {
+  switch (tier) {
+  case RES_TIER_THREE_QUARTER:
+    return 0.75f;
+  case RES_TIER_HALF:
+    return 0.5f;
+  case RES_TIER_QUARTER:
+    return 0.25f;
+  default:
+    return 1.0f;
+  }
+}
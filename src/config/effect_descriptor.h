@@ -27,12 +27,27 @@ typedef Shader *(*GetShaderFn)(PostEffect *pe);
 typedef void (*DrawParamsFn)(EffectConfig *, const ModSources *, ImU32);
 typedef void (*DrawOutputFn)(EffectConfig *, const ModSources *);
 
+// Callback for a compute-dispatch variant of a fragment pass. Returns false
+// when the compute path is unavailable so the fragment pass runs instead.
+typedef bool (*ComputePassFn)(PostEffect *pe, const RenderTexture2D *source,
+                              const RenderTexture2D *dest);
+
 // Flag bitmask for effect routing and capabilities
 #define EFFECT_FLAG_NONE 0
 #define EFFECT_FLAG_BLEND 1
 #define EFFECT_FLAG_HALF_RES 2
 #define EFFECT_FLAG_SIM_BOOST 4
 #define EFFECT_FLAG_NEEDS_RESIZE 8
+#define EFFECT_FLAG_INTERLEAVED 16
+
+// Integer config fields the quality LOD controller may lower under load
+#define EFFECT_QUALITY_PARAM_MAX 2
+
+struct EffectQualityParam {
+  size_t offset; // Byte offset of the int field within EffectConfig
+  int minValue;  // Value used at LOD 0
+  int maxValue;  // Upper clamp for the configured value at LOD 1
+};
 
 struct EffectDescriptor {
   // Metadata
@@ -68,6 +83,13 @@ struct EffectDescriptor {
 
   // Pointer to file-local static <Name>Effect instance, or null for sim boosts
   void *state = nullptr;
+
+  // Tiled compute variant tried before the fragment pass (nullptr = none)
+  ComputePassFn compute = nullptr;
+
+  // Cost knobs registered via REGISTER_QUALITY_PARAM
+  EffectQualityParam quality[EFFECT_QUALITY_PARAM_MAX] = {};
+  int qualityCount = 0;
 };
 
 // Effect descriptor table indexed by TransformEffectType
@@ -102,6 +124,38 @@ inline bool IsTransformEnabled(const EffectConfig *e,
   return IsDescriptorEnabled(e, type);
 }
 
+// True when the pipeline can run the effect at a reduced resolution tier.
+// Multi-pass, custom-render and sim boost effects always run at full.
+bool EffectDescriptorSupportsTiers(TransformEffectType type);
+
+// Resolves the configured tier (including RES_TIER_DEFAULT) to the tier the
+// pipeline will actually use
+EffectResolutionTier EffectDescriptorResolutionTier(const EffectConfig *e,
+                                                    TransformEffectType type);
+
+// Linear scale factor for a tier (FULL and DEFAULT = 1.0)
+float EffectResolutionTierScale(EffectResolutionTier tier);
+
+// Pixel slots per interleave cycle for the effect: 1 when off or when the
+// descriptor lacks EFFECT_FLAG_INTERLEAVED, otherwise 2 or 4
+int EffectDescriptorInterleaveCount(const EffectConfig *e,
+                                    TransformEffectType type);
+
+// Append a quality param to an already-registered descriptor. Returns true.
+bool EffectDescriptorRegisterQuality(TransformEffectType type, size_t offset,
+                                     int minValue, int maxValue);
+
+// Lowers the effect's quality params in place for the given LOD (0-1) and
+// stores the configured values in saved. Returns the number of params
+// written; pass it to EffectDescriptorRestoreQuality after the pass.
+int EffectDescriptorApplyQuality(EffectConfig *e, TransformEffectType type,
+                                 float level,
+                                 int saved[EFFECT_QUALITY_PARAM_MAX]);
+
+void EffectDescriptorRestoreQuality(EffectConfig *e, TransformEffectType type,
+                                    const int saved[EFFECT_QUALITY_PARAM_MAX],
+                                    int count);
+
 // ---------------------------------------------------------------------------
 // Standard generator output section macro
 //
@@ -198,11 +252,49 @@ inline bool IsTransformEnabled(const EffectConfig *e,
        DrawParamsFnArg, nullptr,                                               \
        &g_##field##State});
 
+// --- REGISTER_EFFECT_COMPUTE: REGISTER_EFFECT plus a tiled compute variant ---
+#define REGISTER_EFFECT_COMPUTE(Type, Name, field, displayName, badge,         \
+                                section, flags, SetupFn, ResizeFn,             \
+                                DrawParamsFnArg, ComputeFn)                    \
+  static Name##Effect g_##field##State;                                        \
+  void SetupFn(PostEffect *);                                                  \
+  static bool Init_##field(PostEffect *pe, int, int) {                         \
+    return Name##EffectInit((Name##Effect *)pe->effectStates[Type]);           \
+  }                                                                            \
+  static void Uninit_##field(PostEffect *pe) {                                 \
+    Name##EffectUninit((Name##Effect *)pe->effectStates[Type]);                \
+  }                                                                            \
+  static void Register_##field(EffectConfig *cfg) {                            \
+    Name##RegisterParams(&cfg->field);                                         \
+  }                                                                            \
+  static Shader *GetShader_##field(PostEffect *pe) {                           \
+    return &((Name##Effect *)pe->effectStates[Type])->shader;                  \
+  }                                                                            \
+  static bool reg_##field = EffectDescriptorRegister(                          \
+      Type,                                                                    \
+      EffectDescriptor{Type, displayName, badge, section,                      \
+       offsetof(EffectConfig, field.enabled), #field ".",                       \
+       (uint8_t)(flags),                                                       \
+       Init_##field, Uninit_##field, ResizeFn, Register_##field,               \
+       GetShader_##field, SetupFn,                                             \
+       nullptr, nullptr, nullptr,                                              \
+       DrawParamsFnArg, nullptr,                                               \
+       &g_##field##State, ComputeFn});
+
 // --- REGISTER_GENERATOR: CFG init, GEN badge, BLEND flag ---
 // GetShader returns &pe->blendCompositor->shader
 #define REGISTER_GENERATOR(Type, Name, field, displayName, SetupFn,            \
                            ScratchSetupFn, section, DrawParamsFnArg,           \
                            DrawOutputFnArg)                                    \
+  REGISTER_GENERATOR_FLAGS(Type, Name, field, displayName, SetupFn,            \
+                           ScratchSetupFn, section, DrawParamsFnArg,           \
+                           DrawOutputFnArg, EFFECT_FLAG_BLEND)
+
+// Variant of REGISTER_GENERATOR with explicit flags (must include
+// EFFECT_FLAG_BLEND), e.g. to opt into EFFECT_FLAG_INTERLEAVED
+#define REGISTER_GENERATOR_FLAGS(Type, Name, field, displayName, SetupFn,      \
+                                 ScratchSetupFn, section, DrawParamsFnArg,     \
+                                 DrawOutputFnArg, flags)                       \
   static Name##Effect g_##field##State;                                        \
   void SetupFn(PostEffect *);                                                  \
   void ScratchSetupFn(PostEffect *);                                           \
@@ -226,7 +318,7 @@ inline bool IsTransformEnabled(const EffectConfig *e,
       Type,                                                                    \
       EffectDescriptor{Type, displayName, "GEN", section,                      \
        offsetof(EffectConfig, field.enabled), #field ".",                       \
-       EFFECT_FLAG_BLEND,                                                      \
+       (uint8_t)(flags),                                                       \
        Init_##field, Uninit_##field, NULL, Register_##field,                   \
        GetShader_##field, SetupFn,                                             \
        GetScratchShader_##field, ScratchSetupFn, nullptr,                      \
@@ -291,6 +383,13 @@ inline bool IsTransformEnabled(const EffectConfig *e,
        nullptr, nullptr, nullptr,                                              \
        DrawParamsFnArg, nullptr});
 
+// --- REGISTER_QUALITY_PARAM: int cost knob for the quality LOD controller ---
+// Must follow the effect's REGISTER_* macro in the same file, since
+// registration overwrites the whole descriptor.
+#define REGISTER_QUALITY_PARAM(Type, field, param, minValue, maxValue)         \
+  static bool regQuality_##field##_##param = EffectDescriptorRegisterQuality(  \
+      Type, offsetof(EffectConfig, field.param), minValue, maxValue);
+
 // clang-format on
 
 #endif // EFFECT_DESCRIPTOR_H
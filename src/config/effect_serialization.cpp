@@ -669,6 +669,62 @@ static int TransformEffectFromName(const char *name) {
   return -1;
 }
 
+// Resolution tiers: object keyed by effect name, only enabled effects with a
+// non-default tier are written
+static void ResolutionTiersToJson(json &j, const EffectConfig &e) {
+  j = json::object();
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    const TransformEffectType type = (TransformEffectType)i;
+    if (e.resolutionTier[i] != RES_TIER_DEFAULT &&
+        IsTransformEnabled(&e, type)) {
+      j[TransformEffectName(type)] = (int)e.resolutionTier[i];
+    }
+  }
+}
+
+static void ResolutionTiersFromJson(const json &j, EffectConfig &e) {
+  if (!j.is_object()) {
+    return;
+  }
+  for (const auto &[key, value] : j.items()) {
+    const int type = TransformEffectFromName(key.c_str());
+    if (type < 0 || !value.is_number_integer()) {
+      continue;
+    }
+    const int tier = value.get<int>();
+    if (tier > RES_TIER_DEFAULT && tier < RES_TIER_COUNT) {
+      e.resolutionTier[type] = (EffectResolutionTier)tier;
+    }
+  }
+}
+
+// Interleave modes: same layout as resolutionTiers
+static void InterleaveModesToJson(json &j, const EffectConfig &e) {
+  j = json::object();
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    const TransformEffectType type = (TransformEffectType)i;
+    if (e.interleave[i] != INTERLEAVE_OFF && IsTransformEnabled(&e, type)) {
+      j[TransformEffectName(type)] = (int)e.interleave[i];
+    }
+  }
+}
+
+static void InterleaveModesFromJson(const json &j, EffectConfig &e) {
+  if (!j.is_object()) {
+    return;
+  }
+  for (const auto &[key, value] : j.items()) {
+    const int type = TransformEffectFromName(key.c_str());
+    if (type < 0 || !value.is_number_integer()) {
+      continue;
+    }
+    const int mode = value.get<int>();
+    if (mode > INTERLEAVE_OFF && mode < INTERLEAVE_MODE_COUNT) {
+      e.interleave[type] = (EffectInterleaveMode)mode;
+    }
+  }
+}
+
 // TransformOrderConfig serialization helpers - called from EffectConfig
 // to_json/from_json to_json: Save as string names (stable across enum changes)
 static void TransformOrderToJson(json &j, const TransformOrderConfig &t,
@@ -803,6 +859,8 @@ void to_json(json &j, const EffectConfig &e) {
   j["accumBlendMode"] = (int)e.accumBlendMode;
   j["accumBlendIntensity"] = e.accumBlendIntensity;
   TransformOrderToJson(j["transformOrder"], e.transformOrder, e);
+  ResolutionTiersToJson(j["resolutionTiers"], e);
+  InterleaveModesToJson(j["interleave"], e);
 #define SERIALIZE_EFFECT(name)                                                 \
   if (e.name.enabled)                                                          \
     j[#name] = e.name;
@@ -827,6 +885,12 @@ void from_json(const json &j, EffectConfig &e) {
   if (j.contains("transformOrder")) {
     TransformOrderFromJson(j["transformOrder"], e.transformOrder);
   }
+  if (j.contains("resolutionTiers")) {
+    ResolutionTiersFromJson(j["resolutionTiers"], e);
+  }
+  if (j.contains("interleave")) {
+    InterleaveModesFromJson(j["interleave"], e);
+  }
 #define DESERIALIZE_EFFECT(name) e.name = j.value(#name, e.name);
   EFFECT_CONFIG_FIELDS(DESERIALIZE_EFFECT)
 #undef DESERIALIZE_EFFECT
@@ -2,6 +2,7 @@
 #include "app_configs.h"
 #include "automation/drawable_params.h"
 #include "config/effect_serialization.h"
+#include "render/cpu_profiler.h"
 #include "render/drawable.h"
 #include "ui/imgui_panels.h"
 #include <algorithm>
@@ -168,6 +169,7 @@ bool PresetSave(const Preset *preset, const char *filepath) {
 }
 
 bool PresetLoad(Preset *preset, const char *filepath) {
+  CPU_ZONE("PresetLoad");
   try {
     std::ifstream file(filepath);
     if (!file.is_open()) {
@@ -181,6 +183,20 @@ bool PresetLoad(Preset *preset, const char *filepath) {
   }
 }
 
+bool PresetLoadEffects(EffectConfig *effects, const char *filepath) {
+  try {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+      return false;
+    }
+    const json j = json::parse(file);
+    *effects = j.value("effects", EffectConfig{});
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
 int PresetListEntries(const char *directory, PresetEntry *entries,
                       int maxEntries) {
   try {
@@ -38,6 +38,10 @@ bool PresetSave(const Preset *preset, const char *filepath);
 // Load preset from file. Returns true on success.
 bool PresetLoad(Preset *preset, const char *filepath);
 
+// Load only the effect config from a preset file, skipping drawables and
+// modulation. Returns true on success.
+bool PresetLoadEffects(EffectConfig *effects, const char *filepath);
+
 // List entries (folders + .json presets) in directory.
 // Entries sorted: folders first (case-insensitive alpha), then presets
 // (case-insensitive alpha). Returns number of entries found.
@@ -99,8 +99,8 @@ void ApollonianTunnelEffectSetup(ApollonianTunnelEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -229,6 +229,9 @@ static void DrawApollonianTunnelParams(EffectConfig *e,
 
 // clang-format off
 STANDARD_GENERATOR_OUTPUT(apollonianTunnel)
-REGISTER_GENERATOR(TRANSFORM_APOLLONIAN_TUNNEL_BLEND, ApollonianTunnel, apollonianTunnel, "Apollonian Tunnel",
-                   SetupApollonianTunnelBlend, SetupApollonianTunnel, 13, DrawApollonianTunnelParams, DrawOutput_apollonianTunnel)
+REGISTER_GENERATOR_FLAGS(TRANSFORM_APOLLONIAN_TUNNEL_BLEND, ApollonianTunnel, apollonianTunnel, "Apollonian Tunnel",
+                         SetupApollonianTunnelBlend, SetupApollonianTunnel, 13,
+                         DrawApollonianTunnelParams, DrawOutput_apollonianTunnel,
+                         EFFECT_FLAG_BLEND | EFFECT_FLAG_INTERLEAVED)
+REGISTER_QUALITY_PARAM(TRANSFORM_APOLLONIAN_TUNNEL_BLEND, apollonianTunnel, marchSteps, 48, 128)
 // clang-format on
@@ -73,8 +73,8 @@ void ArcStrobeEffectSetup(ArcStrobeEffect *e, ArcStrobeConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
 
@@ -27,8 +27,8 @@ bool AsciiArtEffectInit(AsciiArtEffect *e) {
 }
 
 void AsciiArtEffectSetup(const AsciiArtEffect *e, const AsciiArtConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   int cellPixels = (int)cfg->cellSize;
   SetShaderValue(e->shader, e->cellPixelsLoc, &cellPixels, SHADER_UNIFORM_INT);
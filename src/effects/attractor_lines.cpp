@@ -217,9 +217,12 @@ void AttractorLinesEffectRender(AttractorLinesEffect *e,
 
 void AttractorLinesEffectResize(AttractorLinesEffect *e, int width,
                                 int height) {
-  UnloadPingPong(e);
+  const AttractorLinesEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void AttractorLinesEffectUninit(AttractorLinesEffect *e) {
@@ -133,7 +133,7 @@ void AttractorLinesEffectRender(AttractorLinesEffect *e,
                                 float deltaTime, int screenWidth,
                                 int screenHeight);
 
-// Unloads ping-pong textures, reallocates at new dimensions
+// Reallocates ping-pong textures at new dimensions, resampling the trails
 void AttractorLinesEffectResize(AttractorLinesEffect *e, int width, int height);
 
 // Unloads shader, frees LUT and ping-pong textures
@@ -7,6 +7,8 @@
 #include "config/effect_descriptor.h"
 #include "imgui.h"
 #include "render/post_effect.h"
+#include "render/tiled_filter.h"
+#include "rlgl.h"
 #include "ui/modulatable_slider.h"
 #include "ui/ui_units.h"
 #include <stddef.h>
@@ -21,13 +23,22 @@ bool BilateralEffectInit(BilateralEffect *e) {
   e->spatialSigmaLoc = GetShaderLocation(e->shader, "spatialSigma");
   e->rangeSigmaLoc = GetShaderLocation(e->shader, "rangeSigma");
 
+  e->computeProgram =
+      TiledFilterLoadProgram("shaders/bilateral_tiled.glsl", "BILATERAL");
+  if (e->computeProgram != 0) {
+    e->computeSpatialSigmaLoc =
+        rlGetLocationUniform(e->computeProgram, "spatialSigma");
+    e->computeRangeSigmaLoc =
+        rlGetLocationUniform(e->computeProgram, "rangeSigma");
+  }
+
   return true;
 }
 
 void BilateralEffectSetup(const BilateralEffect *e,
                           const BilateralConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->spatialSigmaLoc, &cfg->spatialSigma,
@@ -36,8 +47,25 @@ void BilateralEffectSetup(const BilateralEffect *e,
                  SHADER_UNIFORM_FLOAT);
 }
 
+bool BilateralEffectCompute(const BilateralEffect *e,
+                            const BilateralConfig *cfg,
+                            const Texture2D &source,
+                            const RenderTexture2D *dest) {
+  if (!cfg->tiledCompute || e->computeProgram == 0) {
+    return false;
+  }
+
+  rlEnableShader(e->computeProgram);
+  rlSetUniform(e->computeSpatialSigmaLoc, &cfg->spatialSigma,
+               RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(e->computeRangeSigmaLoc, &cfg->rangeSigma,
+               RL_SHADER_UNIFORM_FLOAT, 1);
+  return TiledFilterDispatch(e->computeProgram, source, dest);
+}
+
 void BilateralEffectUninit(const BilateralEffect *e) {
   UnloadShader(e->shader);
+  TiledFilterUnloadProgram(e->computeProgram);
 }
 
 void BilateralRegisterParams(BilateralConfig *cfg) {
@@ -54,6 +82,12 @@ void SetupBilateral(PostEffect *pe) {
   BilateralEffectSetup(GetBilateralEffect(pe), &pe->effects.bilateral);
 }
 
+static bool ComputeBilateral(PostEffect *pe, const RenderTexture2D *source,
+                             const RenderTexture2D *dest) {
+  return BilateralEffectCompute(GetBilateralEffect(pe), &pe->effects.bilateral,
+                                source->texture, dest);
+}
+
 // === UI ===
 
 static void DrawBilateralParams(EffectConfig *e, const ModSources *ms,
@@ -63,9 +97,11 @@ static void DrawBilateralParams(EffectConfig *e, const ModSources *ms,
                     "bilateral.spatialSigma", "%.1f", ms);
   ModulatableSliderLog("Range Sigma##bilateral", &e->bilateral.rangeSigma,
                        "bilateral.rangeSigma", "%.3f", ms);
+  ImGui::Checkbox("Tiled Compute##bilateral", &e->bilateral.tiledCompute);
 }
 
 // clang-format off
-REGISTER_EFFECT(TRANSFORM_BILATERAL, Bilateral, bilateral, "Bilateral", "ART", 4,
-                EFFECT_FLAG_NONE, SetupBilateral, NULL, DrawBilateralParams)
+REGISTER_EFFECT_COMPUTE(TRANSFORM_BILATERAL, Bilateral, bilateral, "Bilateral", "ART", 4,
+                        EFFECT_FLAG_NONE, SetupBilateral, NULL,
+                        DrawBilateralParams, ComputeBilateral)
 // clang-format on
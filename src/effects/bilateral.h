@@ -13,24 +13,35 @@ struct BilateralConfig {
   bool enabled = false;
   float spatialSigma = 4.0f; // Blur radius in pixels (1.0-10.0)
   float rangeSigma = 0.1f;   // Edge sensitivity (0.01-0.5)
+  bool tiledCompute = true;  // Shared-memory compute path when available
 };
 
-#define BILATERAL_CONFIG_FIELDS enabled, spatialSigma, rangeSigma
+#define BILATERAL_CONFIG_FIELDS enabled, spatialSigma, rangeSigma, tiledCompute
 
 typedef struct BilateralEffect {
   Shader shader;
   int resolutionLoc;
   int spatialSigmaLoc;
   int rangeSigmaLoc;
+  unsigned int computeProgram; // 0 when compute is unavailable
+  int computeSpatialSigmaLoc;
+  int computeRangeSigmaLoc;
 } BilateralEffect;
 
 // Returns true on success, false if shader fails to load
+// Tiled compute program is optional; its failure keeps the fragment path
 bool BilateralEffectInit(BilateralEffect *e);
 
 // Sets all uniforms
 void BilateralEffectSetup(const BilateralEffect *e, const BilateralConfig *cfg);
 
-// Unloads shader
+// Runs the tiled compute filter into dest; false falls back to fragment
+bool BilateralEffectCompute(const BilateralEffect *e,
+                            const BilateralConfig *cfg,
+                            const Texture2D &source,
+                            const RenderTexture2D *dest);
+
+// Unloads shader and compute program
 void BilateralEffectUninit(const BilateralEffect *e);
 
 // Registers modulatable params with the modulation engine
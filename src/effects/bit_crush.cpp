@@ -56,8 +56,8 @@ void BitCrushEffectSetup(BitCrushEffect *e, const BitCrushConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   const float center[2] = {0.5f, 0.5f};
@@ -31,8 +31,8 @@ bool BokehEffectInit(BokehEffect *e) {
 }
 
 void BokehEffectSetup(const BokehEffect *e, const BokehConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->radiusLoc, &cfg->radius, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->iterationsLoc, &cfg->iterations,
@@ -90,8 +90,8 @@ void ByzantineEffectSetup(ByzantineEffect *e, const ByzantineConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->simResolutionLoc, resolution,
                  SHADER_UNIFORM_VEC2);
   SetShaderValue(e->displayShader, e->dispResolutionLoc, resolution,
@@ -161,10 +161,12 @@ void ByzantineEffectRender(ByzantineEffect *e, const PostEffect *pe) {
 }
 
 void ByzantineEffectResize(ByzantineEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const ByzantineEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
-  e->frameCount = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void ByzantineEffectUninit(ByzantineEffect *e) {
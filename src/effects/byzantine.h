@@ -77,7 +77,7 @@ void ByzantineEffectSetup(ByzantineEffect *e, const ByzantineConfig *cfg,
 // Runs simulation step and display pass into post-effect chain
 void ByzantineEffectRender(ByzantineEffect *e, const PostEffect *pe);
 
-// Reallocates ping-pong render textures on resolution change
+// Resamples ping-pong render textures on resolution change
 void ByzantineEffectResize(ByzantineEffect *e, int width, int height);
 
 // Unloads shaders and frees LUT
@@ -73,8 +73,8 @@ void ChladniEffectSetup(ChladniEffect *e, const ChladniConfig *cfg,
   e->currentFftTexture = fftTexture;
   ColorLUTUpdate(e->colorLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->plateSizeLoc, &cfg->plateSize,
@@ -132,9 +132,12 @@ void ChladniEffectRender(ChladniEffect *e, const ChladniConfig *cfg,
 }
 
 void ChladniEffectResize(ChladniEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const ChladniEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void ChladniEffectUninit(ChladniEffect *e) {
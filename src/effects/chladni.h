@@ -85,7 +85,7 @@ void ChladniEffectSetup(ChladniEffect *e, const ChladniConfig *cfg,
 void ChladniEffectRender(ChladniEffect *e, const ChladniConfig *cfg,
                          float deltaTime, int screenWidth, int screenHeight);
 
-// Reallocates ping-pong render textures on resolution change
+// Resamples ping-pong render textures on resolution change
 void ChladniEffectResize(ChladniEffect *e, int width, int height);
 
 // Unloads shader and frees LUT
@@ -30,8 +30,8 @@ bool ChromaticAberrationEffectInit(ChromaticAberrationEffect *e) {
 
 void ChromaticAberrationEffectSetup(const ChromaticAberrationEffect *e,
                                     const ChromaticAberrationConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->offsetLoc, &cfg->offset, SHADER_UNIFORM_FLOAT);
   int samples = (int)cfg->samples;
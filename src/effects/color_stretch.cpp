@@ -63,8 +63,8 @@ void ColorStretchEffectSetup(ColorStretchEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
   SetShaderValue(e->shader, e->sampleRateLoc, &sampleRate,
@@ -88,8 +88,8 @@ void ConstellationEffectSetup(ConstellationEffect *e,
   ColorLUTUpdate(e->pointLUT, &cfg->gradient);
   ColorLUTUpdate(e->lineLUT, &cfg->lineGradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->waveInfluenceLoc, &cfg->waveInfluence,
                  SHADER_UNIFORM_FLOAT);
@@ -149,7 +149,7 @@ void ConstellationEffectSetup(ConstellationEffect *e,
 
   const float waveCenter[2] = {
       (cfg->waveCenterX - 0.5f) * cfg->gridScale *
-          ((float)GetScreenWidth() / (float)GetScreenHeight()),
+          ((float)PostEffectRenderWidth() / (float)PostEffectRenderHeight()),
       (cfg->waveCenterY - 0.5f) * cfg->gridScale};
   SetShaderValue(e->shader, e->waveCenterLoc, waveCenter, SHADER_UNIFORM_VEC2);
 
@@ -96,8 +96,8 @@ static void SetupPulse(const CrtEffect *e, const CrtConfig *cfg) {
 void CrtEffectSetup(CrtEffect *e, const CrtConfig *cfg, float deltaTime) {
   e->time += deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
 
@@ -196,8 +196,8 @@ static void BindColorUniforms(const CurlAdvectionEffect *e,
 void CurlAdvectionEffectSetup(CurlAdvectionEffect *e,
                               const CurlAdvectionConfig *cfg, float deltaTime) {
   ColorLUTUpdate(e->colorLUT, &cfg->color);
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   BindStateUniforms(e, cfg, resolution);
   BindColorUniforms(e, cfg, deltaTime, resolution);
 }
@@ -241,13 +241,13 @@ void CurlAdvectionEffectRender(CurlAdvectionEffect *e,
 }
 
 void CurlAdvectionEffectResize(CurlAdvectionEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const CurlAdvectionEffect old = *e;
   InitPingPong(e, width, height);
-  InitializeStateWithNoise(e, width, height);
-  RenderUtilsClearTexture(&e->pingPong[0]);
-  RenderUtilsClearTexture(&e->pingPong[1]);
-  e->stateReadIdx = 0;
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.statePingPong[i], &e->statePingPong[i]);
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void CurlAdvectionEffectReset(CurlAdvectionEffect *e, int width, int height) {
@@ -304,7 +304,7 @@ void SetupCurlAdvection(PostEffect *pe) {
   CurlAdvectionEffect *e = GetCurlAdvectionEffect(pe);
   const CurlAdvectionConfig *cfg = &pe->effects.curlAdvection;
   e->currentAccumTexture = pe->accumTexture.texture;
-  CurlAdvectionEffectSetup(e, cfg, GetFrameTime());
+  CurlAdvectionEffectSetup(e, cfg, pe->currentDeltaTime);
 }
 
 void SetupCurlAdvectionBlend(PostEffect *pe) {
@@ -317,7 +317,7 @@ void SetupCurlAdvectionBlend(PostEffect *pe) {
 void RenderCurlAdvection(PostEffect *pe) {
   CurlAdvectionEffect *e = GetCurlAdvectionEffect(pe);
   const CurlAdvectionConfig *cfg = &pe->effects.curlAdvection;
-  CurlAdvectionEffectRender(e, cfg, GetFrameTime(), pe->screenWidth,
+  CurlAdvectionEffectRender(e, cfg, pe->currentDeltaTime, pe->screenWidth,
                             pe->screenHeight);
 }
 
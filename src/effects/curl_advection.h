@@ -91,7 +91,7 @@ void CurlAdvectionEffectRender(CurlAdvectionEffect *e,
                                const CurlAdvectionConfig *cfg, float deltaTime,
                                int screenWidth, int screenHeight);
 
-// Reallocates ping-pong textures at new dimensions
+// Reallocates ping-pong textures at new dimensions, resampling the field
 void CurlAdvectionEffectResize(CurlAdvectionEffect *e, int width, int height);
 
 // Clears visual buffers and re-seeds state with noise
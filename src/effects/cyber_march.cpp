@@ -107,8 +107,8 @@ void CyberMarchEffectSetup(CyberMarchEffect *e, CyberMarchConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -253,4 +253,6 @@ static void DrawCyberMarchParams(EffectConfig *e, const ModSources *modSources,
 STANDARD_GENERATOR_OUTPUT(cyberMarch)
 REGISTER_GENERATOR(TRANSFORM_CYBER_MARCH_BLEND, CyberMarch, cyberMarch, "Cyber March",
                    SetupCyberMarchBlend, SetupCyberMarch, 13, DrawCyberMarchParams, DrawOutput_cyberMarch)
+REGISTER_QUALITY_PARAM(TRANSFORM_CYBER_MARCH_BLEND, cyberMarch, marchSteps, 30, 100)
+REGISTER_QUALITY_PARAM(TRANSFORM_CYBER_MARCH_BLEND, cyberMarch, foldIterations, 4, 12)
 // clang-format on
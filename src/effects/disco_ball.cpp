@@ -38,8 +38,8 @@ void DiscoBallEffectSetup(DiscoBallEffect *e, const DiscoBallConfig *cfg,
                           float deltaTime) {
   e->angle += cfg->rotationSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->sphereRadiusLoc, &cfg->sphereRadius,
                  SHADER_UNIFORM_FLOAT);
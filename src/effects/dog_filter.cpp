@@ -7,6 +7,8 @@
 #include "config/effect_descriptor.h"
 #include "imgui.h"
 #include "render/post_effect.h"
+#include "render/tiled_filter.h"
+#include "rlgl.h"
 #include "ui/modulatable_slider.h"
 #include <stddef.h>
 
@@ -21,21 +23,45 @@ bool DogFilterEffectInit(DogFilterEffect *e) {
   e->tauLoc = GetShaderLocation(e->shader, "tau");
   e->phiLoc = GetShaderLocation(e->shader, "phi");
 
+  e->computeProgram =
+      TiledFilterLoadProgram("shaders/dog_filter_tiled.glsl", "DOG_FILTER");
+  if (e->computeProgram != 0) {
+    e->computeSigmaLoc = rlGetLocationUniform(e->computeProgram, "sigma");
+    e->computeTauLoc = rlGetLocationUniform(e->computeProgram, "tau");
+    e->computePhiLoc = rlGetLocationUniform(e->computeProgram, "phi");
+  }
+
   return true;
 }
 
 void DogFilterEffectSetup(const DogFilterEffect *e,
                           const DogFilterConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->sigmaLoc, &cfg->sigma, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->tauLoc, &cfg->tau, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->phiLoc, &cfg->phi, SHADER_UNIFORM_FLOAT);
 }
 
+bool DogFilterEffectCompute(const DogFilterEffect *e,
+                            const DogFilterConfig *cfg,
+                            const Texture2D &source,
+                            const RenderTexture2D *dest) {
+  if (!cfg->tiledCompute || e->computeProgram == 0) {
+    return false;
+  }
+
+  rlEnableShader(e->computeProgram);
+  rlSetUniform(e->computeSigmaLoc, &cfg->sigma, RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(e->computeTauLoc, &cfg->tau, RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(e->computePhiLoc, &cfg->phi, RL_SHADER_UNIFORM_FLOAT, 1);
+  return TiledFilterDispatch(e->computeProgram, source, dest);
+}
+
 void DogFilterEffectUninit(const DogFilterEffect *e) {
   UnloadShader(e->shader);
+  TiledFilterUnloadProgram(e->computeProgram);
 }
 
 void DogFilterRegisterParams(DogFilterConfig *cfg) {
@@ -52,6 +78,12 @@ void SetupDogFilter(PostEffect *pe) {
   DogFilterEffectSetup(GetDogFilterEffect(pe), &pe->effects.dogFilter);
 }
 
+static bool ComputeDogFilter(PostEffect *pe, const RenderTexture2D *source,
+                             const RenderTexture2D *dest) {
+  return DogFilterEffectCompute(GetDogFilterEffect(pe), &pe->effects.dogFilter,
+                                source->texture, dest);
+}
+
 // === UI ===
 
 static void DrawDogFilterParams(EffectConfig *e, const ModSources *ms,
@@ -63,10 +95,11 @@ static void DrawDogFilterParams(EffectConfig *e, const ModSources *ms,
                     ms);
   ModulatableSlider("Tau##dogFilter", &df->tau, "dogFilter.tau", "%.3f", ms);
   ModulatableSlider("Phi##dogFilter", &df->phi, "dogFilter.phi", "%.1f", ms);
+  ImGui::Checkbox("Tiled Compute##dogFilter", &df->tiledCompute);
 }
 
 // clang-format off
-REGISTER_EFFECT(TRANSFORM_DOG_FILTER, DogFilter, dogFilter, "DoG Filter",
-                "PRT", 5, EFFECT_FLAG_NONE, SetupDogFilter, NULL,
-                DrawDogFilterParams)
+REGISTER_EFFECT_COMPUTE(TRANSFORM_DOG_FILTER, DogFilter, dogFilter, "DoG Filter", "PRT", 5,
+                        EFFECT_FLAG_NONE, SetupDogFilter, NULL,
+                        DrawDogFilterParams, ComputeDogFilter)
 // clang-format on
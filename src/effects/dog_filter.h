@@ -14,9 +14,10 @@ struct DogFilterConfig {
   float sigma = 1.5f; // Edge Gaussian sigma (0.5-5.0)
   float tau = 0.99f;  // Gaussian weighting (0.9-1.0)
   float phi = 2.0f;   // Threshold steepness (0.5-10.0)
+  bool tiledCompute = true; // Shared-memory compute path when available
 };
 
-#define DOG_FILTER_CONFIG_FIELDS enabled, sigma, tau, phi
+#define DOG_FILTER_CONFIG_FIELDS enabled, sigma, tau, phi, tiledCompute
 
 typedef struct DogFilterEffect {
   Shader shader;
@@ -24,15 +25,26 @@ typedef struct DogFilterEffect {
   int sigmaLoc;
   int tauLoc;
   int phiLoc;
+  unsigned int computeProgram; // 0 when compute is unavailable
+  int computeSigmaLoc;
+  int computeTauLoc;
+  int computePhiLoc;
 } DogFilterEffect;
 
 // Returns true on success, false if shader fails to load
+// Tiled compute program is optional; its failure keeps the fragment path
 bool DogFilterEffectInit(DogFilterEffect *e);
 
 // Sets all uniforms
 void DogFilterEffectSetup(const DogFilterEffect *e, const DogFilterConfig *cfg);
 
-// Unloads shader
+// Runs the tiled compute filter into dest; false falls back to fragment
+bool DogFilterEffectCompute(const DogFilterEffect *e,
+                            const DogFilterConfig *cfg,
+                            const Texture2D &source,
+                            const RenderTexture2D *dest);
+
+// Unloads shader and compute program
 void DogFilterEffectUninit(const DogFilterEffect *e);
 
 // Registers modulatable params with the modulation engine
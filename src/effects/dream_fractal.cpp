@@ -70,8 +70,8 @@ void DreamFractalEffectSetup(DreamFractalEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
 
@@ -226,6 +226,9 @@ static void DrawDreamFractalParams(EffectConfig *e,
 
 // clang-format off
 STANDARD_GENERATOR_OUTPUT(dreamFractal)
-REGISTER_GENERATOR(TRANSFORM_DREAM_FRACTAL_BLEND, DreamFractal, dreamFractal, "Dream Fractal",
-                   SetupDreamFractalBlend, SetupDreamFractal, 13, DrawDreamFractalParams, DrawOutput_dreamFractal)
+REGISTER_GENERATOR_FLAGS(TRANSFORM_DREAM_FRACTAL_BLEND, DreamFractal, dreamFractal, "Dream Fractal",
+                         SetupDreamFractalBlend, SetupDreamFractal, 13,
+                         DrawDreamFractalParams, DrawOutput_dreamFractal,
+                         EFFECT_FLAG_BLEND | EFFECT_FLAG_INTERLEAVED)
+REGISTER_QUALITY_PARAM(TRANSFORM_DREAM_FRACTAL_BLEND, dreamFractal, marchSteps, 30, 120)
 // clang-format on
@@ -103,8 +103,8 @@ void DreamZoomEffectSetup(DreamZoomEffect *e, const DreamZoomConfig *cfg,
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float offsetVec[2] = {cfg->offsetX, cfg->offsetY};
   const float trapVec[2] = {cfg->trapOffsetX, cfg->trapOffsetY};
   const float originVec[2] = {cfg->originX, cfg->originY};
@@ -179,8 +179,10 @@ void DreamZoomEffectResize(DreamZoomEffect *e, int width, int height) {
   if (width == e->prevFrameWidth && height == e->prevFrameHeight) {
     return;
   }
-  UnloadRenderTexture(e->prevFrame);
+  const RenderTexture2D old = e->prevFrame;
   AllocPrevFrame(e, width, height);
+  RenderUtilsResampleTexture(&old, &e->prevFrame);
+  UnloadRenderTexture(old);
 }
 
 void DreamZoomEffectUninit(DreamZoomEffect *e) {
@@ -325,4 +327,5 @@ REGISTER_GENERATOR_FULL(TRANSFORM_DREAM_ZOOM_BLEND, DreamZoom, dreamZoom,
                         "Dream Zoom", SetupDreamZoomBlend, SetupDreamZoom,
                         RenderDreamZoom, 12,
                         DrawDreamZoomParams, DrawOutput_dreamZoom)
+REGISTER_QUALITY_PARAM(TRANSFORM_DREAM_ZOOM_BLEND, dreamZoom, iterations, 32, 1024)
 // clang-format on
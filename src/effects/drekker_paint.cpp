@@ -29,8 +29,8 @@ bool DrekkerPaintEffectInit(DrekkerPaintEffect *e) {
 
 void DrekkerPaintEffectSetup(const DrekkerPaintEffect *e,
                              const DrekkerPaintConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->xDivLoc, &cfg->xDiv, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->yDivLoc, &cfg->yDiv, SHADER_UNIFORM_FLOAT);
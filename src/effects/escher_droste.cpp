@@ -34,8 +34,8 @@ void EscherDrosteEffectSetup(EscherDrosteEffect *e, EscherDrosteConfig *cfg,
                              float deltaTime) {
   e->zoomPhase += cfg->zoomSpeed * deltaTime;
 
-  const float w = (float)GetScreenWidth();
-  const float h = (float)GetScreenHeight();
+  const float w = (float)PostEffectRenderWidth();
+  const float h = (float)PostEffectRenderHeight();
 
   float cx = 0.0f;
   float cy = 0.0f;
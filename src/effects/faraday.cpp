@@ -78,8 +78,8 @@ void FaradayEffectSetup(FaradayEffect *e, const FaradayConfig *cfg,
   e->currentFftTexture = fftTexture;
   ColorLUTUpdate(e->colorLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   if (cfg->waveSource == 0) {
@@ -151,9 +151,12 @@ void FaradayEffectRender(FaradayEffect *e, const FaradayConfig *cfg,
 }
 
 void FaradayEffectResize(FaradayEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const FaradayEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void FaradayEffectUninit(FaradayEffect *e) {
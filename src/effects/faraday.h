@@ -97,7 +97,7 @@ void FaradayEffectSetup(FaradayEffect *effect, const FaradayConfig *cfg,
 void FaradayEffectRender(FaradayEffect *effect, const FaradayConfig *cfg,
                          float deltaTime, int screenWidth, int screenHeight);
 
-// Reallocates ping-pong render textures on resolution change
+// Resamples ping-pong render textures on resolution change
 void FaradayEffectResize(FaradayEffect *effect, int width, int height);
 
 // Unloads shader and frees LUT
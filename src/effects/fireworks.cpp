@@ -132,8 +132,10 @@ void FireworksEffectRender(const FireworksEffect *e, const FireworksConfig *cfg,
 }
 
 void FireworksEffectResize(FireworksEffect *e, int width, int height) {
-  UnloadRenderTexture(e->target);
+  const RenderTexture2D old = e->target;
   RenderUtilsInitTextureHDR(&e->target, width, height, "FIREWORKS");
+  RenderUtilsResampleTexture(&old, &e->target);
+  UnloadRenderTexture(old);
 }
 
 void FireworksEffectUninit(FireworksEffect *e) {
@@ -100,7 +100,7 @@ void FireworksEffectRender(const FireworksEffect *e, const FireworksConfig *cfg,
                            float deltaTime, int screenWidth, int screenHeight,
                            const Texture2D &fftTexture);
 
-// Reallocates render target at new dimensions
+// Reallocates render target at new dimensions, resampling its contents
 void FireworksEffectResize(FireworksEffect *e, int width, int height);
 
 // Unloads shader, frees LUT and render target
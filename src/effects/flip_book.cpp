@@ -71,9 +71,10 @@ void FlipBookEffectRender(FlipBookEffect *e, const PostEffect *pe) {
 }
 
 void FlipBookEffectResize(FlipBookEffect *e, int width, int height) {
-  UnloadRenderTexture(e->heldFrame);
+  const RenderTexture2D old = e->heldFrame;
   RenderUtilsInitTextureHDR(&e->heldFrame, width, height, "FLIP_BOOK");
-  e->lastRenderedIndex = -1;
+  RenderUtilsResampleTexture(&old, &e->heldFrame);
+  UnloadRenderTexture(old);
 }
 
 void FlipBookEffectUninit(const FlipBookEffect *e) {
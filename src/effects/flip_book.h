@@ -40,7 +40,7 @@ void FlipBookEffectSetup(FlipBookEffect *e, const FlipBookConfig *cfg,
 // Renders held frame with jitter offset to pipeline destination
 void FlipBookEffectRender(FlipBookEffect *e, const PostEffect *pe);
 
-// Reallocates held frame texture at new dimensions
+// Reallocates held frame texture at new dimensions, resampling the frame
 void FlipBookEffectResize(FlipBookEffect *e, int width, int height);
 
 // Unloads shader and held frame texture
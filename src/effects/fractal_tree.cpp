@@ -57,8 +57,8 @@ void FractalTreeEffectSetup(FractalTreeEffect *e, const FractalTreeConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
 
@@ -160,4 +160,5 @@ STANDARD_GENERATOR_OUTPUT(fractalTree)
 REGISTER_GENERATOR(TRANSFORM_FRACTAL_TREE_BLEND, FractalTree, fractalTree,
                    "Fractal Tree", SetupFractalTreeBlend,
                    SetupFractalTree, 10, DrawFractalTreeParams, DrawOutput_fractalTree)
+REGISTER_QUALITY_PARAM(TRANSFORM_FRACTAL_TREE_BLEND, fractalTree, maxIterations, 8, 32)
 // clang-format on
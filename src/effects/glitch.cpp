@@ -209,8 +209,8 @@ void GlitchEffectSetup(GlitchEffect *e, const GlitchConfig *cfg,
   e->time += deltaTime;
   e->frame++;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->frameLoc, &e->frame, SHADER_UNIFORM_INT);
@@ -34,8 +34,8 @@ void HalftoneEffectSetup(HalftoneEffect *e, const HalftoneConfig *cfg,
 
   float finalRotation = e->rotation + cfg->rotationAngle;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->dotScaleLoc, &cfg->dotScale,
                  SHADER_UNIFORM_FLOAT);
@@ -124,8 +124,8 @@ void HueRemapEffectSetup(HueRemapEffect *e, const HueRemapConfig *cfg,
   const float center[2] = {cfg->cx, cfg->cy};
   SetShaderValue(e->shader, e->centerLoc, center, SHADER_UNIFORM_VEC2);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetupBlendSpatial(e, cfg);
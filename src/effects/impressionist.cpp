@@ -15,6 +15,7 @@ bool ImpressionistEffectInit(ImpressionistEffect *e) {
     return false;
   }
 
+  e->resolutionLoc = GetShaderLocation(e->shader, "resolution");
   e->splatCountLoc = GetShaderLocation(e->shader, "splatCount");
   e->splatSizeMinLoc = GetShaderLocation(e->shader, "splatSizeMin");
   e->splatSizeMaxLoc = GetShaderLocation(e->shader, "splatSizeMax");
@@ -32,6 +33,9 @@ bool ImpressionistEffectInit(ImpressionistEffect *e) {
 
 void ImpressionistEffectSetup(const ImpressionistEffect *e,
                               const ImpressionistConfig *cfg) {
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
+  SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->splatCountLoc, &cfg->splatCount,
                  SHADER_UNIFORM_INT);
   SetShaderValue(e->shader, e->splatSizeMinLoc, &cfg->splatSizeMin,
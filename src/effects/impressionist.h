@@ -32,6 +32,7 @@ struct ImpressionistConfig {
 
 typedef struct ImpressionistEffect {
   Shader shader;
+  int resolutionLoc;
   int splatCountLoc;
   int splatSizeMinLoc;
   int splatSizeMaxLoc;
@@ -48,7 +49,7 @@ typedef struct ImpressionistEffect {
 // Returns true on success, false if shader fails to load
 bool ImpressionistEffectInit(ImpressionistEffect *e);
 
-// Sets all uniforms except resolution (ApplyHalfResEffect handles resolution)
+// Sets all uniforms; resolution follows PostEffectRenderWidth/Height
 void ImpressionistEffectSetup(const ImpressionistEffect *e,
                               const ImpressionistConfig *cfg);
 
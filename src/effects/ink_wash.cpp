@@ -26,8 +26,8 @@ bool InkWashEffectInit(InkWashEffect *e) {
 }
 
 void InkWashEffectSetup(const InkWashEffect *e, const InkWashConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->strengthLoc, &cfg->strength,
                  SHADER_UNIFORM_FLOAT);
@@ -92,8 +92,8 @@ void IsoflowEffectSetup(IsoflowEffect *e, IsoflowConfig *cfg, float deltaTime,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -221,4 +221,5 @@ static void DrawIsoflowParams(EffectConfig *e, const ModSources *modSources,
 STANDARD_GENERATOR_OUTPUT(isoflow)
 REGISTER_GENERATOR(TRANSFORM_ISOFLOW_BLEND, Isoflow, isoflow, "Isoflow",
                    SetupIsoflowBlend, SetupIsoflow, 13, DrawIsoflowParams, DrawOutput_isoflow)
+REGISTER_QUALITY_PARAM(TRANSFORM_ISOFLOW_BLEND, isoflow, marchSteps, 32, 128)
 // clang-format on
@@ -110,4 +110,5 @@ REGISTER_EFFECT(
     TRANSFORM_KIFS, Kifs, kifs,
     "KIFS", "SYM", 0, EFFECT_FLAG_NONE,
     SetupKifs, NULL, DrawKifsParams)
+REGISTER_QUALITY_PARAM(TRANSFORM_KIFS, kifs, iterations, 2, 6)
 // clang-format on
@@ -7,6 +7,8 @@
 #include "config/effect_descriptor.h"
 #include "imgui.h"
 #include "render/post_effect.h"
+#include "render/tiled_filter.h"
+#include "rlgl.h"
 #include "ui/modulatable_slider.h"
 #include <stddef.h>
 
@@ -19,19 +21,41 @@ bool KuwaharaEffectInit(KuwaharaEffect *e) {
   e->resolutionLoc = GetShaderLocation(e->shader, "resolution");
   e->radiusLoc = GetShaderLocation(e->shader, "radius");
 
+  e->computeProgram =
+      TiledFilterLoadProgram("shaders/kuwahara_tiled.glsl", "KUWAHARA");
+  if (e->computeProgram != 0) {
+    e->computeRadiusLoc = rlGetLocationUniform(e->computeProgram, "radius");
+  }
+
   return true;
 }
 
 void KuwaharaEffectSetup(const KuwaharaEffect *e, const KuwaharaConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   int radius = (int)cfg->radius;
   SetShaderValue(e->shader, e->radiusLoc, &radius, SHADER_UNIFORM_INT);
 }
 
-void KuwaharaEffectUninit(const KuwaharaEffect *e) { UnloadShader(e->shader); }
+bool KuwaharaEffectCompute(const KuwaharaEffect *e, const KuwaharaConfig *cfg,
+                           const Texture2D &source,
+                           const RenderTexture2D *dest) {
+  if (!cfg->tiledCompute || e->computeProgram == 0) {
+    return false;
+  }
+
+  rlEnableShader(e->computeProgram);
+  const int radius = (int)cfg->radius;
+  rlSetUniform(e->computeRadiusLoc, &radius, RL_SHADER_UNIFORM_INT, 1);
+  return TiledFilterDispatch(e->computeProgram, source, dest);
+}
+
+void KuwaharaEffectUninit(const KuwaharaEffect *e) {
+  UnloadShader(e->shader);
+  TiledFilterUnloadProgram(e->computeProgram);
+}
 
 void KuwaharaRegisterParams(KuwaharaConfig *cfg) {
   ModEngineRegisterParam("kuwahara.radius", &cfg->radius, 2.0f, 12.0f);
@@ -45,6 +69,12 @@ void SetupKuwahara(PostEffect *pe) {
   KuwaharaEffectSetup(GetKuwaharaEffect(pe), &pe->effects.kuwahara);
 }
 
+static bool ComputeKuwahara(PostEffect *pe, const RenderTexture2D *source,
+                            const RenderTexture2D *dest) {
+  return KuwaharaEffectCompute(GetKuwaharaEffect(pe), &pe->effects.kuwahara,
+                               source->texture, dest);
+}
+
 // === UI ===
 
 static void DrawKuwaharaParams(EffectConfig *e, const ModSources *ms,
@@ -52,9 +82,11 @@ static void DrawKuwaharaParams(EffectConfig *e, const ModSources *ms,
   (void)glow;
   ModulatableSlider("Radius##kuwahara", &e->kuwahara.radius, "kuwahara.radius",
                     "%.0f", ms);
+  ImGui::Checkbox("Tiled Compute##kuwahara", &e->kuwahara.tiledCompute);
 }
 
 // clang-format off
-REGISTER_EFFECT(TRANSFORM_KUWAHARA, Kuwahara, kuwahara, "Kuwahara", "ART", 4,
-                EFFECT_FLAG_NONE, SetupKuwahara, NULL, DrawKuwaharaParams)
+REGISTER_EFFECT_COMPUTE(TRANSFORM_KUWAHARA, Kuwahara, kuwahara, "Kuwahara", "ART", 4,
+                        EFFECT_FLAG_NONE, SetupKuwahara, NULL,
+                        DrawKuwaharaParams, ComputeKuwahara)
 // clang-format on
@@ -11,24 +11,33 @@ struct PostEffect;
 
 struct KuwaharaConfig {
   bool enabled = false;
-  float radius = 4.0f; // Kernel radius, cast to int in shader (2-12)
+  float radius = 4.0f;      // Kernel radius, cast to int in shader (2-12)
+  bool tiledCompute = true; // Shared-memory compute path when available
 };
 
-#define KUWAHARA_CONFIG_FIELDS enabled, radius
+#define KUWAHARA_CONFIG_FIELDS enabled, radius, tiledCompute
 
 typedef struct KuwaharaEffect {
   Shader shader;
   int resolutionLoc;
   int radiusLoc;
+  unsigned int computeProgram; // 0 when compute is unavailable
+  int computeRadiusLoc;
 } KuwaharaEffect;
 
 // Returns true on success, false if shader fails to load
+// Tiled compute program is optional; its failure keeps the fragment path
 bool KuwaharaEffectInit(KuwaharaEffect *e);
 
 // Sets all uniforms
 void KuwaharaEffectSetup(const KuwaharaEffect *e, const KuwaharaConfig *cfg);
 
-// Unloads shader
+// Runs the tiled compute filter into dest; false falls back to fragment
+bool KuwaharaEffectCompute(const KuwaharaEffect *e, const KuwaharaConfig *cfg,
+                           const Texture2D &source,
+                           const RenderTexture2D *dest);
+
+// Unloads shader and compute program
 void KuwaharaEffectUninit(const KuwaharaEffect *e);
 
 // Registers modulatable params with the modulation engine
@@ -36,8 +36,8 @@ void LatticeCrushEffectSetup(LatticeCrushEffect *e,
                              const LatticeCrushConfig *cfg, float deltaTime) {
   e->time += cfg->speed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   const float center[2] = {0.5f, 0.5f};
@@ -31,8 +31,8 @@ bool LegoBricksEffectInit(LegoBricksEffect *e) {
 
 void LegoBricksEffectSetup(const LegoBricksEffect *e,
                            const LegoBricksConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->brickScaleLoc, &cfg->brickScale,
                  SHADER_UNIFORM_FLOAT);
@@ -261,8 +261,8 @@ void LichenEffectSetup(LichenEffect *e, const LichenConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
 
   BindStateUniforms(e, cfg, resolution);
   SetShaderValue(e->stateShader, e->stateTimeLoc, &e->time,
@@ -334,12 +334,14 @@ void LichenEffectRender(LichenEffect *e, const LichenConfig *cfg,
 }
 
 void LichenEffectResize(LichenEffect *e, int width, int height) {
-  UnloadTextures(e);
+  const LichenEffect old = *e;
   InitTextures(e, width, height);
-  InitializeSeed(e, width, height);
-  RenderUtilsClearTexture(&e->colorRT);
-  e->readIdx0 = 0;
-  e->readIdx1 = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.statePingPong0[i], &e->statePingPong0[i]);
+    RenderUtilsResampleTexture(&old.statePingPong1[i], &e->statePingPong1[i]);
+  }
+  RenderUtilsResampleTexture(&old.colorRT, &e->colorRT);
+  UnloadTextures(&old);
 }
 
 void LichenEffectReset(LichenEffect *e, int width, int height) {
@@ -119,7 +119,7 @@ void LichenEffectSetup(LichenEffect *e, const LichenConfig *cfg,
 void LichenEffectRender(LichenEffect *e, const LichenConfig *cfg,
                         int screenWidth, int screenHeight);
 
-// Reallocates ping-pong textures at new dimensions
+// Reallocates ping-pong textures at new dimensions, resampling the state
 void LichenEffectResize(LichenEffect *e, int width, int height);
 
 // Clears state buffers and re-seeds with noise
@@ -37,8 +37,8 @@ void LotusWarpEffectSetup(LotusWarpEffect *e, const LotusWarpConfig *cfg,
   e->zoomPhase += cfg->zoomSpeed * deltaTime;
   e->spinPhase += cfg->spinSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->scaleLoc, &cfg->scale, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->zoomPhaseLoc, &e->zoomPhase,
@@ -65,8 +65,8 @@ void MarbleEffectSetup(MarbleEffect *e, const MarbleConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
 
@@ -196,4 +196,5 @@ static void DrawMarbleParams(EffectConfig *e, const ModSources *modSources,
 STANDARD_GENERATOR_OUTPUT(marble)
 REGISTER_GENERATOR(TRANSFORM_MARBLE_BLEND, Marble, marble, "Marble",
                    SetupMarbleBlend, SetupMarble, 17, DrawMarbleParams, DrawOutput_marble)
+REGISTER_QUALITY_PARAM(TRANSFORM_MARBLE_BLEND, marble, marchSteps, 32, 128)
 // clang-format on
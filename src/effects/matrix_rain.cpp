@@ -36,8 +36,8 @@ void MatrixRainEffectSetup(MatrixRainEffect *e, const MatrixRainConfig *cfg,
   // CPU time accumulation - avoids position jumps when rainSpeed changes
   e->time += cfg->rainSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->cellSizeLoc, &cfg->cellSize,
                  SHADER_UNIFORM_FLOAT);
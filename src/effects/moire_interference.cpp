@@ -93,8 +93,8 @@ void MoireInterferenceEffectSetup(MoireInterferenceEffect *e,
   SetShaderValue(e->shader, e->centerXLoc, &cfg->centerX, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->centerYLoc, &cfg->centerY, SHADER_UNIFORM_FLOAT);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   // Bind per-layer uniforms
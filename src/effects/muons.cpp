@@ -89,8 +89,8 @@ void MuonsEffectSetup(MuonsEffect *e, const MuonsConfig *cfg, float deltaTime,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
@@ -166,9 +166,12 @@ void MuonsEffectRender(MuonsEffect *e, const MuonsConfig *cfg, float deltaTime,
 }
 
 void MuonsEffectResize(MuonsEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const MuonsEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void MuonsEffectUninit(MuonsEffect *e) {
@@ -120,7 +120,7 @@ void MuonsEffectSetup(MuonsEffect *e, const MuonsConfig *cfg, float deltaTime,
 void MuonsEffectRender(MuonsEffect *e, const MuonsConfig *cfg, float deltaTime,
                        int screenWidth, int screenHeight);
 
-// Reallocates ping-pong render textures on resolution change
+// Resamples ping-pong render textures on resolution change
 void MuonsEffectResize(MuonsEffect *e, int width, int height);
 
 // Unloads shader and frees LUT
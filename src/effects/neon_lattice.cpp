@@ -74,8 +74,8 @@ void NeonLatticeEffectSetup(NeonLatticeEffect *e, const NeonLatticeConfig *cfg,
   e->columnsPhase += cfg->columnsSpeed * deltaTime;
   e->lightsPhase += cfg->lightsSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->spacingLoc, &cfg->spacing, SHADER_UNIFORM_FLOAT);
@@ -228,4 +228,5 @@ STANDARD_GENERATOR_OUTPUT(neonLattice)
 REGISTER_GENERATOR(TRANSFORM_NEON_LATTICE_BLEND, NeonLattice, neonLattice,
                    "Neon Lattice", SetupNeonLatticeBlend, SetupNeonLattice, 13,
                    DrawNeonLatticeParams, DrawOutput_neonLattice)
+REGISTER_QUALITY_PARAM(TRANSFORM_NEON_LATTICE_BLEND, neonLattice, iterations, 20, 80)
 // clang-format on
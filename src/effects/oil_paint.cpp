@@ -81,8 +81,9 @@ void OilPaintEffectResize(OilPaintEffect *e, int width, int height) {
 void ApplyHalfResOilPaint(PostEffect *pe, const RenderTexture2D *source,
                           const int *writeIdx) {
   OilPaintEffect *e = GetOilPaintEffect(pe);
-  const int halfW = pe->screenWidth / 2;
-  const int halfH = pe->screenHeight / 2;
+  RenderTexture2D *half = PostEffectGetTierTargets(pe, RES_TIER_HALF);
+  const int halfW = half[0].texture.width;
+  const int halfH = half[0].texture.height;
   const Rectangle srcRect = {0, 0, (float)source->texture.width,
                              (float)-source->texture.height};
   const Rectangle halfRect = {0, 0, (float)halfW, (float)halfH};
@@ -91,16 +92,16 @@ void ApplyHalfResOilPaint(PostEffect *pe, const RenderTexture2D *source,
   const float halfRes[2] = {(float)halfW, (float)halfH};
   const float fullRes[2] = {(float)pe->screenWidth, (float)pe->screenHeight};
 
-  BeginTextureMode(pe->halfResA);
+  BeginTextureMode(half[0]);
   DrawTexturePro(source->texture, srcRect, halfRect, {0, 0}, 0.0f, WHITE);
   EndTextureMode();
 
   SetShaderValue(e->strokeShader, e->strokeResolutionLoc, halfRes,
                  SHADER_UNIFORM_VEC2);
 
-  BeginTextureMode(pe->halfResB);
+  BeginTextureMode(half[1]);
   BeginShaderMode(e->strokeShader);
-  DrawTexturePro(pe->halfResA.texture, {0, 0, (float)halfW, (float)-halfH},
+  DrawTexturePro(half[0].texture, {0, 0, (float)halfW, (float)-halfH},
                  halfRect, {0, 0}, 0.0f, WHITE);
   EndShaderMode();
   EndTextureMode();
@@ -108,9 +109,9 @@ void ApplyHalfResOilPaint(PostEffect *pe, const RenderTexture2D *source,
   SetShaderValue(e->compositeShader, e->compositeResolutionLoc, halfRes,
                  SHADER_UNIFORM_VEC2);
 
-  BeginTextureMode(pe->halfResA);
+  BeginTextureMode(half[0]);
   BeginShaderMode(e->compositeShader);
-  DrawTexturePro(pe->halfResB.texture, {0, 0, (float)halfW, (float)-halfH},
+  DrawTexturePro(half[1].texture, {0, 0, (float)halfW, (float)-halfH},
                  halfRect, {0, 0}, 0.0f, WHITE);
   EndShaderMode();
   EndTextureMode();
@@ -122,7 +123,7 @@ void ApplyHalfResOilPaint(PostEffect *pe, const RenderTexture2D *source,
                  SHADER_UNIFORM_VEC2);
 
   BeginTextureMode(pe->pingPong[*writeIdx]);
-  DrawTexturePro(pe->halfResA.texture, {0, 0, (float)halfW, (float)-halfH},
+  DrawTexturePro(half[0].texture, {0, 0, (float)halfW, (float)-halfH},
                  fullRect, {0, 0}, 0.0f, WHITE);
   EndTextureMode();
 }
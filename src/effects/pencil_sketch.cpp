@@ -39,8 +39,8 @@ void PencilSketchEffectSetup(PencilSketchEffect *e,
                              const PencilSketchConfig *cfg, float deltaTime) {
   e->wobbleTime += cfg->wobbleSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->angleCountLoc, &cfg->angleCount,
                  SHADER_UNIFORM_INT);
@@ -35,8 +35,8 @@ bool PerspectiveTiltEffectInit(PerspectiveTiltEffect *e) {
 
 void PerspectiveTiltEffectSetup(const PerspectiveTiltEffect *e,
                                 const PerspectiveTiltConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   // Clamp pitch and yaw to +/-85 degrees for numerical safety
@@ -28,8 +28,8 @@ bool PixelationEffectInit(PixelationEffect *e) {
 
 void PixelationEffectSetup(const PixelationEffect *e,
                            const PixelationConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->cellCountLoc, &cfg->cellCount,
                  SHADER_UNIFORM_FLOAT);
@@ -88,8 +88,8 @@ static void UploadUniforms(PolyhedralMirrorEffect *e,
                            float planeOffset, const float *edgeAData,
                            const float *edgeBData, int edgeCount,
                            int maxBouncesInt, const Texture2D &fftTexture) {
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueV(e->shader, e->faceNormalsLoc, faceNormalData,
                   SHADER_UNIFORM_VEC3, faceCount);
@@ -297,4 +297,5 @@ REGISTER_GENERATOR(TRANSFORM_POLYHEDRAL_MIRROR_BLEND, PolyhedralMirror,
                    polyhedralMirror, "Polyhedral Mirror",
                    SetupPolyhedralMirrorBlend, SetupPolyhedralMirror, 10,
                    DrawPolyhedralMirrorParams, DrawOutput_polyhedralMirror)
+REGISTER_QUALITY_PARAM(TRANSFORM_POLYHEDRAL_MIRROR_BLEND, polyhedralMirror, maxIterations, 32, 128)
 // clang-format on
@@ -115,8 +115,8 @@ static void SelectNextShape(PolymorphEffect *e, const PolymorphConfig *cfg) {
 static void UploadUniforms(PolymorphEffect *e, const PolymorphConfig *cfg,
                            const float cameraOrigin[3],
                            const Texture2D &fftTexture) {
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   // Pack edge A endpoints into interleaved vec3 array
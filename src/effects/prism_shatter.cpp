@@ -54,8 +54,8 @@ void PrismShatterEffectSetup(PrismShatterEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->cameraTimeLoc, &e->cameraTime,
                  SHADER_UNIFORM_FLOAT);
@@ -165,4 +165,5 @@ STANDARD_GENERATOR_OUTPUT(prismShatter)
 REGISTER_GENERATOR(TRANSFORM_PRISM_SHATTER_BLEND, PrismShatter, prismShatter,
                    "Prism Shatter", SetupPrismShatterBlend,
                    SetupPrismShatter, 10, DrawPrismShatterParams, DrawOutput_prismShatter)
+REGISTER_QUALITY_PARAM(TRANSFORM_PRISM_SHATTER_BLEND, prismShatter, iterations, 64, 256)
 // clang-format on
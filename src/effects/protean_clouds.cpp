@@ -114,8 +114,8 @@ void ProteanCloudsEffectSetup(ProteanCloudsEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -238,4 +238,5 @@ STANDARD_GENERATOR_OUTPUT(proteanClouds)
 REGISTER_GENERATOR(TRANSFORM_PROTEAN_CLOUDS_BLEND, ProteanClouds, proteanClouds,
                    "Protean Clouds", SetupProteanCloudsBlend, SetupProteanClouds,
                    13, DrawProteanCloudsParams, DrawOutput_proteanClouds)
+REGISTER_QUALITY_PARAM(TRANSFORM_PROTEAN_CLOUDS_BLEND, proteanClouds, marchSteps, 40, 130)
 // clang-format on
@@ -96,4 +96,5 @@ REGISTER_EFFECT(
     TRANSFORM_RADIAL_IFS, RadialIfs, radialIfs,
     "Radial IFS", "SYM", 0, EFFECT_FLAG_NONE,
     SetupRadialIfs, NULL, DrawRadialIfsParams)
+REGISTER_QUALITY_PARAM(TRANSFORM_RADIAL_IFS, radialIfs, iterations, 3, 8)
 // clang-format on
@@ -77,8 +77,8 @@ void RandomVolumetricEffectSetup(RandomVolumetricEffect *e,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
@@ -198,8 +198,8 @@ static void DrawRandomVolumetricParams(EffectConfig *e,
 
 // clang-format off
 STANDARD_GENERATOR_OUTPUT(randomVolumetric)
-REGISTER_GENERATOR(TRANSFORM_RANDOM_VOLUMETRIC, RandomVolumetric, randomVolumetric,
-                   "Random Volumetric",
-                   SetupRandomVolumetricBlend, SetupRandomVolumetric, 13,
-                   DrawRandomVolumetricParams, DrawOutput_randomVolumetric)
+REGISTER_GENERATOR_FLAGS(TRANSFORM_RANDOM_VOLUMETRIC, RandomVolumetric, randomVolumetric, "Random Volumetric",
+                         SetupRandomVolumetricBlend, SetupRandomVolumetric, 13,
+                         DrawRandomVolumetricParams, DrawOutput_randomVolumetric,
+                         EFFECT_FLAG_BLEND | EFFECT_FLAG_INTERLEAVED)
 // clang-format on
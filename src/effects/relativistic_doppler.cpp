@@ -31,8 +31,8 @@ void RelativisticDopplerEffectSetup(const RelativisticDopplerEffect *e,
                                     float deltaTime) {
   (void)deltaTime; // No time accumulation in this effect
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->velocityLoc, &cfg->velocity,
@@ -173,8 +173,8 @@ void RippleTankEffectSetup(RippleTankEffect *e, RippleTankConfig *cfg,
   e->currentWaveformTexture = waveformTexture;
   ColorLUTUpdate(e->colorLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   float aspect = resolution[0] / resolution[1];
   SetShaderValue(e->shader, e->aspectLoc, &aspect, SHADER_UNIFORM_FLOAT);
@@ -255,9 +255,12 @@ void RippleTankEffectRender(RippleTankEffect *e, const RippleTankConfig *cfg,
 }
 
 void RippleTankEffectResize(RippleTankEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const RippleTankEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void RippleTankEffectUninit(RippleTankEffect *e) {
@@ -124,7 +124,7 @@ void RippleTankEffectSetup(RippleTankEffect *e, RippleTankConfig *cfg,
 void RippleTankEffectRender(RippleTankEffect *e, const RippleTankConfig *cfg,
                             float deltaTime, int screenWidth, int screenHeight);
 
-// Reallocates ping-pong render textures on resolution change
+// Resamples ping-pong render textures on resolution change
 void RippleTankEffectResize(RippleTankEffect *e, int width, int height);
 
 // Unloads shader and frees LUT
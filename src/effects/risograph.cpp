@@ -38,8 +38,8 @@ void RisographEffectSetup(RisographEffect *e, const RisographConfig *cfg,
   e->grainTime += cfg->grainSpeed * deltaTime;
   e->misregTime += cfg->misregSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->grainScaleLoc, &cfg->grainScale,
                  SHADER_UNIFORM_FLOAT);
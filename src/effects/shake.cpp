@@ -33,8 +33,8 @@ bool ShakeEffectInit(ShakeEffect *e) {
 void ShakeEffectSetup(ShakeEffect *e, const ShakeConfig *cfg, float deltaTime) {
   e->time += deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->intensityLoc, &cfg->intensity,
@@ -36,8 +36,8 @@ void ShardCrushEffectSetup(ShardCrushEffect *e, const ShardCrushConfig *cfg,
   e->time += cfg->speed * deltaTime;
   e->time = fmodf(e->time, 1000.0f);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
   SetShaderValue(e->shader, e->iterationsLoc, &cfg->iterations,
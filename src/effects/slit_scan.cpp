@@ -138,9 +138,12 @@ void SlitScanEffectRender(SlitScanEffect *e, const SlitScanConfig *cfg,
 }
 
 void SlitScanEffectResize(SlitScanEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const SlitScanEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void SlitScanEffectUninit(const SlitScanEffect *e) {
@@ -76,7 +76,7 @@ void SlitScanEffectSetup(SlitScanEffect *e, const SlitScanConfig *cfg,
 void SlitScanEffectRender(SlitScanEffect *e, const SlitScanConfig *cfg,
                           const PostEffect *pe);
 
-// Unloads ping-pong textures, reallocates at new dimensions
+// Reallocates ping-pong textures at new dimensions, resampling the history
 void SlitScanEffectResize(SlitScanEffect *e, int width, int height);
 
 // Unloads shaders and ping-pong textures
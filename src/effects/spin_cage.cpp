@@ -100,8 +100,8 @@ static void TransformVertices(const ShapeDescriptor *shape, float ax, float ay,
 static void UploadUniforms(const SpinCageEffect *e, const SpinCageConfig *cfg,
                            const ShapeDescriptor *shape, const float *edges,
                            const float *edgeT, const Texture2D &fftTexture) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValueV(e->shader, e->edgesLoc, edges, SHADER_UNIFORM_VEC4,
@@ -101,8 +101,8 @@ void SpiralMarchEffectSetup(SpiralMarchEffect *e, SpiralMarchConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -234,6 +234,9 @@ static void DrawSpiralMarchParams(EffectConfig *e, const ModSources *modSources,
 
 // clang-format off
 STANDARD_GENERATOR_OUTPUT(spiralMarch)
-REGISTER_GENERATOR(TRANSFORM_SPIRAL_MARCH_BLEND, SpiralMarch, spiralMarch, "Spiral March",
-                   SetupSpiralMarchBlend, SetupSpiralMarch, 13, DrawSpiralMarchParams, DrawOutput_spiralMarch)
+REGISTER_GENERATOR_FLAGS(TRANSFORM_SPIRAL_MARCH_BLEND, SpiralMarch, spiralMarch, "Spiral March",
+                         SetupSpiralMarchBlend, SetupSpiralMarch, 13,
+                         DrawSpiralMarchParams, DrawOutput_spiralMarch,
+                         EFFECT_FLAG_BLEND | EFFECT_FLAG_INTERLEAVED)
+REGISTER_QUALITY_PARAM(TRANSFORM_SPIRAL_MARCH_BLEND, spiralMarch, marchSteps, 30, 120)
 // clang-format on
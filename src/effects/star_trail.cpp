@@ -82,8 +82,8 @@ void StarTrailEffectSetup(StarTrailEffect *e, const StarTrailConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->timeLoc, &e->time, SHADER_UNIFORM_FLOAT);
@@ -146,9 +146,12 @@ void StarTrailEffectRender(StarTrailEffect *e, const StarTrailConfig *cfg,
 }
 
 void StarTrailEffectResize(StarTrailEffect *e, int width, int height) {
-  UnloadPingPong(e);
+  const StarTrailEffect old = *e;
   InitPingPong(e, width, height);
-  e->readIdx = 0;
+  for (int i = 0; i < 2; i++) {
+    RenderUtilsResampleTexture(&old.pingPong[i], &e->pingPong[i]);
+  }
+  UnloadPingPong(&old);
 }
 
 void StarTrailEffectUninit(StarTrailEffect *e) {
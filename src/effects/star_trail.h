@@ -97,7 +97,7 @@ void StarTrailEffectSetup(StarTrailEffect *e, const StarTrailConfig *cfg,
 void StarTrailEffectRender(StarTrailEffect *e, const StarTrailConfig *cfg,
                            float deltaTime, int screenWidth, int screenHeight);
 
-// Reallocates ping-pong targets at new dimensions
+// Reallocates ping-pong targets at new dimensions, resampling the trails
 void StarTrailEffectResize(StarTrailEffect *e, int width, int height);
 
 // Unloads shader, frees LUT and ping-pong targets
@@ -60,8 +60,8 @@ void SynapseTreeEffectSetup(SynapseTreeEffect *e, const SynapseTreeConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
 
   SetShaderValue(e->shader, e->animPhaseLoc, &e->animPhase,
@@ -190,4 +190,5 @@ STANDARD_GENERATOR_OUTPUT(synapseTree)
 REGISTER_GENERATOR(TRANSFORM_SYNAPSE_TREE_BLEND, SynapseTree, synapseTree,
                    "Synapse Tree", SetupSynapseTreeBlend, SetupSynapseTree, 11,
                    DrawSynapseTreeParams, DrawOutput_synapseTree)
+REGISTER_QUALITY_PARAM(TRANSFORM_SYNAPSE_TREE_BLEND, synapseTree, marchSteps, 40, 200)
 // clang-format on
@@ -71,8 +71,8 @@ void SynthwaveEffectSetup(SynthwaveEffect *e, const SynthwaveConfig *cfg,
   e->gridTime += cfg->gridScrollSpeed * deltaTime;
   e->stripeTime += cfg->stripeScrollSpeed * deltaTime;
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->horizonYLoc, &cfg->horizonY,
                  SHADER_UNIFORM_FLOAT);
@@ -26,8 +26,8 @@ bool ToonEffectInit(ToonEffect *e) {
 }
 
 void ToonEffectSetup(const ToonEffect *e, const ToonConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->levelsLoc, &cfg->levels, SHADER_UNIFORM_INT);
   SetShaderValue(e->shader, e->edgeThresholdLoc, &cfg->edgeThreshold,
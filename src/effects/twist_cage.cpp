@@ -93,8 +93,8 @@ static void UploadUniforms(TwistCageEffect *e, const TwistCageConfig *cfg,
     edgeIdx[ei * 2 + 1] = (float)shape->edges[ei][1];
   }
 
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueV(e->shader, e->verticesLoc, verts, SHADER_UNIFORM_VEC3,
                   shape->vertexCount);
@@ -111,8 +111,8 @@ void VoxelMarchEffectSetup(VoxelMarchEffect *e, VoxelMarchConfig *cfg,
 
   ColorLUTUpdate(e->gradientLUT, &cfg->gradient);
 
-  const float resolution[2] = {static_cast<float>(GetScreenWidth()),
-                               static_cast<float>(GetScreenHeight())};
+  const float resolution[2] = {static_cast<float>(PostEffectRenderWidth()),
+                               static_cast<float>(PostEffectRenderHeight())};
   const float sampleRate = static_cast<float>(AUDIO_SAMPLE_RATE);
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValueTexture(e->shader, e->fftTextureLoc, fftTexture);
@@ -248,6 +248,9 @@ static void DrawVoxelMarchParams(EffectConfig *e, const ModSources *modSources,
 
 // clang-format off
 STANDARD_GENERATOR_OUTPUT(voxelMarch)
-REGISTER_GENERATOR(TRANSFORM_VOXEL_MARCH_BLEND, VoxelMarch, voxelMarch, "Voxel March",
-                   SetupVoxelMarchBlend, SetupVoxelMarch, 13, DrawVoxelMarchParams, DrawOutput_voxelMarch)
+REGISTER_GENERATOR_FLAGS(TRANSFORM_VOXEL_MARCH_BLEND, VoxelMarch, voxelMarch, "Voxel March",
+                         SetupVoxelMarchBlend, SetupVoxelMarch, 13,
+                         DrawVoxelMarchParams, DrawOutput_voxelMarch,
+                         EFFECT_FLAG_BLEND | EFFECT_FLAG_INTERLEAVED)
+REGISTER_QUALITY_PARAM(TRANSFORM_VOXEL_MARCH_BLEND, voxelMarch, marchSteps, 30, 80)
 // clang-format on
@@ -15,6 +15,7 @@ bool WatercolorEffectInit(WatercolorEffect *e) {
     return false;
   }
 
+  e->resolutionLoc = GetShaderLocation(e->shader, "resolution");
   e->samplesLoc = GetShaderLocation(e->shader, "samples");
   e->strokeStepLoc = GetShaderLocation(e->shader, "strokeStep");
   e->washStrengthLoc = GetShaderLocation(e->shader, "washStrength");
@@ -29,6 +30,9 @@ bool WatercolorEffectInit(WatercolorEffect *e) {
 
 void WatercolorEffectSetup(const WatercolorEffect *e,
                            const WatercolorConfig *cfg) {
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
+  SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   SetShaderValue(e->shader, e->samplesLoc, &cfg->samples, SHADER_UNIFORM_INT);
   SetShaderValue(e->shader, e->strokeStepLoc, &cfg->strokeStep,
                  SHADER_UNIFORM_FLOAT);
@@ -28,6 +28,7 @@ struct WatercolorConfig {
 
 typedef struct WatercolorEffect {
   Shader shader;
+  int resolutionLoc;
   int samplesLoc;
   int strokeStepLoc;
   int washStrengthLoc;
@@ -41,7 +42,7 @@ typedef struct WatercolorEffect {
 // Returns true on success, false if shader fails to load
 bool WatercolorEffectInit(WatercolorEffect *e);
 
-// Sets all uniforms except resolution (ApplyHalfResEffect handles resolution)
+// Sets all uniforms; resolution follows PostEffectRenderWidth/Height
 void WatercolorEffectSetup(const WatercolorEffect *e,
                            const WatercolorConfig *cfg);
 
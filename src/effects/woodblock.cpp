@@ -35,8 +35,8 @@ bool WoodblockEffectInit(WoodblockEffect *e) {
 
 void WoodblockEffectSetup(const WoodblockEffect *e,
                           const WoodblockConfig *cfg) {
-  const float resolution[2] = {(float)GetScreenWidth(),
-                               (float)GetScreenHeight()};
+  const float resolution[2] = {(float)PostEffectRenderWidth(),
+                               (float)PostEffectRenderHeight()};
   SetShaderValue(e->shader, e->resolutionLoc, resolution, SHADER_UNIFORM_VEC2);
   int levelsInt = (int)cfg->levels;
   SetShaderValue(e->shader, e->levelsLoc, &levelsInt, SHADER_UNIFORM_INT);
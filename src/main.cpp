@@ -5,6 +5,7 @@
 #include "analysis/analysis_pipeline.h"
 #include "audio/audio.h"
 #include "audio/audio_config.h"
+#include "audio/audio_file.h"
 #include "automation/drawable_params.h"
 #include "automation/lfo.h"
 #include "automation/mod_bus.h"
@@ -13,10 +14,24 @@
 #include "automation/param_registry.h"
 #include "config/app_configs.h"
 #include "config/constants.h"
+#include "config/effect_descriptor.h"
+#include "config/preset.h"
+#include "render/alloc_tracker.h"
+#include "render/cpu_profiler.h"
 #include "render/drawable.h"
+#include "render/flight_recorder.h"
+#include "render/frame_capture.h"
+#include "render/headless.h"
 #include "render/post_effect.h"
 #include "render/profiler.h"
+#include "render/quality_lod.h"
+#include "render/render_scale.h"
 #include "render/render_pipeline.h"
+#include "render/replay.h"
+#include "render/shader_bench.h"
+#include "render/shm_output.h"
+#include "simulation/sim_cpu.h"
+#include "ui/imgui_effects_dispatch.h"
 #include "ui/imgui_panels.h"
 #include "ui/loading_screen.h"
 #include "ui/ui_units.h"
@@ -24,6 +39,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 typedef struct AppContext {
   AnalysisPipeline analysis;
@@ -44,8 +60,92 @@ typedef struct AppContext {
   ModBusState modBusStates[NUM_MOD_BUSES];
   ModBusConfig modBusConfigs[NUM_MOD_BUSES];
   Profiler profiler;
+  RenderScale renderScale;
+  QualityLod qualityLod;
+  FrameCapture *recording; // Non-NULL while F9 recording is active
+  HeadlessWriter *recordWriter;
+  ReplayRecorder *replayRecorder; // Non-NULL while F10 replay logging
+  ReplayPlayer *replayPlayer;     // Non-NULL when inputs come from a log
 } AppContext;
 
+static bool WriteCapturedFrame(const FrameCaptureFrame *frame, void *userData) {
+  return HeadlessWriterWrite(static_cast<HeadlessWriter *>(userData),
+                             frame->pixels, frame->width, frame->height);
+}
+
+// F9 recording: Y4M of the internal render target via async readback. The
+// stream has a fixed size, so a render-scale change fails the writer and
+// ends the recording.
+static void StartRecording(AppContext *ctx) {
+  const time_t now = time(NULL);
+  char path[64];
+  // NOLINTNEXTLINE(concurrency-mt-unsafe) - called from the main thread only
+  const struct tm *local = localtime(&now);
+  if (local == NULL || strftime(path, sizeof(path),
+                                "capture_%Y%m%d_%H%M%S.y4m", local) == 0) {
+    return;
+  }
+
+  HeadlessOptions opts = {};
+  opts.outPath = path;
+  opts.format = HEADLESS_FORMAT_Y4M;
+  opts.width = ctx->postEffect->screenWidth;
+  opts.height = ctx->postEffect->screenHeight;
+  opts.fps = 60;
+  ctx->recordWriter = HeadlessWriterOpen(&opts);
+  if (ctx->recordWriter == NULL) {
+    return;
+  }
+  ctx->recording = FrameCaptureInit(WriteCapturedFrame, ctx->recordWriter,
+                                    FRAME_CAPTURE_RGBA8, false);
+  TraceLog(LOG_INFO, "FRAME_CAPTURE: Recording %dx%d to %s", opts.width,
+           opts.height, path);
+}
+
+static void StopRecording(AppContext *ctx) {
+  if (ctx->recording != NULL) {
+    FrameCaptureFlush(ctx->recording);
+    const FrameCaptureStats stats = FrameCaptureGetStats(ctx->recording);
+    FrameCaptureUninit(ctx->recording);
+    TraceLog(LOG_INFO, "FRAME_CAPTURE: Stopped, %llu frames, %llu dropped",
+             (unsigned long long)stats.delivered,
+             (unsigned long long)stats.dropped);
+    ctx->recording = NULL;
+  }
+  HeadlessWriterClose(ctx->recordWriter);
+  ctx->recordWriter = NULL;
+}
+
+static ReplayBinding AppContextReplayBinding(AppContext *ctx) {
+  return ReplayBinding{.effects = &ctx->postEffect->effects,
+                       .drawables = ctx->drawables,
+                       .drawableCount = &ctx->drawableCount,
+                       .audio = &ctx->audio,
+                       .modSources = &ctx->modSources,
+                       .analysis = &ctx->analysis,
+                       .postEffect = ctx->postEffect};
+}
+
+// F10 replay logging: every render input from here on goes to
+// replay_<timestamp>.ajr for `--headless --replay`
+static void StartReplayLog(AppContext *ctx) {
+  const time_t now = time(NULL);
+  char path[64];
+  // NOLINTNEXTLINE(concurrency-mt-unsafe) - called from the main thread only
+  const struct tm *local = localtime(&now);
+  if (local == NULL || strftime(path, sizeof(path),
+                                "replay_%Y%m%d_%H%M%S.ajr", local) == 0) {
+    return;
+  }
+  const ReplayBinding binding = AppContextReplayBinding(ctx);
+  ctx->replayRecorder = ReplayRecorderOpen(path, &binding);
+}
+
+static void StopReplayLog(AppContext *ctx) {
+  ReplayRecorderClose(ctx->replayRecorder);
+  ctx->replayRecorder = NULL;
+}
+
 static void AppContextUninit(AppContext *ctx) {
   if (ctx == NULL) {
     return;
@@ -54,12 +154,18 @@ static void AppContextUninit(AppContext *ctx) {
     AudioCaptureStop(ctx->capture);
     AudioCaptureUninit(ctx->capture);
   }
+  StopRecording(ctx);
+  StopReplayLog(ctx);
+  FlightRecorderUninit();
+  ProfilerUninit(&ctx->profiler);
   if (ctx->postEffect != NULL) {
+    ShmOutputUninit(ctx->postEffect->shmOutput);
     PostEffectUninit(ctx->postEffect);
   }
   AnalysisPipelineUninit(&ctx->analysis);
   DrawableStateUninit(&ctx->drawableState);
   ModEngineUninit();
+  SimCpuShutdown();
   free(ctx);
 }
 
@@ -82,9 +188,10 @@ static void AppContextUninit(AppContext *ctx) {
     }                                                                          \
   } while (0)
 
+// captureAudio is false for headless runs, which feed analysis from a file
 static AppContext *AppContextInit(int screenW, int screenH,
                                   PostEffectProgressFn onProgress,
-                                  void *userData) {
+                                  void *userData, bool captureAudio) {
   AppContext *ctx = static_cast<AppContext *>(calloc(1, sizeof(AppContext)));
   if (ctx == NULL) {
     return NULL;
@@ -92,8 +199,10 @@ static AppContext *AppContextInit(int screenW, int screenH,
 
   INIT_OR_FAIL(ctx->postEffect,
                PostEffectInit(screenW, screenH, onProgress, userData));
-  INIT_OR_FAIL(ctx->capture, AudioCaptureInit());
-  CHECK_OR_FAIL(AudioCaptureStart(ctx->capture));
+  if (captureAudio) {
+    INIT_OR_FAIL(ctx->capture, AudioCaptureInit());
+    CHECK_OR_FAIL(AudioCaptureStart(ctx->capture));
+  }
 
   // Initialize drawable system with one default waveform
   DrawableStateInit(&ctx->drawableState);
@@ -191,6 +300,9 @@ static AppContext *AppContextInit(int screenW, int screenH,
   }
 
   ProfilerInit(&ctx->profiler);
+  FlightRecorderInit();
+  RenderScaleInit(&ctx->renderScale);
+  QualityLodInit(&ctx->qualityLod);
 
   return ctx;
 }
@@ -231,6 +343,7 @@ static void UpdateFFTTexture(PostEffect *pe, const float *fftMagnitude) {
 // Visual updates run at 20Hz (sufficient for smooth display)
 static void UpdateVisuals(AppContext *ctx, PostEffect *pe,
                           const float *fftMagnitude) {
+  CPU_ZONE("UpdateVisuals");
   DrawableProcessWaveforms(&ctx->drawableState, ctx->analysis.audioBuffer,
                            ctx->analysis.lastFramesRead, ctx->drawables,
                            ctx->drawableCount, ctx->audio.channelMode);
@@ -241,17 +354,445 @@ static void UpdateVisuals(AppContext *ctx, PostEffect *pe,
   UpdateFFTTexture(pe, fftMagnitude);
 }
 
-static void OnLoadingProgress(float progress, void *userData) {
-  (void)userData;
-  DrawLoadingFrame(progress);
+static AppConfigs AppContextConfigs(AppContext *ctx) {
+  return AppConfigs{.drawables = ctx->drawables,
+                    .drawableCount = &ctx->drawableCount,
+                    .selectedDrawable = &ctx->selectedDrawable,
+                    .effects = &ctx->postEffect->effects,
+                    .audio = &ctx->audio,
+                    .beat = &ctx->analysis.beat,
+                    .bandEnergies = &ctx->analysis.bands,
+                    .lfos = ctx->modLFOConfigs,
+                    .modBuses = ctx->modBusConfigs,
+                    .postEffect = ctx->postEffect};
 }
 
-int main(void) {
-  SetConfigFlags(FLAG_WINDOW_RESIZABLE);
-  InitWindow(1920, 1080, "AudioJones");
-  SetTargetFPS(60);
+// Waveform history, modulation sources and routes, and drawable rotation:
+// everything a replay log captures the result of
+static void AppContextModulate(AppContext *ctx, float deltaTime) {
+  // Waveform history for ripple tank - 60fps for smoother gradients
+  AnalysisPipelineUpdateWaveformHistory(&ctx->analysis);
+
+  // Update modulation sources and apply routes
+  float lfoOutputs[NUM_LFOS];
+  for (int i = 0; i < NUM_LFOS; i++) {
+    lfoOutputs[i] =
+        LFOProcess(&ctx->modLFOs[i], &ctx->modLFOConfigs[i], deltaTime);
+  }
+  ModSourcesUpdate(&ctx->modSources, &ctx->analysis.bands, &ctx->analysis.beat,
+                   &ctx->analysis.features, lfoOutputs);
+  ModBusEvaluate(ctx->modBusStates, ctx->modBusConfigs, &ctx->modSources,
+                 deltaTime);
+  ModEngineUpdate(deltaTime, &ctx->modSources);
+
+  // Accumulate rotation speeds every frame
+  DrawableTickRotations(ctx->drawables, ctx->drawableCount, deltaTime);
+}
+
+// Everything downstream of audio analysis: modulation, drawables, and the
+// render pipeline. Leaves the frame open (BeginDrawing without EndDrawing).
+// During replay the player has already loaded this frame's modulated state.
+static void AppContextUpdate(AppContext *ctx, float deltaTime, double time) {
+  ctx->updateAccumulator += deltaTime;
+
+  if (ctx->replayPlayer == NULL) {
+    AppContextModulate(ctx, deltaTime);
+  }
+  if (ctx->replayRecorder != NULL) {
+    const ReplayBinding binding = AppContextReplayBinding(ctx);
+    if (!ReplayRecorderWrite(ctx->replayRecorder, &binding, deltaTime,
+                             time)) {
+      TraceLog(LOG_WARNING, "REPLAY: Write failed, stopping");
+      StopReplayLog(ctx);
+    }
+  }
+
+  // Visual updates at 20Hz (sufficient for smooth display)
+  const float updateInterval = 1.0f / 20.0f;
+  if (ctx->updateAccumulator >= updateInterval) {
+    UpdateVisuals(ctx, ctx->postEffect, ctx->analysis.fft.magnitude);
+    ctx->updateAccumulator = 0.0f;
+  }
+
+  const int screenW = ctx->postEffect->screenWidth;
+  const int screenH = ctx->postEffect->screenHeight;
+  RenderContext renderCtx = {
+      .screenW = screenW,
+      .screenH = screenH,
+      .centerX = screenW / 2,
+      .centerY = screenH / 2,
+      .minDim = (float)(screenW < screenH ? screenW : screenH),
+      .accumTexture = ctx->postEffect->outputTexture.texture,
+      .postEffect = ctx->postEffect,
+      .deltaTime = deltaTime,
+      .time = time};
+
+  RenderPipelineExecute(ctx->postEffect, &ctx->drawableState, ctx->drawables,
+                        ctx->drawableCount, &renderCtx, deltaTime,
+                        ctx->analysis.fft.magnitude,
+                        ctx->analysis.waveformHistory,
+                        ctx->analysis.waveformWriteIndex, &ctx->profiler);
+}
+
+// Optional shared-memory sink; failing to create it only disables the output
+static void AttachShmOutput(AppContext *ctx, const ShmOutputConfig *cfg) {
+  if (ctx == NULL) {
+    return;
+  }
+  ctx->postEffect->shmOutput =
+      ShmOutputInit(cfg, ctx->postEffect->screenWidth,
+                    ctx->postEffect->screenHeight);
+}
+
+// Per-frame CSV for A/B comparisons. GPU zone times come from the profiler's
+// double-buffered queries and so trail the CPU column by one frame.
+static FILE *OpenTimings(const char *path, const Profiler *profiler) {
+  if (path == NULL) {
+    return NULL;
+  }
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    TraceLog(LOG_WARNING, "HEADLESS: Cannot open %s", path);
+    return NULL;
+  }
+  // NOLINTBEGIN(cert-err33-c) - timing output is best-effort
+  fputs("frame,updateMs", file);
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    fprintf(file, ",%sMs", profiler->zones[i].name);
+  }
+  fputc('\n', file);
+  // NOLINTEND(cert-err33-c)
+  return file;
+}
+
+static void WriteTimings(FILE *file, int frame, double updateMs,
+                         const Profiler *profiler) {
+  if (file == NULL) {
+    return;
+  }
+  // NOLINTBEGIN(cert-err33-c) - timing output is best-effort
+  fprintf(file, "%d,%.4f", frame, updateMs);
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    fprintf(file, ",%.4f", profiler->zones[i].lastMs);
+  }
+  fputc('\n', file);
+  // NOLINTEND(cert-err33-c)
+}
+
+// Render and submit one headless frame; false once the sink fails
+static bool RenderHeadlessFrame(AppContext *ctx, FrameCapture *capture,
+                                FILE *timings, int frame, float deltaTime,
+                                double time) {
+  const double startS = GetTime();
+  AppContextUpdate(ctx, deltaTime, time);
+
+  // Read the final target rather than the hidden window's back buffer,
+  // whose pixels are undefined when the window is not visible. Readback
+  // overlaps rendering of the next frames.
+  FrameCaptureSubmit(capture, *ctx->postEffect->presented, time);
+  const double updateMs = (GetTime() - startS) * 1000.0;
+  EndDrawing();
+  WriteTimings(timings, frame, updateMs, &ctx->profiler);
+  if (FrameCaptureGetStats(capture).sinkFailed) {
+    TraceLog(LOG_ERROR, "HEADLESS: Failed to write frame %d", frame);
+    return false;
+  }
+  return true;
+}
+
+// Render opts->frameCount frames (or the whole file) of a preset against an
+// audio file. Each frame consumes exactly 1/fps seconds of samples, so the
+// audio clock drives every deltaTime instead of wall time.
+static int RenderAudioFile(AppContext *ctx, const HeadlessOptions *opts,
+                           FrameCapture *capture, FILE *timings) {
+  AudioFile *audio = AudioFileOpen(opts->audioPath);
+  Preset preset;
+  if (audio == NULL || !PresetLoad(&preset, opts->presetPath)) {
+    TraceLog(LOG_ERROR, "HEADLESS: Setup failed (preset %s, audio %s)",
+             opts->presetPath, opts->audioPath);
+    AudioFileClose(audio);
+    return -1;
+  }
+  AppConfigs configs = AppContextConfigs(ctx);
+  PresetToAppConfigs(&preset, &configs);
+  PostEffectClearFeedback(ctx->postEffect);
+
+  const float deltaTime = 1.0f / (float)opts->fps;
+  const uint64_t totalSamples = AudioFileLengthFrames(audio);
+  float samples[AUDIO_MAX_FRAMES_PER_UPDATE * AUDIO_CHANNELS];
+  uint64_t samplesConsumed = 0;
+  int result = 0;
+
+  for (int frame = 0; opts->frameCount == 0 || frame < opts->frameCount;
+       frame++) {
+    CPU_ZONE("Frame");
+    // Exact integer sample boundaries so fractional rates never drift
+    const uint64_t frameEnd =
+        (uint64_t)(frame + 1) * AUDIO_SAMPLE_RATE / (uint64_t)opts->fps;
+    const uint32_t wanted = (uint32_t)(frameEnd - samplesConsumed);
+    const uint32_t got = AudioFileRead(audio, samples, wanted);
+    samplesConsumed = frameEnd;
+    if (got == 0 && opts->frameCount == 0) {
+      break;
+    }
+
+    AnalysisPipelineProcessBuffer(&ctx->analysis, samples, got, deltaTime);
+    if (!RenderHeadlessFrame(ctx, capture, timings, frame, deltaTime,
+                             (double)frame * deltaTime)) {
+      result = -1;
+      break;
+    }
+
+    if (frame % opts->fps == 0) {
+      TraceLog(LOG_INFO, "HEADLESS: Frame %d (%.1f / %.1f s)", frame,
+               (double)samplesConsumed / AUDIO_SAMPLE_RATE,
+               (double)totalSamples / AUDIO_SAMPLE_RATE);
+    }
+  }
+
+  AudioFileClose(audio);
+  return result;
+}
+
+// Render a replay log's frames with their recorded inputs. Analysis and
+// modulation are bypassed, so two builds see identical frame inputs.
+static int RenderReplay(AppContext *ctx, ReplayPlayer *player,
+                        const HeadlessOptions *opts, FrameCapture *capture,
+                        FILE *timings) {
+  const ReplayBinding binding = AppContextReplayBinding(ctx);
+  if (!ReplayPlayerBegin(player, &binding)) {
+    return -1;
+  }
+  ctx->replayPlayer = player;
+
+  int result = 0;
+  for (int frame = 0; opts->frameCount == 0 || frame < opts->frameCount;
+       frame++) {
+    CPU_ZONE("Frame");
+    float deltaTime = 0.0f;
+    double time = 0.0;
+    const ReplayReadResult read =
+        ReplayPlayerNext(player, &binding, &deltaTime, &time);
+    if (read != REPLAY_READ_FRAME) {
+      result = (read == REPLAY_READ_END) ? 0 : -1;
+      break;
+    }
+    if (!RenderHeadlessFrame(ctx, capture, timings, frame, deltaTime, time)) {
+      result = -1;
+      break;
+    }
+    if (frame % opts->fps == 0) {
+      TraceLog(LOG_INFO, "HEADLESS: Replay frame %d (%.1f s)", frame, time);
+    }
+  }
+
+  ctx->replayPlayer = NULL;
+  return result;
+}
+
+// Offline rendering of either a preset against an audio file or a replay
+// log. Replays render at the recorded internal resolution.
+static int RunHeadless(const HeadlessOptions *options) {
+  HeadlessRedirectLog();
+  HeadlessOptions opts = *options;
+  ReplayPlayer *player = NULL;
+  if (opts.replayPath != NULL) {
+    ReplayInfo info;
+    player = ReplayPlayerOpen(opts.replayPath, &info);
+    if (player == NULL) {
+      return -1;
+    }
+    opts.width = info.width;
+    opts.height = info.height;
+  }
+
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(opts.width, opts.height, "AudioJones (headless)");
+
+  AppContext *ctx = AppContextInit(opts.width, opts.height, NULL, NULL, false);
+  AttachShmOutput(ctx, &opts.shm);
+  HeadlessWriter *writer = HeadlessWriterOpen(&opts);
+  FrameCapture *capture =
+      writer != NULL ? FrameCaptureInit(WriteCapturedFrame, writer,
+                                        FRAME_CAPTURE_RGBA8, true)
+                     : NULL;
+  FILE *timings = NULL;
+  int result = -1;
+
+  if (ctx != NULL && capture != NULL) {
+    timings = OpenTimings(opts.timingsPath, &ctx->profiler);
+    if (player != NULL) {
+      result = RenderReplay(ctx, player, &opts, capture, timings);
+    } else {
+      result = RenderAudioFile(ctx, &opts, capture, timings);
+    }
+  }
+
+  if (capture != NULL) {
+    FrameCaptureFlush(capture);
+    if (FrameCaptureGetStats(capture).sinkFailed) {
+      result = -1;
+    }
+  }
+  if (timings != NULL) {
+    // NOLINTNEXTLINE(cert-err33-c) - nothing to recover at shutdown
+    fclose(timings);
+  }
+  FrameCaptureUninit(capture);
+  HeadlessWriterClose(writer);
+  ReplayPlayerClose(player);
+  AppContextUninit(ctx);
+  CloseWindow();
+  return result;
+}
+
+// Deterministic bench input: a 120 BPM bass pulse under a mid tone and a
+// treble shimmer, so audio-reactive effects have something to react to
+static void FillBenchSignal(float *samples, uint32_t frameCount,
+                            uint64_t firstFrame) {
+  const double twoPi = 6.283185307179586;
+  for (uint32_t i = 0; i < frameCount; i++) {
+    const double t = (double)(firstFrame + i) / AUDIO_SAMPLE_RATE;
+    const double pulse = fmod(t * 2.0, 1.0) < 0.1 ? 1.0 : 0.2;
+    const double value = 0.5 * pulse * sin(twoPi * 55.0 * t) +
+                         0.2 * sin(twoPi * 440.0 * t) +
+                         0.1 * sin(twoPi * 3520.0 * t);
+    samples[i * AUDIO_CHANNELS] = (float)value;
+    samples[i * AUDIO_CHANNELS + 1] = (float)value;
+  }
+}
+
+// Render one variant from a reset pipeline: analysis, drawables, feedback,
+// and RNGs start over, so output does not depend on what ran before
+static ShaderBenchResult BenchVariant(AppContext *ctx,
+                                      const ShaderBenchVariant *variant,
+                                      int frames) {
+  PostEffect *pe = ctx->postEffect;
+  ShaderBenchApplyVariant(&pe->effects, variant);
+  AnalysisPipelineUninit(&ctx->analysis);
+  AnalysisPipelineInit(&ctx->analysis);
+  DrawableStateUninit(&ctx->drawableState);
+  DrawableStateInit(&ctx->drawableState);
+  ctx->updateAccumulator = 0.0f;
+  pe->fftMaxMagnitude = 0.0f;
+  pe->warpTime = 0.0f;
+  pe->interleaveFrame = 0;
+  srand(1);
+  SetRandomSeed(1);
+  PostEffectClearFeedback(pe);
+
+  const float deltaTime = 1.0f / 60.0f;
+  const uint32_t rate = AUDIO_SAMPLE_RATE;
+  float samples[AUDIO_MAX_FRAMES_PER_UPDATE * AUDIO_CHANNELS];
+  static float gpuMs[SHADER_BENCH_MAX_FRAMES];
+  static float frameMs[SHADER_BENCH_MAX_FRAMES];
+  int gpuCount = 0;
+  int frameCount = 0;
+  float gpuMaxMs = 0.0f;
+
+  // Scope timings read back in frame f belong to frame f - (LATENCY - 1)
+  const int lag = PROFILER_SCOPE_LATENCY - 1;
+  const int first = SHADER_BENCH_WARMUP_FRAMES;
+  for (int f = 0; f < first + frames + lag; f++) {
+    const uint64_t begin = (uint64_t)f * rate / 60;
+    const uint64_t end = (uint64_t)(f + 1) * rate / 60;
+    FillBenchSignal(samples, (uint32_t)(end - begin), begin);
+
+    const double startS = GetTime();
+    AnalysisPipelineProcessBuffer(&ctx->analysis, samples,
+                                  (uint32_t)(end - begin), deltaTime);
+    AppContextUpdate(ctx, deltaTime, (double)f * deltaTime);
+    EndDrawing();
+    ShaderBenchFinishFrame();
+    if (f >= first && f < first + frames) {
+      frameMs[frameCount++] = (float)((GetTime() - startS) * 1000.0);
+    }
+
+    // The baseline enables no effects, so it has no scopes; its pipeline
+    // zones come back one frame late instead
+    const bool baseline = variant->type == TRANSFORM_EFFECT_COUNT;
+    const float sampled = baseline ? ShaderBenchZoneMs(&ctx->profiler)
+                                   : ShaderBenchSampledMs(&ctx->profiler);
+    const int measured = f - (baseline ? 1 : lag);
+    if (sampled >= 0.0f && measured >= first && measured < first + frames) {
+      gpuMs[gpuCount++] = sampled;
+      gpuMaxMs = fmaxf(gpuMaxMs, sampled);
+    }
+  }
+
+  ShaderBenchResult result = {};
+  result.variant = *variant;
+  result.width = pe->screenWidth;
+  result.height = pe->screenHeight;
+  result.samples = gpuCount;
+  result.gpuMs = ShaderBenchMedian(gpuMs, gpuCount);
+  result.gpuMaxMs = gpuMaxMs;
+  result.frameMs = ShaderBenchMedian(frameMs, frameCount);
+  result.hash = ShaderBenchHashTarget(*pe->presented);
+  return result;
+}
+
+// Per-effect GPU cost suite, or a comparison of two of its reports
+static int RunBench(const ShaderBenchOptions *opts) {
+  HeadlessRedirectLog();
+  if (opts->basePath != NULL) {
+    const int regressions =
+        ShaderBenchCompare(opts->basePath, opts->comparePath, opts->threshold);
+    return regressions == 0 ? 0 : 1;
+  }
+
+  int maxW = 0;
+  int maxH = 0;
+  for (int i = 0; i < opts->sizeCount; i++) {
+    maxW = opts->widths[i] > maxW ? opts->widths[i] : maxW;
+    maxH = opts->heights[i] > maxH ? opts->heights[i] : maxH;
+  }
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(maxW, maxH, "AudioJones (bench)");
+
+  AppContext *ctx = AppContextInit(opts->widths[0], opts->heights[0], NULL,
+                                   NULL, false);
+  if (ctx == NULL) {
+    CloseWindow();
+    return -1;
+  }
+
+  static ShaderBenchVariant variants[SHADER_BENCH_MAX_VARIANTS];
+  const int variantCount = ShaderBenchListVariants(
+      variants, sizeof(variants) / sizeof(variants[0]));
+  ShaderBenchReport *report = ShaderBenchReportCreate(opts->frames);
+
+  for (int s = 0; s < opts->sizeCount; s++) {
+    PostEffectResize(ctx->postEffect, opts->widths[s], opts->heights[s]);
+    for (int v = 0; v < variantCount; v++) {
+      const ShaderBenchResult result =
+          BenchVariant(ctx, &variants[v], opts->frames);
+      ShaderBenchReportAdd(report, &result);
+      TraceLog(LOG_INFO, "SHADER_BENCH: %dx%d %s (%s) %.3f ms GPU",
+               result.width, result.height,
+               v == 0 ? "baseline" : EffectDescriptorName(variants[v].type),
+               variants[v].name, result.gpuMs);
+    }
+  }
+
+  const int hashResults = ShaderBenchSpatialHash(report, opts->frames);
+  const int cpuSimResults = ShaderBenchCpuSims(
+      report, opts->widths[0], opts->heights[0], opts->frames);
+
+  const bool written = ShaderBenchReportWrite(report, opts->outPath);
+  if (written) {
+    TraceLog(LOG_INFO, "SHADER_BENCH: Wrote %d results to %s",
+             variantCount * opts->sizeCount + hashResults + cpuSimResults,
+             opts->outPath);
+  }
+  ShaderBenchReportFree(report);
+  AppContextUninit(ctx);
+  CloseWindow();
+  return written ? 0 : -1;
+}
 
-  // Two-stage rlImGui init for custom font loading
+// Two-stage rlImGui init for custom font loading, then the committed layout
+static void InitImGui(void) {
   rlImGuiBeginInitImGui();
   ImGuiIO &io = ImGui::GetIO();
   io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
@@ -263,90 +804,198 @@ int main(void) {
   ImGui::LoadIniSettingsFromDisk("audiojones_layout.ini");
 
   ImGuiApplyNeonTheme();
+}
+
+static void DrawPanels(AppContext *ctx, AppConfigs *configs) {
+  rlImGuiBegin();
+  ImGuiDrawDockspace();
+  ImGuiDrawEffectsPanel(&ctx->postEffect->effects, &ctx->modSources);
+  ImGuiDrawDrawablesPanel(ctx->drawables, &ctx->drawableCount,
+                          &ctx->selectedDrawable, &ctx->modSources);
+  ImGuiDrawAudioPanel(&ctx->audio);
+  ImGuiDrawAnalysisPanel(&ctx->analysis.beat, &ctx->analysis.bands,
+                         &ctx->analysis.features, &ctx->profiler,
+                         &ctx->renderScale, &ctx->qualityLod,
+                         &ctx->postEffect->effects);
+  ImGuiDrawLFOPanel(ctx->modLFOConfigs, ctx->modLFOs, &ctx->modSources);
+  ImGuiDrawBusPanel(ctx->modBusConfigs, ctx->modBusStates, &ctx->modSources);
+  ImGuiDrawPresetPanel(configs);
+  rlImGuiEnd();
+}
+
+// Render a preset against the bench signal with the UI panels drawn, as an
+// interactive frame with nothing clicked, and fail when any frame after
+// warmup allocates through operator new
+static int RunAllocCheck(const HeadlessOptions *opts) {
+  HeadlessRedirectLog();
+  if (!ALLOC_TRACKER_ENABLED) {
+    TraceLog(LOG_ERROR,
+             "ALLOC_TRACKER: Build with AUDIOJONES_ALLOC_TRACKER=ON to check");
+    return -1;
+  }
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(opts->width, opts->height, "AudioJones (alloc check)");
+
+  AppContext *ctx =
+      AppContextInit(opts->width, opts->height, NULL, NULL, false);
+  Preset preset;
+  if (ctx == NULL || !PresetLoad(&preset, opts->allocCheckPath)) {
+    TraceLog(LOG_ERROR, "ALLOC_TRACKER: Setup failed (preset %s)",
+             opts->allocCheckPath);
+    AppContextUninit(ctx);
+    CloseWindow();
+    return -1;
+  }
+  AppConfigs configs = AppContextConfigs(ctx);
+  PresetToAppConfigs(&preset, &configs);
+  PostEffectClearFeedback(ctx->postEffect);
+
+  // Open every enabled effect's section so its sliders (and their
+  // modulation lookups) run each frame
+  InitImGui();
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    g_effectSectionOpen[i] =
+        IsTransformEnabled(&ctx->postEffect->effects, (TransformEffectType)i);
+  }
+
+  const float deltaTime = 1.0f / 60.0f;
+  const uint32_t rate = AUDIO_SAMPLE_RATE;
+  float samples[AUDIO_MAX_FRAMES_PER_UPDATE * AUDIO_CHANNELS];
+  const int first = ALLOC_TRACKER_WARMUP_FRAMES;
+  for (int f = 0; f < first + opts->allocCheckFrames; f++) {
+    CPU_ZONE("Frame");
+    if (f == first) {
+      AllocTrackerReset();
+    }
+    AllocTrackerNextFrame();
+    const uint64_t begin = (uint64_t)f * rate / 60;
+    const uint64_t end = (uint64_t)(f + 1) * rate / 60;
+    FillBenchSignal(samples, (uint32_t)(end - begin), begin);
+    AnalysisPipelineProcessBuffer(&ctx->analysis, samples,
+                                  (uint32_t)(end - begin), deltaTime);
+    AppContextUpdate(ctx, deltaTime, (double)f * deltaTime);
+    DrawPanels(ctx, &configs);
+    EndDrawing();
+  }
+  AllocTrackerNextFrame(); // Close the last checked frame
+
+  const AllocTrackerStats *stats = AllocTrackerGetStats();
+  TraceLog(stats->dirtyFrames == 0 ? LOG_INFO : LOG_ERROR,
+           "ALLOC_TRACKER: %s: %llu / %llu frames allocated",
+           opts->allocCheckPath, (unsigned long long)stats->dirtyFrames,
+           (unsigned long long)stats->frames);
+  for (int i = 0; i < stats->total.siteCount; i++) {
+    const AllocSite &site = stats->total.sites[i];
+    TraceLog(LOG_ERROR, "ALLOC_TRACKER:   %s: %u allocs, %llu bytes",
+             site.zone, site.count, (unsigned long long)site.bytes);
+  }
+
+  rlImGuiShutdown();
+  AppContextUninit(ctx);
+  CloseWindow();
+  return stats->dirtyFrames == 0 ? 0 : 1;
+}
+
+static void OnLoadingProgress(float progress, void *userData) {
+  (void)userData;
+  DrawLoadingFrame(progress);
+}
+
+int main(int argc, char **argv) {
+  HeadlessOptions headless;
+  if (!HeadlessParseArgs(argc, argv, &headless)) {
+    return -1;
+  }
+  SimCpuForce(headless.cpuSims);
+  if (headless.enabled) {
+    return RunHeadless(&headless);
+  }
+  if (headless.allocCheckPath != NULL) {
+    return RunAllocCheck(&headless);
+  }
+  if (headless.bench.enabled || headless.bench.basePath != NULL) {
+    return RunBench(&headless.bench);
+  }
+
+  SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+  InitWindow(1920, 1080, "AudioJones");
+  SetTargetFPS(60);
+
+  InitImGui();
+  const ImGuiIO &io = ImGui::GetIO();
 
   // Initial black frame to eliminate white flash
   BeginDrawing();
   ClearBackground(BLACK);
   EndDrawing();
 
-  AppContext *ctx = AppContextInit(1920, 1080, OnLoadingProgress, NULL);
+  AppContext *ctx = AppContextInit(1920, 1080, OnLoadingProgress, NULL, true);
   if (ctx == NULL) {
     CloseWindow();
     return -1;
   }
+  AttachShmOutput(ctx, &headless.shm);
 
   DrawLoadingFrame(1.0f);
 
-  const float updateInterval = 1.0f / 20.0f;
-
   while (!WindowShouldClose()) {
+    CPU_ZONE("Frame");
+    AllocTrackerNextFrame();
     const float deltaTime = GetFrameTime();
-    ctx->updateAccumulator += deltaTime;
+
+    // deltaTime and events noted last iteration describe the previous frame
+    FlightRecorderRecordFrame(deltaTime * 1000.0f, &ctx->profiler,
+                              AudioCaptureAvailable(ctx->capture),
+                              &ctx->postEffect->effects);
 
     if (IsWindowResized()) {
       const int newWidth = GetScreenWidth();
       const int newHeight = GetScreenHeight();
+      char note[FLIGHT_EVENT_TEXT_MAX];
+      // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size event buffer
+      snprintf(note, sizeof(note), "%dx%d", newWidth, newHeight);
+      FlightRecorderNote(FLIGHT_EVENT_RESIZE, note);
       PostEffectResize(ctx->postEffect, newWidth, newHeight);
     }
 
+    PostEffectSetRenderScale(
+        ctx->postEffect,
+        RenderScaleUpdate(&ctx->renderScale, &ctx->profiler, deltaTime));
+    QualityLodUpdate(&ctx->qualityLod, &ctx->profiler, deltaTime,
+                     ctx->postEffect->qualityLevel);
+
     if (IsKeyPressed(KEY_TAB) && !io.WantCaptureKeyboard) {
       ctx->uiVisible = !ctx->uiVisible;
     }
+    if (IsKeyPressed(KEY_F9) && !io.WantCaptureKeyboard) {
+      if (ctx->recording != NULL) {
+        StopRecording(ctx);
+      } else {
+        StartRecording(ctx);
+      }
+    }
+    if (IsKeyPressed(KEY_F10) && !io.WantCaptureKeyboard) {
+      if (ctx->replayRecorder != NULL) {
+        StopReplayLog(ctx);
+      } else {
+        StartReplayLog(ctx);
+      }
+    }
 
     // Audio analysis every frame for accurate beat detection
     AnalysisPipelineProcess(&ctx->analysis, ctx->capture, deltaTime);
+    AppContextUpdate(ctx, deltaTime, GetTime());
 
-    // Waveform history for ripple tank - 60fps for smoother gradients
-    AnalysisPipelineUpdateWaveformHistory(&ctx->analysis);
-
-    // Update modulation sources and apply routes
-    float lfoOutputs[NUM_LFOS];
-    for (int i = 0; i < NUM_LFOS; i++) {
-      lfoOutputs[i] =
-          LFOProcess(&ctx->modLFOs[i], &ctx->modLFOConfigs[i], deltaTime);
-    }
-    ModSourcesUpdate(&ctx->modSources, &ctx->analysis.bands,
-                     &ctx->analysis.beat, &ctx->analysis.features, lfoOutputs);
-    ModBusEvaluate(ctx->modBusStates, ctx->modBusConfigs, &ctx->modSources,
-                   deltaTime);
-    ModEngineUpdate(deltaTime, &ctx->modSources);
-
-    // Accumulate rotation speeds every frame
-    DrawableTickRotations(ctx->drawables, ctx->drawableCount, deltaTime);
-
-    // Visual updates at 20Hz (sufficient for smooth display)
-    if (ctx->updateAccumulator >= updateInterval) {
-      UpdateVisuals(ctx, ctx->postEffect, ctx->analysis.fft.magnitude);
-      ctx->updateAccumulator = 0.0f;
+    if (ctx->recording != NULL) {
+      FrameCaptureSubmit(ctx->recording, *ctx->postEffect->presented,
+                         GetTime());
+      if (FrameCaptureGetStats(ctx->recording).sinkFailed) {
+        TraceLog(LOG_WARNING, "FRAME_CAPTURE: Write failed, stopping");
+        StopRecording(ctx);
+      }
     }
 
-    const int screenW = ctx->postEffect->screenWidth;
-    const int screenH = ctx->postEffect->screenHeight;
-    RenderContext renderCtx = {
-        .screenW = screenW,
-        .screenH = screenH,
-        .centerX = screenW / 2,
-        .centerY = screenH / 2,
-        .minDim = (float)(screenW < screenH ? screenW : screenH),
-        .accumTexture = ctx->postEffect->outputTexture.texture,
-        .postEffect = ctx->postEffect};
-
-    RenderPipelineExecute(ctx->postEffect, &ctx->drawableState, ctx->drawables,
-                          ctx->drawableCount, &renderCtx, deltaTime,
-                          ctx->analysis.fft.magnitude,
-                          ctx->analysis.waveformHistory,
-                          ctx->analysis.waveformWriteIndex, &ctx->profiler);
-
-    AppConfigs configs = {.drawables = ctx->drawables,
-                          .drawableCount = &ctx->drawableCount,
-                          .selectedDrawable = &ctx->selectedDrawable,
-                          .effects = &ctx->postEffect->effects,
-                          .audio = &ctx->audio,
-                          .beat = &ctx->analysis.beat,
-                          .bandEnergies = &ctx->analysis.bands,
-                          .lfos = ctx->modLFOConfigs,
-                          .modBuses = ctx->modBusConfigs,
-                          .postEffect = ctx->postEffect};
+    AppConfigs configs = AppContextConfigs(ctx);
 
     if (!io.WantCaptureKeyboard) {
       if (IsKeyPressed(KEY_LEFT)) {
@@ -358,22 +1007,17 @@ int main(void) {
     }
 
     if (ctx->uiVisible) {
-      rlImGuiBegin();
-      ImGuiDrawDockspace();
-      ImGuiDrawEffectsPanel(&ctx->postEffect->effects, &ctx->modSources);
-      ImGuiDrawDrawablesPanel(ctx->drawables, &ctx->drawableCount,
-                              &ctx->selectedDrawable, &ctx->modSources);
-      ImGuiDrawAudioPanel(&ctx->audio);
-      ImGuiDrawAnalysisPanel(&ctx->analysis.beat, &ctx->analysis.bands,
-                             &ctx->analysis.features, &ctx->profiler);
-      ImGuiDrawLFOPanel(ctx->modLFOConfigs, ctx->modLFOs, &ctx->modSources);
-      ImGuiDrawBusPanel(ctx->modBusConfigs, ctx->modBusStates,
-                        &ctx->modSources);
-      ImGuiDrawPresetPanel(&configs);
-      rlImGuiEnd();
+      DrawPanels(ctx, &configs);
     } else {
       DrawText("[Tab] Show UI", 10, 10, 16, GRAY);
     }
+    if (ctx->recording != NULL) {
+      DrawText("REC", GetScreenWidth() - 44, 10, 16, RED);
+    }
+    if (ctx->replayRecorder != NULL) {
+      DrawText("LOG", GetScreenWidth() - 44, 30, 16, ORANGE);
+    }
+    CPU_ZONE("EndDrawing"); // Includes swap and the frame limiter wait
     EndDrawing();
   }
 
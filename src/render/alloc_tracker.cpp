@@ -0,0 +1,126 @@
+#include "alloc_tracker.h"
+#include "cpu_profiler.h"
+#include <string.h>
+
+static AllocTrackerStats g_stats;
+static AllocFrameStats g_frame; // Frame in progress
+static bool g_frameOpen = false;
+
+#if ALLOC_TRACKER_ENABLED
+
+#include <new>
+#include <stdlib.h>
+
+static thread_local bool t_frameThread = false;
+
+static bool SameZone(const char *a, const char *b) {
+  return a == b || strcmp(a, b) == 0;
+}
+
+// Must not allocate: runs inside operator new
+static void AddSite(AllocFrameStats *stats, const char *zone, uint32_t count,
+                    uint64_t bytes) {
+  stats->count += count;
+  stats->bytes += bytes;
+  for (int i = 0; i < stats->siteCount; i++) {
+    if (SameZone(stats->sites[i].zone, zone)) {
+      stats->sites[i].count += count;
+      stats->sites[i].bytes += bytes;
+      return;
+    }
+  }
+  if (stats->siteCount < ALLOC_TRACKER_MAX_SITES) {
+    stats->sites[stats->siteCount++] = AllocSite{zone, count, bytes};
+    return;
+  }
+  // Table full: fold the rest into the last slot
+  AllocSite *last = &stats->sites[ALLOC_TRACKER_MAX_SITES - 1];
+  last->zone = "(other)";
+  last->count += count;
+  last->bytes += bytes;
+}
+
+static void SortSites(AllocFrameStats *stats) {
+  for (int i = 1; i < stats->siteCount; i++) {
+    const AllocSite site = stats->sites[i];
+    int j = i;
+    for (; j > 0 && stats->sites[j - 1].count < site.count; j--) {
+      stats->sites[j] = stats->sites[j - 1];
+    }
+    stats->sites[j] = site;
+  }
+}
+
+static void Record(size_t size) {
+  if (!t_frameThread || !g_frameOpen) {
+    return;
+  }
+  const char *zone = CpuProfilerCurrentZone();
+  AddSite(&g_frame, zone != NULL ? zone : "(no zone)", 1, size);
+}
+
+void AllocTrackerNextFrame(void) {
+  t_frameThread = true;
+  if (g_frameOpen) {
+    SortSites(&g_frame);
+    g_stats.lastFrame = g_frame;
+    g_stats.frames++;
+    if (g_frame.count > 0) {
+      g_stats.dirtyFrames++;
+      for (int i = 0; i < g_frame.siteCount; i++) {
+        const AllocSite &site = g_frame.sites[i];
+        AddSite(&g_stats.total, site.zone, site.count, site.bytes);
+      }
+      SortSites(&g_stats.total);
+    }
+  }
+  g_frame = AllocFrameStats{};
+  g_frameOpen = true;
+}
+
+void *operator new(size_t size) {
+  Record(size);
+  void *p = malloc(size != 0 ? size : 1);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+  Record(size);
+  return malloc(size != 0 ? size : 1);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+  Record(size);
+  return malloc(size != 0 ? size : 1);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { free(p); }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept { free(p); }
+
+#else
+
+void AllocTrackerNextFrame(void) {}
+
+#endif // ALLOC_TRACKER_ENABLED
+
+void AllocTrackerReset(void) {
+  g_stats = AllocTrackerStats{};
+  g_frame = AllocFrameStats{};
+  g_frameOpen = false;
+}
+
+const AllocTrackerStats *AllocTrackerGetStats(void) { return &g_stats; }
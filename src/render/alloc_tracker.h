@@ -0,0 +1,57 @@
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <stdint.h>
+
+// Heap allocation tracker for the frame loop. Built with
+// -DALLOC_TRACKER_ENABLED=1 (CMake option AUDIOJONES_ALLOC_TRACKER), it
+// replaces the global operator new and counts allocations made on the
+// thread that calls AllocTrackerNextFrame, per frame, attributed to the
+// innermost CPU profiler zone (cpu_profiler.h).
+//
+// Only operator new is hooked. Interposing malloc would also count GL driver
+// and ImGui allocations on the frame thread, which the app cannot avoid.
+//
+//   AudioJones --alloc-check PRESET.json [--alloc-check-frames N]
+//              [--size WxH]
+//
+// renders a preset against a synthetic signal and exits non-zero when any
+// frame after warmup allocates.
+#ifndef ALLOC_TRACKER_ENABLED
+#define ALLOC_TRACKER_ENABLED 0
+#endif
+
+#define ALLOC_TRACKER_MAX_SITES 32
+#define ALLOC_TRACKER_WARMUP_FRAMES 120 // Settle visual updates and sims
+#define ALLOC_TRACKER_CHECK_FRAMES 300  // Default --alloc-check-frames
+
+typedef struct AllocSite {
+  const char *zone; // Innermost CPU zone, "(no zone)" outside any
+  uint32_t count;
+  uint64_t bytes;
+} AllocSite;
+
+typedef struct AllocFrameStats {
+  uint32_t count;
+  uint64_t bytes;
+  int siteCount;
+  AllocSite sites[ALLOC_TRACKER_MAX_SITES]; // Most allocations first
+} AllocFrameStats;
+
+typedef struct AllocTrackerStats {
+  AllocFrameStats lastFrame;
+  AllocFrameStats total; // Every completed frame since reset
+  uint64_t frames;       // Completed frames since reset
+  uint64_t dirtyFrames;  // Completed frames that allocated
+} AllocTrackerStats;
+
+// Close the frame in progress and start the next one. The calling thread
+// becomes the tracked frame thread.
+void AllocTrackerNextFrame(void);
+
+// Clear the counters and drop the frame in progress
+void AllocTrackerReset(void);
+
+const AllocTrackerStats *AllocTrackerGetStats(void);
+
+#endif // ALLOC_TRACKER_H
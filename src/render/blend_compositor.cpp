@@ -16,6 +16,8 @@ BlendCompositor *BlendCompositorInit(void) {
   }
 
   bc->effectMapLoc = GetShaderLocation(bc->shader, "effectMap");
+  bc->previousMapLoc = GetShaderLocation(bc->shader, "previousMap");
+  bc->stepAlphaLoc = GetShaderLocation(bc->shader, "stepAlpha");
   bc->intensityLoc = GetShaderLocation(bc->shader, "intensity");
   bc->blendModeLoc = GetShaderLocation(bc->shader, "blendMode");
 
@@ -35,8 +37,20 @@ void BlendCompositorUninit(BlendCompositor *bc) {
 void BlendCompositorApply(const BlendCompositor *bc,
                           const Texture2D &effectTexture, float intensity,
                           EffectBlendMode mode) {
+  BlendCompositorApplyStepped(bc, effectTexture, effectTexture, 1.0f,
+                              intensity, mode);
+}
+
+void BlendCompositorApplyStepped(const BlendCompositor *bc,
+                                 const Texture2D &previousTexture,
+                                 const Texture2D &effectTexture,
+                                 float stepAlpha, float intensity,
+                                 EffectBlendMode mode) {
   const int blendModeInt = (int)mode;
   SetShaderValueTexture(bc->shader, bc->effectMapLoc, effectTexture);
+  SetShaderValueTexture(bc->shader, bc->previousMapLoc, previousTexture);
+  SetShaderValue(bc->shader, bc->stepAlphaLoc, &stepAlpha,
+                 SHADER_UNIFORM_FLOAT);
   SetShaderValue(bc->shader, bc->intensityLoc, &intensity,
                  SHADER_UNIFORM_FLOAT);
   SetShaderValue(bc->shader, bc->blendModeLoc, &blendModeInt,
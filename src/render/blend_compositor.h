@@ -10,6 +10,8 @@
 typedef struct BlendCompositor {
   Shader shader;
   int effectMapLoc;
+  int previousMapLoc;
+  int stepAlphaLoc;
   int intensityLoc;
   int blendModeLoc;
 } BlendCompositor;
@@ -27,4 +29,12 @@ void BlendCompositorApply(const BlendCompositor *bc,
                           const Texture2D &effectTexture, float intensity,
                           EffectBlendMode mode);
 
+// As BlendCompositorApply, compositing previousTexture crossfaded into
+// effectTexture by stepAlpha (fixed-step simulation trails between steps)
+void BlendCompositorApplyStepped(const BlendCompositor *bc,
+                                 const Texture2D &previousTexture,
+                                 const Texture2D &effectTexture,
+                                 float stepAlpha, float intensity,
+                                 EffectBlendMode mode);
+
 #endif // BLEND_COMPOSITOR_H
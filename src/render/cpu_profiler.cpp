@@ -0,0 +1,202 @@
+#include "cpu_profiler.h"
+#include "raylib.h"
+#include <stdio.h>
+
+#if CPU_PROFILER_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct ZoneEvent {
+  const char *name;
+  const char *detail;
+  uint64_t startNs;
+  uint64_t endNs;
+};
+
+// Single-writer ring. head counts every write; readers take the last
+// CPU_PROFILER_RING_SIZE entries before it.
+struct ZoneRing {
+  ZoneEvent events[CPU_PROFILER_RING_SIZE];
+  std::atomic<uint32_t> head{0};
+  int tid;
+  const char *threadName;
+};
+
+} // namespace
+
+// Track id reserved for GPU intervals so they sort below the CPU threads
+static const int GPU_TRACK_TID = 1000;
+
+static std::mutex g_ringsMutex;
+static std::vector<std::unique_ptr<ZoneRing>> g_rings;
+static thread_local ZoneRing *t_ring = nullptr;
+static thread_local const char *t_zone = nullptr;
+
+static ZoneRing *NewRing(int tid, const char *threadName) {
+  std::unique_ptr<ZoneRing> ring(new ZoneRing());
+  ring->tid = tid;
+  ring->threadName = threadName;
+  ZoneRing *raw = ring.get();
+  g_rings.push_back(std::move(ring));
+  return raw;
+}
+
+// First thread to record is the main loop; later ones are workers
+static ZoneRing *ThreadRing(void) {
+  if (t_ring == nullptr) {
+    const std::lock_guard<std::mutex> lock(g_ringsMutex);
+    int cpuRings = 0;
+    for (const auto &ring : g_rings) {
+      cpuRings += ring->tid != GPU_TRACK_TID ? 1 : 0;
+    }
+    t_ring = NewRing(cpuRings + 1, cpuRings == 0 ? "Main" : "Worker");
+  }
+  return t_ring;
+}
+
+static ZoneRing *GpuRing(void) {
+  static ZoneRing *ring = nullptr;
+  if (ring == nullptr) {
+    const std::lock_guard<std::mutex> lock(g_ringsMutex);
+    ring = NewRing(GPU_TRACK_TID, "GPU");
+  }
+  return ring;
+}
+
+static void PushEvent(ZoneRing *ring, const ZoneEvent &event) {
+  const uint32_t idx = ring->head.load(std::memory_order_relaxed);
+  ring->events[idx % CPU_PROFILER_RING_SIZE] = event;
+  ring->head.store(idx + 1, std::memory_order_release);
+}
+
+uint64_t CpuProfilerNowNs(void) {
+  return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void CpuProfilerRecord(const char *name, uint64_t startNs, uint64_t endNs) {
+  PushEvent(ThreadRing(), {name, nullptr, startNs, endNs});
+}
+
+void CpuProfilerRecordGpu(const char *name, const char *detail,
+                          uint64_t startNs, uint64_t endNs) {
+  PushEvent(GpuRing(), {name, detail, startNs, endNs});
+}
+
+const char *CpuProfilerCurrentZone(void) { return t_zone; }
+
+const char *CpuProfilerPushZone(const char *name) {
+  const char *previous = t_zone;
+  t_zone = name;
+  return previous;
+}
+
+void CpuProfilerPopZone(const char *previous) { t_zone = previous; }
+
+// Zone names come from literals and descriptor names; escape defensively
+static void WriteJsonString(FILE *f, const char *s) {
+  fputc('"', f);
+  for (; s != nullptr && *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\') {
+      fputc('\\', f);
+    }
+    fputc(*s, f);
+  }
+  fputc('"', f);
+}
+
+static void WriteEvent(FILE *f, const ZoneRing &ring, const ZoneEvent &e,
+                       uint64_t originNs) {
+  fputs(",\n{\"ph\":\"X\",\"pid\":1,\"name\":", f);
+  if (e.detail != nullptr) {
+    char label[128];
+    (void)snprintf(label, sizeof(label), "%s (%s)", e.name, e.detail);
+    WriteJsonString(f, label);
+  } else {
+    WriteJsonString(f, e.name);
+  }
+  (void)fprintf(f, ",\"cat\":\"%s\",\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                ring.tid == GPU_TRACK_TID ? "gpu" : "cpu", ring.tid,
+                (double)(e.startNs - originNs) / 1000.0,
+                (double)(e.endNs - e.startNs) / 1000.0);
+}
+
+// Oldest retained event across all rings becomes ts = 0
+static uint64_t TraceOrigin(void) {
+  uint64_t origin = UINT64_MAX;
+  for (const auto &ring : g_rings) {
+    const uint32_t head = ring->head.load(std::memory_order_acquire);
+    const uint32_t count =
+        head < CPU_PROFILER_RING_SIZE ? head : CPU_PROFILER_RING_SIZE;
+    for (uint32_t i = head - count; i != head; i++) {
+      const uint64_t start = ring->events[i % CPU_PROFILER_RING_SIZE].startNs;
+      origin = start < origin ? start : origin;
+    }
+  }
+  return origin == UINT64_MAX ? 0 : origin;
+}
+
+bool CpuProfilerExportTrace(const char *path) {
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    TraceLog(LOG_WARNING, "CPU_PROFILER: Failed to open %s", path);
+    return false;
+  }
+
+  const std::lock_guard<std::mutex> lock(g_ringsMutex);
+  const uint64_t originNs = TraceOrigin();
+  int written = 0;
+  fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+        "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+        "\"args\":{\"name\":\"AudioJones\"}}",
+        f);
+  for (const auto &ring : g_rings) {
+    (void)fprintf(f,
+                  ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                  "\"name\":\"thread_name\",\"args\":{\"name\":\"%s\"}}",
+                  ring->tid, ring->threadName);
+    // Events overwritten mid-export are tolerated; this is a debug dump
+    const uint32_t head = ring->head.load(std::memory_order_acquire);
+    const uint32_t count =
+        head < CPU_PROFILER_RING_SIZE ? head : CPU_PROFILER_RING_SIZE;
+    for (uint32_t i = head - count; i != head; i++) {
+      WriteEvent(f, *ring, ring->events[i % CPU_PROFILER_RING_SIZE], originNs);
+      written++;
+    }
+  }
+  fputs("\n]}\n", f);
+  const bool ok = ferror(f) == 0;
+  (void)fclose(f);
+
+  TraceLog(ok ? LOG_INFO : LOG_WARNING, "CPU_PROFILER: Wrote %d events to %s",
+           written, path);
+  return ok;
+}
+
+#else
+
+uint64_t CpuProfilerNowNs(void) { return 0; }
+
+void CpuProfilerRecord(const char *, uint64_t, uint64_t) {}
+
+void CpuProfilerRecordGpu(const char *, const char *, uint64_t, uint64_t) {}
+
+const char *CpuProfilerCurrentZone(void) { return NULL; }
+
+const char *CpuProfilerPushZone(const char *) { return NULL; }
+
+void CpuProfilerPopZone(const char *) {}
+
+bool CpuProfilerExportTrace(const char *path) {
+  TraceLog(LOG_WARNING, "CPU_PROFILER: Compiled out, cannot write %s", path);
+  return false;
+}
+
+#endif // CPU_PROFILER_ENABLED
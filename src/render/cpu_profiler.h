@@ -0,0 +1,72 @@
+#ifndef CPU_PROFILER_H
+#define CPU_PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// CPU zone profiler. Each thread records completed zones into its own ring;
+// the GPU profiler feeds readback timestamps into a shared GPU ring so both
+// land on one timeline in the exported Chrome/Perfetto trace.
+//
+// Build with -DCPU_PROFILER_ENABLED=0 to compile every zone out.
+#ifndef CPU_PROFILER_ENABLED
+#define CPU_PROFILER_ENABLED 1
+#endif
+
+// Zones kept per thread ring; older zones are overwritten
+#define CPU_PROFILER_RING_SIZE 65536
+
+// Monotonic clock in nanoseconds (0 when compiled out)
+uint64_t CpuProfilerNowNs(void);
+
+// Record a completed zone on the calling thread. name must be a string
+// literal or otherwise outlive the profiler.
+void CpuProfilerRecord(const char *name, uint64_t startNs, uint64_t endNs);
+
+// Innermost open zone on the calling thread, or NULL outside any zone or
+// when compiled out. Used to attribute allocations (alloc_tracker.h).
+const char *CpuProfilerCurrentZone(void);
+
+// Make name the calling thread's innermost zone; returns the previous one
+// for CpuProfilerPopZone
+const char *CpuProfilerPushZone(const char *name);
+void CpuProfilerPopZone(const char *previous);
+
+// Record a GPU interval already converted to the CPU clock
+void CpuProfilerRecordGpu(const char *name, const char *detail,
+                          uint64_t startNs, uint64_t endNs);
+
+// Write every ring as Chrome trace event JSON. Returns false when the file
+// cannot be written or the profiler is compiled out.
+bool CpuProfilerExportTrace(const char *path);
+
+#if CPU_PROFILER_ENABLED
+
+// RAII zone: records from construction to end of scope
+struct CpuProfilerZone {
+  const char *name;
+  const char *parent;
+  uint64_t startNs;
+  explicit CpuProfilerZone(const char *zoneName)
+      : name(zoneName), parent(CpuProfilerPushZone(zoneName)),
+        startNs(CpuProfilerNowNs()) {}
+  ~CpuProfilerZone() {
+    CpuProfilerRecord(name, startNs, CpuProfilerNowNs());
+    CpuProfilerPopZone(parent);
+  }
+  CpuProfilerZone(const CpuProfilerZone &) = delete;
+  CpuProfilerZone &operator=(const CpuProfilerZone &) = delete;
+};
+
+#define CPU_ZONE_CONCAT_INNER(a, b) a##b
+#define CPU_ZONE_CONCAT(a, b) CPU_ZONE_CONCAT_INNER(a, b)
+#define CPU_ZONE(name)                                                         \
+  const CpuProfilerZone CPU_ZONE_CONCAT(cpuZone_, __LINE__)(name)
+
+#else
+
+#define CPU_ZONE(name) ((void)0)
+
+#endif // CPU_PROFILER_ENABLED
+
+#endif // CPU_PROFILER_H
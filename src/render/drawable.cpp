@@ -1,4 +1,5 @@
 #include "drawable.h"
+#include "cpu_profiler.h"
 #include "draw_utils.h"
 #include <cmath>
 #include <string.h>
@@ -49,6 +50,7 @@ void DrawableStateUninit(DrawableState *state) {
 void DrawableProcessWaveforms(DrawableState *state, const float *audioBuffer,
                               uint32_t framesRead, const Drawable *drawables,
                               int count, ChannelMode channelMode) {
+  CPU_ZONE("DrawableProcessWaveforms");
   // Process base waveform from audio
   ProcessWaveformBase(audioBuffer, framesRead, state->waveform, channelMode);
 
@@ -152,7 +154,7 @@ static void DrawableRenderParametricTrail(RenderContext *ctx, Drawable *d,
   ParametricTrailData &trail = d->parametricTrail;
 
   // Compute cursor position via selected motion type
-  const float deltaTime = GetFrameTime();
+  const float deltaTime = ctx->deltaTime;
   float offsetX;
   float offsetY;
   switch (trail.motionType) {
@@ -171,7 +173,7 @@ static void DrawableRenderParametricTrail(RenderContext *ctx, Drawable *d,
   // Draw gate check
   bool shouldDraw = true;
   if (trail.gateFreq > 0.0f) {
-    const float gatePhase = fmodf((float)GetTime() * trail.gateFreq, 1.0f);
+    const float gatePhase = fmodf((float)ctx->time * trail.gateFreq, 1.0f);
     shouldDraw = gatePhase < 0.5f;
   }
 
@@ -182,7 +184,7 @@ static void DrawableRenderParametricTrail(RenderContext *ctx, Drawable *d,
   // Convert to screen coordinates
   const Vector2 pos = {x * ctx->screenW, y * ctx->screenH};
   const float t = (trail.motionType == TRAIL_MOTION_RANDOM_WALK)
-                      ? fmodf((float)GetTime(), 1.0f)
+                      ? fmodf((float)ctx->time, 1.0f)
                       : fmodf(trail.lissajous.phase, 1.0f);
   const Color color = ColorFromConfig(&d->base.color, t, opacity);
 
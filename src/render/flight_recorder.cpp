@@ -0,0 +1,270 @@
+#include "flight_recorder.h"
+#include "config/effect_descriptor.h"
+#include "raylib.h"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+using json = nlohmann::json;
+
+#define EFFECT_BIT_WORDS ((TRANSFORM_EFFECT_COUNT + 31) / 32)
+
+// Median needs a few seconds of history before hitches are trusted
+static const unsigned int MEDIAN_MIN_SAMPLES = 30;
+
+static const char *EVENT_NAMES[FLIGHT_EVENT_TYPE_COUNT] = {
+    "preset", "playlist", "resize", "reinit"};
+
+struct FlightFrame {
+  unsigned int index;
+  double timeS;
+  float frameMs;
+  float zoneMs[ZONE_COUNT];
+  uint32_t audioBacklog;
+  uint32_t effectBits[EFFECT_BIT_WORDS];
+  int eventCount;
+  FlightEvent events[FLIGHT_EVENTS_PER_FRAME];
+};
+
+static FlightRecorderConfig g_config;
+static FlightFrame g_frames[FLIGHT_RECORDER_FRAMES];
+static FlightFrame g_pending; // Collects events until committed
+static unsigned int g_frameCount;
+static float g_medianWindow[FLIGHT_RECORDER_MEDIAN_WINDOW];
+static float g_medianMs;
+static FlightHitch g_hitches[FLIGHT_RECORDER_MAX_HITCHES];
+static int g_hitchCount;
+static int g_captureHitch = -1; // Hitch awaiting post frames, or -1
+static int g_captureRemaining;  // Post frames still to record
+static const char *g_zoneNames[ZONE_COUNT];
+
+void FlightRecorderInit(void) {
+  g_config.enabled = true;
+  g_config.thresholdRatio = 2.5f;
+  g_config.minHitchMs = 25.0f;
+  g_pending = FlightFrame{};
+  g_frameCount = 0;
+  g_medianMs = 0.0f;
+  g_hitchCount = 0;
+  g_captureHitch = -1;
+  g_captureRemaining = 0;
+}
+
+FlightRecorderConfig *FlightRecorderGetConfig(void) { return &g_config; }
+
+float FlightRecorderMedianMs(void) { return g_medianMs; }
+
+int FlightRecorderHitchCount(void) { return g_hitchCount; }
+
+const FlightHitch *FlightRecorderGetHitch(int index) {
+  if (index < 0 || index >= g_hitchCount) {
+    return NULL;
+  }
+  return &g_hitches[index];
+}
+
+void FlightRecorderNote(FlightEventType type, const char *text) {
+  if (g_pending.eventCount >= FLIGHT_EVENTS_PER_FRAME) {
+    return;
+  }
+  FlightEvent *e = &g_pending.events[g_pending.eventCount++];
+  e->type = type;
+  strncpy(e->text, text != NULL ? text : "", FLIGHT_EVENT_TEXT_MAX - 1);
+  e->text[FLIGHT_EVENT_TEXT_MAX - 1] = '\0';
+}
+
+static json FrameToJson(const FlightFrame &f) {
+  json j;
+  j["frame"] = f.index;
+  j["time"] = f.timeS;
+  j["ms"] = f.frameMs;
+  json zones = json::object();
+  for (int z = 0; z < ZONE_COUNT; z++) {
+    zones[g_zoneNames[z] != NULL ? g_zoneNames[z] : "zone"] = f.zoneMs[z];
+  }
+  j["gpuZonesMs"] = zones;
+  j["audioBacklog"] = f.audioBacklog;
+  json effects = json::array();
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if ((f.effectBits[i / 32] & (1u << (i % 32))) != 0) {
+      effects.push_back(TransformEffectName((TransformEffectType)i));
+    }
+  }
+  j["effects"] = effects;
+  json events = json::array();
+  for (int i = 0; i < f.eventCount; i++) {
+    events.push_back({{"type", EVENT_NAMES[f.events[i].type]},
+                      {"text", f.events[i].text}});
+  }
+  j["events"] = events;
+  return j;
+}
+
+static json HitchToJson(const FlightHitch &h) {
+  return {{"frame", h.frameIndex}, {"time", h.timeS},
+          {"ms", h.frameMs},       {"medianMs", h.medianMs},
+          {"spikes", h.spikeCount}, {"cause", h.cause}};
+}
+
+// Serialization happens off the render thread so the dump does not cause
+// the next hitch
+static void WriteCaptureFile(std::string path, FlightHitch hitch,
+                             std::vector<FlightFrame> frames) {
+  json j;
+  j["hitch"] = HitchToJson(hitch);
+  json list = json::array();
+  for (const FlightFrame &f : frames) {
+    list.push_back(FrameToJson(f));
+  }
+  j["frames"] = list;
+  try {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+      TraceLog(LOG_WARNING, "FLIGHT_RECORDER: Failed to open %s", path.c_str());
+      return;
+    }
+    file << j.dump(1);
+    TraceLog(LOG_INFO, "FLIGHT_RECORDER: Wrote %d frames to %s",
+             (int)frames.size(), path.c_str());
+  } catch (...) {
+    TraceLog(LOG_WARNING, "FLIGHT_RECORDER: Failed to write %s", path.c_str());
+  }
+}
+
+static void WriteCapture(FlightHitch *hitch, bool wait) {
+  const unsigned int oldest = g_frameCount > FLIGHT_RECORDER_FRAMES
+                                  ? g_frameCount - FLIGHT_RECORDER_FRAMES
+                                  : 0;
+  unsigned int first = hitch->frameIndex > FLIGHT_RECORDER_PRE_FRAMES
+                           ? hitch->frameIndex - FLIGHT_RECORDER_PRE_FRAMES
+                           : 0;
+  first = first < oldest ? oldest : first;
+
+  std::vector<FlightFrame> frames;
+  frames.reserve(g_frameCount - first);
+  for (unsigned int i = first; i < g_frameCount; i++) {
+    frames.push_back(g_frames[i % FLIGHT_RECORDER_FRAMES]);
+  }
+
+  const time_t now = time(NULL);
+  // NOLINTNEXTLINE(concurrency-mt-unsafe) - called from the main thread only
+  const struct tm *local = localtime(&now);
+  if (local == NULL || strftime(hitch->path, sizeof(hitch->path),
+                                "hitch_%Y%m%d_%H%M%S.json", local) == 0) {
+    hitch->path[0] = '\0';
+    return;
+  }
+
+  std::thread writer(WriteCaptureFile, std::string(hitch->path), *hitch,
+                     std::move(frames));
+  if (wait) {
+    writer.join();
+  } else {
+    writer.detach();
+  }
+}
+
+void FlightRecorderUninit(void) {
+  if (g_captureHitch >= 0) {
+    WriteCapture(&g_hitches[g_captureHitch], true);
+    g_captureHitch = -1;
+  }
+}
+
+// Median of the previous frames, excluding the one being tested
+static float UpdateMedian(float frameMs) {
+  const int count = g_frameCount < FLIGHT_RECORDER_MEDIAN_WINDOW
+                        ? (int)g_frameCount
+                        : FLIGHT_RECORDER_MEDIAN_WINDOW;
+  float sorted[FLIGHT_RECORDER_MEDIAN_WINDOW];
+  memcpy(sorted, g_medianWindow, sizeof(float) * count);
+  std::nth_element(sorted, sorted + count / 2, sorted + count);
+  const float median = count > 0 ? sorted[count / 2] : 0.0f;
+  g_medianWindow[g_frameCount % FLIGHT_RECORDER_MEDIAN_WINDOW] = frameMs;
+  return median;
+}
+
+// Most recent event within the last second, formatted as "type: text"
+static void FindCause(unsigned int frameIndex, char *out, size_t size) {
+  out[0] = '\0';
+  const unsigned int lookback = 60;
+  for (unsigned int n = 0; n <= lookback && n <= frameIndex; n++) {
+    const unsigned int idx = frameIndex - n;
+    if (idx + FLIGHT_RECORDER_FRAMES < g_frameCount) {
+      return;
+    }
+    const FlightFrame &f = g_frames[idx % FLIGHT_RECORDER_FRAMES];
+    if (f.eventCount > 0) {
+      const FlightEvent &e = f.events[f.eventCount - 1];
+      (void)snprintf(out, size, "%s: %s", EVENT_NAMES[e.type], e.text);
+      return;
+    }
+  }
+}
+
+static void BeginCapture(const FlightFrame &f, float medianMs) {
+  if (g_hitchCount == FLIGHT_RECORDER_MAX_HITCHES) {
+    memmove(&g_hitches[0], &g_hitches[1],
+            sizeof(FlightHitch) * (FLIGHT_RECORDER_MAX_HITCHES - 1));
+    g_hitchCount--;
+  }
+  FlightHitch *h = &g_hitches[g_hitchCount++];
+  *h = FlightHitch{};
+  h->frameIndex = f.index;
+  h->timeS = f.timeS;
+  h->frameMs = f.frameMs;
+  h->medianMs = medianMs;
+  FindCause(f.index, h->cause, sizeof(h->cause));
+  TraceLog(LOG_INFO, "FLIGHT_RECORDER: Hitch %.1f ms (median %.1f) %s",
+           f.frameMs, medianMs, h->cause);
+
+  g_captureHitch = g_hitchCount - 1;
+  g_captureRemaining = FLIGHT_RECORDER_POST_FRAMES;
+}
+
+static void DetectHitch(const FlightFrame &f, float medianMs) {
+  const bool spike = g_config.enabled && f.index >= MEDIAN_MIN_SAMPLES &&
+                     f.frameMs > medianMs * g_config.thresholdRatio &&
+                     f.frameMs > g_config.minHitchMs;
+  if (g_captureHitch >= 0) {
+    g_hitches[g_captureHitch].spikeCount += spike ? 1 : 0;
+    if (--g_captureRemaining <= 0) {
+      WriteCapture(&g_hitches[g_captureHitch], false);
+      g_captureHitch = -1;
+    }
+  } else if (spike) {
+    BeginCapture(f, medianMs);
+  }
+}
+
+void FlightRecorderRecordFrame(float frameMs, const Profiler *profiler,
+                               uint32_t audioBacklog,
+                               const EffectConfig *effects) {
+  FlightFrame f = g_pending;
+  g_pending = FlightFrame{};
+  f.index = g_frameCount;
+  f.timeS = GetTime();
+  f.frameMs = frameMs;
+  f.audioBacklog = audioBacklog;
+  for (int z = 0; z < ZONE_COUNT && profiler != NULL; z++) {
+    f.zoneMs[z] = profiler->zones[z].lastMs;
+    g_zoneNames[z] = profiler->zones[z].name;
+  }
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT && effects != NULL; i++) {
+    if (IsTransformEnabled(effects, (TransformEffectType)i)) {
+      f.effectBits[i / 32] |= 1u << (i % 32);
+    }
+  }
+
+  g_frames[g_frameCount % FLIGHT_RECORDER_FRAMES] = f;
+  const float medianMs = UpdateMedian(frameMs);
+  g_frameCount++;
+  g_medianMs = medianMs;
+  DetectHitch(f, medianMs);
+}
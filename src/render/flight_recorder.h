@@ -0,0 +1,72 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "config/effect_config.h"
+#include "profiler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Continuously records per-frame state and dumps the surrounding window to
+// hitch_<timestamp>.json when a frame exceeds thresholdRatio x the rolling
+// median frame time. Module-global so deep call sites (preset loads, render
+// target reallocation) can attach events without plumbing.
+
+#define FLIGHT_RECORDER_FRAMES 600 // Ring capacity, 10 s at 60 fps
+#define FLIGHT_RECORDER_MEDIAN_WINDOW 120
+#define FLIGHT_RECORDER_PRE_FRAMES 180  // Frames written before the hitch
+#define FLIGHT_RECORDER_POST_FRAMES 60  // Frames written after the hitch
+#define FLIGHT_RECORDER_MAX_HITCHES 32  // Viewer list, oldest dropped
+#define FLIGHT_EVENTS_PER_FRAME 4
+#define FLIGHT_EVENT_TEXT_MAX 64
+
+typedef enum FlightEventType {
+  FLIGHT_EVENT_PRESET_LOAD = 0,
+  FLIGHT_EVENT_PLAYLIST,
+  FLIGHT_EVENT_RESIZE,
+  FLIGHT_EVENT_REINIT,
+  FLIGHT_EVENT_TYPE_COUNT
+} FlightEventType;
+
+typedef struct FlightEvent {
+  FlightEventType type;
+  char text[FLIGHT_EVENT_TEXT_MAX];
+} FlightEvent;
+
+typedef struct FlightRecorderConfig {
+  bool enabled;
+  float thresholdRatio; // Hitch when frame ms > ratio x rolling median
+  float minHitchMs;     // Ignore spikes shorter than this
+} FlightRecorderConfig;
+
+typedef struct FlightHitch {
+  unsigned int frameIndex;
+  double timeS; // GetTime() at the hitch
+  float frameMs;
+  float medianMs;
+  int spikeCount; // Further spikes inside the same capture window
+  char cause[FLIGHT_EVENT_TEXT_MAX]; // Nearest preceding event, or empty
+  char path[64];                     // Empty until the window is written
+} FlightHitch;
+
+void FlightRecorderInit(void);
+
+// Writes any capture still waiting for post-hitch frames
+void FlightRecorderUninit(void);
+
+FlightRecorderConfig *FlightRecorderGetConfig(void);
+
+// Attach an event to the frame currently being recorded. text is copied.
+void FlightRecorderNote(FlightEventType type, const char *text);
+
+// Commit one frame. frameMs is the wall time of the frame that just ended.
+void FlightRecorderRecordFrame(float frameMs, const Profiler *profiler,
+                               uint32_t audioBacklog,
+                               const EffectConfig *effects);
+
+float FlightRecorderMedianMs(void);
+
+// Captured hitches, oldest first
+int FlightRecorderHitchCount(void);
+const FlightHitch *FlightRecorderGetHitch(int index);
+
+#endif // FLIGHT_RECORDER_H
@@ -0,0 +1,309 @@
+#include "frame_capture.h"
+#include "cpu_profiler.h"
+#include "external/glad.h"
+#include "rlgl.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+// Slot lifecycle. Only the main thread touches GL; the consumer thread only
+// reads mapped memory and flips MAPPED -> RELEASED when done with it.
+enum SlotState {
+  SLOT_FREE = 0,
+  SLOT_PENDING,  // Readback issued, fence not yet signaled
+  SLOT_MAPPED,   // Mapped and queued for (or inside) the sink
+  SLOT_RELEASED, // Sink done; main thread must unmap before reuse
+};
+
+// Wait per lossless stall; generous since a frame can take a while offline
+static const GLuint64 STALL_TIMEOUT_NS = 1000000000ull;
+
+struct CaptureSlot {
+  GLuint pbo;
+  GLsync fence;
+  int width;
+  int height;
+  uint64_t sequence;
+  double timeS;
+  const unsigned char *mapped;
+  std::atomic<int> state;
+};
+
+struct FrameCapture {
+  FrameCaptureSinkFn sink;
+  void *userData;
+  FrameCaptureFormat format;
+  bool lossless;
+
+  CaptureSlot slots[FRAME_CAPTURE_SLOTS];
+  int submitIdx; // Next slot to write
+  int retireIdx; // Oldest slot still PENDING, in submit order
+
+  std::thread consumer;
+  std::mutex mutex;
+  std::condition_variable wake;     // Consumer: queue changed or stopping
+  std::condition_variable released; // Main: a slot was released
+  std::deque<int> queue;
+  bool stopping;
+
+  uint64_t submitted;
+  uint64_t dropped;
+  std::atomic<uint64_t> delivered;
+  std::atomic<bool> sinkFailed;
+  float submitMs;
+};
+
+static int BytesPerPixel(FrameCaptureFormat format) {
+  switch (format) {
+  case FRAME_CAPTURE_RGBA16F:
+    return 8;
+  case FRAME_CAPTURE_R8:
+    return 1;
+  case FRAME_CAPTURE_RGBA8:
+  default:
+    return 4;
+  }
+}
+
+static int SlotBytes(const FrameCapture *capture, const CaptureSlot *slot) {
+  return slot->width * slot->height * BytesPerPixel(capture->format);
+}
+
+static void ConsumerMain(FrameCapture *capture) {
+  for (;;) {
+    int idx;
+    {
+      std::unique_lock<std::mutex> lock(capture->mutex);
+      capture->wake.wait(lock, [capture] {
+        return capture->stopping || !capture->queue.empty();
+      });
+      if (capture->queue.empty()) {
+        return;
+      }
+      idx = capture->queue.front();
+      capture->queue.pop_front();
+    }
+
+    CaptureSlot *slot = &capture->slots[idx];
+    FrameCaptureFrame frame = {};
+    frame.pixels = slot->mapped;
+    frame.format = capture->format;
+    frame.width = slot->width;
+    frame.height = slot->height;
+    frame.bytes = SlotBytes(capture, slot);
+    frame.sequence = slot->sequence;
+    frame.timeS = slot->timeS;
+    if (!capture->sink(&frame, capture->userData)) {
+      capture->sinkFailed = true;
+    }
+    capture->delivered++;
+
+    {
+      const std::lock_guard<std::mutex> lock(capture->mutex);
+      slot->state = SLOT_RELEASED;
+    }
+    capture->released.notify_all();
+  }
+}
+
+FrameCapture *FrameCaptureInit(FrameCaptureSinkFn sink, void *userData,
+                               FrameCaptureFormat format, bool lossless) {
+  if (sink == NULL) {
+    return NULL;
+  }
+
+  FrameCapture *capture = new FrameCapture();
+  capture->sink = sink;
+  capture->userData = userData;
+  capture->format = format;
+  capture->lossless = lossless;
+
+  GLuint pbos[FRAME_CAPTURE_SLOTS];
+  glGenBuffers(FRAME_CAPTURE_SLOTS, pbos);
+  for (int i = 0; i < FRAME_CAPTURE_SLOTS; i++) {
+    capture->slots[i].pbo = pbos[i];
+    capture->slots[i].state = SLOT_FREE;
+  }
+
+  capture->consumer = std::thread(ConsumerMain, capture);
+  return capture;
+}
+
+// Unmap every slot the consumer has finished with
+static void RecycleReleased(FrameCapture *capture) {
+  for (int i = 0; i < FRAME_CAPTURE_SLOTS; i++) {
+    CaptureSlot *slot = &capture->slots[i];
+    if (slot->state != SLOT_RELEASED) {
+      continue;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot->mapped = NULL;
+    slot->state = SLOT_FREE;
+  }
+}
+
+// Map signaled slots in submit order and queue them for the consumer.
+// timeoutNs > 0 waits that long for the oldest fence.
+static void RetireSignaled(FrameCapture *capture, GLuint64 timeoutNs) {
+  for (int n = 0; n < FRAME_CAPTURE_SLOTS; n++) {
+    CaptureSlot *slot = &capture->slots[capture->retireIdx];
+    if (slot->state != SLOT_PENDING) {
+      return;
+    }
+
+    const GLenum status = glClientWaitSync(
+        slot->fence, timeoutNs > 0 ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+        timeoutNs);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      return;
+    }
+    timeoutNs = 0;
+    glDeleteSync(slot->fence);
+    slot->fence = NULL;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+    slot->mapped = static_cast<const unsigned char *>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, SlotBytes(capture, slot),
+                         GL_MAP_READ_BIT));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    {
+      const std::lock_guard<std::mutex> lock(capture->mutex);
+      if (slot->mapped == NULL) {
+        // Mapping failed; skip the frame rather than wedge the ring
+        slot->state = SLOT_RELEASED;
+      } else {
+        slot->state = SLOT_MAPPED;
+        capture->queue.push_back(capture->retireIdx);
+      }
+    }
+    capture->wake.notify_one();
+    capture->retireIdx = (capture->retireIdx + 1) % FRAME_CAPTURE_SLOTS;
+  }
+}
+
+void FrameCapturePoll(FrameCapture *capture) {
+  if (capture == NULL) {
+    return;
+  }
+  RecycleReleased(capture);
+  RetireSignaled(capture, 0);
+}
+
+// Block until slot is free, waiting on its fence and then on the sink
+static void WaitForSlot(FrameCapture *capture, CaptureSlot *slot) {
+  while (slot->state != SLOT_FREE) {
+    if (slot->state == SLOT_PENDING) {
+      RetireSignaled(capture, STALL_TIMEOUT_NS);
+    } else {
+      std::unique_lock<std::mutex> lock(capture->mutex);
+      capture->released.wait(
+          lock, [slot] { return slot->state == SLOT_RELEASED; });
+    }
+    RecycleReleased(capture);
+  }
+}
+
+void FrameCaptureSubmit(FrameCapture *capture, RenderTexture2D target,
+                        double timeS) {
+  CPU_ZONE("FrameCaptureSubmit");
+  if (capture == NULL || target.id == 0) {
+    return;
+  }
+  const double startS = GetTime();
+
+  FrameCapturePoll(capture);
+  capture->submitted++;
+
+  CaptureSlot *slot = &capture->slots[capture->submitIdx];
+  if (slot->state != SLOT_FREE) {
+    if (!capture->lossless) {
+      capture->dropped++;
+      capture->submitMs = (float)((GetTime() - startS) * 1000.0);
+      return;
+    }
+    WaitForSlot(capture, slot);
+  }
+
+  const int width = target.texture.width;
+  const int height = target.texture.height;
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+  if (width != slot->width || height != slot->height) {
+    slot->width = width;
+    slot->height = height;
+    glBufferData(GL_PIXEL_PACK_BUFFER, SlotBytes(capture, slot), NULL,
+                 GL_STREAM_READ);
+  }
+
+  // Pending batched draws may still target this framebuffer
+  rlDrawRenderBatchActive();
+  GLint prevReadFbo = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, target.id);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  if (capture->format == FRAME_CAPTURE_R8) {
+    glReadPixels(0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, NULL);
+  } else if (capture->format == FRAME_CAPTURE_RGBA16F) {
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_HALF_FLOAT, NULL);
+  } else {
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+  }
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)prevReadFbo);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot->sequence = capture->submitted - 1;
+  slot->timeS = timeS;
+  slot->state = SLOT_PENDING;
+  capture->submitIdx = (capture->submitIdx + 1) % FRAME_CAPTURE_SLOTS;
+
+  capture->submitMs = (float)((GetTime() - startS) * 1000.0);
+}
+
+void FrameCaptureFlush(FrameCapture *capture) {
+  if (capture == NULL) {
+    return;
+  }
+  for (int i = 0; i < FRAME_CAPTURE_SLOTS; i++) {
+    WaitForSlot(capture, &capture->slots[i]);
+  }
+}
+
+void FrameCaptureUninit(FrameCapture *capture) {
+  if (capture == NULL) {
+    return;
+  }
+  FrameCaptureFlush(capture);
+
+  {
+    const std::lock_guard<std::mutex> lock(capture->mutex);
+    capture->stopping = true;
+  }
+  capture->wake.notify_one();
+  capture->consumer.join();
+
+  GLuint pbos[FRAME_CAPTURE_SLOTS];
+  for (int i = 0; i < FRAME_CAPTURE_SLOTS; i++) {
+    pbos[i] = capture->slots[i].pbo;
+  }
+  glDeleteBuffers(FRAME_CAPTURE_SLOTS, pbos);
+  delete capture;
+}
+
+FrameCaptureStats FrameCaptureGetStats(const FrameCapture *capture) {
+  FrameCaptureStats stats = {};
+  if (capture == NULL) {
+    return stats;
+  }
+  stats.submitted = capture->submitted;
+  stats.delivered = capture->delivered;
+  stats.dropped = capture->dropped;
+  stats.submitMs = capture->submitMs;
+  stats.sinkFailed = capture->sinkFailed;
+  return stats;
+}
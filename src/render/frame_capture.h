@@ -0,0 +1,69 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Asynchronous readback of the final render target. Each submit issues
+// glReadPixels into one of FRAME_CAPTURE_SLOTS pixel buffer objects and
+// fences it; later polls map signaled buffers and hand the mapped memory to a
+// consumer thread, so the render loop never blocks on the GPU or copies
+// pixels itself.
+
+#define FRAME_CAPTURE_SLOTS 3
+
+// Readback layout; the render target should already hold matching channels
+typedef enum FrameCaptureFormat {
+  FRAME_CAPTURE_RGBA8 = 0, // 4 bytes per pixel
+  FRAME_CAPTURE_RGBA16F,   // 8 bytes per pixel, half floats
+  FRAME_CAPTURE_R8,        // 1 byte per pixel, red channel only
+} FrameCaptureFormat;
+
+typedef struct FrameCaptureFrame {
+  const unsigned char *pixels; // Tightly packed rows, bottom row first
+  FrameCaptureFormat format;
+  int width;
+  int height;
+  int bytes;         // width * height * bytes per pixel
+  uint64_t sequence; // Submit index; gaps mean dropped frames
+  double timeS;      // Caller-supplied render time
+} FrameCaptureFrame;
+
+// Runs on the consumer thread. frame->pixels is valid only during the call.
+// Returning false marks the sink failed; later frames are still delivered.
+typedef bool (*FrameCaptureSinkFn)(const FrameCaptureFrame *frame,
+                                   void *userData);
+
+typedef struct FrameCaptureStats {
+  uint64_t submitted;
+  uint64_t delivered;
+  uint64_t dropped; // All slots busy at submit (never when lossless)
+  float submitMs;   // CPU cost of the last submit + poll
+  bool sinkFailed;
+} FrameCaptureStats;
+
+typedef struct FrameCapture FrameCapture;
+
+// Lossless captures wait for a free slot instead of dropping (offline
+// rendering); realtime captures drop. Returns NULL on failure.
+FrameCapture *FrameCaptureInit(FrameCaptureSinkFn sink, void *userData,
+                               FrameCaptureFormat format, bool lossless);
+
+// Deliver every pending frame, then stop the consumer thread
+void FrameCaptureUninit(FrameCapture *capture);
+
+// Queue readback of target's color attachment. Call after rendering, once
+// per frame; also retires finished readbacks.
+void FrameCaptureSubmit(FrameCapture *capture, RenderTexture2D target,
+                        double timeS);
+
+// Retire finished readbacks without submitting
+void FrameCapturePoll(FrameCapture *capture);
+
+// Block until every submitted frame has reached the sink
+void FrameCaptureFlush(FrameCapture *capture);
+
+FrameCaptureStats FrameCaptureGetStats(const FrameCapture *capture);
+
+#endif // FRAME_CAPTURE_H
@@ -0,0 +1,420 @@
+#include "headless.h"
+#include "alloc_tracker.h"
+#include "raylib.h"
+#include <filesystem>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace fs = std::filesystem;
+
+struct HeadlessWriter {
+  HeadlessFormat format;
+  int width;
+  int height;
+  FILE *stream; // Y4M and raw; NULL for png
+  bool ownsStream;
+  std::vector<unsigned char> rgba;   // Converted frame, top row first
+  std::vector<unsigned char> planes; // Y4M conversion scratch
+  fs::path dir;                      // png output directory
+  int frameIndex;
+};
+
+static void PrintUsage(void) {
+  // NOLINTNEXTLINE(cert-err33-c) - usage text is best-effort
+  fprintf(stderr,
+          "usage: AudioJones --headless --preset FILE --audio FILE\n"
+          "                  [--frames N] [--fps %d-%d] [--size WxH]\n"
+          "                  [--format png|y4m|raw] [--out DIR|FILE|-]\n"
+          "       AudioJones --headless --replay LOG.ajr [--timings FILE]\n"
+          "                  [--frames N] [--format ...] [--out ...]\n"
+          "       AudioJones [--headless ...] [--shm NAME] [--shm-size WxH]\n"
+          "                  [--shm-format rgba8|rgba16f|nv12]\n"
+          "       AudioJones --bench [--bench-frames N] [--bench-out FILE]\n"
+          "                  [--bench-sizes WxH,...]\n"
+          "       AudioJones --bench-compare BASE NEW [--bench-threshold X]\n"
+          "       AudioJones --alloc-check PRESET [--alloc-check-frames N]\n"
+          "                  [--size WxH]\n"
+          "       AudioJones [...] --cpu-sims\n",
+          HEADLESS_FPS_MIN, HEADLESS_FPS_MAX);
+}
+
+static bool ParseInt(const char *text, int lo, int hi, int *out) {
+  char *end = NULL;
+  const long value = strtol(text, &end, 10);
+  if (end == text || *end != '\0' || value < lo || value > hi) {
+    return false;
+  }
+  *out = (int)value;
+  return true;
+}
+
+static bool ParseSize(const char *text, int *width, int *height) {
+  const char *x = strchr(text, 'x');
+  if (x == NULL) {
+    return false;
+  }
+  char widthText[16];
+  const size_t len = (size_t)(x - text);
+  if (len == 0 || len >= sizeof(widthText)) {
+    return false;
+  }
+  memcpy(widthText, text, len);
+  widthText[len] = '\0';
+  // Even dimensions keep downstream 4:2:0 encoders happy
+  return ParseInt(widthText, 2, HEADLESS_SIZE_MAX, width) &&
+         ParseInt(x + 1, 2, HEADLESS_SIZE_MAX, height) && *width % 2 == 0 &&
+         *height % 2 == 0;
+}
+
+// Comma-separated WxH list, at most SHADER_BENCH_MAX_SIZES entries
+static bool ParseSizeList(const char *text, ShaderBenchOptions *bench) {
+  bench->sizeCount = 0;
+  while (*text != '\0') {
+    const char *comma = strchr(text, ',');
+    const size_t len = comma != NULL ? (size_t)(comma - text) : strlen(text);
+    char sizeText[32];
+    if (len == 0 || len >= sizeof(sizeText) ||
+        bench->sizeCount >= SHADER_BENCH_MAX_SIZES) {
+      return false;
+    }
+    memcpy(sizeText, text, len);
+    sizeText[len] = '\0';
+    const int i = bench->sizeCount++;
+    if (!ParseSize(sizeText, &bench->widths[i], &bench->heights[i])) {
+      return false;
+    }
+    text += len;
+    if (*text == ',') {
+      text++;
+    }
+  }
+  return bench->sizeCount > 0;
+}
+
+static bool ParseFloat(const char *text, float lo, float hi, float *out) {
+  char *end = NULL;
+  const float value = strtof(text, &end);
+  if (end == text || *end != '\0' || !(value >= lo && value <= hi)) {
+    return false;
+  }
+  *out = value;
+  return true;
+}
+
+static bool ParseFormat(const char *text, HeadlessFormat *format) {
+  if (strcmp(text, "png") == 0) {
+    *format = HEADLESS_FORMAT_PNG;
+  } else if (strcmp(text, "y4m") == 0) {
+    *format = HEADLESS_FORMAT_Y4M;
+  } else if (strcmp(text, "raw") == 0) {
+    *format = HEADLESS_FORMAT_RAW;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool ParseShmFormat(const char *text, ShmVideoFormat *format) {
+  if (strcmp(text, "rgba8") == 0) {
+    *format = SHM_VIDEO_RGBA8;
+  } else if (strcmp(text, "rgba16f") == 0) {
+    *format = SHM_VIDEO_RGBA16F;
+  } else if (strcmp(text, "nv12") == 0) {
+    *format = SHM_VIDEO_NV12;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Apply one "--name value" pair; false for unknown names or bad values
+static bool ParseOption(const char *name, const char *value,
+                        HeadlessOptions *opts) {
+  if (strcmp(name, "--preset") == 0) {
+    opts->presetPath = value;
+    return true;
+  }
+  if (strcmp(name, "--audio") == 0) {
+    opts->audioPath = value;
+    return true;
+  }
+  if (strcmp(name, "--out") == 0) {
+    opts->outPath = value;
+    return true;
+  }
+  if (strcmp(name, "--replay") == 0) {
+    opts->replayPath = value;
+    return true;
+  }
+  if (strcmp(name, "--timings") == 0) {
+    opts->timingsPath = value;
+    return true;
+  }
+  if (strcmp(name, "--frames") == 0) {
+    return ParseInt(value, 1, 0x7fffffff, &opts->frameCount);
+  }
+  if (strcmp(name, "--fps") == 0) {
+    return ParseInt(value, HEADLESS_FPS_MIN, HEADLESS_FPS_MAX, &opts->fps);
+  }
+  if (strcmp(name, "--size") == 0) {
+    return ParseSize(value, &opts->width, &opts->height);
+  }
+  if (strcmp(name, "--format") == 0) {
+    return ParseFormat(value, &opts->format);
+  }
+  if (strcmp(name, "--shm") == 0) {
+    opts->shm.name = value;
+    return true;
+  }
+  if (strcmp(name, "--shm-size") == 0) {
+    return ParseSize(value, &opts->shm.width, &opts->shm.height);
+  }
+  if (strcmp(name, "--shm-format") == 0) {
+    return ParseShmFormat(value, &opts->shm.format);
+  }
+  if (strcmp(name, "--bench-frames") == 0) {
+    return ParseInt(value, 1, SHADER_BENCH_MAX_FRAMES, &opts->bench.frames);
+  }
+  if (strcmp(name, "--bench-sizes") == 0) {
+    return ParseSizeList(value, &opts->bench);
+  }
+  if (strcmp(name, "--bench-out") == 0) {
+    opts->bench.outPath = value;
+    return true;
+  }
+  if (strcmp(name, "--bench-threshold") == 0) {
+    return ParseFloat(value, 1.0f, 100.0f, &opts->bench.threshold);
+  }
+  if (strcmp(name, "--alloc-check") == 0) {
+    opts->allocCheckPath = value;
+    return true;
+  }
+  if (strcmp(name, "--alloc-check-frames") == 0) {
+    return ParseInt(value, 1, 100000, &opts->allocCheckFrames);
+  }
+  return false;
+}
+
+bool HeadlessParseArgs(int argc, char **argv, HeadlessOptions *opts) {
+  *opts = HeadlessOptions{};
+  opts->format = HEADLESS_FORMAT_PNG;
+  opts->width = 1920;
+  opts->height = 1080;
+  opts->fps = 60;
+  opts->bench.outPath = "shader_bench.json";
+  opts->bench.frames = 30;
+  opts->bench.sizeCount = 2;
+  opts->bench.widths[0] = 1280;
+  opts->bench.heights[0] = 720;
+  opts->bench.widths[1] = 1920;
+  opts->bench.heights[1] = 1080;
+  opts->bench.threshold = 1.25f;
+  opts->allocCheckFrames = ALLOC_TRACKER_CHECK_FRAMES;
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (strcmp(arg, "--headless") == 0) {
+      opts->enabled = true;
+      continue;
+    }
+    if (strcmp(arg, "--bench") == 0) {
+      opts->bench.enabled = true;
+      continue;
+    }
+    if (strcmp(arg, "--cpu-sims") == 0) {
+      opts->cpuSims = true;
+      continue;
+    }
+    if (strcmp(arg, "--bench-compare") == 0) {
+      if (i + 2 >= argc) {
+        PrintUsage();
+        return false;
+      }
+      opts->bench.basePath = argv[i + 1];
+      opts->bench.comparePath = argv[i + 2];
+      i += 2;
+      continue;
+    }
+
+    // Every other option takes a value
+    const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+    if (value == NULL || !ParseOption(arg, value, opts)) {
+      // NOLINTNEXTLINE(cert-err33-c) - diagnostics are best-effort
+      fprintf(stderr, "HEADLESS: Invalid argument '%s'\n", arg);
+      PrintUsage();
+      return false;
+    }
+    i++;
+  }
+
+  if (!opts->enabled) {
+    return true;
+  }
+
+  const bool haveSource =
+      opts->replayPath != NULL ||
+      (opts->presetPath != NULL && opts->audioPath != NULL);
+  if (!haveSource) {
+    PrintUsage();
+    return false;
+  }
+  if (opts->outPath == NULL) {
+    opts->outPath = (opts->format == HEADLESS_FORMAT_PNG) ? "frames" : "-";
+  }
+  return true;
+}
+
+static void LogToStderr(int logLevel, const char *text, va_list args) {
+  const char *prefix = "INFO";
+  if (logLevel == LOG_TRACE) {
+    prefix = "TRACE";
+  } else if (logLevel == LOG_DEBUG) {
+    prefix = "DEBUG";
+  } else if (logLevel == LOG_WARNING) {
+    prefix = "WARNING";
+  } else if (logLevel == LOG_ERROR) {
+    prefix = "ERROR";
+  } else if (logLevel == LOG_FATAL) {
+    prefix = "FATAL";
+  }
+  // NOLINTBEGIN(cert-err33-c) - log output is best-effort
+  fprintf(stderr, "%s: ", prefix);
+  vfprintf(stderr, text, args);
+  fputc('\n', stderr);
+  // NOLINTEND(cert-err33-c)
+}
+
+void HeadlessRedirectLog(void) { SetTraceLogCallback(LogToStderr); }
+
+HeadlessWriter *HeadlessWriterOpen(const HeadlessOptions *opts) {
+  HeadlessWriter *writer = new HeadlessWriter{};
+  writer->format = opts->format;
+  writer->width = opts->width;
+  writer->height = opts->height;
+  writer->rgba.resize((size_t)opts->width * opts->height * 4);
+
+  if (opts->format == HEADLESS_FORMAT_PNG) {
+    writer->dir = fs::path(opts->outPath);
+    std::error_code ec;
+    fs::create_directories(writer->dir, ec);
+    if (ec) {
+      TraceLog(LOG_ERROR, "HEADLESS: Cannot create %s", opts->outPath);
+      delete writer;
+      return NULL;
+    }
+    return writer;
+  }
+
+  if (strcmp(opts->outPath, "-") == 0) {
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    writer->stream = stdout;
+  } else {
+    writer->stream = fopen(opts->outPath, "wb");
+    writer->ownsStream = true;
+  }
+  if (writer->stream == NULL) {
+    TraceLog(LOG_ERROR, "HEADLESS: Cannot open %s", opts->outPath);
+    delete writer;
+    return NULL;
+  }
+
+  if (opts->format == HEADLESS_FORMAT_Y4M) {
+    writer->planes.resize((size_t)opts->width * opts->height * 3);
+    if (fprintf(writer->stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n",
+                opts->width, opts->height, opts->fps) < 0) {
+      HeadlessWriterClose(writer);
+      return NULL;
+    }
+  }
+  return writer;
+}
+
+// BT.601 limited range, matching what encoders assume for untagged Y4M
+static void RgbaToYuv444(const unsigned char *rgba, size_t pixelCount,
+                         unsigned char *planes) {
+  unsigned char *yPlane = planes;
+  unsigned char *uPlane = planes + pixelCount;
+  unsigned char *vPlane = planes + 2 * pixelCount;
+  for (size_t i = 0; i < pixelCount; i++) {
+    const int r = rgba[i * 4 + 0];
+    const int g = rgba[i * 4 + 1];
+    const int b = rgba[i * 4 + 2];
+    yPlane[i] = (unsigned char)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+    uPlane[i] =
+        (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    vPlane[i] =
+        (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+  }
+}
+
+// GL readback is bottom-up; flip to top-down. Alpha is forced opaque since
+// feedback passes leave arbitrary values there.
+static void ConvertFrame(const unsigned char *src, int width, int height,
+                         unsigned char *dst) {
+  const size_t rowBytes = (size_t)width * 4;
+  for (int y = 0; y < height; y++) {
+    const unsigned char *row = src + (size_t)(height - 1 - y) * rowBytes;
+    unsigned char *out = dst + (size_t)y * rowBytes;
+    memcpy(out, row, rowBytes);
+    for (int x = 0; x < width; x++) {
+      out[x * 4 + 3] = 255;
+    }
+  }
+}
+
+bool HeadlessWriterWrite(HeadlessWriter *writer, const unsigned char *rgba,
+                         int width, int height) {
+  if (writer == NULL || rgba == NULL || width != writer->width ||
+      height != writer->height) {
+    return false;
+  }
+  ConvertFrame(rgba, width, height, writer->rgba.data());
+
+  unsigned char *frame = writer->rgba.data();
+  const size_t pixelCount = (size_t)writer->width * writer->height;
+  const int index = writer->frameIndex++;
+
+  if (writer->format == HEADLESS_FORMAT_PNG) {
+    char name[32];
+    // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size name buffer
+    snprintf(name, sizeof(name), "frame_%06d.png", index);
+    const Image image = {frame, writer->width, writer->height, 1,
+                         PIXELFORMAT_UNCOMPRESSED_R8G8B8A8};
+    return ExportImage(image, (writer->dir / name).string().c_str());
+  }
+
+  if (writer->format == HEADLESS_FORMAT_Y4M) {
+    RgbaToYuv444(frame, pixelCount, writer->planes.data());
+    if (fputs("FRAME\n", writer->stream) < 0) {
+      return false;
+    }
+    return fwrite(writer->planes.data(), 1, writer->planes.size(),
+                  writer->stream) == writer->planes.size();
+  }
+
+  return fwrite(frame, 4, pixelCount, writer->stream) == pixelCount;
+}
+
+void HeadlessWriterClose(HeadlessWriter *writer) {
+  if (writer == NULL) {
+    return;
+  }
+  if (writer->stream != NULL) {
+    // NOLINTNEXTLINE(cert-err33-c) - nothing to recover at shutdown
+    fflush(writer->stream);
+    if (writer->ownsStream) {
+      // NOLINTNEXTLINE(cert-err33-c) - nothing to recover at shutdown
+      fclose(writer->stream);
+    }
+  }
+  delete writer;
+}
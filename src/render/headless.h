@@ -0,0 +1,78 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include "shader_bench.h"
+#include "shm_output.h"
+#include <stdbool.h>
+
+// Offline rendering: a hidden window renders a preset against an audio file at
+// a fixed timestep and writes every frame out. Frame time comes from the audio
+// clock (sample count / fps), so output is independent of how fast the GPU is.
+//
+//   AudioJones --headless --preset P.json --audio song.wav [--frames N]
+//              [--fps 60] [--size 1920x1080] [--format png|y4m|raw]
+//              [--out DIR|-]
+//   AudioJones --headless --replay LOG.ajr [--timings FILE.csv] [...]
+//
+// --replay renders a log recorded with F10 instead of a preset and audio file,
+// at the recorded internal resolution. --timings writes per-frame CPU and GPU
+// zone times as CSV so two builds can be compared on identical input.
+//
+// The shared-memory output options also apply to interactive runs:
+//   [--shm NAME] [--shm-size WxH] [--shm-format rgba8|rgba16f|nv12]
+//
+// --cpu-sims runs the simulations on the CPU backend (simulation/sim_cpu.h)
+// even when compute shaders are available, in any mode.
+//
+// The shader cost suite options (--bench*) are documented in shader_bench.h,
+// the allocation check (--alloc-check*) in alloc_tracker.h.
+
+#define HEADLESS_FPS_MIN 16 // One frame of audio must fit one analysis update
+#define HEADLESS_FPS_MAX 240
+#define HEADLESS_SIZE_MAX 8192
+
+typedef enum HeadlessFormat {
+  HEADLESS_FORMAT_PNG = 0, // DIR/frame_000000.png sequence
+  HEADLESS_FORMAT_Y4M,     // YUV4MPEG2 4:4:4 stream
+  HEADLESS_FORMAT_RAW,     // Bare RGBA8 frames, top row first
+} HeadlessFormat;
+
+typedef struct HeadlessOptions {
+  bool enabled; // --headless was given
+  const char *presetPath;
+  const char *audioPath;
+  const char *outPath; // Directory for png, file or "-" (stdout) for streams
+  const char *replayPath;  // Replay log; replaces presetPath and audioPath
+  const char *timingsPath; // Optional per-frame timing CSV
+  HeadlessFormat format;
+  int width;
+  int height;
+  int fps;
+  int frameCount; // 0 renders until the audio file ends
+  ShmOutputConfig shm;
+  ShaderBenchOptions bench;
+  const char *allocCheckPath; // --alloc-check preset; NULL when not checking
+  int allocCheckFrames;
+  bool cpuSims; // --cpu-sims was given
+} HeadlessOptions;
+
+// Parse command-line arguments. Returns false and prints usage to stderr on
+// malformed input; opts->enabled reports whether headless mode was requested.
+bool HeadlessParseArgs(int argc, char **argv, HeadlessOptions *opts);
+
+// Route raylib logging to stderr so stdout stays clean for frame streams
+void HeadlessRedirectLog(void);
+
+typedef struct HeadlessWriter HeadlessWriter;
+
+// Open the frame sink described by opts. Returns NULL on failure.
+HeadlessWriter *HeadlessWriterOpen(const HeadlessOptions *opts);
+
+// Write one RGBA8 frame of the opened size, bottom row first as delivered by
+// FrameCapture. Safe to call from the capture consumer thread.
+bool HeadlessWriterWrite(HeadlessWriter *writer, const unsigned char *rgba,
+                         int width, int height);
+
+void HeadlessWriterClose(HeadlessWriter *writer);
+
+#endif // HEADLESS_H
@@ -4,6 +4,8 @@
 #include "config/effect_descriptor.h"
 #include "effects/attractor_lines.h"
 #include "effects/curl_advection.h"
+#include "effects/lichen.h"
+#include "flight_recorder.h"
 #include "noise_texture.h"
 #include "render_utils.h"
 #include "rlgl.h"
@@ -13,12 +15,18 @@
 #include "simulation/maze_worms.h"
 #include "simulation/particle_life.h"
 #include "simulation/physarum.h"
+#include <stdio.h>
 #include <stdlib.h>
 
 static const char *LOG_PREFIX = "POST_EFFECT";
 
 static const int WAVEFORM_TEXTURE_SIZE = 2048;
 
+// Mirror of the live pipeline size for effect setup functions, which only
+// receive their own effect state
+static int g_renderWidth = 0;
+static int g_renderHeight = 0;
+
 static void InitFFTTexture(Texture2D *tex) {
   tex->id =
       rlLoadTexture(NULL, FFT_BIN_COUNT, 1, RL_PIXELFORMAT_UNCOMPRESSED_R32, 1);
@@ -51,11 +59,15 @@ static bool LoadPostEffectShaders(PostEffect *pe) {
   pe->clarityShader = LoadShader(0, "shaders/clarity.fs");
   pe->gammaShader = LoadShader(0, "shaders/gamma.fs");
   pe->shapeTextureShader = LoadShader(0, "shaders/shape_texture.fs");
+  pe->upsampleShader = LoadShader(0, "shaders/upsample_edge_aware.fs");
+  pe->interleaveResolveShader =
+      LoadShader(0, "shaders/interleave_resolve.fs");
 
   return pe->feedbackShader.id != 0 && pe->blurHShader.id != 0 &&
          pe->blurVShader.id != 0 && pe->fxaaShader.id != 0 &&
          pe->clarityShader.id != 0 && pe->gammaShader.id != 0 &&
-         pe->shapeTextureShader.id != 0;
+         pe->shapeTextureShader.id != 0 && pe->upsampleShader.id != 0 &&
+         pe->interleaveResolveShader.id != 0;
 }
 
 // NOLINTNEXTLINE(readability-function-size) - caches all shader uniform
@@ -118,6 +130,17 @@ static void GetShaderUniformLocations(PostEffect *pe) {
   pe->shapeTexAngleLoc = GetShaderLocation(pe->shapeTextureShader, "texAngle");
   pe->shapeTexBrightnessLoc =
       GetShaderLocation(pe->shapeTextureShader, "texBrightness");
+  pe->upsampleGuideLowLoc = GetShaderLocation(pe->upsampleShader, "guideLow");
+  pe->upsampleGuideHighLoc =
+      GetShaderLocation(pe->upsampleShader, "guideHigh");
+  pe->upsampleLowResolutionLoc =
+      GetShaderLocation(pe->upsampleShader, "lowResolution");
+  pe->upsampleRangeSigmaLoc =
+      GetShaderLocation(pe->upsampleShader, "rangeSigma");
+  pe->interleaveResolveCountLoc =
+      GetShaderLocation(pe->interleaveResolveShader, "interleaveCount");
+  pe->interleaveResolvePhaseLoc =
+      GetShaderLocation(pe->interleaveResolveShader, "interleavePhase");
 }
 
 static void SetResolutionUniforms(const PostEffect *pe, int width, int height) {
@@ -134,6 +157,31 @@ static void SetResolutionUniforms(const PostEffect *pe, int width, int height) {
                  SHADER_UNIFORM_VEC2);
 }
 
+static int ScaledDimension(int windowDim, float scale) {
+  const int dim = (int)((float)windowDim * scale + 0.5f);
+  return dim < 1 ? 1 : dim;
+}
+
+static void UnloadTierTargets(PostEffect *pe) {
+  for (int t = 0; t < RES_TIER_COUNT; t++) {
+    for (int i = 0; i < 2; i++) {
+      if (pe->tierTargets[t][i].id != 0) {
+        UnloadRenderTexture(pe->tierTargets[t][i]);
+        pe->tierTargets[t][i] = RenderTexture2D{};
+      }
+    }
+  }
+}
+
+static void UnloadInterleaveHistory(PostEffect *pe) {
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if (pe->interleaveHistory[i].id != 0) {
+      UnloadRenderTexture(pe->interleaveHistory[i]);
+      pe->interleaveHistory[i] = RenderTexture2D{};
+    }
+  }
+}
+
 PostEffect *PostEffectInit(int screenWidth, int screenHeight,
                            PostEffectProgressFn onProgress, void *userData) {
   PostEffect *pe = static_cast<PostEffect *>(calloc(1, sizeof(PostEffect)));
@@ -143,6 +191,14 @@ PostEffect *PostEffectInit(int screenWidth, int screenHeight,
 
   pe->screenWidth = screenWidth;
   pe->screenHeight = screenHeight;
+  pe->windowWidth = screenWidth;
+  pe->windowHeight = screenHeight;
+  pe->renderScale = 1.0f;
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    pe->qualityLevel[i] = 1.0f;
+  }
+  g_renderWidth = screenWidth;
+  g_renderHeight = screenHeight;
   pe->effects = EffectConfig{};
 
   for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
@@ -213,13 +269,6 @@ PostEffect *PostEffectInit(int screenWidth, int screenHeight,
   TraceLog(LOG_INFO, "POST_EFFECT: Waveform texture created (%dx%d)",
            pe->waveformTexture.width, pe->waveformTexture.height);
 
-  RenderUtilsInitTextureHDR(&pe->halfResA, screenWidth / 2, screenHeight / 2,
-                            LOG_PREFIX);
-  RenderUtilsInitTextureHDR(&pe->halfResB, screenWidth / 2, screenHeight / 2,
-                            LOG_PREFIX);
-  TraceLog(LOG_INFO, "POST_EFFECT: Half-res textures allocated (%dx%d)",
-           pe->halfResA.texture.width, pe->halfResA.texture.height);
-
   if (onProgress != NULL) {
     onProgress(0.75f, userData);
   }
@@ -277,25 +326,49 @@ void PostEffectUninit(PostEffect *pe) {
   UnloadShader(pe->clarityShader);
   UnloadShader(pe->gammaShader);
   UnloadShader(pe->shapeTextureShader);
+  UnloadShader(pe->upsampleShader);
+  UnloadShader(pe->interleaveResolveShader);
   UnloadRenderTexture(pe->generatorScratch);
-  UnloadRenderTexture(pe->halfResA);
-  UnloadRenderTexture(pe->halfResB);
+  UnloadTierTargets(pe);
+  UnloadInterleaveHistory(pe);
   free(pe);
 }
 
-void PostEffectResize(PostEffect *pe, int width, int height) {
-  if (pe == NULL || (width == pe->screenWidth && height == pe->screenHeight)) {
-    return;
+// Swap in a new accumTexture holding a resampled copy of the old one so
+// feedback history survives resolution changes
+static void ResampleAccumTexture(PostEffect *pe, int width, int height) {
+  const RenderTexture2D old = pe->accumTexture;
+  RenderUtilsInitTextureHDR(&pe->accumTexture, width, height, LOG_PREFIX);
+  RenderUtilsResampleTexture(&old, &pe->accumTexture);
+  UnloadRenderTexture(old);
+}
+
+// Same for every allocated interleave history so skipped frames keep
+// blending against the last real output
+static void ResampleInterleaveHistory(PostEffect *pe, int width, int height) {
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if (pe->interleaveHistory[i].id == 0) {
+      continue;
+    }
+    const RenderTexture2D old = pe->interleaveHistory[i];
+    RenderUtilsInitTextureHDR(&pe->interleaveHistory[i], width, height,
+                              LOG_PREFIX);
+    RenderUtilsResampleTexture(&old, &pe->interleaveHistory[i]);
+    UnloadRenderTexture(old);
   }
+}
 
+// Reallocate every target that runs at internal render resolution
+static void ResizeRenderTargets(PostEffect *pe, int width, int height) {
   pe->screenWidth = width;
   pe->screenHeight = height;
+  g_renderWidth = width;
+  g_renderHeight = height;
 
-  UnloadRenderTexture(pe->accumTexture);
+  ResampleAccumTexture(pe, width, height);
   UnloadRenderTexture(pe->pingPong[0]);
   UnloadRenderTexture(pe->pingPong[1]);
   UnloadRenderTexture(pe->outputTexture);
-  RenderUtilsInitTextureHDR(&pe->accumTexture, width, height, LOG_PREFIX);
   RenderUtilsInitTextureHDR(&pe->pingPong[0], width, height, LOG_PREFIX);
   RenderUtilsInitTextureHDR(&pe->pingPong[1], width, height, LOG_PREFIX);
   RenderUtilsInitTextureHDR(&pe->outputTexture, width, height, LOG_PREFIX);
@@ -308,14 +381,30 @@ void PostEffectResize(PostEffect *pe, int width, int height) {
     }
   }
 
-  UnloadRenderTexture(pe->halfResA);
-  UnloadRenderTexture(pe->halfResB);
-  RenderUtilsInitTextureHDR(&pe->halfResA, width / 2, height / 2, LOG_PREFIX);
-  RenderUtilsInitTextureHDR(&pe->halfResB, width / 2, height / 2, LOG_PREFIX);
+  UnloadTierTargets(pe);
+  ResampleInterleaveHistory(pe, width, height);
 
   UnloadRenderTexture(pe->generatorScratch);
   RenderUtilsInitTextureHDR(&pe->generatorScratch, width, height, LOG_PREFIX);
+}
+
+void PostEffectResize(PostEffect *pe, int width, int height) {
+  if (pe == NULL ||
+      (width == pe->windowWidth && height == pe->windowHeight)) {
+    return;
+  }
+
+  pe->windowWidth = width;
+  pe->windowHeight = height;
+
+  const int renderW = ScaledDimension(width, pe->renderScale);
+  const int renderH = ScaledDimension(height, pe->renderScale);
+  if (renderW != pe->screenWidth || renderH != pe->screenHeight) {
+    ResizeRenderTargets(pe, renderW, renderH);
+  }
 
+  // Simulations stay at window resolution; their trail maps are sampled by
+  // UV so they composite correctly at any render scale
   PhysarumResize(pe->physarum, width, height);
   CurlFlowResize(pe->curlFlow, width, height);
   AttractorFlowResize(pe->attractorFlow, width, height);
@@ -324,11 +413,76 @@ void PostEffectResize(PostEffect *pe, int width, int height) {
   MazeWormsResize(pe->mazeWorms, width, height);
 }
 
-void PostEffectClearFeedback(PostEffect *pe) {
-  if (pe == NULL) {
+void PostEffectSetRenderScale(PostEffect *pe, float scale) {
+  if (pe == NULL || scale == pe->renderScale) {
     return;
   }
 
+  pe->renderScale = scale;
+  const int renderW = ScaledDimension(pe->windowWidth, scale);
+  const int renderH = ScaledDimension(pe->windowHeight, scale);
+  if (renderW != pe->screenWidth || renderH != pe->screenHeight) {
+    ResizeRenderTargets(pe, renderW, renderH);
+    TraceLog(LOG_INFO, "%s: Render scale %.2f (%dx%d)", LOG_PREFIX, scale,
+             renderW, renderH);
+    char note[FLIGHT_EVENT_TEXT_MAX];
+    // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size event buffer
+    snprintf(note, sizeof(note), "render scale %.2f (%dx%d)", scale, renderW,
+             renderH);
+    FlightRecorderNote(FLIGHT_EVENT_REINIT, note);
+  }
+}
+
+int PostEffectRenderWidth(void) { return g_renderWidth; }
+
+int PostEffectRenderHeight(void) { return g_renderHeight; }
+
+RenderTexture2D *PostEffectGetTierTargets(PostEffect *pe,
+                                          EffectResolutionTier tier) {
+  RenderTexture2D *pair = pe->tierTargets[tier];
+  if (pair[0].id == 0) {
+    const float scale = EffectResolutionTierScale(tier);
+    int w = ScaledDimension(pe->screenWidth, scale);
+    int h = ScaledDimension(pe->screenHeight, scale);
+    // Half keeps the truncated size of the targets it replaced, so default
+    // half-res effects and Oil Paint render exactly as before tiers
+    if (tier == RES_TIER_HALF) {
+      w = pe->screenWidth / 2 > 0 ? pe->screenWidth / 2 : 1;
+      h = pe->screenHeight / 2 > 0 ? pe->screenHeight / 2 : 1;
+    }
+    RenderUtilsInitTextureHDR(&pair[0], w, h, LOG_PREFIX);
+    RenderUtilsInitTextureHDR(&pair[1], w, h, LOG_PREFIX);
+    TraceLog(LOG_INFO, "%s: Tier %d targets allocated (%dx%d)", LOG_PREFIX,
+             (int)tier, w, h);
+  }
+  return pair;
+}
+
+RenderTexture2D *PostEffectGetInterleaveHistory(PostEffect *pe,
+                                                TransformEffectType type) {
+  RenderTexture2D *history = &pe->interleaveHistory[type];
+  if (history->id == 0) {
+    RenderUtilsInitTextureHDR(history, pe->screenWidth, pe->screenHeight,
+                              LOG_PREFIX);
+  }
+  return history;
+}
+
+void PostEffectBeginScaledPass(int width, int height) {
+  g_renderWidth = width;
+  g_renderHeight = height;
+}
+
+void PostEffectEndScaledPass(const PostEffect *pe) {
+  g_renderWidth = pe->screenWidth;
+  g_renderHeight = pe->screenHeight;
+}
+
+// Clear feedback and re-spawn simulations. Disabled ones are skipped unless
+// all is set, to avoid expensive GPU uploads for effects not in use.
+static void ClearFeedback(PostEffect *pe, bool all) {
+  pe->feedbackClears++;
+
   // Clear accumulation and ping-pong buffers to black
   BeginTextureMode(pe->accumTexture);
   ClearBackground(BLACK);
@@ -352,35 +506,49 @@ void PostEffectClearFeedback(PostEffect *pe) {
   EndTextureMode();
   al->readIdx = 0;
 
-  // Reset only enabled simulations to avoid expensive GPU uploads for disabled
-  // effects
-  if (pe->effects.physarum.enabled) {
+  if (all || pe->effects.physarum.enabled) {
     PhysarumReset(pe->physarum);
   }
-  if (pe->effects.curlFlow.enabled) {
+  if (all || pe->effects.curlFlow.enabled) {
     CurlFlowReset(pe->curlFlow);
   }
   // Clear curl advection state and re-seed with noise
   CurlAdvectionEffect *ca = GetCurlAdvectionEffect(pe);
   if (ca->statePingPong[0].id > 0) {
-    CurlAdvectionEffectReset(ca, GetScreenWidth(), GetScreenHeight());
+    CurlAdvectionEffectReset(ca, pe->screenWidth, pe->screenHeight);
   }
-  if (pe->effects.attractorFlow.enabled) {
+  if (all || pe->effects.attractorFlow.enabled) {
     AttractorFlowReset(pe->attractorFlow);
   }
-  if (pe->particleLife != NULL && pe->effects.particleLife.enabled) {
+  if (pe->particleLife != NULL && (all || pe->effects.particleLife.enabled)) {
     ParticleLifeReset(pe->particleLife);
   }
-  if (pe->boids != NULL && pe->effects.boids.enabled) {
+  if (pe->boids != NULL && (all || pe->effects.boids.enabled)) {
     BoidsReset(pe->boids);
   }
-  if (pe->mazeWorms != NULL && pe->effects.mazeWorms.enabled) {
+  if (pe->mazeWorms != NULL && (all || pe->effects.mazeWorms.enabled)) {
     MazeWormsReset(pe->mazeWorms);
   }
   TraceLog(LOG_INFO, "%s: Cleared feedback buffers and reset simulations",
            LOG_PREFIX);
 }
 
+void PostEffectClearFeedback(PostEffect *pe) {
+  if (pe == NULL) {
+    return;
+  }
+  ClearFeedback(pe, false);
+}
+
+void PostEffectReseed(PostEffect *pe) {
+  if (pe == NULL) {
+    return;
+  }
+  ClearFeedback(pe, true);
+  // Lichen draws its seed pattern's noise offset from rand() at init
+  LichenEffectReset(GetLichenEffect(pe), pe->screenWidth, pe->screenHeight);
+}
+
 void PostEffectBeginDrawStage(const PostEffect *pe) {
   BeginTextureMode(pe->accumTexture);
 }
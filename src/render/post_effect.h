@@ -3,8 +3,12 @@
 
 #include "config/effect_config.h"
 #include "raylib.h"
+#include "simulation/sim_clock.h"
 #include <stdint.h>
 
+// Simulation passes driven by RenderPipelineExecute, one SimClock each
+#define POST_EFFECT_SIMULATION_COUNT 6
+
 typedef struct Physarum Physarum;
 typedef struct CurlFlow CurlFlow;
 typedef struct AttractorFlow AttractorFlow;
@@ -13,6 +17,7 @@ typedef struct Boids Boids;
 typedef struct MazeWorms MazeWorms;
 typedef struct BlendCompositor BlendCompositor;
 typedef struct ColorLUT ColorLUT;
+typedef struct ShmOutput ShmOutput;
 
 // Progress callback type - called between init phases
 // progress: 0.0 to 1.0
@@ -30,8 +35,13 @@ typedef struct PostEffect {
   Shader clarityShader;
   Shader gammaShader;
   Shader shapeTextureShader;
-  RenderTexture2D halfResA;
-  RenderTexture2D halfResB;
+  Shader upsampleShader; // Edge-aware upsample for reduced-tier passes
+  // Reduced-resolution scratch pairs per tier, allocated on first use
+  RenderTexture2D tierTargets[RES_TIER_COUNT][2];
+  Shader interleaveResolveShader; // Fills stale interleaved pixels
+  // Per-generator interleave history, allocated on first use
+  RenderTexture2D interleaveHistory[TRANSFORM_EFFECT_COUNT];
+  unsigned int interleaveFrame; // Advances the interleave slot each frame
   int shapeTexZoomLoc;
   int shapeTexAngleLoc;
   int shapeTexBrightnessLoc;
@@ -74,15 +84,27 @@ typedef struct PostEffect {
   int clarityResolutionLoc;
   int clarityAmountLoc;
   int gammaGammaLoc;
+  int upsampleGuideLowLoc;
+  int upsampleGuideHighLoc;
+  int upsampleLowResolutionLoc;
+  int upsampleRangeSigmaLoc;
+  int interleaveResolveCountLoc;
+  int interleaveResolvePhaseLoc;
   EffectConfig effects;
-  int screenWidth;
+  int screenWidth;  // Internal render resolution (window * renderScale)
   int screenHeight;
+  int windowWidth; // Output size; simulations run at this resolution
+  int windowHeight;
+  float renderScale;
+  // Per-effect quality LOD (0-1) applied to descriptor quality params
+  float qualityLevel[TRANSFORM_EFFECT_COUNT];
   Physarum *physarum;
   CurlFlow *curlFlow;
   AttractorFlow *attractorFlow;
   ParticleLife *particleLife;
   Boids *boids;
   MazeWorms *mazeWorms;
+  SimClock simClocks[POST_EFFECT_SIMULATION_COUNT]; // Pass order
   void *effectStates[TRANSFORM_EFFECT_COUNT];
   BlendCompositor *blendCompositor;
   RenderTexture2D
@@ -100,6 +122,10 @@ typedef struct PostEffect {
   Texture2D currentSceneTexture;
   RenderTexture2D
       *currentRenderDest; // Pipeline output for custom render effects
+  const RenderTexture2D
+      *presented; // Final internal-res frame drawn to the window this frame
+  ShmOutput *shmOutput;    // Optional shared-memory sink, owned by the caller
+  uint32_t feedbackClears; // PostEffectClearFeedback calls, for replay logs
 } PostEffect;
 
 // Initialize post-effect processor with screen dimensions
@@ -114,6 +140,30 @@ void PostEffectUninit(PostEffect *pe);
 // Resize render textures (call when window resizes)
 void PostEffectResize(PostEffect *pe, int width, int height);
 
+// Change internal render resolution as a fraction of the window. Feedback
+// history is resampled into the new targets rather than cleared.
+void PostEffectSetRenderScale(PostEffect *pe, float scale);
+
+// Internal render resolution of the active pipeline. Effects size their
+// resolution uniforms from this rather than the window.
+int PostEffectRenderWidth(void);
+int PostEffectRenderHeight(void);
+
+// Scratch pair for a reduced resolution tier, sized from the internal render
+// resolution. Allocated lazily and released on resize.
+RenderTexture2D *PostEffectGetTierTargets(PostEffect *pe,
+                                          EffectResolutionTier tier);
+
+// Report a reduced pass size through PostEffectRenderWidth/Height so effect
+// setup functions emit matching resolution uniforms
+void PostEffectBeginScaledPass(int width, int height);
+void PostEffectEndScaledPass(const PostEffect *pe);
+
+// Persistent history target for an interleaved generator at internal render
+// resolution. Allocated lazily and released on resize.
+RenderTexture2D *PostEffectGetInterleaveHistory(PostEffect *pe,
+                                                TransformEffectType type);
+
 // Register per-effect params with the modulation engine
 // Called after ParamRegistryInit; individual effects add their params here
 void PostEffectRegisterParams(PostEffect *pe);
@@ -121,6 +171,11 @@ void PostEffectRegisterParams(PostEffect *pe);
 // Clear feedback buffers and reset simulations (call when switching presets)
 void PostEffectClearFeedback(PostEffect *pe);
 
+// Clear feedback and re-spawn every simulation and seeded effect, enabled or
+// not, from the current RNG state. Replay calls this right after seeding, so
+// a simulation enabled mid-log starts from the same agents on every run.
+void PostEffectReseed(PostEffect *pe);
+
 // Begin drawing waveforms to accumulation texture
 void PostEffectBeginDrawStage(const PostEffect *pe);
 
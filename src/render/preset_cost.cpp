@@ -0,0 +1,314 @@
+#include "preset_cost.h"
+#include "config/effect_descriptor.h"
+#include <fstream>
+#include <map>
+#include <math.h>
+#include <nlohmann/json.hpp>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+// Nominal costs at 1920x1080 for uncalibrated models: rough desktop-GPU
+// figures, good enough to rank presets against each other
+static const int NOMINAL_REF_WIDTH = 1920;
+static const int NOMINAL_REF_HEIGHT = 1080;
+static const float NOMINAL_BASELINE_MS = 0.6f;
+static const float NOMINAL_SIM_MS = 1.2f;
+static const float NOMINAL_GENERATOR_MS = 0.5f;
+static const float NOMINAL_TRANSFORM_MS = 0.15f;
+
+// Agent counts drive simulation cost. Scaled linearly; the neighbor-search
+// sims grow somewhat faster at high density.
+struct AgentKnob {
+  TransformEffectType type;
+  size_t offset; // int within EffectConfig
+};
+
+static const AgentKnob AGENT_KNOBS[] = {
+    {TRANSFORM_PHYSARUM, offsetof(EffectConfig, physarum.agentCount)},
+    {TRANSFORM_CURL_FLOW, offsetof(EffectConfig, curlFlow.agentCount)},
+    {TRANSFORM_ATTRACTOR_FLOW,
+     offsetof(EffectConfig, attractorFlow.agentCount)},
+    {TRANSFORM_BOIDS, offsetof(EffectConfig, boids.agentCount)},
+    {TRANSFORM_PARTICLE_LIFE, offsetof(EffectConfig, particleLife.agentCount)},
+    {TRANSFORM_MAZE_WORMS, offsetof(EffectConfig, mazeWorms.wormCount)},
+};
+
+struct EffectCost {
+  float fixedMs; // Independent of pixel count
+  float pixelMs; // At full tier and the reference resolution
+};
+
+// One bench measurement at the reference resolution
+struct CostSample {
+  float area; // Tier scale squared
+  float ms;   // Summed GPU scopes of the effect's passes
+};
+
+struct PresetCostModel {
+  bool calibrated;
+  int refWidth;
+  int refHeight;
+  float baselineMs;
+  EffectCost effects[TRANSFORM_EFFECT_COUNT];
+  EffectConfig defaults; // Knob values the costs were measured at
+};
+
+static int ConfigInt(const EffectConfig *cfg, size_t offset) {
+  return *reinterpret_cast<const int *>(reinterpret_cast<const char *>(cfg) +
+                                        offset);
+}
+
+static EffectCost NominalCost(TransformEffectType type) {
+  const uint8_t flags = EFFECT_DESCRIPTORS[type].flags;
+  if ((flags & EFFECT_FLAG_SIM_BOOST) != 0) {
+    return EffectCost{NOMINAL_SIM_MS, 0.0f};
+  }
+  if ((flags & EFFECT_FLAG_BLEND) != 0) {
+    return EffectCost{0.0f, NOMINAL_GENERATOR_MS};
+  }
+  return EffectCost{0.0f, NOMINAL_TRANSFORM_MS};
+}
+
+// Two tiers separate fixed from per-pixel cost; one sample, or a pair too
+// noisy to split, is treated as all per-pixel
+static EffectCost FitCost(TransformEffectType type,
+                          const std::vector<CostSample> &samples) {
+  if ((EFFECT_DESCRIPTORS[type].flags & EFFECT_FLAG_SIM_BOOST) != 0) {
+    return EffectCost{samples[0].ms, 0.0f};
+  }
+  if (samples.size() >= 2) {
+    const CostSample &a = samples[0];
+    const CostSample &b = samples[1];
+    if (fabsf(a.area - b.area) > 0.01f) {
+      const float pixelMs = (a.ms - b.ms) / (a.area - b.area);
+      const float fixedMs = a.ms - pixelMs * a.area;
+      if (pixelMs >= 0.0f && fixedMs >= 0.0f) {
+        return EffectCost{fixedMs, pixelMs};
+      }
+    }
+  }
+  const CostSample &s = samples[0];
+  return EffectCost{0.0f, s.area > 0.0f ? s.ms / s.area : s.ms};
+}
+
+// Replace the nominal costs with the report's measurements at its largest
+// size. Effect rows time only the effect's own passes, so they are used as
+// measured. Effects the report lacks keep their nominal cost, and a report
+// without a timed baseline row keeps the nominal baseline.
+static bool LoadReport(PresetCostModel *model, const json &j) {
+  std::map<std::string, TransformEffectType> byName;
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if (EFFECT_DESCRIPTORS[i].name != NULL) {
+      byName[EFFECT_DESCRIPTORS[i].name] = (TransformEffectType)i;
+    }
+  }
+
+  // Effect and baseline rows only: spatial hash rows report grid sizes
+  const json &results = j.at("results");
+  int refW = 0;
+  int refH = 0;
+  for (const json &r : results) {
+    if (r.at("variant").get<std::string>() != "baseline" &&
+        byName.count(r.at("effect").get<std::string>()) == 0) {
+      continue;
+    }
+    const int w = r.at("width").get<int>();
+    const int h = r.at("height").get<int>();
+    if (w * h > refW * refH) {
+      refW = w;
+      refH = h;
+    }
+  }
+  if (refW <= 0 || refH <= 0) {
+    return false;
+  }
+
+  float baselineMs = -1.0f;
+  std::vector<CostSample> samples[TRANSFORM_EFFECT_COUNT];
+  for (const json &r : results) {
+    if (r.at("width").get<int>() != refW ||
+        r.at("height").get<int>() != refH || r.value("samples", 0) <= 0) {
+      continue;
+    }
+    const std::string variant = r.at("variant").get<std::string>();
+    const float ms = r.at("gpuMs").get<float>();
+    if (variant == "baseline") {
+      baselineMs = ms;
+      continue;
+    }
+    const auto it = byName.find(r.at("effect").get<std::string>());
+    if (it == byName.end()) {
+      continue;
+    }
+    const TransformEffectType type = it->second;
+
+    // "fragment" measures a path the saved configs rarely take
+    EffectResolutionTier tier;
+    if (variant == "default") {
+      tier = EffectDescriptorResolutionTier(&model->defaults, type);
+    } else if (variant == "full") {
+      tier = RES_TIER_FULL;
+    } else if (variant == "half") {
+      tier = RES_TIER_HALF;
+    } else {
+      continue;
+    }
+    const float scale = EffectResolutionTierScale(tier);
+    samples[type].push_back(CostSample{scale * scale, ms});
+  }
+
+  bool measured = baselineMs >= 0.0f;
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if (!samples[i].empty()) {
+      model->effects[i] = FitCost((TransformEffectType)i, samples[i]);
+      measured = true;
+    }
+  }
+  if (!measured) {
+    return false;
+  }
+
+  // The nominal baseline is at 1920x1080; keep it per pixel at the new size
+  if (baselineMs < 0.0f) {
+    baselineMs = model->baselineMs * (float)refW * (float)refH /
+                 ((float)model->refWidth * (float)model->refHeight);
+  }
+  model->refWidth = refW;
+  model->refHeight = refH;
+  model->baselineMs = baselineMs;
+  return true;
+}
+
+PresetCostModel *PresetCostModelLoad(const char *reportPath) {
+  PresetCostModel *model = new PresetCostModel();
+  model->refWidth = NOMINAL_REF_WIDTH;
+  model->refHeight = NOMINAL_REF_HEIGHT;
+  model->baselineMs = NOMINAL_BASELINE_MS;
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    if (EFFECT_DESCRIPTORS[i].name != NULL) {
+      model->effects[i] = NominalCost((TransformEffectType)i);
+    }
+  }
+
+  std::ifstream file(reportPath);
+  if (!file.is_open()) {
+    TraceLog(LOG_INFO, "PRESET_COST: No %s, using nominal costs", reportPath);
+    return model;
+  }
+  try {
+    model->calibrated = LoadReport(model, json::parse(file));
+  } catch (const json::exception &e) {
+    TraceLog(LOG_WARNING, "PRESET_COST: %s: %s", reportPath, e.what());
+  }
+  if (model->calibrated) {
+    TraceLog(LOG_INFO, "PRESET_COST: Loaded %s (%dx%d)", reportPath,
+             model->refWidth, model->refHeight);
+  } else {
+    TraceLog(LOG_WARNING, "PRESET_COST: Cannot use %s, using nominal costs",
+             reportPath);
+  }
+  return model;
+}
+
+void PresetCostModelFree(PresetCostModel *model) { delete model; }
+
+bool PresetCostModelCalibrated(const PresetCostModel *model) {
+  return model->calibrated;
+}
+
+// Product of configured / measured values over the effect's quality params
+static float QualityScale(const PresetCostModel *model,
+                          const EffectConfig *cfg, TransformEffectType type) {
+  const EffectDescriptor &d = EFFECT_DESCRIPTORS[type];
+  float scale = 1.0f;
+  for (int i = 0; i < d.qualityCount; i++) {
+    const int measured = ConfigInt(&model->defaults, d.quality[i].offset);
+    if (measured > 0) {
+      scale *= (float)ConfigInt(cfg, d.quality[i].offset) / (float)measured;
+    }
+  }
+  return scale;
+}
+
+static float AgentScale(const PresetCostModel *model, const EffectConfig *cfg,
+                        TransformEffectType type) {
+  for (const AgentKnob &knob : AGENT_KNOBS) {
+    if (knob.type != type) {
+      continue;
+    }
+    const int measured = ConfigInt(&model->defaults, knob.offset);
+    if (measured > 0) {
+      return (float)ConfigInt(cfg, knob.offset) / (float)measured;
+    }
+  }
+  return 1.0f;
+}
+
+static float EffectMs(const PresetCostModel *model, const EffectConfig *cfg,
+                      TransformEffectType type, float pixelScale) {
+  const EffectCost &c = model->effects[type];
+  const float tierScale =
+      EffectResolutionTierScale(EffectDescriptorResolutionTier(cfg, type));
+  const float shaded = pixelScale * tierScale * tierScale /
+                       (float)EffectDescriptorInterleaveCount(cfg, type);
+  return c.fixedMs * AgentScale(model, cfg, type) +
+         c.pixelMs * shaded * QualityScale(model, cfg, type);
+}
+
+// Keep cost->top sorted, costliest first
+static void InsertTop(PresetCost *cost, TransformEffectType type, float ms) {
+  for (int i = 0; i < PRESET_COST_TOP_EFFECTS; i++) {
+    if (cost->top[i] != TRANSFORM_EFFECT_COUNT && cost->topMs[i] >= ms) {
+      continue;
+    }
+    for (int j = PRESET_COST_TOP_EFFECTS - 1; j > i; j--) {
+      cost->top[j] = cost->top[j - 1];
+      cost->topMs[j] = cost->topMs[j - 1];
+    }
+    cost->top[i] = type;
+    cost->topMs[i] = ms;
+    return;
+  }
+}
+
+PresetCost PresetCostEstimate(const PresetCostModel *model,
+                              const EffectConfig *cfg, int width, int height) {
+  PresetCost cost = {};
+  for (int i = 0; i < PRESET_COST_TOP_EFFECTS; i++) {
+    cost.top[i] = TRANSFORM_EFFECT_COUNT;
+  }
+
+  const float refArea = (float)model->refWidth * (float)model->refHeight;
+  const float pixelScale =
+      refArea > 0.0f ? (float)width * (float)height / refArea : 1.0f;
+  cost.baselineMs = model->baselineMs * pixelScale;
+  cost.totalMs = cost.baselineMs;
+
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    const TransformEffectType type = (TransformEffectType)i;
+    if (EFFECT_DESCRIPTORS[i].name == NULL || !IsDescriptorEnabled(cfg, type)) {
+      continue;
+    }
+    const float ms = EffectMs(model, cfg, type, pixelScale);
+    cost.enabledCount++;
+    cost.totalMs += ms;
+    InsertTop(&cost, type, ms);
+  }
+  return cost;
+}
+
+PresetCostLevel PresetCostClassify(float totalMs, float budgetMs) {
+  if (budgetMs <= 0.0f) {
+    return PRESET_COST_OK;
+  }
+  if (totalMs > budgetMs) {
+    return PRESET_COST_OVER;
+  }
+  if (totalMs > budgetMs * PRESET_COST_TIGHT_FRACTION) {
+    return PRESET_COST_TIGHT;
+  }
+  return PRESET_COST_OK;
+}
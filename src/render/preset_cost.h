@@ -0,0 +1,52 @@
+#ifndef PRESET_COST_H
+#define PRESET_COST_H
+
+#include "config/effect_config.h"
+#include <stdbool.h>
+
+// Static GPU cost estimate for an EffectConfig, evaluated without rendering.
+// Per-effect costs come from a shader bench report (see shader_bench.h) at
+// its largest measured size, the reference resolution. Each effect's cost
+// splits into a per-pixel part, scaled by render size, resolution tier,
+// interleave and its quality params (march steps, iterations), and a fixed
+// part, scaled by agent count for simulations. Without a report, nominal
+// per-kind costs still rank presets but are not calibrated to the machine.
+
+#define PRESET_COST_REPORT "shader_bench.json"
+#define PRESET_COST_TOP_EFFECTS 3
+
+// Fraction of the frame budget above which an estimate is flagged tight
+#define PRESET_COST_TIGHT_FRACTION 0.8f
+
+typedef struct PresetCostModel PresetCostModel;
+
+typedef struct PresetCost {
+  float totalMs;    // Baseline plus every enabled effect
+  float baselineMs; // Feedback, drawables and output with no effects
+  int enabledCount;
+  // Most expensive effects, costliest first; TRANSFORM_EFFECT_COUNT = unused
+  TransformEffectType top[PRESET_COST_TOP_EFFECTS];
+  float topMs[PRESET_COST_TOP_EFFECTS];
+} PresetCost;
+
+typedef enum PresetCostLevel {
+  PRESET_COST_OK = 0,
+  PRESET_COST_TIGHT, // Above PRESET_COST_TIGHT_FRACTION of the budget
+  PRESET_COST_OVER,  // Estimate exceeds the budget
+} PresetCostLevel;
+
+// Load per-effect costs from a bench report. A missing or unreadable report
+// gives an uncalibrated model with nominal costs; never returns NULL.
+PresetCostModel *PresetCostModelLoad(const char *reportPath);
+void PresetCostModelFree(PresetCostModel *model);
+
+// True when costs came from a bench report
+bool PresetCostModelCalibrated(const PresetCostModel *model);
+
+// Estimated GPU time of one frame of cfg at the given internal resolution
+PresetCost PresetCostEstimate(const PresetCostModel *model,
+                              const EffectConfig *cfg, int width, int height);
+
+PresetCostLevel PresetCostClassify(float totalMs, float budgetMs);
+
+#endif // PRESET_COST_H
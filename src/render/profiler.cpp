@@ -1,5 +1,7 @@
 #include "profiler.h"
+#include "cpu_profiler.h"
 #include "raylib.h"
+#include "rlgl.h"
 
 static const char *ZONE_NAMES[ZONE_COUNT] = {"Feedback", "Simulation",
                                              "Drawables", "Output"};
@@ -24,9 +26,122 @@ void ProfilerInit(Profiler *profiler) {
     glEndQuery(GL_TIME_ELAPSED);
   }
 
+  for (int i = 0; i < PROFILER_SCOPE_LATENCY; i++) {
+    glGenQueries(ZONE_COUNT * 2, profiler->scopeFrames[i].zoneQueries);
+  }
+
+  profiler->openScopeRecord = -1;
   profiler->enabled = true;
 }
 
+void ProfilerUninit(Profiler *profiler) {
+  if (profiler == NULL || !profiler->enabled) {
+    return;
+  }
+  glDeleteQueries(ZONE_COUNT * 2, &profiler->queries[0][0]);
+  for (int i = 0; i < PROFILER_SCOPE_LATENCY; i++) {
+    ProfileScopeFrame *frame = &profiler->scopeFrames[i];
+    if (frame->queryCount > 0) {
+      glDeleteQueries(frame->queryCount, frame->queries);
+    }
+    glDeleteQueries(ZONE_COUNT * 2, frame->zoneQueries);
+    frame->queryCount = 0;
+    frame->recordCount = 0;
+  }
+  profiler->enabled = false;
+}
+
+static void CommitScopeSample(ProfileScope *scope) {
+  scope->history[scope->historyIndex] = scope->lastMs;
+  scope->historyIndex = (scope->historyIndex + 1) % PROFILER_HISTORY_SIZE;
+  if (scope->smoothedMs == 0.0f) {
+    scope->smoothedMs = scope->lastMs;
+  } else {
+    scope->smoothedMs +=
+        PROFILER_SMOOTHING * (scope->lastMs - scope->smoothedMs);
+  }
+}
+
+// Forwards the oldest slot's zone timestamps to the CPU trace timeline
+static void ReadZoneStamps(Profiler *profiler) {
+  const int readIdx = (profiler->scopeWriteIdx + 1) % PROFILER_SCOPE_LATENCY;
+  ProfileScopeFrame *frame = &profiler->scopeFrames[readIdx];
+  const uint32_t mask = frame->zoneMask;
+  frame->zoneMask = 0;
+  for (int z = 0; z < ZONE_COUNT; z++) {
+    if ((mask & (1u << z)) == 0) {
+      continue;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(frame->zoneQueries[z * 2 + 1],
+                       GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+      continue;
+    }
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(frame->zoneQueries[z * 2], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame->zoneQueries[z * 2 + 1], GL_QUERY_RESULT,
+                          &end);
+    CpuProfilerRecordGpu(profiler->zones[z].name, "zone",
+                         begin + frame->gpuToCpuNs, end + frame->gpuToCpuNs);
+  }
+}
+
+// Pairs the GPU and CPU clocks for this frame's timestamps
+static void CalibrateScopeFrame(Profiler *profiler) {
+#if CPU_PROFILER_ENABLED
+  GLint64 gpuNow = 0;
+  glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+  profiler->scopeFrames[profiler->scopeWriteIdx].gpuToCpuNs =
+      (int64_t)CpuProfilerNowNs() - gpuNow;
+#else
+  (void)profiler;
+#endif
+}
+
+// Reads the oldest ring slot. Frames whose final timestamp is not yet
+// available are dropped rather than waited on.
+static void ReadScopeFrame(Profiler *profiler) {
+  const int readIdx = (profiler->scopeWriteIdx + 1) % PROFILER_SCOPE_LATENCY;
+  ProfileScopeFrame *frame = &profiler->scopeFrames[readIdx];
+  const int count = frame->recordCount;
+  frame->recordCount = 0;
+  if (count == 0) {
+    return;
+  }
+  GLint available = 0;
+  glGetQueryObjectiv(frame->queries[count * 2 - 1], GL_QUERY_RESULT_AVAILABLE,
+                     &available);
+  if (!available) {
+    return;
+  }
+
+  const unsigned int stamp = profiler->frameIndex;
+  for (int i = 0; i < count; i++) {
+    GLuint64 begin = 0;
+    GLuint64 end = 0;
+    glGetQueryObjectui64v(frame->queries[i * 2], GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(frame->queries[i * 2 + 1], GL_QUERY_RESULT, &end);
+    ProfileScope *scope = &profiler->scopes[frame->scopeIds[i]];
+    CpuProfilerRecordGpu(scope->name, scope->detail,
+                         begin + frame->gpuToCpuNs, end + frame->gpuToCpuNs);
+    // A scope recorded more than once per frame accumulates
+    if (scope->sampleFrame != stamp) {
+      scope->sampleFrame = stamp;
+      scope->lastMs = 0.0f;
+    }
+    scope->lastMs += (float)(end - begin) / 1000000.0f;
+  }
+  for (int i = 0; i < count; i++) {
+    ProfileScope *scope = &profiler->scopes[frame->scopeIds[i]];
+    if (scope->commitFrame != stamp) {
+      scope->commitFrame = stamp;
+      CommitScopeSample(scope);
+    }
+  }
+}
+
 void ProfilerFrameBegin(Profiler *profiler) {
   if (profiler == NULL || !profiler->enabled) {
     return;
@@ -51,6 +166,11 @@ void ProfilerFrameBegin(Profiler *profiler) {
       *smoothed = *smoothed + PROFILER_SMOOTHING * (ms - *smoothed);
     }
   }
+
+  profiler->frameIndex++;
+  ReadZoneStamps(profiler);
+  ReadScopeFrame(profiler);
+  CalibrateScopeFrame(profiler);
 }
 
 void ProfilerFrameEnd(Profiler *profiler) {
@@ -59,6 +179,9 @@ void ProfilerFrameEnd(Profiler *profiler) {
   }
   // Flip double buffer for next frame
   profiler->writeIdx = 1 - profiler->writeIdx;
+  profiler->scopeWriteIdx =
+      (profiler->scopeWriteIdx + 1) % PROFILER_SCOPE_LATENCY;
+  profiler->openScopeRecord = -1;
 
   // Advance history ring buffer index
   for (int i = 0; i < ZONE_COUNT; i++) {
@@ -71,6 +194,11 @@ void ProfilerBeginZone(Profiler *profiler, ProfileZoneId zone) {
   if (profiler == NULL || !profiler->enabled) {
     return;
   }
+  ProfileScopeFrame *frame = &profiler->scopeFrames[profiler->scopeWriteIdx];
+  frame->zoneMask |= 1u << zone;
+  rlDrawRenderBatchActive();
+  glQueryCounter(frame->zoneQueries[zone * 2], GL_TIMESTAMP);
+
   const GLuint query = profiler->queries[zone][profiler->writeIdx];
   glBeginQuery(GL_TIME_ELAPSED, query);
 }
@@ -79,6 +207,64 @@ void ProfilerEndZone(const Profiler *profiler, ProfileZoneId zone) {
   if (profiler == NULL || !profiler->enabled) {
     return;
   }
-  (void)zone; // GL_TIME_ELAPSED allows only one active query; zone unused
+  // GL_TIME_ELAPSED allows only one active query, so only the stamp needs zone
+  rlDrawRenderBatchActive();
   glEndQuery(GL_TIME_ELAPSED);
+  glQueryCounter(
+      profiler->scopeFrames[profiler->scopeWriteIdx].zoneQueries[zone * 2 + 1],
+      GL_TIMESTAMP);
+}
+
+// Returns the query at index, generating pool entries up to it on demand
+static GLuint ScopeQuery(ProfileScopeFrame *frame, int index) {
+  if (index >= frame->queryCount) {
+    const int grow = index + 1 - frame->queryCount;
+    glGenQueries(grow, &frame->queries[frame->queryCount]);
+    frame->queryCount += grow;
+  }
+  return frame->queries[index];
+}
+
+void ProfilerBeginScope(Profiler *profiler, int scopeId, const char *name,
+                        const char *detail) {
+  if (profiler == NULL || !profiler->enabled || scopeId < 0 ||
+      scopeId >= PROFILER_MAX_SCOPES || profiler->openScopeRecord >= 0) {
+    return;
+  }
+  ProfileScopeFrame *frame = &profiler->scopeFrames[profiler->scopeWriteIdx];
+  if (frame->recordCount >= PROFILER_MAX_SCOPE_RECORDS) {
+    return;
+  }
+  ProfileScope *scope = &profiler->scopes[scopeId];
+  scope->name = name;
+  scope->detail = detail;
+
+  const int record = frame->recordCount++;
+  frame->scopeIds[record] = scopeId;
+  profiler->openScopeRecord = record;
+  // Flush batched raylib draws so they land on the right side of the stamp
+  rlDrawRenderBatchActive();
+  glQueryCounter(ScopeQuery(frame, record * 2), GL_TIMESTAMP);
+}
+
+void ProfilerEndScope(Profiler *profiler) {
+  if (profiler == NULL || !profiler->enabled ||
+      profiler->openScopeRecord < 0) {
+    return;
+  }
+  ProfileScopeFrame *frame = &profiler->scopeFrames[profiler->scopeWriteIdx];
+  rlDrawRenderBatchActive();
+  glQueryCounter(ScopeQuery(frame, profiler->openScopeRecord * 2 + 1),
+                 GL_TIMESTAMP);
+  profiler->openScopeRecord = -1;
+}
+
+bool ProfilerScopeActive(const Profiler *profiler, int scopeId,
+                         unsigned int maxAgeFrames) {
+  if (profiler == NULL || scopeId < 0 || scopeId >= PROFILER_MAX_SCOPES) {
+    return false;
+  }
+  const ProfileScope *scope = &profiler->scopes[scopeId];
+  return scope->name != NULL && scope->sampleFrame != 0 &&
+         profiler->frameIndex - scope->sampleFrame <= maxAgeFrames;
 }
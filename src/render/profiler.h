@@ -3,12 +3,20 @@
 
 #include "external/glad.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 // Profiler constants
 #define PROFILER_HISTORY_SIZE 64
 #define PROFILER_SMOOTHING                                                     \
   0.05f // EMA factor: 0.05 = 5% new value per frame (slower, calmer UI)
 
+// Fine-grained GPU scopes (per effect / pass). Ids are assigned by the
+// caller; results are read back PROFILER_SCOPE_LATENCY - 1 frames late so
+// the CPU never waits on the GPU.
+#define PROFILER_MAX_SCOPES 384
+#define PROFILER_MAX_SCOPE_RECORDS 128 // Scope instances per frame
+#define PROFILER_SCOPE_LATENCY 3
+
 // Pipeline zones for GPU timing instrumentation
 typedef enum ProfileZoneId {
   ZONE_FEEDBACK = 0,
@@ -27,6 +35,31 @@ typedef struct ProfileZone {
   int historyIndex;
 } ProfileZone;
 
+// Per-scope timing state, indexed by scope id
+typedef struct ProfileScope {
+  const char *name;   // NULL until the scope is first recorded
+  const char *detail; // Optional pass qualifier ("scratch", "pre-pass")
+  float lastMs;
+  float smoothedMs;
+  float history[PROFILER_HISTORY_SIZE];
+  int historyIndex;
+  unsigned int sampleFrame; // Frame index of the latest readback
+  unsigned int commitFrame; // Frame index of the latest history push
+} ProfileScope;
+
+// GL_TIMESTAMP query pool for one frame. Queries are generated on demand so
+// the pool grows to the longest effect chain seen.
+typedef struct ProfileScopeFrame {
+  GLuint queries[PROFILER_MAX_SCOPE_RECORDS * 2]; // begin/end per record
+  int scopeIds[PROFILER_MAX_SCOPE_RECORDS];
+  int queryCount;  // Query objects generated so far
+  int recordCount; // Records written this frame
+  // Zone begin/end timestamps, exported to the CPU trace timeline
+  GLuint zoneQueries[ZONE_COUNT * 2];
+  uint32_t zoneMask;  // Zones stamped this frame
+  int64_t gpuToCpuNs; // CPU clock minus GPU clock when the frame began
+} ProfileScopeFrame;
+
 // GPU profiler state with double-buffered timestamp queries
 typedef struct Profiler {
   ProfileZone zones[ZONE_COUNT];
@@ -34,6 +67,11 @@ typedef struct Profiler {
   int writeIdx;                  // Current write buffer (0 or 1)
   double frameStartTime;
   bool enabled;
+  ProfileScope scopes[PROFILER_MAX_SCOPES];
+  ProfileScopeFrame scopeFrames[PROFILER_SCOPE_LATENCY];
+  int scopeWriteIdx;   // Ring slot recorded this frame
+  int openScopeRecord; // Record awaiting ProfilerEndScope, or -1
+  unsigned int frameIndex;
 } Profiler;
 
 // Profiler lifecycle
@@ -43,4 +81,18 @@ void ProfilerFrameEnd(Profiler *profiler);
 void ProfilerBeginZone(Profiler *profiler, ProfileZoneId zone);
 void ProfilerEndZone(const Profiler *profiler, ProfileZoneId zone);
 
+// Bracket one GPU pass with timestamps. Scopes may sit inside zones but not
+// inside each other. name/detail must outlive the profiler (string
+// literals or descriptor names).
+void ProfilerBeginScope(Profiler *profiler, int scopeId, const char *name,
+                        const char *detail);
+void ProfilerEndScope(Profiler *profiler);
+
+// True when the scope was sampled within the last maxAgeFrames frames
+bool ProfilerScopeActive(const Profiler *profiler, int scopeId,
+                         unsigned int maxAgeFrames);
+
+// Release query objects
+void ProfilerUninit(Profiler *profiler);
+
 #endif // PROFILER_H
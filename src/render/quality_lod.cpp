@@ -0,0 +1,129 @@
+#include "quality_lod.h"
+#include "profiler.h"
+#include <math.h>
+#include <stddef.h>
+
+// Hysteresis band as fractions of targetMs. Iteration counts scale cost
+// roughly linearly, so one step up (+10%) fits under the upper band.
+static const float UPPER_BAND = 1.0f;
+static const float LOWER_BAND = 0.8f;
+
+// Degrade faster than the render scale controller so shader detail gives way
+// before resolution does
+static const float DOWN_HOLD_S = 0.25f;
+static const float UP_HOLD_S = 1.5f;
+static const float CHANGE_COOLDOWN_S = 0.5f;
+
+static float ClampLevel(float level, float lo, float hi) {
+  if (level < lo) {
+    return lo;
+  }
+  if (level > hi) {
+    return hi;
+  }
+  return level;
+}
+
+static float QuantizeLevel(float level) {
+  return roundf(level / QUALITY_LOD_STEP) * QUALITY_LOD_STEP;
+}
+
+static float TotalGpuMs(const Profiler *profiler) {
+  float total = 0.0f;
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    total += profiler->zones[i].smoothedMs;
+  }
+  return total;
+}
+
+void QualityLodInit(QualityLod *lod) {
+  if (lod == NULL) {
+    return;
+  }
+  *lod = QualityLod{};
+  lod->enabled = false;
+  lod->targetMs = 1000.0f / 60.0f;
+  lod->minLevel = QUALITY_LOD_MIN;
+  lod->level = QUALITY_LOD_MAX;
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    lod->priority[i] = 1.0f;
+  }
+}
+
+float QualityLodEffectLevel(const QualityLod *lod, TransformEffectType type) {
+  if (lod == NULL || !lod->enabled || type < 0 ||
+      type >= TRANSFORM_EFFECT_COUNT) {
+    return QUALITY_LOD_MAX;
+  }
+  // level^(1/w) stays in [0,1]: w > 1 bends toward full quality, w < 1 away
+  const float w = ClampLevel(lod->priority[type], QUALITY_PRIORITY_MIN,
+                             QUALITY_PRIORITY_MAX);
+  return powf(lod->level, 1.0f / w);
+}
+
+// Tracks time outside the hysteresis band and returns the next level
+static float StepLevel(QualityLod *lod, float totalMs, float deltaTime) {
+  if (totalMs > lod->targetMs * UPPER_BAND) {
+    lod->overBudgetS += deltaTime;
+    lod->underBudgetS = 0.0f;
+  } else if (totalMs < lod->targetMs * LOWER_BAND) {
+    lod->underBudgetS += deltaTime;
+    lod->overBudgetS = 0.0f;
+  } else {
+    lod->overBudgetS = 0.0f;
+    lod->underBudgetS = 0.0f;
+  }
+
+  if (lod->overBudgetS >= DOWN_HOLD_S) {
+    return lod->level - QUALITY_LOD_STEP;
+  }
+  if (lod->underBudgetS >= UP_HOLD_S) {
+    return lod->level + QUALITY_LOD_STEP;
+  }
+  return lod->level;
+}
+
+static void UpdateLevel(QualityLod *lod, const Profiler *profiler,
+                        float deltaTime) {
+  const float lo = ClampLevel(lod->minLevel, QUALITY_LOD_MIN, QUALITY_LOD_MAX);
+  lod->level = QuantizeLevel(ClampLevel(lod->level, lo, QUALITY_LOD_MAX));
+
+  if (!lod->enabled || profiler == NULL || !profiler->enabled) {
+    lod->level = QUALITY_LOD_MAX;
+    lod->overBudgetS = 0.0f;
+    lod->underBudgetS = 0.0f;
+    lod->cooldownS = 0.0f;
+    return;
+  }
+  if (lod->cooldownS > 0.0f) {
+    lod->cooldownS -= deltaTime;
+    return;
+  }
+  const float totalMs = TotalGpuMs(profiler);
+  if (totalMs <= 0.0f) {
+    return;
+  }
+
+  const float next = QuantizeLevel(
+      ClampLevel(StepLevel(lod, totalMs, deltaTime), lo, QUALITY_LOD_MAX));
+  if (next != lod->level) {
+    lod->level = next;
+    lod->overBudgetS = 0.0f;
+    lod->underBudgetS = 0.0f;
+    lod->cooldownS = CHANGE_COOLDOWN_S;
+  }
+}
+
+void QualityLodUpdate(QualityLod *lod, const Profiler *profiler,
+                      float deltaTime, float *effectLevels) {
+  if (lod == NULL) {
+    return;
+  }
+  UpdateLevel(lod, profiler, deltaTime);
+  if (effectLevels == NULL) {
+    return;
+  }
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    effectLevels[i] = QualityLodEffectLevel(lod, (TransformEffectType)i);
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef QUALITY_LOD_H
+#define QUALITY_LOD_H
+
+#include "config/effect_config.h"
+#include <stdbool.h>
+
+typedef struct Profiler Profiler;
+
+// LOD bounds and quantization. Steps keep iteration counts from flickering
+// between adjacent values every frame.
+#define QUALITY_LOD_MIN 0.0f
+#define QUALITY_LOD_MAX 1.0f
+#define QUALITY_LOD_STEP 0.1f
+
+// Priority weight bounds; 1.0 degrades linearly with the global LOD
+#define QUALITY_PRIORITY_MIN 0.25f
+#define QUALITY_PRIORITY_MAX 4.0f
+
+// Global quality level for descriptor-declared cost knobs (ray-march steps,
+// fold/IFS iterations), driven by GPU frame time from the profiler
+typedef struct QualityLod {
+  bool enabled;       // Follow targetMs; off holds every effect at LOD 1
+  float targetMs;     // GPU frame-time budget
+  float minLevel;     // Floor for the global level (0-1)
+  float level;        // Current global level, quantized to QUALITY_LOD_STEP
+  float overBudgetS;  // Seconds spent above the upper hysteresis band
+  float underBudgetS; // Seconds spent below the lower hysteresis band
+  float cooldownS;    // Seconds until the next change is allowed
+  // Per-effect weight: >1 keeps an effect sharper while others degrade
+  float priority[TRANSFORM_EFFECT_COUNT];
+} QualityLod;
+
+// Defaults to disabled with a 60 fps budget and unit priorities
+void QualityLodInit(QualityLod *lod);
+
+// Advance the controller and write each effect's LOD (0-1) to effectLevels.
+// Reads smoothed zone times from previous frames; call before rendering.
+void QualityLodUpdate(QualityLod *lod, const Profiler *profiler,
+                      float deltaTime, float *effectLevels);
+
+// Effective LOD for one effect: global level shaped by its priority weight
+float QualityLodEffectLevel(const QualityLod *lod, TransformEffectType type);
+
+#endif // QUALITY_LOD_H
@@ -14,6 +14,8 @@ typedef struct {
   Texture2D
       accumTexture; // Feedback-processed content for textured shape sampling
   PostEffect *postEffect; // Post-effect processor for shader access
+  float deltaTime;        // Frame step (fixed audio-clock step when headless)
+  double time;            // Seconds since start on the same clock
 } RenderContext;
 
 #endif // RENDER_CONTEXT_H
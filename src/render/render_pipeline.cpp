@@ -3,11 +3,13 @@
 #include "analysis/fft.h"
 #include "blend_compositor.h"
 #include "config/effect_descriptor.h"
+#include "cpu_profiler.h"
 #include "drawable.h"
 #include "post_effect.h"
 #include "raylib.h"
 #include "render_utils.h"
 #include "shader_setup.h"
+#include "shm_output.h"
 #include "simulation/attractor_flow.h"
 #include "simulation/boids.h"
 #include "simulation/curl_flow.h"
@@ -18,6 +20,7 @@
 #include "ui/imgui_effects_dispatch.h"
 #include <math.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 static void BlitTexture(const Texture2D &srcTex, const RenderTexture2D *dest,
                         int width, int height) {
@@ -34,6 +37,7 @@ static void RenderPass(PostEffect *pe, const RenderTexture2D *source,
   if (shader.id != 0) {
     BeginShaderMode(shader);
     if (setup != NULL) {
+      CPU_ZONE("Setup");
       setup(pe);
     }
   }
@@ -45,7 +49,31 @@ static void RenderPass(PostEffect *pe, const RenderTexture2D *source,
   EndTextureMode();
 }
 
-static void ApplyCurlFlowPass(PostEffect *pe, float deltaTime) {
+// A fixed-step simulation snapshots its trails before the frame's last step,
+// so the composite can crossfade from that state by steps->alpha instead of
+// jumping once per step when the display outpaces the simulation
+static void SnapshotTrails(TrailMap *trailMap, const SimSteps *steps,
+                           int step) {
+  if (steps->alpha < 1.0f && step + 1 == steps->count) {
+    TrailMapSnapshot(trailMap);
+  }
+}
+
+// Steps before the last diffuse and decay in place. The last step's trails
+// join the batch ApplySimulationPasses flushes after every simulation has
+// stepped; frames with no step leave the trails alone.
+static void QueueTrails(TrailMapBatch *trails, TrailMap *trailMap,
+                        const SimSteps *steps, float decayHalfLife,
+                        int diffusionScale) {
+  TrailMapSetStepAlpha(trailMap, steps->alpha);
+  if (steps->count > 0) {
+    TrailMapBatchAdd(trails, trailMap, steps->stepTime, decayHalfLife,
+                     diffusionScale);
+  }
+}
+
+static void ApplyCurlFlowPass(PostEffect *pe, const SimSteps *steps,
+                              TrailMapBatch *trails) {
   if (pe->curlFlow == NULL) {
     return;
   }
@@ -54,8 +82,16 @@ static void ApplyCurlFlowPass(PostEffect *pe, float deltaTime) {
   CurlFlowApplyConfig(pe->curlFlow, &pe->effects.curlFlow);
 
   if (pe->effects.curlFlow.enabled) {
-    CurlFlowUpdate(pe->curlFlow, deltaTime, pe->accumTexture.texture);
-    CurlFlowProcessTrails(pe->curlFlow, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->curlFlow->trailMap, steps, i);
+      CurlFlowUpdate(pe->curlFlow, steps->stepTime, pe->accumTexture.texture);
+      if (i + 1 < steps->count) {
+        CurlFlowProcessTrails(pe->curlFlow, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->curlFlow->trailMap, steps,
+                pe->effects.curlFlow.decayHalfLife,
+                pe->effects.curlFlow.diffusionScale);
   }
 
   if (pe->effects.curlFlow.debugOverlay && pe->effects.curlFlow.enabled) {
@@ -65,7 +101,8 @@ static void ApplyCurlFlowPass(PostEffect *pe, float deltaTime) {
   }
 }
 
-static void ApplyPhysarumPass(PostEffect *pe, float deltaTime) {
+static void ApplyPhysarumPass(PostEffect *pe, const SimSteps *steps,
+                              TrailMapBatch *trails) {
   if (pe->physarum == NULL) {
     return;
   }
@@ -74,9 +111,17 @@ static void ApplyPhysarumPass(PostEffect *pe, float deltaTime) {
   PhysarumApplyConfig(pe->physarum, &pe->effects.physarum);
 
   if (pe->effects.physarum.enabled) {
-    PhysarumUpdate(pe->physarum, deltaTime, pe->accumTexture.texture,
-                   pe->fftTexture);
-    PhysarumProcessTrails(pe->physarum, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->physarum->trailMap, steps, i);
+      PhysarumUpdate(pe->physarum, steps->stepTime, pe->accumTexture.texture,
+                     pe->fftTexture);
+      if (i + 1 < steps->count) {
+        PhysarumProcessTrails(pe->physarum, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->physarum->trailMap, steps,
+                pe->effects.physarum.decayHalfLife,
+                pe->effects.physarum.diffusionScale);
   }
 
   if (pe->effects.physarum.debugOverlay && pe->effects.physarum.enabled) {
@@ -86,7 +131,8 @@ static void ApplyPhysarumPass(PostEffect *pe, float deltaTime) {
   }
 }
 
-static void ApplyAttractorFlowPass(PostEffect *pe, float deltaTime) {
+static void ApplyAttractorFlowPass(PostEffect *pe, const SimSteps *steps,
+                                   TrailMapBatch *trails) {
   if (pe->attractorFlow == NULL) {
     return;
   }
@@ -95,8 +141,16 @@ static void ApplyAttractorFlowPass(PostEffect *pe, float deltaTime) {
   AttractorFlowApplyConfig(pe->attractorFlow, &pe->effects.attractorFlow);
 
   if (pe->effects.attractorFlow.enabled) {
-    AttractorFlowUpdate(pe->attractorFlow, deltaTime);
-    AttractorFlowProcessTrails(pe->attractorFlow, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->attractorFlow->trailMap, steps, i);
+      AttractorFlowUpdate(pe->attractorFlow, steps->stepTime);
+      if (i + 1 < steps->count) {
+        AttractorFlowProcessTrails(pe->attractorFlow, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->attractorFlow->trailMap, steps,
+                pe->effects.attractorFlow.decayHalfLife,
+                pe->effects.attractorFlow.diffusionScale);
   }
 
   if (pe->effects.attractorFlow.debugOverlay &&
@@ -107,7 +161,8 @@ static void ApplyAttractorFlowPass(PostEffect *pe, float deltaTime) {
   }
 }
 
-static void ApplyParticleLifePass(PostEffect *pe, float deltaTime) {
+static void ApplyParticleLifePass(PostEffect *pe, const SimSteps *steps,
+                                  TrailMapBatch *trails) {
   if (pe->particleLife == NULL) {
     return;
   }
@@ -115,8 +170,16 @@ static void ApplyParticleLifePass(PostEffect *pe, float deltaTime) {
   ParticleLifeApplyConfig(pe->particleLife, &pe->effects.particleLife);
 
   if (pe->effects.particleLife.enabled) {
-    ParticleLifeUpdate(pe->particleLife, deltaTime);
-    ParticleLifeProcessTrails(pe->particleLife, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->particleLife->trailMap, steps, i);
+      ParticleLifeUpdate(pe->particleLife, steps->stepTime);
+      if (i + 1 < steps->count) {
+        ParticleLifeProcessTrails(pe->particleLife, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->particleLife->trailMap, steps,
+                pe->effects.particleLife.decayHalfLife,
+                pe->effects.particleLife.diffusionScale);
   }
 
   if (pe->effects.particleLife.debugOverlay &&
@@ -127,7 +190,8 @@ static void ApplyParticleLifePass(PostEffect *pe, float deltaTime) {
   }
 }
 
-static void ApplyBoidsPass(PostEffect *pe, float deltaTime) {
+static void ApplyBoidsPass(PostEffect *pe, const SimSteps *steps,
+                           TrailMapBatch *trails) {
   if (pe->boids == NULL) {
     return;
   }
@@ -136,8 +200,17 @@ static void ApplyBoidsPass(PostEffect *pe, float deltaTime) {
   BoidsApplyConfig(pe->boids, &pe->effects.boids);
 
   if (pe->effects.boids.enabled) {
-    BoidsUpdate(pe->boids, deltaTime, pe->accumTexture.texture, pe->fftTexture);
-    BoidsProcessTrails(pe->boids, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->boids->trailMap, steps, i);
+      BoidsUpdate(pe->boids, steps->stepTime, pe->accumTexture.texture,
+                  pe->fftTexture);
+      if (i + 1 < steps->count) {
+        BoidsProcessTrails(pe->boids, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->boids->trailMap, steps,
+                pe->effects.boids.decayHalfLife,
+                pe->effects.boids.diffusionScale);
   }
 
   if (pe->effects.boids.debugOverlay && pe->effects.boids.enabled) {
@@ -147,7 +220,8 @@ static void ApplyBoidsPass(PostEffect *pe, float deltaTime) {
   }
 }
 
-static void ApplyMazeWormsPass(PostEffect *pe, float deltaTime) {
+static void ApplyMazeWormsPass(PostEffect *pe, const SimSteps *steps,
+                               TrailMapBatch *trails) {
   if (pe->mazeWorms == NULL) {
     return;
   }
@@ -155,8 +229,16 @@ static void ApplyMazeWormsPass(PostEffect *pe, float deltaTime) {
   MazeWormsApplyConfig(pe->mazeWorms, &pe->effects.mazeWorms);
 
   if (pe->effects.mazeWorms.enabled) {
-    MazeWormsUpdate(pe->mazeWorms, deltaTime);
-    MazeWormsProcessTrails(pe->mazeWorms, deltaTime);
+    for (int i = 0; i < steps->count; i++) {
+      SnapshotTrails(pe->mazeWorms->trailMap, steps, i);
+      MazeWormsUpdate(pe->mazeWorms, steps->stepTime);
+      if (i + 1 < steps->count) {
+        MazeWormsProcessTrails(pe->mazeWorms, steps->stepTime);
+      }
+    }
+    QueueTrails(trails, pe->mazeWorms->trailMap, steps,
+                pe->effects.mazeWorms.decayHalfLife,
+                pe->effects.mazeWorms.diffusionScale);
   }
 }
 
@@ -168,13 +250,71 @@ static void UpdateWaveformTexture(const PostEffect *pe,
   UpdateTexture(pe->waveformTexture, waveformHistory);
 }
 
-static void ApplySimulationPasses(PostEffect *pe, float deltaTime) {
-  ApplyPhysarumPass(pe, deltaTime);
-  ApplyCurlFlowPass(pe, deltaTime);
-  ApplyAttractorFlowPass(pe, deltaTime);
-  ApplyParticleLifePass(pe, deltaTime);
-  ApplyBoidsPass(pe, deltaTime);
-  ApplyMazeWormsPass(pe, deltaTime);
+// GPU scope ids: one per transform, one per transform pre-pass (generator
+// scratch, bloom/streak mips), then one per simulation dispatch and one for
+// the batched trail diffusion
+static const int SCOPE_PREPASS_BASE = TRANSFORM_EFFECT_COUNT;
+static const int SCOPE_SIM_BASE = TRANSFORM_EFFECT_COUNT * 2;
+
+typedef void (*SimulationPassFn)(PostEffect *pe, const SimSteps *steps,
+                                 TrailMapBatch *trails);
+
+struct SimulationPass {
+  const char *name;
+  size_t enabledOffset;  // Only enabled sims get a GPU scope
+  size_t stepRateOffset; // Fixed steps per second for the pass's SimClock
+  SimulationPassFn apply;
+};
+
+#define SIMULATION_PASS(name, field, apply)                                    \
+  {name, offsetof(EffectConfig, field.enabled),                                \
+   offsetof(EffectConfig, field.stepRate), apply}
+
+static const SimulationPass SIMULATION_PASSES[] = {
+    SIMULATION_PASS("Physarum", physarum, ApplyPhysarumPass),
+    SIMULATION_PASS("Curl Flow", curlFlow, ApplyCurlFlowPass),
+    SIMULATION_PASS("Attractor Flow", attractorFlow, ApplyAttractorFlowPass),
+    SIMULATION_PASS("Particle Life", particleLife, ApplyParticleLifePass),
+    SIMULATION_PASS("Boids", boids, ApplyBoidsPass),
+    SIMULATION_PASS("Maze Worms", mazeWorms, ApplyMazeWormsPass),
+};
+static_assert(sizeof(SIMULATION_PASSES) / sizeof(SIMULATION_PASSES[0]) ==
+                  POST_EFFECT_SIMULATION_COUNT,
+              "one SimClock per simulation pass");
+
+static void ApplySimulationPasses(PostEffect *pe, float deltaTime,
+                                  Profiler *profiler) {
+  const int count = sizeof(SIMULATION_PASSES) / sizeof(SIMULATION_PASSES[0]);
+  TrailMapBatch trails = {};
+  for (int i = 0; i < count; i++) {
+    const SimulationPass &pass = SIMULATION_PASSES[i];
+    const char *config = reinterpret_cast<const char *>(&pe->effects);
+    const bool enabled =
+        *reinterpret_cast<const bool *>(config + pass.enabledOffset);
+    const float stepRate =
+        *reinterpret_cast<const float *>(config + pass.stepRateOffset);
+
+    // A disabled sim banks no time, so enabling it doesn't burst steps
+    SimSteps steps = {0, deltaTime, 1.0f};
+    if (enabled) {
+      steps = SimClockAdvance(&pe->simClocks[i], deltaTime, stepRate);
+      ProfilerBeginScope(profiler, SCOPE_SIM_BASE + i, pass.name, "sim");
+    } else {
+      SimClockReset(&pe->simClocks[i]);
+    }
+    pass.apply(pe, &steps, &trails);
+    if (enabled) {
+      ProfilerEndScope(profiler);
+    }
+  }
+
+  // One diffusion dispatch pair for every enabled simulation's trails
+  if (trails.count > 0) {
+    ProfilerBeginScope(profiler, SCOPE_SIM_BASE + count, "Trail Diffusion",
+                       "sim");
+    TrailMapBatchFlush(&trails);
+    ProfilerEndScope(profiler);
+  }
 }
 
 void RenderPipelineApplyFeedback(PostEffect *pe, float deltaTime,
@@ -215,6 +355,7 @@ void RenderPipelineExecute(PostEffect *pe, DrawableState *state,
                            const float *fftMagnitude,
                            const float *waveformHistory, int waveformWriteIndex,
                            Profiler *profiler) {
+  CPU_ZONE("RenderPipelineExecute");
   ProfilerFrameBegin(profiler);
 
   // Upload waveform texture before simulations consume it
@@ -223,7 +364,7 @@ void RenderPipelineExecute(PostEffect *pe, DrawableState *state,
 
   // 1. Run GPU simulations (physarum, curl flow, attractor, boids)
   ProfilerBeginZone(profiler, ZONE_SIMULATION);
-  ApplySimulationPasses(pe, deltaTime);
+  ApplySimulationPasses(pe, deltaTime, profiler);
   ProfilerEndZone(profiler, ZONE_SIMULATION);
 
   // 2. Apply feedback effects (warp, blur, decay)
@@ -249,18 +390,19 @@ void RenderPipelineExecute(PostEffect *pe, DrawableState *state,
   ProfilerBeginZone(profiler, ZONE_OUTPUT);
   BeginDrawing();
   ClearBackground(BLACK);
-  RenderPipelineApplyOutput(pe, DrawableGetTick(state), deltaTime);
+  RenderPipelineApplyOutput(pe, DrawableGetTick(state), deltaTime, profiler);
   ProfilerEndZone(profiler, ZONE_OUTPUT);
 
   ProfilerFrameEnd(profiler);
 }
 
 void RenderPipelineApplyOutput(PostEffect *pe, uint64_t globalTick,
-                               float deltaTime) {
+                               float deltaTime, Profiler *profiler) {
   (void)deltaTime; // reserved for time-based output effects
   // Compute Lissajous animation time
   const float t = (float)globalTick * 0.016f;
   pe->transformTime = t;
+  pe->interleaveFrame++;
 
   BeginTextureMode(pe->pingPong[0]);
   ClearBackground(BLACK);
@@ -277,20 +419,47 @@ void RenderPipelineApplyOutput(PostEffect *pe, uint64_t globalTick,
       if (soloActive && !g_effectSolo[effectType]) {
         continue;
       }
-      if ((EFFECT_DESCRIPTORS[effectType].flags & EFFECT_FLAG_HALF_RES) != 0) {
-        ApplyHalfResEffect(pe, src, &writeIdx, *entry.shader, entry.setup);
+      CPU_ZONE(EFFECT_DESCRIPTORS[effectType].name);
+      // Setup callbacks read quality params straight from the config, so
+      // lower them for the duration of this effect's passes only
+      int savedQuality[EFFECT_QUALITY_PARAM_MAX];
+      const int qualityCount = EffectDescriptorApplyQuality(
+          &pe->effects, effectType, pe->qualityLevel[effectType],
+          savedQuality);
+      const EffectResolutionTier tier =
+          EffectDescriptorResolutionTier(&pe->effects, effectType);
+      const bool isBlend =
+          (EFFECT_DESCRIPTORS[effectType].flags & EFFECT_FLAG_BLEND) != 0;
+      const char *name = EFFECT_DESCRIPTORS[effectType].name;
+      const int prePassScope = SCOPE_PREPASS_BASE + effectType;
+      if (tier != RES_TIER_FULL && !isBlend) {
+        // A tier resolved from DEFAULT keeps the bilinear upsample saved
+        // presets were tuned with; only a chosen tier opts into edge-aware
+        const bool edgeAware =
+            pe->effects.resolutionTier[effectType] != RES_TIER_DEFAULT;
+        ProfilerBeginScope(profiler, effectType, name, NULL);
+        ApplyTieredEffect(pe, src, &pe->pingPong[writeIdx], tier,
+                          *entry.shader, entry.setup, edgeAware);
       } else if (effectType == TRANSFORM_BLOOM) {
+        ProfilerBeginScope(profiler, prePassScope, name, "pre-pass");
         ApplyBloomPasses(pe, src, &writeIdx);
+        ProfilerEndScope(profiler);
+        ProfilerBeginScope(profiler, effectType, name, NULL);
         RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
                    entry.setup);
       } else if (effectType == TRANSFORM_ANAMORPHIC_STREAK) {
+        ProfilerBeginScope(profiler, prePassScope, name, "pre-pass");
         ApplyAnamorphicStreakPasses(pe, src);
+        ProfilerEndScope(profiler);
+        ProfilerBeginScope(profiler, effectType, name, NULL);
         RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
                    entry.setup);
       } else if (effectType == TRANSFORM_OIL_PAINT) {
+        ProfilerBeginScope(profiler, effectType, name, NULL);
         entry.setup(pe);
         ApplyHalfResOilPaint(pe, src, &writeIdx);
       } else if (EFFECT_DESCRIPTORS[effectType].render != nullptr) {
+        ProfilerBeginScope(profiler, effectType, name, NULL);
         pe->currentSceneTexture = src->texture;
         pe->currentRenderDest = &pe->pingPong[writeIdx];
         EFFECT_DESCRIPTORS[effectType].scratchSetup(pe);
@@ -299,16 +468,35 @@ void RenderPipelineApplyOutput(PostEffect *pe, uint64_t globalTick,
           RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
                      entry.setup);
         }
-      } else if ((EFFECT_DESCRIPTORS[effectType].flags & EFFECT_FLAG_BLEND) !=
-                 0) {
+      } else if (isBlend) {
         const GeneratorPassInfo gen = GetGeneratorScratchPass(pe, effectType);
-        RenderPass(pe, src, &pe->generatorScratch, gen.shader, gen.setup);
+        const int interleave =
+            EffectDescriptorInterleaveCount(&pe->effects, effectType);
+        ProfilerBeginScope(profiler, prePassScope, name, "scratch");
+        if (tier != RES_TIER_FULL) {
+          ApplyTieredEffect(pe, src, &pe->generatorScratch, tier, gen.shader,
+                            gen.setup, false);
+        } else if (interleave > 1) {
+          ApplyInterleavedEffect(pe, src, &pe->generatorScratch, effectType,
+                                 gen.shader, gen.setup, interleave);
+        } else {
+          RenderPass(pe, src, &pe->generatorScratch, gen.shader, gen.setup);
+        }
+        ProfilerEndScope(profiler);
+        ProfilerBeginScope(profiler, effectType, name, NULL);
         RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
                    entry.setup);
       } else {
-        RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
-                   entry.setup);
+        ProfilerBeginScope(profiler, effectType, name, NULL);
+        const ComputePassFn compute = EFFECT_DESCRIPTORS[effectType].compute;
+        if (compute == nullptr || !compute(pe, src, &pe->pingPong[writeIdx])) {
+          RenderPass(pe, src, &pe->pingPong[writeIdx], *entry.shader,
+                     entry.setup);
+        }
       }
+      ProfilerEndScope(profiler);
+      EffectDescriptorRestoreQuality(&pe->effects, effectType, savedQuality,
+                                     qualityCount);
       src = &pe->pingPong[writeIdx];
       writeIdx = 1 - writeIdx;
     }
@@ -326,6 +514,15 @@ void RenderPipelineApplyOutput(PostEffect *pe, uint64_t globalTick,
   writeIdx = 1 - writeIdx;
 
   RenderPass(pe, src, &pe->pingPong[writeIdx], pe->gammaShader, SetupGamma);
-  RenderUtilsDrawFullscreenQuad(pe->pingPong[writeIdx].texture, pe->screenWidth,
-                                pe->screenHeight);
+
+  // Upscale internal render resolution to the window (bilinear targets)
+  pe->presented = &pe->pingPong[writeIdx];
+  const Rectangle srcRect = {0, 0, (float)pe->screenWidth,
+                             (float)-pe->screenHeight};
+  const Rectangle dstRect = {0, 0, (float)pe->windowWidth,
+                             (float)pe->windowHeight};
+  DrawTexturePro(pe->pingPong[writeIdx].texture, srcRect, dstRect, {0, 0},
+                 0.0f, WHITE);
+
+  ShmOutputPublish(pe->shmOutput, pe->presented->texture);
 }
@@ -29,8 +29,9 @@ void RenderPipelineApplyFeedback(PostEffect *pe, float deltaTime,
                                  const float *fftMagnitude);
 
 // Apply output stage effects and draw to screen
-// Applies trail boost, transforms, FXAA, gamma
+// Applies trail boost, transforms, FXAA, gamma. Records a GPU scope per
+// transform pass when profiler is non-NULL.
 void RenderPipelineApplyOutput(PostEffect *pe, uint64_t globalTick,
-                               float deltaTime);
+                               float deltaTime, Profiler *profiler);
 
 #endif // RENDER_PIPELINE_H
@@ -0,0 +1,120 @@
+#include "render_scale.h"
+#include "profiler.h"
+#include <math.h>
+#include <stddef.h>
+
+// Hysteresis band as fractions of targetMs. Stepping up one notch at the
+// minimum scale costs (0.30/0.25)^2 = 1.44x, so the lower band must sit below
+// 1/1.44 or the controller would step straight back over budget.
+static const float UPPER_BAND = 1.0f;
+static const float LOWER_BAND = 0.65f;
+
+// Drop quickly when over budget, climb slowly when there is headroom
+static const float DOWN_HOLD_S = 0.5f;
+static const float UP_HOLD_S = 2.0f;
+
+// Smoothed zone times lag a resize by roughly 20 frames
+static const float CHANGE_COOLDOWN_S = 1.5f;
+
+static float ClampScale(float scale, float lo, float hi) {
+  if (scale < lo) {
+    return lo;
+  }
+  if (scale > hi) {
+    return hi;
+  }
+  return scale;
+}
+
+static float QuantizeScale(float scale) {
+  return roundf(scale / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+}
+
+static float TotalGpuMs(const Profiler *profiler) {
+  float total = 0.0f;
+  for (int i = 0; i < ZONE_COUNT; i++) {
+    total += profiler->zones[i].smoothedMs;
+  }
+  return total;
+}
+
+void RenderScaleInit(RenderScale *rs) {
+  if (rs == NULL) {
+    return;
+  }
+  *rs = RenderScale{};
+  rs->adaptive = false;
+  rs->fixedScale = 1.0f;
+  rs->targetMs = 1000.0f / 60.0f;
+  rs->minScale = 0.5f;
+  rs->maxScale = RENDER_SCALE_MAX;
+  rs->scale = 1.0f;
+}
+
+// Step count derived from the pixel-count ratio, since fragment cost scales
+// with scale^2. Always moves at least one step.
+static float ScaleDown(const RenderScale *rs, float totalMs) {
+  const float ideal = rs->scale * sqrtf(rs->targetMs / totalMs);
+  float next = floorf(ideal / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+  if (next > rs->scale - RENDER_SCALE_STEP) {
+    next = rs->scale - RENDER_SCALE_STEP;
+  }
+  return next;
+}
+
+float RenderScaleUpdate(RenderScale *rs, const Profiler *profiler,
+                        float deltaTime) {
+  if (rs == NULL) {
+    return 1.0f;
+  }
+
+  const float lo = ClampScale(rs->minScale, RENDER_SCALE_MIN, RENDER_SCALE_MAX);
+  const float hi = ClampScale(rs->maxScale, lo, RENDER_SCALE_MAX);
+
+  if (!rs->adaptive || profiler == NULL || !profiler->enabled) {
+    rs->scale = QuantizeScale(
+        ClampScale(rs->fixedScale, RENDER_SCALE_MIN, RENDER_SCALE_MAX));
+    rs->overBudgetS = 0.0f;
+    rs->underBudgetS = 0.0f;
+    rs->cooldownS = 0.0f;
+    return rs->scale;
+  }
+
+  rs->scale = QuantizeScale(ClampScale(rs->scale, lo, hi));
+  if (rs->cooldownS > 0.0f) {
+    rs->cooldownS -= deltaTime;
+    return rs->scale;
+  }
+
+  const float totalMs = TotalGpuMs(profiler);
+  if (totalMs <= 0.0f) {
+    return rs->scale;
+  }
+
+  if (totalMs > rs->targetMs * UPPER_BAND) {
+    rs->overBudgetS += deltaTime;
+    rs->underBudgetS = 0.0f;
+  } else if (totalMs < rs->targetMs * LOWER_BAND) {
+    rs->underBudgetS += deltaTime;
+    rs->overBudgetS = 0.0f;
+  } else {
+    rs->overBudgetS = 0.0f;
+    rs->underBudgetS = 0.0f;
+  }
+
+  float next = rs->scale;
+  if (rs->overBudgetS >= DOWN_HOLD_S) {
+    next = ScaleDown(rs, totalMs);
+  } else if (rs->underBudgetS >= UP_HOLD_S) {
+    next = rs->scale + RENDER_SCALE_STEP;
+  }
+
+  next = QuantizeScale(ClampScale(next, lo, hi));
+  if (next != rs->scale) {
+    rs->scale = next;
+    rs->overBudgetS = 0.0f;
+    rs->underBudgetS = 0.0f;
+    rs->cooldownS = CHANGE_COOLDOWN_S;
+  }
+  return rs->scale;
+}
@@ -0,0 +1,36 @@
+#ifndef RENDER_SCALE_H
+#define RENDER_SCALE_H
+
+#include <stdbool.h>
+
+typedef struct Profiler Profiler;
+
+// Render scale bounds and quantization. Steps keep the controller from
+// reallocating render targets for sub-percent changes.
+#define RENDER_SCALE_MIN 0.25f
+#define RENDER_SCALE_MAX 1.0f
+#define RENDER_SCALE_STEP 0.05f
+
+// Internal render resolution as a fraction of the window, either fixed or
+// driven by GPU frame time from the profiler
+typedef struct RenderScale {
+  bool adaptive;      // Follow targetMs instead of fixedScale
+  float fixedScale;   // Scale used when not adaptive (0.25-1.0)
+  float targetMs;     // GPU frame-time budget for adaptive mode
+  float minScale;     // Adaptive lower bound (0.25-1.0)
+  float maxScale;     // Adaptive upper bound (0.25-1.0)
+  float scale;        // Current scale, quantized to RENDER_SCALE_STEP
+  float overBudgetS;  // Seconds spent above the upper hysteresis band
+  float underBudgetS; // Seconds spent below the lower hysteresis band
+  float cooldownS;    // Seconds until the next adaptive change is allowed
+} RenderScale;
+
+// Defaults to fixed 1.0 scale with a 60 fps budget for adaptive mode
+void RenderScaleInit(RenderScale *rs);
+
+// Advance the controller and return the scale to render at this frame.
+// Reads smoothed zone times from previous frames; call before rendering.
+float RenderScaleUpdate(RenderScale *rs, const Profiler *profiler,
+                        float deltaTime);
+
+#endif // RENDER_SCALE_H
@@ -1,31 +1,38 @@
 #include "render_utils.h"
+#include "external/glad.h"
 #include "rlgl.h"
 #include <stddef.h>
 
 void RenderUtilsInitTextureHDR(RenderTexture2D *tex, int width, int height,
                                const char *logPrefix) {
+  RenderUtilsInitTextureFormat(tex, width, height,
+                               RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32,
+                               logPrefix);
+}
+
+void RenderUtilsInitTextureFormat(RenderTexture2D *tex, int width, int height,
+                                  int format, const char *logPrefix) {
   tex->id = rlLoadFramebuffer();
   if (tex->id == 0) {
-    TraceLog(LOG_WARNING, "%s: Failed to create HDR framebuffer", logPrefix);
+    TraceLog(LOG_WARNING, "%s: Failed to create framebuffer", logPrefix);
     return;
   }
 
   rlEnableFramebuffer(tex->id);
 
-  tex->texture.id = rlLoadTexture(NULL, width, height,
-                                  RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, 1);
+  tex->texture.id = rlLoadTexture(NULL, width, height, format, 1);
   tex->texture.width = width;
   tex->texture.height = height;
   tex->texture.mipmaps = 1;
-  tex->texture.format = RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32;
+  tex->texture.format = format;
 
   rlFramebufferAttach(tex->id, tex->texture.id, RL_ATTACHMENT_COLOR_CHANNEL0,
                       RL_ATTACHMENT_TEXTURE2D, 0);
 
   if (!rlFramebufferComplete(tex->id)) {
     TraceLog(LOG_WARNING,
-             "%s: HDR framebuffer incomplete, falling back to standard",
-             logPrefix);
+             "%s: Framebuffer format %d incomplete, falling back to RGBA8",
+             logPrefix, format);
     rlUnloadFramebuffer(tex->id);
     rlUnloadTexture(tex->texture.id);
     *tex = LoadRenderTexture(width, height);
@@ -52,3 +59,18 @@ void RenderUtilsClearTexture(const RenderTexture2D *tex) {
   ClearBackground(BLACK);
   EndTextureMode();
 }
+
+void RenderUtilsResampleTexture(const RenderTexture2D *src,
+                                const RenderTexture2D *dst) {
+  if (src->id == 0 || dst->id == 0) {
+    return;
+  }
+
+  rlDrawRenderBatchActive();
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, src->id);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, dst->id);
+  glBlitFramebuffer(0, 0, src->texture.width, src->texture.height, 0, 0,
+                    dst->texture.width, dst->texture.height,
+                    GL_COLOR_BUFFER_BIT, GL_LINEAR);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
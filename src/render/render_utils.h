@@ -7,6 +7,10 @@
 void RenderUtilsInitTextureHDR(RenderTexture2D *tex, int width, int height,
                                const char *logPrefix);
 
+// Render texture with an explicit raylib PixelFormat color attachment
+void RenderUtilsInitTextureFormat(RenderTexture2D *tex, int width, int height,
+                                  int format, const char *logPrefix);
+
 // Draw texture as fullscreen quad with flipped Y for raylib render textures
 void RenderUtilsDrawFullscreenQuad(const Texture2D &texture, int width,
                                    int height);
@@ -14,4 +18,9 @@ void RenderUtilsDrawFullscreenQuad(const Texture2D &texture, int width,
 // Clear a render texture to black
 void RenderUtilsClearTexture(const RenderTexture2D *tex);
 
+// Copy src into dst with bilinear scaling. All four channels are copied
+// unblended, so simulation state stored in alpha survives.
+void RenderUtilsResampleTexture(const RenderTexture2D *src,
+                                const RenderTexture2D *dst);
+
 #endif // RENDER_UTILS_H
@@ -0,0 +1,372 @@
+#include "replay.h"
+#include "drawable.h"
+#include "post_effect.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+// Tags each frame record so a truncated or misaligned log fails loudly
+static const uint32_t FRAME_TAG = 0x4D415246u; // "FRAM"
+
+// Unchanged gaps shorter than this are folded into the surrounding diff run;
+// a new run costs 8 header bytes
+static const size_t RUN_MERGE_GAP = 16;
+
+enum FrameFlags {
+  FRAME_FFT = 1u << 0,   // FFT magnitudes changed and follow the audio block
+  FRAME_CLEAR = 1u << 1, // Feedback was cleared (preset load) before render
+};
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  int32_t width;
+  int32_t height;
+  uint32_t seed;
+  // Layout checks; replay requires the recording build's sizes
+  uint32_t imageBytes;
+  uint32_t effectBytes;
+  uint32_t drawableBytes;
+  uint32_t maxDrawables;
+  uint32_t fftBins;
+  uint32_t modSources;
+  uint32_t waveformSize;
+  uint32_t audioChannels;
+};
+
+struct FrameHeader {
+  uint32_t tag;
+  uint32_t flags;
+  float deltaTime;
+  uint32_t audioFrames;
+  double time;
+  float modSources[MOD_SOURCE_COUNT];
+  int32_t waveformWriteIndex;
+  float waveformSample; // Value written just before waveformWriteIndex
+  uint32_t runCount;    // Config diff runs that follow
+};
+
+struct DiffRun {
+  uint32_t offset;
+  uint32_t length;
+};
+
+// Config image layout: EffectConfig | drawables | drawableCount | AudioConfig
+static const size_t DRAWABLES_OFFSET = sizeof(EffectConfig);
+static const size_t COUNT_OFFSET =
+    DRAWABLES_OFFSET + sizeof(Drawable) * MAX_DRAWABLES;
+static const size_t AUDIO_OFFSET = COUNT_OFFSET + sizeof(int32_t);
+static const size_t IMAGE_BYTES = AUDIO_OFFSET + sizeof(AudioConfig);
+
+struct ReplayRecorder {
+  FILE *file;
+  std::vector<unsigned char> prev; // Image written with the last frame
+  std::vector<unsigned char> cur;
+  std::vector<DiffRun> runs;
+  float prevFft[FFT_BIN_COUNT];
+  uint32_t feedbackClears;
+  uint64_t frames;
+  uint64_t bytes;
+};
+
+struct ReplayPlayer {
+  FILE *file;
+  FileHeader header;
+  std::vector<unsigned char> image;
+  uint64_t frames;
+};
+
+static void GatherImage(const ReplayBinding *b, unsigned char *image) {
+  const int32_t count = *b->drawableCount;
+  memcpy(image, (const void *)b->effects, sizeof(EffectConfig));
+  memcpy(image + DRAWABLES_OFFSET, (const void *)b->drawables,
+         sizeof(Drawable) * MAX_DRAWABLES);
+  memcpy(image + COUNT_OFFSET, &count, sizeof(count));
+  memcpy(image + AUDIO_OFFSET, (const void *)b->audio, sizeof(AudioConfig));
+}
+
+static void ScatterImage(const unsigned char *image, const ReplayBinding *b) {
+  int32_t count = 0;
+  memcpy((void *)b->effects, image, sizeof(EffectConfig));
+  memcpy((void *)b->drawables, image + DRAWABLES_OFFSET,
+         sizeof(Drawable) * MAX_DRAWABLES);
+  memcpy(&count, image + COUNT_OFFSET, sizeof(count));
+  memcpy((void *)b->audio, image + AUDIO_OFFSET, sizeof(AudioConfig));
+  if (count < 0 || count > MAX_DRAWABLES) {
+    count = 0;
+  }
+  *b->drawableCount = count;
+}
+
+// Byte runs where cur differs from prev, with short equal gaps merged
+static void DiffImages(const unsigned char *prev, const unsigned char *cur,
+                       size_t size, std::vector<DiffRun> *runs) {
+  runs->clear();
+  size_t i = 0;
+  while (i < size) {
+    if (prev[i] == cur[i]) {
+      i++;
+      continue;
+    }
+    const size_t start = i;
+    size_t end = i + 1;
+    for (size_t j = end; j < size && j - end < RUN_MERGE_GAP; j++) {
+      if (prev[j] != cur[j]) {
+        end = j + 1;
+      }
+    }
+    runs->push_back(DiffRun{(uint32_t)start, (uint32_t)(end - start)});
+    i = end;
+  }
+}
+
+static void SeedAndClear(uint32_t seed, PostEffect *pe) {
+  srand(seed);
+  SetRandomSeed(seed);
+  PostEffectReseed(pe);
+}
+
+static bool WriteBytes(ReplayRecorder *rec, const void *data, size_t size) {
+  rec->bytes += size;
+  return fwrite(data, 1, size, rec->file) == size;
+}
+
+static bool ReadBytes(ReplayPlayer *player, void *data, size_t size) {
+  return fread(data, 1, size, player->file) == size;
+}
+
+ReplayRecorder *ReplayRecorderOpen(const char *path,
+                                   const ReplayBinding *binding) {
+  FILE *file = fopen(path, "wb");
+  if (file == NULL) {
+    TraceLog(LOG_ERROR, "REPLAY: Cannot create %s", path);
+    return NULL;
+  }
+
+  ReplayRecorder *rec = new ReplayRecorder{};
+  rec->file = file;
+  rec->prev.resize(IMAGE_BYTES);
+  rec->cur.resize(IMAGE_BYTES);
+
+  FileHeader header = {};
+  header.magic = REPLAY_MAGIC;
+  header.version = REPLAY_VERSION;
+  header.width = binding->postEffect->screenWidth;
+  header.height = binding->postEffect->screenHeight;
+  header.seed = (uint32_t)time(NULL);
+  header.imageBytes = (uint32_t)IMAGE_BYTES;
+  header.effectBytes = (uint32_t)sizeof(EffectConfig);
+  header.drawableBytes = (uint32_t)sizeof(Drawable);
+  header.maxDrawables = MAX_DRAWABLES;
+  header.fftBins = FFT_BIN_COUNT;
+  header.modSources = MOD_SOURCE_COUNT;
+  header.waveformSize = WAVEFORM_HISTORY_SIZE;
+  header.audioChannels = AUDIO_CHANNELS;
+
+  SeedAndClear(header.seed, binding->postEffect);
+  rec->feedbackClears = binding->postEffect->feedbackClears;
+
+  // Starting state: full config image plus analysis history
+  const AnalysisPipeline *analysis = binding->analysis;
+  const int32_t writeIndex = analysis->waveformWriteIndex;
+  GatherImage(binding, rec->prev.data());
+  memcpy(rec->prevFft, analysis->fft.magnitude, sizeof(rec->prevFft));
+  const bool ok =
+      WriteBytes(rec, &header, sizeof(header)) &&
+      WriteBytes(rec, rec->prev.data(), IMAGE_BYTES) &&
+      WriteBytes(rec, analysis->waveformHistory,
+                 sizeof(analysis->waveformHistory)) &&
+      WriteBytes(rec, &writeIndex, sizeof(writeIndex)) &&
+      WriteBytes(rec, rec->prevFft, sizeof(rec->prevFft));
+  if (!ok) {
+    TraceLog(LOG_ERROR, "REPLAY: Failed to write %s", path);
+    ReplayRecorderClose(rec);
+    return NULL;
+  }
+
+  TraceLog(LOG_INFO, "REPLAY: Recording %dx%d to %s", header.width,
+           header.height, path);
+  return rec;
+}
+
+bool ReplayRecorderWrite(ReplayRecorder *rec, const ReplayBinding *binding,
+                         float deltaTime, double time) {
+  if (rec == NULL) {
+    return false;
+  }
+  const AnalysisPipeline *analysis = binding->analysis;
+
+  FrameHeader frame = {};
+  frame.tag = FRAME_TAG;
+  frame.deltaTime = deltaTime;
+  frame.audioFrames = analysis->lastFramesRead;
+  frame.time = time;
+  memcpy(frame.modSources, binding->modSources->values,
+         sizeof(frame.modSources));
+  frame.waveformWriteIndex = analysis->waveformWriteIndex;
+  frame.waveformSample =
+      analysis->waveformHistory[(analysis->waveformWriteIndex +
+                                 WAVEFORM_HISTORY_SIZE - 1) %
+                                WAVEFORM_HISTORY_SIZE];
+
+  // FFT only advances when a full hop has arrived
+  if (memcmp(rec->prevFft, analysis->fft.magnitude, sizeof(rec->prevFft)) !=
+      0) {
+    frame.flags |= FRAME_FFT;
+    memcpy(rec->prevFft, analysis->fft.magnitude, sizeof(rec->prevFft));
+  }
+  if (binding->postEffect->feedbackClears != rec->feedbackClears) {
+    frame.flags |= FRAME_CLEAR;
+    rec->feedbackClears = binding->postEffect->feedbackClears;
+  }
+
+  GatherImage(binding, rec->cur.data());
+  DiffImages(rec->prev.data(), rec->cur.data(), IMAGE_BYTES, &rec->runs);
+  frame.runCount = (uint32_t)rec->runs.size();
+
+  bool ok = WriteBytes(rec, &frame, sizeof(frame)) &&
+            WriteBytes(rec, analysis->audioBuffer,
+                       sizeof(float) * AUDIO_CHANNELS * frame.audioFrames);
+  if (ok && (frame.flags & FRAME_FFT) != 0) {
+    ok = WriteBytes(rec, rec->prevFft, sizeof(rec->prevFft));
+  }
+  for (size_t i = 0; ok && i < rec->runs.size(); i++) {
+    const DiffRun &run = rec->runs[i];
+    ok = WriteBytes(rec, &run, sizeof(run)) &&
+         WriteBytes(rec, rec->cur.data() + run.offset, run.length);
+  }
+
+  rec->prev.swap(rec->cur);
+  rec->frames++;
+  return ok;
+}
+
+void ReplayRecorderClose(ReplayRecorder *rec) {
+  if (rec == NULL) {
+    return;
+  }
+  // NOLINTNEXTLINE(cert-err33-c) - nothing to recover at shutdown
+  fclose(rec->file);
+  TraceLog(LOG_INFO, "REPLAY: Stopped, %llu frames, %.1f MB",
+           (unsigned long long)rec->frames,
+           (double)rec->bytes / (1024.0 * 1024.0));
+  delete rec;
+}
+
+ReplayPlayer *ReplayPlayerOpen(const char *path, ReplayInfo *info) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    TraceLog(LOG_ERROR, "REPLAY: Cannot open %s", path);
+    return NULL;
+  }
+
+  ReplayPlayer *player = new ReplayPlayer{};
+  player->file = file;
+  const FileHeader &h = player->header;
+  if (!ReadBytes(player, &player->header, sizeof(player->header)) ||
+      h.magic != REPLAY_MAGIC || h.version != REPLAY_VERSION) {
+    TraceLog(LOG_ERROR, "REPLAY: %s is not a replay log", path);
+    ReplayPlayerClose(player);
+    return NULL;
+  }
+  if (h.imageBytes != IMAGE_BYTES || h.effectBytes != sizeof(EffectConfig) ||
+      h.drawableBytes != sizeof(Drawable) || h.maxDrawables != MAX_DRAWABLES ||
+      h.fftBins != FFT_BIN_COUNT || h.modSources != MOD_SOURCE_COUNT ||
+      h.waveformSize != WAVEFORM_HISTORY_SIZE ||
+      h.audioChannels != AUDIO_CHANNELS) {
+    TraceLog(LOG_ERROR, "REPLAY: %s was recorded by an incompatible build",
+             path);
+    ReplayPlayerClose(player);
+    return NULL;
+  }
+
+  player->image.resize(IMAGE_BYTES);
+  info->width = h.width;
+  info->height = h.height;
+  info->seed = h.seed;
+  return player;
+}
+
+bool ReplayPlayerBegin(ReplayPlayer *player, const ReplayBinding *binding) {
+  AnalysisPipeline *analysis = binding->analysis;
+  int32_t writeIndex = 0;
+  if (!ReadBytes(player, player->image.data(), IMAGE_BYTES) ||
+      !ReadBytes(player, analysis->waveformHistory,
+                 sizeof(analysis->waveformHistory)) ||
+      !ReadBytes(player, &writeIndex, sizeof(writeIndex)) ||
+      !ReadBytes(player, analysis->fft.magnitude,
+                 sizeof(analysis->fft.magnitude))) {
+    TraceLog(LOG_ERROR, "REPLAY: Truncated starting state");
+    return false;
+  }
+  analysis->waveformWriteIndex = writeIndex;
+  ScatterImage(player->image.data(), binding);
+  SeedAndClear(player->header.seed, binding->postEffect);
+  return true;
+}
+
+ReplayReadResult ReplayPlayerNext(ReplayPlayer *player,
+                                  const ReplayBinding *binding,
+                                  float *deltaTime, double *time) {
+  FrameHeader frame;
+  const size_t got = fread(&frame, 1, sizeof(frame), player->file);
+  if (got == 0 && feof(player->file)) {
+    return REPLAY_READ_END;
+  }
+  if (got != sizeof(frame) || frame.tag != FRAME_TAG ||
+      frame.audioFrames > AUDIO_MAX_FRAMES_PER_UPDATE ||
+      frame.waveformWriteIndex < 0 ||
+      frame.waveformWriteIndex >= WAVEFORM_HISTORY_SIZE) {
+    TraceLog(LOG_ERROR, "REPLAY: Corrupt frame %llu",
+             (unsigned long long)player->frames);
+    return REPLAY_READ_ERROR;
+  }
+
+  AnalysisPipeline *analysis = binding->analysis;
+  bool ok = ReadBytes(player, analysis->audioBuffer,
+                      sizeof(float) * AUDIO_CHANNELS * frame.audioFrames);
+  if (ok && (frame.flags & FRAME_FFT) != 0) {
+    ok = ReadBytes(player, analysis->fft.magnitude,
+                   sizeof(analysis->fft.magnitude));
+  }
+  for (uint32_t i = 0; ok && i < frame.runCount; i++) {
+    DiffRun run;
+    ok = ReadBytes(player, &run, sizeof(run)) && run.offset <= IMAGE_BYTES &&
+         run.length <= IMAGE_BYTES - run.offset &&
+         ReadBytes(player, player->image.data() + run.offset, run.length);
+  }
+  if (!ok) {
+    TraceLog(LOG_ERROR, "REPLAY: Truncated frame %llu",
+             (unsigned long long)player->frames);
+    return REPLAY_READ_ERROR;
+  }
+
+  analysis->lastFramesRead = frame.audioFrames;
+  analysis->waveformWriteIndex = frame.waveformWriteIndex;
+  analysis->waveformHistory[(frame.waveformWriteIndex + WAVEFORM_HISTORY_SIZE -
+                             1) %
+                            WAVEFORM_HISTORY_SIZE] = frame.waveformSample;
+  memcpy(binding->modSources->values, frame.modSources,
+         sizeof(frame.modSources));
+  ScatterImage(player->image.data(), binding);
+  if ((frame.flags & FRAME_CLEAR) != 0) {
+    PostEffectClearFeedback(binding->postEffect);
+  }
+
+  *deltaTime = frame.deltaTime;
+  *time = frame.time;
+  player->frames++;
+  return REPLAY_READ_FRAME;
+}
+
+void ReplayPlayerClose(ReplayPlayer *player) {
+  if (player == NULL) {
+    return;
+  }
+  // NOLINTNEXTLINE(cert-err33-c) - read-only stream
+  fclose(player->file);
+  delete player;
+}
@@ -0,0 +1,80 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "analysis/analysis_pipeline.h"
+#include "audio/audio_config.h"
+#include "automation/mod_sources.h"
+#include "config/drawable_config.h"
+#include "config/effect_config.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Deterministic replay log. A recording holds, per frame, every input the
+// render path consumes: deltaTime and time, ModSources values, the analysis
+// audio block and FFT magnitudes, the waveform history write, and the
+// effect/drawable/audio config as the renderer saw it. Config is captured
+// after modulation, so UI edits and modulation both land in it, stored as
+// byte-range diffs against the previous frame.
+//
+// Replay feeds those inputs straight to the render path, skipping live
+// analysis and modulation, so every replay of a log sees bit-identical
+// inputs. Both sides start from a cleared pipeline with seeded RNGs. Logs
+// are tied to the build's config layout; a build whose EffectConfig or
+// Drawable size differs rejects them.
+
+#define REPLAY_MAGIC 0x50524A41u // "AJRP"
+#define REPLAY_VERSION 1
+
+typedef struct PostEffect PostEffect;
+
+// Render state the log reads from (recording) or writes to (replay)
+typedef struct ReplayBinding {
+  EffectConfig *effects;
+  Drawable *drawables; // MAX_DRAWABLES entries
+  int *drawableCount;
+  AudioConfig *audio;
+  ModSources *modSources;
+  AnalysisPipeline *analysis;
+  PostEffect *postEffect;
+} ReplayBinding;
+
+typedef struct ReplayInfo {
+  int width; // Internal render resolution at record time
+  int height;
+  uint32_t seed;
+} ReplayInfo;
+
+typedef enum ReplayReadResult {
+  REPLAY_READ_FRAME = 0,
+  REPLAY_READ_END,   // Clean end of log
+  REPLAY_READ_ERROR, // Truncated or corrupt frame
+} ReplayReadResult;
+
+typedef struct ReplayRecorder ReplayRecorder;
+typedef struct ReplayPlayer ReplayPlayer;
+
+// Create path, seed the RNGs, clear feedback, and write the starting state.
+// Returns NULL on failure.
+ReplayRecorder *ReplayRecorderOpen(const char *path,
+                                   const ReplayBinding *binding);
+
+// Append one frame. Call after modulation, right before rendering it.
+bool ReplayRecorderWrite(ReplayRecorder *rec, const ReplayBinding *binding,
+                         float deltaTime, double time);
+
+void ReplayRecorderClose(ReplayRecorder *rec);
+
+// Validate the header; info receives the recorded size and seed
+ReplayPlayer *ReplayPlayerOpen(const char *path, ReplayInfo *info);
+
+// Seed the RNGs, clear feedback, and load the starting state into binding
+bool ReplayPlayerBegin(ReplayPlayer *player, const ReplayBinding *binding);
+
+// Load the next frame's inputs into binding
+ReplayReadResult ReplayPlayerNext(ReplayPlayer *player,
+                                  const ReplayBinding *binding,
+                                  float *deltaTime, double *time);
+
+void ReplayPlayerClose(ReplayPlayer *player);
+
+#endif // REPLAY_H
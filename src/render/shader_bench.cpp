@@ -0,0 +1,607 @@
+#include "shader_bench.h"
+#include "config/effect_descriptor.h"
+#include "external/glad.h"
+#include "rlgl.h"
+#include "simulation/attractor_flow.h"
+#include "simulation/particle_life.h"
+#include "simulation/sim_cpu.h"
+#include "simulation/spatial_hash.h"
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <stddef.h>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using json = nlohmann::json;
+
+// Regressions smaller than this are timer noise, whatever the ratio
+static const float MIN_REGRESSION_MS = 0.05f;
+
+// Effects whose fast path (tiled compute, agent cell sort) can be switched
+// off for an A/B pair
+struct ComputeToggle {
+  TransformEffectType type;
+  size_t offset;    // bool within EffectConfig
+  const char *name; // Variant with the fast path off
+  int agentCount;   // Agent count for the pair, 0 = default
+};
+
+static const ComputeToggle COMPUTE_TOGGLES[] = {
+    {TRANSFORM_KUWAHARA, offsetof(EffectConfig, kuwahara.tiledCompute),
+     "fragment", 0},
+    {TRANSFORM_BILATERAL, offsetof(EffectConfig, bilateral.tiledCompute),
+     "fragment", 0},
+    {TRANSFORM_DOG_FILTER, offsetof(EffectConfig, dogFilter.tiledCompute),
+     "fragment", 0},
+    {TRANSFORM_PHYSARUM, offsetof(EffectConfig, physarum.cellSort), "unsorted",
+     0},
+    {TRANSFORM_CURL_FLOW, offsetof(EffectConfig, curlFlow.cellSort),
+     "unsorted", 0},
+    // Pairs with the "100k agents" sweep step
+    {TRANSFORM_BOIDS, offsetof(EffectConfig, boids.cellSort),
+     "unsorted 100k agents", 100000},
+};
+
+// Simulations whose neighbor search should scale with agent count
+struct AgentSweep {
+  TransformEffectType type;
+  size_t offset; // int within EffectConfig
+};
+
+static const AgentSweep AGENT_SWEEPS[SHADER_BENCH_AGENT_SWEEPS] = {
+    {TRANSFORM_PARTICLE_LIFE, offsetof(EffectConfig, particleLife.agentCount)},
+    {TRANSFORM_BOIDS, offsetof(EffectConfig, boids.agentCount)},
+    {TRANSFORM_PHYSARUM, offsetof(EffectConfig, physarum.agentCount)},
+    {TRANSFORM_CURL_FLOW, offsetof(EffectConfig, curlFlow.agentCount)},
+};
+
+// Tiled-compute filters timed at several kernel sizes on both paths; the
+// compute path's shared-memory apron grows with the radius
+struct RadiusSweep {
+  TransformEffectType type;
+  size_t offset; // float within EffectConfig
+  struct {
+    float value;
+    const char *name;         // Tiled compute
+    const char *fragmentName; // Fast path off
+  } steps[SHADER_BENCH_RADIUS_SWEEP_STEPS];
+};
+
+static const RadiusSweep RADIUS_SWEEPS[SHADER_BENCH_RADIUS_SWEEPS] = {
+    {TRANSFORM_KUWAHARA,
+     offsetof(EffectConfig, kuwahara.radius),
+     {{2.0f, "radius 2", "fragment radius 2"},
+      {4.0f, "radius 4", "fragment radius 4"},
+      {8.0f, "radius 8", "fragment radius 8"},
+      {12.0f, "radius 12", "fragment radius 12"}}},
+    {TRANSFORM_BILATERAL,
+     offsetof(EffectConfig, bilateral.spatialSigma),
+     {{1.0f, "sigma 1", "fragment sigma 1"},
+      {2.0f, "sigma 2", "fragment sigma 2"},
+      {4.0f, "sigma 4", "fragment sigma 4"},
+      {8.0f, "sigma 8", "fragment sigma 8"}}},
+    {TRANSFORM_DOG_FILTER,
+     offsetof(EffectConfig, dogFilter.sigma),
+     {{0.5f, "sigma 0.5", "fragment sigma 0.5"},
+      {1.5f, "sigma 1.5", "fragment sigma 1.5"},
+      {3.0f, "sigma 3", "fragment sigma 3"},
+      {5.0f, "sigma 5", "fragment sigma 5"}}},
+};
+
+static const struct {
+  int count;
+  const char *name;
+} AGENT_SWEEP_STEPS[SHADER_BENCH_AGENT_SWEEP_STEPS] = {
+    {10000, "10k agents"},
+    {100000, "100k agents"},
+    {200000, "200k agents"},
+    {500000, "500k agents"},
+};
+
+// Spatial hash build sweep: unit cells, so each grid is also the position
+// range; agents spread uniformly over it
+static const int HASH_BENCH_AGENTS = 100000;
+
+static const struct {
+  int width;
+  int height;
+} HASH_BENCH_GRIDS[] = {
+    {32, 32}, {100, 100}, {320, 320}, {1000, 1000}, {2000, 2000},
+};
+
+// CPU simulation backend sweep: each agent count at each thread count up to
+// the hardware's, so rows show per-agent cost and how far the pool scales
+static const int CPU_BENCH_THREADS[] = {1, 2, 4, 8, 16};
+static const int CPU_BENCH_AGENTS[] = {10000, 100000};
+static const char *const CPU_BENCH_NAMES[][2] = {
+    {"1 thread 10k agents", "1 thread 100k agents"},
+    {"2 threads 10k agents", "2 threads 100k agents"},
+    {"4 threads 10k agents", "4 threads 100k agents"},
+    {"8 threads 10k agents", "8 threads 100k agents"},
+    {"16 threads 10k agents", "16 threads 100k agents"},
+};
+
+struct ShaderBenchReport {
+  int frames;
+  std::vector<ShaderBenchResult> results;
+};
+
+static const ComputeToggle *FindComputeToggle(TransformEffectType type) {
+  for (const ComputeToggle &toggle : COMPUTE_TOGGLES) {
+    if (toggle.type == type) {
+      return &toggle;
+    }
+  }
+  return NULL;
+}
+
+static const AgentSweep *FindAgentSweep(TransformEffectType type) {
+  for (const AgentSweep &sweep : AGENT_SWEEPS) {
+    if (sweep.type == type) {
+      return &sweep;
+    }
+  }
+  return NULL;
+}
+
+static const RadiusSweep *FindRadiusSweep(TransformEffectType type) {
+  for (const RadiusSweep &sweep : RADIUS_SWEEPS) {
+    if (sweep.type == type) {
+      return &sweep;
+    }
+  }
+  return NULL;
+}
+
+static bool AddVariant(ShaderBenchVariant *variants, int maxVariants,
+                       int *count, TransformEffectType type, const char *name,
+                       EffectResolutionTier tier, bool fragmentOnly,
+                       int agentCount = 0, float radius = 0.0f) {
+  if (*count >= maxVariants) {
+    return false;
+  }
+  variants[(*count)++] = ShaderBenchVariant{
+      type, name, tier, fragmentOnly, agentCount, NULL, radius};
+  return true;
+}
+
+int ShaderBenchListVariants(ShaderBenchVariant *variants, int maxVariants) {
+  int count = 0;
+  AddVariant(variants, maxVariants, &count, TRANSFORM_EFFECT_COUNT,
+             "baseline", RES_TIER_DEFAULT, false);
+
+  const EffectConfig defaults = EffectConfig{};
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    const TransformEffectType type = (TransformEffectType)i;
+    if (EFFECT_DESCRIPTORS[type].name == NULL) {
+      continue;
+    }
+    AddVariant(variants, maxVariants, &count, type, "default",
+               RES_TIER_DEFAULT, false);
+
+    // The opposite tier gives the cost model its full vs half ratio
+    if (EffectDescriptorSupportsTiers(type)) {
+      if (EffectDescriptorResolutionTier(&defaults, type) == RES_TIER_HALF) {
+        AddVariant(variants, maxVariants, &count, type, "full", RES_TIER_FULL,
+                   false);
+      } else {
+        AddVariant(variants, maxVariants, &count, type, "half", RES_TIER_HALF,
+                   false);
+      }
+    }
+    const ComputeToggle *toggle = FindComputeToggle(type);
+    if (toggle != NULL) {
+      AddVariant(variants, maxVariants, &count, type, toggle->name,
+                 RES_TIER_DEFAULT, true, toggle->agentCount);
+    }
+    if (FindAgentSweep(type) != NULL) {
+      for (const auto &step : AGENT_SWEEP_STEPS) {
+        AddVariant(variants, maxVariants, &count, type, step.name,
+                   RES_TIER_DEFAULT, false, step.count);
+      }
+    }
+    const RadiusSweep *radiusSweep = FindRadiusSweep(type);
+    if (radiusSweep != NULL) {
+      for (const auto &step : radiusSweep->steps) {
+        AddVariant(variants, maxVariants, &count, type, step.name,
+                   RES_TIER_DEFAULT, false, 0, step.value);
+        AddVariant(variants, maxVariants, &count, type, step.fragmentName,
+                   RES_TIER_DEFAULT, true, 0, step.value);
+      }
+    }
+  }
+  return count;
+}
+
+void ShaderBenchApplyVariant(EffectConfig *cfg,
+                             const ShaderBenchVariant *variant) {
+  *cfg = EffectConfig{};
+  const TransformEffectType type = variant->type;
+  if (type < 0 || type >= TRANSFORM_EFFECT_COUNT) {
+    return;
+  }
+  char *base = reinterpret_cast<char *>(cfg);
+  *reinterpret_cast<bool *>(base + EFFECT_DESCRIPTORS[type].enabledOffset) =
+      true;
+  cfg->resolutionTier[type] = variant->tier;
+
+  const ComputeToggle *toggle = FindComputeToggle(type);
+  if (variant->fragmentOnly && toggle != NULL) {
+    *reinterpret_cast<bool *>(base + toggle->offset) = false;
+  }
+
+  const AgentSweep *sweep = FindAgentSweep(type);
+  if (variant->agentCount > 0 && sweep != NULL) {
+    *reinterpret_cast<int *>(base + sweep->offset) = variant->agentCount;
+  }
+
+  const RadiusSweep *radiusSweep = FindRadiusSweep(type);
+  if (variant->radius > 0.0f && radiusSweep != NULL) {
+    *reinterpret_cast<float *>(base + radiusSweep->offset) = variant->radius;
+  }
+}
+
+static ShaderBenchResult BenchSpatialHashGrid(int width, int height,
+                                              const float *positions,
+                                              int frames) {
+  ShaderBenchResult result = {};
+  result.variant = ShaderBenchVariant{TRANSFORM_EFFECT_COUNT, "100k agents",
+                                      RES_TIER_DEFAULT, false, 0,
+                                      "Spatial Hash"};
+  result.width = width;
+  result.height = height;
+
+  SpatialHash *sh = SpatialHashInit(HASH_BENCH_AGENTS, 1.0f, width, height);
+  const unsigned int buffer = rlLoadShaderBuffer(
+      HASH_BENCH_AGENTS * 2 * sizeof(float), positions, RL_DYNAMIC_COPY);
+  if (sh == NULL || buffer == 0) {
+    rlUnloadShaderBuffer(buffer);
+    SpatialHashUninit(sh);
+    return result;
+  }
+
+  GLuint query = 0;
+  glGenQueries(1, &query);
+  std::vector<float> gpuMs;
+  for (int f = 0; f < SHADER_BENCH_WARMUP_FRAMES + frames; f++) {
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    SpatialHashBuild(sh, buffer, HASH_BENCH_AGENTS, 2 * sizeof(float), 0);
+    glEndQuery(GL_TIME_ELAPSED);
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+    if (f >= SHADER_BENCH_WARMUP_FRAMES) {
+      gpuMs.push_back((float)((double)ns / 1.0e6));
+      result.gpuMaxMs = std::max(result.gpuMaxMs, gpuMs.back());
+    }
+  }
+  glDeleteQueries(1, &query);
+
+  result.samples = (int)gpuMs.size();
+  result.gpuMs = ShaderBenchMedian(gpuMs.data(), (int)gpuMs.size());
+  result.frameMs = result.gpuMs;
+  rlUnloadShaderBuffer(buffer);
+  SpatialHashUninit(sh);
+  return result;
+}
+
+int ShaderBenchSpatialHash(ShaderBenchReport *report, int frames) {
+  std::vector<float> positions(HASH_BENCH_AGENTS * 2);
+  int added = 0;
+  for (const auto &grid : HASH_BENCH_GRIDS) {
+    uint32_t state = 1;
+    for (int i = 0; i < HASH_BENCH_AGENTS; i++) {
+      state = state * 1664525u + 1013904223u;
+      positions[i * 2] = (float)(state >> 8) / 16777216.0f * (float)grid.width;
+      state = state * 1664525u + 1013904223u;
+      positions[i * 2 + 1] =
+          (float)(state >> 8) / 16777216.0f * (float)grid.height;
+    }
+
+    const ShaderBenchResult result =
+        BenchSpatialHashGrid(grid.width, grid.height, positions.data(), frames);
+    if (result.samples == 0) {
+      continue;
+    }
+    ShaderBenchReportAdd(report, &result);
+    TraceLog(LOG_INFO, "SHADER_BENCH: Spatial hash %dx%d grid %.3f ms GPU",
+             grid.width, grid.height, result.gpuMs);
+    added++;
+  }
+  return added;
+}
+
+// Wall time of one CPU-backend simulation frame: agent step, trail
+// diffusion and the trail upload, GPU finished
+template <typename Sim, typename Config>
+static ShaderBenchResult
+BenchCpuSim(Sim *(*init)(int, int, const Config *),
+            void (*update)(Sim *, float),
+            void (*processTrails)(const Sim *, float), void (*uninit)(Sim *),
+            const Config *config, int width, int height, int frames) {
+  ShaderBenchResult result = {};
+  result.width = width;
+  result.height = height;
+
+  Sim *sim = init(width, height, config);
+  if (sim == NULL) {
+    return result;
+  }
+
+  const float deltaTime = 1.0f / 60.0f;
+  std::vector<float> frameMs;
+  for (int f = 0; f < SHADER_BENCH_WARMUP_FRAMES + frames; f++) {
+    const double startS = GetTime();
+    update(sim, deltaTime);
+    processTrails(sim, deltaTime);
+    ShaderBenchFinishFrame();
+    const float ms = (float)((GetTime() - startS) * 1000.0);
+    if (f >= SHADER_BENCH_WARMUP_FRAMES) {
+      frameMs.push_back(ms);
+      result.gpuMaxMs = std::max(result.gpuMaxMs, ms);
+    }
+  }
+  uninit(sim);
+
+  result.samples = (int)frameMs.size();
+  result.gpuMs = ShaderBenchMedian(frameMs.data(), (int)frameMs.size());
+  result.frameMs = result.gpuMs;
+  return result;
+}
+
+int ShaderBenchCpuSims(ShaderBenchReport *report, int width, int height,
+                       int frames) {
+  const int hardware = (int)std::thread::hardware_concurrency();
+  SimCpuForce(true);
+
+  int added = 0;
+  for (int t = 0; t < (int)(sizeof(CPU_BENCH_THREADS) / sizeof(int)); t++) {
+    const int threads = CPU_BENCH_THREADS[t];
+    if (threads > 1 && threads > hardware) {
+      break;
+    }
+    SimCpuSetThreads(threads);
+
+    for (int a = 0; a < (int)(sizeof(CPU_BENCH_AGENTS) / sizeof(int)); a++) {
+      const int agents = CPU_BENCH_AGENTS[a];
+      ParticleLifeConfig plConfig;
+      plConfig.enabled = true;
+      plConfig.agentCount = agents;
+      AttractorFlowConfig afConfig;
+      afConfig.enabled = true;
+      afConfig.agentCount = agents;
+
+      ShaderBenchResult results[2] = {
+          BenchCpuSim(ParticleLifeInit, ParticleLifeUpdate,
+                      ParticleLifeProcessTrails, ParticleLifeUninit, &plConfig,
+                      width, height, frames),
+          BenchCpuSim(AttractorFlowInit, AttractorFlowUpdate,
+                      AttractorFlowProcessTrails, AttractorFlowUninit,
+                      &afConfig, width, height, frames),
+      };
+      const char *subjects[2] = {"Particle Life (CPU)", "Attractor Flow (CPU)"};
+      for (int i = 0; i < 2; i++) {
+        if (results[i].samples == 0) {
+          continue;
+        }
+        results[i].variant = ShaderBenchVariant{
+            TRANSFORM_EFFECT_COUNT, CPU_BENCH_NAMES[t][a], RES_TIER_DEFAULT,
+            false, agents, subjects[i]};
+        ShaderBenchReportAdd(report, &results[i]);
+        TraceLog(LOG_INFO, "SHADER_BENCH: %s %s %.3f ms wall", subjects[i],
+                 CPU_BENCH_NAMES[t][a], results[i].gpuMs);
+        added++;
+      }
+    }
+  }
+
+  SimCpuSetThreads(0);
+  SimCpuForce(false);
+  return added;
+}
+
+float ShaderBenchSampledMs(const Profiler *profiler) {
+  float total = 0.0f;
+  bool sampled = false;
+  for (int i = 0; i < PROFILER_MAX_SCOPES; i++) {
+    const ProfileScope *scope = &profiler->scopes[i];
+    if (scope->name != NULL && scope->sampleFrame == profiler->frameIndex) {
+      total += scope->lastMs;
+      sampled = true;
+    }
+  }
+  return sampled ? total : -1.0f;
+}
+
+float ShaderBenchZoneMs(const Profiler *profiler) {
+  return profiler->zones[ZONE_FEEDBACK].lastMs +
+         profiler->zones[ZONE_DRAWABLES].lastMs +
+         profiler->zones[ZONE_OUTPUT].lastMs;
+}
+
+void ShaderBenchFinishFrame(void) {
+  rlDrawRenderBatchActive();
+  glFinish();
+}
+
+float ShaderBenchMedian(float *values, int count) {
+  if (count <= 0) {
+    return 0.0f;
+  }
+  std::nth_element(values, values + count / 2, values + count);
+  return values[count / 2];
+}
+
+uint64_t ShaderBenchHashTarget(RenderTexture2D target) {
+  const int width = target.texture.width;
+  const int height = target.texture.height;
+  std::vector<unsigned char> pixels((size_t)width * height * 4);
+
+  rlDrawRenderBatchActive();
+  GLint prevReadFbo = 0;
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, target.id);
+  glReadBuffer(GL_COLOR_ATTACHMENT0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, (GLuint)prevReadFbo);
+
+  // FNV-1a
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const unsigned char byte : pixels) {
+    hash = (hash ^ byte) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+ShaderBenchReport *ShaderBenchReportCreate(int frames) {
+  ShaderBenchReport *report = new ShaderBenchReport();
+  report->frames = frames;
+  return report;
+}
+
+void ShaderBenchReportAdd(ShaderBenchReport *report,
+                          const ShaderBenchResult *result) {
+  if (report != NULL && result != NULL) {
+    report->results.push_back(*result);
+  }
+}
+
+static std::string VariantEffectName(const ShaderBenchVariant &variant) {
+  if (variant.subject != NULL) {
+    return variant.subject;
+  }
+  if (variant.type < 0 || variant.type >= TRANSFORM_EFFECT_COUNT) {
+    return "(none)";
+  }
+  return EFFECT_DESCRIPTORS[variant.type].name;
+}
+
+static std::string HashText(uint64_t hash) {
+  char text[17];
+  // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size hash buffer
+  snprintf(text, sizeof(text), "%016llx", (unsigned long long)hash);
+  return text;
+}
+
+bool ShaderBenchReportWrite(const ShaderBenchReport *report,
+                            const char *path) {
+  const char *renderer =
+      reinterpret_cast<const char *>(glGetString(GL_RENDERER));
+  const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
+
+  json j;
+  j["version"] = 1;
+  j["renderer"] = renderer != NULL ? renderer : "";
+  j["glVersion"] = version != NULL ? version : "";
+  j["frames"] = report->frames;
+  j["results"] = json::array();
+  for (const ShaderBenchResult &r : report->results) {
+    j["results"].push_back({{"effect", VariantEffectName(r.variant)},
+                            {"variant", r.variant.name},
+                            {"width", r.width},
+                            {"height", r.height},
+                            {"samples", r.samples},
+                            {"gpuMs", r.gpuMs},
+                            {"gpuMaxMs", r.gpuMaxMs},
+                            {"frameMs", r.frameMs},
+                            {"hash", HashText(r.hash)}});
+  }
+
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    TraceLog(LOG_ERROR, "SHADER_BENCH: Cannot write %s", path);
+    return false;
+  }
+  file << j.dump(2);
+  return file.good();
+}
+
+void ShaderBenchReportFree(ShaderBenchReport *report) { delete report; }
+
+struct CompareEntry {
+  float gpuMs;
+  std::string hash;
+};
+
+// Results keyed by "effect/variant@WxH"
+static bool LoadReport(const char *path, std::string *renderer,
+                       std::map<std::string, CompareEntry> *entries) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    TraceLog(LOG_ERROR, "SHADER_BENCH: Cannot open %s", path);
+    return false;
+  }
+  try {
+    const json j = json::parse(file);
+    *renderer = j.value("renderer", "");
+    for (const json &r : j.at("results")) {
+      const std::string key =
+          r.at("effect").get<std::string>() + "/" +
+          r.at("variant").get<std::string>() + "@" +
+          std::to_string(r.at("width").get<int>()) + "x" +
+          std::to_string(r.at("height").get<int>());
+      (*entries)[key] = CompareEntry{r.at("gpuMs").get<float>(),
+                                     r.at("hash").get<std::string>()};
+    }
+  } catch (const json::exception &e) {
+    TraceLog(LOG_ERROR, "SHADER_BENCH: %s: %s", path, e.what());
+    return false;
+  }
+  return true;
+}
+
+int ShaderBenchCompare(const char *basePath, const char *comparePath,
+                       float threshold) {
+  std::string baseRenderer;
+  std::string newRenderer;
+  std::map<std::string, CompareEntry> base;
+  std::map<std::string, CompareEntry> next;
+  if (!LoadReport(basePath, &baseRenderer, &base) ||
+      !LoadReport(comparePath, &newRenderer, &next)) {
+    return -1;
+  }
+
+  // NOLINTBEGIN(cert-err33-c) - report output is best-effort
+  if (baseRenderer != newRenderer) {
+    printf("warning: renderers differ (%s vs %s); timings and hashes are "
+           "not comparable\n",
+           baseRenderer.c_str(), newRenderer.c_str());
+  }
+
+  int regressions = 0;
+  int changedOutputs = 0;
+  for (const auto &[key, now] : next) {
+    const auto it = base.find(key);
+    if (it == base.end()) {
+      printf("new        %-48s %8.3f ms\n", key.c_str(), now.gpuMs);
+      continue;
+    }
+    const CompareEntry &was = it->second;
+    const bool slower = now.gpuMs > was.gpuMs * threshold &&
+                        now.gpuMs - was.gpuMs > MIN_REGRESSION_MS;
+    const bool changed = now.hash != was.hash;
+    if (slower) {
+      regressions++;
+      printf("REGRESSION %-48s %8.3f -> %8.3f ms (x%.2f)\n", key.c_str(),
+             was.gpuMs, now.gpuMs,
+             was.gpuMs > 0.0f ? now.gpuMs / was.gpuMs : 0.0f);
+    }
+    if (changed) {
+      changedOutputs++;
+      printf("output     %-48s frame hash changed\n", key.c_str());
+    }
+  }
+  for (const auto &[key, was] : base) {
+    if (next.find(key) == next.end()) {
+      printf("missing    %-48s %8.3f ms\n", key.c_str(), was.gpuMs);
+    }
+  }
+  printf("%d regression(s) over x%.2f, %d changed output(s), %zu result(s)\n",
+         regressions, threshold, changedOutputs, next.size());
+  // NOLINTEND(cert-err33-c)
+  return regressions;
+}
@@ -0,0 +1,122 @@
+#ifndef SHADER_BENCH_H
+#define SHADER_BENCH_H
+
+#include "config/effect_config.h"
+#include "profiler.h"
+#include "raylib.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-effect GPU cost suite. Each effect runs alone from its default config
+// through the normal output dispatch (custom render, generator scratch and
+// blend, resolution tiers, compute variants) at fixed sizes. The effect's
+// GPU scopes are summed per frame and written with a hash of the final frame
+// to a JSON report; two reports can be compared to flag regressions.
+//
+//   AudioJones --bench [--bench-frames N] [--bench-sizes WxH,WxH]
+//              [--bench-out FILE.json]
+//   AudioJones --bench-compare BASE.json NEW.json [--bench-threshold 1.25]
+//
+// Frame hashes are only comparable between runs on the same GL driver.
+// The suite also times the simulation spatial hash build against grid size;
+// those rows report the grid as width x height. CPU simulation backend rows
+// (simulation/sim_cpu.h) report wall time per frame in place of GPU time.
+
+#define SHADER_BENCH_MAX_SIZES 4
+#define SHADER_BENCH_AGENT_SWEEPS 4 // Simulations with an agent-count sweep
+#define SHADER_BENCH_AGENT_SWEEP_STEPS 4
+#define SHADER_BENCH_RADIUS_SWEEPS 3 // Tiled filters with a radius sweep
+#define SHADER_BENCH_RADIUS_SWEEP_STEPS 4
+#define SHADER_BENCH_MAX_VARIANTS                                              \
+  (TRANSFORM_EFFECT_COUNT * 3 + 1 +                                            \
+   SHADER_BENCH_AGENT_SWEEPS * SHADER_BENCH_AGENT_SWEEP_STEPS +                \
+   SHADER_BENCH_RADIUS_SWEEPS * SHADER_BENCH_RADIUS_SWEEP_STEPS * 2)
+#define SHADER_BENCH_MAX_FRAMES 1000
+#define SHADER_BENCH_WARMUP_FRAMES 8
+
+typedef struct ShaderBenchOptions {
+  bool enabled;        // --bench was given
+  const char *outPath; // Report file
+  // --bench-compare reports; comparing needs no GL and renders nothing
+  const char *basePath;
+  const char *comparePath;
+  int frames; // Measured frames per effect and size
+  int sizeCount;
+  int widths[SHADER_BENCH_MAX_SIZES];
+  int heights[SHADER_BENCH_MAX_SIZES];
+  float threshold; // Regression when new > base * threshold
+} ShaderBenchOptions;
+
+// One effect configuration to measure. Agent simulations also run an
+// agent-count sweep ("10k agents" .. "500k agents"), and cell-sorted ones an
+// "unsorted" pair. Kuwahara, Bilateral and DoG run a radius sweep ("radius 8",
+// "sigma 2") with the tiled compute path and again fragment-only.
+typedef struct ShaderBenchVariant {
+  TransformEffectType type; // TRANSFORM_EFFECT_COUNT = pipeline baseline
+  const char *name;         // "default", "full", "fragment", "unsorted", ...
+  EffectResolutionTier tier;
+  bool fragmentOnly;   // Switch the fast path off (tiled compute, cell sort)
+  int agentCount;      // Replaces the default agent count when > 0
+  const char *subject; // Non-effect measurement ("Spatial Hash"), else NULL
+  float radius;        // Replaces the default filter radius/sigma when > 0
+} ShaderBenchVariant;
+
+typedef struct ShaderBenchResult {
+  ShaderBenchVariant variant;
+  int width;
+  int height;
+  int samples; // Frames with GPU timings read back
+  float gpuMs; // Median of the effect's summed GPU scopes (baseline: zones)
+  float gpuMaxMs;
+  float frameMs; // Median wall time of the whole frame, GPU finished
+  uint64_t hash; // FNV-1a of the final RGBA8 frame
+} ShaderBenchResult;
+
+typedef struct ShaderBenchReport ShaderBenchReport;
+
+// Variants for every registered effect, baseline first. Returns the count
+// written, at most maxVariants.
+int ShaderBenchListVariants(ShaderBenchVariant *variants, int maxVariants);
+
+// Time SpatialHashBuild on 2D grids from 1k to 4M cells and add the results
+// to report. Returns the number of results added.
+int ShaderBenchSpatialHash(ShaderBenchReport *report, int frames);
+
+// Time CPU-backend Particle Life and Attractor Flow frames (step, trails,
+// upload) at 10k and 100k agents on 1 to 16 threads, up to the hardware's,
+// and add the wall times to report. Returns the number of results added.
+int ShaderBenchCpuSims(ShaderBenchReport *report, int width, int height,
+                       int frames);
+
+// Reset cfg to defaults with only the variant's effect enabled
+void ShaderBenchApplyVariant(EffectConfig *cfg,
+                             const ShaderBenchVariant *variant);
+
+// GPU ms of every scope read back during the current profiler frame, or a
+// negative value when nothing was read back
+float ShaderBenchSampledMs(const Profiler *profiler);
+
+// GPU ms of the feedback, drawables and output zones, read back one frame
+// late. The baseline variant has no effect scopes, so it is timed by these.
+float ShaderBenchZoneMs(const Profiler *profiler);
+
+// Wait for the GPU so the next frame's timings are complete
+void ShaderBenchFinishFrame(void);
+
+// Median of values (reordered in place); 0 when count is 0
+float ShaderBenchMedian(float *values, int count);
+
+uint64_t ShaderBenchHashTarget(RenderTexture2D target);
+
+ShaderBenchReport *ShaderBenchReportCreate(int frames);
+void ShaderBenchReportAdd(ShaderBenchReport *report,
+                          const ShaderBenchResult *result);
+bool ShaderBenchReportWrite(const ShaderBenchReport *report, const char *path);
+void ShaderBenchReportFree(ShaderBenchReport *report);
+
+// Print a comparison table to stdout. Returns the number of regressions, or
+// -1 when a report cannot be read.
+int ShaderBenchCompare(const char *basePath, const char *comparePath,
+                       float threshold);
+
+#endif // SHADER_BENCH_H
@@ -1,7 +1,9 @@
 #include "shader_setup.h"
 #include "blend_compositor.h"
 #include "config/effect_descriptor.h"
+#include "cpu_profiler.h"
 #include "post_effect.h"
+#include "render_utils.h"
 #include <math.h>
 
 TransformEffectEntry GetTransformEffect(PostEffect *pe,
@@ -166,36 +168,66 @@ static bool reg_accumComposite = EffectDescriptorRegister(
      nullptr, nullptr});
 // clang-format on
 
-void ApplyHalfResEffect(PostEffect *pe, const RenderTexture2D *source,
-                        const int *writeIdx, Shader shader,
-                        RenderPipelineShaderSetupFn setup) {
-  const int halfW = pe->screenWidth / 2;
-  const int halfH = pe->screenHeight / 2;
+// Luma tolerance for upsample taps; larger values approach plain bilinear
+static const float UPSAMPLE_RANGE_SIGMA = 0.1f;
+
+static void DrawEdgeAwareUpsample(PostEffect *pe, const Texture2D &lowResult,
+                                  const Texture2D &lowGuide,
+                                  const Texture2D &highGuide) {
+  const float lowRes[2] = {(float)lowResult.width, (float)lowResult.height};
+  const Rectangle lowSrcRect = {0, 0, (float)lowResult.width,
+                                (float)-lowResult.height};
+  const Rectangle fullRect = {0, 0, (float)pe->screenWidth,
+                              (float)pe->screenHeight};
+
+  BeginShaderMode(pe->upsampleShader);
+  SetShaderValueTexture(pe->upsampleShader, pe->upsampleGuideLowLoc, lowGuide);
+  SetShaderValueTexture(pe->upsampleShader, pe->upsampleGuideHighLoc,
+                        highGuide);
+  SetShaderValue(pe->upsampleShader, pe->upsampleLowResolutionLoc, lowRes,
+                 SHADER_UNIFORM_VEC2);
+  SetShaderValue(pe->upsampleShader, pe->upsampleRangeSigmaLoc,
+                 &UPSAMPLE_RANGE_SIGMA, SHADER_UNIFORM_FLOAT);
+  DrawTexturePro(lowResult, lowSrcRect, fullRect, {0, 0}, 0.0f, WHITE);
+  EndShaderMode();
+}
+
+void ApplyTieredEffect(PostEffect *pe, const RenderTexture2D *source,
+                       const RenderTexture2D *dest, EffectResolutionTier tier,
+                       Shader shader, RenderPipelineShaderSetupFn setup,
+                       bool edgeAware) {
+  RenderTexture2D *low = PostEffectGetTierTargets(pe, tier);
+  const int lowW = low[0].texture.width;
+  const int lowH = low[0].texture.height;
   const Rectangle srcRect = {0, 0, (float)source->texture.width,
                              (float)-source->texture.height};
-  const Rectangle halfRect = {0, 0, (float)halfW, (float)halfH};
+  const Rectangle lowSrcRect = {0, 0, (float)lowW, (float)-lowH};
+  const Rectangle lowRect = {0, 0, (float)lowW, (float)lowH};
   const Rectangle fullRect = {0, 0, (float)pe->screenWidth,
                               (float)pe->screenHeight};
 
-  BeginTextureMode(pe->halfResA);
-  DrawTexturePro(source->texture, srcRect, halfRect, {0, 0}, 0.0f, WHITE);
+  BeginTextureMode(low[0]);
+  DrawTexturePro(source->texture, srcRect, lowRect, {0, 0}, 0.0f, WHITE);
   EndTextureMode();
 
   const int resLoc = GetShaderLocation(shader, "resolution");
   if (resLoc >= 0) {
-    const float halfRes[2] = {(float)halfW, (float)halfH};
-    SetShaderValue(shader, resLoc, halfRes, SHADER_UNIFORM_VEC2);
+    const float lowRes[2] = {(float)lowW, (float)lowH};
+    SetShaderValue(shader, resLoc, lowRes, SHADER_UNIFORM_VEC2);
   }
 
+  // Setups that read PostEffectRenderWidth/Height see the tier size
+  PostEffectBeginScaledPass(lowW, lowH);
   if (setup != NULL) {
+    CPU_ZONE("Setup");
     setup(pe);
   }
-  BeginTextureMode(pe->halfResB);
+  BeginTextureMode(low[1]);
   BeginShaderMode(shader);
-  DrawTexturePro(pe->halfResA.texture, {0, 0, (float)halfW, (float)-halfH},
-                 halfRect, {0, 0}, 0.0f, WHITE);
+  DrawTexturePro(low[0].texture, lowSrcRect, lowRect, {0, 0}, 0.0f, WHITE);
   EndShaderMode();
   EndTextureMode();
+  PostEffectEndScaledPass(pe);
 
   // Subsequent effects may share this shader
   if (resLoc >= 0) {
@@ -203,8 +235,54 @@ void ApplyHalfResEffect(PostEffect *pe, const RenderTexture2D *source,
     SetShaderValue(shader, resLoc, fullRes, SHADER_UNIFORM_VEC2);
   }
 
-  BeginTextureMode(pe->pingPong[*writeIdx]);
-  DrawTexturePro(pe->halfResB.texture, {0, 0, (float)halfW, (float)-halfH},
-                 fullRect, {0, 0}, 0.0f, WHITE);
+  BeginTextureMode(*dest);
+  if (edgeAware) {
+    DrawEdgeAwareUpsample(pe, low[1].texture, low[0].texture, source->texture);
+  } else {
+    DrawTexturePro(low[1].texture, lowSrcRect, fullRect, {0, 0}, 0.0f, WHITE);
+  }
+  EndTextureMode();
+}
+
+// 4-way cycle alternates diagonals so consecutive frames cover opposite slots
+static const int INTERLEAVE_QUAD_ORDER[4] = {0, 3, 1, 2};
+
+void ApplyInterleavedEffect(PostEffect *pe, const RenderTexture2D *source,
+                            const RenderTexture2D *dest,
+                            TransformEffectType type, Shader shader,
+                            RenderPipelineShaderSetupFn setup, int count) {
+  const RenderTexture2D *history = PostEffectGetInterleaveHistory(pe, type);
+  const int phase = count == 4 ? INTERLEAVE_QUAD_ORDER[pe->interleaveFrame % 4]
+                               : (int)(pe->interleaveFrame % 2);
+  const int countLoc = GetShaderLocation(shader, "interleaveCount");
+  const int phaseLoc = GetShaderLocation(shader, "interleavePhase");
+  SetShaderValue(shader, countLoc, &count, SHADER_UNIFORM_INT);
+  SetShaderValue(shader, phaseLoc, &phase, SHADER_UNIFORM_INT);
+
+  // No clear: discarded pixels keep their last shaded value
+  BeginTextureMode(*history);
+  BeginShaderMode(shader);
+  if (setup != NULL) {
+    CPU_ZONE("Setup");
+    setup(pe);
+  }
+  RenderUtilsDrawFullscreenQuad(source->texture, pe->screenWidth,
+                                pe->screenHeight);
+  EndShaderMode();
+  EndTextureMode();
+
+  // Shader stays shared with non-interleaved dispatch
+  const int off = 0;
+  SetShaderValue(shader, countLoc, &off, SHADER_UNIFORM_INT);
+
+  BeginTextureMode(*dest);
+  BeginShaderMode(pe->interleaveResolveShader);
+  SetShaderValue(pe->interleaveResolveShader, pe->interleaveResolveCountLoc,
+                 &count, SHADER_UNIFORM_INT);
+  SetShaderValue(pe->interleaveResolveShader, pe->interleaveResolvePhaseLoc,
+                 &phase, SHADER_UNIFORM_INT);
+  RenderUtilsDrawFullscreenQuad(history->texture, pe->screenWidth,
+                                pe->screenHeight);
+  EndShaderMode();
   EndTextureMode();
 }
@@ -24,9 +24,21 @@ void SetupClarity(PostEffect *pe);
 void SetupAccumComposite(PostEffect *pe);
 
 // Multi-pass and utility functions
-void ApplyHalfResEffect(PostEffect *pe, const RenderTexture2D *source,
-                        const int *writeIdx, Shader shader,
-                        RenderPipelineShaderSetupFn setup);
+// Run a single-pass effect at a reduced resolution tier and upscale into
+// dest. edgeAware guides the upsample by source luma (transforms with an
+// explicitly chosen tier); plain bilinear suits generators, whose output is
+// unrelated to the scene, and default-tier transforms.
+void ApplyTieredEffect(PostEffect *pe, const RenderTexture2D *source,
+                       const RenderTexture2D *dest, EffectResolutionTier tier,
+                       Shader shader, RenderPipelineShaderSetupFn setup,
+                       bool edgeAware);
+
+// Shade one interleave slot of a generator into its history target, then
+// resolve the full frame into dest. count is 2 (checkerboard) or 4.
+void ApplyInterleavedEffect(PostEffect *pe, const RenderTexture2D *source,
+                            const RenderTexture2D *dest,
+                            TransformEffectType type, Shader shader,
+                            RenderPipelineShaderSetupFn setup, int count);
 
 // Returns shader, setup callback, and enabled flag for a transform effect type
 TransformEffectEntry GetTransformEffect(PostEffect *pe,
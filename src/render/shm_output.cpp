@@ -0,0 +1,245 @@
+#include "shm_output.h"
+#include "cpu_profiler.h"
+#include "frame_capture.h"
+#include "render_utils.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// Header page, then page-aligned slots so consumers can map or DMA a slot
+static const size_t PAGE_BYTES = 4096;
+static_assert(sizeof(ShmVideoHeader) <= PAGE_BYTES, "header exceeds a page");
+
+struct ShmOutput {
+  ShmVideoFormat format;
+  int width;
+  int height;
+  Shader convertShader;
+  int frameSizeLoc;
+  int nv12Loc;
+  RenderTexture2D target;
+  FrameCapture *capture;
+
+  char name[64];
+  unsigned char *base;
+  size_t size;
+  ShmVideoHeader *header;
+  uint64_t published; // Consumer thread only
+};
+
+#ifndef _WIN32
+static size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+static uint64_t MonotonicNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static bool CreateSegment(ShmOutput *out, uint32_t frameBytes) {
+  const size_t slotStride = AlignUp(frameBytes, PAGE_BYTES);
+  out->size = PAGE_BYTES + slotStride * SHM_VIDEO_SLOTS;
+
+  const int fd = shm_open(out->name, O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return false;
+  }
+  if (ftruncate(fd, (off_t)out->size) != 0) {
+    close(fd);
+    shm_unlink(out->name);
+    return false;
+  }
+  void *base =
+      mmap(NULL, out->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    shm_unlink(out->name);
+    return false;
+  }
+
+  out->base = static_cast<unsigned char *>(base);
+  out->header = static_cast<ShmVideoHeader *>(base);
+  memset(out->header, 0, sizeof(ShmVideoHeader));
+  out->header->version = SHM_VIDEO_VERSION;
+  out->header->format = out->format;
+  out->header->width = (uint32_t)out->width;
+  out->header->height = (uint32_t)out->height;
+  out->header->frameBytes = frameBytes;
+  out->header->slotCount = SHM_VIDEO_SLOTS;
+  out->header->slotStride = (uint32_t)slotStride;
+  out->header->dataOffset = PAGE_BYTES;
+  out->header->writerPid = (uint32_t)getpid();
+  // Readers treat a matching magic as "header complete"
+  __atomic_store_n(&out->header->magic, SHM_VIDEO_MAGIC, __ATOMIC_RELEASE);
+  return true;
+}
+
+static void DestroySegment(ShmOutput *out) {
+  if (out->base == NULL) {
+    return;
+  }
+  munmap(out->base, out->size);
+  shm_unlink(out->name);
+  out->base = NULL;
+  out->header = NULL;
+}
+
+static void RingDoorbell(ShmVideoHeader *header) {
+  __atomic_add_fetch(&header->doorbell, 1, __ATOMIC_RELEASE);
+#ifdef __linux__
+  syscall(SYS_futex, &header->doorbell, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+// Capture thread: copy one converted frame into the next ring slot
+static bool PublishFrame(const FrameCaptureFrame *frame, void *userData) {
+  ShmOutput *out = static_cast<ShmOutput *>(userData);
+  ShmVideoHeader *header = out->header;
+  if ((uint32_t)frame->bytes != header->frameBytes) {
+    return false;
+  }
+
+  const uint64_t number = ++out->published;
+  const uint32_t slot = (uint32_t)((number - 1) % SHM_VIDEO_SLOTS);
+  ShmVideoSlot *s = &header->slots[slot];
+
+  __atomic_store_n(&s->sequence, number * 2 - 1, __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  memcpy(out->base + header->dataOffset + (size_t)slot * header->slotStride,
+         frame->pixels, header->frameBytes);
+  s->timestampNs = MonotonicNs();
+  __atomic_store_n(&s->sequence, number * 2, __ATOMIC_RELEASE);
+  __atomic_store_n(&header->latest, number, __ATOMIC_RELEASE);
+  RingDoorbell(header);
+  return true;
+}
+
+static FrameCaptureFormat CaptureFormat(ShmVideoFormat format) {
+  switch (format) {
+  case SHM_VIDEO_RGBA16F:
+    return FRAME_CAPTURE_RGBA16F;
+  case SHM_VIDEO_NV12:
+    return FRAME_CAPTURE_R8;
+  case SHM_VIDEO_RGBA8:
+  default:
+    return FRAME_CAPTURE_RGBA8;
+  }
+}
+
+static int TargetPixelFormat(ShmVideoFormat format) {
+  switch (format) {
+  case SHM_VIDEO_RGBA16F:
+    return RL_PIXELFORMAT_UNCOMPRESSED_R16G16B16A16;
+  case SHM_VIDEO_NV12:
+    return RL_PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+  case SHM_VIDEO_RGBA8:
+  default:
+    return RL_PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+  }
+}
+#endif
+
+ShmOutput *ShmOutputInit(const ShmOutputConfig *cfg, int renderWidth,
+                         int renderHeight) {
+  if (cfg == NULL || cfg->name == NULL) {
+    return NULL;
+  }
+#ifdef _WIN32
+  (void)renderWidth;
+  (void)renderHeight;
+  TraceLog(LOG_WARNING, "SHM_OUTPUT: POSIX shared memory is unavailable");
+  return NULL;
+#else
+  ShmOutput *out = new ShmOutput{};
+  out->format = cfg->format;
+  out->width = cfg->width > 0 ? cfg->width : renderWidth;
+  out->height = cfg->height > 0 ? cfg->height : renderHeight;
+  if (out->format == SHM_VIDEO_NV12) {
+    out->width &= ~1;
+    out->height &= ~1;
+  }
+  // POSIX names need exactly one leading slash
+  // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size name buffer
+  snprintf(out->name, sizeof(out->name), "%s%s",
+           cfg->name[0] == '/' ? "" : "/", cfg->name);
+
+  const uint32_t frameBytes = ShmVideoFrameBytes(
+      out->format, (uint32_t)out->width, (uint32_t)out->height);
+  if (!CreateSegment(out, frameBytes)) {
+    TraceLog(LOG_WARNING, "SHM_OUTPUT: Failed to create %s", out->name);
+    delete out;
+    return NULL;
+  }
+
+  out->convertShader = LoadShader(0, "shaders/shm_convert.fs");
+  out->frameSizeLoc = GetShaderLocation(out->convertShader, "frameSize");
+  out->nv12Loc = GetShaderLocation(out->convertShader, "nv12");
+
+  const int targetHeight =
+      out->format == SHM_VIDEO_NV12 ? out->height * 3 / 2 : out->height;
+  RenderUtilsInitTextureFormat(&out->target, out->width, targetHeight,
+                               TargetPixelFormat(out->format), "SHM_OUTPUT");
+  out->capture = FrameCaptureInit(PublishFrame, out,
+                                  CaptureFormat(out->format), false);
+  if (out->target.id == 0 || out->capture == NULL) {
+    ShmOutputUninit(out);
+    return NULL;
+  }
+
+  TraceLog(LOG_INFO, "SHM_OUTPUT: Publishing %dx%d format %d to %s",
+           out->width, out->height, (int)out->format, out->name);
+  return out;
+#endif
+}
+
+void ShmOutputUninit(ShmOutput *out) {
+  if (out == NULL) {
+    return;
+  }
+  FrameCaptureUninit(out->capture);
+  if (out->target.id != 0) {
+    UnloadRenderTexture(out->target);
+  }
+  UnloadShader(out->convertShader);
+#ifndef _WIN32
+  DestroySegment(out);
+#endif
+  delete out;
+}
+
+void ShmOutputPublish(ShmOutput *out, Texture2D source) {
+  if (out == NULL) {
+    return;
+  }
+  CPU_ZONE("ShmOutputPublish");
+
+  const float frameSize[2] = {(float)out->width, (float)out->height};
+  const int nv12 = out->format == SHM_VIDEO_NV12 ? 1 : 0;
+
+  BeginTextureMode(out->target);
+  BeginShaderMode(out->convertShader);
+  SetShaderValue(out->convertShader, out->frameSizeLoc, frameSize,
+                 SHADER_UNIFORM_VEC2);
+  SetShaderValue(out->convertShader, out->nv12Loc, &nv12, SHADER_UNIFORM_INT);
+  const Rectangle srcRect = {0, 0, (float)source.width, (float)source.height};
+  const Rectangle dstRect = {0, 0, (float)out->target.texture.width,
+                             (float)out->target.texture.height};
+  DrawTexturePro(source, srcRect, dstRect, {0, 0}, 0.0f, WHITE);
+  EndShaderMode();
+  EndTextureMode();
+
+  FrameCaptureSubmit(out->capture, out->target, GetTime());
+}
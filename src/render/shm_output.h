@@ -0,0 +1,33 @@
+#ifndef SHM_OUTPUT_H
+#define SHM_OUTPUT_H
+
+#include "raylib.h"
+#include "shm/shm_video.h"
+#include <stdbool.h>
+
+// Publishes final frames into a POSIX shared-memory ring (protocol in
+// shm/shm_video.h) for local consumers. Frames are scaled and converted on
+// the GPU, read back through FrameCapture, and copied into the ring on the
+// capture thread. Unavailable on Windows, where Init returns NULL.
+
+typedef struct ShmOutputConfig {
+  const char *name; // Segment name; NULL disables the output
+  int width;        // 0 = internal render size at init
+  int height;
+  ShmVideoFormat format;
+} ShmOutputConfig;
+
+typedef struct ShmOutput ShmOutput;
+
+// Create the segment and GPU resources. Returns NULL when disabled or on
+// failure.
+ShmOutput *ShmOutputInit(const ShmOutputConfig *cfg, int renderWidth,
+                         int renderHeight);
+
+// Unlinks the segment; readers keep their mapping until they close
+void ShmOutputUninit(ShmOutput *out);
+
+// Convert source and queue it for publishing. NULL-safe; call once per frame.
+void ShmOutputPublish(ShmOutput *out, Texture2D source);
+
+#endif // SHM_OUTPUT_H
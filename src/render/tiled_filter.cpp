@@ -0,0 +1,71 @@
+#include "tiled_filter.h"
+#include "external/glad.h"
+#include "rlgl.h"
+#include <stddef.h>
+
+unsigned int TiledFilterLoadProgram(const char *path, const char *logPrefix) {
+  if (rlGetVersion() != RL_OPENGL_43) {
+    TraceLog(LOG_INFO, "%s: Compute shaders unavailable, using fragment path",
+             logPrefix);
+    return 0;
+  }
+
+  char *source = LoadFileText(path);
+  if (source == NULL) {
+    TraceLog(LOG_WARNING, "%s: Failed to load tiled shader: %s", logPrefix,
+             path);
+    return 0;
+  }
+
+  const unsigned int shaderId = rlCompileShader(source, RL_COMPUTE_SHADER);
+  UnloadFileText(source);
+  if (shaderId == 0) {
+    TraceLog(LOG_WARNING, "%s: Failed to compile tiled shader, using fragment",
+             logPrefix);
+    return 0;
+  }
+
+  const unsigned int program = rlLoadComputeShaderProgram(shaderId);
+  if (program == 0) {
+    TraceLog(LOG_WARNING, "%s: Failed to link tiled shader, using fragment",
+             logPrefix);
+  }
+  return program;
+}
+
+void TiledFilterUnloadProgram(unsigned int program) {
+  if (program != 0) {
+    rlUnloadShaderProgram(program);
+  }
+}
+
+bool TiledFilterDispatch(unsigned int program, const Texture2D &source,
+                         const RenderTexture2D *dest) {
+  // LoadRenderTexture fallback targets are RGBA8 and cannot bind as rgba32f
+  if (program == 0 ||
+      dest->texture.format != RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32) {
+    rlDisableShader();
+    return false;
+  }
+
+  rlActiveTextureSlot(0);
+  rlEnableTexture(source.id);
+  rlBindImageTexture(dest->texture.id, 1,
+                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+
+  const int groupsX =
+      (dest->texture.width + TILED_FILTER_GROUP_SIZE - 1) /
+      TILED_FILTER_GROUP_SIZE;
+  const int groupsY =
+      (dest->texture.height + TILED_FILTER_GROUP_SIZE - 1) /
+      TILED_FILTER_GROUP_SIZE;
+  rlComputeShaderDispatch((unsigned int)groupsX, (unsigned int)groupsY, 1);
+
+  // Next pass either samples dest or renders into it as a framebuffer
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT |
+                  GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+
+  rlDisableTexture();
+  rlDisableShader();
+  return true;
+}
@@ -0,0 +1,28 @@
+#ifndef TILED_FILTER_H
+#define TILED_FILTER_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Workgroup edge and maximum kernel radius baked into shaders/*_tiled.glsl.
+// A 16x16 tile with a 12px apron is 40x40 vec4 = 25.6 KB of shared memory,
+// under the 32 KB GL 4.3 guarantee.
+#define TILED_FILTER_GROUP_SIZE 16
+#define TILED_FILTER_MAX_RADIUS 12
+
+// Compile a tiled neighborhood-filter compute shader. Returns 0 when compute
+// shaders are unavailable or compilation fails; callers keep their fragment
+// shader as the fallback path.
+unsigned int TiledFilterLoadProgram(const char *path, const char *logPrefix);
+
+// Unload a program returned by TiledFilterLoadProgram (0 is ignored)
+void TiledFilterUnloadProgram(unsigned int program);
+
+// Dispatch the currently enabled tiled program over dest. Binds source to
+// sampler unit 0 and dest as an rgba32f image at binding 1, then disables the
+// program. Caller enables the program and sets uniforms first.
+// Returns false (without dispatching) when dest is not an HDR float target.
+bool TiledFilterDispatch(unsigned int program, const Texture2D &source,
+                         const RenderTexture2D *dest);
+
+#endif // TILED_FILTER_H
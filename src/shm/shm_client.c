@@ -0,0 +1,107 @@
+// Test client for the shared-memory video output. Prints the segment format
+// and per-second frame rate, skipped frames, and publish-to-read latency.
+//
+//   shm_client [NAME] [--dump FILE]
+//
+// --dump writes the first valid frame as raw bytes in the segment's format.
+
+#include "shm_video.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static const char *FORMAT_NAMES[SHM_VIDEO_FORMAT_COUNT] = {"rgba8", "rgba16f",
+                                                           "nv12"};
+
+static uint64_t NowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static int DumpFrame(const char *path, const ShmVideoReader *reader,
+                     const ShmVideoFrame *frame) {
+  const ShmVideoHeader *header = ShmVideoReaderHeader(reader);
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    fprintf(stderr, "shm_client: cannot open %s\n", path);
+    return -1;
+  }
+  const size_t written = fwrite(frame->data, 1, header->frameBytes, f);
+  fclose(f);
+  if (written != header->frameBytes || !ShmVideoFrameValid(reader, frame)) {
+    return 1; // Torn or short; try the next frame
+  }
+  fprintf(stderr, "shm_client: wrote frame %llu to %s\n",
+          (unsigned long long)frame->number, path);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  const char *name = SHM_VIDEO_DEFAULT_NAME;
+  const char *dumpPath = NULL;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--dump") == 0 && i + 1 < argc) {
+      dumpPath = argv[++i];
+    } else {
+      name = argv[i];
+    }
+  }
+
+  ShmVideoReader *reader = ShmVideoReaderOpen(name);
+  if (reader == NULL) {
+    fprintf(stderr, "shm_client: no AudioJones output at %s\n", name);
+    return 1;
+  }
+
+  const ShmVideoHeader *header = ShmVideoReaderHeader(reader);
+  printf("%s: %ux%u %s, %u bytes/frame, writer pid %u\n", name, header->width,
+         header->height,
+         header->format < SHM_VIDEO_FORMAT_COUNT ? FORMAT_NAMES[header->format]
+                                                 : "?",
+         header->frameBytes, header->writerPid);
+
+  uint64_t last = 0;
+  uint64_t windowStart = NowNs();
+  unsigned frames = 0;
+  unsigned skipped = 0;
+  double latencySumMs = 0.0;
+
+  for (;;) {
+    ShmVideoFrame frame;
+    if (!ShmVideoReaderWait(reader, last, 2000, &frame)) {
+      printf("no frames for 2 s\n");
+      continue;
+    }
+    if (last != 0 && frame.number > last + 1) {
+      skipped += (unsigned)(frame.number - last - 1);
+    }
+    last = frame.number;
+    frames++;
+    latencySumMs += (double)(NowNs() - frame.timestampNs) / 1e6;
+
+    if (dumpPath != NULL) {
+      const int result = DumpFrame(dumpPath, reader, &frame);
+      if (result < 0) {
+        break;
+      }
+      if (result == 0) {
+        dumpPath = NULL;
+      }
+    }
+
+    const uint64_t now = NowNs();
+    if (now - windowStart >= 1000000000u) {
+      printf("%u fps, %u skipped, %.2f ms latency\n", frames, skipped,
+             latencySumMs / frames);
+      fflush(stdout);
+      windowStart = now;
+      frames = 0;
+      skipped = 0;
+      latencySumMs = 0.0;
+    }
+  }
+
+  ShmVideoReaderClose(reader);
+  return 0;
+}
@@ -0,0 +1,94 @@
+#ifndef SHM_VIDEO_H
+#define SHM_VIDEO_H
+
+// Shared-memory video output protocol and reader API. Plain C so external
+// consumers (compositors, LED mappers) can build src/shm/shm_video_reader.c
+// without the rest of AudioJones.
+//
+// Segment layout: ShmVideoHeader, then SHM_VIDEO_SLOTS frames of frameBytes
+// each, starting at dataOffset and slotStride apart. Frames are written
+// round-robin; frame n (1-based) lands in slot (n - 1) % SHM_VIDEO_SLOTS.
+// Each slot is a seqlock: its sequence is 2n - 1 while frame n is being
+// written and 2n once complete. Rows are top row first.
+//
+// After each frame the writer publishes latest = n and increments doorbell,
+// a 32-bit futex word readers can sleep on.
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SHM_VIDEO_MAGIC 0x4F564A41u // "AJVO"
+#define SHM_VIDEO_VERSION 1
+#define SHM_VIDEO_SLOTS 3
+#define SHM_VIDEO_DEFAULT_NAME "/audiojones"
+
+typedef enum ShmVideoFormat {
+  SHM_VIDEO_RGBA8 = 0, // 4 bytes per pixel
+  SHM_VIDEO_RGBA16F,   // 8 bytes per pixel, IEEE half floats
+  SHM_VIDEO_NV12,      // Y plane, then interleaved CbCr at half resolution
+                       // (BT.709 limited range)
+  SHM_VIDEO_FORMAT_COUNT
+} ShmVideoFormat;
+
+typedef struct ShmVideoSlot {
+  uint64_t sequence;    // Seqlock word, see above
+  uint64_t timestampNs; // CLOCK_MONOTONIC when the frame was published
+} ShmVideoSlot;
+
+typedef struct ShmVideoHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t format; // ShmVideoFormat
+  uint32_t width;
+  uint32_t height;
+  uint32_t frameBytes;
+  uint32_t slotCount;
+  uint32_t slotStride;
+  uint64_t dataOffset;
+  uint32_t doorbell; // Futex word, incremented after every frame
+  uint32_t writerPid;
+  uint64_t latest; // Newest complete frame number, 0 before the first
+  ShmVideoSlot slots[SHM_VIDEO_SLOTS];
+} ShmVideoHeader;
+
+// Bytes per frame for a format and size (NV12 needs even dimensions)
+static inline uint32_t ShmVideoFrameBytes(ShmVideoFormat format,
+                                          uint32_t width, uint32_t height) {
+  switch (format) {
+  case SHM_VIDEO_RGBA16F:
+    return width * height * 8;
+  case SHM_VIDEO_NV12:
+    return width * height * 3 / 2;
+  case SHM_VIDEO_RGBA8:
+  default:
+    return width * height * 4;
+  }
+}
+
+typedef struct ShmVideoFrame {
+  const void *data; // Points into the shared segment; see ShmVideoFrameValid
+  uint64_t number;  // Frame number, 1-based; gaps mean skipped frames
+  uint64_t timestampNs;
+} ShmVideoFrame;
+
+typedef struct ShmVideoReader ShmVideoReader;
+
+// Map an existing segment read-only. Returns NULL if it does not exist or
+// the header does not match this protocol version.
+ShmVideoReader *ShmVideoReaderOpen(const char *name);
+
+void ShmVideoReaderClose(ShmVideoReader *reader);
+
+const ShmVideoHeader *ShmVideoReaderHeader(const ShmVideoReader *reader);
+
+// Wait up to timeoutMs for a frame newer than afterNumber (0 = any frame).
+// Returns false on timeout. The frame is read in place, not copied.
+bool ShmVideoReaderWait(ShmVideoReader *reader, uint64_t afterNumber,
+                        int timeoutMs, ShmVideoFrame *frame);
+
+// True if the writer has not started overwriting frame since it was returned.
+// Check after consuming in-place data; on false, discard what was read.
+bool ShmVideoFrameValid(const ShmVideoReader *reader,
+                        const ShmVideoFrame *frame);
+
+#endif // SHM_VIDEO_H
@@ -0,0 +1,136 @@
+#include "shm_video.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+struct ShmVideoReader {
+  const ShmVideoHeader *header;
+  const unsigned char *base;
+  size_t size;
+};
+
+ShmVideoReader *ShmVideoReaderOpen(const char *name) {
+  const int fd = shm_open(name != NULL ? name : SHM_VIDEO_DEFAULT_NAME,
+                          O_RDONLY, 0);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmVideoHeader)) {
+    close(fd);
+    return NULL;
+  }
+
+  void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return NULL;
+  }
+
+  const ShmVideoHeader *header = (const ShmVideoHeader *)base;
+  const uint64_t needed =
+      header->dataOffset + (uint64_t)header->slotStride * SHM_VIDEO_SLOTS;
+  if (header->magic != SHM_VIDEO_MAGIC ||
+      header->version != SHM_VIDEO_VERSION ||
+      header->slotCount != SHM_VIDEO_SLOTS ||
+      needed > (uint64_t)st.st_size) {
+    munmap(base, (size_t)st.st_size);
+    return NULL;
+  }
+
+  ShmVideoReader *reader = (ShmVideoReader *)calloc(1, sizeof(*reader));
+  if (reader == NULL) {
+    munmap(base, (size_t)st.st_size);
+    return NULL;
+  }
+  reader->header = header;
+  reader->base = (const unsigned char *)base;
+  reader->size = (size_t)st.st_size;
+  return reader;
+}
+
+void ShmVideoReaderClose(ShmVideoReader *reader) {
+  if (reader == NULL) {
+    return;
+  }
+  munmap((void *)reader->base, reader->size);
+  free(reader);
+}
+
+const ShmVideoHeader *ShmVideoReaderHeader(const ShmVideoReader *reader) {
+  return reader != NULL ? reader->header : NULL;
+}
+
+static uint64_t NowMs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+}
+
+// Sleep until doorbell moves past seen or timeoutMs passes
+static void WaitDoorbell(const ShmVideoHeader *header, uint32_t seen,
+                         int timeoutMs) {
+#ifdef __linux__
+  struct timespec ts = {timeoutMs / 1000, (long)(timeoutMs % 1000) * 1000000L};
+  syscall(SYS_futex, &header->doorbell, FUTEX_WAIT, seen, &ts, NULL, 0);
+#else
+  (void)header;
+  (void)seen;
+  struct timespec ts = {0, 1000000L};
+  (void)timeoutMs;
+  nanosleep(&ts, NULL);
+#endif
+}
+
+bool ShmVideoReaderWait(ShmVideoReader *reader, uint64_t afterNumber,
+                        int timeoutMs, ShmVideoFrame *frame) {
+  if (reader == NULL || frame == NULL) {
+    return false;
+  }
+
+  const ShmVideoHeader *header = reader->header;
+  const uint64_t deadline = NowMs() + (uint64_t)(timeoutMs > 0 ? timeoutMs : 0);
+  for (;;) {
+    const uint32_t bell = __atomic_load_n(&header->doorbell, __ATOMIC_ACQUIRE);
+    const uint64_t latest = __atomic_load_n(&header->latest, __ATOMIC_ACQUIRE);
+    if (latest > afterNumber) {
+      const uint32_t slot = (uint32_t)((latest - 1) % SHM_VIDEO_SLOTS);
+      const ShmVideoSlot *s = &header->slots[slot];
+      if (__atomic_load_n(&s->sequence, __ATOMIC_ACQUIRE) == latest * 2) {
+        frame->data = reader->base + header->dataOffset +
+                      (uint64_t)slot * header->slotStride;
+        frame->number = latest;
+        frame->timestampNs = s->timestampNs;
+        return true;
+      }
+      // Writer lapped the ring between the two loads; go again
+      continue;
+    }
+
+    const uint64_t now = NowMs();
+    if (now >= deadline) {
+      return false;
+    }
+    WaitDoorbell(header, bell, (int)(deadline - now));
+  }
+}
+
+bool ShmVideoFrameValid(const ShmVideoReader *reader,
+                        const ShmVideoFrame *frame) {
+  if (reader == NULL || frame == NULL || frame->number == 0) {
+    return false;
+  }
+  const uint32_t slot = (uint32_t)((frame->number - 1) % SHM_VIDEO_SLOTS);
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&reader->header->slots[slot].sequence,
+                         __ATOMIC_ACQUIRE) == frame->number * 2;
+}
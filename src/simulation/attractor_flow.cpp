@@ -1,4 +1,5 @@
 #include "attractor_flow.h"
+#include "attractor_flow_cpu.h"
 #include "automation/mod_sources.h"
 #include "automation/modulation_engine.h"
 #include "config/constants.h"
@@ -12,6 +13,7 @@
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -21,6 +23,14 @@
 
 static const char *COMPUTE_SHADER_PATH = "shaders/attractor_agents.glsl";
 
+// Orbit cache: ORBIT_COUNT trajectories of ORBIT_LENGTH samples per
+// attractor type (4 MB each), built by one dispatch of the agent shader
+static const int ORBIT_COUNT = 64;
+static const int ORBIT_LENGTH = 4096;
+static const int ORBIT_MODE_INTEGRATE = 0;
+static const int ORBIT_MODE_BUILD = 1;
+static const int ORBIT_MODE_FOLLOW = 2;
+
 static void InitializeAgents(AttractorAgent *agents, int count,
                              AttractorType type) {
   for (int i = 0; i < count; i++) {
@@ -66,10 +76,10 @@ static void InitializeAgents(AttractorAgent *agents, int count,
     }
     }
     agents[i].age = 0.0f;
+    agents[i].orbitPhase = 0.0f;
     agents[i]._pad[0] = 0.0f;
     agents[i]._pad[1] = 0.0f;
     agents[i]._pad[2] = 0.0f;
-    agents[i]._pad[3] = 0.0f;
   }
 }
 
@@ -124,6 +134,10 @@ static GLuint LoadComputeProgram(AttractorFlow *af) {
   af->depositAmountLoc = rlGetLocationUniform(program, "depositAmount");
   af->maxSpeedLoc = rlGetLocationUniform(program, "maxSpeed");
   af->computeGradientLUTLoc = rlGetLocationUniform(program, "gradientLUT");
+  af->orbitModeLoc = rlGetLocationUniform(program, "orbitMode");
+  af->orbitCountLoc = rlGetLocationUniform(program, "orbitCount");
+  af->orbitLengthLoc = rlGetLocationUniform(program, "orbitLength");
+  af->orbitAdvanceLoc = rlGetLocationUniform(program, "orbitAdvance");
 
   return program;
 }
@@ -146,14 +160,109 @@ static GLuint CreateAgentBuffer(int agentCount, AttractorType type) {
   return buffer;
 }
 
+// FNV-1a over the parameters that shape the current attractor. Rotation,
+// scale and position only change how an orbit is drawn.
+static unsigned int OrbitParamHash(const AttractorFlowConfig *cfg) {
+  float params[5] = {0};
+  switch (cfg->attractorType) {
+  case ATTRACTOR_LORENZ:
+    params[0] = cfg->sigma;
+    params[1] = cfg->rho;
+    params[2] = cfg->beta;
+    break;
+  case ATTRACTOR_ROSSLER:
+    params[0] = cfg->rosslerC;
+    break;
+  case ATTRACTOR_THOMAS:
+    params[0] = cfg->thomasB;
+    break;
+  case ATTRACTOR_DADRAS:
+    params[0] = cfg->dadrasA;
+    params[1] = cfg->dadrasB;
+    params[2] = cfg->dadrasC;
+    params[3] = cfg->dadrasD;
+    params[4] = cfg->dadrasE;
+    break;
+  case ATTRACTOR_CHUA:
+    params[0] = cfg->chuaAlpha;
+    params[1] = cfg->chuaGamma;
+    params[2] = cfg->chuaM0;
+    params[3] = cfg->chuaM1;
+    break;
+  case ATTRACTOR_AIZAWA:
+  default:
+    break;
+  }
+
+  unsigned int hash = 2166136261u;
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(params);
+  for (size_t i = 0; i < sizeof(params); i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static void FreeOrbits(AttractorFlow *af) {
+  for (int i = 0; i < ATTRACTOR_COUNT; i++) {
+    rlUnloadShaderBuffer(af->orbits[i].buffer);
+    af->orbits[i] = AttractorOrbitCache{};
+  }
+}
+
+// Return the current attractor's orbits, rebuilding them with the agent
+// shader (enabled, uniforms set) when its parameters changed or the time
+// scale drifted more than 2x from the one they were integrated with. Only
+// that type's entry is rebuilt. NULL when the buffer can't be allocated.
+static const AttractorOrbitCache *PrepareOrbits(AttractorFlow *af) {
+  AttractorOrbitCache *orbit = &af->orbits[af->config.attractorType];
+  const unsigned int hash = OrbitParamHash(&af->config);
+  const float timeScale = af->config.timeScale;
+
+  if (orbit->buffer == 0) {
+    orbit->buffer = rlLoadShaderBuffer(
+        ORBIT_COUNT * ORBIT_LENGTH * 4 * sizeof(float), NULL, RL_DYNAMIC_COPY);
+    if (orbit->buffer == 0) {
+      TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create orbit cache");
+      return NULL;
+    }
+  } else if (orbit->paramHash == hash && timeScale <= orbit->timeStep * 2.0f &&
+             timeScale >= orbit->timeStep * 0.5f) {
+    return orbit;
+  }
+
+  rlSetUniform(af->orbitModeLoc, &ORBIT_MODE_BUILD, RL_SHADER_UNIFORM_INT, 1);
+  rlBindShaderBuffer(orbit->buffer, 2);
+  const int workGroupSize = 1024;
+  rlComputeShaderDispatch(
+      (unsigned int)((ORBIT_COUNT + workGroupSize - 1) / workGroupSize), 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  orbit->paramHash = hash;
+  orbit->timeStep = timeScale;
+  return orbit;
+}
+
+// CPU backend: replace the agents with a fresh spawn
+static bool LoadCpuAgents(AttractorFlow *af) {
+  AttractorAgent *agents = static_cast<AttractorAgent *>(
+      malloc(af->agentCount * sizeof(AttractorAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, af->agentCount, af->config.attractorType);
+  const bool loaded = AttractorFlowCpuLoad(af->cpu, agents, af->agentCount);
+  free(agents);
+  return loaded;
+}
+
 AttractorFlow *AttractorFlowInit(int width, int height,
                                  const AttractorFlowConfig *config) {
   if (!AttractorFlowSupported()) {
-    TraceLog(
-        LOG_WARNING,
-        "ATTRACTOR_FLOW: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "ATTRACTOR_FLOW: Compute shaders not supported "
+                          "(requires OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   AttractorFlow *af =
       static_cast<AttractorFlow *>(calloc(1, sizeof(AttractorFlow)));
@@ -171,15 +280,24 @@ AttractorFlow *AttractorFlowInit(int width, int height,
   af->time = 0.0f;
   af->supported = true;
 
-  af->computeProgram = LoadComputeProgram(af);
-  if (af->computeProgram == 0) {
-    goto cleanup;
-  }
+  if (cpuBackend) {
+    af->cpu = AttractorFlowCpuInit();
+    af->trailMap = TrailMapInitCpu(width, height);
+    if (af->cpu == NULL || af->trailMap == NULL) {
+      TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create CPU backend");
+      goto cleanup;
+    }
+  } else {
+    af->computeProgram = LoadComputeProgram(af);
+    if (af->computeProgram == 0) {
+      goto cleanup;
+    }
 
-  af->trailMap = TrailMapInit(width, height);
-  if (af->trailMap == NULL) {
-    TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create trail map");
-    goto cleanup;
+    af->trailMap = TrailMapInit(width, height);
+    if (af->trailMap == NULL) {
+      TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create trail map");
+      goto cleanup;
+    }
   }
 
   af->colorizeShader = LoadShader(NULL, "shaders/trail_debug.fs");
@@ -188,19 +306,28 @@ AttractorFlow *AttractorFlowInit(int width, int height,
              "ATTRACTOR_FLOW: Failed to load debug shader, using default");
   }
 
-  af->gradientLUT = ColorLUTInit(&af->config.color);
-  if (af->gradientLUT == NULL) {
-    TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create gradient LUT");
-    goto cleanup;
-  }
+  if (cpuBackend) {
+    // Colors come from the CPU backend's own copy of the gradient
+    if (!LoadCpuAgents(af)) {
+      goto cleanup;
+    }
+  } else {
+    af->gradientLUT = ColorLUTInit(&af->config.color);
+    if (af->gradientLUT == NULL) {
+      TraceLog(LOG_ERROR, "ATTRACTOR_FLOW: Failed to create gradient LUT");
+      goto cleanup;
+    }
 
-  af->agentBuffer = CreateAgentBuffer(af->agentCount, af->config.attractorType);
-  if (af->agentBuffer == 0) {
-    goto cleanup;
+    af->agentBuffer =
+        CreateAgentBuffer(af->agentCount, af->config.attractorType);
+    if (af->agentBuffer == 0) {
+      goto cleanup;
+    }
+    af->agentCapacity = af->agentCount;
   }
 
-  TraceLog(LOG_INFO, "ATTRACTOR_FLOW: Initialized with %d agents at %dx%d",
-           af->agentCount, width, height);
+  TraceLog(LOG_INFO, "ATTRACTOR_FLOW: Initialized with %d agents at %dx%d%s",
+           af->agentCount, width, height, cpuBackend ? " on the CPU" : "");
   return af;
 
 cleanup:
@@ -214,6 +341,8 @@ void AttractorFlowUninit(AttractorFlow *af) {
   }
 
   rlUnloadShaderBuffer(af->agentBuffer);
+  FreeOrbits(af);
+  AttractorFlowCpuUninit(af->cpu);
   TrailMapUninit(af->trailMap);
   ColorLUTUninit(af->gradientLUT);
   if (af->colorizeShader.id != 0) {
@@ -235,6 +364,34 @@ void AttractorFlowUpdate(AttractorFlow *af, float deltaTime) {
   af->rotationAccumY += af->config.rotationSpeedY * deltaTime;
   af->rotationAccumZ += af->config.rotationSpeedZ * deltaTime;
 
+  // Effective rotation = base angle + accumulated speed
+  const float rotX = af->config.rotationAngleX + af->rotationAccumX;
+  const float rotY = af->config.rotationAngleY + af->rotationAccumY;
+  const float rotZ = af->config.rotationAngleZ + af->rotationAccumZ;
+
+  const float cx = cosf(rotX);
+  const float sx = sinf(rotX);
+  const float cy = cosf(rotY);
+  const float sy = sinf(rotY);
+  const float cz = cosf(rotZ);
+  const float sz = sinf(rotZ);
+
+  // Rotation matrix (XYZ order): Rz * Ry * Rx, column-major for OpenGL
+  float rotationMatrix[9] = {cy * cz,
+                             cy * sz,
+                             -sy,
+                             sx * sy * cz - cx * sz,
+                             sx * sy * sz + cx * cz,
+                             sx * cy,
+                             cx * sy * cz + sx * sz,
+                             cx * sy * sz - sx * cz,
+                             cx * cy};
+
+  if (af->cpu != NULL) {
+    AttractorFlowCpuStep(af->cpu, af, rotationMatrix);
+    return;
+  }
+
   rlEnableShader(af->computeProgram);
 
   const float resolution[2] = {(float)af->width, (float)af->height};
@@ -266,34 +423,14 @@ void AttractorFlowUpdate(AttractorFlow *af, float deltaTime) {
   const float center[2] = {af->config.x, af->config.y};
   rlSetUniform(af->centerLoc, center, RL_SHADER_UNIFORM_VEC2, 1);
 
-  // Effective rotation = base angle + accumulated speed
-  const float rotX = af->config.rotationAngleX + af->rotationAccumX;
-  const float rotY = af->config.rotationAngleY + af->rotationAccumY;
-  const float rotZ = af->config.rotationAngleZ + af->rotationAccumZ;
-
-  const float cx = cosf(rotX);
-  const float sx = sinf(rotX);
-  const float cy = cosf(rotY);
-  const float sy = sinf(rotY);
-  const float cz = cosf(rotZ);
-  const float sz = sinf(rotZ);
-
-  // Rotation matrix (XYZ order): Rz * Ry * Rx, column-major for OpenGL
-  float rotationMatrix[9] = {cy * cz,
-                             cy * sz,
-                             -sy,
-                             sx * sy * cz - cx * sz,
-                             sx * sy * sz + cx * cz,
-                             sx * cy,
-                             cx * sy * cz + sx * sz,
-                             cx * sy * sz - sx * cz,
-                             cx * cy};
   glUniformMatrix3fv(af->rotationMatrixLoc, 1, GL_FALSE, rotationMatrix);
 
   rlSetUniform(af->depositAmountLoc, &af->config.depositAmount,
                RL_SHADER_UNIFORM_FLOAT, 1);
   rlSetUniform(af->maxSpeedLoc, &af->config.maxSpeed, RL_SHADER_UNIFORM_FLOAT,
                1);
+  rlSetUniform(af->orbitCountLoc, &ORBIT_COUNT, RL_SHADER_UNIFORM_INT, 1);
+  rlSetUniform(af->orbitLengthLoc, &ORBIT_LENGTH, RL_SHADER_UNIFORM_INT, 1);
 
   // Bind gradient LUT as sampler for velocity-to-color mapping
   if (af->gradientLUT != NULL) {
@@ -303,7 +440,22 @@ void AttractorFlowUpdate(AttractorFlow *af, float deltaTime) {
     glUniform1i(af->computeGradientLUTLoc, 0);
   }
 
-  rlBindShaderBuffer(af->agentBuffer, 0);
+  // Cached orbits replace per-agent RK4; fall back to integrating when the
+  // cache can't be built
+  const AttractorOrbitCache *orbit =
+      af->config.orbitCache ? PrepareOrbits(af) : NULL;
+  int orbitMode = ORBIT_MODE_INTEGRATE;
+  float orbitAdvance = 0.0f;
+  if (orbit != NULL) {
+    orbitMode = ORBIT_MODE_FOLLOW;
+    orbitAdvance = af->config.timeScale / fmaxf(orbit->timeStep, 1e-6f);
+    rlBindShaderBuffer(orbit->buffer, 2);
+  }
+  rlSetUniform(af->orbitModeLoc, &orbitMode, RL_SHADER_UNIFORM_INT, 1);
+  rlSetUniform(af->orbitAdvanceLoc, &orbitAdvance, RL_SHADER_UNIFORM_FLOAT, 1);
+
+  SimBindAgentBuffer(af->agentBuffer, 0, af->agentCount,
+                     sizeof(AttractorAgent));
   rlBindImageTexture(TrailMapGetTexture(af->trailMap).id, 1,
                      RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
 
@@ -346,6 +498,11 @@ void AttractorFlowReset(AttractorFlow *af) {
 
   TrailMapClear(af->trailMap);
 
+  if (af->cpu != NULL) {
+    LoadCpuAgents(af);
+    return;
+  }
+
   AttractorAgent *agents = static_cast<AttractorAgent *>(
       malloc(af->agentCount * sizeof(AttractorAgent)));
   if (agents == NULL) {
@@ -358,6 +515,33 @@ void AttractorFlowReset(AttractorFlow *af) {
   free(agents);
 }
 
+// Keep the running agents, appending freshly spawned ones when growing and
+// dropping the tail when shrinking
+static void ResizeAgents(AttractorFlow *af, int count) {
+  const int oldCount = af->agentCount;
+
+  AttractorAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<AttractorAgent *>(
+        malloc((count - oldCount) * sizeof(AttractorAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, count - oldCount, af->config.attractorType);
+  }
+
+  const bool resized =
+      af->cpu != NULL
+          ? AttractorFlowCpuResize(af->cpu, newAgents, count)
+          : SimResizeAgentBuffer(&af->agentBuffer, &af->agentCapacity,
+                                 oldCount, count, sizeof(AttractorAgent),
+                                 newAgents);
+  free(newAgents);
+  if (resized) {
+    af->agentCount = count;
+  }
+}
+
 void AttractorFlowApplyConfig(AttractorFlow *af,
                               const AttractorFlowConfig *newConfig) {
   if (af == NULL || newConfig == NULL) {
@@ -372,6 +556,10 @@ void AttractorFlowApplyConfig(AttractorFlow *af,
   const bool needsBufferRealloc = (newAgentCount != af->agentCount);
 
   af->config = *newConfig;
+  TrailMapSetActive(af->trailMap, af->config.enabled);
+  if (!af->config.orbitCache) {
+    FreeOrbits(af);
+  }
 
   // LUT updates instantly - no agent reinit needed for color changes
   if (af->gradientLUT != NULL) {
@@ -379,25 +567,7 @@ void AttractorFlowApplyConfig(AttractorFlow *af,
   }
 
   if (needsBufferRealloc) {
-    rlUnloadShaderBuffer(af->agentBuffer);
-    af->agentCount = newAgentCount;
-
-    AttractorAgent *agents = static_cast<AttractorAgent *>(
-        malloc(af->agentCount * sizeof(AttractorAgent)));
-    if (agents == NULL) {
-      af->agentBuffer = 0;
-      return;
-    }
-
-    InitializeAgents(agents, af->agentCount, af->config.attractorType);
-    af->agentBuffer = rlLoadShaderBuffer(
-        af->agentCount * sizeof(AttractorAgent), agents, RL_DYNAMIC_COPY);
-    free(agents);
-
-    TrailMapClear(af->trailMap);
-
-    TraceLog(LOG_INFO, "ATTRACTOR_FLOW: Reallocated buffer for %d agents",
-             af->agentCount);
+    ResizeAgents(af, newAgentCount);
   }
 }
 
@@ -422,7 +592,12 @@ static const char *ATTRACTOR_TYPES[] = {"Lorenz", "Rossler", "Aizawa",
 
 static void DrawAttractorFlowParams(EffectConfig *e, const ModSources *ms,
                                     ImU32) {
-  ImGui::SliderInt("Agents##attr", &e->attractorFlow.agentCount, 10000, 500000);
+  // Cached orbits skip per-agent integration, so far more agents fit
+  ImGui::SliderInt("Agents##attr", &e->attractorFlow.agentCount, 10000,
+                   e->attractorFlow.orbitCache ? 2000000 : 500000);
+  ImGui::SliderFloat("Step Rate##attr", &e->attractorFlow.stepRate, 0.0f,
+                     240.0f, "%.0f Hz");
+  ImGui::Checkbox("Orbit Cache##attr", &e->attractorFlow.orbitCache);
 
   ImGui::SeparatorText("Attractor");
   int attractorType = (int)e->attractorFlow.attractorType;
@@ -517,10 +692,12 @@ void AttractorFlowRegisterParams(AttractorFlowConfig *cfg) {
 }
 
 void SetupAttractorFlowTrailBoost(PostEffect *pe) {
-  BlendCompositorApply(pe->blendCompositor,
-                       TrailMapGetTexture(pe->attractorFlow->trailMap),
-                       pe->effects.attractorFlow.boostIntensity,
-                       pe->effects.attractorFlow.blendMode);
+  const TrailMap *trailMap = pe->attractorFlow->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
+      pe->effects.attractorFlow.boostIntensity,
+      pe->effects.attractorFlow.blendMode);
 }
 
 // clang-format off
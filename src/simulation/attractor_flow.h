@@ -8,19 +8,22 @@
 #include <stdbool.h>
 
 typedef struct TrailMap TrailMap;
+typedef struct AttractorFlowCpu AttractorFlowCpu;
 
 typedef struct AttractorAgent {
   float x;
   float y;
   float z;
   float age;
-  float _pad[4]; // Pad to 32 bytes for GPU alignment
+  float orbitPhase; // Orbit samples advanced (orbit cache only)
+  float _pad[3];    // Pad to 32 bytes for GPU alignment
 } AttractorAgent;
 
 typedef struct AttractorFlowConfig {
   bool enabled = false;
   AttractorType attractorType = ATTRACTOR_LORENZ;
   int agentCount = 100000;
+  bool orbitCache = false;      // Ride precomputed orbits (compute path only)
   float timeScale = 0.01f;      // Integration timestep (0.001-0.1)
   float attractorScale = 0.02f; // World-to-screen scale (0.005-0.1)
   // Lorenz parameters (classic: sigma=10, rho=28, beta=8/3)
@@ -54,6 +57,7 @@ typedef struct AttractorFlowConfig {
   float maxSpeed = 50.0f;      // Velocity normalization ceiling (5-200)
   float decayHalfLife = 1.0f;  // Seconds for 50% decay (0.1-5.0)
   int diffusionScale = 1;      // Diffusion kernel scale in pixels (0-4)
+  float stepRate = 0.0f;       // Fixed steps per second (0 = every frame)
   float boostIntensity = 1.0f; // Trail boost strength (0.0-5.0)
   EffectBlendMode blendMode = EFFECT_BLEND_SCREEN;
   ColorConfig color;
@@ -66,17 +70,28 @@ typedef struct AttractorFlowConfig {
       chuaAlpha, chuaGamma, chuaM0, chuaM1, x, y, rotationAngleX,              \
       rotationAngleY, rotationAngleZ, rotationSpeedX, rotationSpeedY,          \
       rotationSpeedZ, depositAmount, maxSpeed, decayHalfLife, diffusionScale,  \
-      boostIntensity, blendMode, color, debugOverlay
+      boostIntensity, blendMode, color, debugOverlay, stepRate, orbitCache
 
 typedef struct ColorLUT ColorLUT;
 
+// Precomputed trajectories for one attractor type. With config.orbitCache,
+// agents advance along these instead of integrating RK4 every step.
+typedef struct AttractorOrbitCache {
+  unsigned int buffer;    // vec4 samples (position, speed); 0 until built
+  unsigned int paramHash; // Hash of the parameters the orbits were built for
+  float timeStep;         // timeScale the orbits were integrated with
+} AttractorOrbitCache;
+
 typedef struct AttractorFlow {
   unsigned int agentBuffer;
   unsigned int computeProgram;
+  AttractorFlowCpu *cpu; // CPU backend state; NULL on the compute path
   TrailMap *trailMap;
   Shader colorizeShader;
   ColorLUT *gradientLUT;
+  AttractorOrbitCache orbits[ATTRACTOR_COUNT]; // Compute path only
   int agentCount;
+  int agentCapacity; // Agents agentBuffer holds; grows, never shrinks
   int width;
   int height;
   // Agent shader uniforms
@@ -104,6 +119,10 @@ typedef struct AttractorFlow {
   int depositAmountLoc;
   int maxSpeedLoc;
   int computeGradientLUTLoc;
+  int orbitModeLoc;
+  int orbitCountLoc;
+  int orbitLengthLoc;
+  int orbitAdvanceLoc;
   float time;
   float rotationAccumX; // Runtime accumulator (not saved to preset)
   float rotationAccumY;
@@ -116,14 +135,15 @@ typedef struct AttractorFlow {
 bool AttractorFlowSupported(void);
 
 // Initialize attractor flow simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders
+// Returns NULL if allocation fails
 AttractorFlow *AttractorFlowInit(int width, int height,
                                  const AttractorFlowConfig *config);
 
 // Clean up attractor flow resources
 void AttractorFlowUninit(AttractorFlow *af);
 
-// Dispatch compute shader to update agents
+// Dispatch compute shader (or step the CPU backend) to update agents
 void AttractorFlowUpdate(AttractorFlow *af, float deltaTime);
 
 // Process trails with diffusion and decay (call after AttractorFlowUpdate)
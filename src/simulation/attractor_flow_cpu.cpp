@@ -0,0 +1,423 @@
+#include "attractor_flow_cpu.h"
+#include "render/color_config.h"
+#include "render/color_lut.h"
+#include "render/draw_utils.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const int AGENT_GRAIN = 1024; // Agents per worker chunk
+// Respawn when position exceeds this distance from origin
+static const float EXPLOSION_THRESHOLD = 500.0f;
+
+struct AttractorFlowCpu {
+  float *x;
+  float *y;
+  float *z;
+  float *age;
+  int *deposit;  // Trail pixel per agent, -1 when off screen or respawned
+  float *speed;  // Normalized speed at the deposit, selects the color
+  int count;
+  float palette[COLOR_LUT_SIZE * 3]; // CPU copy of the gradient LUT
+  ColorConfig paletteColor;
+  bool paletteValid;
+};
+
+// Attractor parameters for one step
+struct StepJob {
+  AttractorFlowCpu *cpu;
+  AttractorType type;
+  float dt;
+  float seedTime;
+  float sigma;
+  float rho;
+  float beta;
+  float rosslerC;
+  float thomasB;
+  float dadrasA;
+  float dadrasB;
+  float dadrasC;
+  float dadrasD;
+  float dadrasE;
+  float chuaAlpha;
+  float chuaGamma;
+  float chuaM0;
+  float chuaM1;
+  const float *rotation;
+  float projection; // attractorScale times the short screen side
+  float centerX;
+  float centerY;
+  int width;
+  int height;
+  float invMaxSpeed;
+};
+
+// The arrays share one allocation starting at x. The first keep agents carry
+// over; speed and deposit are rewritten every step.
+static bool AllocAgents(AttractorFlowCpu *cpu, int count, int keep) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 6 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  if (keep > 0) {
+    const size_t bytes = (size_t)keep * sizeof(float);
+    memcpy(block, cpu->x, bytes);
+    memcpy(block + (size_t)count, cpu->y, bytes);
+    memcpy(block + (size_t)count * 2, cpu->z, bytes);
+    memcpy(block + (size_t)count * 3, cpu->age, bytes);
+  }
+  free(cpu->x);
+  cpu->x = block;
+  cpu->y = block + (size_t)count;
+  cpu->z = block + (size_t)count * 2;
+  cpu->age = block + (size_t)count * 3;
+  cpu->speed = block + (size_t)count * 4;
+  cpu->deposit = reinterpret_cast<int *>(block + (size_t)count * 5);
+  cpu->count = count;
+  return true;
+}
+
+AttractorFlowCpu *AttractorFlowCpuInit(void) {
+  return static_cast<AttractorFlowCpu *>(calloc(1, sizeof(AttractorFlowCpu)));
+}
+
+void AttractorFlowCpuUninit(AttractorFlowCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  free(cpu->x);
+  free(cpu);
+}
+
+// Copy count agents into the state arrays starting at first
+static void StoreAgents(AttractorFlowCpu *cpu, int first,
+                        const AttractorAgent *agents, int count) {
+  for (int i = 0; i < count; i++) {
+    cpu->x[first + i] = agents[i].x;
+    cpu->y[first + i] = agents[i].y;
+    cpu->z[first + i] = agents[i].z;
+    cpu->age[first + i] = agents[i].age;
+  }
+}
+
+bool AttractorFlowCpuLoad(AttractorFlowCpu *cpu, const AttractorAgent *agents,
+                          int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool AttractorFlowCpuResize(AttractorFlowCpu *cpu,
+                            const AttractorAgent *newAgents, int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+static unsigned int Hash(unsigned int x) {
+  x ^= x >> 16;
+  x *= 0x85ebca6bu;
+  x ^= x >> 13;
+  x *= 0xc2b2ae35u;
+  x ^= x >> 16;
+  return x;
+}
+
+static float HashFloat(unsigned int x) {
+  return (float)Hash(x) / 4294967295.0f;
+}
+
+static float ChuaDiode(const StepJob *job, float x) {
+  return job->chuaM1 * x + 0.5f * (job->chuaM0 - job->chuaM1) *
+                               (fabsf(x + 1.0f) - fabsf(x - 1.0f));
+}
+
+// Same systems and constants as shaders/attractor_agents.glsl
+static inline void Derivative(const StepJob *job, const float p[3],
+                              float d[3]) {
+  switch (job->type) {
+  case ATTRACTOR_ROSSLER:
+    d[0] = -p[1] - p[2];
+    d[1] = p[0] + 0.2f * p[1];
+    d[2] = 0.2f + p[2] * (p[0] - job->rosslerC);
+    break;
+  case ATTRACTOR_AIZAWA:
+    d[0] = (p[2] - 0.7f) * p[0] - 3.5f * p[1];
+    d[1] = 3.5f * p[0] + (p[2] - 0.7f) * p[1];
+    d[2] = 0.6f + 0.95f * p[2] - (p[2] * p[2] * p[2]) / 3.0f -
+           (p[0] * p[0] + p[1] * p[1]) * (1.0f + 0.25f * p[2]) +
+           0.1f * p[2] * p[0] * p[0] * p[0];
+    break;
+  case ATTRACTOR_THOMAS:
+    d[0] = sinf(p[1]) - job->thomasB * p[0];
+    d[1] = sinf(p[2]) - job->thomasB * p[1];
+    d[2] = sinf(p[0]) - job->thomasB * p[2];
+    break;
+  case ATTRACTOR_DADRAS:
+    d[0] = p[1] - job->dadrasA * p[0] + job->dadrasB * p[1] * p[2];
+    d[1] = job->dadrasC * p[1] - p[0] * p[2] + p[2];
+    d[2] = job->dadrasD * p[0] * p[1] - job->dadrasE * p[2];
+    break;
+  case ATTRACTOR_CHUA:
+    d[0] = job->chuaAlpha * (p[1] - p[0] - ChuaDiode(job, p[0]));
+    d[1] = p[0] - p[1] + p[2];
+    d[2] = -job->chuaGamma * p[1];
+    break;
+  case ATTRACTOR_LORENZ:
+  default:
+    d[0] = job->sigma * (p[1] - p[0]);
+    d[1] = p[0] * (job->rho - p[2]) - p[1];
+    d[2] = p[0] * p[1] - job->beta * p[2];
+    break;
+  }
+}
+
+static void Rk4Step(const StepJob *job, float p[3]) {
+  const float dt = job->dt;
+  float k1[3];
+  float k2[3];
+  float k3[3];
+  float k4[3];
+  float t[3];
+  Derivative(job, p, k1);
+  for (int c = 0; c < 3; c++) {
+    t[c] = p[c] + 0.5f * dt * k1[c];
+  }
+  Derivative(job, t, k2);
+  for (int c = 0; c < 3; c++) {
+    t[c] = p[c] + 0.5f * dt * k2[c];
+  }
+  Derivative(job, t, k3);
+  for (int c = 0; c < 3; c++) {
+    t[c] = p[c] + dt * k3[c];
+  }
+  Derivative(job, t, k4);
+  for (int c = 0; c < 3; c++) {
+    p[c] += (dt / 6.0f) * (k1[c] + 2.0f * k2[c] + 2.0f * k3[c] + k4[c]);
+  }
+}
+
+// Respawn near the attractor, seeded like the shader
+static void Respawn(const StepJob *job, unsigned int id, float p[3]) {
+  const unsigned int seed = Hash(id + (unsigned int)(job->seedTime * 1000.0f));
+  const float r1 = HashFloat(seed + 1u) - 0.5f;
+  const float r2 = HashFloat(seed + 2u) - 0.5f;
+  const float r3 = HashFloat(seed + 3u) - 0.5f;
+  switch (job->type) {
+  case ATTRACTOR_LORENZ: {
+    const float wing = HashFloat(seed) > 0.5f ? 1.0f : -1.0f;
+    p[0] = wing * 8.5f + r1 * 5.0f;
+    p[1] = wing * 8.5f + r2 * 5.0f;
+    p[2] = 27.0f + r3 * 10.0f;
+    break;
+  }
+  case ATTRACTOR_ROSSLER:
+    p[0] = r1 * 4.0f;
+    p[1] = r2 * 4.0f;
+    p[2] = r3 * 2.0f;
+    break;
+  case ATTRACTOR_AIZAWA:
+    p[0] = r1;
+    p[1] = r2;
+    p[2] = r3;
+    break;
+  case ATTRACTOR_THOMAS:
+    p[0] = r1 * 2.0f;
+    p[1] = r2 * 2.0f;
+    p[2] = r3 * 2.0f;
+    break;
+  case ATTRACTOR_DADRAS:
+    p[0] = r1 * 3.0f;
+    p[1] = r2 * 3.0f;
+    p[2] = r3 * 3.0f;
+    break;
+  case ATTRACTOR_CHUA:
+  default: {
+    const float sign = HashFloat(seed) < 0.5f ? 1.0f : -1.0f;
+    p[0] = sign * 1.5f + r1 * 0.2f;
+    p[1] = r2 * 0.2f;
+    p[2] = r3 * 0.2f;
+    break;
+  }
+  }
+}
+
+// Orthographic projection with the shader's per-attractor centering, plane
+// and scale
+static void Project(const StepJob *job, const float p[3], float *sx,
+                    float *sy) {
+  const float *m = job->rotation;
+  const float cz = job->type == ATTRACTOR_LORENZ ? p[2] - 27.0f : p[2];
+  const float rx = m[0] * p[0] + m[3] * p[1] + m[6] * cz;
+  const float ry = m[1] * p[0] + m[4] * p[1] + m[7] * cz;
+  const float rz = m[2] * p[0] + m[5] * p[1] + m[8] * cz;
+
+  float u;
+  float v;
+  switch (job->type) {
+  case ATTRACTOR_LORENZ:
+    u = rx;
+    v = rz;
+    break;
+  case ATTRACTOR_ROSSLER:
+    u = rx;
+    v = ry;
+    break;
+  case ATTRACTOR_AIZAWA:
+    u = rx * 8.0f;
+    v = rz * 8.0f;
+    break;
+  case ATTRACTOR_THOMAS:
+    u = rx * 4.0f;
+    v = ry * 4.0f;
+    break;
+  case ATTRACTOR_DADRAS:
+    u = rx * 2.7f;
+    v = ry * 2.7f;
+    break;
+  case ATTRACTOR_CHUA:
+  default:
+    u = rx * 3.0f;
+    v = rz * 3.0f;
+    break;
+  }
+  *sx = u * job->projection + job->centerX;
+  *sy = v * job->projection + job->centerY;
+}
+
+static void StepAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  AttractorFlowCpu *cpu = job->cpu;
+
+  for (int i = begin; i < end; i++) {
+    float p[3] = {cpu->x[i], cpu->y[i], cpu->z[i]};
+    Rk4Step(job, p);
+
+    // Numerical instability (NaN or explosion): respawn without depositing
+    const float magnitude = sqrtf(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+    if (!isfinite(magnitude) || magnitude > EXPLOSION_THRESHOLD) {
+      Respawn(job, (unsigned int)i, p);
+      cpu->x[i] = p[0];
+      cpu->y[i] = p[1];
+      cpu->z[i] = p[2];
+      cpu->age[i] = 0.0f;
+      cpu->deposit[i] = -1;
+      continue;
+    }
+
+    cpu->x[i] = p[0];
+    cpu->y[i] = p[1];
+    cpu->z[i] = p[2];
+    cpu->age[i] += job->dt;
+
+    float sx;
+    float sy;
+    Project(job, p, &sx, &sy);
+    const bool onScreen = sx >= 0.0f && sx < (float)job->width &&
+                          sy >= 0.0f && sy < (float)job->height;
+    if (!onScreen) {
+      cpu->deposit[i] = -1;
+      continue;
+    }
+
+    // Velocity selects the gradient color
+    float d[3];
+    Derivative(job, p, d);
+    const float speed = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    cpu->speed[i] = fminf(fmaxf(speed * job->invMaxSpeed, 0.0f), 1.0f);
+    cpu->deposit[i] = (int)sy * job->width + (int)sx;
+  }
+}
+
+static void UpdatePalette(AttractorFlowCpu *cpu, const ColorConfig *color) {
+  if (cpu->paletteValid && ColorConfigEquals(&cpu->paletteColor, color)) {
+    return;
+  }
+  for (int i = 0; i < COLOR_LUT_SIZE; i++) {
+    const float t = (float)i / (float)(COLOR_LUT_SIZE - 1);
+    const Color c = ColorFromConfig(color, t, 1.0f);
+    cpu->palette[i * 3] = (float)c.r / 255.0f;
+    cpu->palette[i * 3 + 1] = (float)c.g / 255.0f;
+    cpu->palette[i * 3 + 2] = (float)c.b / 255.0f;
+  }
+  cpu->paletteColor = *color;
+  cpu->paletteValid = true;
+}
+
+void AttractorFlowCpuStep(AttractorFlowCpu *cpu, const AttractorFlow *af,
+                          const float rotation[9]) {
+  if (cpu == NULL || cpu->count == 0) {
+    return;
+  }
+  const AttractorFlowConfig *cfg = &af->config;
+
+  StepJob job = {};
+  job.cpu = cpu;
+  job.type = cfg->attractorType;
+  job.dt = cfg->timeScale;
+  job.seedTime = af->time;
+  job.sigma = cfg->sigma;
+  job.rho = cfg->rho;
+  job.beta = cfg->beta;
+  job.rosslerC = cfg->rosslerC;
+  job.thomasB = cfg->thomasB;
+  job.dadrasA = cfg->dadrasA;
+  job.dadrasB = cfg->dadrasB;
+  job.dadrasC = cfg->dadrasC;
+  job.dadrasD = cfg->dadrasD;
+  job.dadrasE = cfg->dadrasE;
+  job.chuaAlpha = cfg->chuaAlpha;
+  job.chuaGamma = cfg->chuaGamma;
+  job.chuaM0 = cfg->chuaM0;
+  job.chuaM1 = cfg->chuaM1;
+  job.rotation = rotation;
+  job.projection =
+      cfg->attractorScale * (float)(af->width < af->height ? af->width
+                                                           : af->height);
+  job.centerX = cfg->x * (float)af->width;
+  job.centerY = cfg->y * (float)af->height;
+  job.width = af->width;
+  job.height = af->height;
+  job.invMaxSpeed = 1.0f / fmaxf(cfg->maxSpeed, 0.001f);
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, StepAgents, &job);
+
+  // Serial deposit: agents landing on one pixel must not race
+  UpdatePalette(cpu, &cfg->color);
+  for (int i = 0; i < cpu->count; i++) {
+    const int pixel = cpu->deposit[i];
+    if (pixel < 0) {
+      continue;
+    }
+    const float u = cpu->speed[i] * (float)(COLOR_LUT_SIZE - 1);
+    const int lo = (int)u;
+    const int hi = lo < COLOR_LUT_SIZE - 1 ? lo + 1 : lo;
+    const float f = u - (float)lo;
+    float rgb[3];
+    for (int c = 0; c < 3; c++) {
+      const float a = cpu->palette[lo * 3 + c];
+      rgb[c] = (a + (cpu->palette[hi * 3 + c] - a) * f) * cfg->depositAmount;
+    }
+    TrailMapDeposit(af->trailMap, pixel % af->width, pixel / af->width, rgb[0],
+                    rgb[1], rgb[2]);
+  }
+}
@@ -0,0 +1,32 @@
+#ifndef ATTRACTOR_FLOW_CPU_H
+#define ATTRACTOR_FLOW_CPU_H
+
+#include "attractor_flow.h"
+#include <stdbool.h>
+
+// CPU backend for Attractor Flow. Agents live in SoA arrays and integrate
+// on the worker pool; deposits are colored from a CPU copy of the gradient.
+typedef struct AttractorFlowCpu AttractorFlowCpu;
+
+// Returns NULL on allocation failure
+AttractorFlowCpu *AttractorFlowCpuInit(void);
+
+void AttractorFlowCpuUninit(AttractorFlowCpu *cpu);
+
+// Replace the agents. Returns false and keeps the old agents when the
+// arrays cannot be allocated.
+bool AttractorFlowCpuLoad(AttractorFlowCpu *cpu, const AttractorAgent *agents,
+                          int count);
+
+// Resize to count agents, keeping the first min(current, count) in their
+// current state and appending newAgents (the count - current new ones) when
+// growing. Returns false and keeps the old agents on allocation failure.
+bool AttractorFlowCpuResize(AttractorFlowCpu *cpu,
+                            const AttractorAgent *newAgents, int count);
+
+// Advance every agent one RK4 step with af's config, depositing into af's
+// trail map. rotation is column-major.
+void AttractorFlowCpuStep(AttractorFlowCpu *cpu, const AttractorFlow *af,
+                          const float rotation[9]);
+
+#endif // ATTRACTOR_FLOW_CPU_H
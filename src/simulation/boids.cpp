@@ -1,4 +1,5 @@
 #include "boids.h"
+#include "boids_cpu.h"
 #include "automation/mod_sources.h"
 #include "automation/modulation_engine.h"
 #include "config/effect_descriptor.h"
@@ -9,6 +10,7 @@
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
 #include "spatial_hash.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
@@ -65,16 +67,18 @@ static float CalculateCellSize(int width, int height) {
   return (float)cellSize;
 }
 
-static void InitializeAgents(BoidAgent *agents, int count, int width,
-                             int height, const ColorConfig *color) {
-  for (int i = 0; i < count; i++) {
-    agents[i].x = (float)(GetRandomValue(0, width - 1));
-    agents[i].y = (float)(GetRandomValue(0, height - 1));
+// Fill agents[0..count-first) with agents first..count-1 of count
+static void InitializeAgents(BoidAgent *agents, int first, int count,
+                             int width, int height, const ColorConfig *color) {
+  for (int i = first; i < count; i++) {
+    BoidAgent *agent = &agents[i - first];
+    agent->x = (float)(GetRandomValue(0, width - 1));
+    agent->y = (float)(GetRandomValue(0, height - 1));
 
     const float angle = (float)GetRandomValue(0, 628) / 100.0f;
-    agents[i].vx = cosf(angle) * 1.0f;
-    agents[i].vy = sinf(angle) * 1.0f;
-    agents[i].hue = ColorConfigAgentHue(color, i, count);
+    agent->vx = cosf(angle) * 1.0f;
+    agent->vy = sinf(angle) * 1.0f;
+    agent->hue = ColorConfigAgentHue(color, i, count);
   }
 }
 
@@ -134,7 +138,7 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
     return 0;
   }
 
-  InitializeAgents(agents, agentCount, width, height, color);
+  InitializeAgents(agents, 0, agentCount, width, height, color);
   const GLuint buffer = rlLoadShaderBuffer(agentCount * sizeof(BoidAgent),
                                            agents, RL_DYNAMIC_COPY);
   free(agents);
@@ -145,12 +149,56 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
   return buffer;
 }
 
+static bool CreateCellSort(Boids *b) {
+  b->sortedBuffer = rlLoadShaderBuffer(b->agentCapacity * sizeof(BoidAgent),
+                                       NULL, RL_DYNAMIC_COPY);
+  if (b->sortedBuffer == 0) {
+    TraceLog(LOG_ERROR, "BOIDS: Failed to create sorted agent SSBO");
+    return false;
+  }
+
+  b->spatialHash =
+      SpatialHashInit(b->agentCapacity, CalculateCellSize(b->width, b->height),
+                      b->width, b->height);
+  if (b->spatialHash == NULL) {
+    TraceLog(LOG_ERROR, "BOIDS: Failed to create spatial hash");
+    return false;
+  }
+  return true;
+}
+
+// Without the hash the flock steers with no neighbors (gridSize 0 in the
+// shader) until a resize recreates it
+static void FreeCellSort(Boids *b) {
+  if (b->sortedBuffer != 0) {
+    rlUnloadShaderBuffer(b->sortedBuffer);
+    b->sortedBuffer = 0;
+  }
+  SpatialHashUninit(b->spatialHash);
+  b->spatialHash = NULL;
+}
+
+// CPU backend: replace the agents with a fresh spawn
+static bool LoadCpuAgents(Boids *b) {
+  BoidAgent *agents =
+      static_cast<BoidAgent *>(malloc(b->agentCount * sizeof(BoidAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, 0, b->agentCount, b->width, b->height,
+                   &b->config.color);
+  const bool loaded = BoidsCpuLoad(b->cpu, agents, b->agentCount);
+  free(agents);
+  return loaded;
+}
+
 Boids *BoidsInit(int width, int height, const BoidsConfig *config) {
   if (!BoidsSupported()) {
-    TraceLog(LOG_WARNING,
-             "BOIDS: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "BOIDS: Compute shaders not supported (requires "
+                          "OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   Boids *b = static_cast<Boids *>(calloc(1, sizeof(Boids)));
   if (b == NULL) {
@@ -167,12 +215,19 @@ Boids *BoidsInit(int width, int height, const BoidsConfig *config) {
   b->time = 0.0f;
   b->supported = true;
 
-  b->computeProgram = LoadComputeProgram(b);
-  if (b->computeProgram == 0) {
-    goto cleanup;
+  if (!cpuBackend) {
+    b->computeProgram = LoadComputeProgram(b);
+    if (b->computeProgram == 0) {
+      goto cleanup;
+    }
   }
 
-  b->trailMap = TrailMapInit(width, height);
+  b->trailMap =
+      cpuBackend
+          ? TrailMapInitCpu(TrailMapGridSize(width, b->config.gridDivisor),
+                            TrailMapGridSize(height, b->config.gridDivisor))
+          : TrailMapInit(TrailMapGridSize(width, b->config.gridDivisor),
+                         TrailMapGridSize(height, b->config.gridDivisor));
   if (b->trailMap == NULL) {
     TraceLog(LOG_ERROR, "BOIDS: Failed to create trail map");
     goto cleanup;
@@ -183,16 +238,26 @@ Boids *BoidsInit(int width, int height, const BoidsConfig *config) {
     TraceLog(LOG_WARNING, "BOIDS: Failed to load debug shader, using default");
   }
 
+  if (cpuBackend) {
+    // The CPU step bins the flock itself each frame: no GPU cell sort
+    b->cpu = BoidsCpuInit();
+    if (b->cpu == NULL || !LoadCpuAgents(b)) {
+      TraceLog(LOG_ERROR, "BOIDS: Failed to create CPU backend");
+      goto cleanup;
+    }
+    TraceLog(LOG_INFO, "BOIDS: Initialized with %d agents at %dx%d on the CPU",
+             b->agentCount, width, height);
+    return b;
+  }
+
   b->agentBuffer =
       CreateAgentBuffer(b->agentCount, width, height, &b->config.color);
   if (b->agentBuffer == 0) {
     goto cleanup;
   }
+  b->agentCapacity = b->agentCount;
 
-  b->spatialHash = SpatialHashInit(
-      b->agentCount, CalculateCellSize(width, height), width, height);
-  if (b->spatialHash == NULL) {
-    TraceLog(LOG_ERROR, "BOIDS: Failed to create spatial hash");
+  if (!CreateCellSort(b)) {
     goto cleanup;
   }
 
@@ -211,8 +276,9 @@ void BoidsUninit(Boids *b) {
   }
 
   rlUnloadShaderBuffer(b->agentBuffer);
+  BoidsCpuUninit(b->cpu);
+  FreeCellSort(b);
   TrailMapUninit(b->trailMap);
-  SpatialHashUninit(b->spatialHash);
   if (b->debugShader.id != 0) {
     UnloadShader(b->debugShader);
   }
@@ -228,10 +294,35 @@ void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
 
   b->time += deltaTime;
 
+  if (b->cpu != NULL) {
+    BoidsCpuStep(b->cpu, b, CalculateCellSize(b->width, b->height));
+    return;
+  }
+
   // Build spatial hash from current agent positions
   SpatialHashBuild(b->spatialHash, b->agentBuffer, b->agentCount,
                    (int)sizeof(BoidAgent), 0);
 
+  // Periodically move the agents themselves into cell order so neighbor
+  // fetches read contiguous memory; between sorts the hash indices stay close
+  // to the identity
+  if (b->config.cellSort && b->sortedBuffer != 0 && b->spatialHash != NULL &&
+      ++b->framesSinceSort >= SPATIAL_HASH_SORT_INTERVAL) {
+    SpatialHashReorder(b->spatialHash, b->agentBuffer, b->sortedBuffer,
+                       b->agentCount, (int)sizeof(BoidAgent));
+    const unsigned int sorted = b->sortedBuffer;
+    b->sortedBuffer = b->agentBuffer;
+    b->agentBuffer = sorted;
+    b->framesSinceSort = 0;
+  }
+
+  // Downsampled grids splat deposits into the trail map's atomic sums
+  const bool accumulate = b->trailMap->width != b->width ||
+                          b->trailMap->height != b->height;
+  if (accumulate && !TrailMapBindDeposits(b->trailMap)) {
+    return;
+  }
+
   rlEnableShader(b->computeProgram);
 
   const float resolution[2] = {(float)b->width, (float)b->height};
@@ -261,9 +352,9 @@ void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
   rlSetUniform(b->saturationLoc, &saturation, RL_SHADER_UNIFORM_FLOAT, 1);
   rlSetUniform(b->valueLoc, &colorValue, RL_SHADER_UNIFORM_FLOAT, 1);
 
-  int gridWidth;
-  int gridHeight;
-  float cellSize;
+  int gridWidth = 0;
+  int gridHeight = 0;
+  float cellSize = 1.0f;
   SpatialHashGetGrid(b->spatialHash, &gridWidth, &gridHeight, &cellSize);
   const int gridSize[2] = {gridWidth, gridHeight};
   rlSetUniform(b->gridSizeLoc, gridSize, RL_SHADER_UNIFORM_IVEC2, 1);
@@ -274,11 +365,13 @@ void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
       b->config.perceptionRadius; // Use perception radius as edge margin
   rlSetUniform(b->edgeMarginLoc, &edgeMargin, RL_SHADER_UNIFORM_FLOAT, 1);
 
-  rlBindShaderBuffer(b->agentBuffer, 0);
+  SimBindAgentBuffer(b->agentBuffer, 0, b->agentCount, sizeof(BoidAgent));
   rlBindImageTexture(TrailMapGetTexture(b->trailMap).id, 1,
                      RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
-  rlBindShaderBuffer(SpatialHashGetOffsetsBuffer(b->spatialHash), 2);
-  rlBindShaderBuffer(SpatialHashGetIndicesBuffer(b->spatialHash), 3);
+  if (b->spatialHash != NULL) {
+    rlBindShaderBuffer(SpatialHashGetOffsetsBuffer(b->spatialHash), 2);
+    rlBindShaderBuffer(SpatialHashGetIndicesBuffer(b->spatialHash), 3);
+  }
 
   // Bind accumulation texture for repulsion sampling
   int accumMapUnit = 4;
@@ -294,6 +387,10 @@ void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
                   GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
 
   rlDisableShader();
+
+  if (accumulate) {
+    TrailMapResolveDeposits(b->trailMap);
+  }
 }
 
 void BoidsProcessTrails(const Boids *b, float deltaTime) {
@@ -305,6 +402,85 @@ void BoidsProcessTrails(const Boids *b, float deltaTime) {
                   b->config.diffusionScale);
 }
 
+// Shrink to count agents in place, taking every (agentCount / count)-th agent
+// in cell order so each cell keeps its share rather than the regions at the
+// buffer tail emptying
+static void ThinAgents(Boids *b, int count) {
+  if (b->spatialHash == NULL || b->sortedBuffer == 0) {
+    return;
+  }
+
+  SpatialHashBuild(b->spatialHash, b->agentBuffer, b->agentCount,
+                   (int)sizeof(BoidAgent), 0);
+  SpatialHashThin(b->spatialHash, b->agentBuffer, b->sortedBuffer,
+                  b->agentCount, count, (int)sizeof(BoidAgent));
+  const unsigned int thinned = b->sortedBuffer;
+  b->sortedBuffer = b->agentBuffer;
+  b->agentBuffer = thinned;
+}
+
+// Keep the running flock, appending freshly spawned agents when growing and
+// thinning them evenly when shrinking
+static void ResizeAgents(Boids *b, int count) {
+  const int oldCount = b->agentCount;
+  const int oldCapacity = b->agentCapacity;
+
+  BoidAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<BoidAgent *>(
+        malloc((count - oldCount) * sizeof(BoidAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, oldCount, count, b->width, b->height,
+                     &b->config.color);
+  }
+
+  if (b->cpu != NULL) {
+    if (BoidsCpuResize(b->cpu, newAgents, count)) {
+      b->agentCount = count;
+    }
+    free(newAgents);
+    return;
+  }
+
+  if (count < oldCount) {
+    ThinAgents(b, count);
+  }
+  const bool resized =
+      SimResizeAgentBuffer(&b->agentBuffer, &b->agentCapacity, oldCount, count,
+                           sizeof(BoidAgent), newAgents);
+  free(newAgents);
+  if (!resized) {
+    return;
+  }
+  b->agentCount = count;
+
+  if (b->agentCapacity == oldCapacity) {
+    return;
+  }
+
+  // The reorder target swaps with agentBuffer, so it tracks the capacity
+  rlUnloadShaderBuffer(b->sortedBuffer);
+  b->sortedBuffer = rlLoadShaderBuffer(b->agentCapacity * sizeof(BoidAgent),
+                                       NULL, RL_DYNAMIC_COPY);
+  if (b->sortedBuffer == 0 ||
+      !SpatialHashReserve(b->spatialHash, b->agentCapacity)) {
+    TraceLog(LOG_ERROR, "BOIDS: Failed to grow spatial hash, steering without "
+                        "neighbors");
+    FreeCellSort(b);
+  }
+
+  TraceLog(LOG_INFO, "BOIDS: Grew agent buffers to %d agents",
+           b->agentCapacity);
+}
+
+// The trail map follows the screen at 1/gridDivisor scale
+static void SyncTrailGrid(Boids *b) {
+  TrailMapResize(b->trailMap, TrailMapGridSize(b->width, b->config.gridDivisor),
+                 TrailMapGridSize(b->height, b->config.gridDivisor));
+}
+
 void BoidsApplyConfig(Boids *b, const BoidsConfig *newConfig) {
   if (b == NULL || newConfig == NULL) {
     return;
@@ -320,40 +496,13 @@ void BoidsApplyConfig(Boids *b, const BoidsConfig *newConfig) {
       !ColorConfigEquals(&b->config.color, &newConfig->color);
 
   b->config = *newConfig;
+  TrailMapSetActive(b->trailMap, b->config.enabled);
+  SyncTrailGrid(b);
 
   if (needsBufferRealloc) {
-    rlUnloadShaderBuffer(b->agentBuffer);
-    b->agentCount = newAgentCount;
-
-    BoidAgent *agents =
-        static_cast<BoidAgent *>(malloc(b->agentCount * sizeof(BoidAgent)));
-    if (agents == NULL) {
-      b->agentBuffer = 0;
-      return;
-    }
-
-    InitializeAgents(agents, b->agentCount, b->width, b->height,
-                     &b->config.color);
-    b->agentBuffer = rlLoadShaderBuffer(b->agentCount * sizeof(BoidAgent),
-                                        agents, RL_DYNAMIC_COPY);
-    free(agents);
-
-    TrailMapClear(b->trailMap);
-
-    TraceLog(LOG_INFO, "BOIDS: Reallocated buffer for %d agents",
-             b->agentCount);
-
-    // Recreate spatial hash for new agent count (cell size is resolution-based,
-    // doesn't change)
-    SpatialHashUninit(b->spatialHash);
-    b->spatialHash =
-        SpatialHashInit(b->agentCount, CalculateCellSize(b->width, b->height),
-                        b->width, b->height);
-    if (b->spatialHash == NULL) {
-      TraceLog(LOG_ERROR,
-               "BOIDS: Failed to recreate spatial hash on config change");
-    }
-  } else if (needsHueReinit) {
+    ResizeAgents(b, newAgentCount);
+  }
+  if (needsHueReinit) {
     BoidsReset(b);
   }
 }
@@ -365,13 +514,18 @@ void BoidsReset(Boids *b) {
 
   TrailMapClear(b->trailMap);
 
+  if (b->cpu != NULL) {
+    LoadCpuAgents(b);
+    return;
+  }
+
   BoidAgent *agents =
       static_cast<BoidAgent *>(malloc(b->agentCount * sizeof(BoidAgent)));
   if (agents == NULL) {
     return;
   }
 
-  InitializeAgents(agents, b->agentCount, b->width, b->height,
+  InitializeAgents(agents, 0, b->agentCount, b->width, b->height,
                    &b->config.color);
   rlUpdateShaderBuffer(b->agentBuffer, agents,
                        b->agentCount * sizeof(BoidAgent), 0);
@@ -386,13 +540,11 @@ void BoidsResize(Boids *b, int width, int height) {
   b->width = width;
   b->height = height;
 
-  TrailMapResize(b->trailMap, width, height);
+  SyncTrailGrid(b);
 
   // Recreate spatial hash with new resolution
-  SpatialHashUninit(b->spatialHash);
-  b->spatialHash = SpatialHashInit(
-      b->agentCount, CalculateCellSize(width, height), width, height);
-  if (b->spatialHash == NULL) {
+  FreeCellSort(b);
+  if (b->cpu == NULL && !CreateCellSort(b)) {
     TraceLog(LOG_ERROR, "BOIDS: Failed to recreate spatial hash on resize");
   }
 
@@ -408,7 +560,9 @@ void BoidsDrawDebug(const Boids *b) {
   if (b->debugShader.id != 0) {
     BeginShaderMode(b->debugShader);
   }
-  DrawTextureRec(trailTex, {0, 0, (float)b->width, (float)-b->height}, {0, 0},
+  DrawTexturePro(trailTex,
+                 {0, 0, (float)trailTex.width, (float)-trailTex.height},
+                 {0, 0, (float)b->width, (float)b->height}, {0, 0}, 0.0f,
                  WHITE);
   if (b->debugShader.id != 0) {
     EndShaderMode();
@@ -421,6 +575,10 @@ static const char *BOIDS_BOUNDS_MODES[] = {"Toroidal", "Soft Repulsion"};
 
 static void DrawBoidsParams(EffectConfig *e, const ModSources *ms, ImU32) {
   ImGui::SliderInt("Agents##boids", &e->boids.agentCount, 1000, 125000);
+  ImGui::Checkbox("Cell Sort##boids", &e->boids.cellSort);
+  ImGui::SliderFloat("Step Rate##boids", &e->boids.stepRate, 0.0f, 240.0f,
+                     "%.0f Hz");
+  ImGuiDrawTrailGrid("Trail Grid##boids", &e->boids.gridDivisor);
 
   ImGui::SeparatorText("Bounds");
   int boundsMode = (int)e->boids.boundsMode;
@@ -439,8 +597,11 @@ static void DrawBoidsParams(EffectConfig *e, const ModSources *ms, ImU32) {
                     "boids.separationWeight", "%.2f", ms);
   ModulatableSlider("Alignment##boids", &e->boids.alignmentWeight,
                     "boids.alignmentWeight", "%.2f", ms);
+  // Repulsion samples the GPU accumulation texture
+  ImGui::BeginDisabled(SimCpuBackend());
   ImGui::SliderFloat("Accum Repulsion##boids", &e->boids.accumRepulsion, 0.0f,
                      2.0f, "%.2f");
+  ImGui::EndDisabled();
 
   ImGui::SeparatorText("Species");
   ImGui::SliderFloat("Hue Affinity##boids", &e->boids.hueAffinity, 0.0f, 2.0f,
@@ -471,8 +632,10 @@ static void DrawBoidsParams(EffectConfig *e, const ModSources *ms, ImU32) {
 }
 
 void SetupBoidsTrailBoost(PostEffect *pe) {
-  BlendCompositorApply(
-      pe->blendCompositor, TrailMapGetTexture(pe->boids->trailMap),
+  const TrailMap *trailMap = pe->boids->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
       pe->effects.boids.boostIntensity, pe->effects.boids.blendMode);
 }
 
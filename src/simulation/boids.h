@@ -9,6 +9,7 @@
 
 typedef struct TrailMap TrailMap;
 typedef struct SpatialHash SpatialHash;
+typedef struct BoidsCpu BoidsCpu;
 
 typedef struct BoidAgent {
   float x;
@@ -37,9 +38,12 @@ typedef struct BoidsConfig {
   float depositAmount = 0.05f; // Trail brightness (0.01-0.5)
   float decayHalfLife = 0.5f;  // Trail persistence in seconds (0.1-5.0)
   int diffusionScale = 1;      // Blur kernel size (0-4)
+  float stepRate = 0.0f;       // Fixed steps per second (0 = every frame)
+  int gridDivisor = 1;         // Trail grid downsample per axis (1, 2 or 4)
   float boostIntensity = 1.0f; // Trail boost strength (0.0-5.0)
   EffectBlendMode blendMode = EFFECT_BLEND_SCREEN;
   bool debugOverlay = false;
+  bool cellSort = true; // Keep agents in grid cell order for the neighbor loop
   ColorConfig color;
 } BoidsConfig;
 
@@ -47,15 +51,19 @@ typedef struct BoidsConfig {
   enabled, boundsMode, agentCount, perceptionRadius, separationRadius,         \
       cohesionWeight, separationWeight, alignmentWeight, hueAffinity,          \
       accumRepulsion, maxSpeed, minSpeed, depositAmount, decayHalfLife,        \
-      diffusionScale, boostIntensity, blendMode, debugOverlay, color
+      diffusionScale, boostIntensity, blendMode, debugOverlay, cellSort,       \
+      color, stepRate, gridDivisor
 
 typedef struct Boids {
   unsigned int agentBuffer;
+  unsigned int sortedBuffer; // Reorder target, swapped with agentBuffer
   unsigned int computeProgram;
+  BoidsCpu *cpu; // CPU backend state; NULL on the compute path
   TrailMap *trailMap;
   SpatialHash *spatialHash;
   Shader debugShader;
   int agentCount;
+  int agentCapacity; // Agents the buffers hold; grows, never shrinks
   int width;
   int height;
 
@@ -80,6 +88,7 @@ typedef struct Boids {
   int edgeMarginLoc;
 
   float time;
+  int framesSinceSort;
   BoidsConfig config;
   bool supported;
 } Boids;
@@ -91,13 +100,15 @@ void BoidsRegisterParams(BoidsConfig *cfg);
 bool BoidsSupported(void);
 
 // Initialize boids simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders, steering by
+// the flock only (accumRepulsion is ignored there)
+// Returns NULL if allocation fails
 Boids *BoidsInit(int width, int height, const BoidsConfig *config);
 
 // Clean up boids resources
 void BoidsUninit(Boids *b);
 
-// Dispatch compute shader to update agents
+// Dispatch compute shader (or step the CPU backend) to update agents
 void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
                  Texture2D fftTexture);
 
@@ -105,7 +116,7 @@ void BoidsUpdate(Boids *b, float deltaTime, const Texture2D &accumTexture,
 void BoidsProcessTrails(const Boids *b, float deltaTime);
 
 // Apply config changes (call before update if config may have changed)
-// Handles agent count changes (buffer reallocation)
+// Agent count changes keep the running agents and spawn only the difference
 void BoidsApplyConfig(Boids *b, const BoidsConfig *newConfig);
 
 // Reinitialize agents to random positions
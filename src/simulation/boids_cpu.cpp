@@ -0,0 +1,409 @@
+#include "boids_cpu.h"
+#include "render/color_config.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+
+static const int AGENT_GRAIN = 256; // Agents per worker chunk
+
+// One array per agent field
+struct BoidsSoA {
+  float *x;
+  float *y;
+  float *vx;
+  float *vy;
+  float *hue;
+};
+
+struct BoidsCpu {
+  BoidsSoA agents; // Updated state, in cell order after each step
+  BoidsSoA sorted; // Cell-ordered copy read by the steering pass
+  int *cell;       // Grid cell per agent
+  int *order;      // Agent in each sorted slot
+  int *cellStart;  // Cell c spans [cellStart[c], cellStart[c + 1])
+  int cellCapacity;
+  int count;
+};
+
+// Per-step parameters shared by the worker chunks
+struct StepJob {
+  BoidsCpu *cpu;
+  const BoidsConfig *cfg;
+  float width; // Screen resolution the agents move in
+  float height;
+  int gridWidth;
+  int gridHeight;
+  float cellSize;
+  int scanRadius; // Cells searched around the agent's own, per axis
+  bool toroidal;
+};
+
+// The arrays share one allocation starting at x
+static bool AllocSoA(BoidsSoA *soa, int count) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 5 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  soa->x = block;
+  soa->y = block + (size_t)count;
+  soa->vx = block + (size_t)count * 2;
+  soa->vy = block + (size_t)count * 3;
+  soa->hue = block + (size_t)count * 4;
+  return true;
+}
+
+static void FreeSoA(BoidsSoA *soa) {
+  free(soa->x);
+  *soa = BoidsSoA{};
+}
+
+static void FreeAgents(BoidsCpu *cpu) {
+  FreeSoA(&cpu->agents);
+  FreeSoA(&cpu->sorted);
+  free(cpu->cell);
+  free(cpu->order);
+  cpu->cell = NULL;
+  cpu->order = NULL;
+  cpu->count = 0;
+}
+
+BoidsCpu *BoidsCpuInit(void) {
+  return static_cast<BoidsCpu *>(calloc(1, sizeof(BoidsCpu)));
+}
+
+void BoidsCpuUninit(BoidsCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  FreeAgents(cpu);
+  free(cpu->cellStart);
+  free(cpu);
+}
+
+// Reallocate for count agents, keeping keep of the current state
+static bool ReallocAgents(BoidsCpu *cpu, int count, int keep) {
+  BoidsCpu next = {};
+  next.cell = static_cast<int *>(malloc((size_t)count * sizeof(int)));
+  next.order = static_cast<int *>(malloc((size_t)count * sizeof(int)));
+  if (!AllocSoA(&next.agents, count) || !AllocSoA(&next.sorted, count) ||
+      next.cell == NULL || next.order == NULL) {
+    FreeAgents(&next);
+    return false;
+  }
+
+  // The state is in cell order, so shrinking takes every (count / keep)-th
+  // agent and each cell keeps its share; growing copies them in place
+  const BoidsSoA *src = &cpu->agents;
+  BoidsSoA *dst = &next.agents;
+  for (int i = 0; i < keep; i++) {
+    const size_t s = (size_t)i * cpu->count / keep;
+    dst->x[i] = src->x[s];
+    dst->y[i] = src->y[s];
+    dst->vx[i] = src->vx[s];
+    dst->vy[i] = src->vy[s];
+    dst->hue[i] = src->hue[s];
+  }
+
+  FreeAgents(cpu);
+  cpu->agents = next.agents;
+  cpu->sorted = next.sorted;
+  cpu->cell = next.cell;
+  cpu->order = next.order;
+  cpu->count = count;
+  return true;
+}
+
+// Copy count agents into the state arrays starting at first
+static void StoreAgents(BoidsCpu *cpu, int first, const BoidAgent *agents,
+                        int count) {
+  BoidsSoA *soa = &cpu->agents;
+  for (int i = 0; i < count; i++) {
+    soa->x[first + i] = agents[i].x;
+    soa->y[first + i] = agents[i].y;
+    soa->vx[first + i] = agents[i].vx;
+    soa->vy[first + i] = agents[i].vy;
+    soa->hue[first + i] = agents[i].hue;
+  }
+}
+
+bool BoidsCpuLoad(BoidsCpu *cpu, const BoidAgent *agents, int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !ReallocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool BoidsCpuResize(BoidsCpu *cpu, const BoidAgent *newAgents, int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !ReallocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+// GLSL mod: the result takes the sign of m
+static float Mod(float x, float m) { return x - m * floorf(x / m); }
+
+// Grid cell along one axis of a position wrapped onto the screen
+static int CellCoord(float v, float extent, float cellSize, int cells) {
+  const int c = (int)floorf(Mod(v, extent) / cellSize);
+  return c < 0 ? 0 : (c >= cells ? cells - 1 : c);
+}
+
+static void BinAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const BoidsSoA *a = &job->cpu->agents;
+  for (int i = begin; i < end; i++) {
+    const int cx = CellCoord(a->x[i], job->width, job->cellSize,
+                             job->gridWidth);
+    const int cy = CellCoord(a->y[i], job->height, job->cellSize,
+                             job->gridHeight);
+    job->cpu->cell[i] = cy * job->gridWidth + cx;
+  }
+}
+
+// Copy the agents into sorted in cell order
+static void SortByCell(BoidsCpu *cpu, int cellCount) {
+  SimCpuBinByCell(cpu->cell, cpu->count, cellCount, cpu->cellStart,
+                  cpu->order);
+
+  const BoidsSoA *a = &cpu->agents;
+  BoidsSoA *s = &cpu->sorted;
+  for (int k = 0; k < cpu->count; k++) {
+    const int i = cpu->order[k];
+    s->x[k] = a->x[i];
+    s->y[k] = a->y[i];
+    s->vx[k] = a->vx[i];
+    s->vy[k] = a->vy[i];
+    s->hue[k] = a->hue[i];
+  }
+}
+
+// Circular hue distance (handles wrap at 0/1 boundary)
+static float HueDistance(float a, float b) {
+  const float d = fabsf(a - b);
+  return fminf(d, 1.0f - d);
+}
+
+// Quadratic push away from an edge within margin of it
+static float EdgeForce(float v, float extent, float margin) {
+  float force = 0.0f;
+  if (v < margin) {
+    const float t = 1.0f - v / margin;
+    force += t * t;
+  }
+  if (v > extent - margin) {
+    const float t = (v - (extent - margin)) / margin;
+    force -= t * t;
+  }
+  return force;
+}
+
+// Sorted agent i -> agents[i]: the compute shader's steering, per agent
+static void SteerAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const BoidsConfig *cfg = job->cfg;
+  const BoidsSoA *s = &job->cpu->sorted;
+  BoidsSoA *a = &job->cpu->agents;
+  const int *cellStart = job->cpu->cellStart;
+  const int gw = job->gridWidth;
+  const int gh = job->gridHeight;
+
+  for (int i = begin; i < end; i++) {
+    float px = s->x[i];
+    float py = s->y[i];
+    float vx = s->vx[i];
+    float vy = s->vy[i];
+    const float hue = s->hue[i];
+
+    float cohesionX = 0.0f;
+    float cohesionY = 0.0f;
+    float separationX = 0.0f;
+    float separationY = 0.0f;
+    float alignmentX = 0.0f;
+    float alignmentY = 0.0f;
+    float cohesionWeight = 0.0f;
+    float alignmentWeight = 0.0f;
+
+    const int cx = CellCoord(px, job->width, job->cellSize, gw);
+    const int cy = CellCoord(py, job->height, job->cellSize, gh);
+    for (int dy = -job->scanRadius; dy <= job->scanRadius; dy++) {
+      for (int dx = -job->scanRadius; dx <= job->scanRadius; dx++) {
+        // Toroidal wrap for neighbor cell (double-mod handles scanRadius >
+        // grid size)
+        const int nx = ((cx + dx) % gw + gw) % gw;
+        const int ny = ((cy + dy) % gh + gh) % gh;
+        const int c = ny * gw + nx;
+        for (int j = cellStart[c]; j < cellStart[c + 1]; j++) {
+          if (j == i) {
+            continue;
+          }
+
+          float deltaX = s->x[j] - px;
+          float deltaY = s->y[j] - py;
+          if (job->toroidal) {
+            deltaX = Mod(deltaX + job->width * 0.5f, job->width) -
+                     job->width * 0.5f;
+            deltaY = Mod(deltaY + job->height * 0.5f, job->height) -
+                     job->height * 0.5f;
+          }
+          const float dist = sqrtf(deltaX * deltaX + deltaY * deltaY);
+          const float hueDist = HueDistance(s->hue[j], hue);
+
+          if (dist < cfg->perceptionRadius) {
+            const float affinity = 1.0f - hueDist * cfg->hueAffinity;
+            cohesionX += deltaX * affinity;
+            cohesionY += deltaY * affinity;
+            cohesionWeight += affinity;
+            alignmentX += s->vx[j] * affinity;
+            alignmentY += s->vy[j] * affinity;
+            alignmentWeight += affinity;
+          }
+
+          if (dist < cfg->separationRadius && dist > 0.0f) {
+            const float repulsion =
+                (1.0f + hueDist * cfg->hueAffinity * 2.0f) / (dist * dist);
+            separationX -= deltaX * repulsion;
+            separationY -= deltaY * repulsion;
+          }
+        }
+      }
+    }
+
+    if (cohesionWeight > 0.001f) {
+      vx += cohesionX / cohesionWeight * 0.01f * cfg->cohesionWeight;
+      vy += cohesionY / cohesionWeight * 0.01f * cfg->cohesionWeight;
+    }
+    vx += separationX * cfg->separationWeight;
+    vy += separationY * cfg->separationWeight;
+    if (alignmentWeight > 0.001f) {
+      vx += (alignmentX / alignmentWeight - s->vx[i]) * 0.125f *
+            cfg->alignmentWeight;
+      vy += (alignmentY / alignmentWeight - s->vy[i]) * 0.125f *
+            cfg->alignmentWeight;
+    }
+
+    // Edge avoidance for soft repulsion mode, perception radius wide
+    const float margin = cfg->perceptionRadius;
+    if (!job->toroidal && margin > 0.0f) {
+      vx += EdgeForce(px, job->width, margin) * 0.5f;
+      vy += EdgeForce(py, job->height, margin) * 0.5f;
+    }
+
+    const float speed = sqrtf(vx * vx + vy * vy);
+    if (speed > cfg->maxSpeed) {
+      vx = vx / speed * cfg->maxSpeed;
+      vy = vy / speed * cfg->maxSpeed;
+    } else if (speed < cfg->minSpeed && speed > 0.001f) {
+      vx = vx / speed * cfg->minSpeed;
+      vy = vy / speed * cfg->minSpeed;
+    }
+
+    px += vx;
+    py += vy;
+    if (job->toroidal) {
+      px = Mod(px, job->width);
+      py = Mod(py, job->height);
+    } else {
+      px = fminf(fmaxf(px, 0.0f), job->width - 1.0f);
+      py = fminf(fmaxf(py, 0.0f), job->height - 1.0f);
+    }
+
+    a->x[i] = px;
+    a->y[i] = py;
+    a->vx[i] = vx;
+    a->vy[i] = vy;
+    a->hue[i] = hue;
+  }
+}
+
+static void HsvToRgb(float h, float s, float v, float *r, float *g, float *b) {
+  const float k[3] = {1.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float rgb[3];
+  for (int c = 0; c < 3; c++) {
+    const float t = h + k[c];
+    const float p = fabsf((t - floorf(t)) * 6.0f - 3.0f);
+    const float channel = fminf(fmaxf(p - 1.0f, 0.0f), 1.0f);
+    rgb[c] = v * (1.0f + (channel - 1.0f) * s);
+  }
+  *r = rgb[0];
+  *g = rgb[1];
+  *b = rgb[2];
+}
+
+// Grow the cell ranges to cellCount cells. The grid follows the screen, so
+// this only reallocates on resizes past the largest grid so far.
+static bool ReserveCells(BoidsCpu *cpu, int cellCount) {
+  if (cellCount <= cpu->cellCapacity) {
+    return true;
+  }
+  int *cellStart = static_cast<int *>(
+      realloc(cpu->cellStart, ((size_t)cellCount + 1) * sizeof(int)));
+  if (cellStart == NULL) {
+    return false;
+  }
+  cpu->cellStart = cellStart;
+  cpu->cellCapacity = cellCount;
+  return true;
+}
+
+void BoidsCpuStep(BoidsCpu *cpu, const Boids *boids, float cellSize) {
+  if (cpu == NULL || cpu->count == 0 || boids->trailMap->pixels == NULL) {
+    return;
+  }
+  const BoidsConfig *cfg = &boids->config;
+
+  // Same grid as the compute path's spatial hash
+  StepJob job = {};
+  job.cpu = cpu;
+  job.cfg = cfg;
+  job.width = (float)boids->width;
+  job.height = (float)boids->height;
+  job.cellSize = cellSize;
+  job.gridWidth = (int)ceilf(job.width / cellSize);
+  job.gridHeight = (int)ceilf(job.height / cellSize);
+  job.gridWidth = job.gridWidth < 1 ? 1 : job.gridWidth;
+  job.gridHeight = job.gridHeight < 1 ? 1 : job.gridHeight;
+  // Minimum 2 (5x5) to avoid edge artifacts, further for large perception
+  const int perceptionCells = (int)ceilf(cfg->perceptionRadius / cellSize);
+  job.scanRadius = perceptionCells > 2 ? perceptionCells : 2;
+  job.toroidal = cfg->boundsMode == BOIDS_BOUNDS_TOROIDAL;
+
+  const int cellCount = job.gridWidth * job.gridHeight;
+  if (!ReserveCells(cpu, cellCount)) {
+    return;
+  }
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, BinAgents, &job);
+  SortByCell(cpu, cellCount);
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, SteerAgents, &job);
+
+  // Serial: agents sharing a texel must not race on the proportional scaling
+  float saturation;
+  float value;
+  ColorConfigGetSV(&cfg->color, &saturation, &value);
+  for (int i = 0; i < cpu->count; i++) {
+    float r;
+    float g;
+    float b;
+    HsvToRgb(cpu->agents.hue[i], saturation, value, &r, &g, &b);
+    TrailMapDepositScreen(boids->trailMap, cpu->agents.x[i], cpu->agents.y[i],
+                          job.width, job.height, r * cfg->depositAmount,
+                          g * cfg->depositAmount, b * cfg->depositAmount);
+  }
+}
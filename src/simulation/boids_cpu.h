@@ -0,0 +1,33 @@
+#ifndef BOIDS_CPU_H
+#define BOIDS_CPU_H
+
+#include "boids.h"
+#include <stdbool.h>
+
+// CPU backend for Boids. Agents live in SoA arrays. Each step bins them into
+// the compute path's screen grid with a counting sort, steers every agent
+// against the cells around it on the worker pool, and deposits serially into
+// the CPU trail map. accumRepulsion needs the GPU accumulation texture and is
+// ignored.
+typedef struct BoidsCpu BoidsCpu;
+
+// Returns NULL on allocation failure
+BoidsCpu *BoidsCpuInit(void);
+
+void BoidsCpuUninit(BoidsCpu *cpu);
+
+// Replace the agents. Returns false and keeps the old agents when the
+// arrays cannot be allocated.
+bool BoidsCpuLoad(BoidsCpu *cpu, const BoidAgent *agents, int count);
+
+// Resize to count agents, keeping min(current, count) in their current state
+// (an even stride of them when shrinking) and appending newAgents (the
+// count - current new ones) when growing. Returns false and keeps the old
+// agents on allocation failure.
+bool BoidsCpuResize(BoidsCpu *cpu, const BoidAgent *newAgents, int count);
+
+// Advance every agent one step with boids' config over a grid of cellSize
+// cells, depositing into boids' trail map
+void BoidsCpuStep(BoidsCpu *cpu, const Boids *boids, float cellSize);
+
+#endif // BOIDS_CPU_H
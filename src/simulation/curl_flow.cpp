@@ -1,4 +1,5 @@
 #include "curl_flow.h"
+#include "curl_flow_cpu.h"
 #include "automation/mod_sources.h"
 #include "automation/modulation_engine.h"
 #include "config/effect_descriptor.h"
@@ -10,6 +11,8 @@
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
+#include "spatial_hash.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -18,6 +21,8 @@
 
 static const char *COMPUTE_SHADER_PATH = "shaders/curl_flow_agents.glsl";
 static const char *GRADIENT_SHADER_PATH = "shaders/curl_gradient.glsl";
+// Screen tile the reorder pass groups agents by; a few texture cache lines
+static const float SORT_CELL_SIZE = 32.0f;
 
 static void InitializeAgents(CurlFlowAgent *agents, int count, int width,
                              int height) {
@@ -140,12 +145,53 @@ static GLuint LoadGradientProgram(CurlFlow *cf) {
   return program;
 }
 
+// Reorder target and tile hash, both sized to the agent capacity and screen
+static bool CreateCellSort(CurlFlow *cf) {
+  cf->sortedBuffer = rlLoadShaderBuffer(
+      cf->agentCapacity * sizeof(CurlFlowAgent), NULL, RL_DYNAMIC_COPY);
+  if (cf->sortedBuffer == 0) {
+    TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create sorted agent SSBO");
+    return false;
+  }
+
+  cf->spatialHash =
+      SpatialHashInit(cf->agentCapacity, SORT_CELL_SIZE, cf->width, cf->height);
+  if (cf->spatialHash == NULL) {
+    TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create spatial hash");
+    return false;
+  }
+  return true;
+}
+
+static void FreeCellSort(CurlFlow *cf) {
+  if (cf->sortedBuffer != 0) {
+    rlUnloadShaderBuffer(cf->sortedBuffer);
+    cf->sortedBuffer = 0;
+  }
+  SpatialHashUninit(cf->spatialHash);
+  cf->spatialHash = NULL;
+}
+
+// CPU backend: replace the agents with a fresh spawn
+static bool LoadCpuAgents(CurlFlow *cf) {
+  CurlFlowAgent *agents = static_cast<CurlFlowAgent *>(
+      malloc(cf->agentCount * sizeof(CurlFlowAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, cf->agentCount, cf->width, cf->height);
+  const bool loaded = CurlFlowCpuLoad(cf->cpu, agents, cf->agentCount);
+  free(agents);
+  return loaded;
+}
+
 CurlFlow *CurlFlowInit(int width, int height, const CurlFlowConfig *config) {
   if (!CurlFlowSupported()) {
-    TraceLog(LOG_WARNING,
-             "CURL_FLOW: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "CURL_FLOW: Compute shaders not supported (requires "
+                          "OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   CurlFlow *cf = static_cast<CurlFlow *>(calloc(1, sizeof(CurlFlow)));
   if (cf == NULL) {
@@ -162,35 +208,62 @@ CurlFlow *CurlFlowInit(int width, int height, const CurlFlowConfig *config) {
   cf->time = 0.0f;
   cf->supported = true;
 
-  cf->computeProgram = LoadComputeProgram(cf);
-  if (cf->computeProgram == 0) {
-    goto cleanup;
+  if (!cpuBackend) {
+    cf->computeProgram = LoadComputeProgram(cf);
+    if (cf->computeProgram == 0) {
+      goto cleanup;
+    }
   }
 
-  cf->trailMap = TrailMapInit(width, height);
+  cf->trailMap =
+      cpuBackend
+          ? TrailMapInitCpu(TrailMapGridSize(width, cf->config.gridDivisor),
+                            TrailMapGridSize(height, cf->config.gridDivisor))
+          : TrailMapInit(TrailMapGridSize(width, cf->config.gridDivisor),
+                         TrailMapGridSize(height, cf->config.gridDivisor));
   if (cf->trailMap == NULL) {
     TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create trail map");
     goto cleanup;
   }
 
-  cf->colorLUT = ColorLUTInit(&cf->config.color);
-  if (cf->colorLUT == NULL) {
-    TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create color LUT");
-    goto cleanup;
-  }
-
   cf->debugShader = LoadShader(NULL, "shaders/trail_debug.fs");
   if (cf->debugShader.id == 0) {
     TraceLog(LOG_WARNING,
              "CURL_FLOW: Failed to load debug shader, using default");
   }
 
+  if (cpuBackend) {
+    // No cell sort, color texture or gradient pass: the CPU step keeps its
+    // own color table and samples the density gradient from the trails
+    cf->cpu = CurlFlowCpuInit();
+    if (cf->cpu == NULL || !LoadCpuAgents(cf)) {
+      TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create CPU backend");
+      goto cleanup;
+    }
+    TraceLog(LOG_INFO, "CURL_FLOW: Initialized with %d agents at %dx%d on the "
+                       "CPU",
+             cf->agentCount, width, height);
+    return cf;
+  }
+
+  cf->colorLUT = ColorLUTInit(&cf->config.color);
+  if (cf->colorLUT == NULL) {
+    TraceLog(LOG_ERROR, "CURL_FLOW: Failed to create color LUT");
+    goto cleanup;
+  }
+
   cf->agentBuffer = CreateAgentBuffer(cf->agentCount, width, height);
   if (cf->agentBuffer == 0) {
     goto cleanup;
   }
+  cf->agentCapacity = cf->agentCount;
+
+  if (!CreateCellSort(cf)) {
+    goto cleanup;
+  }
 
-  cf->gradientTexture = CreateGradientTexture(width, height);
+  cf->gradientTexture =
+      CreateGradientTexture(cf->trailMap->width, cf->trailMap->height);
   if (cf->gradientTexture == 0) {
     goto cleanup;
   }
@@ -215,6 +288,8 @@ void CurlFlowUninit(CurlFlow *cf) {
   }
 
   rlUnloadShaderBuffer(cf->agentBuffer);
+  CurlFlowCpuUninit(cf->cpu);
+  FreeCellSort(cf);
   TrailMapUninit(cf->trailMap);
   ColorLUTUninit(cf->colorLUT);
   if (cf->debugShader.id != 0) {
@@ -228,21 +303,50 @@ void CurlFlowUninit(CurlFlow *cf) {
   free(cf);
 }
 
+// Brightness the color LUT entries are scaled by when depositing
+static float DepositValue(const ColorConfig *color) {
+  float value;
+  if (color->mode == COLOR_MODE_SOLID) {
+    float h;
+    float s;
+    ColorConfigRGBToHSV(color->solid, &h, &s, &value);
+  } else if (color->mode == COLOR_MODE_GRADIENT) {
+    value = 1.0f;
+  } else if (color->mode == COLOR_MODE_PALETTE) {
+    float s;
+    ColorConfigGetSV(color, &s, &value);
+  } else {
+    value = color->rainbowVal;
+  }
+  return value;
+}
+
 void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture) {
   if (cf == NULL || !cf->supported || !cf->config.enabled) {
     return;
   }
 
   cf->time += deltaTime;
+
+  if (cf->cpu != NULL) {
+    CurlFlowCpuStep(cf->cpu, cf, DepositValue(&cf->config.color));
+    return;
+  }
   const float resolution[2] = {(float)cf->width, (float)cf->height};
 
   // Dispatch gradient pass when trail influence is active
   if (cf->config.trailInfluence >= 0.001f) {
     rlEnableShader(cf->gradientProgram);
 
-    rlSetUniform(cf->gradResolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
-    rlSetUniform(cf->gradRadiusLoc, &cf->config.gradientRadius,
-                 RL_SHADER_UNIFORM_FLOAT, 1);
+    // The gradient matches the trail grid; its radius stays in screen pixels
+    const int gridWidth = cf->trailMap->width;
+    const int gridHeight = cf->trailMap->height;
+    const float gridResolution[2] = {(float)gridWidth, (float)gridHeight};
+    const float gridRadius =
+        cf->config.gradientRadius * (float)gridWidth / (float)cf->width;
+    rlSetUniform(cf->gradResolutionLoc, gridResolution, RL_SHADER_UNIFORM_VEC2,
+                 1);
+    rlSetUniform(cf->gradRadiusLoc, &gridRadius, RL_SHADER_UNIFORM_FLOAT, 1);
     rlSetUniform(cf->gradAccumBlendLoc, &cf->config.accumSenseBlend,
                  RL_SHADER_UNIFORM_FLOAT, 1);
 
@@ -253,8 +357,8 @@ void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture) {
     glBindImageTexture(2, cf->gradientTexture, 0, GL_FALSE, 0, GL_WRITE_ONLY,
                        GL_RGBA16F);
 
-    const int workGroupX = (cf->width + 15) / 16;
-    const int workGroupY = (cf->height + 15) / 16;
+    const int workGroupX = (gridWidth + 15) / 16;
+    const int workGroupY = (gridHeight + 15) / 16;
     rlComputeShaderDispatch((unsigned int)workGroupX, (unsigned int)workGroupY,
                             1);
 
@@ -263,6 +367,27 @@ void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture) {
     rlDisableShader();
   }
 
+  // Every few frames, gather the agents into screen tile order so each
+  // workgroup's gradient fetches and deposits touch neighboring texels
+  if (cf->config.cellSort && cf->spatialHash != NULL &&
+      ++cf->framesSinceSort >= SPATIAL_HASH_SORT_INTERVAL) {
+    SpatialHashBuild(cf->spatialHash, cf->agentBuffer, cf->agentCount,
+                     (int)sizeof(CurlFlowAgent), 0);
+    SpatialHashReorder(cf->spatialHash, cf->agentBuffer, cf->sortedBuffer,
+                       cf->agentCount, (int)sizeof(CurlFlowAgent));
+    const unsigned int sorted = cf->sortedBuffer;
+    cf->sortedBuffer = cf->agentBuffer;
+    cf->agentBuffer = sorted;
+    cf->framesSinceSort = 0;
+  }
+
+  // Downsampled grids splat deposits into the trail map's atomic sums
+  const bool accumulate = cf->trailMap->width != cf->width ||
+                          cf->trailMap->height != cf->height;
+  if (accumulate && !TrailMapBindDeposits(cf->trailMap)) {
+    return;
+  }
+
   rlEnableShader(cf->computeProgram);
 
   rlSetUniform(cf->resolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
@@ -286,22 +411,11 @@ void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture) {
   rlSetUniform(cf->respawnProbabilityLoc, &cf->config.respawnProbability,
                RL_SHADER_UNIFORM_FLOAT, 1);
 
-  float value;
-  if (cf->config.color.mode == COLOR_MODE_SOLID) {
-    float h;
-    float s;
-    ColorConfigRGBToHSV(cf->config.color.solid, &h, &s, &value);
-  } else if (cf->config.color.mode == COLOR_MODE_GRADIENT) {
-    value = 1.0f;
-  } else if (cf->config.color.mode == COLOR_MODE_PALETTE) {
-    float s;
-    ColorConfigGetSV(&cf->config.color, &s, &value);
-  } else {
-    value = cf->config.color.rainbowVal;
-  }
+  const float value = DepositValue(&cf->config.color);
   rlSetUniform(cf->valueLoc, &value, RL_SHADER_UNIFORM_FLOAT, 1);
 
-  rlBindShaderBuffer(cf->agentBuffer, 0);
+  SimBindAgentBuffer(cf->agentBuffer, 0, cf->agentCount,
+                     sizeof(CurlFlowAgent));
   rlBindImageTexture(TrailMapGetTexture(cf->trailMap).id, 1,
                      RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
   glActiveTexture(GL_TEXTURE2);
@@ -319,6 +433,10 @@ void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture) {
                   GL_TEXTURE_FETCH_BARRIER_BIT);
 
   rlDisableShader();
+
+  if (accumulate) {
+    TrailMapResolveDeposits(cf->trailMap);
+  }
 }
 
 void CurlFlowProcessTrails(const CurlFlow *cf, float deltaTime) {
@@ -330,6 +448,27 @@ void CurlFlowProcessTrails(const CurlFlow *cf, float deltaTime) {
                   cf->config.diffusionScale);
 }
 
+// The trail map and density gradient follow the screen at 1/gridDivisor
+// scale
+static void SyncTrailGrid(CurlFlow *cf) {
+  const int gridWidth = TrailMapGridSize(cf->width, cf->config.gridDivisor);
+  const int gridHeight = TrailMapGridSize(cf->height, cf->config.gridDivisor);
+  if (gridWidth == cf->trailMap->width && gridHeight == cf->trailMap->height) {
+    return;
+  }
+
+  TrailMapResize(cf->trailMap, gridWidth, gridHeight);
+
+  // The CPU step samples the trails directly: no gradient texture
+  if (cf->cpu != NULL) {
+    return;
+  }
+  if (cf->gradientTexture != 0) {
+    glDeleteTextures(1, &cf->gradientTexture);
+  }
+  cf->gradientTexture = CreateGradientTexture(gridWidth, gridHeight);
+}
+
 void CurlFlowResize(CurlFlow *cf, int width, int height) {
   if (cf == NULL || (width == cf->width && height == cf->height)) {
     return;
@@ -338,13 +477,13 @@ void CurlFlowResize(CurlFlow *cf, int width, int height) {
   cf->width = width;
   cf->height = height;
 
-  TrailMapResize(cf->trailMap, width, height);
+  SyncTrailGrid(cf);
 
-  // Recreate gradient texture at new size
-  if (cf->gradientTexture != 0) {
-    glDeleteTextures(1, &cf->gradientTexture);
+  // Tile grid follows the screen
+  FreeCellSort(cf);
+  if (cf->cpu == NULL && !CreateCellSort(cf)) {
+    TraceLog(LOG_ERROR, "CURL_FLOW: Failed to recreate cell sort on resize");
   }
-  cf->gradientTexture = CreateGradientTexture(width, height);
 
   CurlFlowReset(cf);
 }
@@ -356,6 +495,11 @@ void CurlFlowReset(CurlFlow *cf) {
 
   TrailMapClear(cf->trailMap);
 
+  if (cf->cpu != NULL) {
+    LoadCpuAgents(cf);
+    return;
+  }
+
   CurlFlowAgent *agents = static_cast<CurlFlowAgent *>(
       malloc(cf->agentCount * sizeof(CurlFlowAgent)));
   if (agents == NULL) {
@@ -368,6 +512,76 @@ void CurlFlowReset(CurlFlow *cf) {
   free(agents);
 }
 
+// Shrink to count agents in place, taking every (agentCount / count)-th agent
+// in tile order so each tile keeps its share rather than the regions at the
+// buffer tail emptying
+static void ThinAgents(CurlFlow *cf, int count) {
+  if (cf->spatialHash == NULL || cf->sortedBuffer == 0) {
+    return;
+  }
+
+  SpatialHashBuild(cf->spatialHash, cf->agentBuffer, cf->agentCount,
+                   (int)sizeof(CurlFlowAgent), 0);
+  SpatialHashThin(cf->spatialHash, cf->agentBuffer, cf->sortedBuffer,
+                  cf->agentCount, count, (int)sizeof(CurlFlowAgent));
+  const unsigned int thinned = cf->sortedBuffer;
+  cf->sortedBuffer = cf->agentBuffer;
+  cf->agentBuffer = thinned;
+}
+
+// Keep the running agents, appending freshly spawned ones when growing and
+// thinning them evenly when shrinking
+static void ResizeAgents(CurlFlow *cf, int count) {
+  const int oldCount = cf->agentCount;
+  const int oldCapacity = cf->agentCapacity;
+
+  CurlFlowAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<CurlFlowAgent *>(
+        malloc((count - oldCount) * sizeof(CurlFlowAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, count - oldCount, cf->width, cf->height);
+  }
+
+  if (cf->cpu != NULL) {
+    if (CurlFlowCpuResize(cf->cpu, newAgents, count)) {
+      cf->agentCount = count;
+    }
+    free(newAgents);
+    return;
+  }
+
+  if (count < oldCount) {
+    ThinAgents(cf, count);
+  }
+  const bool resized =
+      SimResizeAgentBuffer(&cf->agentBuffer, &cf->agentCapacity, oldCount,
+                           count, sizeof(CurlFlowAgent), newAgents);
+  free(newAgents);
+  if (!resized) {
+    return;
+  }
+  cf->agentCount = count;
+
+  if (cf->agentCapacity == oldCapacity) {
+    return;
+  }
+
+  // The reorder target swaps with agentBuffer, so it tracks the capacity
+  rlUnloadShaderBuffer(cf->sortedBuffer);
+  cf->sortedBuffer = rlLoadShaderBuffer(
+      cf->agentCapacity * sizeof(CurlFlowAgent), NULL, RL_DYNAMIC_COPY);
+  if (cf->sortedBuffer == 0 ||
+      !SpatialHashReserve(cf->spatialHash, cf->agentCapacity)) {
+    FreeCellSort(cf);
+  }
+
+  TraceLog(LOG_INFO, "CURL_FLOW: Grew agent buffers to %d agents",
+           cf->agentCapacity);
+}
+
 void CurlFlowApplyConfig(CurlFlow *cf, const CurlFlowConfig *newConfig) {
   if (cf == NULL || newConfig == NULL) {
     return;
@@ -382,27 +596,11 @@ void CurlFlowApplyConfig(CurlFlow *cf, const CurlFlowConfig *newConfig) {
 
   ColorLUTUpdate(cf->colorLUT, &newConfig->color);
   cf->config = *newConfig;
+  TrailMapSetActive(cf->trailMap, cf->config.enabled);
+  SyncTrailGrid(cf);
 
   if (needsBufferRealloc) {
-    rlUnloadShaderBuffer(cf->agentBuffer);
-    cf->agentCount = newAgentCount;
-
-    CurlFlowAgent *agents = static_cast<CurlFlowAgent *>(
-        malloc(cf->agentCount * sizeof(CurlFlowAgent)));
-    if (agents == NULL) {
-      cf->agentBuffer = 0;
-      return;
-    }
-
-    InitializeAgents(agents, cf->agentCount, cf->width, cf->height);
-    cf->agentBuffer = rlLoadShaderBuffer(cf->agentCount * sizeof(CurlFlowAgent),
-                                         agents, RL_DYNAMIC_COPY);
-    free(agents);
-
-    TrailMapClear(cf->trailMap);
-
-    TraceLog(LOG_INFO, "CURL_FLOW: Reallocated buffer for %d agents",
-             cf->agentCount);
+    ResizeAgents(cf, newAgentCount);
   }
 }
 
@@ -415,7 +613,9 @@ void CurlFlowDrawDebug(const CurlFlow *cf) {
   if (cf->debugShader.id != 0) {
     BeginShaderMode(cf->debugShader);
   }
-  DrawTextureRec(trailTex, {0, 0, (float)cf->width, (float)-cf->height}, {0, 0},
+  DrawTexturePro(trailTex,
+                 {0, 0, (float)trailTex.width, (float)-trailTex.height},
+                 {0, 0, (float)cf->width, (float)cf->height}, {0, 0}, 0.0f,
                  WHITE);
   if (cf->debugShader.id != 0) {
     EndShaderMode();
@@ -424,6 +624,10 @@ void CurlFlowDrawDebug(const CurlFlow *cf) {
 
 static void DrawCurlFlowParams(EffectConfig *e, const ModSources *, ImU32) {
   ImGui::SliderInt("Agents##curl", &e->curlFlow.agentCount, 1000, 1000000);
+  ImGui::Checkbox("Cell Sort##curl", &e->curlFlow.cellSort);
+  ImGui::SliderFloat("Step Rate##curl", &e->curlFlow.stepRate, 0.0f, 240.0f,
+                     "%.0f Hz");
+  ImGuiDrawTrailGrid("Trail Grid##curl", &e->curlFlow.gridDivisor);
 
   ImGui::SeparatorText("Field");
   ImGui::SliderFloat("Frequency", &e->curlFlow.noiseFrequency, 0.001f, 0.1f,
@@ -435,8 +639,11 @@ static void DrawCurlFlowParams(EffectConfig *e, const ModSources *, ImU32) {
   ImGui::SeparatorText("Sensing");
   ImGui::SliderFloat("Density Influence", &e->curlFlow.trailInfluence, 0.0f,
                      1.0f, "%.2f");
+  // Accum sensing needs the GPU accumulation texture
+  ImGui::BeginDisabled(SimCpuBackend());
   ImGui::SliderFloat("Sense Blend##curl", &e->curlFlow.accumSenseBlend, 0.0f,
                      1.0f, "%.2f");
+  ImGui::EndDisabled();
   ImGui::SliderFloat("Gradient Radius", &e->curlFlow.gradientRadius, 1.0f,
                      32.0f, "%.0f px");
 
@@ -470,8 +677,10 @@ void CurlFlowRegisterParams(CurlFlowConfig *cfg) {
 }
 
 void SetupCurlFlowTrailBoost(PostEffect *pe) {
-  BlendCompositorApply(
-      pe->blendCompositor, TrailMapGetTexture(pe->curlFlow->trailMap),
+  const TrailMap *trailMap = pe->curlFlow->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
       pe->effects.curlFlow.boostIntensity, pe->effects.curlFlow.blendMode);
 }
 
@@ -7,7 +7,9 @@
 #include <stdbool.h>
 
 typedef struct TrailMap TrailMap;
+typedef struct SpatialHash SpatialHash;
 typedef struct ColorLUT ColorLUT;
+typedef struct CurlFlowCpu CurlFlowCpu;
 
 typedef struct CurlFlowAgent {
   float x;
@@ -33,25 +35,33 @@ typedef struct CurlFlowConfig {
   float depositAmount = 0.1f;      // Trail deposit strength (0.01-0.2)
   float decayHalfLife = 1.0f;      // Seconds for 50% decay (0.1-5.0)
   int diffusionScale = 1;          // Diffusion kernel scale in pixels (0-4)
+  float stepRate = 0.0f;           // Fixed steps per second (0 = every frame)
+  int gridDivisor = 1;             // Trail grid downsample per axis (1, 2 or 4)
   float boostIntensity = 1.0f;     // Trail boost strength (0.0-5.0)
   EffectBlendMode blendMode = EFFECT_BLEND_SCREEN;
   ColorConfig color;
   bool debugOverlay = false;
+  bool cellSort = true; // Keep agents in screen tile order for texture access
 } CurlFlowConfig;
 
 #define CURL_FLOW_CONFIG_FIELDS                                                \
   enabled, agentCount, noiseFrequency, noiseEvolution, momentum,               \
       trailInfluence, accumSenseBlend, gradientRadius, stepSize,               \
       respawnProbability, depositAmount, decayHalfLife, diffusionScale,        \
-      boostIntensity, blendMode, color, debugOverlay
+      boostIntensity, blendMode, color, debugOverlay, cellSort, stepRate,      \
+      gridDivisor
 
 typedef struct CurlFlow {
   unsigned int agentBuffer;
+  unsigned int sortedBuffer; // Reorder target, swapped with agentBuffer
   unsigned int computeProgram;
+  CurlFlowCpu *cpu; // CPU backend state; NULL on the compute path
   TrailMap *trailMap;
+  SpatialHash *spatialHash; // Screen tiles for the reorder pass
   ColorLUT *colorLUT;
   Shader debugShader;
   int agentCount;
+  int agentCapacity; // Agents the buffers hold; grows, never shrinks
   int width;
   int height;
   // Agent shader uniforms
@@ -74,6 +84,7 @@ typedef struct CurlFlow {
   int gradRadiusLoc;
   int gradAccumBlendLoc;
   float time;
+  int framesSinceSort;
   CurlFlowConfig config;
   bool supported;
 } CurlFlow;
@@ -82,13 +93,15 @@ typedef struct CurlFlow {
 bool CurlFlowSupported(void);
 
 // Initialize curl flow simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders, sensing the
+// trails only (accumSenseBlend is ignored there)
+// Returns NULL if allocation fails
 CurlFlow *CurlFlowInit(int width, int height, const CurlFlowConfig *config);
 
 // Clean up curl flow resources
 void CurlFlowUninit(CurlFlow *cf);
 
-// Dispatch compute shader to update agents
+// Dispatch compute shader (or step the CPU backend) to update agents
 void CurlFlowUpdate(CurlFlow *cf, float deltaTime, Texture2D accumTexture);
 
 // Process trails with diffusion and decay (call after CurlFlowUpdate)
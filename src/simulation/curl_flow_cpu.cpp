@@ -0,0 +1,385 @@
+#include "curl_flow_cpu.h"
+#include "render/color_config.h"
+#include "render/color_lut.h"
+#include "render/draw_utils.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+
+static const int AGENT_GRAIN = 256; // Agents per worker chunk
+static const float PI = 3.14159265f;
+static const float LUMA_R = 0.299f; // Rec. 601, as in curl_gradient.glsl
+static const float LUMA_G = 0.587f;
+static const float LUMA_B = 0.114f;
+
+struct CurlFlowCpu {
+  float *x;
+  float *y;
+  float *angle; // Velocity angle, for the deposit color
+  int count;
+  float lut[COLOR_LUT_SIZE * 3]; // Deposit color by velocity angle
+  ColorConfig lutColor;
+  bool lutValid;
+};
+
+// Config for one step, shared by the worker chunks
+struct StepJob {
+  CurlFlowCpu *cpu;
+  const CurlFlowConfig *cfg;
+  const float *trail; // CPU trail map pixels, read-only while steering
+  int gridWidth;
+  int gridHeight;
+  float width; // Screen resolution the agents move in
+  float height;
+  float time;
+  float gridRadius; // Gradient sample distance in trail texels
+};
+
+// The arrays share one allocation starting at x. keep agents carry over.
+static bool AllocAgents(CurlFlowCpu *cpu, int count, int keep) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 3 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  float *x = block;
+  float *y = block + (size_t)count;
+  float *angle = block + (size_t)count * 2;
+  // Shrinking takes every (count / keep)-th agent so the survivors stay
+  // spread over the screen; growing copies them in place
+  for (int i = 0; i < keep; i++) {
+    const size_t src = (size_t)i * cpu->count / keep;
+    x[i] = cpu->x[src];
+    y[i] = cpu->y[src];
+    angle[i] = cpu->angle[src];
+  }
+  free(cpu->x);
+  cpu->x = x;
+  cpu->y = y;
+  cpu->angle = angle;
+  cpu->count = count;
+  return true;
+}
+
+CurlFlowCpu *CurlFlowCpuInit(void) {
+  return static_cast<CurlFlowCpu *>(calloc(1, sizeof(CurlFlowCpu)));
+}
+
+void CurlFlowCpuUninit(CurlFlowCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  free(cpu->x);
+  free(cpu);
+}
+
+// Copy count agents into the state arrays starting at first
+static void StoreAgents(CurlFlowCpu *cpu, int first,
+                        const CurlFlowAgent *agents, int count) {
+  for (int i = 0; i < count; i++) {
+    cpu->x[first + i] = agents[i].x;
+    cpu->y[first + i] = agents[i].y;
+    cpu->angle[first + i] = agents[i].velocityAngle;
+  }
+}
+
+bool CurlFlowCpuLoad(CurlFlowCpu *cpu, const CurlFlowAgent *agents,
+                     int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool CurlFlowCpuResize(CurlFlowCpu *cpu, const CurlFlowAgent *newAgents,
+                       int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+void CurlFlowCpuSetColor(CurlFlowCpu *cpu, const ColorConfig *color) {
+  if (cpu == NULL || color == NULL ||
+      (cpu->lutValid && ColorConfigEquals(&cpu->lutColor, color))) {
+    return;
+  }
+
+  for (int i = 0; i < COLOR_LUT_SIZE; i++) {
+    const float t = (float)i / (float)(COLOR_LUT_SIZE - 1);
+    const Color c = ColorFromConfig(color, t, 1.0f);
+    cpu->lut[i * 3] = (float)c.r / 255.0f;
+    cpu->lut[i * 3 + 1] = (float)c.g / 255.0f;
+    cpu->lut[i * 3 + 2] = (float)c.b / 255.0f;
+  }
+  cpu->lutColor = *color;
+  cpu->lutValid = true;
+}
+
+// GLSL mod: the result takes the sign of m
+static float Mod(float x, float m) { return x - m * floorf(x / m); }
+
+static float Fract(float x) { return x - floorf(x); }
+
+// The shader's hash11; correlated for sequential ids (intentional there)
+static float Hash11(float p) {
+  p = Fract(p * 0.1031f);
+  p *= p + 33.33f;
+  p *= p + p;
+  return Fract(p);
+}
+
+static float Mod289(float x) {
+  return x - floorf(x * (1.0f / 289.0f)) * 289.0f;
+}
+
+static float Permute(float x) { return Mod289((x * 34.0f + 1.0f) * x); }
+
+// The shader's snoise3_grad, one simplex corner at a time. Writes the noise
+// value and its x and y derivatives; the flow never uses the z one.
+static void SimplexGrad(float vx, float vy, float vz, float *value, float *dx,
+                        float *dy) {
+  const float cx = 1.0f / 6.0f;
+  const float cy = 1.0f / 3.0f;
+
+  const float skew = (vx + vy + vz) * cy;
+  float i[3] = {floorf(vx + skew), floorf(vy + skew), floorf(vz + skew)};
+  const float unskew = (i[0] + i[1] + i[2]) * cx;
+  const float x0[3] = {vx - i[0] + unskew, vy - i[1] + unskew,
+                       vz - i[2] + unskew};
+
+  // Corner offsets: 0, i1, i2, 1 (i1 and i2 from the simplex ordering)
+  const float g[3] = {x0[0] >= x0[1] ? 1.0f : 0.0f,
+                      x0[1] >= x0[2] ? 1.0f : 0.0f,
+                      x0[2] >= x0[0] ? 1.0f : 0.0f};
+  float offset[4][3];
+  for (int k = 0; k < 3; k++) {
+    const float l = 1.0f - g[(k + 2) % 3];
+    offset[0][k] = 0.0f;
+    offset[1][k] = fminf(g[k], l);
+    offset[2][k] = fmaxf(g[k], l);
+    offset[3][k] = 1.0f;
+  }
+  const float cornerBias[4] = {0.0f, cx, cy, 0.5f};
+
+  for (int k = 0; k < 3; k++) {
+    i[k] = Mod289(i[k]);
+  }
+
+  const float n = 0.142857142857f;
+  const float nsX = n * 2.0f;
+  const float nsY = n * 0.5f - 1.0f;
+  const float nsZ = n;
+
+  float sum = 0.0f;
+  float gradX = 0.0f;
+  float gradY = 0.0f;
+  for (int c = 0; c < 4; c++) {
+    const float x[3] = {x0[0] - offset[c][0] + cornerBias[c],
+                        x0[1] - offset[c][1] + cornerBias[c],
+                        x0[2] - offset[c][2] + cornerBias[c]};
+
+    const float pz = Permute(i[2] + offset[c][2]);
+    const float py = Permute(pz + i[1] + offset[c][1]);
+    const float p = Permute(py + i[0] + offset[c][0]);
+    const float j = p - 49.0f * floorf(p * nsZ * nsZ);
+    const float xf = floorf(j * nsZ);
+    const float yf = floorf(j - 7.0f * xf);
+    const float gx = xf * nsX + nsY;
+    const float gy = yf * nsX + nsY;
+    const float h = 1.0f - fabsf(gx) - fabsf(gy);
+    const float sh = h <= 0.0f ? -1.0f : 0.0f;
+    float grad[3] = {gx + (floorf(gx) * 2.0f + 1.0f) * sh,
+                     gy + (floorf(gy) * 2.0f + 1.0f) * sh, h};
+    const float norm =
+        1.79284291400159f -
+        0.85373472095314f *
+            (grad[0] * grad[0] + grad[1] * grad[1] + grad[2] * grad[2]);
+    for (int k = 0; k < 3; k++) {
+      grad[k] *= norm;
+    }
+
+    const float m =
+        fmaxf(0.6f - (x[0] * x[0] + x[1] * x[1] + x[2] * x[2]), 0.0f);
+    const float m2 = m * m;
+    const float m4 = m2 * m2;
+    const float pdotx = grad[0] * x[0] + grad[1] * x[1] + grad[2] * x[2];
+    const float temp = m2 * m * pdotx;
+    gradX += -8.0f * temp * x[0] + m4 * grad[0];
+    gradY += -8.0f * temp * x[1] + m4 * grad[1];
+    sum += m4 * pdotx;
+  }
+
+  *value = 42.0f * sum;
+  *dx = 42.0f * gradX;
+  *dy = 42.0f * gradY;
+}
+
+// Bilinear trail luma at a grid position in texels, clamped to the edges
+static float TrailDensity(const StepJob *job, float gx, float gy) {
+  gx = fminf(fmaxf(gx - 0.5f, 0.0f), (float)(job->gridWidth - 1));
+  gy = fminf(fmaxf(gy - 0.5f, 0.0f), (float)(job->gridHeight - 1));
+  const int x0 = (int)gx;
+  const int y0 = (int)gy;
+  const int x1 = x0 + 1 < job->gridWidth ? x0 + 1 : x0;
+  const int y1 = y0 + 1 < job->gridHeight ? y0 + 1 : y0;
+  const float fx = gx - (float)x0;
+  const float fy = gy - (float)y0;
+
+  float luma[4];
+  const int xs[2] = {x0, x1};
+  const int ys[2] = {y0, y1};
+  for (int c = 0; c < 4; c++) {
+    const float *t =
+        job->trail + ((size_t)ys[c >> 1] * job->gridWidth + xs[c & 1]) * 4;
+    luma[c] = t[0] * LUMA_R + t[1] * LUMA_G + t[2] * LUMA_B;
+  }
+  const float top = luma[0] + (luma[1] - luma[0]) * fx;
+  const float bottom = luma[2] + (luma[3] - luma[2]) * fx;
+  return top + (bottom - top) * fy;
+}
+
+// computeModulatedCurl (Bridson 2007), sampling the density and its central
+// differences straight from the trails rather than a precomputed map
+static void ModulatedCurl(const StepJob *job, float px, float py, float *cx,
+                          float *cy) {
+  const CurlFlowConfig *cfg = job->cfg;
+  const float evolveTime = Mod(job->time * cfg->noiseEvolution, 1000.0f);
+  float potential;
+  float dx;
+  float dy;
+  SimplexGrad(px * cfg->noiseFrequency, py * cfg->noiseFrequency, evolveTime,
+              &potential, &dx, &dy);
+  const float influence = cfg->trailInfluence;
+  if (influence < 0.001f) {
+    *cx = dy;
+    *cy = -dx;
+    return;
+  }
+
+  const float gx = px * (float)job->gridWidth / job->width;
+  const float gy = py * (float)job->gridHeight / job->height;
+  const float r = job->gridRadius;
+  const float gradX =
+      (TrailDensity(job, gx + r, gy) - TrailDensity(job, gx - r, gy)) * 0.5f;
+  const float gradY =
+      (TrailDensity(job, gx, gy + r) - TrailDensity(job, gx, gy - r)) * 0.5f;
+  const float density = TrailDensity(job, gx, gy);
+
+  // Ramp: 1 near zero density, 0 near full density. Product rule:
+  // curl(ramp * P) = ramp * curl(P) + P * curl(ramp)
+  const float ramp = 1.0f - fminf(fmaxf(density * influence, 0.0f), 1.0f);
+  const float rampGradX = -influence * gradX;
+  const float rampGradY = -influence * gradY;
+  *cx = ramp * dy * cfg->noiseFrequency + potential * rampGradY;
+  *cy = -ramp * dx * cfg->noiseFrequency - potential * rampGradX;
+}
+
+static void MoveAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const CurlFlowConfig *cfg = job->cfg;
+  CurlFlowCpu *cpu = job->cpu;
+
+  for (int i = begin; i < end; i++) {
+    float px = cpu->x[i];
+    float py = cpu->y[i];
+    float angle = cpu->angle[i];
+    const float id = (float)i;
+
+    // Probabilistic respawn, hashed on the agent index like the shader
+    if (cfg->respawnProbability > 0.0f) {
+      const float roll =
+          Hash11(id * 12.9898f + Mod(job->time * 17.3f, 1000.0f));
+      if (roll < cfg->respawnProbability) {
+        const float evolveTime =
+            Mod(job->time * cfg->noiseEvolution, 1000.0f);
+        px = Hash11(id * 78.233f + evolveTime) * job->width;
+        py = Hash11(id * 43.317f + evolveTime + 100.0f) * job->height;
+        angle = Hash11(id + evolveTime * 0.7f) * 2.0f * PI - PI;
+      }
+    }
+
+    float curlX;
+    float curlY;
+    ModulatedCurl(job, px, py, &curlX, &curlY);
+
+    // Near-zero curl keeps the previous direction
+    const float currentX = cosf(angle);
+    const float currentY = sinf(angle);
+    const float curlLen = sqrtf(curlX * curlX + curlY * curlY);
+    const float targetX = curlLen > 0.001f ? curlX / curlLen : currentX;
+    const float targetY = curlLen > 0.001f ? curlY / curlLen : currentY;
+
+    // Momentum blends from the current direction toward the target
+    const float blend = 1.0f - cfg->momentum;
+    float dirX = currentX + (targetX - currentX) * blend;
+    float dirY = currentY + (targetY - currentY) * blend;
+    const float dirLen = sqrtf(dirX * dirX + dirY * dirY);
+    if (dirLen > 0.0f) {
+      dirX /= dirLen;
+      dirY /= dirLen;
+    } else {
+      dirX = currentX;
+      dirY = currentY;
+    }
+
+    px = Mod(Mod(px + dirX * cfg->stepSize, job->width) + job->width,
+             job->width);
+    py = Mod(Mod(py + dirY * cfg->stepSize, job->height) + job->height,
+             job->height);
+
+    cpu->x[i] = px;
+    cpu->y[i] = py;
+    cpu->angle[i] = atan2f(dirY, dirX);
+  }
+}
+
+void CurlFlowCpuStep(CurlFlowCpu *cpu, const CurlFlow *cf, float value) {
+  if (cpu == NULL || cpu->count == 0 || cf->trailMap->pixels == NULL) {
+    return;
+  }
+  const CurlFlowConfig *cfg = &cf->config;
+  CurlFlowCpuSetColor(cpu, &cfg->color);
+
+  StepJob job = {};
+  job.cpu = cpu;
+  job.cfg = cfg;
+  job.trail = cf->trailMap->pixels;
+  job.gridWidth = cf->trailMap->width;
+  job.gridHeight = cf->trailMap->height;
+  job.width = (float)cf->width;
+  job.height = (float)cf->height;
+  job.time = cf->time;
+  // The gradient radius stays in screen pixels on a downsampled grid
+  job.gridRadius = cfg->gradientRadius * (float)job.gridWidth / job.width;
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, MoveAgents, &job);
+
+  // Serial: agents sharing a texel must not race on the proportional scaling
+  const float scale = value * cfg->depositAmount;
+  for (int i = 0; i < cpu->count; i++) {
+    const float t = (cpu->angle[i] + PI) / (2.0f * PI);
+    int entry = (int)(t * (float)(COLOR_LUT_SIZE - 1) + 0.5f);
+    entry = entry < 0 ? 0 : entry;
+    entry = entry < COLOR_LUT_SIZE ? entry : COLOR_LUT_SIZE - 1;
+    const float *color = cpu->lut + entry * 3;
+    TrailMapDepositScreen(cf->trailMap, cpu->x[i], cpu->y[i], job.width,
+                          job.height, color[0] * scale, color[1] * scale,
+                          color[2] * scale);
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef CURL_FLOW_CPU_H
+#define CURL_FLOW_CPU_H
+
+#include "curl_flow.h"
+#include <stdbool.h>
+
+// CPU backend for Curl Flow. Agents live in SoA arrays and follow the curl
+// noise field on the worker pool, bending around density they sample from
+// the CPU trail map, then deposit serially. accumSenseBlend needs the GPU
+// accumulation texture and is ignored.
+typedef struct CurlFlowCpu CurlFlowCpu;
+
+// Returns NULL on allocation failure
+CurlFlowCpu *CurlFlowCpuInit(void);
+
+void CurlFlowCpuUninit(CurlFlowCpu *cpu);
+
+// Replace the agents. Returns false and keeps the old agents when the
+// arrays cannot be allocated.
+bool CurlFlowCpuLoad(CurlFlowCpu *cpu, const CurlFlowAgent *agents, int count);
+
+// Resize to count agents, keeping min(current, count) in their current state
+// (an even stride of them when shrinking) and appending newAgents (the
+// count - current new ones) when growing. Returns false and keeps the old
+// agents on allocation failure.
+bool CurlFlowCpuResize(CurlFlowCpu *cpu, const CurlFlowAgent *newAgents,
+                       int count);
+
+// Regenerate the deposit color table if color changed, as ColorLUTUpdate
+// does for the compute path
+void CurlFlowCpuSetColor(CurlFlowCpu *cpu, const ColorConfig *color);
+
+// Advance every agent one step with cf's config and time, depositing table
+// colors scaled by value into cf's trail map
+void CurlFlowCpuStep(CurlFlowCpu *cpu, const CurlFlow *cf, float value);
+
+#endif // CURL_FLOW_CPU_H
@@ -1,4 +1,5 @@
 #include "maze_worms.h"
+#include "maze_worms_cpu.h"
 #include "automation/mod_sources.h"
 #include "automation/modulation_engine.h"
 #include "config/effect_descriptor.h"
@@ -10,6 +11,7 @@
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -17,19 +19,22 @@
 #include <stdlib.h>
 
 static const char *COMPUTE_SHADER_PATH = "shaders/maze_worm_agents.glsl";
+static const char *RESPAWN_SHADER_PATH = "shaders/maze_worm_respawn.glsl";
 static const int MARGIN = 10;
 
-static void InitializeAgents(MazeWormAgent *agents, int count, int width,
-                             int height, const ColorConfig *color) {
-  for (int i = 0; i < count; i++) {
-    agents[i].x = (float)(GetRandomValue(MARGIN, width - 1 - MARGIN));
-    agents[i].y = (float)(GetRandomValue(MARGIN, height - 1 - MARGIN));
-    agents[i].angle = (float)GetRandomValue(0, 628) / 100.0f;
-    agents[i].age = 1.0f;
-    agents[i].alive = 1.0f;
-    agents[i].hue = ColorConfigAgentHue(color, i, count);
-    agents[i].respawnTimer = 0.0f;
-    agents[i]._pad = 0.0f;
+// Fill agents[0..count-first) with agents first..count-1 of count
+static void InitializeAgents(MazeWormAgent *agents, int first, int count,
+                             int width, int height, const ColorConfig *color) {
+  for (int i = first; i < count; i++) {
+    MazeWormAgent *agent = &agents[i - first];
+    agent->x = (float)(GetRandomValue(MARGIN, width - 1 - MARGIN));
+    agent->y = (float)(GetRandomValue(MARGIN, height - 1 - MARGIN));
+    agent->angle = (float)GetRandomValue(0, 628) / 100.0f;
+    agent->age = 1.0f;
+    agent->alive = 1.0f;
+    agent->hue = ColorConfigAgentHue(color, i, count);
+    agent->respawnTimer = 0.0f;
+    agent->_pad = 0.0f;
   }
 }
 
@@ -65,15 +70,56 @@ static GLuint LoadComputeProgram(MazeWorms *mw) {
   mw->turnAngleLoc = rlGetLocationUniform(program, "turnAngle");
   mw->trailWidthLoc = rlGetLocationUniform(program, "trailWidth");
   mw->collisionGapLoc = rlGetLocationUniform(program, "collisionGap");
-  mw->timeLoc = rlGetLocationUniform(program, "time");
   mw->gradientLUTLoc = rlGetLocationUniform(program, "gradientLUT");
   mw->respawnCooldownLoc = rlGetLocationUniform(program, "respawnCooldown");
-  mw->stepDeltaTimeLoc = rlGetLocationUniform(program, "stepDeltaTime");
   mw->moveSpeedLoc = rlGetLocationUniform(program, "moveSpeed");
 
   return program;
 }
 
+static GLuint LoadRespawnProgram(MazeWorms *mw) {
+  char *shaderSource = SimLoadShaderSource(RESPAWN_SHADER_PATH);
+  if (shaderSource == NULL) {
+    return 0;
+  }
+
+  const unsigned int shaderId =
+      rlCompileShader(shaderSource, RL_COMPUTE_SHADER);
+  UnloadFileText(shaderSource);
+
+  if (shaderId == 0) {
+    TraceLog(LOG_ERROR, "MAZE_WORMS: Failed to compile respawn shader");
+    return 0;
+  }
+
+  const GLuint program = rlLoadComputeShaderProgram(shaderId);
+  if (program == 0) {
+    TraceLog(LOG_ERROR, "MAZE_WORMS: Failed to load respawn shader program");
+    return 0;
+  }
+
+  mw->respawnResolutionLoc = rlGetLocationUniform(program, "resolution");
+  mw->respawnTrailWidthLoc = rlGetLocationUniform(program, "trailWidth");
+  mw->respawnCollisionGapLoc = rlGetLocationUniform(program, "collisionGap");
+  mw->respawnTimeLoc = rlGetLocationUniform(program, "time");
+  mw->respawnStepDeltaTimeLoc = rlGetLocationUniform(program, "stepDeltaTime");
+  mw->respawnRebuildLoc = rlGetLocationUniform(program, "rebuild");
+
+  return program;
+}
+
+// Grow all four index lists to hold count worms
+static bool ReserveLists(MazeWorms *mw, int count) {
+  for (int i = 0; i < 2; i++) {
+    if (!SimLiveListReserve(&mw->liveLists[i], count) ||
+        !SimLiveListReserve(&mw->deadLists[i], count)) {
+      TraceLog(LOG_ERROR, "MAZE_WORMS: Failed to create agent index lists");
+      return false;
+    }
+  }
+  return true;
+}
+
 static GLuint CreateAgentBuffer(int agentCount, int width, int height,
                                 const ColorConfig *color) {
   MazeWormAgent *agents =
@@ -82,7 +128,7 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
     return 0;
   }
 
-  InitializeAgents(agents, agentCount, width, height, color);
+  InitializeAgents(agents, 0, agentCount, width, height, color);
   const GLuint buffer = rlLoadShaderBuffer(agentCount * sizeof(MazeWormAgent),
                                            agents, RL_DYNAMIC_COPY);
   free(agents);
@@ -93,12 +139,27 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
   return buffer;
 }
 
+// CPU backend: replace the worms with a fresh spawn
+static bool LoadCpuAgents(MazeWorms *mw) {
+  MazeWormAgent *agents = static_cast<MazeWormAgent *>(
+      malloc(mw->agentCount * sizeof(MazeWormAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, 0, mw->agentCount, mw->width, mw->height,
+                   &mw->config.color);
+  const bool loaded = MazeWormsCpuLoad(mw->cpu, agents, mw->agentCount);
+  free(agents);
+  return loaded;
+}
+
 MazeWorms *MazeWormsInit(int width, int height, const MazeWormsConfig *config) {
   if (!MazeWormsSupported()) {
-    TraceLog(LOG_WARNING,
-             "MAZE_WORMS: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "MAZE_WORMS: Compute shaders not supported "
+                          "(requires OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   MazeWorms *mw = static_cast<MazeWorms *>(calloc(1, sizeof(MazeWorms)));
   if (mw == NULL) {
@@ -115,11 +176,30 @@ MazeWorms *MazeWormsInit(int width, int height, const MazeWormsConfig *config) {
   mw->time = 0.0f;
   mw->supported = true;
 
+  if (cpuBackend) {
+    // Colors come from the CPU backend's own copy of the gradient
+    mw->cpu = MazeWormsCpuInit();
+    mw->trailMap = TrailMapInitCpu(width, height);
+    if (mw->cpu == NULL || mw->trailMap == NULL || !LoadCpuAgents(mw)) {
+      TraceLog(LOG_ERROR, "MAZE_WORMS: Failed to create CPU backend");
+      goto cleanup;
+    }
+    TraceLog(LOG_INFO, "MAZE_WORMS: Initialized with %d agents at %dx%d on "
+                       "the CPU",
+             mw->agentCount, width, height);
+    return mw;
+  }
+
   mw->computeProgram = LoadComputeProgram(mw);
   if (mw->computeProgram == 0) {
     goto cleanup;
   }
 
+  mw->respawnProgram = LoadRespawnProgram(mw);
+  if (mw->respawnProgram == 0) {
+    goto cleanup;
+  }
+
   mw->trailMap = TrailMapInit(width, height);
   if (mw->trailMap == NULL) {
     TraceLog(LOG_ERROR, "MAZE_WORMS: Failed to create trail map");
@@ -138,6 +218,12 @@ MazeWorms *MazeWormsInit(int width, int height, const MazeWormsConfig *config) {
   if (mw->agentBuffer == 0) {
     goto cleanup;
   }
+  mw->agentCapacity = mw->agentCount;
+
+  if (!ReserveLists(mw, mw->agentCapacity)) {
+    goto cleanup;
+  }
+  mw->listsStale = true;
 
   TraceLog(LOG_INFO, "MAZE_WORMS: Initialized with %d agents at %dx%d",
            mw->agentCount, width, height);
@@ -154,25 +240,114 @@ void MazeWormsUninit(MazeWorms *mw) {
   }
 
   rlUnloadShaderBuffer(mw->agentBuffer);
+  MazeWormsCpuUninit(mw->cpu);
   TrailMapUninit(mw->trailMap);
   ColorLUTUninit(mw->colorLUT);
   rlUnloadShaderProgram(mw->computeProgram);
+  rlUnloadShaderProgram(mw->respawnProgram);
+  for (int i = 0; i < 2; i++) {
+    SimLiveListUninit(&mw->liveLists[i]);
+    SimLiveListUninit(&mw->deadLists[i]);
+  }
   free(mw);
 }
 
+// Bind the agents, the trail map, the list a kernel walks and the pair it
+// appends to
+static void BindStepBuffers(const MazeWorms *mw, const SimLiveList *source,
+                            int target) {
+  SimBindAgentBuffer(mw->agentBuffer, 0, mw->agentCount,
+                     sizeof(MazeWormAgent));
+  rlBindImageTexture(TrailMapGetTexture(mw->trailMap).id, 1,
+                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  SimLiveListBind(source, 2);
+  SimLiveListBind(&mw->liveLists[target], 3);
+  SimLiveListBind(&mw->deadLists[target], 4);
+}
+
+static void SetRespawnUniforms(const MazeWorms *mw, float stepDt,
+                               int rebuild) {
+  const float resolution[2] = {(float)mw->width, (float)mw->height};
+  rlSetUniform(mw->respawnResolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2,
+               1);
+  rlSetUniform(mw->respawnTrailWidthLoc, &mw->config.trailWidth,
+               RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(mw->respawnCollisionGapLoc, &mw->config.collisionGap,
+               RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(mw->respawnTimeLoc, &mw->time, RL_SHADER_UNIFORM_FLOAT, 1);
+  rlSetUniform(mw->respawnStepDeltaTimeLoc, &stepDt, RL_SHADER_UNIFORM_FLOAT,
+               1);
+  rlSetUniform(mw->respawnRebuildLoc, &rebuild, RL_SHADER_UNIFORM_INT, 1);
+}
+
+// Sort every agent into the current live or dead list by its alive flag,
+// after the CPU rewrote or resized the agent buffer
+static void RebuildLists(MazeWorms *mw) {
+  const int current = mw->listIndex;
+  SimLiveListClear(&mw->liveLists[current]);
+  SimLiveListClear(&mw->deadLists[current]);
+
+  rlEnableShader(mw->respawnProgram);
+  SetRespawnUniforms(mw, 0.0f, 1);
+  // Rebuild never reads the source list; bind the idle pair's to satisfy it
+  BindStepBuffers(mw, &mw->deadLists[1 - current], current);
+
+  const int groupSize = SIM_LIVE_LIST_GROUP_SIZE;
+  const int numGroups = (mw->agentCount + groupSize - 1) / groupSize;
+  rlComputeShaderDispatch((unsigned int)numGroups, 1, 1);
+
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+  rlDisableShader();
+
+  mw->listsStale = false;
+}
+
 void MazeWormsUpdate(MazeWorms *mw, float deltaTime) {
-  if (mw == NULL || !mw->supported || !mw->config.enabled ||
-      mw->agentBuffer == 0) {
+  if (mw == NULL || !mw->supported || !mw->config.enabled) {
+    return;
+  }
+
+  if (mw->cpu != NULL) {
+    mw->time += deltaTime;
+    const int steps = static_cast<int>(mw->config.stepsPerFrame);
+    const float stepDt = deltaTime / static_cast<float>(steps);
+    for (int step = 0; step < steps; step++) {
+      MazeWormsCpuStep(mw->cpu, mw, stepDt);
+    }
+    return;
+  }
+
+  if (mw->agentBuffer == 0 || mw->liveLists[0].capacity < mw->agentCount) {
     return;
   }
 
   mw->time += deltaTime;
 
+  if (mw->listsStale) {
+    RebuildLists(mw);
+  }
+
   const float resolution[2] = {(float)mw->width, (float)mw->height};
   const int turningMode = (int)mw->config.turningMode;
 
   const int steps = static_cast<int>(mw->config.stepsPerFrame);
+  const float stepDt = deltaTime / static_cast<float>(steps);
   for (int step = 0; step < steps; step++) {
+    const int current = mw->listIndex;
+    const int next = 1 - current;
+    SimLiveListClear(&mw->liveLists[next]);
+    SimLiveListClear(&mw->deadLists[next]);
+
+    // Dead worms: count down and respawn onto empty cells
+    rlEnableShader(mw->respawnProgram);
+    SetRespawnUniforms(mw, stepDt, 0);
+    BindStepBuffers(mw, &mw->deadLists[current], next);
+    SimLiveListDispatch(&mw->deadLists[current]);
+
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                    GL_SHADER_STORAGE_BARRIER_BIT);
+
+    // Live worms: steer, move and deposit
     rlEnableShader(mw->computeProgram);
 
     rlSetUniform(mw->resolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
@@ -185,11 +360,8 @@ void MazeWormsUpdate(MazeWorms *mw, float deltaTime) {
                  RL_SHADER_UNIFORM_FLOAT, 1);
     rlSetUniform(mw->collisionGapLoc, &mw->config.collisionGap,
                  RL_SHADER_UNIFORM_FLOAT, 1);
-    rlSetUniform(mw->timeLoc, &mw->time, RL_SHADER_UNIFORM_FLOAT, 1);
     rlSetUniform(mw->respawnCooldownLoc, &mw->config.respawnCooldown,
                  RL_SHADER_UNIFORM_FLOAT, 1);
-    const float stepDt = deltaTime / static_cast<float>(steps);
-    rlSetUniform(mw->stepDeltaTimeLoc, &stepDt, RL_SHADER_UNIFORM_FLOAT, 1);
     rlSetUniform(mw->moveSpeedLoc, &mw->config.moveSpeed,
                  RL_SHADER_UNIFORM_FLOAT, 1);
 
@@ -197,18 +369,14 @@ void MazeWormsUpdate(MazeWorms *mw, float deltaTime) {
     glBindTexture(GL_TEXTURE_2D, ColorLUTGetTexture(mw->colorLUT).id);
     glUniform1i(mw->gradientLUTLoc, 0);
 
-    rlBindShaderBuffer(mw->agentBuffer, 0);
-    rlBindImageTexture(TrailMapGetTexture(mw->trailMap).id, 1,
-                       RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
-
-    const int workGroupSize = 1024;
-    const int numGroups = (mw->agentCount + workGroupSize - 1) / workGroupSize;
-    rlComputeShaderDispatch((unsigned int)numGroups, 1, 1);
+    BindStepBuffers(mw, &mw->liveLists[current], next);
+    SimLiveListDispatch(&mw->liveLists[current]);
 
     glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
                     GL_SHADER_STORAGE_BARRIER_BIT);
 
     rlDisableShader();
+    mw->listIndex = next;
   }
 }
 
@@ -240,17 +408,23 @@ void MazeWormsReset(MazeWorms *mw) {
 
   TrailMapClear(mw->trailMap);
 
+  if (mw->cpu != NULL) {
+    LoadCpuAgents(mw);
+    return;
+  }
+
   MazeWormAgent *agents = static_cast<MazeWormAgent *>(
       malloc(mw->agentCount * sizeof(MazeWormAgent)));
   if (agents == NULL) {
     return;
   }
 
-  InitializeAgents(agents, mw->agentCount, mw->width, mw->height,
+  InitializeAgents(agents, 0, mw->agentCount, mw->width, mw->height,
                    &mw->config.color);
   rlUpdateShaderBuffer(mw->agentBuffer, agents,
                        mw->agentCount * sizeof(MazeWormAgent), 0);
   free(agents);
+  mw->listsStale = true;
 }
 
 void MazeWormsRegisterParams(MazeWormsConfig *cfg) {
@@ -271,6 +445,40 @@ void MazeWormsRegisterParams(MazeWormsConfig *cfg) {
                          2.0f);
 }
 
+// Keep the running worms, appending fresh ones when growing and dropping the
+// tail when shrinking; the maze carved so far stays in the trail map
+static void ResizeAgents(MazeWorms *mw, int count) {
+  const int oldCount = mw->agentCount;
+
+  MazeWormAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<MazeWormAgent *>(
+        malloc((count - oldCount) * sizeof(MazeWormAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, oldCount, count, mw->width, mw->height,
+                     &mw->config.color);
+  }
+
+  if (mw->cpu != NULL) {
+    if (MazeWormsCpuResize(mw->cpu, newAgents, count)) {
+      mw->agentCount = count;
+    }
+    free(newAgents);
+    return;
+  }
+
+  if (ReserveLists(mw, count) &&
+      SimResizeAgentBuffer(&mw->agentBuffer, &mw->agentCapacity, oldCount,
+                           count, sizeof(MazeWormAgent), newAgents)) {
+    mw->agentCount = count;
+  }
+  // Growing the lists discards them, so re-sort even if the resize failed
+  mw->listsStale = true;
+  free(newAgents);
+}
+
 void MazeWormsApplyConfig(MazeWorms *mw, const MazeWormsConfig *newConfig) {
   if (mw == NULL || newConfig == NULL) {
     return;
@@ -287,29 +495,12 @@ void MazeWormsApplyConfig(MazeWorms *mw, const MazeWormsConfig *newConfig) {
 
   ColorLUTUpdate(mw->colorLUT, &newConfig->color);
   mw->config = *newConfig;
+  TrailMapSetActive(mw->trailMap, mw->config.enabled);
 
   if (needsBufferRealloc) {
-    rlUnloadShaderBuffer(mw->agentBuffer);
-    mw->agentCount = newWormCount;
-
-    MazeWormAgent *agents = static_cast<MazeWormAgent *>(
-        malloc(mw->agentCount * sizeof(MazeWormAgent)));
-    if (agents == NULL) {
-      mw->agentBuffer = 0;
-      return;
-    }
-
-    InitializeAgents(agents, mw->agentCount, mw->width, mw->height,
-                     &mw->config.color);
-    mw->agentBuffer = rlLoadShaderBuffer(mw->agentCount * sizeof(MazeWormAgent),
-                                         agents, RL_DYNAMIC_COPY);
-    free(agents);
-
-    TrailMapClear(mw->trailMap);
-
-    TraceLog(LOG_INFO, "MAZE_WORMS: Reallocated buffer for %d agents",
-             mw->agentCount);
-  } else if (needsHueReinit) {
+    ResizeAgents(mw, newWormCount);
+  }
+  if (needsHueReinit) {
     MazeWormsReset(mw);
   }
 }
@@ -323,6 +514,8 @@ static const int TURNING_MODE_COUNT = 4;
 static void DrawMazeWormsParams(EffectConfig *e, const ModSources *ms, ImU32) {
   ImGui::SeparatorText("Simulation");
   ImGui::SliderInt("Worm Count", &e->mazeWorms.wormCount, 4, 1000);
+  ImGui::SliderFloat("Step Rate##maze", &e->mazeWorms.stepRate, 0.0f, 240.0f,
+                     "%.0f Hz");
   int turningMode = (int)e->mazeWorms.turningMode;
   if (ImGui::Combo("Turning Mode", &turningMode, TURNING_MODE_NAMES,
                    TURNING_MODE_COUNT)) {
@@ -366,8 +559,10 @@ void SetupMazeWormsTrailBoost(PostEffect *pe) {
   if (pe->mazeWorms == NULL) {
     return;
   }
-  BlendCompositorApply(
-      pe->blendCompositor, TrailMapGetTexture(pe->mazeWorms->trailMap),
+  const TrailMap *trailMap = pe->mazeWorms->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
       pe->effects.mazeWorms.boostIntensity, pe->effects.mazeWorms.blendMode);
 }
 
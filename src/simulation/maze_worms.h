@@ -6,10 +6,12 @@
 #include "raylib.h"
 #include "render/blend_mode.h"
 #include "render/color_config.h"
+#include "shader_utils.h"
 #include <stdbool.h>
 
 typedef struct TrailMap TrailMap;
 typedef struct ColorLUT ColorLUT;
+typedef struct MazeWormsCpu MazeWormsCpu;
 
 typedef enum {
   MAZE_WORM_TURN_SPIRAL = 0, // angle += curvature / age
@@ -43,8 +45,9 @@ typedef struct MazeWormsConfig {
   float trailWidth = 1.5f;      // Smoothstep circle radius in pixels (0.5-5.0)
   float decayHalfLife = 8.0f;   // Trail persistence in seconds (0.5-30.0)
   int diffusionScale = 0;       // Trail blur radius in pixels (0-5)
+  float stepRate = 0.0f;        // Fixed steps per second (0 = every frame)
   float respawnCooldown = 0.5f; // Seconds before dead worm respawns (0.0-5.0)
-  float stepsPerFrame = 2.0f;   // Agent steps per frame (1-8)
+  float stepsPerFrame = 2.0f;   // Agent moves per simulation step (1-8)
   float moveSpeed = 1.0f;       // Pixels per step (0.1-5.0)
   float collisionGap = 2.0f;    // Lookahead beyond trail width (0.0-5.0 pixels)
   float boostIntensity = 1.0f;  // Blend intensity (0.0-2.0)
@@ -55,14 +58,23 @@ typedef struct MazeWormsConfig {
 #define MAZE_WORMS_CONFIG_FIELDS                                               \
   enabled, wormCount, turningMode, curvature, turnAngle, trailWidth,           \
       decayHalfLife, diffusionScale, respawnCooldown, stepsPerFrame,           \
-      moveSpeed, collisionGap, boostIntensity, blendMode, color
+      moveSpeed, collisionGap, boostIntensity, blendMode, color, stepRate
 
 typedef struct MazeWorms {
   unsigned int agentBuffer;    // SSBO for agent data
   unsigned int computeProgram; // Agent update compute shader
+  unsigned int respawnProgram; // Dead agent countdown and respawn shader
+  // Ping-pong index lists: each step walks liveLists/deadLists[listIndex] and
+  // appends every worm's next state to the other pair
+  SimLiveList liveLists[2];
+  SimLiveList deadLists[2];
+  int listIndex;
+  bool listsStale; // Agents changed on the CPU; re-sort before the next step
+  MazeWormsCpu *cpu;  // CPU backend state; NULL on the compute path
   TrailMap *trailMap; // Shared trail infrastructure (diffusion + decay)
   ColorLUT *colorLUT; // Gradient texture for agent coloring
   int agentCount;     // Current agent count (tracks config changes)
+  int agentCapacity;  // Agents agentBuffer holds; grows, never shrinks
   int width;
   int height;
 
@@ -73,12 +85,18 @@ typedef struct MazeWorms {
   int turnAngleLoc;
   int trailWidthLoc;
   int collisionGapLoc;
-  int timeLoc;
   int gradientLUTLoc;
   int respawnCooldownLoc;
-  int stepDeltaTimeLoc;
   int moveSpeedLoc;
 
+  // Respawn shader uniform locations
+  int respawnResolutionLoc;
+  int respawnTrailWidthLoc;
+  int respawnCollisionGapLoc;
+  int respawnTimeLoc;
+  int respawnStepDeltaTimeLoc;
+  int respawnRebuildLoc;
+
   float time;             // Animation time accumulator
   MazeWormsConfig config; // Cached config for change detection
   bool supported;
@@ -88,13 +106,15 @@ typedef struct MazeWorms {
 bool MazeWormsSupported(void);
 
 // Initialize maze worms simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders
+// Returns NULL if allocation fails
 MazeWorms *MazeWormsInit(int width, int height, const MazeWormsConfig *config);
 
 // Clean up maze worms resources
 void MazeWormsUninit(MazeWorms *mw);
 
-// Dispatch compute shader to update agents
+// Dispatch compute shaders to update agents; only live worms run the update
+// kernel, dead ones run a small respawn kernel (both sized indirectly)
 void MazeWormsUpdate(MazeWorms *mw, float deltaTime);
 
 // Process trails with diffusion and decay (call after MazeWormsUpdate)
@@ -110,7 +130,7 @@ void MazeWormsReset(MazeWorms *mw);
 void MazeWormsRegisterParams(MazeWormsConfig *cfg);
 
 // Apply config changes (call before update if config may have changed)
-// Handles worm count changes (buffer reallocation)
+// Worm count changes keep the running worms and spawn only the difference
 void MazeWormsApplyConfig(MazeWorms *mw, const MazeWormsConfig *newConfig);
 
 #endif // MAZE_WORMS_H
@@ -0,0 +1,340 @@
+#include "maze_worms_cpu.h"
+#include "render/color_config.h"
+#include "render/color_lut.h"
+#include "render/draw_utils.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const int AGENT_GRAIN = 64;    // Worms per worker chunk
+static const float TWO_PI = 6.2832f;  // The shaders' heading wrap
+static const float WALL_ALPHA = 0.1f; // Trail alpha that blocks a probe
+static const int MAX_TURN_ATTEMPTS = 128;
+
+// What a worm did this step, for the serial deposit and respawn pass
+enum WormMove { WORM_IDLE = 0, WORM_MOVED = 1, WORM_KILLED = 2 };
+
+struct MazeWormsCpu {
+  float *x;
+  float *y;
+  float *angle;
+  float *age;
+  float *alive;
+  float *hue;
+  float *respawnTimer;
+  int *move; // WormMove per worm, rewritten every step
+  int count;
+  float palette[COLOR_LUT_SIZE * 3]; // CPU copy of the gradient LUT
+  ColorConfig paletteColor;
+  bool paletteValid;
+};
+
+// Config for one step, shared by the worker chunks
+struct StepJob {
+  MazeWormsCpu *cpu;
+  const float *trail; // CPU trail map pixels, read-only while steering
+  int width;
+  int height;
+  MazeWormTurningMode turningMode;
+  float curvature;
+  float turnAngle;
+  float trailWidth;
+  float collisionGap;
+  float respawnCooldown;
+  float moveSpeed;
+};
+
+// The arrays share one allocation starting at x. The first keep worms carry
+// over; move is rewritten every step.
+static bool AllocAgents(MazeWormsCpu *cpu, int count, int keep) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 8 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  float *arrays[7];
+  for (int i = 0; i < 7; i++) {
+    arrays[i] = block + (size_t)count * i;
+  }
+  if (keep > 0) {
+    const size_t bytes = (size_t)keep * sizeof(float);
+    memcpy(arrays[0], cpu->x, bytes);
+    memcpy(arrays[1], cpu->y, bytes);
+    memcpy(arrays[2], cpu->angle, bytes);
+    memcpy(arrays[3], cpu->age, bytes);
+    memcpy(arrays[4], cpu->alive, bytes);
+    memcpy(arrays[5], cpu->hue, bytes);
+    memcpy(arrays[6], cpu->respawnTimer, bytes);
+  }
+  free(cpu->x);
+  cpu->x = arrays[0];
+  cpu->y = arrays[1];
+  cpu->angle = arrays[2];
+  cpu->age = arrays[3];
+  cpu->alive = arrays[4];
+  cpu->hue = arrays[5];
+  cpu->respawnTimer = arrays[6];
+  cpu->move = reinterpret_cast<int *>(block + (size_t)count * 7);
+  cpu->count = count;
+  return true;
+}
+
+MazeWormsCpu *MazeWormsCpuInit(void) {
+  return static_cast<MazeWormsCpu *>(calloc(1, sizeof(MazeWormsCpu)));
+}
+
+void MazeWormsCpuUninit(MazeWormsCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  free(cpu->x);
+  free(cpu);
+}
+
+// Copy count worms into the state arrays starting at first
+static void StoreAgents(MazeWormsCpu *cpu, int first,
+                        const MazeWormAgent *agents, int count) {
+  for (int i = 0; i < count; i++) {
+    cpu->x[first + i] = agents[i].x;
+    cpu->y[first + i] = agents[i].y;
+    cpu->angle[first + i] = agents[i].angle;
+    cpu->age[first + i] = agents[i].age;
+    cpu->alive[first + i] = agents[i].alive;
+    cpu->hue[first + i] = agents[i].hue;
+    cpu->respawnTimer[first + i] = agents[i].respawnTimer;
+  }
+}
+
+bool MazeWormsCpuLoad(MazeWormsCpu *cpu, const MazeWormAgent *agents,
+                      int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool MazeWormsCpuResize(MazeWormsCpu *cpu, const MazeWormAgent *newAgents,
+                        int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+static float TrailAlpha(const StepJob *job, float px, float py) {
+  const size_t pixel = (size_t)(int)py * job->width + (int)px;
+  return job->trail[pixel * 4 + 3];
+}
+
+// Single-point collision probe at trailWidth + 1 + collisionGap ahead, as in
+// maze_worm_agents.glsl
+static bool ProbeWall(const StepJob *job, float x, float y, float a) {
+  const float reach = job->trailWidth + 1.0f + job->collisionGap;
+  const float px = x + reach * cosf(a);
+  const float py = y + reach * sinf(a);
+  if (px < reach || px > (float)job->width - reach || py < reach ||
+      py > (float)job->height - reach) {
+    return true;
+  }
+  return TrailAlpha(job, px, py) > WALL_ALPHA;
+}
+
+// Turn by turn until the probe clears; false when a full circle is blocked
+static bool Dodge(const StepJob *job, float x, float y, float *a,
+                  float turn) {
+  const float safeAngle = fmaxf(fabsf(job->turnAngle), 0.05f);
+  int maxAttempts = (int)(TWO_PI / safeAngle) + 1;
+  if (maxAttempts > MAX_TURN_ATTEMPTS) {
+    maxAttempts = MAX_TURN_ATTEMPTS;
+  }
+  int attempts = 0;
+  while (ProbeWall(job, x, y, *a) && attempts < maxAttempts) {
+    *a += turn;
+    attempts++;
+  }
+  return attempts < maxAttempts;
+}
+
+// Alternating turn direction per worm: sign(sin(index + 0.5))
+static float Chirality(int i) {
+  return sinf((float)i + 0.5f) >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Steer and move the live worms. Deposits wait for the serial pass, so
+// every worm probes the trails as they stood at the start of the step.
+static void MoveWorms(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  MazeWormsCpu *cpu = job->cpu;
+
+  for (int i = begin; i < end; i++) {
+    if (cpu->alive[i] < 0.5f) {
+      cpu->move[i] = WORM_IDLE;
+      continue;
+    }
+
+    const float x = cpu->x[i];
+    const float y = cpu->y[i];
+    const float age = cpu->age[i];
+    float a = cpu->angle[i];
+    bool clear;
+    switch (job->turningMode) {
+    case MAZE_WORM_TURN_SPIRAL:
+      a += Chirality(i) * job->curvature / age;
+      clear = !ProbeWall(job, x, y, a);
+      break;
+    case MAZE_WORM_TURN_WALL_FOLLOW:
+      a -= job->curvature / sqrtf(age);
+      clear = Dodge(job, x, y, &a, job->turnAngle);
+      break;
+    case MAZE_WORM_TURN_WALL_HUG:
+      a += job->curvature / sqrtf(age);
+      clear = Dodge(job, x, y, &a, -job->turnAngle);
+      break;
+    case MAZE_WORM_TURN_MIXED:
+    default:
+      a += job->curvature * 0.001f * age * Chirality(i);
+      clear = !ProbeWall(job, x, y, a);
+      break;
+    }
+
+    const float newX = x + cosf(a) * job->moveSpeed;
+    const float newY = y + sinf(a) * job->moveSpeed;
+    const float margin = job->trailWidth + 1.0f;
+    if (!clear || newX < margin || newX > (float)job->width - margin ||
+        newY < margin || newY > (float)job->height - margin) {
+      cpu->alive[i] = 0.0f;
+      cpu->respawnTimer[i] = job->respawnCooldown;
+      cpu->move[i] = WORM_KILLED;
+      continue;
+    }
+
+    cpu->x[i] = newX;
+    cpu->y[i] = newY;
+    cpu->angle[i] = a - TWO_PI * floorf(a / TWO_PI);
+    cpu->age[i] = age + 1.0f;
+    cpu->move[i] = WORM_MOVED;
+  }
+}
+
+static void UpdatePalette(MazeWormsCpu *cpu, const ColorConfig *color) {
+  if (cpu->paletteValid && ColorConfigEquals(&cpu->paletteColor, color)) {
+    return;
+  }
+  for (int i = 0; i < COLOR_LUT_SIZE; i++) {
+    const float t = (float)i / (float)(COLOR_LUT_SIZE - 1);
+    const Color c = ColorFromConfig(color, t, 1.0f);
+    cpu->palette[i * 3] = (float)c.r / 255.0f;
+    cpu->palette[i * 3 + 1] = (float)c.g / 255.0f;
+    cpu->palette[i * 3 + 2] = (float)c.b / 255.0f;
+  }
+  cpu->paletteColor = *color;
+  cpu->paletteValid = true;
+}
+
+// Add the worm's color and a wall mark to every pixel within trailWidth
+static void DepositDisc(const MazeWormsCpu *cpu, TrailMap *trailMap, int i,
+                        float trailWidth) {
+  const float u = fminf(fmaxf(cpu->hue[i], 0.0f), 1.0f) *
+                  (float)(COLOR_LUT_SIZE - 1);
+  const int lo = (int)u;
+  const int hi = lo < COLOR_LUT_SIZE - 1 ? lo + 1 : lo;
+  const float f = u - (float)lo;
+  float rgb[3];
+  for (int c = 0; c < 3; c++) {
+    const float a = cpu->palette[lo * 3 + c];
+    rgb[c] = a + (cpu->palette[hi * 3 + c] - a) * f;
+  }
+
+  const int r = (int)ceilf(trailWidth);
+  for (int dy = -r; dy <= r; dy++) {
+    for (int dx = -r; dx <= r; dx++) {
+      if (sqrtf((float)(dx * dx + dy * dy)) > trailWidth) {
+        continue;
+      }
+      TrailMapAdd(trailMap, (int)(cpu->x[i] + (float)dx),
+                  (int)(cpu->y[i] + (float)dy), rgb[0], rgb[1], rgb[2], 1.0f);
+    }
+  }
+}
+
+static float HashFloat(float n) {
+  const float h = sinf(n) * 43758.5453123f;
+  return h - floorf(h);
+}
+
+// Count a dead worm down and drop it on an empty spot once it runs out, as
+// in maze_worm_respawn.glsl. A blocked spot is retried next step.
+static void Respawn(const StepJob *job, int i, float time, float stepDt) {
+  MazeWormsCpu *cpu = job->cpu;
+  const float timer = cpu->respawnTimer[i] - stepDt;
+  if (timer > 0.0f) {
+    cpu->respawnTimer[i] = timer;
+    return;
+  }
+
+  const float seed = (float)i * 1000.0f + time * 137.0f;
+  const float margin = job->trailWidth + 1.0f + job->collisionGap;
+  const float newX =
+      margin + HashFloat(seed) * ((float)job->width - 2.0f * margin);
+  const float newY =
+      margin + HashFloat(seed + 1.0f) * ((float)job->height - 2.0f * margin);
+  cpu->respawnTimer[i] = 0.0f;
+  if (TrailAlpha(job, newX, newY) >= WALL_ALPHA) {
+    return;
+  }
+
+  cpu->x[i] = newX;
+  cpu->y[i] = newY;
+  cpu->angle[i] = HashFloat(seed + 2.0f) * TWO_PI;
+  cpu->age[i] = 1.0f;
+  cpu->alive[i] = 1.0f;
+}
+
+void MazeWormsCpuStep(MazeWormsCpu *cpu, const MazeWorms *mw, float stepDt) {
+  if (cpu == NULL || cpu->count == 0 || mw->trailMap->pixels == NULL) {
+    return;
+  }
+  const MazeWormsConfig *cfg = &mw->config;
+
+  StepJob job = {};
+  job.cpu = cpu;
+  job.trail = mw->trailMap->pixels;
+  job.width = mw->width;
+  job.height = mw->height;
+  job.turningMode = cfg->turningMode;
+  job.curvature = cfg->curvature;
+  job.turnAngle = cfg->turnAngle;
+  job.trailWidth = cfg->trailWidth;
+  job.collisionGap = cfg->collisionGap;
+  job.respawnCooldown = cfg->respawnCooldown;
+  job.moveSpeed = cfg->moveSpeed;
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, MoveWorms, &job);
+
+  // Serial: overlapping discs must not race, and respawns see this step's
+  // walls. Worms killed this step start counting down on the next one.
+  UpdatePalette(cpu, &cfg->color);
+  for (int i = 0; i < cpu->count; i++) {
+    if (cpu->move[i] == WORM_MOVED) {
+      DepositDisc(cpu, mw->trailMap, i, cfg->trailWidth);
+    } else if (cpu->move[i] == WORM_IDLE) {
+      Respawn(&job, i, mw->time, stepDt);
+    }
+  }
+}
@@ -0,0 +1,32 @@
+#ifndef MAZE_WORMS_CPU_H
+#define MAZE_WORMS_CPU_H
+
+#include "maze_worms.h"
+#include <stdbool.h>
+
+// CPU backend for Maze Worms. Worms live in SoA arrays. Each move steers the
+// live worms against the CPU trail map's alpha on the worker pool, then
+// deposits their trails and counts down and respawns the dead ones serially.
+typedef struct MazeWormsCpu MazeWormsCpu;
+
+// Returns NULL on allocation failure
+MazeWormsCpu *MazeWormsCpuInit(void);
+
+void MazeWormsCpuUninit(MazeWormsCpu *cpu);
+
+// Replace the worms. Returns false and keeps the old worms when the arrays
+// cannot be allocated.
+bool MazeWormsCpuLoad(MazeWormsCpu *cpu, const MazeWormAgent *agents,
+                      int count);
+
+// Resize to count worms, keeping the first min(current, count) in their
+// current state and appending newAgents (the count - current new ones) when
+// growing. Returns false and keeps the old worms on allocation failure.
+bool MazeWormsCpuResize(MazeWormsCpu *cpu, const MazeWormAgent *newAgents,
+                        int count);
+
+// Advance every worm one move of stepDt seconds with mw's config, depositing
+// into mw's trail map
+void MazeWormsCpuStep(MazeWormsCpu *cpu, const MazeWorms *mw, float stepDt);
+
+#endif // MAZE_WORMS_CPU_H
@@ -5,12 +5,15 @@
 #include "config/effect_descriptor.h"
 #include "external/glad.h"
 #include "imgui.h"
+#include "particle_life_cpu.h"
 #include "render/blend_compositor.h"
 #include "render/color_config.h"
 #include "render/gradient.h"
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
+#include "spatial_hash.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -19,7 +22,10 @@
 #include <stdlib.h>
 
 static const char *COMPUTE_SHADER_PATH = "shaders/particle_life_agents.glsl";
+static const char *SORT_SHADER_PATH = "shaders/particle_life_sort.glsl";
 static const int MAX_SPECIES = 16;
+// Spatial hash cell budget; small radii in large bounds get wider cells
+static const int MAX_GRID_CELLS = 64 * 64 * 64;
 
 // Simple hash function for attraction matrix generation
 static unsigned int HashSeed(unsigned int x) {
@@ -65,12 +71,15 @@ static void RegenerateMatrix(ParticleLife *pl) {
   pl->evolutionFrameCounter = 0;
 }
 
-static void InitializeAgents(ParticleLifeAgent *agents, int count,
+// Fill agents[0..count-first) with agents first..count-1 of count
+static void InitializeAgents(ParticleLifeAgent *agents, int first, int count,
                              int speciesCount, const ColorConfig *color) {
   // Distribute agents in a sphere around the origin (normalized space)
   const float spawnRadius = 0.5f;
 
-  for (int i = 0; i < count; i++) {
+  for (int i = first; i < count; i++) {
+    ParticleLifeAgent *agent = &agents[i - first];
+
     // Random position in sphere
     const float theta =
         (float)(GetRandomValue(0, 31415)) / 10000.0f * 2.0f; // 0 to 2*PI
@@ -79,18 +88,18 @@ static void InitializeAgents(ParticleLifeAgent *agents, int count,
     const float r = spawnRadius * cbrtf((float)GetRandomValue(0, 10000) /
                                         10000.0f); // Uniform in volume
 
-    agents[i].x = r * sinf(phi) * cosf(theta);
-    agents[i].y = r * sinf(phi) * sinf(theta);
-    agents[i].z = r * cosf(phi);
+    agent->x = r * sinf(phi) * cosf(theta);
+    agent->y = r * sinf(phi) * sinf(theta);
+    agent->z = r * cosf(phi);
 
     // Zero initial velocity
-    agents[i].vx = 0.0f;
-    agents[i].vy = 0.0f;
-    agents[i].vz = 0.0f;
+    agent->vx = 0.0f;
+    agent->vy = 0.0f;
+    agent->vz = 0.0f;
 
     // Assign species evenly, derive hue from species
-    agents[i].species = i % speciesCount;
-    agents[i].hue = ColorConfigAgentHue(color, agents[i].species, speciesCount);
+    agent->species = i % speciesCount;
+    agent->hue = ColorConfigAgentHue(color, agent->species, speciesCount);
   }
 }
 
@@ -138,6 +147,35 @@ static GLuint LoadComputeProgram(ParticleLife *pl) {
   pl->saturationLoc = rlGetLocationUniform(program, "saturation");
   pl->valueLoc = rlGetLocationUniform(program, "value");
   pl->attractionMatrixLoc = rlGetLocationUniform(program, "attractionMatrix");
+  pl->gridSizeLoc = rlGetLocationUniform(program, "gridSize");
+  pl->gridOriginLoc = rlGetLocationUniform(program, "gridOrigin");
+  pl->cellSizeLoc = rlGetLocationUniform(program, "cellSize");
+
+  return program;
+}
+
+static GLuint LoadSortProgram(ParticleLife *pl) {
+  char *shaderSource = SimLoadShaderSource(SORT_SHADER_PATH);
+  if (shaderSource == NULL) {
+    return 0;
+  }
+
+  const unsigned int shaderId =
+      rlCompileShader(shaderSource, RL_COMPUTE_SHADER);
+  UnloadFileText(shaderSource);
+
+  if (shaderId == 0) {
+    TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to compile sort shader");
+    return 0;
+  }
+
+  const GLuint program = rlLoadComputeShaderProgram(shaderId);
+  if (program == 0) {
+    TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to load sort shader program");
+    return 0;
+  }
+
+  pl->sortNumParticlesLoc = rlGetLocationUniform(program, "numParticles");
 
   return program;
 }
@@ -150,7 +188,7 @@ static GLuint CreateAgentBuffer(int agentCount, int speciesCount,
     return 0;
   }
 
-  InitializeAgents(agents, agentCount, speciesCount, color);
+  InitializeAgents(agents, 0, agentCount, speciesCount, color);
   const GLuint buffer = rlLoadShaderBuffer(
       agentCount * sizeof(ParticleLifeAgent), agents, RL_DYNAMIC_COPY);
   free(agents);
@@ -161,14 +199,75 @@ static GLuint CreateAgentBuffer(int agentCount, int speciesCount,
   return buffer;
 }
 
+// Sorted agent copy and spatial hash, both sized to the agent capacity
+static bool CreateNeighborSearch(ParticleLife *pl) {
+  pl->sortedBuffer = rlLoadShaderBuffer(
+      pl->agentCapacity * sizeof(ParticleLifeAgent), NULL, RL_DYNAMIC_COPY);
+  if (pl->sortedBuffer == 0) {
+    TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to create sorted agent SSBO");
+    return false;
+  }
+
+  pl->spatialHash = SpatialHashInit3D(pl->agentCapacity, MAX_GRID_CELLS);
+  if (pl->spatialHash == NULL) {
+    TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to create spatial hash");
+    return false;
+  }
+  return true;
+}
+
+// CPU backend: replace the agents with a fresh spawn
+static bool LoadCpuAgents(ParticleLife *pl) {
+  ParticleLifeAgent *agents = static_cast<ParticleLifeAgent *>(
+      malloc(pl->agentCount * sizeof(ParticleLifeAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, 0, pl->agentCount, pl->config.speciesCount,
+                   &pl->config.color);
+  const bool loaded = ParticleLifeCpuLoad(pl->cpu, agents, pl->agentCount);
+  free(agents);
+  return loaded;
+}
+
+static void FreeNeighborSearch(ParticleLife *pl) {
+  if (pl->sortedBuffer != 0) {
+    rlUnloadShaderBuffer(pl->sortedBuffer);
+    pl->sortedBuffer = 0;
+  }
+  SpatialHashUninit(pl->spatialHash);
+  pl->spatialHash = NULL;
+}
+
+// Fit the neighbor search to the agent capacity. A search freed by an earlier
+// failure is recreated, since SpatialHashReserve cannot grow a missing hash;
+// Update skips while the hash is missing.
+static void SyncNeighborSearch(ParticleLife *pl) {
+  if (pl->spatialHash == NULL) {
+    FreeNeighborSearch(pl);
+    if (!CreateNeighborSearch(pl)) {
+      FreeNeighborSearch(pl);
+    }
+    return;
+  }
+
+  rlUnloadShaderBuffer(pl->sortedBuffer);
+  pl->sortedBuffer = rlLoadShaderBuffer(
+      pl->agentCapacity * sizeof(ParticleLifeAgent), NULL, RL_DYNAMIC_COPY);
+  if (pl->sortedBuffer == 0 ||
+      !SpatialHashReserve(pl->spatialHash, pl->agentCapacity)) {
+    FreeNeighborSearch(pl);
+  }
+}
+
 ParticleLife *ParticleLifeInit(int width, int height,
                                const ParticleLifeConfig *config) {
   if (!ParticleLifeSupported()) {
-    TraceLog(
-        LOG_WARNING,
-        "PARTICLE_LIFE: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "PARTICLE_LIFE: Compute shaders not supported "
+                          "(requires OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   ParticleLife *pl =
       static_cast<ParticleLife *>(calloc(1, sizeof(ParticleLife)));
@@ -183,6 +282,7 @@ ParticleLife *ParticleLifeInit(int width, int height,
   if (pl->agentCount < 1) {
     pl->agentCount = 1;
   }
+  pl->agentCapacity = pl->agentCount;
   pl->time = 0.0f;
   pl->rotationAccumX = 0.0f;
   pl->rotationAccumY = 0.0f;
@@ -193,15 +293,29 @@ ParticleLife *ParticleLifeInit(int width, int height,
   // Initialize persistent attraction matrix
   RegenerateMatrix(pl);
 
-  pl->computeProgram = LoadComputeProgram(pl);
-  if (pl->computeProgram == 0) {
-    goto cleanup;
-  }
+  if (cpuBackend) {
+    pl->cpu = ParticleLifeCpuInit();
+    pl->trailMap = TrailMapInitCpu(width, height);
+    if (pl->cpu == NULL || pl->trailMap == NULL) {
+      TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to create CPU backend");
+      goto cleanup;
+    }
+  } else {
+    pl->computeProgram = LoadComputeProgram(pl);
+    if (pl->computeProgram == 0) {
+      goto cleanup;
+    }
 
-  pl->trailMap = TrailMapInit(width, height);
-  if (pl->trailMap == NULL) {
-    TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to create trail map");
-    goto cleanup;
+    pl->sortProgram = LoadSortProgram(pl);
+    if (pl->sortProgram == 0) {
+      goto cleanup;
+    }
+
+    pl->trailMap = TrailMapInit(width, height);
+    if (pl->trailMap == NULL) {
+      TraceLog(LOG_ERROR, "PARTICLE_LIFE: Failed to create trail map");
+      goto cleanup;
+    }
   }
 
   pl->debugShader = LoadShader(NULL, "shaders/trail_debug.fs");
@@ -210,15 +324,26 @@ ParticleLife *ParticleLifeInit(int width, int height,
              "PARTICLE_LIFE: Failed to load debug shader, using default");
   }
 
-  pl->agentBuffer = CreateAgentBuffer(pl->agentCount, pl->config.speciesCount,
-                                      &pl->config.color);
-  if (pl->agentBuffer == 0) {
-    goto cleanup;
+  if (cpuBackend) {
+    if (!LoadCpuAgents(pl)) {
+      goto cleanup;
+    }
+  } else {
+    pl->agentBuffer = CreateAgentBuffer(
+        pl->agentCount, pl->config.speciesCount, &pl->config.color);
+    if (pl->agentBuffer == 0) {
+      goto cleanup;
+    }
+
+    if (!CreateNeighborSearch(pl)) {
+      goto cleanup;
+    }
   }
 
   TraceLog(LOG_INFO,
-           "PARTICLE_LIFE: Initialized with %d agents (%d species) at %dx%d",
-           pl->agentCount, pl->config.speciesCount, width, height);
+           "PARTICLE_LIFE: Initialized with %d agents (%d species) at %dx%d%s",
+           pl->agentCount, pl->config.speciesCount, width, height,
+           cpuBackend ? " on the CPU" : "");
   return pl;
 
 cleanup:
@@ -232,16 +357,20 @@ void ParticleLifeUninit(ParticleLife *pl) {
   }
 
   rlUnloadShaderBuffer(pl->agentBuffer);
+  FreeNeighborSearch(pl);
+  ParticleLifeCpuUninit(pl->cpu);
   TrailMapUninit(pl->trailMap);
   if (pl->debugShader.id != 0) {
     UnloadShader(pl->debugShader);
   }
   rlUnloadShaderProgram(pl->computeProgram);
+  rlUnloadShaderProgram(pl->sortProgram);
   free(pl);
 }
 
 void ParticleLifeUpdate(ParticleLife *pl, float deltaTime) {
-  if (pl == NULL || !pl->supported || !pl->config.enabled) {
+  if (pl == NULL || !pl->supported || !pl->config.enabled ||
+      (pl->cpu == NULL && pl->spatialHash == NULL)) {
     return;
   }
 
@@ -277,6 +406,53 @@ void ParticleLifeUpdate(ParticleLife *pl, float deltaTime) {
   pl->rotationAccumY += pl->config.rotationSpeedY * deltaTime;
   pl->rotationAccumZ += pl->config.rotationSpeedZ * deltaTime;
 
+  // Compute rotation matrix on CPU (XYZ order)
+  const float rotX = pl->config.rotationAngleX + pl->rotationAccumX;
+  const float rotY = pl->config.rotationAngleY + pl->rotationAccumY;
+  const float rotZ = pl->config.rotationAngleZ + pl->rotationAccumZ;
+
+  const float cx = cosf(rotX);
+  const float sx = sinf(rotX);
+  const float cy = cosf(rotY);
+  const float sy = sinf(rotY);
+  const float cz = cosf(rotZ);
+  const float sz = sinf(rotZ);
+
+  // Rotation matrix (XYZ order): Rz * Ry * Rx, column-major for OpenGL
+  float rotationMatrix[9] = {cy * cz,
+                             cy * sz,
+                             -sy,
+                             sx * sy * cz - cx * sz,
+                             sx * sy * sz + cx * cz,
+                             sx * cy,
+                             cx * sy * cz + sx * sz,
+                             cx * sy * sz - sx * cz,
+                             cx * cy};
+
+  if (pl->cpu != NULL) {
+    ParticleLifeCpuStep(pl->cpu, pl, rotationMatrix, deltaTime);
+    return;
+  }
+
+  // Bin agents into cells at least rMax wide over the safety clamp sphere
+  SpatialHashSetBounds3D(pl->spatialHash, pl->config.rMax,
+                         pl->config.boundsRadius * 1.1f);
+  SpatialHashBuild(pl->spatialHash, pl->agentBuffer, pl->agentCount,
+                   sizeof(ParticleLifeAgent), 0);
+
+  const int workGroupSize = 1024;
+  const int numGroups = (pl->agentCount + workGroupSize - 1) / workGroupSize;
+
+  // Gather agents into cell order for the force pass
+  rlEnableShader(pl->sortProgram);
+  rlSetUniform(pl->sortNumParticlesLoc, &pl->agentCount, RL_SHADER_UNIFORM_INT,
+               1);
+  rlBindShaderBuffer(pl->agentBuffer, 0);
+  rlBindShaderBuffer(pl->sortedBuffer, 1);
+  rlBindShaderBuffer(SpatialHashGetIndicesBuffer(pl->spatialHash), 2);
+  rlComputeShaderDispatch((unsigned int)numGroups, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
   rlEnableShader(pl->computeProgram);
 
   const float resolution[2] = {(float)pl->width, (float)pl->height};
@@ -300,28 +476,6 @@ void ParticleLifeUpdate(ParticleLife *pl, float deltaTime) {
   const float center[2] = {pl->config.x, pl->config.y};
   rlSetUniform(pl->centerLoc, center, RL_SHADER_UNIFORM_VEC2, 1);
 
-  // Compute rotation matrix on CPU (XYZ order)
-  const float rotX = pl->config.rotationAngleX + pl->rotationAccumX;
-  const float rotY = pl->config.rotationAngleY + pl->rotationAccumY;
-  const float rotZ = pl->config.rotationAngleZ + pl->rotationAccumZ;
-
-  const float cx = cosf(rotX);
-  const float sx = sinf(rotX);
-  const float cy = cosf(rotY);
-  const float sy = sinf(rotY);
-  const float cz = cosf(rotZ);
-  const float sz = sinf(rotZ);
-
-  // Rotation matrix (XYZ order): Rz * Ry * Rx, column-major for OpenGL
-  float rotationMatrix[9] = {cy * cz,
-                             cy * sz,
-                             -sy,
-                             sx * sy * cz - cx * sz,
-                             sx * sy * sz + cx * cz,
-                             sx * cy,
-                             cx * sy * cz + sx * sz,
-                             cx * sy * sz - sx * cz,
-                             cx * cy};
   glUniformMatrix3fv(pl->rotationMatrixLoc, 1, GL_FALSE, rotationMatrix);
 
   rlSetUniform(pl->projectionScaleLoc, &pl->config.projectionScale,
@@ -339,15 +493,24 @@ void ParticleLifeUpdate(ParticleLife *pl, float deltaTime) {
   glUniform1fv(pl->attractionMatrixLoc, MAX_SPECIES * MAX_SPECIES,
                pl->attractionMatrix);
 
+  int gridSize[3];
+  float gridOrigin[3];
+  float cellSize;
+  SpatialHashGetGrid3D(pl->spatialHash, gridSize, gridOrigin, &cellSize);
+  rlSetUniform(pl->gridSizeLoc, gridSize, RL_SHADER_UNIFORM_IVEC3, 1);
+  rlSetUniform(pl->gridOriginLoc, gridOrigin, RL_SHADER_UNIFORM_VEC3, 1);
+  rlSetUniform(pl->cellSizeLoc, &cellSize, RL_SHADER_UNIFORM_FLOAT, 1);
+
   rlBindShaderBuffer(pl->agentBuffer, 0);
   rlBindImageTexture(TrailMapGetTexture(pl->trailMap).id, 1,
                      RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  rlBindShaderBuffer(pl->sortedBuffer, 2);
+  rlBindShaderBuffer(SpatialHashGetOffsetsBuffer(pl->spatialHash), 3);
 
-  const int workGroupSize = 1024;
-  const int numGroups = (pl->agentCount + workGroupSize - 1) / workGroupSize;
   rlComputeShaderDispatch((unsigned int)numGroups, 1, 1);
 
-  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT |
+                  GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
                   GL_TEXTURE_FETCH_BARRIER_BIT);
 
   rlDisableShader();
@@ -382,19 +545,92 @@ void ParticleLifeReset(ParticleLife *pl) {
 
   TrailMapClear(pl->trailMap);
 
+  if (pl->cpu != NULL) {
+    LoadCpuAgents(pl);
+    return;
+  }
+
+  if (pl->spatialHash == NULL) {
+    SyncNeighborSearch(pl);
+  }
+
   ParticleLifeAgent *agents = static_cast<ParticleLifeAgent *>(
       malloc(pl->agentCount * sizeof(ParticleLifeAgent)));
   if (agents == NULL) {
     return;
   }
 
-  InitializeAgents(agents, pl->agentCount, pl->config.speciesCount,
+  InitializeAgents(agents, 0, pl->agentCount, pl->config.speciesCount,
                    &pl->config.color);
   rlUpdateShaderBuffer(pl->agentBuffer, agents,
                        pl->agentCount * sizeof(ParticleLifeAgent), 0);
   free(agents);
 }
 
+// Shrink to count agents in place, taking every (agentCount / count)-th agent
+// in cell order so each cell keeps its share rather than the regions at the
+// buffer tail emptying
+static void ThinAgents(ParticleLife *pl, int count) {
+  if (pl->spatialHash == NULL || pl->sortedBuffer == 0) {
+    return;
+  }
+
+  SpatialHashSetBounds3D(pl->spatialHash, pl->config.rMax,
+                         pl->config.boundsRadius * 1.1f);
+  SpatialHashBuild(pl->spatialHash, pl->agentBuffer, pl->agentCount,
+                   sizeof(ParticleLifeAgent), 0);
+  SpatialHashThin(pl->spatialHash, pl->agentBuffer, pl->sortedBuffer,
+                  pl->agentCount, count, sizeof(ParticleLifeAgent));
+  const unsigned int thinned = pl->sortedBuffer;
+  pl->sortedBuffer = pl->agentBuffer;
+  pl->agentBuffer = thinned;
+}
+
+// Keep the running agents, appending freshly spawned ones when growing and
+// thinning them evenly when shrinking
+static void ResizeAgents(ParticleLife *pl, int count) {
+  const int oldCount = pl->agentCount;
+  const int oldCapacity = pl->agentCapacity;
+
+  ParticleLifeAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<ParticleLifeAgent *>(
+        malloc((count - oldCount) * sizeof(ParticleLifeAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, oldCount, count, pl->config.speciesCount,
+                     &pl->config.color);
+  }
+
+  if (pl->cpu == NULL && count < oldCount) {
+    ThinAgents(pl, count);
+  }
+  const bool resized =
+      pl->cpu != NULL
+          ? ParticleLifeCpuResize(pl->cpu, newAgents, count)
+          : SimResizeAgentBuffer(&pl->agentBuffer, &pl->agentCapacity,
+                                 oldCount, count, sizeof(ParticleLifeAgent),
+                                 newAgents);
+  free(newAgents);
+  if (!resized) {
+    return;
+  }
+  pl->agentCount = count;
+
+  if (pl->cpu != NULL ||
+      (pl->agentCapacity == oldCapacity && pl->spatialHash != NULL)) {
+    return;
+  }
+
+  SyncNeighborSearch(pl);
+
+  if (pl->agentCapacity != oldCapacity) {
+    TraceLog(LOG_INFO, "PARTICLE_LIFE: Grew agent buffers to %d agents",
+             pl->agentCapacity);
+  }
+}
+
 void ParticleLifeApplyConfig(ParticleLife *pl,
                              const ParticleLifeConfig *newConfig) {
   if (pl == NULL || newConfig == NULL) {
@@ -417,15 +653,35 @@ void ParticleLifeApplyConfig(ParticleLife *pl,
       (newConfig->symmetricForces != pl->config.symmetricForces);
 
   pl->config = *newConfig;
+  TrailMapSetActive(pl->trailMap, pl->config.enabled);
 
   // Regenerate matrix if seed or symmetry setting changed
   if (seedChanged || symmetryChanged || speciesChanged) {
     RegenerateMatrix(pl);
   }
 
-  if (needsBufferRealloc || speciesChanged) {
+  // A count change alone keeps the running agents; new species respawn all
+  if (needsBufferRealloc && !speciesChanged) {
+    ResizeAgents(pl, newAgentCount);
+  }
+
+  if (pl->cpu != NULL) {
+    if (speciesChanged || colorChanged) {
+      pl->agentCount = newAgentCount;
+      LoadCpuAgents(pl);
+      TrailMapClear(pl->trailMap);
+    }
+    return;
+  }
+
+  if (speciesChanged) {
     rlUnloadShaderBuffer(pl->agentBuffer);
     pl->agentCount = newAgentCount;
+    pl->agentCapacity = newAgentCount;
+
+    // Sized to the agent capacity; Update skips while the hash is missing
+    FreeNeighborSearch(pl);
+    CreateNeighborSearch(pl);
 
     ParticleLifeAgent *agents = static_cast<ParticleLifeAgent *>(
         malloc(pl->agentCount * sizeof(ParticleLifeAgent)));
@@ -434,7 +690,7 @@ void ParticleLifeApplyConfig(ParticleLife *pl,
       return;
     }
 
-    InitializeAgents(agents, pl->agentCount, pl->config.speciesCount,
+    InitializeAgents(agents, 0, pl->agentCount, pl->config.speciesCount,
                      &pl->config.color);
     pl->agentBuffer = rlLoadShaderBuffer(
         pl->agentCount * sizeof(ParticleLifeAgent), agents, RL_DYNAMIC_COPY);
@@ -449,7 +705,7 @@ void ParticleLifeApplyConfig(ParticleLife *pl,
     ParticleLifeAgent *agents = static_cast<ParticleLifeAgent *>(
         malloc(pl->agentCount * sizeof(ParticleLifeAgent)));
     if (agents != NULL) {
-      InitializeAgents(agents, pl->agentCount, pl->config.speciesCount,
+      InitializeAgents(agents, 0, pl->agentCount, pl->config.speciesCount,
                        &pl->config.color);
       rlUpdateShaderBuffer(pl->agentBuffer, agents,
                            pl->agentCount * sizeof(ParticleLifeAgent), 0);
@@ -477,7 +733,9 @@ void ParticleLifeDrawDebug(const ParticleLife *pl) {
 
 static void DrawParticleLifeParams(EffectConfig *e, const ModSources *ms,
                                    ImU32) {
-  ImGui::SliderInt("Agents##plife", &e->particleLife.agentCount, 1000, 100000);
+  ImGui::SliderInt("Agents##plife", &e->particleLife.agentCount, 1000, 500000);
+  ImGui::SliderFloat("Step Rate##plife", &e->particleLife.stepRate, 0.0f,
+                     240.0f, "%.0f Hz");
 
   ImGui::SeparatorText("Species");
   int speciesCount = e->particleLife.speciesCount;
@@ -566,10 +824,12 @@ void ParticleLifeRegisterParams(ParticleLifeConfig *cfg) {
 }
 
 void SetupParticleLifeTrailBoost(PostEffect *pe) {
-  BlendCompositorApply(pe->blendCompositor,
-                       TrailMapGetTexture(pe->particleLife->trailMap),
-                       pe->effects.particleLife.boostIntensity,
-                       pe->effects.particleLife.blendMode);
+  const TrailMap *trailMap = pe->particleLife->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
+      pe->effects.particleLife.boostIntensity,
+      pe->effects.particleLife.blendMode);
 }
 
 // clang-format off
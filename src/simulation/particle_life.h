@@ -7,6 +7,8 @@
 #include <stdbool.h>
 
 typedef struct TrailMap TrailMap;
+typedef struct SpatialHash SpatialHash;
+typedef struct ParticleLifeCpu ParticleLifeCpu;
 
 typedef struct ParticleLifeAgent {
   float x;           // Position X
@@ -49,6 +51,7 @@ typedef struct ParticleLifeConfig {
   float depositAmount = 0.1f;  // Trail deposit strength (0.01-0.5)
   float decayHalfLife = 1.0f;  // Seconds for 50% decay (0.1-5.0)
   int diffusionScale = 1;      // Diffusion kernel scale in pixels (0-4)
+  float stepRate = 0.0f;       // Fixed steps per second (0 = every frame)
   float boostIntensity = 1.0f; // Trail boost strength (0.0-5.0)
   EffectBlendMode blendMode = EFFECT_BLEND_SCREEN;
   ColorConfig color;
@@ -61,14 +64,19 @@ typedef struct ParticleLifeConfig {
       boundaryStiffness, x, y, rotationAngleX, rotationAngleY, rotationAngleZ, \
       rotationSpeedX, rotationSpeedY, rotationSpeedZ, projectionScale,         \
       depositAmount, decayHalfLife, diffusionScale, boostIntensity, blendMode, \
-      color, debugOverlay
+      color, debugOverlay, stepRate
 
 typedef struct ParticleLife {
   unsigned int agentBuffer;
+  unsigned int sortedBuffer; // Agents in cell order, read by the force pass
   unsigned int computeProgram;
+  unsigned int sortProgram;
+  SpatialHash *spatialHash; // 3D grid of rMax cells for neighbor search
+  ParticleLifeCpu *cpu;     // CPU backend state; NULL on the compute path
   TrailMap *trailMap;
   Shader debugShader;
   int agentCount;
+  int agentCapacity; // Agents the buffers hold; grows, never shrinks
   int width;
   int height;
   // Agent shader uniform locations
@@ -90,6 +98,11 @@ typedef struct ParticleLife {
   int saturationLoc;
   int valueLoc;
   int attractionMatrixLoc;
+  int gridSizeLoc;
+  int gridOriginLoc;
+  int cellSizeLoc;
+  // Sort shader uniform locations
+  int sortNumParticlesLoc;
   // Runtime state
   float time;
   float rotationAccumX; // Runtime accumulator (not saved to preset)
@@ -107,14 +120,15 @@ typedef struct ParticleLife {
 bool ParticleLifeSupported(void);
 
 // Initialize particle life simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders
+// Returns NULL if allocation fails
 ParticleLife *ParticleLifeInit(int width, int height,
                                const ParticleLifeConfig *config);
 
 // Clean up particle life resources
 void ParticleLifeUninit(ParticleLife *pl);
 
-// Dispatch compute shader to update agents
+// Dispatch compute shader (or step the CPU backend) to update agents
 void ParticleLifeUpdate(ParticleLife *pl, float deltaTime);
 
 // Process trails with diffusion and decay (call after ParticleLifeUpdate)
@@ -0,0 +1,472 @@
+#include "particle_life_cpu.h"
+#include "render/color_config.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+
+static const int MAX_SPECIES = 16; // Attraction matrix row stride
+static const int MAX_GRID_CELLS = 64 * 64 * 64;
+static const int AGENT_GRAIN = 256; // Agents per worker chunk
+
+// One array per agent field
+struct ParticleLifeSoA {
+  float *x;
+  float *y;
+  float *z;
+  float *vx;
+  float *vy;
+  float *vz;
+  float *hue;
+  int *species;
+};
+
+struct ParticleLifeCpu {
+  ParticleLifeSoA agents; // Updated state, in cell order after each step
+  ParticleLifeSoA sorted; // Cell-ordered copy read by the force pass
+  int *cell;              // Grid cell per agent
+  int *order;             // Agent in each sorted slot
+  int *deposit;           // Trail pixel per agent, -1 when off screen
+  int *cellStart;         // Cell c spans [cellStart[c], cellStart[c + 1])
+  int count;
+};
+
+// Force function terms
+struct PairParams {
+  float rMax;
+  float invRMax;
+  float beta;
+  float invBeta;
+  float invOuter; // 1 / (1 - beta)
+};
+
+// Per-step parameters shared by the worker chunks
+struct StepJob {
+  ParticleLifeCpu *cpu;
+  const float *matrix;
+  int dim; // Cells per grid axis
+  float origin;
+  float invCellSize;
+  PairParams pair;
+  float forceScale;
+  float momentum;
+  float boundsRadius;
+  float boundaryStiffness;
+  float dt;
+  const float *rotation;
+  float projection; // Normalized units to pixels
+  float centerX;
+  float centerY;
+  int width;
+  int height;
+};
+
+// The arrays share one allocation starting at x
+static bool AllocSoA(ParticleLifeSoA *soa, int count) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 8 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  soa->x = block;
+  soa->y = block + (size_t)count;
+  soa->z = block + (size_t)count * 2;
+  soa->vx = block + (size_t)count * 3;
+  soa->vy = block + (size_t)count * 4;
+  soa->vz = block + (size_t)count * 5;
+  soa->hue = block + (size_t)count * 6;
+  soa->species = reinterpret_cast<int *>(block + (size_t)count * 7);
+  return true;
+}
+
+static void FreeSoA(ParticleLifeSoA *soa) {
+  free(soa->x);
+  *soa = ParticleLifeSoA{};
+}
+
+static void FreeAgents(ParticleLifeCpu *cpu) {
+  FreeSoA(&cpu->agents);
+  FreeSoA(&cpu->sorted);
+  free(cpu->cell);
+  free(cpu->order);
+  free(cpu->deposit);
+  cpu->cell = NULL;
+  cpu->order = NULL;
+  cpu->deposit = NULL;
+  cpu->count = 0;
+}
+
+ParticleLifeCpu *ParticleLifeCpuInit(void) {
+  ParticleLifeCpu *cpu =
+      static_cast<ParticleLifeCpu *>(calloc(1, sizeof(ParticleLifeCpu)));
+  if (cpu == NULL) {
+    return NULL;
+  }
+  cpu->cellStart =
+      static_cast<int *>(malloc((MAX_GRID_CELLS + 1) * sizeof(int)));
+  if (cpu->cellStart == NULL) {
+    free(cpu);
+    return NULL;
+  }
+  return cpu;
+}
+
+void ParticleLifeCpuUninit(ParticleLifeCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  FreeAgents(cpu);
+  free(cpu->cellStart);
+  free(cpu);
+}
+
+// Reallocate for count agents, keeping keep of the current state
+static bool ReallocAgents(ParticleLifeCpu *cpu, int count, int keep) {
+  ParticleLifeCpu next = {};
+  next.cell = static_cast<int *>(malloc((size_t)count * sizeof(int)));
+  next.order = static_cast<int *>(malloc((size_t)count * sizeof(int)));
+  next.deposit = static_cast<int *>(malloc((size_t)count * sizeof(int)));
+  if (!AllocSoA(&next.agents, count) || !AllocSoA(&next.sorted, count) ||
+      next.cell == NULL || next.order == NULL || next.deposit == NULL) {
+    FreeAgents(&next);
+    return false;
+  }
+
+  // The state is in cell order, so shrinking takes every (count / keep)-th
+  // agent and each cell keeps its share; growing copies them in place
+  const ParticleLifeSoA *src = &cpu->agents;
+  ParticleLifeSoA *dst = &next.agents;
+  for (int i = 0; i < keep; i++) {
+    const size_t s = (size_t)i * cpu->count / keep;
+    dst->x[i] = src->x[s];
+    dst->y[i] = src->y[s];
+    dst->z[i] = src->z[s];
+    dst->vx[i] = src->vx[s];
+    dst->vy[i] = src->vy[s];
+    dst->vz[i] = src->vz[s];
+    dst->hue[i] = src->hue[s];
+    dst->species[i] = src->species[s];
+  }
+
+  FreeAgents(cpu);
+  cpu->agents = next.agents;
+  cpu->sorted = next.sorted;
+  cpu->cell = next.cell;
+  cpu->order = next.order;
+  cpu->deposit = next.deposit;
+  cpu->count = count;
+  return true;
+}
+
+// Copy count agents into the state arrays starting at first
+static void StoreAgents(ParticleLifeCpu *cpu, int first,
+                        const ParticleLifeAgent *agents, int count) {
+  ParticleLifeSoA *soa = &cpu->agents;
+  for (int i = 0; i < count; i++) {
+    soa->x[first + i] = agents[i].x;
+    soa->y[first + i] = agents[i].y;
+    soa->z[first + i] = agents[i].z;
+    soa->vx[first + i] = agents[i].vx;
+    soa->vy[first + i] = agents[i].vy;
+    soa->vz[first + i] = agents[i].vz;
+    soa->hue[first + i] = agents[i].hue;
+    soa->species[first + i] = agents[i].species;
+  }
+}
+
+bool ParticleLifeCpuLoad(ParticleLifeCpu *cpu, const ParticleLifeAgent *agents,
+                         int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !ReallocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool ParticleLifeCpuResize(ParticleLifeCpu *cpu,
+                           const ParticleLifeAgent *newAgents, int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !ReallocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+// Same clamped mapping as the compute path's spatial hash
+static int CellCoord(const StepJob *job, float v) {
+  const int c = (int)floorf((v - job->origin) * job->invCellSize);
+  return c < 0 ? 0 : (c >= job->dim ? job->dim - 1 : c);
+}
+
+static void BinAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const ParticleLifeSoA *a = &job->cpu->agents;
+  for (int i = begin; i < end; i++) {
+    const int cx = CellCoord(job, a->x[i]);
+    const int cy = CellCoord(job, a->y[i]);
+    const int cz = CellCoord(job, a->z[i]);
+    job->cpu->cell[i] = (cz * job->dim + cy) * job->dim + cx;
+  }
+}
+
+// Copy the agents into sorted in cell order
+static void SortByCell(ParticleLifeCpu *cpu, int cellCount) {
+  SimCpuBinByCell(cpu->cell, cpu->count, cellCount, cpu->cellStart,
+                  cpu->order);
+
+  const ParticleLifeSoA *a = &cpu->agents;
+  ParticleLifeSoA *s = &cpu->sorted;
+  for (int k = 0; k < cpu->count; k++) {
+    const int i = cpu->order[k];
+    s->x[k] = a->x[i];
+    s->y[k] = a->y[i];
+    s->z[k] = a->z[i];
+    s->vx[k] = a->vx[i];
+    s->vy[k] = a->vy[i];
+    s->vz[k] = a->vz[i];
+    s->hue[k] = a->hue[i];
+    s->species[k] = a->species[i];
+  }
+}
+
+// Force along delta per unit of delta: force(r / rMax) / r, zero outside
+// (0, rMax). Both branches are computed so the caller's loop vectorizes.
+static inline float PairForce(const PairParams &p, float a, float r2) {
+  const float r = sqrtf(r2);
+  const float rn = r * p.invRMax;
+  const float inner = rn * p.invBeta - 1.0f;
+  const float outer =
+      a * (1.0f - fabsf(2.0f * rn - 1.0f - p.beta) * p.invOuter);
+  const float f = rn < p.beta ? inner : outer;
+  return (r > 0.0f && r < p.rMax) ? f / r : 0.0f;
+}
+
+// Forces from sorted agents [start, end), added to force. Lanes are
+// independent, so the block loop vectorizes without reassociating sums;
+// everything it touches is local so the compiler sees no aliasing.
+static void AccumulateRun(const StepJob *job, const float *matrixRow, float px,
+                          float py, float pz, int start, int end,
+                          float force[3]) {
+  const PairParams p = job->pair;
+  const float *xs = job->cpu->sorted.x;
+  const float *ys = job->cpu->sorted.y;
+  const float *zs = job->cpu->sorted.z;
+  const int *species = job->cpu->sorted.species;
+  float fx[SIM_CPU_LANES] = {};
+  float fy[SIM_CPU_LANES] = {};
+  float fz[SIM_CPU_LANES] = {};
+
+  int j = start;
+  for (; j + SIM_CPU_LANES <= end; j += SIM_CPU_LANES) {
+    for (int l = 0; l < SIM_CPU_LANES; l++) {
+      const float dx = xs[j + l] - px;
+      const float dy = ys[j + l] - py;
+      const float dz = zs[j + l] - pz;
+      const float k = PairForce(p, matrixRow[species[j + l]],
+                                dx * dx + dy * dy + dz * dz);
+      fx[l] += dx * k;
+      fy[l] += dy * k;
+      fz[l] += dz * k;
+    }
+  }
+  for (; j < end; j++) {
+    const float dx = xs[j] - px;
+    const float dy = ys[j] - py;
+    const float dz = zs[j] - pz;
+    const float k =
+        PairForce(p, matrixRow[species[j]], dx * dx + dy * dy + dz * dz);
+    fx[0] += dx * k;
+    fy[0] += dy * k;
+    fz[0] += dz * k;
+  }
+
+  for (int l = 0; l < SIM_CPU_LANES; l++) {
+    force[0] += fx[l];
+    force[1] += fy[l];
+    force[2] += fz[l];
+  }
+}
+
+// Sorted agent i -> agents[i]: the compute shader's update, per agent
+static void StepAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const ParticleLifeSoA *s = &job->cpu->sorted;
+  ParticleLifeSoA *a = &job->cpu->agents;
+  const int *cellStart = job->cpu->cellStart;
+  const int dim = job->dim;
+  const float *m = job->rotation;
+
+  for (int i = begin; i < end; i++) {
+    float px = s->x[i];
+    float py = s->y[i];
+    float pz = s->z[i];
+    const float *matrixRow = job->matrix + s->species[i] * MAX_SPECIES;
+
+    float force[3] = {};
+    const int cx = CellCoord(job, px);
+    const int cy = CellCoord(job, py);
+    const int cz = CellCoord(job, pz);
+    const int xMin = cx > 0 ? cx - 1 : 0;
+    const int xMax = cx < dim - 1 ? cx + 1 : dim - 1;
+    for (int z = (cz > 0 ? cz - 1 : 0); z <= cz + 1 && z < dim; z++) {
+      for (int y = (cy > 0 ? cy - 1 : 0); y <= cy + 1 && y < dim; y++) {
+        // Cells along x are adjacent in sorted order: one run per row
+        const int row = (z * dim + y) * dim;
+        AccumulateRun(job, matrixRow, px, py, pz, cellStart[row + xMin],
+                      cellStart[row + xMax + 1], force);
+      }
+    }
+
+    // Scale force by interaction radius and user factor
+    float tx = force[0] * job->forceScale;
+    float ty = force[1] * job->forceScale;
+    float tz = force[2] * job->forceScale;
+
+    // Soft boundary: exponential repulsion starting at 80% radius
+    float dist = sqrtf(px * px + py * py + pz * pz);
+    const float softStart = job->boundsRadius * 0.8f;
+    if (dist > softStart) {
+      const float overshoot = (dist - softStart) / (job->boundsRadius * 0.2f);
+      const float repulsion =
+          job->boundaryStiffness * (expf(overshoot * 3.0f) - 1.0f) / dist;
+      tx -= px * repulsion;
+      ty -= py * repulsion;
+      tz -= pz * repulsion;
+    }
+
+    // Semi-implicit Euler integration
+    float vx = s->vx[i] * job->momentum + tx * job->dt;
+    float vy = s->vy[i] * job->momentum + ty * job->dt;
+    float vz = s->vz[i] * job->momentum + tz * job->dt;
+    px += vx * job->dt;
+    py += vy * job->dt;
+    pz += vz * job->dt;
+
+    // Safety clamp at 110% boundary, dropping outward velocity
+    dist = sqrtf(px * px + py * py + pz * pz);
+    const float limit = job->boundsRadius * 1.1f;
+    if (dist > limit && dist > 0.0001f) {
+      const float nx = px / dist;
+      const float ny = py / dist;
+      const float nz = pz / dist;
+      px = nx * limit;
+      py = ny * limit;
+      pz = nz * limit;
+      const float outward = vx * nx + vy * ny + vz * nz;
+      if (outward > 0.0f) {
+        vx -= nx * outward;
+        vy -= ny * outward;
+        vz -= nz * outward;
+      }
+    }
+
+    a->x[i] = px;
+    a->y[i] = py;
+    a->z[i] = pz;
+    a->vx[i] = vx;
+    a->vy[i] = vy;
+    a->vz[i] = vz;
+    a->hue[i] = s->hue[i];
+    a->species[i] = s->species[i];
+
+    // Project: rotate, drop Y (depth)
+    const float rx = m[0] * px + m[3] * py + m[6] * pz;
+    const float rz = m[2] * px + m[5] * py + m[8] * pz;
+    const float sx = rx * job->projection + job->centerX;
+    const float sy = rz * job->projection + job->centerY;
+    const bool onScreen = sx >= 0.0f && sx < (float)job->width &&
+                          sy >= 0.0f && sy < (float)job->height;
+    job->cpu->deposit[i] = onScreen ? (int)sy * job->width + (int)sx : -1;
+  }
+}
+
+static void HsvToRgb(float h, float s, float v, float *r, float *g, float *b) {
+  const float k[3] = {1.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float rgb[3];
+  for (int c = 0; c < 3; c++) {
+    const float t = h + k[c];
+    const float p = fabsf((t - floorf(t)) * 6.0f - 3.0f);
+    const float channel = fminf(fmaxf(p - 1.0f, 0.0f), 1.0f);
+    rgb[c] = v * (1.0f + (channel - 1.0f) * s);
+  }
+  *r = rgb[0];
+  *g = rgb[1];
+  *b = rgb[2];
+}
+
+void ParticleLifeCpuStep(ParticleLifeCpu *cpu, const ParticleLife *pl,
+                         const float rotation[9], float deltaTime) {
+  if (cpu == NULL || cpu->count == 0) {
+    return;
+  }
+  const ParticleLifeConfig *cfg = &pl->config;
+
+  // Cubic grid of cells at least rMax wide over the safety clamp sphere
+  int maxDim = 1;
+  while ((maxDim + 1) * (maxDim + 1) * (maxDim + 1) <= MAX_GRID_CELLS) {
+    maxDim++;
+  }
+  const float halfExtent = fmaxf(cfg->boundsRadius * 1.1f, 0.001f);
+  const float rMax = fmaxf(cfg->rMax, 0.001f);
+  int dim = (int)ceilf(2.0f * halfExtent / rMax);
+  dim = dim < 1 ? 1 : (dim > maxDim ? maxDim : dim);
+
+  StepJob job = {};
+  job.cpu = cpu;
+  job.matrix = pl->attractionMatrix;
+  job.dim = dim;
+  job.origin = -halfExtent;
+  job.invCellSize = (float)dim / (2.0f * halfExtent);
+  job.pair.rMax = rMax;
+  job.pair.invRMax = 1.0f / rMax;
+  job.pair.beta = cfg->beta;
+  job.pair.invBeta = 1.0f / fmaxf(cfg->beta, 0.001f);
+  job.pair.invOuter = 1.0f / fmaxf(1.0f - cfg->beta, 0.001f);
+  job.forceScale = rMax * cfg->forceFactor;
+  job.momentum = cfg->momentum;
+  job.boundsRadius = cfg->boundsRadius;
+  job.boundaryStiffness = cfg->boundaryStiffness;
+  job.dt = deltaTime;
+  job.rotation = rotation;
+  job.projection =
+      cfg->projectionScale * (float)(pl->width < pl->height ? pl->width
+                                                            : pl->height);
+  job.centerX = cfg->x * (float)pl->width;
+  job.centerY = cfg->y * (float)pl->height;
+  job.width = pl->width;
+  job.height = pl->height;
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, BinAgents, &job);
+  SortByCell(cpu, dim * dim * dim);
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, StepAgents, &job);
+
+  // Serial deposit: agents landing on one pixel must not race
+  float saturation;
+  float value;
+  ColorConfigGetSV(&cfg->color, &saturation, &value);
+  for (int i = 0; i < cpu->count; i++) {
+    const int pixel = cpu->deposit[i];
+    if (pixel < 0) {
+      continue;
+    }
+    float r;
+    float g;
+    float b;
+    HsvToRgb(cpu->agents.hue[i], saturation, value, &r, &g, &b);
+    TrailMapDeposit(pl->trailMap, pixel % pl->width, pixel / pl->width,
+                    r * cfg->depositAmount, g * cfg->depositAmount,
+                    b * cfg->depositAmount);
+  }
+}
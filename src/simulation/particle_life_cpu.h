@@ -0,0 +1,35 @@
+#ifndef PARTICLE_LIFE_CPU_H
+#define PARTICLE_LIFE_CPU_H
+
+#include "particle_life.h"
+#include <stdbool.h>
+
+// CPU backend for Particle Life. Agents live in SoA arrays. Each step bins
+// them into a 3D grid of rMax cells with a counting sort (the compute path's
+// spatial hash), updates every agent against the 27 cells around it on the
+// worker pool, and deposits into the CPU trail map.
+typedef struct ParticleLifeCpu ParticleLifeCpu;
+
+// Returns NULL on allocation failure
+ParticleLifeCpu *ParticleLifeCpuInit(void);
+
+void ParticleLifeCpuUninit(ParticleLifeCpu *cpu);
+
+// Replace the agents. Returns false and keeps the old agents when the
+// arrays cannot be allocated.
+bool ParticleLifeCpuLoad(ParticleLifeCpu *cpu, const ParticleLifeAgent *agents,
+                         int count);
+
+// Resize to count agents, keeping min(current, count) in their current state
+// (an even stride of them when shrinking) and appending newAgents (the
+// count - current new ones) when growing. Returns false and keeps the old
+// agents on allocation failure.
+bool ParticleLifeCpuResize(ParticleLifeCpu *cpu,
+                           const ParticleLifeAgent *newAgents, int count);
+
+// Advance every agent by deltaTime with pl's config and attraction matrix,
+// depositing into pl's trail map. rotation is column-major.
+void ParticleLifeCpuStep(ParticleLifeCpu *cpu, const ParticleLife *pl,
+                         const float rotation[9], float deltaTime);
+
+#endif // PARTICLE_LIFE_CPU_H
@@ -1,4 +1,5 @@
 #include "physarum.h"
+#include "physarum_cpu.h"
 #include "automation/mod_sources.h"
 #include "automation/modulation_engine.h"
 #include "config/effect_descriptor.h"
@@ -9,6 +10,8 @@
 #include "render/post_effect.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
+#include "spatial_hash.h"
 #include "trail_map.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -17,14 +20,19 @@
 #include <stdlib.h>
 
 static const char *COMPUTE_SHADER_PATH = "shaders/physarum_agents.glsl";
-
-static void InitializeAgents(PhysarumAgent *agents, int count, int width,
-                             int height, const ColorConfig *color) {
-  for (int i = 0; i < count; i++) {
-    agents[i].x = (float)(GetRandomValue(0, width - 1));
-    agents[i].y = (float)(GetRandomValue(0, height - 1));
-    agents[i].heading = (float)GetRandomValue(0, 628) / 100.0f;
-    agents[i].hue = ColorConfigAgentHue(color, i, count);
+// Screen tile the reorder pass groups agents by; a few texture cache lines
+static const float SORT_CELL_SIZE = 32.0f;
+
+// Fill agents[0..count-first) with agents first..count-1 of count
+static void InitializeAgents(PhysarumAgent *agents, int first, int count,
+                             int width, int height, const ColorConfig *color) {
+  for (int i = first; i < count; i++) {
+    PhysarumAgent *agent = &agents[i - first];
+    agent->x = (float)(GetRandomValue(0, width - 1));
+    agent->y = (float)(GetRandomValue(0, height - 1));
+    agent->heading = (float)GetRandomValue(0, 628) / 100.0f;
+    agent->hue = ColorConfigAgentHue(color, i, count);
+    agent->seed = (unsigned int)i;
   }
 }
 
@@ -98,7 +106,7 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
     return 0;
   }
 
-  InitializeAgents(agents, agentCount, width, height, color);
+  InitializeAgents(agents, 0, agentCount, width, height, color);
   const GLuint buffer = rlLoadShaderBuffer(agentCount * sizeof(PhysarumAgent),
                                            agents, RL_DYNAMIC_COPY);
   free(agents);
@@ -109,12 +117,54 @@ static GLuint CreateAgentBuffer(int agentCount, int width, int height,
   return buffer;
 }
 
+// Reorder target and tile hash, both sized to the agent capacity and screen
+static bool CreateCellSort(Physarum *p) {
+  p->sortedBuffer = rlLoadShaderBuffer(
+      p->agentCapacity * sizeof(PhysarumAgent), NULL, RL_DYNAMIC_COPY);
+  if (p->sortedBuffer == 0) {
+    TraceLog(LOG_ERROR, "PHYSARUM: Failed to create sorted agent SSBO");
+    return false;
+  }
+
+  p->spatialHash =
+      SpatialHashInit(p->agentCapacity, SORT_CELL_SIZE, p->width, p->height);
+  if (p->spatialHash == NULL) {
+    TraceLog(LOG_ERROR, "PHYSARUM: Failed to create spatial hash");
+    return false;
+  }
+  return true;
+}
+
+static void FreeCellSort(Physarum *p) {
+  if (p->sortedBuffer != 0) {
+    rlUnloadShaderBuffer(p->sortedBuffer);
+    p->sortedBuffer = 0;
+  }
+  SpatialHashUninit(p->spatialHash);
+  p->spatialHash = NULL;
+}
+
+// CPU backend: replace the agents with a fresh spawn
+static bool LoadCpuAgents(Physarum *p) {
+  PhysarumAgent *agents = static_cast<PhysarumAgent *>(
+      malloc(p->agentCount * sizeof(PhysarumAgent)));
+  if (agents == NULL) {
+    return false;
+  }
+
+  InitializeAgents(agents, 0, p->agentCount, p->width, p->height,
+                   &p->config.color);
+  const bool loaded = PhysarumCpuLoad(p->cpu, agents, p->agentCount);
+  free(agents);
+  return loaded;
+}
+
 Physarum *PhysarumInit(int width, int height, const PhysarumConfig *config) {
   if (!PhysarumSupported()) {
-    TraceLog(LOG_WARNING,
-             "PHYSARUM: Compute shaders not supported (requires OpenGL 4.3)");
-    return NULL;
+    TraceLog(LOG_WARNING, "PHYSARUM: Compute shaders not supported (requires "
+                          "OpenGL 4.3), using CPU backend");
   }
+  const bool cpuBackend = SimCpuBackend();
 
   Physarum *p = static_cast<Physarum *>(calloc(1, sizeof(Physarum)));
   if (p == NULL) {
@@ -131,12 +181,19 @@ Physarum *PhysarumInit(int width, int height, const PhysarumConfig *config) {
   p->time = 0.0f;
   p->supported = true;
 
-  p->computeProgram = LoadComputeProgram(p);
-  if (p->computeProgram == 0) {
-    goto cleanup;
+  if (!cpuBackend) {
+    p->computeProgram = LoadComputeProgram(p);
+    if (p->computeProgram == 0) {
+      goto cleanup;
+    }
   }
 
-  p->trailMap = TrailMapInit(width, height);
+  p->trailMap =
+      cpuBackend
+          ? TrailMapInitCpu(TrailMapGridSize(width, p->config.gridDivisor),
+                            TrailMapGridSize(height, p->config.gridDivisor))
+          : TrailMapInit(TrailMapGridSize(width, p->config.gridDivisor),
+                         TrailMapGridSize(height, p->config.gridDivisor));
   if (p->trailMap == NULL) {
     TraceLog(LOG_ERROR, "PHYSARUM: Failed to create trail map");
     goto cleanup;
@@ -148,11 +205,29 @@ Physarum *PhysarumInit(int width, int height, const PhysarumConfig *config) {
              "PHYSARUM: Failed to load debug shader, using default");
   }
 
+  if (cpuBackend) {
+    // No cell sort: the CPU step reads the trails straight from memory
+    p->cpu = PhysarumCpuInit();
+    if (p->cpu == NULL || !LoadCpuAgents(p)) {
+      TraceLog(LOG_ERROR, "PHYSARUM: Failed to create CPU backend");
+      goto cleanup;
+    }
+    TraceLog(LOG_INFO, "PHYSARUM: Initialized with %d agents at %dx%d on the "
+                       "CPU",
+             p->agentCount, width, height);
+    return p;
+  }
+
   p->agentBuffer =
       CreateAgentBuffer(p->agentCount, width, height, &p->config.color);
   if (p->agentBuffer == 0) {
     goto cleanup;
   }
+  p->agentCapacity = p->agentCount;
+
+  if (!CreateCellSort(p)) {
+    goto cleanup;
+  }
 
   TraceLog(LOG_INFO, "PHYSARUM: Initialized with %d agents at %dx%d",
            p->agentCount, width, height);
@@ -169,6 +244,8 @@ void PhysarumUninit(Physarum *p) {
   }
 
   rlUnloadShaderBuffer(p->agentBuffer);
+  PhysarumCpuUninit(p->cpu);
+  FreeCellSort(p);
   TrailMapUninit(p->trailMap);
   if (p->debugShader.id != 0) {
     UnloadShader(p->debugShader);
@@ -228,6 +305,32 @@ void PhysarumUpdate(Physarum *p, float deltaTime, Texture2D accumTexture,
                               p->config.attractorBaseRadius, 0.5f, 0.5f, count,
                               attractors);
 
+  if (p->cpu != NULL) {
+    PhysarumCpuStep(p->cpu, p, attractors);
+    return;
+  }
+
+  // Every few frames, gather the agents into screen tile order so each
+  // workgroup senses and deposits into neighboring texels
+  if (p->config.cellSort && p->spatialHash != NULL &&
+      ++p->framesSinceSort >= SPATIAL_HASH_SORT_INTERVAL) {
+    SpatialHashBuild(p->spatialHash, p->agentBuffer, p->agentCount,
+                     (int)sizeof(PhysarumAgent), 0);
+    SpatialHashReorder(p->spatialHash, p->agentBuffer, p->sortedBuffer,
+                       p->agentCount, (int)sizeof(PhysarumAgent));
+    const unsigned int sorted = p->sortedBuffer;
+    p->sortedBuffer = p->agentBuffer;
+    p->agentBuffer = sorted;
+    p->framesSinceSort = 0;
+  }
+
+  // Downsampled grids splat deposits into the trail map's atomic sums
+  const bool accumulate = p->trailMap->width != p->width ||
+                          p->trailMap->height != p->height;
+  if (accumulate && !TrailMapBindDeposits(p->trailMap)) {
+    return;
+  }
+
   rlEnableShader(p->computeProgram);
 
   const float resolution[2] = {(float)p->width, (float)p->height};
@@ -286,7 +389,7 @@ void PhysarumUpdate(Physarum *p, float deltaTime, Texture2D accumTexture,
   rlSetUniform(p->saturationLoc, &saturation, RL_SHADER_UNIFORM_FLOAT, 1);
   rlSetUniform(p->valueLoc, &value, RL_SHADER_UNIFORM_FLOAT, 1);
 
-  rlBindShaderBuffer(p->agentBuffer, 0);
+  SimBindAgentBuffer(p->agentBuffer, 0, p->agentCount, sizeof(PhysarumAgent));
   rlBindImageTexture(TrailMapGetTexture(p->trailMap).id, 1,
                      RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
   glActiveTexture(GL_TEXTURE2);
@@ -303,6 +406,10 @@ void PhysarumUpdate(Physarum *p, float deltaTime, Texture2D accumTexture,
                   GL_TEXTURE_FETCH_BARRIER_BIT);
 
   rlDisableShader();
+
+  if (accumulate) {
+    TrailMapResolveDeposits(p->trailMap);
+  }
 }
 
 void PhysarumProcessTrails(const Physarum *p, float deltaTime) {
@@ -323,13 +430,21 @@ void PhysarumDrawDebug(const Physarum *p) {
   if (p->debugShader.id != 0) {
     BeginShaderMode(p->debugShader);
   }
-  DrawTextureRec(trailTex, {0, 0, (float)p->width, (float)-p->height}, {0, 0},
+  DrawTexturePro(trailTex,
+                 {0, 0, (float)trailTex.width, (float)-trailTex.height},
+                 {0, 0, (float)p->width, (float)p->height}, {0, 0}, 0.0f,
                  WHITE);
   if (p->debugShader.id != 0) {
     EndShaderMode();
   }
 }
 
+// The trail map follows the screen at 1/gridDivisor scale
+static void SyncTrailGrid(Physarum *p) {
+  TrailMapResize(p->trailMap, TrailMapGridSize(p->width, p->config.gridDivisor),
+                 TrailMapGridSize(p->height, p->config.gridDivisor));
+}
+
 void PhysarumResize(Physarum *p, int width, int height) {
   if (p == NULL || (width == p->width && height == p->height)) {
     return;
@@ -338,7 +453,13 @@ void PhysarumResize(Physarum *p, int width, int height) {
   p->width = width;
   p->height = height;
 
-  TrailMapResize(p->trailMap, width, height);
+  SyncTrailGrid(p);
+
+  // Tile grid follows the screen
+  FreeCellSort(p);
+  if (p->cpu == NULL && !CreateCellSort(p)) {
+    TraceLog(LOG_ERROR, "PHYSARUM: Failed to recreate cell sort on resize");
+  }
 
   PhysarumReset(p);
 }
@@ -350,19 +471,95 @@ void PhysarumReset(Physarum *p) {
 
   TrailMapClear(p->trailMap);
 
+  if (p->cpu != NULL) {
+    LoadCpuAgents(p);
+    return;
+  }
+
   PhysarumAgent *agents = static_cast<PhysarumAgent *>(
       malloc(p->agentCount * sizeof(PhysarumAgent)));
   if (agents == NULL) {
     return;
   }
 
-  InitializeAgents(agents, p->agentCount, p->width, p->height,
+  InitializeAgents(agents, 0, p->agentCount, p->width, p->height,
                    &p->config.color);
   rlUpdateShaderBuffer(p->agentBuffer, agents,
                        p->agentCount * sizeof(PhysarumAgent), 0);
   free(agents);
 }
 
+// Shrink to count agents in place, taking every (agentCount / count)-th agent
+// in tile order so each tile keeps its share rather than the regions at the
+// buffer tail emptying
+static void ThinAgents(Physarum *p, int count) {
+  if (p->spatialHash == NULL || p->sortedBuffer == 0) {
+    return;
+  }
+
+  SpatialHashBuild(p->spatialHash, p->agentBuffer, p->agentCount,
+                   (int)sizeof(PhysarumAgent), 0);
+  SpatialHashThin(p->spatialHash, p->agentBuffer, p->sortedBuffer,
+                  p->agentCount, count, (int)sizeof(PhysarumAgent));
+  const unsigned int thinned = p->sortedBuffer;
+  p->sortedBuffer = p->agentBuffer;
+  p->agentBuffer = thinned;
+}
+
+// Keep the running network, appending freshly spawned agents when growing and
+// thinning them evenly when shrinking
+static void ResizeAgents(Physarum *p, int count) {
+  const int oldCount = p->agentCount;
+  const int oldCapacity = p->agentCapacity;
+
+  PhysarumAgent *newAgents = NULL;
+  if (count > oldCount) {
+    newAgents = static_cast<PhysarumAgent *>(
+        malloc((count - oldCount) * sizeof(PhysarumAgent)));
+    if (newAgents == NULL) {
+      return;
+    }
+    InitializeAgents(newAgents, oldCount, count, p->width, p->height,
+                     &p->config.color);
+  }
+
+  if (p->cpu != NULL) {
+    if (PhysarumCpuResize(p->cpu, newAgents, count)) {
+      p->agentCount = count;
+    }
+    free(newAgents);
+    return;
+  }
+
+  if (count < oldCount) {
+    ThinAgents(p, count);
+  }
+  const bool resized =
+      SimResizeAgentBuffer(&p->agentBuffer, &p->agentCapacity, oldCount, count,
+                           sizeof(PhysarumAgent), newAgents);
+  free(newAgents);
+  if (!resized) {
+    return;
+  }
+  p->agentCount = count;
+
+  if (p->agentCapacity == oldCapacity) {
+    return;
+  }
+
+  // The reorder target swaps with agentBuffer, so it tracks the capacity
+  rlUnloadShaderBuffer(p->sortedBuffer);
+  p->sortedBuffer = rlLoadShaderBuffer(
+      p->agentCapacity * sizeof(PhysarumAgent), NULL, RL_DYNAMIC_COPY);
+  if (p->sortedBuffer == 0 ||
+      !SpatialHashReserve(p->spatialHash, p->agentCapacity)) {
+    FreeCellSort(p);
+  }
+
+  TraceLog(LOG_INFO, "PHYSARUM: Grew agent buffers to %d agents",
+           p->agentCapacity);
+}
+
 void PhysarumApplyConfig(Physarum *p, const PhysarumConfig *newConfig) {
   if (p == NULL || newConfig == NULL) {
     return;
@@ -378,29 +575,13 @@ void PhysarumApplyConfig(Physarum *p, const PhysarumConfig *newConfig) {
       !ColorConfigEquals(&p->config.color, &newConfig->color);
 
   p->config = *newConfig;
+  TrailMapSetActive(p->trailMap, p->config.enabled);
+  SyncTrailGrid(p);
 
   if (needsBufferRealloc) {
-    rlUnloadShaderBuffer(p->agentBuffer);
-    p->agentCount = newAgentCount;
-
-    PhysarumAgent *agents = static_cast<PhysarumAgent *>(
-        malloc(p->agentCount * sizeof(PhysarumAgent)));
-    if (agents == NULL) {
-      p->agentBuffer = 0;
-      return;
-    }
-
-    InitializeAgents(agents, p->agentCount, p->width, p->height,
-                     &p->config.color);
-    p->agentBuffer = rlLoadShaderBuffer(p->agentCount * sizeof(PhysarumAgent),
-                                        agents, RL_DYNAMIC_COPY);
-    free(agents);
-
-    TrailMapClear(p->trailMap);
-
-    TraceLog(LOG_INFO, "PHYSARUM: Reallocated buffer for %d agents",
-             p->agentCount);
-  } else if (needsHueReinit) {
+    ResizeAgents(p, newAgentCount);
+  }
+  if (needsHueReinit) {
     PhysarumReset(p);
   }
 }
@@ -419,6 +600,10 @@ static const int PHYSARUM_WALK_MODE_COUNT = 8;
 
 static void DrawPhysarumParams(EffectConfig *e, const ModSources *ms, ImU32) {
   ImGui::SliderInt("Agents", &e->physarum.agentCount, 10000, 5000000);
+  ImGui::Checkbox("Cell Sort##physarum", &e->physarum.cellSort);
+  ImGui::SliderFloat("Step Rate##physarum", &e->physarum.stepRate, 0.0f, 240.0f,
+                     "%.0f Hz");
+  ImGuiDrawTrailGrid("Trail Grid##physarum", &e->physarum.gridDivisor);
 
   ImGui::SeparatorText("Bounds");
   int boundsMode = (int)e->physarum.boundsMode;
@@ -451,7 +636,10 @@ static void DrawPhysarumParams(EffectConfig *e, const ModSources *ms, ImU32) {
                             "physarum.sensorAngle", ms);
   ModulatableSliderAngleDeg("Turn Angle", &e->physarum.turningAngle,
                             "physarum.turningAngle", ms);
+  // Accum sensing needs the GPU accumulation texture
+  ImGui::BeginDisabled(SimCpuBackend());
   ImGui::SliderFloat("Sense Blend", &e->physarum.accumSenseBlend, 0.0f, 1.0f);
+  ImGui::EndDisabled();
 
   ImGui::SeparatorText("Animation");
   ModulatableSlider("Step Size", &e->physarum.stepSize, "physarum.stepSize",
@@ -516,8 +704,10 @@ static void DrawPhysarumParams(EffectConfig *e, const ModSources *ms, ImU32) {
 }
 
 void SetupPhysarumTrailBoost(PostEffect *pe) {
-  BlendCompositorApply(
-      pe->blendCompositor, TrailMapGetTexture(pe->physarum->trailMap),
+  const TrailMap *trailMap = pe->physarum->trailMap;
+  BlendCompositorApplyStepped(
+      pe->blendCompositor, TrailMapGetPreviousTexture(trailMap),
+      TrailMapGetTexture(trailMap), trailMap->stepAlpha,
       pe->effects.physarum.boostIntensity, pe->effects.physarum.blendMode);
 }
 
@@ -9,6 +9,8 @@
 #include <stdbool.h>
 
 typedef struct TrailMap TrailMap;
+typedef struct SpatialHash SpatialHash;
+typedef struct PhysarumCpu PhysarumCpu;
 
 typedef enum {
   PHYSARUM_WALK_NORMAL = 0,   // Fixed step = stepSize
@@ -25,8 +27,9 @@ typedef struct PhysarumAgent {
   float x;
   float y;
   float heading;
-  float hue;     // Agent's hue identity (0-1) for deposit color and affinity
-  float _pad[4]; // Pad to 32 bytes for GPU alignment
+  float hue;         // Hue identity (0-1) for deposit color and affinity
+  unsigned int seed; // Stable hash seed; cell sort reorders the buffer
+  float _pad[3];     // Pad to 32 bytes for GPU alignment
 } PhysarumAgent;
 
 typedef struct PhysarumConfig {
@@ -50,6 +53,8 @@ typedef struct PhysarumConfig {
   float depositAmount = 0.05f;
   float decayHalfLife = 0.5f;  // Seconds for 50% decay (0.1-5.0 range)
   int diffusionScale = 1;      // Diffusion kernel scale in pixels (0-4 range)
+  float stepRate = 0.0f;       // Fixed steps per second (0 = every frame)
+  int gridDivisor = 1;         // Trail grid downsample per axis (1, 2 or 4)
   float boostIntensity = 1.0f; // Trail boost strength (0.0-5.0)
   EffectBlendMode blendMode =
       EFFECT_BLEND_SCREEN;      // Blend mode for trail compositing
@@ -79,6 +84,7 @@ typedef struct PhysarumConfig {
       .phase = 0.0f,
   };
   bool debugOverlay = false; // Show color debug visualization
+  bool cellSort = true;      // Keep agents in screen tile order
   ColorConfig color;         // Hue distribution for species
 } PhysarumConfig;
 
@@ -90,14 +96,18 @@ typedef struct PhysarumConfig {
       boostIntensity, blendMode, accumSenseBlend, repulsionStrength,           \
       samplingExponent, vectorSteering, respawnMode, gravityStrength,          \
       orbitOffset, attractorCount, attractorBaseRadius, lissajous, color,      \
-      debugOverlay
+      debugOverlay, cellSort, stepRate, gridDivisor
 
 typedef struct Physarum {
   unsigned int agentBuffer;
+  unsigned int sortedBuffer; // Reorder target, swapped with agentBuffer
   unsigned int computeProgram;
+  PhysarumCpu *cpu; // CPU backend state; NULL on the compute path
   TrailMap *trailMap;
+  SpatialHash *spatialHash; // Screen tiles for the reorder pass
   Shader debugShader;
   int agentCount;
+  int agentCapacity; // Agents the buffers hold; grows, never shrinks
   int width;
   int height;
   int resolutionLoc;
@@ -129,6 +139,7 @@ typedef struct Physarum {
   int sprintFactorLoc;
   int gradientBoostLoc;
   float time;
+  int framesSinceSort;
   PhysarumConfig config;
   bool supported;
 } Physarum;
@@ -137,7 +148,9 @@ typedef struct Physarum {
 bool PhysarumSupported(void);
 
 // Initialize physarum simulation
-// Returns NULL if compute shaders not supported or allocation fails
+// Runs on the CPU backend (sim_cpu.h) without compute shaders, sensing the
+// trails only (accumSenseBlend is ignored there)
+// Returns NULL if allocation fails
 Physarum *PhysarumInit(int width, int height, const PhysarumConfig *config);
 
 // Clean up physarum resources
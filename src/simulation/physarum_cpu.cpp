@@ -0,0 +1,537 @@
+#include "physarum_cpu.h"
+#include "render/color_config.h"
+#include "sim_cpu.h"
+#include "trail_map.h"
+#include <math.h>
+#include <stdlib.h>
+
+static const int AGENT_GRAIN = 256; // Agents per worker chunk
+static const float PI = 3.14159265f;
+static const float TWO_PI = 6.28318530f;
+static const float HASH_MAX = 4294967295.0f;
+static const float LUMA_R = 0.299f; // Rec. 601, as in physarum_agents.glsl
+static const float LUMA_G = 0.587f;
+static const float LUMA_B = 0.114f;
+
+struct PhysarumCpu {
+  float *x;
+  float *y;
+  float *heading;
+  float *hue;
+  unsigned int *seed;
+  int count;
+};
+
+// Config for one step, shared by the worker chunks
+struct StepJob {
+  PhysarumCpu *cpu;
+  const PhysarumConfig *cfg;
+  const float *trail; // CPU trail map pixels, read-only while steering
+  int gridWidth;
+  int gridHeight;
+  float width; // Screen resolution the agents move in
+  float height;
+  unsigned int timeSeed;
+  const float *attractors;
+  int attractorCount;
+};
+
+// The arrays share one allocation starting at x. keep agents carry over.
+static bool AllocAgents(PhysarumCpu *cpu, int count, int keep) {
+  float *block =
+      static_cast<float *>(malloc((size_t)count * 5 * sizeof(float)));
+  if (block == NULL) {
+    return false;
+  }
+  float *arrays[4];
+  for (int i = 0; i < 4; i++) {
+    arrays[i] = block + (size_t)count * i;
+  }
+  unsigned int *seed =
+      reinterpret_cast<unsigned int *>(block + (size_t)count * 4);
+  // Shrinking takes every (count / keep)-th agent so the survivors stay
+  // spread over the screen; growing copies them in place
+  for (int i = 0; i < keep; i++) {
+    const size_t src = (size_t)i * cpu->count / keep;
+    arrays[0][i] = cpu->x[src];
+    arrays[1][i] = cpu->y[src];
+    arrays[2][i] = cpu->heading[src];
+    arrays[3][i] = cpu->hue[src];
+    seed[i] = cpu->seed[src];
+  }
+  free(cpu->x);
+  cpu->x = arrays[0];
+  cpu->y = arrays[1];
+  cpu->heading = arrays[2];
+  cpu->hue = arrays[3];
+  cpu->seed = seed;
+  cpu->count = count;
+  return true;
+}
+
+PhysarumCpu *PhysarumCpuInit(void) {
+  return static_cast<PhysarumCpu *>(calloc(1, sizeof(PhysarumCpu)));
+}
+
+void PhysarumCpuUninit(PhysarumCpu *cpu) {
+  if (cpu == NULL) {
+    return;
+  }
+  free(cpu->x);
+  free(cpu);
+}
+
+// Copy count agents into the state arrays starting at first
+static void StoreAgents(PhysarumCpu *cpu, int first,
+                        const PhysarumAgent *agents, int count) {
+  for (int i = 0; i < count; i++) {
+    cpu->x[first + i] = agents[i].x;
+    cpu->y[first + i] = agents[i].y;
+    cpu->heading[first + i] = agents[i].heading;
+    cpu->hue[first + i] = agents[i].hue;
+    cpu->seed[first + i] = agents[i].seed;
+  }
+}
+
+bool PhysarumCpuLoad(PhysarumCpu *cpu, const PhysarumAgent *agents,
+                     int count) {
+  if (cpu == NULL || agents == NULL || count < 1) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, 0)) {
+    return false;
+  }
+
+  StoreAgents(cpu, 0, agents, count);
+  return true;
+}
+
+bool PhysarumCpuResize(PhysarumCpu *cpu, const PhysarumAgent *newAgents,
+                       int count) {
+  if (cpu == NULL || count < 1) {
+    return false;
+  }
+  const int keep = cpu->count < count ? cpu->count : count;
+  if (count > keep && newAgents == NULL) {
+    return false;
+  }
+  if (count != cpu->count && !AllocAgents(cpu, count, keep)) {
+    return false;
+  }
+
+  StoreAgents(cpu, keep, newAgents, count - keep);
+  return true;
+}
+
+// Same hash as the shader (Sage Jenson's), so stochastic modes match
+static unsigned int Hash(unsigned int state) {
+  state ^= 2747636419u;
+  state *= 2654435769u;
+  state ^= state >> 16;
+  state *= 2654435769u;
+  state ^= state >> 16;
+  return state;
+}
+
+static float HashUnit(unsigned int state) {
+  return (float)Hash(state) / HASH_MAX;
+}
+
+// Box-Muller: Gaussian with mean 0 and stddev 1
+static float Gaussian(unsigned int *state) {
+  float u1 = HashUnit(*state);
+  *state = Hash(*state);
+  const float u2 = HashUnit(*state);
+  *state = Hash(*state);
+  u1 = fmaxf(u1, 1e-6f);
+  return sqrtf(-2.0f * logf(u1)) * cosf(TWO_PI * u2);
+}
+
+// GLSL mod: the result takes the sign of m
+static float Mod(float x, float m) { return x - m * floorf(x / m); }
+
+// Hue channel of the shader's rgb2hsv
+static float RgbHue(float r, float g, float b) {
+  const bool gMax = g >= b;
+  const float px = gMax ? g : b;
+  const float py = gMax ? b : g;
+  const float pz = gMax ? 0.0f : -1.0f;
+  const float pw = gMax ? -1.0f / 3.0f : 2.0f / 3.0f;
+
+  const bool rMax = r >= px;
+  const float qx = rMax ? r : px;
+  const float qz = rMax ? pz : pw;
+  const float qw = rMax ? px : r;
+  const float d = qx - fminf(qw, py);
+  return fabsf(qz + (qw - py) / (6.0f * d + 1.0e-10f));
+}
+
+static void HsvToRgb(float h, float s, float v, float *r, float *g, float *b) {
+  const float k[3] = {1.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+  float rgb[3];
+  for (int c = 0; c < 3; c++) {
+    const float t = h + k[c];
+    const float p = fabsf((t - floorf(t)) * 6.0f - 3.0f);
+    const float channel = fminf(fmaxf(p - 1.0f, 0.0f), 1.0f);
+    rgb[c] = v * (1.0f + (channel - 1.0f) * s);
+  }
+  *r = rgb[0];
+  *g = rgb[1];
+  *b = rgb[2];
+}
+
+// Trail map texel under a screen position; the grid may be downsampled
+static const float *TrailTexel(const StepJob *job, float px, float py) {
+  int cx = (int)(Mod(px, job->width) * (float)job->gridWidth / job->width);
+  int cy = (int)(Mod(py, job->height) * (float)job->gridHeight / job->height);
+  cx = cx < job->gridWidth ? cx : job->gridWidth - 1;
+  cy = cy < job->gridHeight ? cy : job->gridHeight - 1;
+  return job->trail + ((size_t)cy * job->gridWidth + cx) * 4;
+}
+
+static float TrailLuma(const StepJob *job, float px, float py) {
+  const float *t = TrailTexel(job, px, py);
+  return t[0] * LUMA_R + t[1] * LUMA_G + t[2] * LUMA_B;
+}
+
+static bool OutOfBounds(const StepJob *job, float px, float py) {
+  return px < 0.0f || px >= job->width || py < 0.0f || py >= job->height;
+}
+
+// Affinity of the trail at a sensor (lower = more attractive), as in the
+// shader's computeAffinity. Sensing reads the trails only on this backend.
+static float SenseAffinity(const StepJob *job, float px, float py,
+                           float agentHue) {
+  const float repulsion = job->cfg->repulsionStrength;
+  if (job->cfg->boundsMode != PHYSARUM_BOUNDS_TOROIDAL &&
+      OutOfBounds(job, px, py)) {
+    return 1.0f;
+  }
+  const float *t = TrailTexel(job, px, py);
+  const float intensity = t[0] * LUMA_R + t[1] * LUMA_G + t[2] * LUMA_B;
+  if (intensity < 0.001f) {
+    return 1.0f + (0.5f - 1.0f) * repulsion;
+  }
+
+  const float diff = fabsf(agentHue - RgbHue(t[0], t[1], t[2]));
+  const float hueDiff = fminf(diff, 1.0f - diff);
+  const float oldAffinity = hueDiff + (1.0f - intensity) * 0.3f;
+  const float attraction = intensity * (1.0f - hueDiff * 2.0f);
+  const float repel = intensity * hueDiff * 2.0f;
+  const float newAffinity = 0.5f - attraction * 0.5f + repel * 2.0f;
+  return oldAffinity + (newAffinity - oldAffinity) * repulsion;
+}
+
+// Turn toward the sensors' preferred direction
+static float Steer(const StepJob *job, float heading, float front, float left,
+                   float right, float rnd) {
+  const PhysarumConfig *cfg = job->cfg;
+  const float sa = cfg->sensorAngle;
+  const float turn = cfg->turningAngle;
+
+  if (cfg->vectorSteering) {
+    // Attractive sensors pull toward, repulsive ones push away
+    const float sx = cosf(heading) * (0.5f - front) +
+                     cosf(heading + sa) * (0.5f - left) +
+                     cosf(heading - sa) * (0.5f - right);
+    const float sy = sinf(heading) * (0.5f - front) +
+                     sinf(heading + sa) * (0.5f - left) +
+                     sinf(heading - sa) * (0.5f - right);
+    if (sqrtf(sx * sx + sy * sy) > 0.001f) {
+      float angleDiff = atan2f(sy, sx) - heading;
+      angleDiff = Mod(angleDiff + 3.14159f, 6.28318f) - 3.14159f;
+      return heading + fminf(fmaxf(angleDiff, -turn), turn);
+    }
+    return heading + (rnd - 0.5f) * turn * 2.0f;
+  }
+
+  if (cfg->samplingExponent > 0.0f) {
+    // MCPM: mutate toward the better side with Pmut = d1^e / (d0^e + d1^e)
+    const float d1 = left < right ? left : right;
+    const float turnDir = left < right ? 1.0f : -1.0f;
+    const float p0 = powf(front, cfg->samplingExponent);
+    const float p1 = powf(d1, cfg->samplingExponent);
+    if (rnd < p1 / (p0 + p1 + 0.0001f)) {
+      return heading + turnDir * turn;
+    }
+    return heading;
+  }
+
+  if (front < left && front < right) {
+    return heading;
+  }
+  if (front > left && front > right) {
+    return heading + (rnd - 0.5f) * turn * 2.0f;
+  }
+  if (left < right) {
+    return heading + turn;
+  }
+  if (right < left) {
+    return heading - turn;
+  }
+  return heading;
+}
+
+// Step length for the walk mode
+static float WalkStep(const StepJob *job, float x, float y, float heading,
+                      float preHeading, unsigned int *hashState) {
+  const PhysarumConfig *cfg = job->cfg;
+  const float step = cfg->stepSize;
+
+  switch (cfg->walkMode) {
+  case PHYSARUM_WALK_LEVY:
+    if (cfg->levyAlpha > 0.001f) {
+      const float u = fmaxf(HashUnit(*hashState), 0.001f);
+      *hashState = Hash(*hashState);
+      return fminf(step * powf(u, -1.0f / cfg->levyAlpha), step * 50.0f);
+    }
+    return step;
+  case PHYSARUM_WALK_ADAPTIVE: {
+    const float density = TrailLuma(job, x, y);
+    return step * (1.0f + (cfg->densityResponse - 1.0f) * density);
+  }
+  case PHYSARUM_WALK_CAUCHY: {
+    float u = HashUnit(*hashState);
+    *hashState = Hash(*hashState);
+    u = fminf(fmaxf(u, 0.01f), 0.99f);
+    const float cauchy = tanf(PI * (u - 0.5f)) * cfg->cauchyScale;
+    return fminf(step * (1.0f + fabsf(cauchy)), step * 50.0f);
+  }
+  case PHYSARUM_WALK_EXPONENTIAL: {
+    const float u = fmaxf(HashUnit(*hashState), 0.001f);
+    *hashState = Hash(*hashState);
+    return fminf(step * (-logf(u) * cfg->expScale), step * 50.0f);
+  }
+  case PHYSARUM_WALK_GAUSSIAN: {
+    const float g = Gaussian(hashState);
+    return step * fmaxf(0.1f, 1.0f + g * cfg->gaussianVariance);
+  }
+  case PHYSARUM_WALK_SPRINT: {
+    const float delta =
+        fabsf(Mod(fabsf(heading - preHeading) + PI, TWO_PI) - PI);
+    return step * (1.0f + cfg->sprintFactor * delta);
+  }
+  case PHYSARUM_WALK_GRADIENT: {
+    const float here = TrailLuma(job, x, y);
+    const float ahead = TrailLuma(job, x + cosf(heading) * 2.0f,
+                                  y + sinf(heading) * 2.0f);
+    return step * (1.0f + cfg->gradientBoost * fabsf(ahead - here));
+  }
+  case PHYSARUM_WALK_NORMAL:
+  default:
+    return step;
+  }
+}
+
+static bool ClampToEdge(const StepJob *job, float *x, float *y) {
+  bool hitEdge = false;
+  if (*x < 0.0f) {
+    *x = 0.0f;
+    hitEdge = true;
+  }
+  if (*x >= job->width) {
+    *x = job->width - 1.0f;
+    hitEdge = true;
+  }
+  if (*y < 0.0f) {
+    *y = 0.0f;
+    hitEdge = true;
+  }
+  if (*y >= job->height) {
+    *y = job->height - 1.0f;
+    hitEdge = true;
+  }
+  return hitEdge;
+}
+
+// Mirror the heading off the edges it crossed; true when one was hit
+static bool Reflect(const StepJob *job, float *x, float *y, float *heading) {
+  bool hitEdge = false;
+  if (*x < 0.0f || *x >= job->width) {
+    *x = fminf(fmaxf(*x, 0.0f), job->width - 1.0f);
+    *heading = PI - *heading;
+    hitEdge = true;
+  }
+  if (*y < 0.0f || *y >= job->height) {
+    *y = fminf(fmaxf(*y, 0.0f), job->height - 1.0f);
+    *heading = -*heading;
+    hitEdge = true;
+  }
+  return hitEdge;
+}
+
+// Redirect toward a target, or teleport onto it in respawn mode
+static void HeadFor(const StepJob *job, float tx, float ty, float *x, float *y,
+                    float *heading) {
+  if (job->cfg->respawnMode) {
+    *x = tx;
+    *y = ty;
+  } else {
+    *heading = atan2f(ty - *y, tx - *x);
+  }
+}
+
+static void ApplyBounds(const StepJob *job, int i, float *x, float *y,
+                        float *heading, unsigned int hashState) {
+  const float cx = job->width * 0.5f;
+  const float cy = job->height * 0.5f;
+  const unsigned int seed = job->cpu->seed[i];
+
+  switch (job->cfg->boundsMode) {
+  case PHYSARUM_BOUNDS_TOROIDAL:
+    *x = Mod(*x, job->width);
+    *y = Mod(*y, job->height);
+    break;
+  case PHYSARUM_BOUNDS_REFLECT:
+    Reflect(job, x, y, heading);
+    break;
+  case PHYSARUM_BOUNDS_REDIRECT:
+    if (ClampToEdge(job, x, y)) {
+      HeadFor(job, cx, cy, x, y, heading);
+    }
+    break;
+  case PHYSARUM_BOUNDS_SCATTER:
+    if (Reflect(job, x, y, heading)) {
+      *heading += (HashUnit(hashState) - 0.5f) * 1.57f;
+    }
+    break;
+  case PHYSARUM_BOUNDS_RANDOM:
+    if (ClampToEdge(job, x, y)) {
+      *heading = HashUnit(hashState) * TWO_PI;
+    }
+    break;
+  case PHYSARUM_BOUNDS_FIXED_HOME:
+    if (ClampToEdge(job, x, y)) {
+      unsigned int homeHash = Hash(seed * 3u + 12345u);
+      const float homeX = (float)homeHash / HASH_MAX * job->width;
+      homeHash = Hash(homeHash);
+      const float homeY = (float)homeHash / HASH_MAX * job->height;
+      *heading = atan2f(homeY - *y, homeX - *x);
+    }
+    break;
+  case PHYSARUM_BOUNDS_ORBIT:
+    if (ClampToEdge(job, x, y)) {
+      *heading = atan2f(cy - *y, cx - *x) + PI * 0.5f;
+    }
+    break;
+  case PHYSARUM_BOUNDS_SPECIES_ORBIT:
+    if (ClampToEdge(job, x, y)) {
+      const float offset = job->cpu->hue[i] * TWO_PI * job->cfg->orbitOffset;
+      *heading = atan2f(cy - *y, cx - *x) + PI * 0.5f + offset;
+    }
+    break;
+  case PHYSARUM_BOUNDS_MULTI_HOME:
+    if (ClampToEdge(job, x, y)) {
+      const unsigned int a = Hash(seed) % (unsigned int)job->attractorCount;
+      HeadFor(job, job->attractors[a * 2] * job->width,
+              job->attractors[a * 2 + 1] * job->height, x, y, heading);
+    }
+    break;
+  case PHYSARUM_BOUNDS_ANTIPODAL:
+    if (ClampToEdge(job, x, y)) {
+      *x = fminf(fmaxf(2.0f * cx - *x, 0.0f), job->width - 1.0f);
+      *y = fminf(fmaxf(2.0f * cy - *y, 0.0f), job->height - 1.0f);
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+// Sense, steer and move, as in physarum_agents.glsl. Deposits wait for the
+// serial pass, so every agent senses the trails as they stood at the start
+// of the step.
+static void MoveAgents(void *ctx, int begin, int end) {
+  const StepJob *job = static_cast<const StepJob *>(ctx);
+  const PhysarumConfig *cfg = job->cfg;
+  PhysarumCpu *cpu = job->cpu;
+
+  for (int i = begin; i < end; i++) {
+    float x = cpu->x[i];
+    float y = cpu->y[i];
+    float heading = cpu->heading[i];
+    const float hue = cpu->hue[i];
+    unsigned int hashState = Hash((unsigned int)i + job->timeSeed);
+
+    // Stable per-agent sensing distance
+    float sensorDist = cfg->sensorDistance;
+    if (cfg->sensorDistanceVariance > 0.001f) {
+      unsigned int distHash = Hash(cpu->seed[i]);
+      const float offset = Gaussian(&distHash) * cfg->sensorDistanceVariance;
+      sensorDist = fminf(fmaxf(cfg->sensorDistance + offset, 1.0f),
+                         cfg->sensorDistance * 2.0f);
+    }
+
+    const float sa = cfg->sensorAngle;
+    const float front = SenseAffinity(job, x + cosf(heading) * sensorDist,
+                                      y + sinf(heading) * sensorDist, hue);
+    const float left =
+        SenseAffinity(job, x + cosf(heading + sa) * sensorDist,
+                      y + sinf(heading + sa) * sensorDist, hue);
+    const float right =
+        SenseAffinity(job, x + cosf(heading - sa) * sensorDist,
+                      y + sinf(heading - sa) * sensorDist, hue);
+
+    const float preHeading = heading;
+    heading =
+        Steer(job, heading, front, left, right, (float)hashState / HASH_MAX);
+
+    const float step = WalkStep(job, x, y, heading, preHeading, &hashState);
+    x += cosf(heading) * step;
+    y += sinf(heading) * step;
+
+    if (cfg->gravityStrength > 0.001f) {
+      const float toX = job->width * 0.5f - x;
+      const float toY = job->height * 0.5f - y;
+      const float force =
+          cfg->gravityStrength * (sqrtf(toX * toX + toY * toY) /
+                                  sqrtf(job->width * job->width +
+                                        job->height * job->height));
+      const float angleDiff =
+          Mod(atan2f(toY, toX) - heading + PI, TWO_PI) - PI;
+      heading += angleDiff * force;
+    }
+
+    ApplyBounds(job, i, &x, &y, &heading, hashState);
+
+    cpu->x[i] = x;
+    cpu->y[i] = y;
+    cpu->heading[i] = heading;
+  }
+}
+
+void PhysarumCpuStep(PhysarumCpu *cpu, const Physarum *p,
+                     const float attractors[16]) {
+  if (cpu == NULL || cpu->count == 0 || p->trailMap->pixels == NULL) {
+    return;
+  }
+  const PhysarumConfig *cfg = &p->config;
+
+  StepJob job = {};
+  job.cpu = cpu;
+  job.cfg = cfg;
+  job.trail = p->trailMap->pixels;
+  job.gridWidth = p->trailMap->width;
+  job.gridHeight = p->trailMap->height;
+  job.width = (float)p->width;
+  job.height = (float)p->height;
+  job.timeSeed = (unsigned int)(p->time * 1000.0f);
+  job.attractors = attractors;
+  job.attractorCount = cfg->attractorCount > 1 ? cfg->attractorCount : 1;
+
+  SimCpuParallelFor(cpu->count, AGENT_GRAIN, MoveAgents, &job);
+
+  // Serial: agents sharing a texel must not race on the proportional scaling
+  float saturation;
+  float value;
+  ColorConfigGetSV(&cfg->color, &saturation, &value);
+  for (int i = 0; i < cpu->count; i++) {
+    float r;
+    float g;
+    float b;
+    HsvToRgb(cpu->hue[i], saturation, value, &r, &g, &b);
+    TrailMapDepositScreen(p->trailMap, cpu->x[i], cpu->y[i], job.width,
+                          job.height, r * cfg->depositAmount,
+                          g * cfg->depositAmount, b * cfg->depositAmount);
+  }
+}
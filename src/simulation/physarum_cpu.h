@@ -0,0 +1,34 @@
+#ifndef PHYSARUM_CPU_H
+#define PHYSARUM_CPU_H
+
+#include "physarum.h"
+#include <stdbool.h>
+
+// CPU backend for Physarum. Agents live in SoA arrays and sense, steer and
+// move on the worker pool against the CPU trail map, then deposit serially.
+// Sensing reads the trails only: accumSenseBlend needs the GPU accumulation
+// texture and is ignored.
+typedef struct PhysarumCpu PhysarumCpu;
+
+// Returns NULL on allocation failure
+PhysarumCpu *PhysarumCpuInit(void);
+
+void PhysarumCpuUninit(PhysarumCpu *cpu);
+
+// Replace the agents. Returns false and keeps the old agents when the
+// arrays cannot be allocated.
+bool PhysarumCpuLoad(PhysarumCpu *cpu, const PhysarumAgent *agents, int count);
+
+// Resize to count agents, keeping min(current, count) in their current state
+// (an even stride of them when shrinking) and appending newAgents (the
+// count - current new ones) when growing. Returns false and keeps the old
+// agents on allocation failure.
+bool PhysarumCpuResize(PhysarumCpu *cpu, const PhysarumAgent *newAgents,
+                       int count);
+
+// Advance every agent one step with p's config, depositing into p's trail
+// map. attractors holds the 8 Multi-Home targets (normalized x, y pairs).
+void PhysarumCpuStep(PhysarumCpu *cpu, const Physarum *p,
+                     const float attractors[16]);
+
+#endif // PHYSARUM_CPU_H
@@ -1,5 +1,7 @@
 #include "shader_utils.h"
+#include "external/glad.h"
 #include "raylib.h"
+#include "rlgl.h"
 #include <stddef.h>
 
 char *SimLoadShaderSource(const char *path) {
@@ -9,3 +11,91 @@ char *SimLoadShaderSource(const char *path) {
   }
   return source;
 }
+
+bool SimResizeAgentBuffer(unsigned int *buffer, int *capacity, int oldCount,
+                          int count, int stride, const void *newAgents) {
+  // Copies and uploads below must see the last dispatch's agent writes
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+  if (count > *capacity) {
+    int grown = *capacity + *capacity / 2;
+    if (grown < count) {
+      grown = count;
+    }
+
+    const unsigned int resized =
+        rlLoadShaderBuffer(grown * stride, NULL, RL_DYNAMIC_COPY);
+    if (resized == 0) {
+      TraceLog(LOG_ERROR, "SIMULATION: Failed to grow agent SSBO to %d agents",
+               grown);
+      return false;
+    }
+
+    const int kept = oldCount < count ? oldCount : count;
+    if (*buffer != 0 && kept > 0) {
+      rlCopyShaderBuffer(resized, *buffer, 0, 0, kept * stride);
+    }
+    rlUnloadShaderBuffer(*buffer);
+    *buffer = resized;
+    *capacity = grown;
+  }
+
+  if (count > oldCount && newAgents != NULL) {
+    rlUpdateShaderBuffer(*buffer, newAgents, (count - oldCount) * stride,
+                         oldCount * stride);
+  }
+  return true;
+}
+
+void SimBindAgentBuffer(unsigned int buffer, unsigned int binding, int count,
+                        int stride) {
+  glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, buffer, 0,
+                    (GLsizeiptr)count * stride);
+}
+
+static const int LIVE_LIST_HEADER_SIZE = 4 * sizeof(GLuint);
+
+bool SimLiveListReserve(SimLiveList *list, int capacity) {
+  if (capacity <= list->capacity && list->buffer != 0) {
+    return true;
+  }
+
+  const unsigned int resized = rlLoadShaderBuffer(
+      LIVE_LIST_HEADER_SIZE + capacity * sizeof(GLuint), NULL, RL_DYNAMIC_COPY);
+  if (resized == 0) {
+    TraceLog(LOG_ERROR, "SIMULATION: Failed to grow live list to %d agents",
+             capacity);
+    return false;
+  }
+
+  rlUnloadShaderBuffer(list->buffer);
+  list->buffer = resized;
+  list->capacity = capacity;
+  SimLiveListClear(list);
+  return true;
+}
+
+void SimLiveListUninit(SimLiveList *list) {
+  rlUnloadShaderBuffer(list->buffer);
+  list->buffer = 0;
+  list->capacity = 0;
+}
+
+void SimLiveListClear(const SimLiveList *list) {
+  static const GLuint EMPTY[4] = {0, 1, 1, 0};
+
+  // The last dispatch that appended to or consumed this list must finish
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  rlUpdateShaderBuffer(list->buffer, EMPTY, sizeof(EMPTY), 0);
+}
+
+void SimLiveListBind(const SimLiveList *list, unsigned int binding) {
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, list->buffer);
+}
+
+void SimLiveListDispatch(const SimLiveList *list) {
+  glMemoryBarrier(GL_COMMAND_BARRIER_BIT);
+  glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, list->buffer);
+  glDispatchComputeIndirect(0);
+  glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, 0);
+}
@@ -1,8 +1,59 @@
 #ifndef SHADER_UTILS_H
 #define SHADER_UTILS_H
 
+#include <stdbool.h>
+
 // Load shader source file with error logging. Returns NULL on failure.
 // Caller must call UnloadFileText() on the returned pointer.
 char *SimLoadShaderSource(const char *path);
 
+// Resize an agent SSBO holding capacity agents of stride bytes from oldCount
+// to count active agents, keeping the first min(oldCount, count) in place.
+// Growing past capacity allocates half again as much (or count, if larger)
+// and copies the survivors on the GPU; shrinking keeps the buffer. newAgents
+// holds the count - oldCount agents appended at oldCount (NULL to skip the
+// upload). Returns false and leaves the buffer untouched when the larger
+// buffer cannot be allocated. Simulations with a spatial hash thin a
+// shrinking population first (SpatialHashThin) so the kept prefix is an even
+// spread of the old one.
+bool SimResizeAgentBuffer(unsigned int *buffer, int *capacity, int oldCount,
+                          int count, int stride, const void *newAgents);
+
+// Bind the first count agents of an agent SSBO, so agents.length() in the
+// shader is the active count rather than the buffer capacity.
+void SimBindAgentBuffer(unsigned int buffer, unsigned int binding, int count,
+                        int stride);
+
+// Compacted list of agent indices for agents that die and respawn. The SSBO
+// starts with the glDispatchComputeIndirect arguments and the index count:
+//
+//   layout(std430) buffer List { uint groups[3]; uint count; uint indices[]; };
+//
+// Shaders append with slot = atomicAdd(count, 1u), store the agent index at
+// indices[slot], and atomicAdd(groups[0], 1u) when slot is a multiple of
+// SIM_LIVE_LIST_GROUP_SIZE, so groups[0] always covers count. Kernels that
+// consume a list use local_size_x = SIM_LIVE_LIST_GROUP_SIZE and return when
+// gl_GlobalInvocationID.x >= count.
+#define SIM_LIVE_LIST_GROUP_SIZE 1024
+
+typedef struct SimLiveList {
+  unsigned int buffer; // Dispatch args, count, then indices
+  int capacity;        // Indices buffer holds; grows, never shrinks
+} SimLiveList;
+
+// Grow list to hold at least capacity indices, discarding its contents.
+// Returns false and leaves the list untouched on allocation failure.
+bool SimLiveListReserve(SimLiveList *list, int capacity);
+
+void SimLiveListUninit(SimLiveList *list);
+
+// Empty the list: zero count and an indirect dispatch of (0, 1, 1) groups
+void SimLiveListClear(const SimLiveList *list);
+
+void SimLiveListBind(const SimLiveList *list, unsigned int binding);
+
+// Dispatch the bound compute program with one invocation per listed index.
+// Waits for the shader writes that filled the list.
+void SimLiveListDispatch(const SimLiveList *list);
+
 #endif // SHADER_UTILS_H
@@ -0,0 +1,51 @@
+#include "sim_clock.h"
+#include <math.h>
+#include <stddef.h>
+
+// Slack for float drift when the frame time is a multiple of the step time,
+// so 60 Hz frames of a 60 Hz sim always run exactly one step
+static const float STEP_EPSILON = 1e-4f;
+// Relative frame time error treated as vsync jitter
+static const float VSYNC_SNAP = 0.03f;
+
+// Snap deltaTime to n steps or 1/n of a step when it is that within jitter
+static float SnapFrameTime(float deltaTime, float stepTime) {
+  const float ratio = deltaTime / stepTime;
+  const float whole =
+      ratio >= 1.0f ? roundf(ratio) : 1.0f / roundf(1.0f / ratio);
+  if (fabsf(ratio - whole) <= whole * VSYNC_SNAP) {
+    return whole * stepTime;
+  }
+  return deltaTime;
+}
+
+SimSteps SimClockAdvance(SimClock *clock, float deltaTime, float stepRate) {
+  SimSteps steps = {0, deltaTime, 1.0f};
+  if (clock == NULL || stepRate <= 0.0f) {
+    steps.count = 1;
+    return steps;
+  }
+
+  steps.stepTime = 1.0f / stepRate;
+  if (deltaTime > 0.0f) {
+    clock->accumulator += SnapFrameTime(deltaTime, steps.stepTime);
+  }
+
+  const float threshold = steps.stepTime * (1.0f - STEP_EPSILON);
+  while (clock->accumulator >= threshold && steps.count < SIM_CLOCK_MAX_STEPS) {
+    clock->accumulator -= steps.stepTime;
+    steps.count++;
+  }
+
+  if (clock->accumulator >= threshold) {
+    clock->accumulator = 0.0f;
+  }
+  steps.alpha = fmaxf(clock->accumulator, 0.0f) / steps.stepTime;
+  return steps;
+}
+
+void SimClockReset(SimClock *clock) {
+  if (clock != NULL) {
+    clock->accumulator = 0.0f;
+  }
+}
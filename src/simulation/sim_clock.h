@@ -0,0 +1,34 @@
+#ifndef SIM_CLOCK_H
+#define SIM_CLOCK_H
+
+// Fixed-rate simulation stepping, decoupled from the display rate. A
+// simulation with a step rate advances that many fixed steps per second of
+// frame time, so it behaves the same at 60 and 144 Hz and a heavy one can
+// step slower than the display.
+
+// Steps per frame before the backlog is dropped, so a stall doesn't make
+// every following frame slower
+#define SIM_CLOCK_MAX_STEPS 4
+
+typedef struct SimClock {
+  float accumulator; // Frame time not yet simulated
+} SimClock;
+
+typedef struct SimSteps {
+  int count;      // Steps due this frame (0 when the sim is ahead)
+  float stepTime; // Seconds each step simulates
+  // Fraction of a step the display is past the last one, for blending the
+  // state before that step into the current one. 1 when stepping per frame.
+  float alpha;
+} SimSteps;
+
+// Add a frame of deltaTime and return the steps due. stepRate <= 0 steps
+// once per frame with deltaTime. Frame times within a few percent of a whole
+// number of steps, or of a whole fraction of one, snap to it, so vsync jitter
+// doesn't alternate 0- and 2-step frames.
+SimSteps SimClockAdvance(SimClock *clock, float deltaTime, float stepRate);
+
+// Forget unsimulated time, e.g. while the simulation is disabled
+void SimClockReset(SimClock *clock);
+
+#endif // SIM_CLOCK_H
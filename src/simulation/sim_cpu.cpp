@@ -0,0 +1,245 @@
+#include "sim_cpu.h"
+#include "raylib.h"
+#include "rlgl.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <string.h>
+#include <thread>
+
+// [begin, end) packed into one word so taking and stealing are single CASes
+struct alignas(64) SimCpuSlice {
+  std::atomic<uint64_t> range;
+};
+
+struct SimCpuPool {
+  std::thread workers[SIM_CPU_MAX_THREADS - 1];
+  int threads; // Including the caller
+  std::mutex mutex;
+  std::condition_variable wake; // Workers: new job or stopping
+  std::condition_variable done; // Caller: last worker finished
+  uint64_t generation;          // Bumped per job
+  int pending;                  // Workers still inside the current job
+  bool stopping;
+
+  // Current job, written before generation is bumped
+  SimCpuRangeFn fn;
+  void *ctx;
+  int grain;
+  SimCpuSlice slices[SIM_CPU_MAX_THREADS];
+};
+
+static SimCpuPool *g_pool = NULL;
+static int g_requestedThreads = 0;
+static bool g_forced = false;
+
+static uint64_t PackRange(uint32_t begin, uint32_t end) {
+  return ((uint64_t)end << 32) | begin;
+}
+
+static uint32_t RangeBegin(uint64_t range) { return (uint32_t)range; }
+
+static uint32_t RangeEnd(uint64_t range) { return (uint32_t)(range >> 32); }
+
+// Claim up to grain items from the front of a slice
+static bool TakeChunk(SimCpuSlice *slice, int grain, int *begin, int *end) {
+  uint64_t range = slice->range.load(std::memory_order_acquire);
+  for (;;) {
+    const uint32_t b = RangeBegin(range);
+    const uint32_t e = RangeEnd(range);
+    if (b >= e) {
+      return false;
+    }
+    const uint32_t next = (e - b > (uint32_t)grain) ? b + (uint32_t)grain : e;
+    if (slice->range.compare_exchange_weak(range, PackRange(next, e),
+                                           std::memory_order_acq_rel)) {
+      *begin = (int)b;
+      *end = (int)next;
+      return true;
+    }
+  }
+}
+
+// Move the back half of the largest remaining slice into self's (empty)
+// slice. Fails once every slice is drained.
+static bool Steal(SimCpuPool *pool, int self) {
+  for (;;) {
+    int victim = -1;
+    uint32_t most = 0;
+    for (int i = 0; i < pool->threads; i++) {
+      const uint64_t range =
+          pool->slices[i].range.load(std::memory_order_relaxed);
+      const uint32_t b = RangeBegin(range);
+      const uint32_t e = RangeEnd(range);
+      if (i != self && b < e && e - b > most) {
+        most = e - b;
+        victim = i;
+      }
+    }
+    if (victim < 0) {
+      return false;
+    }
+
+    SimCpuSlice *slice = &pool->slices[victim];
+    uint64_t range = slice->range.load(std::memory_order_acquire);
+    const uint32_t b = RangeBegin(range);
+    const uint32_t e = RangeEnd(range);
+    if (b >= e) {
+      continue;
+    }
+    // A single chunk is not worth splitting
+    const uint32_t mid = (e - b > (uint32_t)pool->grain) ? b + (e - b) / 2 : b;
+    if (slice->range.compare_exchange_strong(range, PackRange(b, mid),
+                                             std::memory_order_acq_rel)) {
+      pool->slices[self].range.store(PackRange(mid, e),
+                                     std::memory_order_release);
+      return true;
+    }
+  }
+}
+
+static void RunSlices(SimCpuPool *pool, int self) {
+  int begin;
+  int end;
+  do {
+    while (TakeChunk(&pool->slices[self], pool->grain, &begin, &end)) {
+      pool->fn(pool->ctx, begin, end);
+    }
+  } while (Steal(pool, self));
+}
+
+static void WorkerMain(SimCpuPool *pool, int self) {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(pool->mutex);
+      pool->wake.wait(lock, [pool, seen] {
+        return pool->stopping || pool->generation != seen;
+      });
+      if (pool->stopping) {
+        return;
+      }
+      seen = pool->generation;
+    }
+
+    RunSlices(pool, self);
+
+    bool last;
+    {
+      const std::lock_guard<std::mutex> lock(pool->mutex);
+      last = --pool->pending == 0;
+    }
+    if (last) {
+      pool->done.notify_one();
+    }
+  }
+}
+
+static int DefaultThreads(void) {
+  const int hardware = (int)std::thread::hardware_concurrency();
+  return hardware > 1 ? hardware - 1 : 1;
+}
+
+static SimCpuPool *StartPool(void) {
+  if (g_pool != NULL) {
+    return g_pool;
+  }
+
+  int threads = g_requestedThreads > 0 ? g_requestedThreads : DefaultThreads();
+  if (threads > SIM_CPU_MAX_THREADS) {
+    threads = SIM_CPU_MAX_THREADS;
+  }
+
+  g_pool = new SimCpuPool();
+  g_pool->threads = threads;
+  for (int i = 1; i < threads; i++) {
+    g_pool->workers[i - 1] = std::thread(WorkerMain, g_pool, i);
+  }
+  TraceLog(LOG_INFO, "SIM_CPU: Started %d threads", threads);
+  return g_pool;
+}
+
+bool SimCpuBackend(void) {
+  return g_forced || rlGetVersion() != RL_OPENGL_43;
+}
+
+void SimCpuForce(bool force) { g_forced = force; }
+
+void SimCpuParallelFor(int count, int grain, SimCpuRangeFn fn, void *ctx) {
+  if (count <= 0) {
+    return;
+  }
+  if (grain < 1) {
+    grain = 1;
+  }
+
+  SimCpuPool *pool = StartPool();
+  if (pool->threads <= 1 || count <= grain) {
+    fn(ctx, 0, count);
+    return;
+  }
+
+  pool->fn = fn;
+  pool->ctx = ctx;
+  pool->grain = grain;
+  for (int i = 0; i < pool->threads; i++) {
+    const uint32_t b = (uint32_t)((int64_t)count * i / pool->threads);
+    const uint32_t e = (uint32_t)((int64_t)count * (i + 1) / pool->threads);
+    pool->slices[i].range.store(PackRange(b, e), std::memory_order_relaxed);
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(pool->mutex);
+    pool->pending = pool->threads - 1;
+    pool->generation++;
+  }
+  pool->wake.notify_all();
+
+  RunSlices(pool, 0);
+
+  std::unique_lock<std::mutex> lock(pool->mutex);
+  pool->done.wait(lock, [pool] { return pool->pending == 0; });
+}
+
+void SimCpuSetThreads(int threads) {
+  SimCpuShutdown();
+  g_requestedThreads = threads > 0 ? threads : 0;
+}
+
+int SimCpuThreads(void) { return StartPool()->threads; }
+
+void SimCpuShutdown(void) {
+  if (g_pool == NULL) {
+    return;
+  }
+
+  {
+    const std::lock_guard<std::mutex> lock(g_pool->mutex);
+    g_pool->stopping = true;
+  }
+  g_pool->wake.notify_all();
+  for (int i = 0; i < g_pool->threads - 1; i++) {
+    g_pool->workers[i].join();
+  }
+  delete g_pool;
+  g_pool = NULL;
+}
+
+void SimCpuBinByCell(const int *cell, int count, int cellCount, int *cellStart,
+                     int *order) {
+  memset(cellStart, 0, ((size_t)cellCount + 1) * sizeof(int));
+  for (int i = 0; i < count; i++) {
+    cellStart[cell[i] + 1]++;
+  }
+  for (int c = 0; c < cellCount; c++) {
+    cellStart[c + 1] += cellStart[c];
+  }
+
+  // Scatter with cellStart[c] as the insertion cursor, then shift it back
+  for (int i = 0; i < count; i++) {
+    order[cellStart[cell[i]]++] = i;
+  }
+  memmove(cellStart + 1, cellStart, (size_t)cellCount * sizeof(int));
+  cellStart[0] = 0;
+}
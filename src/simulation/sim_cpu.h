@@ -0,0 +1,51 @@
+#ifndef SIM_CPU_H
+#define SIM_CPU_H
+
+#include <stdbool.h>
+
+// CPU simulation backend support. Without compute shaders (GL < 4.3) the
+// simulations keep agents in SoA arrays, step them on this worker pool and
+// upload a CPU trail map (TrailMapInitCpu) each frame.
+//
+// SimCpuParallelFor gives each thread an equal slice of the range. A thread
+// that drains its slice steals the back half of the largest remaining one,
+// so uneven work (dense neighbor cells) still balances. The calling thread
+// takes part and returns once the whole range is done.
+
+#define SIM_CPU_MAX_THREADS 32
+#define SIM_CPU_LANES 8 // Kernel inner loops run in blocks this wide
+
+// Process items [begin, end). ctx is passed through unchanged.
+typedef void (*SimCpuRangeFn)(void *ctx, int begin, int end);
+
+// True when simulations should take the CPU path: compute shaders are
+// missing or SimCpuForce(true) was called.
+bool SimCpuBackend(void);
+
+// Use the CPU path even with compute shaders (--cpu-sims, benchmarks).
+// Affects simulations initialized afterwards.
+void SimCpuForce(bool force);
+
+// Run fn over [0, count) in chunks of grain items. Runs inline when the pool
+// has one thread or the range fits one chunk. Not reentrant.
+void SimCpuParallelFor(int count, int grain, SimCpuRangeFn fn, void *ctx);
+
+// Set the thread count including the caller; 0 restores the default of one
+// per hardware thread, minus one left for audio and the driver.
+void SimCpuSetThreads(int threads);
+
+// Threads SimCpuParallelFor uses, including the caller
+int SimCpuThreads(void);
+
+// Stop and join the workers. The next SimCpuParallelFor restarts them.
+void SimCpuShutdown(void);
+
+// Counting sort for neighbor searches, the CPU side of the compute paths'
+// spatial hash. cell[i] is agent i's cell in [0, cellCount). Fills
+// cellStart[0..cellCount] so cell c's agents take slots [cellStart[c],
+// cellStart[c + 1]), and order[k] with the agent in slot k. Serial: a
+// histogram and a scatter, small next to the neighbor passes.
+void SimCpuBinByCell(const int *cell, int count, int cellCount, int *cellStart,
+                     int *order);
+
+#endif // SIM_CPU_H
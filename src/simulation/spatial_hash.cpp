@@ -4,10 +4,13 @@
 #include "rlgl.h"
 #include "shader_utils.h"
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 static const char *SHADER_PATH = "shaders/spatial_hash_build.glsl";
+// Cells per scan workgroup; matches SCAN_BLOCK in the shader
+static const int SCAN_BLOCK_SIZE = 1024;
 
 static void CalculateGridDimensions(SpatialHash *sh) {
   sh->gridWidth = (int)ceilf((float)sh->width / sh->cellSize);
@@ -18,6 +21,7 @@ static void CalculateGridDimensions(SpatialHash *sh) {
   if (sh->gridHeight < 1) {
     sh->gridHeight = 1;
   }
+  sh->gridDepth = 1;
 }
 
 static GLuint CompileKernel(const char *source, const char *define) {
@@ -67,12 +71,22 @@ static bool LoadShaderPrograms(SpatialHash *sh) {
   } kernels[] = {
       {&sh->clearProgram, "#define KERNEL_CLEAR", "clear"},
       {&sh->countProgram, "#define KERNEL_COUNT", "count"},
-      {&sh->prefixSumProgram, "#define KERNEL_PREFIX_SUM", "prefix sum"},
+      {&sh->scanBlocksProgram, "#define KERNEL_SCAN_BLOCKS", "scan blocks"},
+      {&sh->scanBlockSumsProgram, "#define KERNEL_SCAN_BLOCK_SUMS",
+       "scan block sums"},
+      {&sh->addBlockOffsetsProgram, "#define KERNEL_ADD_BLOCK_OFFSETS",
+       "add block offsets"},
       {&sh->scatterProgram, "#define KERNEL_SCATTER", "scatter"},
+      {&sh->restoreProgram, "#define KERNEL_RESTORE", "restore"},
+      {&sh->reorderProgram, "#define KERNEL_REORDER", "reorder"},
+      {&sh->thinProgram, "#define KERNEL_THIN", "thin"},
   };
 
-  for (int i = 0; i < 4; i++) {
-    *kernels[i].program = CompileKernel(shaderSource, kernels[i].define);
+  for (int i = 0; i < (int)(sizeof(kernels) / sizeof(kernels[0])); i++) {
+    char define[64];
+    (void)snprintf(define, sizeof(define), "%s%s",
+                   sh->is3D ? "#define GRID_3D\n" : "", kernels[i].define);
+    *kernels[i].program = CompileKernel(shaderSource, define);
     if (*kernels[i].program == 0) {
       TraceLog(LOG_ERROR, "SPATIAL_HASH: Failed to compile %s kernel",
                kernels[i].name);
@@ -90,21 +104,28 @@ static bool LoadShaderPrograms(SpatialHash *sh) {
   sh->countResolutionLoc = rlGetLocationUniform(sh->countProgram, "resolution");
   sh->countCellSizeLoc = rlGetLocationUniform(sh->countProgram, "cellSize");
   sh->countGridSizeLoc = rlGetLocationUniform(sh->countProgram, "gridSize");
+  sh->countGridOriginLoc = rlGetLocationUniform(sh->countProgram, "gridOrigin");
   sh->countAgentCountLoc = rlGetLocationUniform(sh->countProgram, "agentCount");
   sh->countAgentStrideLoc =
       rlGetLocationUniform(sh->countProgram, "agentStride");
   sh->countPositionOffsetLoc =
       rlGetLocationUniform(sh->countProgram, "positionOffset");
 
-  // Cache uniform locations - prefix sum program
-  sh->prefixSumTotalCellsLoc =
-      rlGetLocationUniform(sh->prefixSumProgram, "totalCells");
+  // Cache uniform locations - prefix sum programs
+  sh->scanBlocksTotalCellsLoc =
+      rlGetLocationUniform(sh->scanBlocksProgram, "totalCells");
+  sh->scanBlockSumsCountLoc =
+      rlGetLocationUniform(sh->scanBlockSumsProgram, "blockCount");
+  sh->addBlockOffsetsTotalCellsLoc =
+      rlGetLocationUniform(sh->addBlockOffsetsProgram, "totalCells");
 
   // Cache uniform locations - scatter program
   sh->scatterResolutionLoc =
       rlGetLocationUniform(sh->scatterProgram, "resolution");
   sh->scatterCellSizeLoc = rlGetLocationUniform(sh->scatterProgram, "cellSize");
   sh->scatterGridSizeLoc = rlGetLocationUniform(sh->scatterProgram, "gridSize");
+  sh->scatterGridOriginLoc =
+      rlGetLocationUniform(sh->scatterProgram, "gridOrigin");
   sh->scatterAgentCountLoc =
       rlGetLocationUniform(sh->scatterProgram, "agentCount");
   sh->scatterAgentStrideLoc =
@@ -112,11 +133,28 @@ static bool LoadShaderPrograms(SpatialHash *sh) {
   sh->scatterPositionOffsetLoc =
       rlGetLocationUniform(sh->scatterProgram, "positionOffset");
 
+  // Cache uniform locations - restore program
+  sh->restoreTotalCellsLoc =
+      rlGetLocationUniform(sh->restoreProgram, "totalCells");
+
+  // Cache uniform locations - reorder program
+  sh->reorderAgentCountLoc =
+      rlGetLocationUniform(sh->reorderProgram, "agentCount");
+  sh->reorderAgentWordsLoc =
+      rlGetLocationUniform(sh->reorderProgram, "agentWords");
+
+  // Cache uniform locations - thin program
+  sh->thinAgentCountLoc = rlGetLocationUniform(sh->thinProgram, "agentCount");
+  sh->thinAgentWordsLoc = rlGetLocationUniform(sh->thinProgram, "agentWords");
+  sh->thinSourceCountLoc =
+      rlGetLocationUniform(sh->thinProgram, "sourceCount");
+  sh->thinSourceStepLoc = rlGetLocationUniform(sh->thinProgram, "sourceStep");
+
   return true;
 }
 
 static bool AllocateBuffers(SpatialHash *sh) {
-  const int totalCells = sh->gridWidth * sh->gridHeight;
+  const int totalCells = sh->maxCells;
 
   sh->cellCountsBuffer = rlLoadShaderBuffer(totalCells * sizeof(unsigned int),
                                             NULL, RL_DYNAMIC_COPY);
@@ -139,6 +177,14 @@ static bool AllocateBuffers(SpatialHash *sh) {
     return false;
   }
 
+  const int maxBlocks = (totalCells + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE;
+  sh->blockSumsBuffer = rlLoadShaderBuffer(maxBlocks * sizeof(unsigned int),
+                                           NULL, RL_DYNAMIC_COPY);
+  if (sh->blockSumsBuffer == 0) {
+    TraceLog(LOG_ERROR, "SPATIAL_HASH: Failed to create block sums buffer");
+    return false;
+  }
+
   return true;
 }
 
@@ -155,6 +201,10 @@ static void FreeBuffers(SpatialHash *sh) {
     rlUnloadShaderBuffer(sh->sortedIndicesBuffer);
     sh->sortedIndicesBuffer = 0;
   }
+  if (sh->blockSumsBuffer != 0) {
+    rlUnloadShaderBuffer(sh->blockSumsBuffer);
+    sh->blockSumsBuffer = 0;
+  }
 }
 
 SpatialHash *SpatialHashInit(int maxAgents, float cellSize, int width,
@@ -170,6 +220,7 @@ SpatialHash *SpatialHashInit(int maxAgents, float cellSize, int width,
   sh->height = height;
 
   CalculateGridDimensions(sh);
+  sh->maxCells = sh->gridWidth * sh->gridHeight;
 
   if (!LoadShaderPrograms(sh)) {
     goto cleanup;
@@ -190,6 +241,88 @@ cleanup:
   return NULL;
 }
 
+SpatialHash *SpatialHashInit3D(int maxAgents, int maxCells) {
+  SpatialHash *sh = static_cast<SpatialHash *>(calloc(1, sizeof(SpatialHash)));
+  if (sh == NULL) {
+    return NULL;
+  }
+
+  sh->is3D = true;
+  sh->maxAgents = maxAgents;
+  sh->maxCells = maxCells > 1 ? maxCells : 1;
+  SpatialHashSetBounds3D(sh, 1.0f, 1.0f);
+
+  if (!LoadShaderPrograms(sh)) {
+    goto cleanup;
+  }
+
+  if (!AllocateBuffers(sh)) {
+    goto cleanup;
+  }
+
+  TraceLog(LOG_INFO,
+           "SPATIAL_HASH: Initialized 3D grid (%d cells) for %d agents",
+           sh->maxCells, sh->maxAgents);
+  return sh;
+
+cleanup:
+  SpatialHashUninit(sh);
+  return NULL;
+}
+
+void SpatialHashSetBounds3D(SpatialHash *sh, float cellSize,
+                            float halfExtent) {
+  if (sh == NULL || !sh->is3D || cellSize <= 0.0f || halfExtent <= 0.0f) {
+    return;
+  }
+
+  // Largest cube that fits the cell buffers
+  int maxDim = 1;
+  while ((maxDim + 1) * (maxDim + 1) * (maxDim + 1) <= sh->maxCells) {
+    maxDim++;
+  }
+
+  const float extent = 2.0f * halfExtent;
+  int dim = (int)ceilf(extent / cellSize);
+  if (dim > maxDim) {
+    dim = maxDim;
+    cellSize = extent / (float)dim;
+  }
+  if (dim < 1) {
+    dim = 1;
+  }
+
+  sh->cellSize = cellSize;
+  sh->halfExtent = halfExtent;
+  sh->gridWidth = dim;
+  sh->gridHeight = dim;
+  sh->gridDepth = dim;
+}
+
+bool SpatialHashReserve(SpatialHash *sh, int maxAgents) {
+  if (sh == NULL) {
+    return false;
+  }
+  if (maxAgents <= sh->maxAgents) {
+    return true;
+  }
+
+  // Every build rewrites the sorted indices, so nothing needs copying
+  const unsigned int indices = rlLoadShaderBuffer(
+      maxAgents * sizeof(unsigned int), NULL, RL_DYNAMIC_COPY);
+  if (indices == 0) {
+    TraceLog(LOG_ERROR,
+             "SPATIAL_HASH: Failed to grow sorted indices buffer to %d agents",
+             maxAgents);
+    return false;
+  }
+
+  rlUnloadShaderBuffer(sh->sortedIndicesBuffer);
+  sh->sortedIndicesBuffer = indices;
+  sh->maxAgents = maxAgents;
+  return true;
+}
+
 void SpatialHashUninit(SpatialHash *sh) {
   if (sh == NULL) {
     return;
@@ -203,29 +336,85 @@ void SpatialHashUninit(SpatialHash *sh) {
   if (sh->countProgram != 0) {
     rlUnloadShaderProgram(sh->countProgram);
   }
-  if (sh->prefixSumProgram != 0) {
-    rlUnloadShaderProgram(sh->prefixSumProgram);
+  if (sh->scanBlocksProgram != 0) {
+    rlUnloadShaderProgram(sh->scanBlocksProgram);
+  }
+  if (sh->scanBlockSumsProgram != 0) {
+    rlUnloadShaderProgram(sh->scanBlockSumsProgram);
+  }
+  if (sh->addBlockOffsetsProgram != 0) {
+    rlUnloadShaderProgram(sh->addBlockOffsetsProgram);
   }
   if (sh->scatterProgram != 0) {
     rlUnloadShaderProgram(sh->scatterProgram);
   }
+  if (sh->restoreProgram != 0) {
+    rlUnloadShaderProgram(sh->restoreProgram);
+  }
+  if (sh->reorderProgram != 0) {
+    rlUnloadShaderProgram(sh->reorderProgram);
+  }
+  if (sh->thinProgram != 0) {
+    rlUnloadShaderProgram(sh->thinProgram);
+  }
 
   free(sh);
 }
 
+// Three-phase scan: each workgroup scans a block of cells, one workgroup
+// scans the block totals, then every block after the first adds the total of
+// the blocks before it. Unlike a single-pass scan with decoupled lookback it
+// needs no forward-progress guarantee between workgroups, which GL lacks.
+static void ScanCellCounts(const SpatialHash *sh, int totalCells) {
+  const int blockCount = (totalCells + SCAN_BLOCK_SIZE - 1) / SCAN_BLOCK_SIZE;
+
+  rlEnableShader(sh->scanBlocksProgram);
+  rlSetUniform(sh->scanBlocksTotalCellsLoc, &totalCells, RL_SHADER_UNIFORM_INT,
+               1);
+  rlBindShaderBuffer(sh->cellCountsBuffer, 0);
+  rlBindShaderBuffer(sh->cellOffsetsBuffer, 1);
+  rlBindShaderBuffer(sh->blockSumsBuffer, 2);
+  rlComputeShaderDispatch((unsigned int)blockCount, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  if (blockCount <= 1) {
+    return;
+  }
+
+  rlEnableShader(sh->scanBlockSumsProgram);
+  rlSetUniform(sh->scanBlockSumsCountLoc, &blockCount, RL_SHADER_UNIFORM_INT,
+               1);
+  rlBindShaderBuffer(sh->blockSumsBuffer, 0);
+  rlComputeShaderDispatch(1, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  rlEnableShader(sh->addBlockOffsetsProgram);
+  rlSetUniform(sh->addBlockOffsetsTotalCellsLoc, &totalCells,
+               RL_SHADER_UNIFORM_INT, 1);
+  rlBindShaderBuffer(sh->cellOffsetsBuffer, 1);
+  rlBindShaderBuffer(sh->blockSumsBuffer, 2);
+  rlComputeShaderDispatch((unsigned int)(blockCount - 1), 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
 void SpatialHashBuild(SpatialHash *sh, unsigned int positionBuffer,
                       int agentCount, int agentStride, int positionOffset) {
   if (sh == NULL || positionBuffer == 0 || agentCount <= 0) {
     return;
   }
 
-  const int totalCells = sh->gridWidth * sh->gridHeight;
+  const int totalCells = sh->gridWidth * sh->gridHeight * sh->gridDepth;
   const int workGroupSize = 1024;
   const int agentGroups = (agentCount + workGroupSize - 1) / workGroupSize;
   const int clearGroups = (totalCells + workGroupSize - 1) / workGroupSize;
 
+  // 2D grids ignore the origin; 3D grids ignore the resolution
   const float resolution[2] = {(float)sh->width, (float)sh->height};
-  const int gridSize[2] = {sh->gridWidth, sh->gridHeight};
+  const int gridSize[3] = {sh->gridWidth, sh->gridHeight, sh->gridDepth};
+  const int gridSizeType =
+      sh->is3D ? RL_SHADER_UNIFORM_IVEC3 : RL_SHADER_UNIFORM_IVEC2;
+  const float gridOrigin[3] = {-sh->halfExtent, -sh->halfExtent,
+                               -sh->halfExtent};
 
   // Pass 1: Clear cell counts
   rlEnableShader(sh->clearProgram);
@@ -238,7 +427,8 @@ void SpatialHashBuild(SpatialHash *sh, unsigned int positionBuffer,
   rlEnableShader(sh->countProgram);
   rlSetUniform(sh->countResolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
   rlSetUniform(sh->countCellSizeLoc, &sh->cellSize, RL_SHADER_UNIFORM_FLOAT, 1);
-  rlSetUniform(sh->countGridSizeLoc, gridSize, RL_SHADER_UNIFORM_IVEC2, 1);
+  rlSetUniform(sh->countGridSizeLoc, gridSize, gridSizeType, 1);
+  rlSetUniform(sh->countGridOriginLoc, gridOrigin, RL_SHADER_UNIFORM_VEC3, 1);
   rlSetUniform(sh->countAgentCountLoc, &agentCount, RL_SHADER_UNIFORM_INT, 1);
   rlSetUniform(sh->countAgentStrideLoc, &agentStride, RL_SHADER_UNIFORM_INT, 1);
   rlSetUniform(sh->countPositionOffsetLoc, &positionOffset,
@@ -248,21 +438,17 @@ void SpatialHashBuild(SpatialHash *sh, unsigned int positionBuffer,
   rlComputeShaderDispatch((unsigned int)agentGroups, 1, 1);
   glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-  // Pass 3: Serial prefix sum (single thread)
-  rlEnableShader(sh->prefixSumProgram);
-  rlSetUniform(sh->prefixSumTotalCellsLoc, &totalCells, RL_SHADER_UNIFORM_INT,
-               1);
-  rlBindShaderBuffer(sh->cellCountsBuffer, 0);
-  rlBindShaderBuffer(sh->cellOffsetsBuffer, 1);
-  rlComputeShaderDispatch(1, 1, 1);
-  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+  // Pass 3: Inclusive prefix sum of counts into offsets
+  ScanCellCounts(sh, totalCells);
 
   // Pass 4: Scatter agents to sorted indices
   rlEnableShader(sh->scatterProgram);
   rlSetUniform(sh->scatterResolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
   rlSetUniform(sh->scatterCellSizeLoc, &sh->cellSize, RL_SHADER_UNIFORM_FLOAT,
                1);
-  rlSetUniform(sh->scatterGridSizeLoc, gridSize, RL_SHADER_UNIFORM_IVEC2, 1);
+  rlSetUniform(sh->scatterGridSizeLoc, gridSize, gridSizeType, 1);
+  rlSetUniform(sh->scatterGridOriginLoc, gridOrigin, RL_SHADER_UNIFORM_VEC3,
+               1);
   rlSetUniform(sh->scatterAgentCountLoc, &agentCount, RL_SHADER_UNIFORM_INT, 1);
   rlSetUniform(sh->scatterAgentStrideLoc, &agentStride, RL_SHADER_UNIFORM_INT,
                1);
@@ -274,14 +460,64 @@ void SpatialHashBuild(SpatialHash *sh, unsigned int positionBuffer,
   rlComputeShaderDispatch((unsigned int)agentGroups, 1, 1);
   glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-  // Pass 5: Re-run prefix sum to restore offsets (scatter corrupts them via
-  // atomic decrement)
-  rlEnableShader(sh->prefixSumProgram);
-  rlSetUniform(sh->prefixSumTotalCellsLoc, &totalCells, RL_SHADER_UNIFORM_INT,
-               1);
+  // Pass 5: Restore offsets (scatter decrements them to each cell's start)
+  rlEnableShader(sh->restoreProgram);
+  rlSetUniform(sh->restoreTotalCellsLoc, &totalCells, RL_SHADER_UNIFORM_INT, 1);
   rlBindShaderBuffer(sh->cellCountsBuffer, 0);
   rlBindShaderBuffer(sh->cellOffsetsBuffer, 1);
-  rlComputeShaderDispatch(1, 1, 1);
+  rlComputeShaderDispatch((unsigned int)clearGroups, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  rlDisableShader();
+}
+
+void SpatialHashReorder(SpatialHash *sh, unsigned int srcBuffer,
+                        unsigned int dstBuffer, int agentCount,
+                        int agentStride) {
+  if (sh == NULL || srcBuffer == 0 || dstBuffer == 0 || agentCount <= 0) {
+    return;
+  }
+
+  const int agentWords = agentStride / 4;
+  const int workGroupSize = 1024;
+  const int agentGroups = (agentCount + workGroupSize - 1) / workGroupSize;
+
+  rlEnableShader(sh->reorderProgram);
+  rlSetUniform(sh->reorderAgentCountLoc, &agentCount, RL_SHADER_UNIFORM_INT,
+               1);
+  rlSetUniform(sh->reorderAgentWordsLoc, &agentWords, RL_SHADER_UNIFORM_INT,
+               1);
+  rlBindShaderBuffer(srcBuffer, 0);
+  rlBindShaderBuffer(dstBuffer, 1);
+  rlBindShaderBuffer(sh->sortedIndicesBuffer, 2);
+  rlComputeShaderDispatch((unsigned int)agentGroups, 1, 1);
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  rlDisableShader();
+}
+
+void SpatialHashThin(SpatialHash *sh, unsigned int srcBuffer,
+                     unsigned int dstBuffer, int agentCount, int count,
+                     int agentStride) {
+  if (sh == NULL || srcBuffer == 0 || dstBuffer == 0 || count <= 0 ||
+      count > agentCount) {
+    return;
+  }
+
+  const int agentWords = agentStride / 4;
+  const float sourceStep = (float)agentCount / (float)count;
+  const int workGroupSize = 1024;
+  const int agentGroups = (count + workGroupSize - 1) / workGroupSize;
+
+  rlEnableShader(sh->thinProgram);
+  rlSetUniform(sh->thinAgentCountLoc, &count, RL_SHADER_UNIFORM_INT, 1);
+  rlSetUniform(sh->thinAgentWordsLoc, &agentWords, RL_SHADER_UNIFORM_INT, 1);
+  rlSetUniform(sh->thinSourceCountLoc, &agentCount, RL_SHADER_UNIFORM_INT, 1);
+  rlSetUniform(sh->thinSourceStepLoc, &sourceStep, RL_SHADER_UNIFORM_FLOAT, 1);
+  rlBindShaderBuffer(srcBuffer, 0);
+  rlBindShaderBuffer(dstBuffer, 1);
+  rlBindShaderBuffer(sh->sortedIndicesBuffer, 2);
+  rlComputeShaderDispatch((unsigned int)agentGroups, 1, 1);
   glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
   rlDisableShader();
@@ -303,6 +539,26 @@ void SpatialHashGetGrid(const SpatialHash *sh, int *outWidth, int *outHeight,
   }
 }
 
+void SpatialHashGetGrid3D(const SpatialHash *sh, int outSize[3],
+                          float outOrigin[3], float *outCellSize) {
+  if (sh == NULL) {
+    return;
+  }
+  if (outSize != NULL) {
+    outSize[0] = sh->gridWidth;
+    outSize[1] = sh->gridHeight;
+    outSize[2] = sh->gridDepth;
+  }
+  if (outOrigin != NULL) {
+    outOrigin[0] = -sh->halfExtent;
+    outOrigin[1] = -sh->halfExtent;
+    outOrigin[2] = -sh->halfExtent;
+  }
+  if (outCellSize != NULL) {
+    *outCellSize = sh->cellSize;
+  }
+}
+
 unsigned int SpatialHashGetOffsetsBuffer(const SpatialHash *sh) {
   if (sh == NULL) {
     return 0;
@@ -1,16 +1,29 @@
 #ifndef SPATIAL_HASH_H
 #define SPATIAL_HASH_H
 
+#include <stdbool.h>
+
+// Frames between SpatialHashReorder passes in simulations that keep their
+// agents in cell order. Agents rarely leave their cell in this many frames,
+// so the order stays mostly coherent between sorts.
+#define SPATIAL_HASH_SORT_INTERVAL 8
+
 typedef struct SpatialHash {
   unsigned int cellCountsBuffer; // Boids per cell (reset each frame)
   unsigned int
       cellOffsetsBuffer; // Prefix sum result (also used as insertion counters)
   unsigned int sortedIndicesBuffer; // Agent indices sorted by cell
+  unsigned int blockSumsBuffer;     // Per-block totals for the prefix sum
 
-  unsigned int clearProgram;     // Clear counts kernel
-  unsigned int countProgram;     // Count agents per cell kernel
-  unsigned int prefixSumProgram; // Serial prefix sum kernel
-  unsigned int scatterProgram;   // Scatter agents to sorted indices kernel
+  unsigned int clearProgram;           // Clear counts kernel
+  unsigned int countProgram;           // Count agents per cell kernel
+  unsigned int scanBlocksProgram;      // Prefix sum within blocks kernel
+  unsigned int scanBlockSumsProgram;   // Prefix sum of block totals kernel
+  unsigned int addBlockOffsetsProgram; // Add block prefixes kernel
+  unsigned int scatterProgram;         // Scatter to sorted indices kernel
+  unsigned int restoreProgram;         // Restore offsets after scatter
+  unsigned int reorderProgram;         // Gather agents into sorted order
+  unsigned int thinProgram;            // Gather a strided subset in sorted order
 
   // Uniform locations - clear program
   int clearTotalCellsLoc;
@@ -19,33 +32,68 @@ typedef struct SpatialHash {
   int countResolutionLoc;
   int countCellSizeLoc;
   int countGridSizeLoc;
+  int countGridOriginLoc;
   int countAgentCountLoc;
   int countAgentStrideLoc;
   int countPositionOffsetLoc;
 
-  // Uniform locations - prefix sum program
-  int prefixSumTotalCellsLoc;
+  // Uniform locations - prefix sum programs
+  int scanBlocksTotalCellsLoc;
+  int scanBlockSumsCountLoc;
+  int addBlockOffsetsTotalCellsLoc;
 
   // Uniform locations - scatter program
   int scatterResolutionLoc;
   int scatterCellSizeLoc;
   int scatterGridSizeLoc;
+  int scatterGridOriginLoc;
   int scatterAgentCountLoc;
   int scatterAgentStrideLoc;
   int scatterPositionOffsetLoc;
 
+  // Uniform locations - restore program
+  int restoreTotalCellsLoc;
+
+  // Uniform locations - reorder program
+  int reorderAgentCountLoc;
+  int reorderAgentWordsLoc;
+
+  // Uniform locations - thin program
+  int thinAgentCountLoc;
+  int thinAgentWordsLoc;
+  int thinSourceCountLoc;
+  int thinSourceStepLoc;
+
   float cellSize;
   int gridWidth;
   int gridHeight;
+  int gridDepth; // 1 for 2D grids
   int maxAgents;
+  int maxCells; // Cell buffer capacity
   int width;
   int height;
+  bool is3D;
+  float halfExtent; // 3D grids span [-halfExtent, halfExtent] on each axis
 } SpatialHash;
 
 // Initialize spatial hash with given parameters. Returns NULL on failure.
 SpatialHash *SpatialHashInit(int maxAgents, float cellSize, int width,
                              int height);
 
+// Initialize a 3D spatial hash over vec3 positions with room for maxCells
+// cells. Positions outside the bounds clamp into the border cells. Call
+// SpatialHashSetBounds3D before the first build. Returns NULL on failure.
+SpatialHash *SpatialHashInit3D(int maxAgents, int maxCells);
+
+// Fit a cubic grid of cellSize cells over [-halfExtent, halfExtent] per axis.
+// Cells grow past cellSize when the grid would exceed maxCells, so searching
+// the 27 cells around a position still covers a radius of cellSize.
+void SpatialHashSetBounds3D(SpatialHash *sh, float cellSize, float halfExtent);
+
+// Make room for maxAgents agents without rebuilding the grid or kernels.
+// Only grows; returns false and keeps the old capacity on failure.
+bool SpatialHashReserve(SpatialHash *sh, int maxAgents);
+
 // Release all spatial hash resources.
 void SpatialHashUninit(SpatialHash *sh);
 
@@ -53,14 +101,36 @@ void SpatialHashUninit(SpatialHash *sh);
 // positionBuffer: SSBO containing agent data
 // agentCount: number of agents to process
 // agentStride: bytes between agents in buffer
-// positionOffset: byte offset to position (vec2) within agent struct
+// positionOffset: byte offset to position (vec2, vec3 for 3D) within agent
 void SpatialHashBuild(SpatialHash *sh, unsigned int positionBuffer,
                       int agentCount, int agentStride, int positionOffset);
 
+// Gather agents into the cell order of the last build:
+// dstBuffer[i] = srcBuffer[sortedIndices[i]] for structs agentStride bytes
+// apart (a multiple of 4). The sorted indices become the identity, so the
+// cell offsets stay valid for dstBuffer and neighbor loops read each cell
+// from contiguous memory. agentCount must match the last build.
+void SpatialHashReorder(SpatialHash *sh, unsigned int srcBuffer,
+                        unsigned int dstBuffer, int agentCount,
+                        int agentStride);
+
+// Gather count of the agentCount agents of the last build into dstBuffer,
+// taking every (agentCount / count)-th agent in cell order. Shrinking a
+// population through this keeps every cell's share of the agents instead of
+// dropping whichever region sits at the tail of the buffer. count must not
+// exceed agentCount, which must match the last build.
+void SpatialHashThin(SpatialHash *sh, unsigned int srcBuffer,
+                     unsigned int dstBuffer, int agentCount, int count,
+                     int agentStride);
+
 // Get grid dimensions and cell size.
 void SpatialHashGetGrid(const SpatialHash *sh, int *outWidth, int *outHeight,
                         float *outCellSize);
 
+// Get 3D grid dimensions (cells per axis), minimum corner, and cell size.
+void SpatialHashGetGrid3D(const SpatialHash *sh, int outSize[3],
+                          float outOrigin[3], float *outCellSize);
+
 // Get the cell offsets buffer (for binding in steering shader).
 unsigned int SpatialHashGetOffsetsBuffer(const SpatialHash *sh);
 
@@ -2,10 +2,47 @@
 #include "external/glad.h"
 #include "rlgl.h"
 #include "shader_utils.h"
+#include "sim_cpu.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 static const char *TRAIL_SHADER_PATH = "shaders/trail_diffusion.glsl";
+static const char *RESOLVE_SHADER_PATH = "shaders/trail_deposit_resolve.glsl";
+// CPU diffusion: the Gaussian radius is capped so the weights fit the stack
+static const int CPU_MAX_RADIUS = 32;
+static const int CPU_ROW_GRAIN = 8; // Rows per worker chunk
+
+// One separable pass over RGBA float rows
+struct CpuBlurJob {
+  const float *src;
+  float *dst;
+  int width;
+  int height;
+  int radius;
+  const float *weights; // 2 * radius + 1 taps, normalized
+};
+
+// Diffusion resources shared by every GPU trail map. The programs live as
+// long as any GPU map does. The scratch array holds one horizontal-pass
+// layer per map in a batch; it only grows, when a flush needs more layers or
+// a larger map than it holds, and is freed with the last GPU map.
+struct TrailMapPool {
+  int maps; // Initialized GPU trail maps
+  GLuint program;
+  int resolutionLoc;
+  int diffusionScaleLoc;
+  int decayFactorLoc;
+  int directionLoc;
+  GLuint resolveProgram; // Deposit accumulator resolve; 0 if it failed
+
+  GLuint scratch; // RGBA32F 2D array texture
+  int scratchWidth;
+  int scratchHeight;
+  int scratchLayers;
+};
+
+static TrailMapPool g_pool = {};
 
 static bool CreateRenderTexture(RenderTexture2D *rt, int width, int height) {
   rt->id = rlLoadFramebuffer();
@@ -20,6 +57,7 @@ static bool CreateRenderTexture(RenderTexture2D *rt, int width, int height) {
   rt->texture.height = height;
   rt->texture.mipmaps = 1;
   rt->texture.format = RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32;
+  SetTextureFilter(rt->texture, TEXTURE_FILTER_BILINEAR);
   rlFramebufferAttach(rt->id, rt->texture.id, RL_ATTACHMENT_COLOR_CHANNEL0,
                       RL_ATTACHMENT_TEXTURE2D, 0);
 
@@ -47,8 +85,8 @@ static void ClearRenderTexture(const RenderTexture2D *rt) {
   EndTextureMode();
 }
 
-static GLuint LoadTrailProgram(TrailMap *tm) {
-  char *shaderSource = SimLoadShaderSource(TRAIL_SHADER_PATH);
+static GLuint LoadComputeProgram(const char *path) {
+  char *shaderSource = SimLoadShaderSource(path);
   if (shaderSource == NULL) {
     return 0;
   }
@@ -58,25 +96,212 @@ static GLuint LoadTrailProgram(TrailMap *tm) {
   UnloadFileText(shaderSource);
 
   if (shaderId == 0) {
-    TraceLog(LOG_ERROR, "TRAILMAP: Failed to compile trail shader");
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to compile %s", path);
     return 0;
   }
 
   const GLuint program = rlLoadComputeShaderProgram(shaderId);
   if (program == 0) {
-    TraceLog(LOG_ERROR, "TRAILMAP: Failed to load trail shader program");
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to load %s program", path);
+  }
+  return program;
+}
+
+static GLuint LoadTrailProgram(void) {
+  const GLuint program = LoadComputeProgram(TRAIL_SHADER_PATH);
+  if (program == 0) {
     return 0;
   }
 
-  tm->resolutionLoc = rlGetLocationUniform(program, "resolution");
-  tm->diffusionScaleLoc = rlGetLocationUniform(program, "diffusionScale");
-  tm->decayFactorLoc = rlGetLocationUniform(program, "decayFactor");
-  tm->applyDecayLoc = rlGetLocationUniform(program, "applyDecay");
-  tm->directionLoc = rlGetLocationUniform(program, "direction");
+  g_pool.resolutionLoc = rlGetLocationUniform(program, "resolution");
+  g_pool.diffusionScaleLoc = rlGetLocationUniform(program, "diffusionScale");
+  g_pool.decayFactorLoc = rlGetLocationUniform(program, "decayFactor");
+  g_pool.directionLoc = rlGetLocationUniform(program, "direction");
 
   return program;
 }
 
+static bool PoolRetain(void) {
+  if (g_pool.maps == 0) {
+    g_pool.program = LoadTrailProgram();
+    if (g_pool.program == 0) {
+      return false;
+    }
+    // Only downsampled agent passes need it; full-res grids run without
+    g_pool.resolveProgram = LoadComputeProgram(RESOLVE_SHADER_PATH);
+  }
+  g_pool.maps++;
+  return true;
+}
+
+static void PoolDropScratch(void) {
+  if (g_pool.scratch != 0) {
+    glDeleteTextures(1, &g_pool.scratch);
+  }
+  g_pool.scratch = 0;
+  g_pool.scratchWidth = 0;
+  g_pool.scratchHeight = 0;
+  g_pool.scratchLayers = 0;
+}
+
+static void PoolRelease(void) {
+  g_pool.maps--;
+  if (g_pool.maps == 0) {
+    rlUnloadShaderProgram(g_pool.program);
+    g_pool.program = 0;
+    if (g_pool.resolveProgram != 0) {
+      rlUnloadShaderProgram(g_pool.resolveProgram);
+    }
+    g_pool.resolveProgram = 0;
+    PoolDropScratch();
+  }
+}
+
+// Grow the scratch array to at least width x height x layers
+static bool PoolReserveScratch(int width, int height, int layers) {
+  if (width <= g_pool.scratchWidth && height <= g_pool.scratchHeight &&
+      layers <= g_pool.scratchLayers) {
+    return true;
+  }
+
+  width = width > g_pool.scratchWidth ? width : g_pool.scratchWidth;
+  height = height > g_pool.scratchHeight ? height : g_pool.scratchHeight;
+  layers = layers > g_pool.scratchLayers ? layers : g_pool.scratchLayers;
+  PoolDropScratch();
+
+  // Drain stale errors so the check below sees only the storage call
+  while (glGetError() != GL_NO_ERROR) {
+  }
+
+  GLuint texture = 0;
+  glGenTextures(1, &texture);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+  glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_RGBA32F, width, height, layers);
+  const GLenum error = glGetError();
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+  if (texture == 0 || error != GL_NO_ERROR) {
+    TraceLog(LOG_ERROR,
+             "TRAILMAP: Failed to create %dx%d x%d diffusion scratch (0x%x)",
+             width, height, layers, error);
+    if (texture != 0) {
+      glDeleteTextures(1, &texture);
+    }
+    return false;
+  }
+
+  g_pool.scratch = texture;
+  g_pool.scratchWidth = width;
+  g_pool.scratchHeight = height;
+  g_pool.scratchLayers = layers;
+  TraceLog(LOG_INFO, "TRAILMAP: Diffusion scratch at %dx%d x%d", width,
+           height, layers);
+  return true;
+}
+
+static void FreeDeposits(TrailMap *tm) {
+  if (tm->depositBuffer != 0) {
+    rlUnloadShaderBuffer(tm->depositBuffer);
+  }
+  tm->depositBuffer = 0;
+}
+
+static size_t CpuPixelBytes(int width, int height) {
+  return (size_t)width * height * 4 * sizeof(float);
+}
+
+// Horizontal pass. Pixel x reads x + i, wrapping like the compute shader;
+// each tap is split at the wrap so both loops run over contiguous floats.
+static void BlurRows(void *ctx, int begin, int end) {
+  const CpuBlurJob *job = static_cast<const CpuBlurJob *>(ctx);
+  const int stride = job->width * 4;
+  for (int y = begin; y < end; y++) {
+    const float *src = job->src + (size_t)y * stride;
+    float *dst = job->dst + (size_t)y * stride;
+    memset(dst, 0, (size_t)stride * sizeof(float));
+    for (int i = -job->radius; i <= job->radius; i++) {
+      const float w = job->weights[i + job->radius];
+      const int shift = ((i % job->width + job->width) % job->width) * 4;
+      const int head = stride - shift;
+      for (int k = 0; k < head; k++) {
+        dst[k] += w * src[k + shift];
+      }
+      for (int k = head; k < stride; k++) {
+        dst[k] += w * src[k - head];
+      }
+    }
+  }
+}
+
+// Vertical pass: whole source rows are weighted into each output row
+static void BlurColumns(void *ctx, int begin, int end) {
+  const CpuBlurJob *job = static_cast<const CpuBlurJob *>(ctx);
+  const int stride = job->width * 4;
+  for (int y = begin; y < end; y++) {
+    float *dst = job->dst + (size_t)y * stride;
+    memset(dst, 0, (size_t)stride * sizeof(float));
+    for (int i = -job->radius; i <= job->radius; i++) {
+      const float w = job->weights[i + job->radius];
+      const int row = ((y + i) % job->height + job->height) % job->height;
+      const float *src = job->src + (size_t)row * stride;
+      for (int k = 0; k < stride; k++) {
+        dst[k] += w * src[k];
+      }
+    }
+  }
+}
+
+// Decay only (no diffusion), in place
+static void ScaleRows(void *ctx, int begin, int end) {
+  const CpuBlurJob *job = static_cast<const CpuBlurJob *>(ctx);
+  const float w = job->weights[0];
+  const size_t stride = (size_t)job->width * 4;
+  float *dst = job->dst + (size_t)begin * stride;
+  const size_t count = (size_t)(end - begin) * stride;
+  for (size_t k = 0; k < count; k++) {
+    dst[k] *= w;
+  }
+}
+
+static void ProcessCpu(const TrailMap *tm, float decayFactor,
+                       int diffusionScale) {
+  CpuBlurJob job = {tm->pixels, tm->pixels, tm->width, tm->height, 0, NULL};
+
+  if (diffusionScale <= 0) {
+    job.weights = &decayFactor;
+    SimCpuParallelFor(tm->height, CPU_ROW_GRAIN, ScaleRows, &job);
+  } else {
+    // Same kernel as the shader: sigma = diffusionScale, radius = 3 sigma
+    const float sigma = (float)diffusionScale;
+    const int radius = (int)fminf(ceilf(3.0f * sigma), (float)CPU_MAX_RADIUS);
+    float weights[2 * CPU_MAX_RADIUS + 1];
+    float wsum = 0.0f;
+    for (int i = -radius; i <= radius; i++) {
+      weights[i + radius] = expf(-(float)(i * i) / (2.0f * sigma * sigma));
+      wsum += weights[i + radius];
+    }
+    for (int i = 0; i <= 2 * radius; i++) {
+      weights[i] /= wsum;
+    }
+    job.radius = radius;
+    job.weights = weights;
+
+    // Horizontal pass: pixels -> scratch
+    job.dst = tm->scratch;
+    SimCpuParallelFor(tm->height, CPU_ROW_GRAIN, BlurRows, &job);
+
+    // Vertical pass with decay: scratch -> pixels
+    for (int i = 0; i <= 2 * radius; i++) {
+      weights[i] *= decayFactor;
+    }
+    job.src = tm->scratch;
+    job.dst = tm->pixels;
+    SimCpuParallelFor(tm->height, CPU_ROW_GRAIN, BlurColumns, &job);
+  }
+
+  UpdateTexture(tm->primary.texture, tm->pixels);
+}
+
 TrailMap *TrailMapInit(int width, int height) {
   TrailMap *tm = static_cast<TrailMap *>(calloc(1, sizeof(TrailMap)));
   if (tm == NULL) {
@@ -85,27 +310,47 @@ TrailMap *TrailMapInit(int width, int height) {
 
   tm->width = width;
   tm->height = height;
+  tm->stepAlpha = 1.0f;
 
-  if (!CreateRenderTexture(&tm->primary, width, height)) {
-    TraceLog(LOG_ERROR, "TRAILMAP: Failed to create primary texture");
-    goto cleanup;
+  if (!PoolRetain()) {
+    free(tm);
+    return NULL;
   }
 
-  if (!CreateRenderTexture(&tm->temp, width, height)) {
-    TraceLog(LOG_ERROR, "TRAILMAP: Failed to create temp texture");
+  TraceLog(LOG_INFO, "TRAILMAP: Initialized at %dx%d", width, height);
+  return tm;
+}
+
+TrailMap *TrailMapInitCpu(int width, int height) {
+  TrailMap *tm = static_cast<TrailMap *>(calloc(1, sizeof(TrailMap)));
+  if (tm == NULL) {
+    return NULL;
+  }
+
+  tm->width = width;
+  tm->height = height;
+  tm->stepAlpha = 1.0f;
+
+  if (!CreateRenderTexture(&tm->primary, width, height)) {
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to create primary texture");
     goto cleanup;
   }
 
-  tm->program = LoadTrailProgram(tm);
-  if (tm->program == 0) {
+  tm->pixels = static_cast<float *>(calloc(1, CpuPixelBytes(width, height)));
+  tm->scratch = static_cast<float *>(malloc(CpuPixelBytes(width, height)));
+  if (tm->pixels == NULL || tm->scratch == NULL) {
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to allocate CPU pixels");
     goto cleanup;
   }
 
-  TraceLog(LOG_INFO, "TRAILMAP: Initialized at %dx%d", width, height);
+  TraceLog(LOG_INFO, "TRAILMAP: Initialized CPU map at %dx%d", width, height);
   return tm;
 
 cleanup:
-  TrailMapUninit(tm);
+  UnloadRenderTexture(tm->primary);
+  free(tm->pixels);
+  free(tm->scratch);
+  free(tm);
   return NULL;
 }
 
@@ -114,21 +359,42 @@ void TrailMapUninit(TrailMap *tm) {
     return;
   }
 
-  if (tm->program != 0) {
-    rlUnloadShaderProgram(tm->program);
+  if (tm->pixels == NULL) {
+    FreeDeposits(tm);
+    PoolRelease();
   }
-  UnloadRenderTexture(tm->temp);
   UnloadRenderTexture(tm->primary);
+  UnloadRenderTexture(tm->previous);
+  free(tm->pixels);
+  free(tm->scratch);
   free(tm);
 }
 
+int TrailMapGridSize(int screenSize, int gridDivisor) {
+  const int divisor = gridDivisor >= 4 ? 4 : (gridDivisor >= 2 ? 2 : 1);
+  const int size = screenSize / divisor;
+  return size > 0 ? size : 1;
+}
+
 void TrailMapResize(TrailMap *tm, int width, int height) {
   if (tm == NULL || (width == tm->width && height == tm->height)) {
     return;
   }
 
+  const bool cpu = tm->pixels != NULL;
   RenderTexture2D newPrimary = {0};
-  RenderTexture2D newTemp = {0};
+
+  // The next snapshot and deposit pass reallocate at the new size
+  UnloadRenderTexture(tm->previous);
+  tm->previous = {0};
+  FreeDeposits(tm);
+
+  // Inactive maps allocate at the new size when activated
+  if (!cpu && tm->primary.id == 0) {
+    tm->width = width;
+    tm->height = height;
+    return;
+  }
 
   if (!CreateRenderTexture(&newPrimary, width, height)) {
     TraceLog(LOG_ERROR,
@@ -136,75 +402,152 @@ void TrailMapResize(TrailMap *tm, int width, int height) {
     return;
   }
 
-  if (!CreateRenderTexture(&newTemp, width, height)) {
-    TraceLog(LOG_ERROR,
-             "TRAILMAP: Failed to recreate temp texture after resize");
-    UnloadRenderTexture(newPrimary);
-    return;
+  if (cpu) {
+    float *pixels =
+        static_cast<float *>(calloc(1, CpuPixelBytes(width, height)));
+    float *scratch = static_cast<float *>(malloc(CpuPixelBytes(width, height)));
+    if (pixels == NULL || scratch == NULL) {
+      TraceLog(LOG_ERROR,
+               "TRAILMAP: Failed to reallocate CPU pixels after resize");
+      free(pixels);
+      free(scratch);
+      UnloadRenderTexture(newPrimary);
+      return;
+    }
+    free(tm->pixels);
+    free(tm->scratch);
+    tm->pixels = pixels;
+    tm->scratch = scratch;
   }
 
   UnloadRenderTexture(tm->primary);
-  UnloadRenderTexture(tm->temp);
   tm->primary = newPrimary;
-  tm->temp = newTemp;
   tm->width = width;
   tm->height = height;
 }
 
+void TrailMapSetActive(TrailMap *tm, bool active) {
+  if (tm == NULL || tm->pixels != NULL || active == (tm->primary.id != 0)) {
+    return;
+  }
+
+  if (!active) {
+    UnloadRenderTexture(tm->primary);
+    UnloadRenderTexture(tm->previous);
+    tm->primary = {0};
+    tm->previous = {0};
+    FreeDeposits(tm);
+    TraceLog(LOG_INFO, "TRAILMAP: Released %dx%d map", tm->width, tm->height);
+    return;
+  }
+
+  if (!CreateRenderTexture(&tm->primary, tm->width, tm->height)) {
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to create primary texture");
+    tm->primary = {0};
+  }
+}
+
 void TrailMapClear(TrailMap *tm) {
-  if (tm == NULL) {
+  if (tm == NULL || tm->primary.id == 0) {
     return;
   }
 
   ClearRenderTexture(&tm->primary);
-  ClearRenderTexture(&tm->temp);
+  if (tm->previous.id != 0) {
+    ClearRenderTexture(&tm->previous);
+  }
+  if (tm->pixels != NULL) {
+    memset(tm->pixels, 0, CpuPixelBytes(tm->width, tm->height));
+  }
 }
 
 void TrailMapProcess(const TrailMap *tm, float deltaTime, float decayHalfLife,
                      int diffusionScale) {
-  if (tm == NULL || tm->program == 0) {
+  TrailMapBatch batch = {};
+  TrailMapBatchAdd(&batch, tm, deltaTime, decayHalfLife, diffusionScale);
+  TrailMapBatchFlush(&batch);
+}
+
+void TrailMapBatchAdd(TrailMapBatch *batch, const TrailMap *tm,
+                      float deltaTime, float decayHalfLife,
+                      int diffusionScale) {
+  if (batch == NULL || tm == NULL || tm->primary.id == 0) {
     return;
   }
 
   const float safeHalfLife = fmaxf(decayHalfLife, 0.001f);
-  float decayFactor = expf(-0.693147f * deltaTime / safeHalfLife);
+  const float decayFactor = expf(-0.693147f * deltaTime / safeHalfLife);
+
+  if (tm->pixels != NULL) {
+    ProcessCpu(tm, decayFactor, diffusionScale);
+    return;
+  }
+
+  if (batch->count == TRAIL_MAP_BATCH_MAX) {
+    TrailMapBatchFlush(batch);
+  }
+  batch->maps[batch->count] = tm;
+  batch->decayFactor[batch->count] = decayFactor;
+  batch->diffusionScale[batch->count] = diffusionScale;
+  batch->count++;
+}
 
-  rlEnableShader(tm->program);
+void TrailMapBatchFlush(TrailMapBatch *batch) {
+  if (batch == NULL || batch->count == 0) {
+    return;
+  }
 
-  const float resolution[2] = {(float)tm->width, (float)tm->height};
-  rlSetUniform(tm->resolutionLoc, resolution, RL_SHADER_UNIFORM_VEC2, 1);
-  rlSetUniform(tm->diffusionScaleLoc, &diffusionScale, RL_SHADER_UNIFORM_INT,
-               1);
-  rlSetUniform(tm->decayFactorLoc, &decayFactor, RL_SHADER_UNIFORM_FLOAT, 1);
+  const int count = batch->count;
+  batch->count = 0;
+
+  int resolution[2 * TRAIL_MAP_BATCH_MAX];
+  int maxWidth = 0;
+  int maxHeight = 0;
+  for (int i = 0; i < count; i++) {
+    resolution[2 * i] = batch->maps[i]->width;
+    resolution[2 * i + 1] = batch->maps[i]->height;
+    maxWidth = resolution[2 * i] > maxWidth ? resolution[2 * i] : maxWidth;
+    maxHeight =
+        resolution[2 * i + 1] > maxHeight ? resolution[2 * i + 1] : maxHeight;
+  }
 
-  const int workGroupsX = (tm->width + 15) / 16;
-  const int workGroupsY = (tm->height + 15) / 16;
+  if (g_pool.program == 0 || !PoolReserveScratch(maxWidth, maxHeight, count)) {
+    return;
+  }
 
-  // Horizontal pass: primary -> temp
+  rlEnableShader(g_pool.program);
+
+  rlSetUniform(g_pool.resolutionLoc, resolution, RL_SHADER_UNIFORM_IVEC2,
+               count);
+  rlSetUniform(g_pool.diffusionScaleLoc, batch->diffusionScale,
+               RL_SHADER_UNIFORM_INT, count);
+  rlSetUniform(g_pool.decayFactorLoc, batch->decayFactor,
+               RL_SHADER_UNIFORM_FLOAT, count);
+
+  // Unit 0 is the scratch array, units 1.. the maps; z selects the map
+  glBindImageTexture(0, g_pool.scratch, 0, GL_TRUE, 0, GL_READ_WRITE,
+                     GL_RGBA32F);
+  for (int i = 0; i < count; i++) {
+    rlBindImageTexture(batch->maps[i]->primary.texture.id, 1 + i,
+                       RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  }
+
+  const int workGroupsX = (maxWidth + 15) / 16;
+  const int workGroupsY = (maxHeight + 15) / 16;
+
+  // Horizontal pass: map -> scratch layer
   int direction = 0;
-  int applyDecay = 0;
-  rlSetUniform(tm->directionLoc, &direction, RL_SHADER_UNIFORM_INT, 1);
-  rlSetUniform(tm->applyDecayLoc, &applyDecay, RL_SHADER_UNIFORM_INT, 1);
-  rlBindImageTexture(tm->primary.texture.id, 1,
-                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, true);
-  rlBindImageTexture(tm->temp.texture.id, 2,
-                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  rlSetUniform(g_pool.directionLoc, &direction, RL_SHADER_UNIFORM_INT, 1);
   rlComputeShaderDispatch((unsigned int)workGroupsX, (unsigned int)workGroupsY,
-                          1);
+                          (unsigned int)count);
 
   glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
 
-  // Vertical pass with decay: temp -> primary
+  // Vertical pass with decay: scratch layer -> map
   direction = 1;
-  applyDecay = 1;
-  rlSetUniform(tm->directionLoc, &direction, RL_SHADER_UNIFORM_INT, 1);
-  rlSetUniform(tm->applyDecayLoc, &applyDecay, RL_SHADER_UNIFORM_INT, 1);
-  rlBindImageTexture(tm->temp.texture.id, 1,
-                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, true);
-  rlBindImageTexture(tm->primary.texture.id, 2,
-                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  rlSetUniform(g_pool.directionLoc, &direction, RL_SHADER_UNIFORM_INT, 1);
   rlComputeShaderDispatch((unsigned int)workGroupsX, (unsigned int)workGroupsY,
-                          1);
+                          (unsigned int)count);
 
   glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
                   GL_TEXTURE_FETCH_BARRIER_BIT);
@@ -212,9 +555,165 @@ void TrailMapProcess(const TrailMap *tm, float deltaTime, float decayHalfLife,
   rlDisableShader();
 }
 
+void TrailMapDeposit(TrailMap *tm, int x, int y, float r, float g, float b) {
+  if (tm == NULL || tm->pixels == NULL || x < 0 || x >= tm->width || y < 0 ||
+      y >= tm->height) {
+    return;
+  }
+
+  float *p = tm->pixels + ((size_t)y * tm->width + x) * 4;
+  float nr = p[0] + r;
+  float ng = p[1] + g;
+  float nb = p[2] + b;
+
+  // Proportional scaling to prevent overflow
+  const float maxChan = fmaxf(nr, fmaxf(ng, nb));
+  if (maxChan > 1.0f) {
+    nr /= maxChan;
+    ng /= maxChan;
+    nb /= maxChan;
+  }
+
+  p[0] = nr;
+  p[1] = ng;
+  p[2] = nb;
+  p[3] = 0.0f;
+}
+
+void TrailMapDepositScreen(TrailMap *tm, float x, float y, float screenWidth,
+                           float screenHeight, float r, float g, float b) {
+  if (tm == NULL) {
+    return;
+  }
+  if (tm->width == (int)screenWidth && tm->height == (int)screenHeight) {
+    TrailMapDeposit(tm, (int)x, (int)y, r, g, b);
+    return;
+  }
+
+  const float scaleX = (float)tm->width / screenWidth;
+  const float scaleY = (float)tm->height / screenHeight;
+  const float gx = (x - screenWidth * floorf(x / screenWidth)) * scaleX - 0.5f;
+  const float gy =
+      (y - screenHeight * floorf(y / screenHeight)) * scaleY - 0.5f;
+  const int baseX = (int)floorf(gx);
+  const int baseY = (int)floorf(gy);
+  const float fx = gx - (float)baseX;
+  const float fy = gy - (float)baseY;
+  const float area = scaleX * scaleY;
+  for (int c = 0; c < 4; c++) {
+    const int ox = c & 1;
+    const int oy = c >> 1;
+    const float w = (ox ? fx : 1.0f - fx) * (oy ? fy : 1.0f - fy) * area;
+    const int cx = (baseX + ox + tm->width) % tm->width;
+    const int cy = (baseY + oy + tm->height) % tm->height;
+    TrailMapDeposit(tm, cx, cy, r * w, g * w, b * w);
+  }
+}
+
+bool TrailMapBindDeposits(TrailMap *tm) {
+  if (tm == NULL || tm->pixels != NULL || tm->primary.id == 0 ||
+      g_pool.resolveProgram == 0) {
+    return false;
+  }
+
+  if (tm->depositBuffer == 0) {
+    // rlLoadShaderBuffer zeroes the storage when given no data
+    const unsigned int size =
+        (unsigned int)((size_t)tm->width * tm->height * 3 * sizeof(GLuint));
+    tm->depositBuffer = rlLoadShaderBuffer(size, NULL, RL_DYNAMIC_COPY);
+    if (tm->depositBuffer == 0) {
+      TraceLog(LOG_ERROR, "TRAILMAP: Failed to create %dx%d deposit buffer",
+               tm->width, tm->height);
+      return false;
+    }
+  }
+
+  rlBindShaderBuffer(tm->depositBuffer, TRAIL_MAP_DEPOSIT_BINDING);
+  return true;
+}
+
+void TrailMapResolveDeposits(TrailMap *tm) {
+  if (tm == NULL || tm->depositBuffer == 0 || tm->primary.id == 0 ||
+      g_pool.resolveProgram == 0) {
+    return;
+  }
+
+  // The agent pass's atomic adds must land before they are read
+  glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+  rlEnableShader(g_pool.resolveProgram);
+  rlBindImageTexture(tm->primary.texture.id, 1,
+                     RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32A32, false);
+  rlBindShaderBuffer(tm->depositBuffer, TRAIL_MAP_DEPOSIT_BINDING);
+  rlComputeShaderDispatch((unsigned int)((tm->width + 15) / 16),
+                          (unsigned int)((tm->height + 15) / 16), 1);
+
+  glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT |
+                  GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+
+  rlDisableShader();
+}
+
+void TrailMapAdd(TrailMap *tm, int x, int y, float r, float g, float b,
+                 float a) {
+  if (tm == NULL || tm->pixels == NULL || x < 0 || x >= tm->width || y < 0 ||
+      y >= tm->height) {
+    return;
+  }
+
+  float *p = tm->pixels + ((size_t)y * tm->width + x) * 4;
+  p[0] += r;
+  p[1] += g;
+  p[2] += b;
+  p[3] += a;
+}
+
 Texture2D TrailMapGetTexture(const TrailMap *tm) {
   if (tm == NULL) {
     return Texture2D{};
   }
   return tm->primary.texture;
 }
+
+void TrailMapSnapshot(TrailMap *tm) {
+  if (tm == NULL || tm->primary.id == 0) {
+    return;
+  }
+
+  if (tm->previous.id == 0 &&
+      !CreateRenderTexture(&tm->previous, tm->width, tm->height)) {
+    TraceLog(LOG_ERROR, "TRAILMAP: Failed to create previous texture");
+    tm->previous = {0};
+    return;
+  }
+
+  // Agent and diffusion passes write GPU maps as images
+  if (tm->pixels == NULL) {
+    glMemoryBarrier(GL_FRAMEBUFFER_BARRIER_BIT);
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, tm->primary.id);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, tm->previous.id);
+  glBlitFramebuffer(0, 0, tm->width, tm->height, 0, 0, tm->width, tm->height,
+                    GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void TrailMapSetStepAlpha(TrailMap *tm, float alpha) {
+  if (tm == NULL) {
+    return;
+  }
+
+  tm->stepAlpha = fminf(fmaxf(alpha, 0.0f), 1.0f);
+  if (tm->stepAlpha >= 1.0f && tm->previous.id != 0) {
+    UnloadRenderTexture(tm->previous);
+    tm->previous = {0};
+  }
+}
+
+Texture2D TrailMapGetPreviousTexture(const TrailMap *tm) {
+  if (tm == NULL) {
+    return Texture2D{};
+  }
+  return tm->previous.id != 0 ? tm->previous.texture : tm->primary.texture;
+}
@@ -4,39 +4,126 @@
 #include "raylib.h"
 #include <stdbool.h>
 
+// Most trail maps a batch diffuses in one dispatch: one per simulation. The
+// shader binds each map to its own image unit next to the shared scratch.
+#define TRAIL_MAP_BATCH_MAX 6
+
+// Agent shader SSBO binding of the deposit accumulator (TrailMapBindDeposits)
+#define TRAIL_MAP_DEPOSIT_BINDING 6
+
+// GPU trail maps only hold a texture while active (TrailMapSetActive); the
+// diffusion program and ping-pong scratch are shared by all of them.
 typedef struct TrailMap {
   RenderTexture2D primary; // Main trail texture (agents write here)
-  RenderTexture2D temp;    // Ping-pong buffer for diffusion
-  unsigned int program;    // Trail compute shader program
+  // Fixed-step simulations: the state before the last step, crossfaded into
+  // primary by stepAlpha when composited. Allocated by TrailMapSnapshot.
+  RenderTexture2D previous;
+  float stepAlpha;
+
+  // CPU trail maps: RGBA floats, row 0 first, uploaded to primary by
+  // TrailMapProcess. Always allocated.
+  float *pixels;
+  float *scratch; // Horizontal diffusion output
 
-  // Uniform locations
-  int resolutionLoc;
-  int diffusionScaleLoc;
-  int decayFactorLoc;
-  int applyDecayLoc;
-  int directionLoc;
+  // GPU maps on a downsampled grid: fixed-point RGB sums per texel that agent
+  // shaders add to atomically. Allocated by TrailMapBindDeposits.
+  unsigned int depositBuffer;
 
   int width;
   int height;
 } TrailMap;
 
-// Initialize trail map with given dimensions. Returns NULL on failure.
+// Trail maps queued for one combined diffusion and decay dispatch
+typedef struct TrailMapBatch {
+  const TrailMap *maps[TRAIL_MAP_BATCH_MAX];
+  float decayFactor[TRAIL_MAP_BATCH_MAX];
+  int diffusionScale[TRAIL_MAP_BATCH_MAX];
+  int count;
+} TrailMapBatch;
+
+// Initialize trail map with given dimensions. The texture is allocated on
+// the first TrailMapSetActive. Returns NULL on failure.
 TrailMap *TrailMapInit(int width, int height);
 
+// Initialize a trail map written and diffused on the CPU, for simulations
+// running without compute shaders. Returns NULL on failure.
+TrailMap *TrailMapInitCpu(int width, int height);
+
 // Release all trail map resources.
 void TrailMapUninit(TrailMap *tm);
 
+// Trail map size along one axis of a screenSize-pixel output at 1/gridDivisor
+// scale. gridDivisor is rounded down to 1, 2 or 4.
+int TrailMapGridSize(int screenSize, int gridDivisor);
+
 // Recreate textures at new dimensions.
 void TrailMapResize(TrailMap *tm, int width, int height);
 
+// Allocate the texture of a GPU trail map when active and free it when not,
+// so disabled simulations hold no trail storage. Reactivated maps start
+// black. No-op for CPU trail maps.
+void TrailMapSetActive(TrailMap *tm, bool active);
+
 // Clear trail textures to black.
 void TrailMapClear(TrailMap *tm);
 
-// Run diffusion and decay compute pass.
+// Run diffusion and decay compute pass. CPU trail maps diffuse on the
+// simulation worker pool and upload the result.
 void TrailMapProcess(const TrailMap *tm, float deltaTime, float decayHalfLife,
                      int diffusionScale);
 
-// Get the primary trail texture for sampling.
+// Queue a TrailMapProcess for the next TrailMapBatchFlush. A full batch is
+// flushed first. CPU trail maps are processed immediately and inactive maps
+// are skipped.
+void TrailMapBatchAdd(TrailMapBatch *batch, const TrailMap *tm,
+                      float deltaTime, float decayHalfLife,
+                      int diffusionScale);
+
+// Diffuse and decay every queued map in two dispatches, then empty the batch
+void TrailMapBatchFlush(TrailMapBatch *batch);
+
+// Add color to a CPU trail map pixel, scaled down proportionally when a
+// channel would pass 1 (the agent shaders' deposit rule).
+void TrailMapDeposit(TrailMap *tm, int x, int y, float r, float g, float b);
+
+// Deposit at a position on a screenWidth x screenHeight screen the CPU trail
+// map covers. A downsampled grid splits the deposit bilinearly over the 4
+// nearest texels, scaled by the texel area, as the agent shaders do. Deposits
+// land serially, so none are lost, but each is overflow-scaled on its own
+// rather than summed per step first as on the GPU.
+void TrailMapDepositScreen(TrailMap *tm, float x, float y, float screenWidth,
+                           float screenHeight, float r, float g, float b);
+
+// Bind the deposit accumulator at TRAIL_MAP_DEPOSIT_BINDING for an agent pass
+// on a downsampled grid, allocating it zeroed on first use. Bilinear splats
+// make agents share texels, so the shaders add into it with atomics instead
+// of a read-modify-write of the texture, which drops colliding deposits.
+// Returns false when the accumulator or its resolve program is unavailable.
+bool TrailMapBindDeposits(TrailMap *tm);
+
+// Add the accumulated deposits into primary, with TrailMapDeposit's
+// proportional scaling applied to each texel's sum, and zero them. Call after
+// the agent pass that TrailMapBindDeposits bound.
+void TrailMapResolveDeposits(TrailMap *tm);
+
+// Add color and alpha to a CPU trail map pixel unscaled, the way Maze Worms
+// deposits (alpha marks its walls).
+void TrailMapAdd(TrailMap *tm, int x, int y, float r, float g, float b,
+                 float a);
+
+// Get the primary trail texture for sampling (id 0 while inactive). It is
+// bilinearly filtered, so downsampled maps upsample smoothly.
 Texture2D TrailMapGetTexture(const TrailMap *tm);
 
+// Copy the trail state to the previous texture, allocating it on first use.
+// Call before a fixed-step simulation's last step of the frame.
+void TrailMapSnapshot(TrailMap *tm);
+
+// Set how far the composite is from the previous state to primary. 1 shows
+// primary alone and frees the previous texture.
+void TrailMapSetStepAlpha(TrailMap *tm, float alpha);
+
+// Get the texture to crossfade from: previous once snapshotted, else primary
+Texture2D TrailMapGetPreviousTexture(const TrailMap *tm);
+
 #endif // TRAIL_MAP_H
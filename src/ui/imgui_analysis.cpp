@@ -2,13 +2,23 @@
 #include "analysis/bands.h"
 #include "analysis/beat.h"
 #include "config/band_config.h"
+#include "config/effect_descriptor.h"
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "raylib.h"
+#include "render/alloc_tracker.h"
+#include "render/cpu_profiler.h"
+#include "render/flight_recorder.h"
 #include "render/profiler.h"
+#include "render/quality_lod.h"
+#include "render/render_scale.h"
 #include "ui/imgui_panels.h"
 #include "ui/theme.h"
+#include <float.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 static const float GRAPH_HEIGHT = 80.0f;
 static const float METER_BAR_HEIGHT = 22.0f;
@@ -385,6 +395,229 @@ static void DrawProfilerSparklines(const Profiler *profiler) {
   }
 }
 
+// Scopes not sampled for this many frames drop out of the cost table
+static const unsigned int SCOPE_TABLE_MAX_AGE = 30;
+
+enum ScopeTableColumn { SCOPE_COL_PASS = 0, SCOPE_COL_AVG, SCOPE_COL_LAST };
+
+// qsort has no context argument; set before each sort
+static const Profiler *g_scopeSortProfiler = NULL;
+static int g_scopeSortColumn = SCOPE_COL_AVG;
+static bool g_scopeSortAscending = false;
+
+static int CompareScopes(const void *a, const void *b) {
+  const ProfileScope *sa =
+      &g_scopeSortProfiler->scopes[*static_cast<const int *>(a)];
+  const ProfileScope *sb =
+      &g_scopeSortProfiler->scopes[*static_cast<const int *>(b)];
+  int result;
+  if (g_scopeSortColumn == SCOPE_COL_PASS) {
+    result = strcmp(sa->name, sb->name);
+  } else {
+    const float va =
+        g_scopeSortColumn == SCOPE_COL_LAST ? sa->lastMs : sa->smoothedMs;
+    const float vb =
+        g_scopeSortColumn == SCOPE_COL_LAST ? sb->lastMs : sb->smoothedMs;
+    result = (va > vb) - (va < vb);
+  }
+  return g_scopeSortAscending ? result : -result;
+}
+
+static void DrawScopeRow(const ProfileScope *scope) {
+  ImGui::TableNextRow();
+  ImGui::TableNextColumn();
+  if (scope->detail != NULL) {
+    ImGui::Text("%s", scope->name);
+    ImGui::SameLine();
+    ImGui::TextColored(Theme::TEXT_SECONDARY, "(%s)", scope->detail);
+  } else {
+    ImGui::Text("%s", scope->name);
+  }
+  ImGui::TableNextColumn();
+  ImGui::Text("%.3f", scope->smoothedMs);
+  ImGui::TableNextColumn();
+  ImGui::Text("%.3f", scope->lastMs);
+  ImGui::TableNextColumn();
+  ImGui::PushID(scope);
+  ImGui::PlotLines("##history", scope->history, PROFILER_HISTORY_SIZE,
+                   scope->historyIndex, NULL, 0.0f, FLT_MAX,
+                   ImVec2(-1.0f, ImGui::GetTextLineHeight()));
+  ImGui::PopID();
+}
+
+// Sortable per-pass GPU cost table from timestamp scopes
+static void DrawProfilerScopeTable(const Profiler *profiler) {
+  if (profiler == NULL || !profiler->enabled) {
+    return;
+  }
+
+  ImGui::SeparatorText("Pass Timing");
+
+  int rows[PROFILER_MAX_SCOPES];
+  int rowCount = 0;
+  for (int i = 0; i < PROFILER_MAX_SCOPES; i++) {
+    if (ProfilerScopeActive(profiler, i, SCOPE_TABLE_MAX_AGE)) {
+      rows[rowCount++] = i;
+    }
+  }
+  if (rowCount == 0) {
+    ImGui::TextColored(Theme::TEXT_SECONDARY, "No passes recorded");
+    return;
+  }
+
+  const ImGuiTableFlags flags = ImGuiTableFlags_Sortable |
+                                ImGuiTableFlags_RowBg |
+                                ImGuiTableFlags_BordersInnerV |
+                                ImGuiTableFlags_SizingStretchProp;
+  if (!ImGui::BeginTable("##passTiming", 4, flags)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Pass", ImGuiTableColumnFlags_None, 2.0f);
+  ImGui::TableSetupColumn("Avg ms",
+                          ImGuiTableColumnFlags_DefaultSort |
+                              ImGuiTableColumnFlags_PreferSortDescending,
+                          0.8f);
+  ImGui::TableSetupColumn("Last ms", ImGuiTableColumnFlags_PreferSortDescending,
+                          0.8f);
+  ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_NoSort, 1.5f);
+  ImGui::TableHeadersRow();
+
+  const ImGuiTableSortSpecs *specs = ImGui::TableGetSortSpecs();
+  if (specs != NULL && specs->SpecsCount > 0) {
+    g_scopeSortColumn = specs->Specs[0].ColumnIndex;
+    g_scopeSortAscending =
+        specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending;
+  }
+  g_scopeSortProfiler = profiler;
+  qsort(rows, rowCount, sizeof(int), CompareScopes);
+
+  for (int i = 0; i < rowCount; i++) {
+    DrawScopeRow(&profiler->scopes[rows[i]]);
+  }
+  ImGui::EndTable();
+}
+
+// Dumps the CPU zone rings and GPU timestamps as a Chrome/Perfetto trace
+static void DrawTraceExportButton(void) {
+  if (!ImGui::Button("Export Trace")) {
+    return;
+  }
+  char path[64];
+  const time_t now = time(NULL);
+  // NOLINTNEXTLINE(concurrency-mt-unsafe) - UI thread only
+  const struct tm *local = localtime(&now);
+  if (local == NULL ||
+      strftime(path, sizeof(path), "trace_%Y%m%d_%H%M%S.json", local) == 0) {
+    return;
+  }
+  CpuProfilerExportTrace(path);
+}
+
+static void DrawHitchTable(void) {
+  const ImGuiTableFlags flags = ImGuiTableFlags_RowBg |
+                                ImGuiTableFlags_BordersInnerV |
+                                ImGuiTableFlags_SizingStretchProp;
+  if (!ImGui::BeginTable("##hitches", 5, flags)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_None, 0.7f);
+  ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_None, 0.6f);
+  ImGui::TableSetupColumn("Median", ImGuiTableColumnFlags_None, 0.6f);
+  ImGui::TableSetupColumn("Cause", ImGuiTableColumnFlags_None, 2.0f);
+  ImGui::TableSetupColumn("File", ImGuiTableColumnFlags_None, 1.6f);
+  ImGui::TableHeadersRow();
+
+  // Newest first
+  for (int i = FlightRecorderHitchCount() - 1; i >= 0; i--) {
+    const FlightHitch *h = FlightRecorderGetHitch(i);
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1fs", h->timeS);
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1f", h->frameMs);
+    if (h->spikeCount > 0) {
+      ImGui::SameLine();
+      ImGui::TextColored(Theme::TEXT_SECONDARY, "+%d", h->spikeCount);
+    }
+    ImGui::TableNextColumn();
+    ImGui::Text("%.1f", h->medianMs);
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(h->cause[0] != '\0' ? h->cause : "-");
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(h->path[0] != '\0' ? h->path : "capturing");
+  }
+  ImGui::EndTable();
+}
+
+#if ALLOC_TRACKER_ENABLED
+static void DrawAllocSiteTable(const AllocFrameStats *total) {
+  const ImGuiTableFlags flags = ImGuiTableFlags_RowBg |
+                                ImGuiTableFlags_BordersInnerV |
+                                ImGuiTableFlags_SizingStretchProp;
+  if (!ImGui::BeginTable("##allocSites", 3, flags)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_None, 2.0f);
+  ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_None, 0.7f);
+  ImGui::TableSetupColumn("Bytes", ImGuiTableColumnFlags_None, 0.8f);
+  ImGui::TableHeadersRow();
+  for (int i = 0; i < total->siteCount; i++) {
+    const AllocSite *site = &total->sites[i];
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(site->zone);
+    ImGui::TableNextColumn();
+    ImGui::Text("%u", site->count);
+    ImGui::TableNextColumn();
+    ImGui::Text("%llu", (unsigned long long)site->bytes);
+  }
+  ImGui::EndTable();
+}
+#endif
+
+// Heap allocations on the frame thread, by innermost CPU zone
+static void DrawAllocTrackerSection(void) {
+  ImGui::SeparatorText("Allocations");
+#if ALLOC_TRACKER_ENABLED
+  const AllocTrackerStats *stats = AllocTrackerGetStats();
+  ImGui::TextColored(stats->lastFrame.count > 0 ? Theme::ACCENT_MAGENTA
+                                                : Theme::TEXT_SECONDARY,
+                     "Last frame %u (%llu B)", stats->lastFrame.count,
+                     (unsigned long long)stats->lastFrame.bytes);
+  ImGui::TextColored(Theme::TEXT_SECONDARY, "%llu / %llu frames allocated",
+                     (unsigned long long)stats->dirtyFrames,
+                     (unsigned long long)stats->frames);
+  ImGui::SameLine();
+  if (ImGui::SmallButton("Reset##allocTracker")) {
+    AllocTrackerReset();
+  }
+  if (stats->total.siteCount > 0) {
+    DrawAllocSiteTable(&stats->total);
+  }
+#else
+  ImGui::TextDisabled("Build with AUDIOJONES_ALLOC_TRACKER=ON to count");
+#endif
+}
+
+// Hitch detector settings and the list of captured frame-time spikes
+static void DrawFlightRecorderSection(void) {
+  FlightRecorderConfig *cfg = FlightRecorderGetConfig();
+
+  ImGui::SeparatorText("Flight Recorder");
+  ImGui::Checkbox("Capture Hitches##flightRecorder", &cfg->enabled);
+  if (cfg->enabled) {
+    ImGui::SliderFloat("Threshold##flightRecorder", &cfg->thresholdRatio,
+                       1.5f, 8.0f, "%.1fx median");
+    ImGui::SliderFloat("Min ms##flightRecorder", &cfg->minHitchMs, 5.0f,
+                       100.0f, "%.0f ms");
+  }
+  ImGui::TextColored(Theme::TEXT_SECONDARY, "Median %.2f ms",
+                     FlightRecorderMedianMs());
+  if (FlightRecorderHitchCount() > 0) {
+    DrawHitchTable();
+  }
+}
+
 // Animated band energy meter with gradient bars
 // NOLINTNEXTLINE(readability-function-size) - immediate-mode UI requires
 // sequential widget calls
@@ -588,9 +821,77 @@ static void DrawAudioFeaturesSection(const BandEnergies *bands,
   ImGui::Dummy(ImVec2(availWidth, totalHeight));
 }
 
+// Internal render resolution controls: fixed scale or frame-time target
+static void DrawRenderScaleSection(RenderScale *rs) {
+  if (rs == NULL) {
+    return;
+  }
+
+  ImGui::SeparatorText("Render Scale");
+  ImGui::Checkbox("Adaptive##renderScale", &rs->adaptive);
+  if (rs->adaptive) {
+    ImGui::SliderFloat("Target ms##renderScale", &rs->targetMs, 4.0f, 33.3f,
+                       "%.1f ms");
+    ImGui::SliderFloat("Min##renderScale", &rs->minScale, RENDER_SCALE_MIN,
+                       RENDER_SCALE_MAX, "%.2f");
+    ImGui::SliderFloat("Max##renderScale", &rs->maxScale, RENDER_SCALE_MIN,
+                       RENDER_SCALE_MAX, "%.2f");
+  } else {
+    ImGui::SliderFloat("Scale##renderScale", &rs->fixedScale, RENDER_SCALE_MIN,
+                       RENDER_SCALE_MAX, "%.2f");
+  }
+  ImGui::TextColored(Theme::TEXT_SECONDARY, "Current %.0f%%",
+                     rs->scale * 100.0f);
+}
+
+// Per-effect priority weights and effective LOD for enabled effects that
+// declare quality params
+static void DrawQualityLodEffects(QualityLod *lod, const EffectConfig *effects) {
+  for (int i = 0; i < TRANSFORM_EFFECT_COUNT; i++) {
+    const TransformEffectType type = (TransformEffectType)i;
+    if (EFFECT_DESCRIPTORS[i].qualityCount == 0 ||
+        !IsTransformEnabled(effects, type)) {
+      continue;
+    }
+    ImGui::PushID(i);
+    ImGui::SliderFloat(EFFECT_DESCRIPTORS[i].name, &lod->priority[i],
+                       QUALITY_PRIORITY_MIN, QUALITY_PRIORITY_MAX, "x%.2f");
+    ImGui::SameLine();
+    ImGui::TextColored(Theme::TEXT_SECONDARY, "%.0f%%",
+                       QualityLodEffectLevel(lod, type) * 100.0f);
+    ImGui::PopID();
+  }
+}
+
+// Iteration-count LOD controls: frame-time target, floor, priorities
+static void DrawQualityLodSection(QualityLod *lod,
+                                  const EffectConfig *effects) {
+  if (lod == NULL) {
+    return;
+  }
+
+  ImGui::SeparatorText("Quality LOD");
+  ImGui::Checkbox("Adaptive##qualityLod", &lod->enabled);
+  if (!lod->enabled) {
+    return;
+  }
+  ImGui::SliderFloat("Target ms##qualityLod", &lod->targetMs, 4.0f, 33.3f,
+                     "%.1f ms");
+  ImGui::SliderFloat("Floor##qualityLod", &lod->minLevel, QUALITY_LOD_MIN,
+                     QUALITY_LOD_MAX, "%.2f");
+  ImGui::TextColored(Theme::TEXT_SECONDARY, "Current %.0f%%",
+                     lod->level * 100.0f);
+  if (effects != NULL) {
+    DrawQualityLodEffects(lod, effects);
+  }
+}
+
 void ImGuiDrawAnalysisPanel(const BeatDetector *beat, const BandEnergies *bands,
                             const AudioFeatures *features,
-                            const Profiler *profiler) {
+                            const Profiler *profiler, RenderScale *renderScale,
+                            QualityLod *qualityLod,
+                            const EffectConfig *effects) {
+  CPU_ZONE("ImGuiDrawAnalysisPanel");
   if (!ImGui::Begin("Analysis")) {
     ImGui::End();
     return;
@@ -609,6 +910,13 @@ void ImGuiDrawAnalysisPanel(const BeatDetector *beat, const BandEnergies *bands,
   DrawProfilerFlame(profiler);
 
   DrawProfilerSparklines(profiler);
+  DrawProfilerScopeTable(profiler);
+  DrawTraceExportButton();
+  DrawFlightRecorderSection();
+  DrawAllocTrackerSection();
+
+  DrawRenderScaleSection(renderScale);
+  DrawQualityLodSection(qualityLod, effects);
 
   ImGui::End();
 }
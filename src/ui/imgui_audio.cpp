@@ -1,9 +1,11 @@
 #include "audio/audio_config.h"
 #include "imgui.h"
+#include "render/cpu_profiler.h"
 #include "ui/imgui_panels.h"
 #include "ui/theme.h"
 
 void ImGuiDrawAudioPanel(AudioConfig *cfg) {
+  CPU_ZONE("ImGuiDrawAudioPanel");
   if (!ImGui::Begin("Audio")) {
     ImGui::End();
     return;
@@ -2,6 +2,7 @@
 #include "automation/mod_sources.h"
 #include "config/mod_bus_config.h"
 #include "imgui.h"
+#include "render/cpu_profiler.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
 #include "ui/theme.h"
@@ -304,6 +305,7 @@ static void DrawBusStrip(ModBusConfig *cfg, const ModBusState *state,
 
 void ImGuiDrawBusPanel(ModBusConfig *configs, const ModBusState *states,
                        const ModSources *sources) {
+  CPU_ZONE("ImGuiDrawBusPanel");
   if (!ImGui::Begin("Buses")) {
     ImGui::End();
     return;
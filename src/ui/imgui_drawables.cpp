@@ -1,6 +1,7 @@
 #include "automation/drawable_params.h"
 #include "config/drawable_config.h"
 #include "imgui.h"
+#include "render/cpu_profiler.h"
 #include "render/drawable.h"
 #include "ui/drawable_type_controls.h"
 #include "ui/imgui_panels.h"
@@ -21,6 +22,7 @@ static uint32_t sNextDrawableId = 1;
 // sequential widget calls
 void ImGuiDrawDrawablesPanel(Drawable *drawables, int *count, int *selected,
                              const ModSources *sources) {
+  CPU_ZONE("ImGuiDrawDrawablesPanel");
   if (!ImGui::Begin("Drawables")) {
     ImGui::End();
     return;
@@ -3,6 +3,7 @@
 #include "config/effect_descriptor.h"
 #include "imgui.h"
 #include "render/blend_mode.h"
+#include "render/cpu_profiler.h"
 #include "ui/imgui_effects_dispatch.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
@@ -20,6 +21,7 @@ static int selectedTransformEffect = -1;
 // NOLINTNEXTLINE(readability-function-size) - immediate-mode UI requires
 // sequential widget calls
 void ImGuiDrawEffectsPanel(EffectConfig *e, const ModSources *modSources) {
+  CPU_ZONE("ImGuiDrawEffectsPanel");
   if (!ImGui::Begin("Effects")) {
     ImGui::End();
     return;
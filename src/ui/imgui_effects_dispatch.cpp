@@ -45,6 +45,29 @@ static const CategoryInfo CATEGORY_INFO[] = {
 static const int CATEGORY_INFO_COUNT =
     (int)(sizeof(CATEGORY_INFO) / sizeof(CATEGORY_INFO[0]));
 
+static const char *RESOLUTION_TIER_NAMES[RES_TIER_COUNT] = {
+    "Default", "Full", "3/4", "Half", "Quarter"};
+
+static void DrawResolutionTierCombo(EffectConfig *e, TransformEffectType type) {
+  int tier = (int)e->resolutionTier[type];
+  if (ImGui::Combo("Resolution", &tier, RESOLUTION_TIER_NAMES,
+                   RES_TIER_COUNT)) {
+    e->resolutionTier[type] = (EffectResolutionTier)tier;
+  }
+}
+
+static const char *INTERLEAVE_MODE_NAMES[INTERLEAVE_MODE_COUNT] = {
+    "Off", "Checker", "Quad"};
+
+// Interleave only takes effect at full resolution tier
+static void DrawInterleaveCombo(EffectConfig *e, TransformEffectType type) {
+  int mode = (int)e->interleave[type];
+  if (ImGui::Combo("Interleave", &mode, INTERLEAVE_MODE_NAMES,
+                   INTERLEAVE_MODE_COUNT)) {
+    e->interleave[type] = (EffectInterleaveMode)mode;
+  }
+}
+
 void DrawEffectCategory(EffectConfig *e, const ModSources *modSources,
                         int sectionIndex) {
   if (sectionIndex < 0 || sectionIndex >= CATEGORY_INFO_COUNT) {
@@ -88,6 +111,13 @@ void DrawEffectCategory(EffectConfig *e, const ModSources *modSources,
       if (!wasEnabled && *enabled) {
         MoveTransformToEnd(&e->transformOrder, desc.type);
       }
+      if (*enabled && EffectDescriptorSupportsTiers(desc.type)) {
+        DrawResolutionTierCombo(e, desc.type);
+      }
+      if (*enabled &&
+          (EFFECT_DESCRIPTORS[desc.type].flags & EFFECT_FLAG_INTERLEAVED)) {
+        DrawInterleaveCombo(e, desc.type);
+      }
       if (*enabled && desc.drawParams != nullptr) {
         desc.drawParams(e, modSources, categoryGlow);
       }
@@ -1,6 +1,7 @@
 #include "automation/lfo.h"
 #include "config/lfo_config.h"
 #include "imgui.h"
+#include "render/cpu_profiler.h"
 #include "ui/imgui_panels.h"
 #include "ui/modulatable_slider.h"
 #include "ui/theme.h"
@@ -160,6 +161,7 @@ static void DrawOutputMeter(float currentOutput, bool enabled,
 
 void ImGuiDrawLFOPanel(LFOConfig *configs, const LFOState *states,
                        const ModSources *sources) {
+  CPU_ZONE("ImGuiDrawLFOPanel");
   if (!ImGui::Begin("LFOs")) {
     ImGui::End();
     return;
@@ -13,12 +13,16 @@ struct BeatDetector;
 struct BandEnergies;
 struct AudioFeatures;
 struct Profiler;
+struct RenderScale;
+struct QualityLod;
 struct AppConfigs;
 struct ModSources;
 struct LFOConfig;
 struct LFOState;
 struct ModBusConfig;
 struct ModBusState;
+struct PostEffect;
+struct PresetCost;
 
 // Call once after rlImGuiSetup() - applies Neon Eclipse synthwave theme
 void ImGuiApplyNeonTheme(void);
@@ -63,6 +67,9 @@ void DrawModuleStripEnd(void);
 
 void ImGuiDrawColorMode(ColorConfig *color);
 
+// Simulation trail grid scale (Full, 1/2, 1/4) for a gridDivisor field
+void ImGuiDrawTrailGrid(const char *label, int *gridDivisor);
+
 // Panel draw functions
 void ImGuiDrawEffectsPanel(EffectConfig *e, const ModSources *modSources);
 void ImGuiDrawDrawablesPanel(Drawable *drawables, int *count, int *selected,
@@ -71,10 +78,21 @@ void ImGuiDrawDrawablesSyncIdCounter(const Drawable *drawables, int count);
 void ImGuiDrawAudioPanel(AudioConfig *cfg);
 void ImGuiDrawAnalysisPanel(const BeatDetector *beat, const BandEnergies *bands,
                             const AudioFeatures *features,
-                            const Profiler *profiler);
+                            const Profiler *profiler, RenderScale *renderScale,
+                            QualityLod *qualityLod,
+                            const EffectConfig *effects);
 void ImGuiDrawPresetPanel(AppConfigs *configs);
 const char *ImGuiGetLoadedPresetPath(void);
 void ImGuiLoadPreset(const char *filepath, AppConfigs *configs);
+
+// Cached cost estimate of a preset file at the current render size, or NULL
+// when the file cannot be read. Re-estimated when the file changes on disk
+// (checked on listing) or the render size changes.
+const PresetCost *ImGuiPresetCost(const char *filepath, const PostEffect *pe);
+
+// Text color for a cost against the frame budget, and a breakdown tooltip
+ImU32 ImGuiPresetCostColor(const PresetCost *cost);
+void ImGuiPresetCostTooltip(const PresetCost *cost);
 void ImGuiDrawPlaylistSection(AppConfigs *configs);
 void ImGuiPlaylistAdvance(int direction, AppConfigs *configs);
 void ImGuiDrawLFOPanel(LFOConfig *configs, const LFOState *states,
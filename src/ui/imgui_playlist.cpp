@@ -2,6 +2,8 @@
 #include "config/playlist.h"
 #include "imgui.h"
 #include "raylib.h"
+#include "render/flight_recorder.h"
+#include "render/preset_cost.h"
 #include "ui/imgui_panels.h"
 #include "ui/theme.h"
 #include <filesystem>
@@ -233,6 +235,20 @@ static void DrawSetlist(AppConfigs *configs) {
         isActive ? Theme::ACCENT_CYAN_U32 : Theme::TEXT_PRIMARY_U32;
     draw->AddText(ImVec2(nameX, textY), nameColor, displayName);
 
+    // Cost estimate, right-aligned clear of the remove button
+    const PresetCost *cost =
+        ImGuiPresetCost(playlist.entries[i], configs->postEffect);
+    if (cost != nullptr) {
+      char costBuf[16];
+      (void)snprintf(costBuf, sizeof(costBuf), "%.1f ms", cost->totalMs);
+      const float costW = ImGui::CalcTextSize(costBuf).x;
+      draw->AddText(ImVec2(rowMax.x - 28.0f - costW, textY),
+                    ImGuiPresetCostColor(cost), costBuf);
+      if (rowHovered && !ImGui::IsAnyItemActive()) {
+        ImGuiPresetCostTooltip(cost);
+      }
+    }
+
     // Double-click to load
     if (clicked && ImGui::IsMouseDoubleClicked(0)) {
       if (fs::exists(playlist.entries[i])) {
@@ -402,6 +418,12 @@ void ImGuiPlaylistAdvance(int direction, AppConfigs *configs) {
     return;
   }
 
+  char note[FLIGHT_EVENT_TEXT_MAX];
+  // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size event buffer
+  snprintf(note, sizeof(note), "advance %+d to entry %d", direction,
+           playlist.activeIndex);
+  FlightRecorderNote(FLIGHT_EVENT_PLAYLIST, note);
+
   if (fs::exists(playlist.entries[playlist.activeIndex])) {
     ImGuiLoadPreset(playlist.entries[playlist.activeIndex], configs);
   } else {
@@ -1,14 +1,19 @@
 #include "config/app_configs.h"
+#include "config/effect_descriptor.h"
 #include "config/preset.h"
 #include "imgui.h"
+#include "render/cpu_profiler.h"
+#include "render/flight_recorder.h"
 #include "render/post_effect.h"
+#include "render/preset_cost.h"
 #include "ui/imgui_panels.h"
 #include "ui/theme.h"
 #include <filesystem>
+#include <map>
+#include <memory>
 #include <stdio.h>
 #include <string.h>
 #include <string>
-#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -28,40 +33,80 @@ static bool savingPreset = false;
 static bool focusSaveInput = false;
 static char savePresetBuf[PRESET_NAME_MAX] = "";
 
+// Parsed effects per preset file, kept until the file changes. The estimate
+// is redone from them alone when the render size changes, which adaptive
+// render scale does every few seconds.
+struct PresetCostCacheEntry {
+  fs::file_time_type writeTime;
+  bool parsed;
+  std::unique_ptr<EffectConfig> effects; // NULL when the file could not be read
+  int width; // Render size of cost, 0 before the first estimate
+  int height;
+  PresetCost cost;
+};
+
+static PresetCostModel *costModel = NULL;
+static std::map<std::string, PresetCostCacheEntry, std::less<>> costCache;
+static float budgetMs = 1000.0f / 60.0f;
+
+static void ReloadCostModel(void) {
+  PresetCostModelFree(costModel);
+  costModel = PresetCostModelLoad(PRESET_COST_REPORT);
+  costCache.clear();
+}
+
+// Frame budget at the refresh rate of the window's monitor
+static float FrameBudgetMs(void) {
+  const int hz = GetMonitorRefreshRate(GetCurrentMonitor());
+  return 1000.0f / (float)(hz > 0 ? hz : 60);
+}
+
 static void RefreshPresetList(void) {
   entryCount = PresetListEntries(currentDir, entries, MAX_PRESET_ENTRIES);
-}
 
-// Split a path string by '/' into segments
-static std::vector<std::string> SplitPath(const char *path) {
-  std::vector<std::string> segments;
-  const std::string s(path);
-  size_t start = 0;
-  while (start < s.size()) {
-    const size_t pos = s.find('/', start);
-    if (pos == std::string::npos) {
-      segments.push_back(s.substr(start));
-      break;
+  // Drop estimates of presets changed on disk since they were taken
+  for (int i = 0; i < entryCount; i++) {
+    if (entries[i].isFolder) {
+      continue;
     }
-    if (pos > start) {
-      segments.push_back(s.substr(start, pos - start));
+    char filepath[PRESET_PATH_MAX];
+    (void)snprintf(filepath, PRESET_PATH_MAX, "%s/%s.json", currentDir,
+                   entries[i].name);
+    const auto it = costCache.find(filepath);
+    std::error_code ec;
+    if (it != costCache.end() &&
+        fs::last_write_time(filepath, ec) != it->second.writeTime) {
+      costCache.erase(it);
     }
-    start = pos + 1;
   }
-  return segments;
 }
 
-// Build path from segments [0..endIndex] inclusive
-static std::string BuildPath(const std::vector<std::string> &segments,
-                             int endIndex) {
-  std::string path;
-  for (int i = 0; i <= endIndex; i++) {
-    if (i > 0) {
-      path += "/";
+#define MAX_PATH_SEGMENTS 32
+
+// A '/'-separated piece of currentDir, located in place so the breadcrumb
+// bar does not build strings every frame
+struct PathSegment {
+  int start;
+  int end; // Exclusive; also the length of the path through this segment
+};
+
+// Split a path by '/' into non-empty segments. Returns the segment count.
+static int SplitPath(const char *path, PathSegment *segments, int maxSegments) {
+  int count = 0;
+  int start = 0;
+  for (int i = 0; count < maxSegments; i++) {
+    if (path[i] != '/' && path[i] != '\0') {
+      continue;
     }
-    path += segments[i];
+    if (i > start) {
+      segments[count++] = PathSegment{start, i};
+    }
+    if (path[i] == '\0') {
+      break;
+    }
+    start = i + 1;
   }
-  return path;
+  return count;
 }
 
 // Navigate to a directory path and refresh the entry list
@@ -71,10 +116,102 @@ static void NavigateTo(const char *path) {
   RefreshPresetList();
 }
 
+// Navigate to currentDir up to and including a segment
+static void NavigateToSegment(const PathSegment &segment) {
+  char path[PRESET_PATH_MAX];
+  (void)snprintf(path, PRESET_PATH_MAX, "%.*s", segment.end, currentDir);
+  NavigateTo(path);
+}
+
 const char *ImGuiGetLoadedPresetPath(void) { return loadedPresetPath; }
 
+const PresetCost *ImGuiPresetCost(const char *filepath, const PostEffect *pe) {
+  if (costModel == NULL) {
+    ReloadCostModel();
+  }
+  // Heterogeneous find: a hit does not build a std::string key
+  auto it = costCache.find(filepath);
+  if (it == costCache.end()) {
+    it = costCache.emplace(filepath, PresetCostCacheEntry{}).first;
+  }
+  PresetCostCacheEntry &entry = it->second;
+  if (!entry.parsed) {
+    entry.parsed = true;
+    std::error_code ec;
+    entry.writeTime = fs::last_write_time(filepath, ec);
+    entry.effects = std::make_unique<EffectConfig>();
+    if (!PresetLoadEffects(entry.effects.get(), filepath)) {
+      entry.effects.reset();
+    }
+  }
+  if (entry.effects == NULL) {
+    return NULL;
+  }
+  if (entry.width != pe->screenWidth || entry.height != pe->screenHeight) {
+    entry.width = pe->screenWidth;
+    entry.height = pe->screenHeight;
+    entry.cost = PresetCostEstimate(costModel, entry.effects.get(),
+                                    pe->screenWidth, pe->screenHeight);
+  }
+  return &entry.cost;
+}
+
+ImU32 ImGuiPresetCostColor(const PresetCost *cost) {
+  switch (PresetCostClassify(cost->totalMs, budgetMs)) {
+  case PRESET_COST_OVER:
+    return Theme::ACCENT_MAGENTA_U32;
+  case PRESET_COST_TIGHT:
+    return Theme::ACCENT_ORANGE_U32;
+  default:
+    return Theme::TEXT_DISABLED_U32;
+  }
+}
+
+void ImGuiPresetCostTooltip(const PresetCost *cost) {
+  ImGui::BeginTooltip();
+  ImGui::Text("Est. GPU %.1f ms of %.1f ms budget", cost->totalMs, budgetMs);
+  if (PresetCostClassify(cost->totalMs, budgetMs) == PRESET_COST_OVER) {
+    ImGui::TextColored(Theme::ACCENT_MAGENTA,
+                       "Over budget at the current render size");
+  }
+  ImGui::TextDisabled("Baseline %.1f ms, %d effects", cost->baselineMs,
+                      cost->enabledCount);
+  for (int i = 0; i < PRESET_COST_TOP_EFFECTS; i++) {
+    if (cost->top[i] == TRANSFORM_EFFECT_COUNT) {
+      break;
+    }
+    ImGui::Text("  %s  %.2f ms", EffectDescriptorName(cost->top[i]),
+                cost->topMs[i]);
+  }
+  if (!PresetCostModelCalibrated(costModel)) {
+    ImGui::TextDisabled("Nominal costs - run the shader bench to calibrate");
+  }
+  ImGui::EndTooltip();
+}
+
+// Right-aligned estimate over the last item, with a breakdown on hover
+static void DrawCostTag(const PresetCost *cost) {
+  if (cost == NULL) {
+    return;
+  }
+  char text[16];
+  (void)snprintf(text, sizeof(text), "%.1f ms", cost->totalMs);
+  const ImVec2 rowMin = ImGui::GetItemRectMin();
+  const ImVec2 rowMax = ImGui::GetItemRectMax();
+  const ImVec2 size = ImGui::CalcTextSize(text);
+  ImGui::GetWindowDrawList()->AddText(
+      ImVec2(rowMax.x - size.x - 4.0f,
+             rowMin.y + (rowMax.y - rowMin.y - size.y) * 0.5f),
+      ImGuiPresetCostColor(cost), text);
+  if (ImGui::IsItemHovered()) {
+    ImGuiPresetCostTooltip(cost);
+  }
+}
+
 // Load a preset file and apply it to app configs
 void ImGuiLoadPreset(const char *filepath, AppConfigs *configs) {
+  CPU_ZONE("ImGuiLoadPreset");
+  const double startS = GetTime();
   Preset p;
   if (PresetLoad(&p, filepath)) {
     strncpy(presetName, p.name, PRESET_NAME_MAX);
@@ -84,11 +221,24 @@ void ImGuiLoadPreset(const char *filepath, AppConfigs *configs) {
     strncpy(loadedPresetPath, filepath, PRESET_PATH_MAX);
     loadedPresetPath[PRESET_PATH_MAX - 1] = '\0';
     savingPreset = false;
+
+    // Switch cost feeds the flight recorder's hitch attribution
+    char note[FLIGHT_EVENT_TEXT_MAX];
+    // NOLINTNEXTLINE(cert-err33-c) - snprintf into fixed-size event buffer
+    snprintf(note, sizeof(note), "%s %.1f ms", p.name,
+             (GetTime() - startS) * 1000.0);
+    FlightRecorderNote(FLIGHT_EVENT_PRESET_LOAD, note);
   }
 }
 
 static void DrawBreadcrumbs(void) {
-  std::vector<std::string> segments = SplitPath(currentDir);
+  PathSegment segments[MAX_PATH_SEGMENTS];
+  const int segmentCount = SplitPath(currentDir, segments, MAX_PATH_SEGMENTS);
+  if (segmentCount == 0) {
+    ImGui::Separator();
+    return;
+  }
+  char name[PRESET_PATH_MAX];
 
   // Style: transparent buttons with cyan text
   ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0, 0, 0, 0));
@@ -96,19 +246,20 @@ static void DrawBreadcrumbs(void) {
                         ImVec4(0.0f, 0.9f, 0.95f, 0.15f));
   ImGui::PushStyleColor(ImGuiCol_Text, Theme::ACCENT_CYAN);
 
-  if (segments.size() > 1) {
+  if (segmentCount > 1) {
     if (ImGui::SmallButton("<")) {
-      const std::string newPath = BuildPath(segments, (int)segments.size() - 2);
-      NavigateTo(newPath.c_str());
+      NavigateToSegment(segments[segmentCount - 2]);
     }
     ImGui::SameLine();
   }
 
-  for (int i = 0; i < (int)segments.size() - 1; i++) {
+  for (int i = 0; i < segmentCount - 1; i++) {
     ImGui::PushID(i);
-    if (ImGui::SmallButton(segments[i].c_str())) {
-      const std::string newPath = BuildPath(segments, i);
-      NavigateTo(newPath.c_str());
+    (void)snprintf(name, sizeof(name), "%.*s",
+                   segments[i].end - segments[i].start,
+                   currentDir + segments[i].start);
+    if (ImGui::SmallButton(name)) {
+      NavigateToSegment(segments[i]);
     }
     ImGui::PopID();
     ImGui::SameLine();
@@ -126,16 +277,19 @@ static void DrawBreadcrumbs(void) {
   ImGui::PopStyleColor(3);
 
   // Current segment - white, not clickable
-  ImGui::TextColored(Theme::TEXT_PRIMARY, "%s", segments.back().c_str());
+  const PathSegment &current = segments[segmentCount - 1];
+  ImGui::TextColored(Theme::TEXT_PRIMARY, "%.*s", current.end - current.start,
+                     currentDir + current.start);
 
   ImGui::Separator();
 }
 
 static void DrawPresetList(AppConfigs *configs) {
   const float controlsH = ImGui::GetFrameHeightWithSpacing();
+  const float costH = ImGui::GetTextLineHeightWithSpacing();
   const float playlistH =
       (PLAYLIST_SETLIST_ROWS + 4) * ImGui::GetFrameHeightWithSpacing();
-  const float reserveBelow = controlsH + playlistH;
+  const float reserveBelow = controlsH + costH + playlistH;
 
   if (!ImGui::BeginChild("##presetList", ImVec2(-1, -reserveBelow),
                          ImGuiChildFlags_Borders)) {
@@ -233,6 +387,8 @@ static void DrawPresetList(AppConfigs *configs) {
     if (isLoaded) {
       ImGui::PopStyleColor();
     }
+
+    DrawCostTag(ImGuiPresetCost(filepath, configs->postEffect));
   }
 
   // Empty state
@@ -247,6 +403,21 @@ static void DrawPresetList(AppConfigs *configs) {
   ImGui::EndChild();
 }
 
+// Estimate of the live config, including UI edits and modulation
+static void DrawCurrentCost(const AppConfigs *configs) {
+  const PostEffect *pe = configs->postEffect;
+  const PresetCost cost = PresetCostEstimate(
+      costModel, configs->effects, pe->screenWidth, pe->screenHeight);
+  ImGui::TextDisabled("Est. GPU");
+  ImGui::SameLine();
+  ImGui::PushStyleColor(ImGuiCol_Text, ImGuiPresetCostColor(&cost));
+  ImGui::Text("%.1f / %.1f ms", cost.totalMs, budgetMs);
+  ImGui::PopStyleColor();
+  if (ImGui::IsItemHovered()) {
+    ImGuiPresetCostTooltip(&cost);
+  }
+}
+
 static void DrawPresetControls(const AppConfigs *configs) {
   const float width = ImGui::GetContentRegionAvail().x;
 
@@ -304,12 +475,15 @@ static void DrawPresetControls(const AppConfigs *configs) {
   ImGui::SameLine();
 
   if (ImGui::Button("Refresh")) {
+    ReloadCostModel();
     RefreshPresetList();
   }
 }
 
 void ImGuiDrawPresetPanel(AppConfigs *configs) {
+  CPU_ZONE("ImGuiDrawPresetPanel");
   if (!initialized) {
+    ReloadCostModel();
     RefreshPresetList();
     initialized = true;
   }
@@ -319,8 +493,10 @@ void ImGuiDrawPresetPanel(AppConfigs *configs) {
     return;
   }
 
+  budgetMs = FrameBudgetMs();
   DrawBreadcrumbs();
   DrawPresetList(configs);
+  DrawCurrentCost(configs);
   DrawPresetControls(configs);
   ImGuiDrawPlaylistSection(configs);
 
@@ -485,3 +485,16 @@ void ImGuiDrawColorMode(ColorConfig *color) {
   }
   ImGui::PopID();
 }
+
+void ImGuiDrawTrailGrid(const char *label, int *gridDivisor) {
+  const char *scales[] = {"Full", "1/2", "1/4"};
+  int scale = *gridDivisor >= 4 ? 2 : (*gridDivisor >= 2 ? 1 : 0);
+  if (ImGui::Combo(label, &scale, scales, 3)) {
+    *gridDivisor = 1 << scale;
+  }
+  if (ImGui::IsItemHovered()) {
+    ImGui::SetTooltip("Trail resolution relative to the output. Lower scales "
+                      "make sensing, deposit and diffusion cheaper; enable "
+                      "Debug to compare the upsampled trails.");
+  }
+}